@@ -55,6 +55,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cerrno>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
@@ -67,6 +68,7 @@
 // clang-format off
 #if defined(_WIN32) || defined(__MINGW32__)
 # include <direct.h>  // mkdir
+# include <malloc.h>  // _aligned_malloc
 #endif
 #ifdef __GLIBC__
 # include <execinfo.h>
@@ -77,6 +79,24 @@
 # include <sys/resource.h>
 # define _VL_HAVE_GETRLIMIT
 #endif
+#if !defined(_WIN32) && !defined(__MINGW32__)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+# define _VL_HAVE_MMAP
+#endif
+// Character I/O without taking the stdio lock, used while holding it via VlFileReadLock
+#if defined(_WIN32) || defined(__MINGW32__)
+# define VL_FLOCKFILE(fp) _lock_file(fp)
+# define VL_FUNLOCKFILE(fp) _unlock_file(fp)
+# define VL_GETC_UNLOCKED(fp) _getc_nolock(fp)
+# define VL_UNGETC_UNLOCKED(c, fp) _ungetc_nolock((c), (fp))
+#else
+# define VL_FLOCKFILE(fp) flockfile(fp)
+# define VL_FUNLOCKFILE(fp) funlockfile(fp)
+# define VL_GETC_UNLOCKED(fp) getc_unlocked(fp)
+# define VL_UNGETC_UNLOCKED(c, fp) std::ungetc((c), (fp))  // Lock is recursive
+#endif
 
 #include "verilated_threads.h"
 // clang-format on
@@ -121,6 +141,7 @@ thread_local Verilated::ThreadLocal Verilated::t_s;
 void vl_finish(const char* filename, int linenum, const char* hier) VL_MT_UNSAFE {
     // hier is unused in the default implementation.
     (void)hier;
+    VerilatedAsyncOutput::drainIfEnabled();
     VL_PRINTF(  // Not VL_PRINTF_MT, already on main thread
         "- %s:%d: Verilog $finish\n", filename, linenum);
     Verilated::threadContextp()->gotFinish(true);
@@ -136,6 +157,7 @@ void vl_stop(const char* filename, int linenum, const char* hier) VL_MT_UNSAFE {
     if (Verilated::threadContextp()->fatalOnError()) {
         vl_fatal(filename, linenum, hier, msg);
     } else {
+        VerilatedAsyncOutput::drainIfEnabled();
         if (filename && filename[0]) {
             // Not VL_PRINTF_MT, already on main thread
             VL_PRINTF("%%Error: %s:%d: %s\n", filename, linenum, msg);
@@ -153,6 +175,7 @@ void vl_fatal(const char* filename, int linenum, const char* hier, const char* m
     (void)hier;
     Verilated::threadContextp()->gotError(true);
     Verilated::threadContextp()->gotFinish(true);
+    VerilatedAsyncOutput::drainIfEnabled();
     if (filename && filename[0]) {
         // Not VL_PRINTF_MT, already on main thread
         VL_PRINTF("%%Error: %s:%d: %s\n", filename, linenum, msg);
@@ -194,6 +217,7 @@ void vl_stop_maybe(const char* filename, int linenum, const char* hier, bool may
 void vl_warn(const char* filename, int linenum, const char* hier, const char* msg) VL_MT_UNSAFE {
     // hier is unused in the default implementation.
     (void)hier;
+    VerilatedAsyncOutput::drainIfEnabled();
     if (filename && filename[0]) {
         // Not VL_PRINTF_MT, already on main thread
         VL_PRINTF("%%Warning: %s:%d: %s\n", filename, linenum, msg);
@@ -285,10 +309,103 @@ void VL_PRINTF_MT(const char* formatp, ...) VL_MT_SAFE {
     const std::string result = _vl_string_vprintf(formatp, ap);
     va_end(ap);
     VerilatedThreadMsgQueue::post(VerilatedMsg{[=]() {  //
+        VerilatedAsyncOutput::drainIfEnabled();
         VL_PRINTF("%s", result.c_str());
     }});
 }
 
+//===========================================================================
+// Asynchronous output
+
+void VerilatedAsyncOutput::enable(bool flag) VL_MT_UNSAFE {
+    if (flag == enabled()) return;
+    if (flag) {
+        {
+            const VerilatedLockGuard lock{m_mutex};
+            m_exit = false;
+        }
+        m_thread = std::thread{&VerilatedAsyncOutput::writerMain, this};
+        m_enabled.store(true);
+    } else {
+        drain();
+        m_enabled.store(false);
+        {
+            const VerilatedLockGuard lock{m_mutex};
+            m_exit = true;
+            m_cv.notify_all();
+        }
+        m_thread.join();
+    }
+}
+
+void VerilatedAsyncOutput::write(FILE* fp, const char* datap, size_t size)
+    VL_MT_SAFE_EXCLUDES(m_mutex) {
+    if (VL_UNLIKELY(!size)) return;
+    VerilatedLockGuard lock{m_mutex};
+    if (VL_UNLIKELY(m_pending.m_data.size() >= MAX_PENDING)) {
+        // Writer is behind, wait for it rather than growing without bound
+        m_cv.wait(m_mutex, [this]() VL_REQUIRES(m_mutex) {
+            return m_pending.m_data.size() < MAX_PENDING;
+        });
+    }
+    if (!m_pending.m_records.empty() && m_pending.m_records.back().m_fp == fp) {
+        m_pending.m_records.back().m_size += size;  // Coalesce with previous write
+    } else {
+        m_pending.m_records.push_back(Record{fp, size});
+    }
+    const size_t before = m_pending.m_data.size();
+    m_pending.m_data.append(datap, size);
+    ++m_posted;
+    // Wake the writer once per large block, rather than per write
+    if (VL_UNLIKELY(before < WAKE_PENDING && m_pending.m_data.size() >= WAKE_PENDING)) {
+        m_cv.notify_all();
+    }
+}
+
+void VerilatedAsyncOutput::drain() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    VerilatedLockGuard lock{m_mutex};
+    const uint64_t target = m_posted;
+    if (m_written >= target) return;
+    m_drainTarget = std::max(m_drainTarget, target);
+    m_cv.notify_all();
+    m_cv.wait(m_mutex, [this, target]() VL_REQUIRES(m_mutex) { return m_written >= target; });
+}
+
+void VerilatedAsyncOutput::writerMain() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    Batch batch;  // Swapped with m_pending, so both buffers keep their capacity
+    while (true) {
+        uint64_t posted;
+        {
+            VerilatedLockGuard lock{m_mutex};
+            // Poll so small amounts of output still appear promptly
+            const auto wakeup = [this]() VL_REQUIRES(m_mutex) {
+                return m_exit || m_drainTarget > m_written
+                       || m_pending.m_data.size() >= WAKE_PENDING;
+            };
+            m_cv.wait_for(m_mutex, std::chrono::milliseconds{10}, wakeup);
+            if (m_pending.m_records.empty()) {
+                if (m_exit) return;  // Exiting, and nothing left
+                continue;
+            }
+            std::swap(batch, m_pending);
+            posted = m_posted;
+            m_cv.notify_all();  // Producers waiting on MAX_PENDING
+        }
+        const char* datap = batch.m_data.data();
+        for (const Record& record : batch.m_records) {
+            (void)std::fwrite(datap, 1, record.m_size, record.m_fp);
+            datap += record.m_size;
+        }
+        batch.m_data.clear();
+        batch.m_records.clear();
+        {
+            const VerilatedLockGuard lock{m_mutex};
+            m_written = posted;
+            m_cv.notify_all();  // Threads in drain()
+        }
+    }
+}
+
 //===========================================================================
 // Random -- Mostly called at init time, so not inline.
 
@@ -303,23 +420,33 @@ VlRNG::VlRNG() VL_MT_SAFE {
                         ^ (fromr.m_state[1] << 14));
     fromr.m_state[1] = (fromr.m_state[1] << 36) | (fromr.m_state[1] >> 28);
 }
-uint64_t VlRNG::rand64() VL_MT_UNSAFE {
-    // Xoroshiro128+ algorithm
-    const uint64_t result = m_state[0] + m_state[1];
-    m_state[1] ^= m_state[0];
-    m_state[0] = (((m_state[0] << 55) | (m_state[0] >> 9)) ^ m_state[1] ^ (m_state[1] << 14));
-    m_state[1] = (m_state[1] << 36) | (m_state[1] >> 28);
-    return result;
-}
-uint64_t VlRNG::vl_thread_rng_rand64() VL_MT_SAFE {
-    VlRNG& fromr = vl_thread_rng();
-    const uint64_t result = fromr.m_state[0] + fromr.m_state[1];
-    fromr.m_state[1] ^= fromr.m_state[0];
-    fromr.m_state[0] = (((fromr.m_state[0] << 55) | (fromr.m_state[0] >> 9)) ^ fromr.m_state[1]
-                        ^ (fromr.m_state[1] << 14));
-    fromr.m_state[1] = (fromr.m_state[1] << 36) | (fromr.m_state[1] >> 28);
-    return result;
+void VlRNG::fill(void* datap, size_t bytes) VL_MT_UNSAFE {
+    // Independent Xoroshiro128+ lanes, so the compiler can interleave or vectorize them. They
+    // are seeded by this generator, so the result only depends on its state, as when filling
+    // with rand64() calls.
+    constexpr size_t LANES = 4;
+    uint64_t s0[LANES];
+    uint64_t s1[LANES];
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        s0[lane] = rand64() | 1;  // Never all zero state
+        s1[lane] = rand64();
+    }
+    uint8_t* bytep = static_cast<uint8_t*>(datap);
+    while (bytes) {
+        uint64_t block[LANES];
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            block[lane] = s0[lane] + s1[lane];
+            s1[lane] ^= s0[lane];
+            s0[lane] = (((s0[lane] << 55) | (s0[lane] >> 9)) ^ s1[lane] ^ (s1[lane] << 14));
+            s1[lane] = (s1[lane] << 36) | (s1[lane] >> 28);
+        }
+        const size_t n = std::min(bytes, sizeof(block));
+        std::memcpy(bytep, block, n);
+        bytep += n;
+        bytes -= n;
+    }
 }
+uint64_t VlRNG::vl_thread_rng_rand64() VL_MT_SAFE { return vl_thread_rng().rand64(); }
 void VlRNG::srandom(uint64_t n) VL_MT_UNSAFE {
     m_state[0] = n;
     m_state[1] = m_state[0];
@@ -384,7 +511,8 @@ VlRNG& VlRNG::vl_thread_rng() VL_MT_SAFE {
 }
 
 WDataOutP VL_RANDOM_W(int obits, WDataOutP outwp) VL_MT_SAFE {
-    for (int i = 0; i < VL_WORDS_I(obits); ++i) outwp[i] = vl_rand64();
+    VlRNG& rngr = VlRNG::vl_thread_rng();
+    for (int i = 0; i < VL_WORDS_I(obits); ++i) outwp[i] = rngr.rand64();
     // Last word is unclean
     return outwp;
 }
@@ -407,9 +535,10 @@ IData VL_URANDOM_SEEDED_II(IData seed) VL_MT_SAFE {
     return VL_RANDOM_I();
 }
 IData VL_RAND_RESET_I(int obits) VL_MT_SAFE {
-    if (Verilated::threadContextp()->randReset() == 0) return 0;
+    const int randReset = Verilated::threadContextp()->randReset();
+    if (randReset == 0) return 0;
     IData data = ~0;
-    if (Verilated::threadContextp()->randReset() != 1) {  // if 2, randomize
+    if (randReset != 1) {  // if 2, randomize
         data = VL_RANDOM_I();
     }
     data &= VL_MASK_I(obits);
@@ -418,9 +547,10 @@ IData VL_RAND_RESET_I(int obits) VL_MT_SAFE {
 IData VL_RAND_RESET_ASSIGN_I(int obits) VL_MT_SAFE { return VL_RANDOM_I() & VL_MASK_I(obits); }
 
 QData VL_RAND_RESET_Q(int obits) VL_MT_SAFE {
-    if (Verilated::threadContextp()->randReset() == 0) return 0;
+    const int randReset = Verilated::threadContextp()->randReset();
+    if (randReset == 0) return 0;
     QData data = ~0ULL;
-    if (Verilated::threadContextp()->randReset() != 1) {  // if 2, randomize
+    if (randReset != 1) {  // if 2, randomize
         data = VL_RANDOM_Q();
     }
     data &= VL_MASK_Q(obits);
@@ -430,13 +560,61 @@ QData VL_RAND_RESET_Q(int obits) VL_MT_SAFE {
 QData VL_RAND_RESET_ASSIGN_Q(int obits) VL_MT_SAFE { return VL_RANDOM_Q() & VL_MASK_Q(obits); }
 
 WDataOutP VL_RAND_RESET_W(int obits, WDataOutP outwp) VL_MT_SAFE {
-    for (int i = 0; i < VL_WORDS_I(obits) - 1; ++i) outwp[i] = VL_RAND_RESET_I(32);
-    outwp[VL_WORDS_I(obits) - 1] = VL_RAND_RESET_I(32) & VL_MASK_E(obits);
+    // Look up the context and generator once, not per word
+    const int randReset = Verilated::threadContextp()->randReset();
+    if (randReset == 0) return VL_ZERO_W(obits, outwp);
+    if (randReset == 1) {
+        for (int i = 0; i < VL_WORDS_I(obits); ++i) outwp[i] = ~0;
+    } else {  // if 2, randomize
+        VlRNG& rngr = VlRNG::vl_thread_rng();
+        for (int i = 0; i < VL_WORDS_I(obits); ++i) outwp[i] = rngr.rand64();
+    }
+    outwp[VL_WORDS_I(obits) - 1] &= VL_MASK_E(obits);
     return outwp;
 }
+template <typename T_Elem>
+static void vl_mask_array(T_Elem mask, void* datap, size_t bytes) {
+    T_Elem* const elemsp = static_cast<T_Elem*>(datap);
+    for (size_t i = 0; i < bytes / sizeof(T_Elem); ++i) elemsp[i] &= mask;
+}
+static void vl_clean_array(int obits, void* datap, size_t bytes) VL_MT_SAFE {
+    // Clean the unused bits of each element
+    if (obits <= VL_BYTESIZE) {
+        vl_mask_array<CData>(VL_MASK_I(obits), datap, bytes);
+    } else if (obits <= VL_SHORTSIZE) {
+        vl_mask_array<SData>(VL_MASK_I(obits), datap, bytes);
+    } else if (obits <= VL_IDATASIZE) {
+        vl_mask_array<IData>(VL_MASK_I(obits), datap, bytes);
+    } else if (obits <= VL_QUADSIZE) {
+        vl_mask_array<QData>(VL_MASK_Q(obits), datap, bytes);
+    } else if (VL_BITBIT_E(obits)) {
+        const size_t words = VL_WORDS_I(obits);
+        EData* const wordsp = static_cast<EData*>(datap);
+        const EData mask = VL_MASK_E(obits);
+        for (size_t i = words - 1; i < bytes / sizeof(EData); i += words) wordsp[i] &= mask;
+    }
+}
+void VL_RAND_RESET_ARRAY(int obits, void* datap, size_t bytes) VL_MT_SAFE {
+    const int randReset = Verilated::threadContextp()->randReset();
+    if (randReset == 0) {
+        std::memset(datap, 0, bytes);
+        return;
+    }
+    if (randReset == 1) {
+        std::memset(datap, 0xff, bytes);
+    } else {  // if 2, randomize
+        VlRNG::vl_thread_rng().fill(datap, bytes);
+    }
+    vl_clean_array(obits, datap, bytes);
+}
+void VL_RANDOM_RNG_ARRAY(VlRNG& rngr, int obits, void* datap, size_t bytes) VL_MT_UNSAFE {
+    rngr.fill(datap, bytes);
+    vl_clean_array(obits, datap, bytes);
+}
 WDataOutP VL_RAND_RESET_ASSIGN_W(int obits, WDataOutP outwp) VL_MT_SAFE {
-    for (int i = 0; i < VL_WORDS_I(obits) - 1; ++i) outwp[i] = VL_RAND_RESET_ASSIGN_I(32);
-    outwp[VL_WORDS_I(obits) - 1] = VL_RAND_RESET_ASSIGN_I(32) & VL_MASK_E(obits);
+    VlRNG& rngr = VlRNG::vl_thread_rng();
+    for (int i = 0; i < VL_WORDS_I(obits); ++i) outwp[i] = rngr.rand64();
+    outwp[VL_WORDS_I(obits) - 1] &= VL_MASK_E(obits);
     return outwp;
 }
 WDataOutP VL_ZERO_RESET_W(int obits, WDataOutP outwp) VL_MT_SAFE {
@@ -738,7 +916,8 @@ std::string VL_DECIMAL_NW(int width, const WDataInP lwp) VL_MT_SAFE {
 }
 
 template <typename T>
-std::string _vl_vsformat_time(char* tmp, T ld, int timeunit, bool left, size_t width) VL_MT_SAFE {
+void _vl_vsformat_time(std::string& output, char* tmp, T ld, int timeunit, bool left,
+                       size_t width) VL_MT_SAFE {
     const VerilatedContextImp* const ctxImpp = Verilated::threadContextp()->impp();
     const std::string suffix = ctxImpp->timeFormatSuffix();
     const int userUnits = ctxImpp->timeFormatUnits();  // 0..-15
@@ -813,43 +992,53 @@ std::string _vl_vsformat_time(char* tmp, T ld, int timeunit, bool left, size_t w
         }
     }
 
-    const int needmore = static_cast<int>(width) - digits;
-    std::string padding;
-    if (needmore > 0) padding.append(needmore, ' ');  // Pad with spaces
-    return left ? (tmp + padding) : (padding + tmp);
+    const int needmore = std::max(static_cast<int>(width) - digits, 0);
+    if (!left) output.append(needmore, ' ');  // Pad with spaces
+    output += tmp;
+    if (left) output.append(needmore, ' ');
 }
 
 // Do a va_arg returning a quad, assuming input argument is anything less than wide
 #define VL_VA_ARG_Q_(ap, bits) (((bits) <= VL_IDATASIZE) ? va_arg(ap, IData) : va_arg(ap, QData))
 
-void _vl_vsformat(std::string& output, const std::string& format, va_list ap) VL_MT_SAFE {
+// Append a field to output, padded to width with padc, before the field unless left
+static void _vl_vsformat_padded(std::string& output, const char* datap, size_t len, size_t width,
+                                bool left, char padc) VL_MT_SAFE {
+    const size_t needmore = width > len ? width - len : 0;
+    if (!left) output.append(needmore, padc);
+    output.append(datap, len);
+    if (left) output.append(needmore, ' ');
+}
+
+void _vl_vsformat(std::string& output, const char* formatp, va_list ap) VL_MT_SAFE {
     // Format a Verilog $write style format into the output list
     // The format must be pre-processed (and lower cased) by Verilator
     // Arguments are in "width, arg-value (or WDataIn* if wide)" form
     //
+    // Values are formatted directly into output, without temporary strings,
+    // so formatting into a reused buffer does not allocate in most cases.
+    //
     // Note uses a single buffer internally; presumes only one usage per printf
     // Note also assumes variables < 64 are not wide, this assumption is
     // sometimes not true in low-level routines written here in verilated.cpp
     static thread_local char t_tmp[VL_VALUE_STRING_MAX_WIDTH];
-    std::string::const_iterator pctit = format.end();  // Most recent %##.##g format
+    const char* pctp = nullptr;  // Most recent %##.##g format
     bool inPct = false;
     bool widthSet = false;
     bool left = false;
     size_t width = 0;
-    for (std::string::const_iterator pos = format.cbegin(); pos != format.cend(); ++pos) {
+    for (const char* pos = formatp; *pos; ++pos) {
         if (!inPct && pos[0] == '%') {
-            pctit = pos;
+            pctp = pos;
             inPct = true;
             widthSet = false;
             width = 0;
         } else if (!inPct) {  // Normal text
             // Fast-forward to next escape and add to output
-            std::string::const_iterator ep = pos;
-            while (ep != format.end() && ep[0] != '%') ++ep;
-            if (ep != pos) {
-                output.append(pos, ep);
-                pos = ep - 1;
-            }
+            const char* ep = pos;
+            while (*ep && *ep != '%') ++ep;
+            output.append(pos, ep - pos);
+            pos = ep - 1;
         } else {  // Format character
             inPct = false;
             const char fmt = pos[0];
@@ -894,9 +1083,7 @@ void _vl_vsformat(std::string& output, const std::string& format, va_list ap) VL
             case '@': {  // Verilog/C++ string
                 va_arg(ap, int);  // # bits is ignored
                 const std::string* const cstrp = va_arg(ap, const std::string*);
-                std::string padding;
-                if (width > cstrp->size()) padding.append(width - cstrp->size(), ' ');
-                output += left ? (*cstrp + padding) : (padding + *cstrp);
+                _vl_vsformat_padded(output, cstrp->data(), cstrp->size(), width, left, ' ');
                 break;
             }
             case 'e':
@@ -909,9 +1096,9 @@ void _vl_vsformat(std::string& output, const std::string& format, va_list ap) VL
                 if (fmt == '^') {  // Realtime
                     if (!widthSet) width = Verilated::threadContextp()->impp()->timeFormatWidth();
                     const int timeunit = va_arg(ap, int);
-                    output += _vl_vsformat_time(t_tmp, d, timeunit, left, width);
+                    _vl_vsformat_time(output, t_tmp, d, timeunit, left, width);
                 } else {
-                    const std::string fmts{pctit, pos + 1};
+                    const std::string fmts{pctp, pos + 1};
                     VL_SNPRINTF(t_tmp, VL_VALUE_STRING_MAX_WIDTH, fmts.c_str(), d);
                     output += t_tmp;
                 }
@@ -950,6 +1137,8 @@ void _vl_vsformat(std::string& output, const std::string& format, va_list ap) VL
                 if (widthSet && width == 0) {
                     while (lsb && !VL_BITISSET_W(lwp, lsb)) --lsb;
                 }
+                // %0 pads decimal numbers with zeros
+                const char decimalPad = (pctp && pctp[1] == '0') ? '0' : ' ';
                 switch (fmt) {
                 case 'c': {
                     const IData charval = ld & 0xff;
@@ -957,26 +1146,25 @@ void _vl_vsformat(std::string& output, const std::string& format, va_list ap) VL
                     break;
                 }
                 case 's': {
-                    std::string field;
+                    const size_t chars = lsb / 8 + 1;
+                    const size_t needmore = width > chars ? width - chars : 0;
+                    if (!left) output.append(needmore, ' ');
                     for (; lsb >= 0; --lsb) {
                         lsb = (lsb / 8) * 8;  // Next digit
                         const IData charval = VL_BITRSHIFT_W(lwp, lsb) & 0xff;
-                        field += (charval == 0) ? ' ' : charval;
+                        output += (charval == 0) ? ' ' : static_cast<char>(charval);
                     }
-                    std::string padding;
-                    if (width > field.size()) padding.append(width - field.size(), ' ');
-                    output += left ? (field + padding) : (padding + field);
+                    if (left) output.append(needmore, ' ');
                     break;
                 }
                 case 'd': {  // Signed decimal
-                    int digits = 0;
-                    std::string append;
                     if (lbits <= VL_QUADSIZE) {
-                        digits
+                        const int digits
                             = VL_SNPRINTF(t_tmp, VL_VALUE_STRING_MAX_WIDTH, "%" PRId64,
                                           static_cast<int64_t>(VL_EXTENDS_QQ(lbits, lbits, ld)));
-                        append = t_tmp;
+                        _vl_vsformat_padded(output, t_tmp, digits, width, left, decimalPad);
                     } else {
+                        std::string append;
                         if (VL_SIGN_E(lbits, lwp[VL_WORDS_I(lbits) - 1])) {
                             VlWide<VL_VALUE_STRING_MAX_WIDTH / 4 + 2> neg;
                             VL_NEGATE_W(VL_WORDS_I(lbits), neg, lwp);
@@ -984,60 +1172,27 @@ void _vl_vsformat(std::string& output, const std::string& format, va_list ap) VL
                         } else {
                             append = VL_DECIMAL_NW(lbits, lwp);
                         }
-                        digits = static_cast<int>(append.length());
-                    }
-                    const int needmore = static_cast<int>(width) - digits;
-                    if (needmore > 0) {
-                        std::string padding;
-                        if (left) {
-                            padding.append(needmore, ' ');  // Pre-pad spaces
-                            output += append + padding;
-                        } else {
-                            if (pctit != format.end() && pctit[0] && pctit[1] == '0') {  // %0
-                                padding.append(needmore, '0');  // Pre-pad zero
-                            } else {
-                                padding.append(needmore, ' ');  // Pre-pad spaces
-                            }
-                            output += padding + append;
-                        }
-                    } else {
-                        output += append;
+                        _vl_vsformat_padded(output, append.data(), append.size(), width, left,
+                                            decimalPad);
                     }
                     break;
                 }
                 case '#': {  // Unsigned decimal
-                    int digits = 0;
-                    std::string append;
                     if (lbits <= VL_QUADSIZE) {
-                        digits = VL_SNPRINTF(t_tmp, VL_VALUE_STRING_MAX_WIDTH, "%" PRIu64, ld);
-                        append = t_tmp;
-                    } else {
-                        append = VL_DECIMAL_NW(lbits, lwp);
-                        digits = static_cast<int>(append.length());
-                    }
-                    const int needmore = static_cast<int>(width) - digits;
-                    if (needmore > 0) {
-                        std::string padding;
-                        if (left) {
-                            padding.append(needmore, ' ');  // Pre-pad spaces
-                            output += append + padding;
-                        } else {
-                            if (pctit != format.end() && pctit[0] && pctit[1] == '0') {  // %0
-                                padding.append(needmore, '0');  // Pre-pad zero
-                            } else {
-                                padding.append(needmore, ' ');  // Pre-pad spaces
-                            }
-                            output += padding + append;
-                        }
+                        const int digits
+                            = VL_SNPRINTF(t_tmp, VL_VALUE_STRING_MAX_WIDTH, "%" PRIu64, ld);
+                        _vl_vsformat_padded(output, t_tmp, digits, width, left, decimalPad);
                     } else {
-                        output += append;
+                        const std::string append = VL_DECIMAL_NW(lbits, lwp);
+                        _vl_vsformat_padded(output, append.data(), append.size(), width, left,
+                                            decimalPad);
                     }
                     break;
                 }
                 case 't': {  // Time
                     if (!widthSet) width = Verilated::threadContextp()->impp()->timeFormatWidth();
                     const int timeunit = va_arg(ap, int);
-                    output += _vl_vsformat_time(t_tmp, ld, timeunit, left, width);
+                    _vl_vsformat_time(output, t_tmp, ld, timeunit, left, width);
                     break;
                 }
                 case 'b':  // FALLTHRU
@@ -1047,23 +1202,23 @@ void _vl_vsformat(std::string& output, const std::string& format, va_list ap) VL
                         lsb = VL_MOSTSETBITP1_W(VL_WORDS_I(lbits), lwp);
                         lsb = (lsb < 1) ? 0 : (lsb - 1);
                     }
-
-                    std::string append;
-                    int digits;
+                    const int digits = fmt == 'b'   ? lsb + 1
+                                       : fmt == 'o' ? (lsb + 1 + 2) / 3
+                                                    : (lsb + 1 + 3) / 4;
+                    const int needmore = static_cast<int>(width) - digits;
+                    if (needmore > 0 && !left) output.append(needmore, '0');  // Pre-pad zero
                     switch (fmt) {
                     case 'b': {
-                        digits = lsb + 1;
-                        for (; lsb >= 0; --lsb) append += (VL_BITRSHIFT_W(lwp, lsb) & 1) + '0';
+                        for (; lsb >= 0; --lsb) output += (VL_BITRSHIFT_W(lwp, lsb) & 1) + '0';
                         break;
                     }
                     case 'o': {
-                        digits = (lsb + 1 + 2) / 3;
                         for (; lsb >= 0; --lsb) {
                             lsb = (lsb / 3) * 3;  // Next digit
                             // Octal numbers may span more than one wide word,
                             // so we need to grab each bit separately and check for overrun
                             // Octal is rare, so we'll do it a slow simple way
-                            append += static_cast<char>(
+                            output += static_cast<char>(
                                 '0' + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb + 0)) ? 1 : 0)
                                 + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb + 1)) ? 2 : 0)
                                 + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb + 2)) ? 4 : 0));
@@ -1071,29 +1226,15 @@ void _vl_vsformat(std::string& output, const std::string& format, va_list ap) VL
                         break;
                     }
                     default: {  // 'x'
-                        digits = (lsb + 1 + 3) / 4;
                         for (; lsb >= 0; --lsb) {
                             lsb = (lsb / 4) * 4;  // Next digit
                             const IData charval = VL_BITRSHIFT_W(lwp, lsb) & 0xf;
-                            append += "0123456789abcdef"[charval];
+                            output += "0123456789abcdef"[charval];
                         }
                         break;
                     }
                     }  // switch
-
-                    const int needmore = static_cast<int>(width) - digits;
-                    if (needmore > 0) {
-                        std::string padding;
-                        if (left) {
-                            padding.append(needmore, ' ');  // Pre-pad spaces
-                            output += append + padding;
-                        } else {
-                            padding.append(needmore, '0');  // Pre-pad zero
-                            output += padding + append;
-                        }
-                    } else {
-                        output += append;
-                    }
+                    if (needmore > 0 && left) output.append(needmore, ' ');  // Post-pad spaces
                     break;
                 }  // b / o / x
                 case 'u':
@@ -1133,6 +1274,19 @@ void _vl_vsformat(std::string& output, const std::string& format, va_list ap) VL
     }
 }
 
+// Holds the stdio lock of a file across many character reads, so each can skip locking
+class VlFileReadLock final {
+    FILE* const m_fp;
+
+public:
+    explicit VlFileReadLock(FILE* fp)
+        : m_fp{fp} {
+        VL_FLOCKFILE(m_fp);
+    }
+    ~VlFileReadLock() { VL_FUNLOCKFILE(m_fp); }
+    VL_UNCOPYABLE(VlFileReadLock);
+};
+
 static bool _vl_vsss_eof(FILE* fp, int floc) VL_MT_SAFE {
     if (VL_LIKELY(fp)) {
         return std::feof(fp) ? true : false;  // true : false to prevent MSVC++ warning
@@ -1142,7 +1296,7 @@ static bool _vl_vsss_eof(FILE* fp, int floc) VL_MT_SAFE {
 }
 static void _vl_vsss_advance(FILE* fp, int& floc) VL_MT_SAFE {
     if (VL_LIKELY(fp)) {
-        std::fgetc(fp);
+        VL_GETC_UNLOCKED(fp);
     } else {
         floc -= 8;
     }
@@ -1151,9 +1305,9 @@ static int _vl_vsss_peek(FILE* fp, int& floc, const WDataInP fromp,
                          const std::string& fstr) VL_MT_SAFE {
     // Get a character without advancing
     if (VL_LIKELY(fp)) {
-        const int data = std::fgetc(fp);
+        const int data = VL_GETC_UNLOCKED(fp);
         if (data == EOF) return EOF;
-        ungetc(data, fp);
+        VL_UNGETC_UNLOCKED(data, fp);
         return data;
     } else {
         if (floc < 0) return EOF;
@@ -1490,8 +1644,9 @@ static IData getLine(std::string& str, IData fpi, size_t maxLen) VL_MT_SAFE {
     if (VL_UNLIKELY(!fp)) return 0;
 
     // We don't use fgets, as we must read \0s.
+    const VlFileReadLock lock{fp};
     while (str.size() < maxLen) {
-        const int c = getc(fp);  // getc() is threadsafe
+        const int c = VL_GETC_UNLOCKED(fp);
         if (c == EOF) break;
         str.push_back(c);
         if (c == '\n') break;
@@ -1549,102 +1704,113 @@ void VL_FCLOSE_I(IData fdi) VL_MT_SAFE {
     Verilated::threadContextp()->impp()->fdClose(fdi);
 }
 
-void VL_SFORMAT_NX(int obits, CData& destr, const std::string& format, int argc, ...) VL_MT_SAFE {
+void VL_SFORMAT_NX(int obits, CData& destr, const char* formatp, int argc, ...) VL_MT_SAFE {
     static thread_local std::string t_output;  // static only for speed
-    t_output = "";
+    t_output.clear();
     va_list ap;
     va_start(ap, argc);
-    _vl_vsformat(t_output, format, ap);
+    _vl_vsformat(t_output, formatp, ap);
     va_end(ap);
 
     _vl_string_to_vint(obits, &destr, t_output.length(), t_output.c_str());
 }
 
-void VL_SFORMAT_NX(int obits, SData& destr, const std::string& format, int argc, ...) VL_MT_SAFE {
+void VL_SFORMAT_NX(int obits, SData& destr, const char* formatp, int argc, ...) VL_MT_SAFE {
     static thread_local std::string t_output;  // static only for speed
-    t_output = "";
+    t_output.clear();
     va_list ap;
     va_start(ap, argc);
-    _vl_vsformat(t_output, format, ap);
+    _vl_vsformat(t_output, formatp, ap);
     va_end(ap);
 
     _vl_string_to_vint(obits, &destr, t_output.length(), t_output.c_str());
 }
 
-void VL_SFORMAT_NX(int obits, IData& destr, const std::string& format, int argc, ...) VL_MT_SAFE {
+void VL_SFORMAT_NX(int obits, IData& destr, const char* formatp, int argc, ...) VL_MT_SAFE {
     static thread_local std::string t_output;  // static only for speed
-    t_output = "";
+    t_output.clear();
     va_list ap;
     va_start(ap, argc);
-    _vl_vsformat(t_output, format, ap);
+    _vl_vsformat(t_output, formatp, ap);
     va_end(ap);
 
     _vl_string_to_vint(obits, &destr, t_output.length(), t_output.c_str());
 }
 
-void VL_SFORMAT_NX(int obits, QData& destr, const std::string& format, int argc, ...) VL_MT_SAFE {
+void VL_SFORMAT_NX(int obits, QData& destr, const char* formatp, int argc, ...) VL_MT_SAFE {
     static thread_local std::string t_output;  // static only for speed
-    t_output = "";
+    t_output.clear();
     va_list ap;
     va_start(ap, argc);
-    _vl_vsformat(t_output, format, ap);
+    _vl_vsformat(t_output, formatp, ap);
     va_end(ap);
 
     _vl_string_to_vint(obits, &destr, t_output.length(), t_output.c_str());
 }
 
-void VL_SFORMAT_NX(int obits, void* destp, const std::string& format, int argc, ...) VL_MT_SAFE {
+void VL_SFORMAT_NX(int obits, void* destp, const char* formatp, int argc, ...) VL_MT_SAFE {
     static thread_local std::string t_output;  // static only for speed
-    t_output = "";
+    t_output.clear();
     va_list ap;
     va_start(ap, argc);
-    _vl_vsformat(t_output, format, ap);
+    _vl_vsformat(t_output, formatp, ap);
     va_end(ap);
 
     _vl_string_to_vint(obits, destp, t_output.length(), t_output.c_str());
 }
 
-void VL_SFORMAT_NX(int obits_ignored, std::string& output, const std::string& format, int argc,
+void VL_SFORMAT_NX(int obits_ignored, std::string& output, const char* formatp, int argc,
                    ...) VL_MT_SAFE {
     (void)obits_ignored;  // So VL_SFORMAT_NNX function signatures all match
-    std::string temp_output;
+    static thread_local std::string t_output;  // static only for speed
+    t_output.clear();  // Not output itself, as output may be an argument
     va_list ap;
     va_start(ap, argc);
-    _vl_vsformat(temp_output, format, ap);
+    _vl_vsformat(t_output, formatp, ap);
     va_end(ap);
-    output = temp_output;
+    output = t_output;
 }
 
-std::string VL_SFORMATF_N_NX(const std::string& format, int argc, ...) VL_MT_SAFE {
+std::string VL_SFORMATF_N_NX(const char* formatp, int argc, ...) VL_MT_SAFE {
     static thread_local std::string t_output;  // static only for speed
-    t_output = "";
+    t_output.clear();
     va_list ap;
     va_start(ap, argc);
-    _vl_vsformat(t_output, format, ap);
+    _vl_vsformat(t_output, formatp, ap);
     va_end(ap);
 
     return t_output;
 }
 
-void VL_WRITEF_NX(const std::string& format, int argc, ...) VL_MT_SAFE {
+void VL_WRITEF_NX(const char* formatp, int argc, ...) VL_MT_SAFE {
     static thread_local std::string t_output;  // static only for speed
-    t_output = "";
+    t_output.clear();
     va_list ap;
     va_start(ap, argc);
-    _vl_vsformat(t_output, format, ap);
+    _vl_vsformat(t_output, formatp, ap);
     va_end(ap);
 
-    VL_PRINTF_MT("%s", t_output.c_str());
+    if (Verilated::mtaskId() == 0) {
+        VerilatedAsyncOutput& async = VerilatedAsyncOutput::singleton();
+        if (VL_UNLIKELY(async.enabled())) {
+            async.write(stdout, t_output.data(), t_output.size());
+        } else {
+            // Not in an mtask, so no need to copy into a message
+            VL_PRINTF("%s", t_output.c_str());
+        }
+    } else {
+        VL_PRINTF_MT("%s", t_output.c_str());
+    }
 }
 
-void VL_FWRITEF_NX(IData fpi, const std::string& format, int argc, ...) VL_MT_SAFE {
+void VL_FWRITEF_NX(IData fpi, const char* formatp, int argc, ...) VL_MT_SAFE {
     // While threadsafe, each thread can only access different file handles
     static thread_local std::string t_output;  // static only for speed
-    t_output = "";
+    t_output.clear();
 
     va_list ap;
     va_start(ap, argc);
-    _vl_vsformat(t_output, format, ap);
+    _vl_vsformat(t_output, formatp, ap);
     va_end(ap);
 
     Verilated::threadContextp()->impp()->fdWrite(fpi, t_output);
@@ -1655,6 +1821,7 @@ IData VL_FSCANF_INX(IData fpi, const std::string& format, int argc, ...) VL_MT_S
     FILE* const fp = VL_CVT_I_FP(fpi);
     if (VL_UNLIKELY(!fp)) return ~0U;  // -1
 
+    const VlFileReadLock lock{fp};
     va_list ap;
     va_start(ap, argc);
     const IData got = _vl_vsscanf(fp, 0, nullptr, "", format, ap);
@@ -1706,50 +1873,46 @@ IData VL_FREAD_I(int width, int array_lsb, int array_size, void* memp, IData fpi
     FILE* const fp = VL_CVT_I_FP(fpi);
     if (VL_UNLIKELY(!fp)) return 0;
     if (count > (array_size - (start - array_lsb))) count = array_size - (start - array_lsb);
-    // Prep for reading
-    IData read_count = 0;
-    IData read_elements = 0;
+    if (VL_UNLIKELY(!count)) return 0;
+    // Read all the data at once, then distribute it to the elements
+    const size_t elementBytes = VL_BYTES_I(width);
+    static thread_local std::vector<uint8_t> t_buffer;
+    t_buffer.resize(elementBytes * count);
+    const size_t read_count = std::fread(t_buffer.data(), 1, t_buffer.size(), fp);
+    // Each element is big endian, the first byte read is the most significant
     const int start_shift = (width - 1) & ~7;  // bit+7:bit gets first character
-    int shift = start_shift;
-    // Read the data
-    // We process a character at a time, as then we don't need to deal
-    // with changing buffer sizes dynamically, etc.
-    while (true) {
-        const int c = std::fgetc(fp);
-        if (VL_UNLIKELY(c == EOF)) break;
-        // Shift value in
-        const IData entry = read_elements + start - array_lsb;
-        if (width <= 8) {
-            CData* const datap = &(reinterpret_cast<CData*>(memp))[entry];
-            if (shift == start_shift) *datap = 0;
-            *datap |= (c << shift) & VL_MASK_I(width);
-        } else if (width <= 16) {
-            SData* const datap = &(reinterpret_cast<SData*>(memp))[entry];
-            if (shift == start_shift) *datap = 0;
-            *datap |= (c << shift) & VL_MASK_I(width);
-        } else if (width <= VL_IDATASIZE) {
-            IData* const datap = &(reinterpret_cast<IData*>(memp))[entry];
-            if (shift == start_shift) *datap = 0;
-            *datap |= (c << shift) & VL_MASK_I(width);
-        } else if (width <= VL_QUADSIZE) {
-            QData* const datap = &(reinterpret_cast<QData*>(memp))[entry];
-            if (shift == start_shift) *datap = 0;
-            *datap |= ((static_cast<QData>(c) << static_cast<QData>(shift)) & VL_MASK_Q(width));
+    IData entry = start - array_lsb;
+    for (size_t pos = 0; pos < read_count; pos += elementBytes, ++entry) {
+        const uint8_t* const bytep = &t_buffer[pos];
+        // A partial element at the end of the file is filled from the top
+        const size_t bytes = std::min(elementBytes, read_count - pos);
+        if (width <= VL_QUADSIZE) {
+            QData value = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                const int shift = start_shift - 8 * static_cast<int>(i);
+                value |= static_cast<QData>(bytep[i]) << shift;
+            }
+            value &= VL_MASK_Q(width);
+            if (width <= 8) {
+                reinterpret_cast<CData*>(memp)[entry] = static_cast<CData>(value);
+            } else if (width <= 16) {
+                reinterpret_cast<SData*>(memp)[entry] = static_cast<SData>(value);
+            } else if (width <= VL_IDATASIZE) {
+                reinterpret_cast<IData*>(memp)[entry] = static_cast<IData>(value);
+            } else {
+                reinterpret_cast<QData*>(memp)[entry] = value;
+            }
         } else {
             WDataOutP datap = &(reinterpret_cast<WDataOutP>(memp))[entry * VL_WORDS_I(width)];
-            if (shift == start_shift) VL_ZERO_W(width, datap);
-            datap[VL_BITWORD_E(shift)] |= (static_cast<EData>(c) << VL_BITBIT_E(shift));
-        }
-        // Prep for next
-        ++read_count;
-        shift -= 8;
-        if (shift < 0) {
-            shift = start_shift;
-            ++read_elements;
-            if (VL_UNLIKELY(read_elements >= count)) break;
+            VL_ZERO_W(width, datap);
+            for (size_t i = 0; i < bytes; ++i) {
+                const int shift = start_shift - 8 * static_cast<int>(i);
+                const EData byte = bytep[i];
+                datap[VL_BITWORD_E(shift)] |= byte << VL_BITBIT_E(shift);
+            }
         }
     }
-    return read_count;
+    return static_cast<IData>(read_count);
 }
 
 std::string VL_STACKTRACE_N() VL_MT_SAFE {
@@ -2056,46 +2219,90 @@ VlReadMem::VlReadMem(bool hex, int bits, const std::string& filename, QData star
     , m_filename(filename)  // Need () or GCC 4.8 false warning
     , m_end{end}
     , m_addr{start} {
-    m_fp = std::fopen(filename.c_str(), "r");
-    if (VL_UNLIKELY(!m_fp)) {
-        // We don't report the Verilog source filename as it slow to have to pass it down
-        VL_WARN_MT(filename.c_str(), 0, "", "$readmem file not found");
-        // cppcheck-has-bug-suppress resourceLeak  // m_fp is nullptr
-        return;
+    // Memory images may be gigabytes, so map the file rather than reading it
+#ifdef _VL_HAVE_MMAP
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat sstat;
+        if (::fstat(fd, &sstat) == 0 && S_ISREG(sstat.st_mode) && sstat.st_size > 0) {
+            const size_t size = static_cast<size_t>(sstat.st_size);
+            void* const mapp = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapp != MAP_FAILED) {
+                ::madvise(mapp, size, MADV_SEQUENTIAL);
+                m_datap = static_cast<const char*>(mapp);
+                m_mappedSize = size;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+    if (!m_datap) {  // Empty, not a regular file, or no mmap
+        FILE* const fp = std::fopen(filename.c_str(), "r");
+        if (VL_UNLIKELY(!fp)) {
+            // We don't report the Verilog source filename as it slow to have to pass it down
+            VL_WARN_MT(filename.c_str(), 0, "", "$readmem file not found");
+            return;
+        }
+        char buf[64 * 1024];
+        size_t got;
+        while ((got = std::fread(buf, 1, sizeof(buf), fp)) > 0) m_buffer.append(buf, got);
+        std::fclose(fp);
+        m_datap = m_buffer.data();
     }
+    m_curp = m_datap;
+    m_endp = m_datap + (m_mappedSize ? m_mappedSize : m_buffer.size());
 }
 VlReadMem::~VlReadMem() {
-    if (m_fp) {
-        std::fclose(m_fp);
-        m_fp = nullptr;
+#ifdef _VL_HAVE_MMAP
+    if (m_mappedSize) ::munmap(const_cast<char*>(m_datap), m_mappedSize);
+#endif
+}
+struct VlReadMemHexTable final {
+    bool m_is4StateHex[256];  // Character is a 0-9, a-f, x or z digit, either case
+    uint8_t m_value[256];  // Value of hex digit, X_OR_Z for x or z
+    static constexpr uint8_t X_OR_Z = 16;
+    VlReadMemHexTable() {
+        for (int c = 0; c < 256; ++c) {
+            const int lc = c | 0x20;  // Lower case for letters
+            m_is4StateHex[c]
+                = (c >= '0' && c <= '9') || (lc >= 'a' && lc <= 'f') || lc == 'x' || lc == 'z';
+            m_value[c] = (lc == 'x' || lc == 'z') ? X_OR_Z
+                         : (lc >= 'a')            ? (lc - 'a' + 10)
+                                                  : (c - '0');
+        }
     }
+};
+static const VlReadMemHexTable s_readmemHexTable;
+// Table lookup, as digits and letters of random data mispredict branches
+static inline bool readmemIs4StateHex(int c) VL_PURE {
+    return s_readmemHexTable.m_is4StateHex[static_cast<unsigned char>(c)];
+}
+static inline bool readmemIs4StateBin(int c) VL_PURE {
+    const int lc = c | 0x20;  // Lower case for letters
+    return c == '0' || c == '1' || lc == 'x' || lc == 'z';
 }
 bool VlReadMem::get(QData& addrr, std::string& valuer) {
-    if (VL_UNLIKELY(!m_fp)) return false;
-    valuer = "";
+    if (VL_UNLIKELY(!m_datap)) return false;
+    valuer.clear();
     // Prep for reading
     bool inData = false;
     bool ignoreToEol = false;
     bool ignoreToComment = false;
     bool readingAddress = false;
     int lastCh = ' ';
-    // Read the data
-    // We process a character at a time, as then we don't need to deal
-    // with changing buffer sizes dynamically, etc.
+    // Read the data, a character at a time, except runs of data digits
     while (true) {
-        int c = std::fgetc(m_fp);
-        if (VL_UNLIKELY(c == EOF)) break;
-        const bool chIs4StateBin
-            = c == '0' || c == '1' || c == 'x' || c == 'X' || c == 'z' || c == 'Z';
-        const bool chIs2StateHex = std::isxdigit(c);
-        const bool chIs4StateHex = std::isxdigit(c) || chIs4StateBin;
+        if (VL_UNLIKELY(m_curp >= m_endp)) break;
+        int c = static_cast<unsigned char>(*m_curp++);
+        const bool chIs4StateHex = readmemIs4StateHex(c);
+        const bool chIs2StateHex = chIs4StateHex && (c | 0x20) != 'x' && (c | 0x20) != 'z';
         // printf("%d: Got '%c' Addr%lx IN%d IgE%d IgC%d\n",
         //        m_linenum, c, m_addr, inData, ignoreToEol, ignoreToComment);
         // See if previous data value has completed, and if so return
         if (c == '_') continue;  // Ignore _ e.g. inside a number
         if (inData && !chIs4StateHex) {
             // printf("Got data @%lx = %s\n", m_addr, valuer.c_str());
-            ungetc(c, m_fp);
+            --m_curp;  // Reread terminator next time
             addrr = m_addr;
             ++m_addr;
             return true;
@@ -2133,10 +2340,34 @@ bool VlReadMem::get(QData& addrr, std::string& valuer) {
                             "$readmem address contains 4-state characters");
             } else if (chIs4StateHex) {
                 inData = true;
-                valuer += static_cast<char>(c);
-                if (VL_UNLIKELY(!m_hex && !chIs4StateBin)) {
-                    VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
-                                "$readmemb (binary) file contains hex characters");
+                // Take the rest of the digits in one step, '_' is ignored
+                const char* const startp = m_curp - 1;
+                const char* runEndp = m_curp;
+                bool anyUnderscore = false;
+                for (; runEndp < m_endp; ++runEndp) {
+                    if (*runEndp == '_') {
+                        anyUnderscore = true;
+                    } else if (!readmemIs4StateHex(*runEndp)) {
+                        break;
+                    }
+                }
+                m_curp = runEndp;
+                if (VL_LIKELY(!anyUnderscore)) {
+                    valuer.append(startp, m_curp - startp);
+                } else {
+                    for (const char* cp = startp; cp < m_curp; ++cp) {
+                        if (*cp != '_') valuer += *cp;
+                    }
+                }
+                c = valuer.back();
+                if (!m_hex) {
+                    for (const char ch : valuer) {
+                        if (VL_UNLIKELY(!readmemIs4StateBin(ch))) {
+                            VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
+                                        "$readmemb (binary) file contains hex characters");
+                            break;
+                        }
+                    }
                 }
             } else {
                 VL_FATAL_MT(m_filename.c_str(), m_linenum, "", "$readmem file syntax error");
@@ -2153,39 +2384,39 @@ bool VlReadMem::get(QData& addrr, std::string& valuer) {
     addrr = m_addr;
     return inData;  // EOF
 }
+static inline IData readmemDigit(bool hex, char c) VL_MT_SAFE {
+    const IData value = s_readmemHexTable.m_value[static_cast<unsigned char>(c)];
+    if (VL_UNLIKELY(value == VlReadMemHexTable::X_OR_Z)) return VL_RAND_RESET_I(hex ? 4 : 1);
+    return value;
+}
 void VlReadMem::setData(void* valuep, const std::string& rhs) {
-    const QData shift = m_hex ? 4ULL : 1ULL;
-    bool innum = false;
-    // Shift value in
-    for (const auto& i : rhs) {
-        const char c = std::tolower(i);
-        const int value = (c == 'x' || c == 'z') ? VL_RAND_RESET_I(m_hex ? 4 : 1)
-                          : (c >= 'a')           ? (c - 'a' + 10)
-                                                 : (c - '0');
+    if (rhs.empty()) return;
+    const int shift = m_hex ? 4 : 1;
+    if (m_bits <= VL_QUADSIZE) {
+        // Shift value in
+        QData value = 0;
+        for (const char c : rhs) value = (value << shift) + readmemDigit(m_hex, c);
+        value &= VL_MASK_Q(m_bits);
         if (m_bits <= 8) {
-            CData* const datap = reinterpret_cast<CData*>(valuep);
-            if (!innum) *datap = 0;
-            *datap = ((*datap << shift) + value) & VL_MASK_I(m_bits);
+            *reinterpret_cast<CData*>(valuep) = static_cast<CData>(value);
         } else if (m_bits <= 16) {
-            SData* const datap = reinterpret_cast<SData*>(valuep);
-            if (!innum) *datap = 0;
-            *datap = ((*datap << shift) + value) & VL_MASK_I(m_bits);
+            *reinterpret_cast<SData*>(valuep) = static_cast<SData>(value);
         } else if (m_bits <= VL_IDATASIZE) {
-            IData* const datap = reinterpret_cast<IData*>(valuep);
-            if (!innum) *datap = 0;
-            *datap = ((*datap << shift) + value) & VL_MASK_I(m_bits);
-        } else if (m_bits <= VL_QUADSIZE) {
-            QData* const datap = reinterpret_cast<QData*>(valuep);
-            if (!innum) *datap = 0;
-            *datap = ((*datap << static_cast<QData>(shift)) + static_cast<QData>(value))
-                     & VL_MASK_Q(m_bits);
+            *reinterpret_cast<IData*>(valuep) = static_cast<IData>(value);
         } else {
-            WDataOutP datap = reinterpret_cast<WDataOutP>(valuep);
-            if (!innum) VL_ZERO_W(m_bits, datap);
-            _vl_shiftl_inplace_w(m_bits, datap, static_cast<IData>(shift));
-            datap[0] |= value;
+            *reinterpret_cast<QData*>(valuep) = value;
+        }
+    } else {
+        // Place each digit at its final bit position, digits never straddle words
+        WDataOutP const datap = reinterpret_cast<WDataOutP>(valuep);
+        VL_ZERO_W(m_bits, datap);
+        int lsb = static_cast<int>(rhs.size()) * shift;
+        for (const char c : rhs) {
+            lsb -= shift;
+            const IData digit = readmemDigit(m_hex, c);
+            if (lsb < m_bits) datap[VL_BITWORD_E(lsb)] |= digit << VL_BITBIT_E(lsb);
         }
-        innum = true;
+        datap[VL_WORDS_I(m_bits) - 1] &= VL_MASK_E(m_bits);
     }
 }
 
@@ -2376,7 +2607,7 @@ void VL_WRITEMEM_N(bool hex,  // Hex format, else binary
 
 static const char* vl_time_str(int scale) VL_PURE {
     static const char* const names[]
-        = {"100s",  "10s",  "1s",  "100ms", "10ms", "1ms", "100us", "10us", "1us",
+        = {"100s", "10s", "1s", "100ms", "10ms", "1ms", "100us", "10us", "1us",
            "100ns", "10ns", "1ns", "100ps", "10ps", "1ps", "100fs", "10fs", "1fs"};
     if (VL_UNLIKELY(scale > 2 || scale < -15)) scale = 0;
     return names[2 - scale];
@@ -2564,6 +2795,12 @@ void VerilatedContext::assertOnClear(VerilatedAssertType_t types,
             m_s.m_assertOn &= ~(directives << (i * ASSERT_DIRECTIVE_TYPE_MASK_WIDTH));
     }
 }
+bool VerilatedContext::asyncOutput() const VL_MT_SAFE {
+    return VerilatedAsyncOutput::singleton().enabled();
+}
+void VerilatedContext::asyncOutput(bool flag) VL_MT_UNSAFE {
+    VerilatedAsyncOutput::singleton().enable(flag);
+}
 void VerilatedContext::calcUnusedSigs(bool flag) VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     m_s.m_calcUnusedSigs = flag;
@@ -2628,6 +2865,31 @@ void VerilatedContext::profExecWindow(uint64_t flag) VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     m_ns.m_profExecWindow = flag;
 }
+void VerilatedContext::profExecSample(uint64_t flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_profExecSample = flag;
+}
+void VerilatedContext::profExecHwCounters(bool flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_profExecHwCounters = flag;
+}
+void VerilatedContext::hugePages(bool flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_hugePages = flag;
+}
+void VerilatedContext::lowLatency(bool flag) VL_MT_SAFE {
+    if (m_ns.m_lowLatency.exchange(flag) == flag) return;
+    threadsWait(flag ? VerilatedThreadsWait::SPIN : VerilatedThreadsWait::PARK);
+#if !defined(_WIN32) && !defined(__MINGW32__)
+    if (!flag) {
+        munlockall();
+    } else if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {  // Future too, for later allocations
+        VL_PRINTF_MT("%%Warning: Low latency mode could not lock memory: %s;"
+                     " perhaps increase 'ulimit -l'\n",
+                     std::strerror(errno));
+    }
+#endif
+}
 void VerilatedContext::profExecFilename(const std::string& flag) VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     m_ns.m_profExecFilename = flag;
@@ -2757,11 +3019,25 @@ VerilatedVirtualBase* VerilatedContext::threadPoolp() {
     return m_threadPool.get();
 }
 
-void VerilatedContext::prepareClone() { delete m_threadPool.release(); }
+void VerilatedContext::threadPoolShare(VerilatedContext& other) {
+    if (m_threadPool) {
+        VL_FATAL_MT(__FILE__, __LINE__, "",
+                    "%Error: Cannot share a thread pool after the thread pool has been created.");
+    }
+    if (&other == this) return;
+    m_threads = other.m_threads;
+    if (VlThreadPool* const poolp = static_cast<VlThreadPool*>(other.threadPoolp())) {
+        poolp->shared(true);
+        m_threadPool = other.m_threadPool;
+    }
+}
+
+void VerilatedContext::prepareClone() { m_threadPool.reset(); }
 
 VerilatedVirtualBase* VerilatedContext::threadPoolpOnClone() {
-    if (VL_UNLIKELY(m_threadPool)) m_threadPool.release();
-    m_threadPool = std::unique_ptr<VlThreadPool>(new VlThreadPool{this, m_threads - 1});
+    // The pool's threads do not exist in the clone, so must never destruct it
+    if (VL_UNLIKELY(m_threadPool)) new std::shared_ptr<VerilatedVirtualBase>{m_threadPool};
+    m_threadPool.reset(new VlThreadPool{this, m_threads - 1});
     return m_threadPool.get();
 }
 
@@ -2845,7 +3121,9 @@ void VerilatedContextImp::commandArgVl(const std::string& arg) {
     if (0 == std::strncmp(arg.c_str(), "+verilator+", std::strlen("+verilator+"))) {
         std::string str;
         uint64_t u64;
-        if (commandArgVlString(arg, "+verilator+coverage+file+", str)) {
+        if (arg == "+verilator+async+output") {
+            asyncOutput(true);
+        } else if (commandArgVlString(arg, "+verilator+coverage+file+", str)) {
             coverageFilename(str);
         } else if (arg == "+verilator+debug") {
             Verilated::debug(4);
@@ -2860,12 +3138,21 @@ void VerilatedContextImp::commandArgVl(const std::string& arg) {
             VL_PRINTF_MT("For help, please see 'verilator --help'\n");
             VL_FATAL_MT("COMMAND_LINE", 0, "",
                         "Exiting due to command line argument (not an error)");
+        } else if (arg == "+verilator+hugepages") {
+            hugePages(true);
+        } else if (arg == "+verilator+low+latency") {
+            lowLatency(true);
         } else if (arg == "+verilator+noassert") {
             assertOn(false);
         } else if (commandArgVlUint64(arg, "+verilator+prof+exec+start+", u64)) {
             profExecStart(u64);
         } else if (commandArgVlUint64(arg, "+verilator+prof+exec+window+", u64, 1)) {
             profExecWindow(u64);
+        } else if (commandArgVlUint64(arg, "+verilator+prof+exec+sample+", u64, 0,
+                                      std::numeric_limits<uint32_t>::max())) {
+            profExecSample(u64);
+        } else if (arg == "+verilator+prof+exec+hwcounters") {
+            profExecHwCounters(true);
         } else if (commandArgVlString(arg, "+verilator+prof+exec+file+", str)) {
             profExecFilename(str);
         } else if (commandArgVlString(arg, "+verilator+prof+vlt+file+", str)) {
@@ -2877,6 +3164,18 @@ void VerilatedContextImp::commandArgVl(const std::string& arg) {
         } else if (commandArgVlUint64(arg, "+verilator+seed+", u64, 1,
                                       std::numeric_limits<int>::max())) {
             randSeed(static_cast<int>(u64));
+        } else if (arg == "+verilator+threads+wait+spin") {
+            threadsWait(VerilatedThreadsWait::SPIN);
+        } else if (arg == "+verilator+threads+wait+yield") {
+            threadsWait(VerilatedThreadsWait::YIELD);
+        } else if (arg == "+verilator+threads+wait+park") {
+            threadsWait(VerilatedThreadsWait::PARK);
+        } else if (arg == "+verilator+threads+adaptive+auto") {
+            threadsAdaptive(VerilatedThreadsAdaptive::AUTO);
+        } else if (arg == "+verilator+threads+adaptive+serial") {
+            threadsAdaptive(VerilatedThreadsAdaptive::SERIAL);
+        } else if (arg == "+verilator+threads+adaptive+parallel") {
+            threadsAdaptive(VerilatedThreadsAdaptive::PARALLEL);
         } else if (arg == "+verilator+V") {
             VerilatedImp::versionDump();  // Someday more info too
             VL_FATAL_MT("COMMAND_LINE", 0, "",
@@ -2977,6 +3276,104 @@ void VerilatedContext::statsPrintSummary() VL_MT_UNSAFE {
     const double modelMB = VlOs::memUsageBytes() / 1024.0 / 1024.0;
     VL_PRINTF("- Verilator: cpu %0.3f s on %u threads; alloced %0.0f MB\n", cputime,
               threadsInModels(), modelMB);
+    if (statTraceBytesMax()) {
+        VL_PRINTF("- Verilator: trace offload waited %0.3f s; buffers %0.1f MB; dropped %" PRIu64
+                  " dumps\n",
+                  statTraceStallTime(), statTraceBytesMax() / 1024.0 / 1024.0, statTraceDrops());
+    }
+    if (const uint64_t evals = statsRuntime().count(VerilatedStatsRuntime::EVALS)) {
+        VL_PRINTF("- Verilator: eval %" PRIu64 " times; per eval", evals);
+        for (int i = VerilatedStatsRuntime::ICO_ITERATIONS; i < VerilatedStatsRuntime::COUNTERS;
+             ++i) {
+            const VerilatedStatsRuntime::Counter counter
+                = static_cast<VerilatedStatsRuntime::Counter>(i);
+            if (const uint64_t count = statsRuntime().count(counter)) {
+                VL_PRINTF(" %s %0.2f", VerilatedStatsRuntime::name(counter),
+                          static_cast<double>(count) / evals);
+            }
+        }
+        VL_PRINTF("\n");
+    }
+    if (const uint64_t maxNs = statsRuntime().evalLatencyMaxNs()) {
+        VL_PRINTF("- Verilator: eval latency p50 %0.3f us; p99 %0.3f us; p99.9 %0.3f us;"
+                  " max %0.3f us\n",
+                  statsRuntime().evalLatencyNs(50) / 1e3, statsRuntime().evalLatencyNs(99) / 1e3,
+                  statsRuntime().evalLatencyNs(99.9) / 1e3, maxNs / 1e3);
+    }
+    if (void (*const cb)() = VerilatedImp::coroutineStatsCb()) cb();
+}
+double VerilatedContext::statTraceStallTime() const VL_MT_SAFE {
+    return m_ns.m_traceStallNs / 1e9;
+}
+uint64_t VerilatedContext::statTraceBytesMax() const VL_MT_SAFE { return m_ns.m_traceBytesMax; }
+uint64_t VerilatedContext::statTraceDrops() const VL_MT_SAFE { return m_ns.m_traceDrops; }
+void VerilatedContext::statTraceAdd(uint64_t stallNs, uint64_t bytes,
+                                    uint64_t drops) VL_MT_SAFE {
+    // Called by trace files, so cheap atomics, as may be several trace files per context
+    if (stallNs) m_ns.m_traceStallNs += stallNs;
+    if (drops) m_ns.m_traceDrops += drops;
+    uint64_t prev = m_ns.m_traceBytesMax;
+    while (bytes > prev && !m_ns.m_traceBytesMax.compare_exchange_weak(prev, bytes)) {}
+}
+
+//======================================================================
+// VerilatedStatsRuntime:: Methods
+
+const char* VerilatedStatsRuntime::name(Counter counter) VL_PURE {
+    static const char* const names[] = {
+        "evals",  //
+        "ico-iterations", "ico-triggered",  //
+        "act-iterations", "act-triggered",  //
+        "nba-iterations", "nba-triggered",  //
+        "obs-iterations", "obs-triggered",  //
+        "react-iterations", "react-triggered",  //
+        "nba-commits",  //
+        "timing-resumes",  //
+        "thread-waits", "thread-wait-ticks",  //
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == COUNTERS, "Counter names out of sync");
+    return names[counter];
+}
+
+uint64_t VerilatedStatsRuntime::evalStartNs() VL_MT_SAFE {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void VerilatedStatsRuntime::evalEnd(uint64_t startNs) VL_MT_SAFE {
+    const uint64_t ns = evalStartNs() - startNs;
+    // Bucket by the top LATENCY_SUB_BITS+1 bits, so each is within 1/8th
+    unsigned msb = 0;
+    for (uint64_t v = ns; v >>= 1;) ++msb;
+    const unsigned bucket
+        = msb <= LATENCY_SUB_BITS
+              ? static_cast<unsigned>(ns)
+              : (((msb - LATENCY_SUB_BITS + 1) << LATENCY_SUB_BITS)
+                 | ((ns >> (msb - LATENCY_SUB_BITS)) & ((1U << LATENCY_SUB_BITS) - 1)));
+    m_latency[bucket].fetch_add(1, std::memory_order_relaxed);
+    uint64_t prev = m_latencyMaxNs.load(std::memory_order_relaxed);
+    while (ns > prev && !m_latencyMaxNs.compare_exchange_weak(prev, ns)) {}
+}
+
+uint64_t VerilatedStatsRuntime::evalLatencyNs(double percentile) const VL_MT_SAFE {
+    uint64_t total = 0;
+    for (const std::atomic<uint64_t>& bucket : m_latency) total += bucket.load();
+    if (!total) return 0;
+    const double target = std::max(1.0, std::ceil(total * percentile / 100.0));
+    uint64_t seen = 0;
+    for (unsigned bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+        seen += m_latency[bucket].load();
+        if (seen < target) continue;
+        if (bucket < (2U << LATENCY_SUB_BITS)) return bucket;
+        // Upper end of the bucket, but no more than the maximum seen
+        const unsigned shift = (bucket >> LATENCY_SUB_BITS) - 1;
+        const uint64_t mantissa
+            = (1U << LATENCY_SUB_BITS) | (bucket & ((1U << LATENCY_SUB_BITS) - 1));
+        const uint64_t upper = ((mantissa + 1) << shift) - 1;
+        return std::min(upper, evalLatencyMaxNs());
+    }
+    return evalLatencyMaxNs();
 }
 
 //======================================================================
@@ -2997,6 +3394,7 @@ void VerilatedContextImp::scopeInsert(const VerilatedScope* scopep) VL_MT_SAFE {
     const VerilatedLockGuard lock{m_impdatap->m_nameMutex};
     const auto it = m_impdatap->m_nameMap.find(scopep->name());
     if (it == m_impdatap->m_nameMap.end()) m_impdatap->m_nameMap.emplace(scopep->name(), scopep);
+    m_impdatap->m_scopeGeneration.fetch_add(1, std::memory_order_release);
 }
 void VerilatedContextImp::scopeErase(const VerilatedScope* scopep) VL_MT_SAFE {
     // Slow ok - called once/scope at destruction
@@ -3004,6 +3402,7 @@ void VerilatedContextImp::scopeErase(const VerilatedScope* scopep) VL_MT_SAFE {
     VerilatedImp::userEraseScope(scopep);
     const auto it = m_impdatap->m_nameMap.find(scopep->name());
     if (it != m_impdatap->m_nameMap.end()) m_impdatap->m_nameMap.erase(it);
+    m_impdatap->m_scopeGeneration.fetch_add(1, std::memory_order_release);
 }
 const VerilatedScope* VerilatedContext::scopeFind(const char* namep) const VL_MT_SAFE {
     // Thread save only assuming this is called only after model construction completed
@@ -3063,6 +3462,43 @@ VerilatedSyms::~VerilatedSyms() {
     delete __Vm_evalMsgQp;
 }
 
+void* VerilatedSyms::allocate(size_t size, size_t align, VerilatedContext* contextp) {
+    if (align < alignof(std::max_align_t)) align = alignof(std::max_align_t);
+    void* objp = nullptr;
+#if defined(_WIN32) || defined(__MINGW32__)
+    (void)contextp;
+    objp = _aligned_malloc(size, align);
+#else
+#ifdef MADV_HUGEPAGE
+    if (!contextp) contextp = Verilated::threadContextp();
+    constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+    // Only worth it when at least a page is used, as the rest of the last page is wasted
+    if (contextp->hugePages() && size >= HUGE_PAGE && align <= HUGE_PAGE) {
+        const size_t alignedSize = (size + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1);
+        if (0 == posix_memalign(&objp, HUGE_PAGE, alignedSize)) {
+            // Just advice, if transparent huge pages are disabled the memory is still usable
+            madvise(objp, alignedSize, MADV_HUGEPAGE);
+        } else {
+            objp = nullptr;  // Fall back to normal allocation
+        }
+    }
+#else
+    (void)contextp;
+#endif
+    if (!objp && 0 != posix_memalign(&objp, align, size)) objp = nullptr;
+#endif
+    if (VL_UNLIKELY(!objp)) throw std::bad_alloc{};
+    return objp;
+}
+
+void VerilatedSyms::deallocate(void* objp) VL_MT_SAFE {
+#if defined(_WIN32) || defined(__MINGW32__)
+    _aligned_free(objp);
+#else
+    std::free(objp);
+#endif
+}
+
 //===========================================================================
 // Verilated:: Methods
 
@@ -3151,6 +3587,7 @@ void Verilated::runFlushCallbacks() VL_MT_SAFE {
         runCallbacks(VlCbStatic.s_flushCbs);
     }
     --s_recursing;
+    VerilatedAsyncOutput::drainIfEnabled();
     std::fflush(stderr);
     std::fflush(stdout);
     // When running internal code coverage (gcc --coverage, as opposed to
@@ -3252,6 +3689,13 @@ void Verilated::quiesce() VL_MT_SAFE {
     // THREADED-TODO
 }
 
+VerilatedImp::ExportCacheEntry& VerilatedImp::exportCacheEntry(const char* namep) VL_MT_SAFE {
+    // Names are string literals in the models, so are compared by pointer
+    static constexpr size_t SIZE = 64;  // Entries, power of 2
+    static thread_local ExportCacheEntry t_cache[SIZE];
+    return t_cache[(reinterpret_cast<uintptr_t>(namep) >> 3) & (SIZE - 1)];
+}
+
 int Verilated::exportFuncNum(const char* namep) VL_MT_SAFE {
     return VerilatedImp::exportFind(namep);
 }
@@ -3420,6 +3864,14 @@ void VerilatedScope::varInsert(int finalize, const char* namep, void* datap, boo
     m_varsp->emplace(namep, var);
 }
 
+void VerilatedScope::varChangedInsert(int finalize, const char* namep,
+                                      CData* changedp) VL_MT_UNSAFE {
+    // Flag the model sets when writing the variable, see VerilatedVpi::callValueCbs
+    if (!finalize || !m_varsp) return;
+    const auto it = m_varsp->find(namep);
+    if (VL_LIKELY(it != m_varsp->end())) it->second.m_changedp = changedp;
+}
+
 // cppcheck-suppress unusedFunction  // Used by applications
 VerilatedVar* VerilatedScope::varFind(const char* namep) const VL_MT_SAFE_POSTINIT {
     if (VL_LIKELY(m_varsp)) {
@@ -3448,6 +3900,16 @@ void* VerilatedScope::exportFindError(int funcnum) const VL_MT_SAFE {
     return nullptr;
 }
 
+int VerilatedScope::exportResolve(const VerilatedScope* scopep, int funcnum,
+                                  VlDpiExportHandle* handlep) VL_MT_SAFE {
+    handlep->scopep = scopep;
+    handlep->cbp = nullptr;
+    if (scopep && funcnum >= 0 && funcnum < scopep->m_funcnumMax) {
+        handlep->cbp = scopep->m_callbacksp[funcnum];
+    }
+    return handlep->cbp != nullptr;
+}
+
 void VerilatedScope::scopeDump() const {
     VL_PRINTF_MT("    SCOPE %p: %s\n", this, name());
     for (int i = 0; i < m_funcnumMax; ++i) {
@@ -3462,11 +3924,11 @@ void VerilatedScope::scopeDump() const {
 }
 
 void VerilatedHierarchy::add(VerilatedScope* fromp, VerilatedScope* top) {
-    VerilatedImp::hierarchyAdd(fromp, top);
+    top->symsp()->_vm_contextp__->impp()->hierarchyAdd(fromp, top);
 }
 
 void VerilatedHierarchy::remove(VerilatedScope* fromp, VerilatedScope* top) {
-    VerilatedImp::hierarchyRemove(fromp, top);
+    top->symsp()->_vm_contextp__->impp()->hierarchyRemove(fromp, top);
 }
 
 //===========================================================================
@@ -3483,7 +3945,28 @@ void VerilatedAssertOneThread::fatal_different() VL_MT_SAFE {
 //===========================================================================
 // VlDeleter:: Methods
 
+VlDeleter::~VlDeleter() {
+    deleteAll();
+    for (std::vector<void*>& freeList : m_pool) {
+        for (void* const memp : freeList) ::operator delete(memp);
+    }
+}
+
+void VlDeleter::deleteSerial() {
+    std::vector<VlDeletable*> deleteNow;
+    while (!m_serialGarbage.empty()) {
+        // Destructors may enqueue new objects
+        std::swap(m_serialGarbage, deleteNow);
+        for (VlDeletable* const objp : deleteNow) destroy(objp);
+        deleteNow.clear();
+    }
+}
+
 void VlDeleter::deleteAll() VL_EXCLUDES(m_mutex) VL_EXCLUDES(m_deleteMutex) VL_MT_SAFE {
+    if (m_serial) {
+        deleteSerial();
+        return;
+    }
     while (true) {
         {
             VerilatedLockGuard lock{m_mutex};
@@ -3492,7 +3975,7 @@ void VlDeleter::deleteAll() VL_EXCLUDES(m_mutex) VL_EXCLUDES(m_deleteMutex) VL_M
             std::swap(m_newGarbage, m_deleteNow);
             // m_mutex is unlocked here, so destructors can enqueue new objects
         }
-        for (VlDeletable* const objp : m_deleteNow) delete objp;
+        for (VlDeletable* const objp : m_deleteNow) destroy(objp);
         m_deleteNow.clear();
         m_deleteMutex.unlock();
     }
@@ -58,6 +58,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <new>
 #include <set>
 #include <string>
 #include <unordered_set>
@@ -172,6 +173,19 @@ enum class VerilatedAssertDirectiveType : uint8_t {
     DIRECTIVE_TYPE_COVER = (1 << 1),
     DIRECTIVE_TYPE_ASSUME = (1 << 2),
 };
+// How threads wait for other threads, see VerilatedContext::threadsWait
+enum class VerilatedThreadsWait : uint8_t {
+    SPIN = 0,  // Busy-wait only; lowest latency on dedicated hosts
+    YIELD = 1,  // Busy-wait, then yield the processor
+    PARK = 2,  // Busy-wait, then sleep until woken (futex on Linux, otherwise as YIELD)
+};
+// Which schedule --threads-adaptive models run, see VerilatedContext::threadsAdaptive
+enum class VerilatedThreadsAdaptive : uint8_t {
+    AUTO = 0,  // Time both schedules during warm-up, then keep the faster
+    SERIAL = 1,  // Always run mtasks on the evaluating thread
+    PARALLEL = 2,  // Always run mtasks on the thread pool
+};
+
 using VerilatedAssertType_t = std::underlying_type<VerilatedAssertType>::type;
 using VerilatedAssertDirectiveType_t = std::underlying_type<VerilatedAssertDirectiveType>::type;
 
@@ -341,6 +355,84 @@ public:
 #endif
 // clang-format on
 
+//===========================================================================
+/// Runtime evaluation statistics
+///
+/// Counters of the scheduling work done by the eval() of models Verilated
+/// with --stats-runtime, summed over all such models in a context. Access
+/// with VerilatedContext::statsRuntime(). The counters remain zero for
+/// models Verilated without --stats-runtime.
+
+class VerilatedStatsRuntime final {
+public:
+    // TYPES
+    enum Counter : uint8_t {
+        EVALS = 0,  ///< Calls to eval (or eval_step, or tick)
+        ICO_ITERATIONS,  ///< Iterations of the 'ico' (input combinational) region loop
+        ICO_TRIGGERED,  ///< Iterations of the 'ico' loop with a trigger fired
+        ACT_ITERATIONS,  ///< Iterations of the 'act' (active) region loop
+        ACT_TRIGGERED,  ///< Iterations of the 'act' loop with a trigger fired
+        NBA_ITERATIONS,  ///< Iterations of the 'nba' region loop
+        NBA_TRIGGERED,  ///< Iterations of the 'nba' loop with a trigger fired
+        OBS_ITERATIONS,  ///< Iterations of the 'obs' (observed) region loop
+        OBS_TRIGGERED,  ///< Iterations of the 'obs' loop with a trigger fired
+        REACT_ITERATIONS,  ///< Iterations of the 'react' (reactive) region loop
+        REACT_TRIGGERED,  ///< Iterations of the 'react' loop with a trigger fired
+        NBA_COMMITS,  ///< Commits of dynamically scheduled (timing) NBAs
+        TIMING_RESUMES,  ///< Resumptions of processes waiting on triggers
+        THREAD_WAITS,  ///< Mtask waits for dependencies run by other threads
+        THREAD_WAIT_TICKS,  ///< CPU ticks (as VL_CPU_TICK) spent in such waits
+        COUNTERS  ///< Number of counters
+    };
+
+    // Evaluation latency histogram, with 2^LATENCY_SUB_BITS buckets per power of two
+    static constexpr unsigned LATENCY_SUB_BITS = 3;
+    static constexpr unsigned LATENCY_BUCKETS = (64 - LATENCY_SUB_BITS + 1) << LATENCY_SUB_BITS;
+
+private:
+    // MEMBERS
+    std::atomic<uint64_t> m_counters[COUNTERS];
+    std::atomic<uint64_t> m_latency[LATENCY_BUCKETS];  // Evaluations by latency bucket
+    std::atomic<uint64_t> m_latencyMaxNs;  // Longest evaluation latency
+
+public:
+    // CONSTRUCTORS
+    VerilatedStatsRuntime() { clear(); }
+    ~VerilatedStatsRuntime() = default;
+    VL_UNCOPYABLE(VerilatedStatsRuntime);
+
+    // METHODS
+    /// Return the value of a counter
+    uint64_t count(Counter counter) const VL_MT_SAFE {
+        return m_counters[counter].load(std::memory_order_relaxed);
+    }
+    /// Return the name of a counter, as used by VerilatedContext::statsPrintSummary
+    static const char* name(Counter counter) VL_PURE;
+    /// Return the latency in nanoseconds within which the given percentage
+    /// of evaluations completed, e.g. 99.0 for the 99th percentile, to
+    /// within one part in 2^LATENCY_SUB_BITS. Zero if none were timed.
+    uint64_t evalLatencyNs(double percentile) const VL_MT_SAFE;
+    /// Return the longest evaluation latency in nanoseconds
+    uint64_t evalLatencyMaxNs() const VL_MT_SAFE {
+        return m_latencyMaxNs.load(std::memory_order_relaxed);
+    }
+    /// Zero all counters
+    void clear() VL_MT_SAFE {
+        for (std::atomic<uint64_t>& counter : m_counters) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (std::atomic<uint64_t>& bucket : m_latency) bucket.store(0, std::memory_order_relaxed);
+        m_latencyMaxNs.store(0, std::memory_order_relaxed);
+    }
+    // Internal: Called by Verilated models
+    void add(Counter counter, uint64_t value = 1) VL_MT_SAFE {
+        m_counters[counter].fetch_add(value, std::memory_order_relaxed);
+    }
+    // Internal: Called by Verilated models around each evaluation
+    static uint64_t evalStartNs() VL_MT_SAFE;
+    void evalEnd(uint64_t startNs) VL_MT_SAFE;
+};
+
 //===========================================================================
 // Internal: Base class to allow virtual destruction
 
@@ -426,6 +518,14 @@ protected:
         // Fast path
         uint64_t m_profExecStart = 1;  // +prof+exec+start time
         uint32_t m_profExecWindow = 2;  // +prof+exec+window size
+        uint32_t m_profExecSample = 0;  // +prof+exec+sample rate, 0 = off
+        bool m_profExecHwCounters = false;  // +prof+exec+hwcounters
+        bool m_hugePages = false;  // +verilator+hugepages
+        // +threads+wait policy
+        std::atomic<VerilatedThreadsWait> m_threadsWait{VerilatedThreadsWait::PARK};
+        std::atomic<bool> m_lowLatency{false};  // +verilator+low+latency
+        // +threads+adaptive schedule choice
+        std::atomic<VerilatedThreadsAdaptive> m_threadsAdaptive{VerilatedThreadsAdaptive::AUTO};
         // Slow path
         std::string m_coverageFilename;  // +coverage+file filename
         std::string m_profExecFilename;  // +prof+exec+file filename
@@ -434,6 +534,10 @@ protected:
         VlOs::DeltaCpuTime m_cpuTimeStart{false};  // CPU time, starts when create first model
         VlOs::DeltaWallTime m_wallTimeStart{false};  // Wall time, starts when create first model
         std::vector<traceBaseModelCb_t> m_traceBaseModelCbs;  // Callbacks to traceRegisterModel
+        std::atomic<uint64_t> m_traceStallNs{0};  // Trace offload wait time
+        std::atomic<uint64_t> m_traceBytesMax{0};  // Trace offload buffers high water mark
+        std::atomic<uint64_t> m_traceDrops{0};  // Trace offload dumps dropped
+        VerilatedStatsRuntime m_statsRuntime;  // --stats-runtime counters
     } m_ns;
 
     mutable VerilatedMutex m_argMutex;  // Protect m_argVec, m_argVecLoaded
@@ -452,7 +556,7 @@ protected:
     // Number of threads in added models
     unsigned m_threadsInModels = 0;
     // The thread pool shared by all models added to this context
-    std::unique_ptr<VerilatedVirtualBase> m_threadPool;
+    std::shared_ptr<VerilatedVirtualBase> m_threadPool;
     // The execution profiler shared by all models added to this context
     std::unique_ptr<VerilatedVirtualBase> m_executionProfiler;
     // Coverage access
@@ -495,6 +599,13 @@ public:
     /// Clear enabled status for given assertion types
     void assertOnClear(VerilatedAssertType_t types,
                        VerilatedAssertDirectiveType_t directives) VL_MT_SAFE;
+    /// Return if $display/$fwrite output is written by a separate I/O thread
+    bool asyncOutput() const VL_MT_SAFE;
+    /// Enable writing $display/$fwrite output by a separate I/O thread.
+    /// This setting is process-wide, shared by all contexts. Output is
+    /// written in order, and flushed on $fflush, $finish, $stop, errors,
+    /// and when the process exits.
+    void asyncOutput(bool flag) VL_MT_UNSAFE;
     /// Return if calculating of unused signals (for traces)
     bool calcUnusedSigs() const VL_MT_SAFE { return m_s.m_calcUnusedSigs; }
     /// Enable calculation of unused signals (for traces)
@@ -547,6 +658,10 @@ public:
     bool quiet() const VL_MT_SAFE { return m_s.m_quiet; }
     /// Enable quiet (also prevents need for OS calls to get CPU time)
     void quiet(bool flag) VL_MT_SAFE;
+    /// Return if models are allocated on huge pages
+    bool hugePages() const VL_MT_SAFE { return m_ns.m_hugePages; }
+    /// Set to allocate models constructed afterwards on huge pages, where supported
+    void hugePages(bool flag) VL_MT_SAFE;
     /// Return randReset value
     int randReset() VL_MT_SAFE { return m_s.m_randReset; }
     /// Select initial value of otherwise uninitialized signals.
@@ -563,6 +678,15 @@ public:
     double statCpuTimeSinceStart() const VL_MT_SAFE_EXCLUDES(m_mutex);
     /// Return statistic: Wall time delta from model created until now
     double statWallTimeSinceStart() const VL_MT_SAFE_EXCLUDES(m_mutex);
+    /// Return statistic: Seconds trace dumps waited for the offload thread
+    double statTraceStallTime() const VL_MT_SAFE;
+    /// Return statistic: Most bytes of trace buffers held by the offload thread
+    uint64_t statTraceBytesMax() const VL_MT_SAFE;
+    /// Return statistic: Number of trace dumps dropped as the offload thread fell behind
+    uint64_t statTraceDrops() const VL_MT_SAFE;
+    /// Return statistics: Evaluation counters of models Verilated with --stats-runtime
+    VerilatedStatsRuntime& statsRuntime() VL_MT_SAFE { return m_ns.m_statsRuntime; }
+    const VerilatedStatsRuntime& statsRuntime() const VL_MT_SAFE { return m_ns.m_statsRuntime; }
     /// Print statistics summary (if not quiet)
     void statsPrintSummary() VL_MT_UNSAFE;
 
@@ -614,6 +738,36 @@ public:
     /// Set number of threads used for simulation (including the main thread)
     /// Can only be called before the thread pool is created (before first model is added).
     void threads(unsigned n);
+    /// Use the thread pool of another context, instead of creating a new
+    /// one. Models in all contexts sharing a pool take turns on the pool's
+    /// threads, so the pool is not oversubscribed. The thread count is taken
+    /// from the other context.
+    /// Can only be called before the thread pool is created (before first model is added).
+    void threadPoolShare(VerilatedContext& other);
+    /// Get how threads wait for dependencies from other threads
+    VerilatedThreadsWait threadsWait() const VL_MT_SAFE {
+        return m_ns.m_threadsWait.load(std::memory_order_relaxed);
+    }
+    /// Set how threads wait for dependencies from other threads
+    void threadsWait(VerilatedThreadsWait policy) VL_MT_SAFE {
+        m_ns.m_threadsWait.store(policy, std::memory_order_relaxed);
+    }
+    /// Get if configured for lowest evaluation latency, see lowLatency(bool)
+    bool lowLatency() const VL_MT_SAFE { return m_ns.m_lowLatency.load(); }
+    /// Configure for lowest evaluation latency rather than throughput, e.g.
+    /// when co-simulating with hardware. Threads busy-wait as with
+    /// threadsWait(SPIN), and on POSIX hosts the process's memory is locked
+    /// so evaluation never waits for paging.
+    void lowLatency(bool flag) VL_MT_SAFE;
+    /// Get which schedule models Verilated with --threads-adaptive run
+    VerilatedThreadsAdaptive threadsAdaptive() const VL_MT_SAFE {
+        return m_ns.m_threadsAdaptive.load(std::memory_order_relaxed);
+    }
+    /// Set which schedule models Verilated with --threads-adaptive run.
+    /// Setting AUTO restarts the warm-up measurement on the next evaluation.
+    void threadsAdaptive(VerilatedThreadsAdaptive mode) VL_MT_SAFE {
+        m_ns.m_threadsAdaptive.store(mode, std::memory_order_relaxed);
+    }
 
     /// Trace signals in models within the context; called by application code
     void trace(VerilatedTraceBaseC* tfp, int levels, int options = 0);
@@ -662,6 +816,10 @@ public:
     void profExecStart(uint64_t flag) VL_MT_SAFE;
     uint32_t profExecWindow() const VL_MT_SAFE { return m_ns.m_profExecWindow; }
     void profExecWindow(uint64_t flag) VL_MT_SAFE;
+    uint32_t profExecSample() const VL_MT_SAFE { return m_ns.m_profExecSample; }
+    void profExecSample(uint64_t flag) VL_MT_SAFE;
+    bool profExecHwCounters() const VL_MT_SAFE { return m_ns.m_profExecHwCounters; }
+    void profExecHwCounters(bool flag) VL_MT_SAFE;
     std::string profExecFilename() const VL_MT_SAFE;
     void profExecFilename(const std::string& flag) VL_MT_SAFE;
     std::string profVltFilename() const VL_MT_SAFE;
@@ -681,6 +839,7 @@ public:
 
     // Internal: trace registration
     void traceBaseModelCbAdd(traceBaseModelCb_t cb) VL_MT_SAFE;
+    void statTraceAdd(uint64_t stallNs, uint64_t bytes, uint64_t drops) VL_MT_SAFE;
 
     // Internal: Check magic number
     static void checkMagic(const VerilatedContext* contextp);
@@ -700,8 +859,38 @@ public:  // But for internal use only
     explicit VerilatedSyms(VerilatedContext* contextp);  // Pass null for default context
     ~VerilatedSyms();
     VL_UNCOPYABLE(VerilatedSyms);
+    // Allocate the model's symbol table, which contains all module instances, on huge pages if
+    // VerilatedContext::hugePages()
+    static void* allocate(size_t size, size_t align, VerilatedContext* contextp);
+    static void deallocate(void* objp) VL_MT_SAFE;
+    static void* operator new(size_t size, VerilatedContext* contextp) {
+        return allocate(size, VL_CACHE_LINE_BYTES, contextp);
+    }
+    static void operator delete(void* objp, VerilatedContext*) { deallocate(objp); }
+    static void operator delete(void* objp) { deallocate(objp); }
+#ifdef __cpp_aligned_new
+    static void* operator new(size_t size, std::align_val_t align, VerilatedContext* contextp) {
+        return allocate(size, static_cast<size_t>(align), contextp);
+    }
+    static void operator delete(void* objp, std::align_val_t, VerilatedContext*) {
+        deallocate(objp);
+    }
+    static void operator delete(void* objp, std::align_val_t) { deallocate(objp); }
+#endif
 };
 
+//===========================================================================
+// DPI export function resolved in a scope, see --dpi-export-handles.
+// The same definition is in each __Dpi.h, for C code.
+
+#ifndef VL_DPI_EXPORT_HANDLE_DEFINED_
+#define VL_DPI_EXPORT_HANDLE_DEFINED_
+typedef struct VlDpiExportHandle {
+    const void* scopep;  // VerilatedScope the export was resolved in
+    void* cbp;  // Export callback in that scope
+} VlDpiExportHandle;
+#endif
+
 //===========================================================================
 // Verilator scope information class
 // Used for internal VPI implementation, and introspection into scopes
@@ -735,6 +924,7 @@ public:  // But internals only - called from VerilatedModule's
     void exportInsert(int finalize, const char* namep, void* cb) VL_MT_UNSAFE;
     void varInsert(int finalize, const char* namep, void* datap, bool isParam,
                    VerilatedVarType vltype, int vlflags, int udims, int pdims, ...) VL_MT_UNSAFE;
+    void varChangedInsert(int finalize, const char* namep, CData* changedp) VL_MT_UNSAFE;
     // ACCESSORS
     const char* name() const VL_MT_SAFE_POSTINIT { return m_namep; }
     const char* identifier() const VL_MT_SAFE_POSTINIT { return m_identifierp; }
@@ -755,6 +945,9 @@ public:  // But internals only - called from VerilatedModule's
             return scopep->exportFindError(funcnum);  // LCOV_EXCL_LINE
         }
     }
+    // Resolve the export into the handle, return 0 if it is not in the scope
+    static int exportResolve(const VerilatedScope* scopep, int funcnum,
+                             VlDpiExportHandle* handlep) VL_MT_SAFE;
     Type type() const { return m_type; }
 };
 
@@ -789,6 +982,7 @@ class Verilated final {
         // Fast path
         VerilatedContext* t_contextp = nullptr;  // Thread's context
         uint32_t t_mtaskId = 0;  // mtask# executing on this thread
+        uint32_t t_coverSlot = 0;  // Coverage counter block written by this thread
         // Messages maybe pending on thread, needs end-of-eval calls
         uint32_t t_endOfEvalReqd = 0;
         const VerilatedScope* t_dpiScopep = nullptr;  // DPI context scope
@@ -1005,6 +1199,9 @@ public:
     // Per thread, so no need to be in VerilatedContext
     static uint32_t mtaskId() VL_MT_SAFE { return t_s.t_mtaskId; }
     static void mtaskId(uint32_t id) VL_MT_SAFE { t_s.t_mtaskId = id; }
+    // Internal: Set the coverage counter block, called when a thread function starts
+    static uint32_t coverSlot() VL_MT_SAFE { return t_s.t_coverSlot; }
+    static void coverSlot(uint32_t slot) VL_MT_SAFE { t_s.t_coverSlot = slot; }
     static void endOfEvalReqdInc() VL_MT_SAFE { ++t_s.t_endOfEvalReqd; }
     static void endOfEvalReqdDec() VL_MT_SAFE { --t_s.t_endOfEvalReqd; }
 
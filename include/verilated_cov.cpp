@@ -28,10 +28,13 @@
 #include "verilated.h"
 #include "verilated_cov_key.h"
 
+#include <cstring>
 #include <deque>
 #include <fstream>
 #include <map>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 //=============================================================================
 // VerilatedCovConst
@@ -90,6 +93,38 @@ public:
     ~VerilatedCoverItemSpec() override = default;
 };
 
+//=============================================================================
+// VerilatedCoverItemBlocks
+// Point counted in one block of counters per thread, summed when read
+
+class VerilatedCoverItemBlocks final : public VerilatedCovImpItem {
+private:
+    // MEMBERS
+    uint32_t* m_countp;  // Count value in first block
+    size_t m_blocks;  // Number of blocks
+    size_t m_stride;  // Counters between blocks
+    bool m_saturate;  // Count is only if any thread counted
+public:
+    // METHODS
+    uint64_t count() const override {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < m_blocks; ++i) sum += m_countp[i * m_stride];
+        return m_saturate ? (sum != 0) : sum;
+    }
+    void zero() const override {
+        for (size_t i = 0; i < m_blocks; ++i) m_countp[i * m_stride] = 0;
+    }
+    // CONSTRUCTORS
+    VerilatedCoverItemBlocks(uint32_t* countp, size_t blocks, size_t stride, bool saturate)
+        : m_countp{countp}
+        , m_blocks{blocks}
+        , m_stride{stride}
+        , m_saturate{saturate} {
+        zero();
+    }
+    ~VerilatedCoverItemBlocks() override = default;
+};
+
 //=============================================================================
 // VerilatedCovImp
 //
@@ -101,7 +136,7 @@ public:
 class VerilatedCovImp final : public VerilatedCovContext {
 private:
     // TYPES
-    using ValueIndexMap = std::map<const std::string, int>;
+    using ValueIndexMap = std::unordered_map<std::string, int>;
     using IndexValueMap = std::map<int, std::string>;
     using ItemList = std::deque<VerilatedCovImpItem*>;
 
@@ -140,6 +175,15 @@ private:
         m_indexValues.emplace(m_nextIndex, value);
         return m_nextIndex;
     }
+    int valueIndexCached(const char*& lastp, int& lastIndex, const char* valp)
+        VL_REQUIRES(m_mutex) {
+        // Index of valp, if same pointer as lastp, reuse lastIndex
+        if (lastp != valp) {
+            lastp = valp;
+            lastIndex = valueIndex(valp);
+        }
+        return lastIndex;
+    }
     static std::string dequote(const std::string& text) VL_PURE {
         // Quote any special characters
         std::string rtn;
@@ -245,6 +289,28 @@ private:
         SELF_CHECK(combineHier("1.2.3.a", "9.8.7.a"), "*.a");
 #undef SELF_CHECK
     }
+    static void
+    writeBinary(std::ofstream& os,
+                const std::map<const std::string, std::pair<std::string, uint64_t>>& eventCounts)
+        VL_MT_SAFE {
+        // Header, then table of point names each with a terminating NUL,
+        // then dense array of counts, so tools may find all names then all counts
+        // without parsing. See VlcTop::readCoverageBinary.
+        std::string names;
+        std::vector<uint64_t> counts;
+        counts.reserve(eventCounts.size());
+        for (const auto& i : eventCounts) {
+            names += i.first;
+            if (!i.second.first.empty()) names += keyValueFormatter(VL_CIK_HIER, i.second.first);
+            names += '\0';
+            counts.push_back(i.second.second);
+        }
+        const uint64_t sizes[2] = {counts.size(), names.size()};
+        os.write(VL_COVERAGE_BINARY_MAGIC, std::strlen(VL_COVERAGE_BINARY_MAGIC));
+        os.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+        os.write(names.data(), names.size());
+        os.write(reinterpret_cast<const char*>(counts.data()), counts.size() * sizeof(uint64_t));
+    }
     void clearGuts() VL_REQUIRES(m_mutex) {
         for (const auto& itemp : m_items) VL_DO_DANGLING(delete itemp, itemp);
         m_items.clear();
@@ -356,19 +422,71 @@ public:
         // Prepare for next
         m_insertp = nullptr;
     }
+    void insertTable(const char* hierp, uint32_t* countsp, bool enable,
+                     const VerilatedCovPoint* pointsp, size_t npoints, size_t blocks,
+                     size_t stride, bool saturateToggle) VL_MT_SAFE_EXCLUDES(m_mutex) {
+        // Used for second++ instantiation of identical bin
+        static uint32_t s_zeroCount = 0;
+        const VerilatedLockGuard lock{m_mutex};
+        // Same keys, in same order, as insertp would give the points.
+        // Tables repeat filenames etc., so remember the last index of each.
+        const int keyFilename = valueIndex("filename");
+        const int keyLineno = valueIndex("lineno");
+        const int keyColumn = valueIndex("column");
+        const int keyHier = valueIndex("hier");
+        const int keyPage = valueIndex("page");
+        const int keyComment = valueIndex("comment");
+        const int keyLinescov = valueIndex("linescov");
+        const char* lastps[4] = {nullptr, nullptr, nullptr, nullptr};
+        int lastIndexes[4] = {0, 0, 0, 0};
+        std::string fullhier;
+        for (size_t i = 0; i < npoints; ++i) {
+            const VerilatedCovPoint& point = pointsp[i];
+            VerilatedCovImpItem* itemp;
+            if (!enable) {
+                itemp = new VerilatedCoverItemSpec<uint32_t>{&s_zeroCount};
+            } else if (blocks > 1) {
+                const bool saturate
+                    = saturateToggle && !std::strncmp(point.m_pagep, "v_toggle", 8);
+                itemp = new VerilatedCoverItemBlocks{&countsp[point.m_bin], blocks, stride,
+                                                     saturate};
+            } else {
+                itemp = new VerilatedCoverItemSpec<uint32_t>{&countsp[point.m_bin]};
+            }
+            int k = 0;
+            const auto add = [&](int key, int val) {
+                itemp->m_keys[k] = key;
+                itemp->m_vals[k] = val;
+                ++k;
+            };
+            add(keyFilename, valueIndexCached(lastps[0], lastIndexes[0], point.m_filenamep));
+            add(keyLineno, valueIndex(std::to_string(point.m_lineno)));
+            add(keyColumn, valueIndex(std::to_string(point.m_column)));
+            fullhier = hierp;
+            fullhier += point.m_hierp;
+            if (!fullhier.empty() && fullhier[0] == '.') fullhier.erase(0, 1);
+            add(keyHier, valueIndex(fullhier));
+            add(keyPage, valueIndexCached(lastps[1], lastIndexes[1], point.m_pagep));
+            add(keyComment, valueIndexCached(lastps[2], lastIndexes[2], point.m_commentp));
+            if (point.m_linescovp[0]) {
+                add(keyLinescov, valueIndexCached(lastps[3], lastIndexes[3], point.m_linescovp));
+            }
+            m_items.push_back(itemp);
+        }
+    }
 
-    void write(const std::string& filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
+    void write(const std::string& filename, bool binary) VL_MT_SAFE_EXCLUDES(m_mutex) {
         Verilated::quiesce();
         const VerilatedLockGuard lock{m_mutex};
         selftest();
 
-        std::ofstream os{filename};
+        std::ofstream os{filename, binary ? std::ios::out | std::ios::binary : std::ios::out};
         if (os.fail()) {
             const std::string msg = "%Error: Can't write '"s + filename + "'";
             VL_FATAL_MT("", 0, "", msg.c_str());
             return;
         }
-        os << "# SystemC::Coverage-3\n";
+        if (!binary) os << "# SystemC::Coverage-3\n";
 
         // Build list of events; totalize if collapsing hierarchy
         std::map<const std::string, std::pair<std::string, uint64_t>> eventCounts;
@@ -415,6 +533,11 @@ public:
             }
         }
 
+        if (binary) {
+            writeBinary(os, eventCounts);
+            return;
+        }
+
         // Output body
         for (const auto& i : eventCounts) {
             os << "C '" << std::dec;
@@ -439,7 +562,10 @@ void VerilatedCovContext::clearNonMatch(const char* matchp) VL_MT_SAFE {
 }
 void VerilatedCovContext::zero() VL_MT_SAFE { impp()->zero(); }
 void VerilatedCovContext::write(const std::string& filename) VL_MT_SAFE {
-    impp()->write(filename);
+    impp()->write(filename, false);
+}
+void VerilatedCovContext::writeBinary(const std::string& filename) VL_MT_SAFE {
+    impp()->write(filename, true);
 }
 void VerilatedCovContext::_inserti(uint32_t* itemp) VL_MT_SAFE {
     impp()->inserti(new VerilatedCoverItemSpec<uint32_t>{itemp});
@@ -450,6 +576,18 @@ void VerilatedCovContext::_inserti(uint64_t* itemp) VL_MT_SAFE {
 void VerilatedCovContext::_insertf(const char* filename, int lineno) VL_MT_SAFE {
     impp()->insertf(filename, lineno);
 }
+void VerilatedCovContext::_insertTable(const char* hierp, uint32_t* countsp, bool enable,
+                                       const VerilatedCovPoint* pointsp,
+                                       size_t npoints) VL_MT_SAFE {
+    impp()->insertTable(hierp, countsp, enable, pointsp, npoints, 1, 0, false);
+}
+void VerilatedCovContext::_insertTable(const char* hierp, uint32_t* countsp, bool enable,
+                                       const VerilatedCovPoint* pointsp, size_t npoints,
+                                       size_t blocks, size_t stride,
+                                       bool saturateToggle) VL_MT_SAFE {
+    impp()->insertTable(hierp, countsp, enable, pointsp, npoints, blocks, stride,
+                        saturateToggle);
+}
 
 #ifndef DOXYGEN
 #define K(n) const char* key##n
@@ -75,6 +75,53 @@ class VerilatedCovImp;
         ccontextp->_insertp("hier", name, __VA_ARGS__); \
     } while (false)
 
+//=============================================================================
+//  VerilatedCovPoint
+/// Internal: Coverage point in a table emitted by Verilator, for
+/// VerilatedCovContext::_insertTable
+
+struct VerilatedCovPoint final {
+    uint32_t m_bin;  // Index of point's counter
+    int m_lineno;  // Line number
+    int m_column;  // Column number
+    const char* m_filenamep;  // Filename
+    const char* m_hierp;  // Hierarchy under the module instance, with leading '.', or ""
+    const char* m_pagep;  // Page
+    const char* m_commentp;  // Comment
+    const char* m_linescovp;  // Lines covered, or ""
+};
+
+//=============================================================================
+/// Internal: Toggle coverage of a word of bits, called from Verilated code.
+/// Increment the count of each bit set in 'toggled', the count of bit N
+/// being countsp[N].  The _SAT versions count each bit at most once.
+
+inline int vlCoverToggleNext(uint64_t toggled) VL_PURE {
+#ifdef __GNUC__
+    return __builtin_ctzll(toggled);
+#else
+    int bit = 0;
+    while (!((toggled >> bit) & 1ULL)) ++bit;
+    return bit;
+#endif
+}
+inline void VL_COVER_TOGGLE(uint32_t* countsp, uint64_t toggled) VL_MT_UNSAFE {
+    for (; toggled; toggled &= toggled - 1) ++countsp[vlCoverToggleNext(toggled)];
+}
+inline void VL_COVER_TOGGLE(std::atomic<uint32_t>* countsp, uint64_t toggled) VL_MT_SAFE {
+    for (; toggled; toggled &= toggled - 1) {
+        countsp[vlCoverToggleNext(toggled)].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+inline void VL_COVER_TOGGLE_SAT(uint32_t* countsp, uint64_t toggled) VL_MT_UNSAFE {
+    for (; toggled; toggled &= toggled - 1) countsp[vlCoverToggleNext(toggled)] = 1;
+}
+inline void VL_COVER_TOGGLE_SAT(std::atomic<uint32_t>* countsp, uint64_t toggled) VL_MT_SAFE {
+    for (; toggled; toggled &= toggled - 1) {
+        countsp[vlCoverToggleNext(toggled)].store(1, std::memory_order_relaxed);
+    }
+}
+
 //=============================================================================
 //  VerilatedCov
 /// Per-VerilatedContext coverage data class.
@@ -95,6 +142,9 @@ public:
     /// Write all coverage data to a file
     void write() VL_MT_SAFE { write(defaultFilename()); }
     void write(const std::string& filename) VL_MT_SAFE;
+    /// Write all coverage data to a file, in binary format, which
+    /// verilator_coverage reads faster, and converts to text with --write
+    void writeBinary(const std::string& filename) VL_MT_SAFE;
     /// Clear coverage points (and call delete on all items)
     void clear() VL_MT_SAFE;
     /// Clear items not matching the provided string
@@ -130,6 +180,18 @@ public:
     // Backward compatibility for Verilator
     void _insertp(A(0), A(1), K(2), int val2, K(3), int val3, K(4), const std::string& val4, A(5),
                   A(6), A(7)) VL_MT_SAFE;
+    // Insert a table of points of module instance hierp, counting into
+    // countsp[point's m_bin], or if !enable, into a counter that is never written.
+    // Same as VL_COVER_INSERT for each point, but without per-point overhead
+    void _insertTable(const char* hierp, uint32_t* countsp, bool enable,
+                      const VerilatedCovPoint* pointsp, size_t npoints) VL_MT_SAFE;
+    // As above, but each point is counted in 'blocks' blocks of counters,
+    // 'stride' counters apart, one per thread, see Verilated::coverSlot.
+    // The reported count is their sum, or for toggle points with
+    // 'saturateToggle', whether any is set.
+    void _insertTable(const char* hierp, uint32_t* countsp, bool enable,
+                      const VerilatedCovPoint* pointsp, size_t npoints, size_t blocks,
+                      size_t stride, bool saturateToggle) VL_MT_SAFE;
 
 #undef K
 #undef A
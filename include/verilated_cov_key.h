@@ -58,6 +58,9 @@ VLCOVGEN_ITEM("'name':'weight',      'short':'w',  'group':0, 'default':None, 'd
 #define VL_CIK_WEIGHT "w"
 // VLCOVGEN_CIK_AUTO_EDIT_END
 
+// First bytes of a binary format coverage file, see VerilatedCovContext::writeBinary
+#define VL_COVERAGE_BINARY_MAGIC "VLCOVB01"
+
 //=============================================================================
 // VerilatedCovKey
 // Namespace-style static class for \internal use.
@@ -756,8 +756,40 @@ int svPutUserData(const svScope scope, void* userKey, void* userData) {
     return 0;
 }
 
+// Per-thread cache of svGetUserData lookups, so context DPI imports called
+// in parallel from different threads do not contend on the user data lock
+struct VlUserDataCache final {
+    static constexpr size_t SIZE = 16;  // Entries, power of 2
+    struct Entry final {
+        const void* m_scopep = nullptr;
+        void* m_userKey = nullptr;
+        void* m_userData = nullptr;
+        bool m_valid = false;
+    };
+    uint64_t m_generation = 0;  // VerilatedImp::userGeneration() the entries are valid for
+    Entry m_entries[SIZE];
+};
+
 void* svGetUserData(const svScope scope, void* userKey) {
-    return VerilatedImp::userFind(scope, userKey);
+    static thread_local VlUserDataCache t_cache;
+    const uint64_t generation = VerilatedImp::userGeneration();
+    if (VL_UNLIKELY(t_cache.m_generation != generation)) {
+        t_cache = VlUserDataCache{};
+        t_cache.m_generation = generation;
+    }
+    const size_t index = ((reinterpret_cast<uintptr_t>(scope) >> 4)
+                          ^ (reinterpret_cast<uintptr_t>(userKey) >> 3))
+                         & (VlUserDataCache::SIZE - 1);
+    VlUserDataCache::Entry& entry = t_cache.m_entries[index];
+    if (VL_LIKELY(entry.m_valid && entry.m_scopep == scope && entry.m_userKey == userKey)) {
+        return entry.m_userData;
+    }
+    void* const userData = VerilatedImp::userFind(scope, userKey);
+    entry.m_scopep = scope;
+    entry.m_userKey = userKey;
+    entry.m_userData = userData;
+    entry.m_valid = true;
+    return userData;
 }
 
 int svGetCallerInfo(const char** fileNamepp, int* lineNumberp) {
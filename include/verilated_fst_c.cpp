@@ -183,7 +183,7 @@ void VerilatedFst::popPrefix() {
     assert(!m_prefixStack.empty());  // Always one left, the constructor's initial one
 }
 
-void VerilatedFst::declare(uint32_t code, const char* name, int dtypenum,
+void VerilatedFst::declare(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                            VerilatedTraceSigDirection direction, VerilatedTraceSigKind kind,
                            VerilatedTraceSigType type, bool array, int arraynum, bool bussed,
                            int msb, int lsb) {
@@ -191,7 +191,7 @@ void VerilatedFst::declare(uint32_t code, const char* name, int dtypenum,
 
     const std::string hierarchicalName = m_prefixStack.back().first + name;
 
-    const bool enabled = Super::declCode(code, hierarchicalName, bits);
+    const bool enabled = Super::declCode(code, fidx, hierarchicalName, bits);
     if (!enabled) return;
 
     assert(hierarchicalName.rfind(' ') != std::string::npos);
@@ -253,35 +253,35 @@ void VerilatedFst::declare(uint32_t code, const char* name, int dtypenum,
 void VerilatedFst::declEvent(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                              VerilatedTraceSigDirection direction, VerilatedTraceSigKind kind,
                              VerilatedTraceSigType type, bool array, int arraynum) {
-    declare(code, name, dtypenum, direction, kind, type, array, arraynum, false, 0, 0);
+    declare(code, fidx, name, dtypenum, direction, kind, type, array, arraynum, false, 0, 0);
 }
 void VerilatedFst::declBit(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                            VerilatedTraceSigDirection direction, VerilatedTraceSigKind kind,
                            VerilatedTraceSigType type, bool array, int arraynum) {
-    declare(code, name, dtypenum, direction, kind, type, array, arraynum, false, 0, 0);
+    declare(code, fidx, name, dtypenum, direction, kind, type, array, arraynum, false, 0, 0);
 }
 void VerilatedFst::declBus(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                            VerilatedTraceSigDirection direction, VerilatedTraceSigKind kind,
                            VerilatedTraceSigType type, bool array, int arraynum, int msb,
                            int lsb) {
-    declare(code, name, dtypenum, direction, kind, type, array, arraynum, true, msb, lsb);
+    declare(code, fidx, name, dtypenum, direction, kind, type, array, arraynum, true, msb, lsb);
 }
 void VerilatedFst::declQuad(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                             VerilatedTraceSigDirection direction, VerilatedTraceSigKind kind,
                             VerilatedTraceSigType type, bool array, int arraynum, int msb,
                             int lsb) {
-    declare(code, name, dtypenum, direction, kind, type, array, arraynum, true, msb, lsb);
+    declare(code, fidx, name, dtypenum, direction, kind, type, array, arraynum, true, msb, lsb);
 }
 void VerilatedFst::declArray(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                              VerilatedTraceSigDirection direction, VerilatedTraceSigKind kind,
                              VerilatedTraceSigType type, bool array, int arraynum, int msb,
                              int lsb) {
-    declare(code, name, dtypenum, direction, kind, type, array, arraynum, true, msb, lsb);
+    declare(code, fidx, name, dtypenum, direction, kind, type, array, arraynum, true, msb, lsb);
 }
 void VerilatedFst::declDouble(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                               VerilatedTraceSigDirection direction, VerilatedTraceSigKind kind,
                               VerilatedTraceSigType type, bool array, int arraynum) {
-    declare(code, name, dtypenum, direction, kind, type, array, arraynum, false, 63, 0);
+    declare(code, fidx, name, dtypenum, direction, kind, type, array, arraynum, false, 63, 0);
 }
 
 //=============================================================================
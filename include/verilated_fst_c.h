@@ -66,9 +66,9 @@ private:
 
     // CONSTRUCTORS
     VL_UNCOPYABLE(VerilatedFst);
-    void declare(uint32_t code, const char* name, int dtypenum, VerilatedTraceSigDirection,
-                 VerilatedTraceSigKind, VerilatedTraceSigType, bool array, int arraynum,
-                 bool bussed, int msb, int lsb);
+    void declare(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                 VerilatedTraceSigDirection, VerilatedTraceSigKind, VerilatedTraceSigType,
+                 bool array, int arraynum, bool bussed, int msb, int lsb);
 
 protected:
     //=========================================================================
@@ -150,6 +150,8 @@ template <>
 void VerilatedFst::Super::set_time_resolution(const std::string& unit);
 template <>
 void VerilatedFst::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedFst::Super::dumpvarsMatch(const std::string& pattern);
 #endif
 
 //=============================================================================
@@ -254,6 +256,17 @@ public:
     void dumpvars(int level, const std::string& hier) VL_MT_SAFE {
         m_sptrace.dumpvars(level, hier);
     }
+    // Add variables to dump, those with a name matching the glob pattern
+    // ('*' any characters, '?' any character), e.g. "top.t.*.data*"
+    void dumpvarsMatch(const std::string& pattern) VL_MT_SAFE {
+        m_sptrace.dumpvarsMatch(pattern);
+    }
+    /// With --trace-threads, limit the memory of buffers queued for the
+    /// offload thread to the given bytes (0 = default of 8 buffers)
+    void offloadBytesMax(size_t bytes) VL_MT_SAFE { m_sptrace.offloadBytesMax(bytes); }
+    /// With --trace-threads, if the offload thread falls behind skip a dump,
+    /// with its changes written in the next dump, instead of waiting
+    void offloadDrop(bool flag) VL_MT_SAFE { m_sptrace.offloadDrop(flag); }
 
     // Internal class access
     VerilatedFst* spTrace() { return &m_sptrace; }
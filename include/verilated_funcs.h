@@ -28,6 +28,8 @@
 #error "verilated_funcs.h should only be included by verilated.h"
 #endif
 
+#include "verilated_intrinsics.h"
+
 #include <string>
 
 //=========================================================================
@@ -108,6 +110,9 @@ extern QData VL_RAND_RESET_Q(int obits) VL_MT_SAFE;
 /// Random reset a signal of given width (init time only)
 extern WDataOutP VL_RAND_RESET_W(int obits, WDataOutP outwp) VL_MT_SAFE;
 
+/// Random reset all elements of an unpacked array of a given element width (init time only)
+extern void VL_RAND_RESET_ARRAY(int obits, void* datap, size_t bytes) VL_MT_SAFE;
+
 /// Random reset a signal of given width (assign time only)
 extern IData VL_RAND_RESET_ASSIGN_I(int obits) VL_MT_SAFE;
 /// Random reset a signal of given width (assign time only)
@@ -137,8 +142,9 @@ extern void VL_FCLOSE_I(IData fdi) VL_MT_SAFE;
 extern IData VL_FREAD_I(int width, int array_lsb, int array_size, void* memp, IData fpi,
                         IData start, IData count) VL_MT_SAFE;
 
-extern void VL_WRITEF_NX(const std::string& format, int argc, ...) VL_MT_SAFE;
-extern void VL_FWRITEF_NX(IData fpi, const std::string& format, int argc, ...) VL_MT_SAFE;
+// Formats are string literals, so passed as const char* to not construct a std::string
+extern void VL_WRITEF_NX(const char* formatp, int argc, ...) VL_MT_SAFE;
+extern void VL_FWRITEF_NX(IData fpi, const char* formatp, int argc, ...) VL_MT_SAFE;
 
 extern IData VL_FSCANF_INX(IData fpi, const std::string& format, int argc, ...) VL_MT_SAFE;
 extern IData VL_SSCANF_IINX(int lbits, IData ld, const std::string& format, int argc,
@@ -148,15 +154,15 @@ extern IData VL_SSCANF_IQNX(int lbits, QData ld, const std::string& format, int
 extern IData VL_SSCANF_IWNX(int lbits, WDataInP const lwp, const std::string& format, int argc,
                             ...) VL_MT_SAFE;
 
-extern void VL_SFORMAT_NX(int obits, CData& destr, const std::string& format, int argc,
+extern void VL_SFORMAT_NX(int obits, CData& destr, const char* formatp, int argc,
                           ...) VL_MT_SAFE;
-extern void VL_SFORMAT_NX(int obits, SData& destr, const std::string& format, int argc,
+extern void VL_SFORMAT_NX(int obits, SData& destr, const char* formatp, int argc,
                           ...) VL_MT_SAFE;
-extern void VL_SFORMAT_NX(int obits, IData& destr, const std::string& format, int argc,
+extern void VL_SFORMAT_NX(int obits, IData& destr, const char* formatp, int argc,
                           ...) VL_MT_SAFE;
-extern void VL_SFORMAT_NX(int obits, QData& destr, const std::string& format, int argc,
+extern void VL_SFORMAT_NX(int obits, QData& destr, const char* formatp, int argc,
                           ...) VL_MT_SAFE;
-extern void VL_SFORMAT_NX(int obits, void* destp, const std::string& format, int argc,
+extern void VL_SFORMAT_NX(int obits, void* destp, const char* formatp, int argc,
                           ...) VL_MT_SAFE;
 
 extern void VL_STACKTRACE() VL_MT_SAFE;
@@ -550,6 +556,57 @@ static inline void VL_ASSIGNBIT_WO(int bit, WDataOutP owp) VL_MT_SAFE {
         (svar).write(_butemp); \
     }
 
+// Set a SystemC variable only if the value changed, see --sc-clocked-eval.
+// Compares before creating any SystemC temporary, and avoids the write.
+
+#define VL_ASSIGNCHG_SII(obits, svar, vvar) \
+    { \
+        if ((svar).read() != (vvar)) (svar).write(vvar); \
+    }
+#define VL_ASSIGNCHG_SQQ(obits, svar, vvar) \
+    { \
+        if ((svar).read() != (vvar)) (svar).write(vvar); \
+    }
+
+#define VL_ASSIGNCHG_SWI(obits, svar, rd) \
+    { \
+        if ((svar).read().get_word(0) != (rd)) VL_ASSIGN_SWI(obits, svar, rd); \
+    }
+#define VL_ASSIGNCHG_SWQ(obits, svar, rd) \
+    { \
+        if ((svar).read().get_word(0) != static_cast<IData>(rd) \
+            || (svar).read().get_word(1) != static_cast<IData>((rd) >> VL_IDATASIZE)) \
+            VL_ASSIGN_SWQ(obits, svar, rd); \
+    }
+#define VL_ASSIGNCHG_SWW(obits, svar, rwp) \
+    { \
+        for (int i = 0; i < VL_WORDS_I(obits); ++i) { \
+            if ((svar).read().get_word(i) != (rwp)[i]) { \
+                VL_ASSIGN_SWW(obits, svar, rwp); \
+                break; \
+            } \
+        } \
+    }
+
+#define VL_ASSIGNCHG_SUI(obits, svar, rd) \
+    { \
+        if ((svar).read() != (rd)) (svar).write(rd); \
+    }
+#define VL_ASSIGNCHG_SUQ(obits, svar, rd) \
+    { \
+        if ((svar).read() != (rd)) (svar).write(rd); \
+    }
+#define VL_ASSIGNCHG_SBI(obits, svar, rd) \
+    { \
+        if ((svar).read() != (rd)) (svar).write(rd); \
+    }
+#define VL_ASSIGNCHG_SBQ(obits, svar, rd) \
+    { \
+        if ((svar).read() != (rd)) (svar).write(rd); \
+    }
+// Comparing needs the sc_biguint temporary, so compared by the write itself
+#define VL_ASSIGNCHG_SBW(obits, svar, rwp) VL_ASSIGN_SBW(obits, svar, rwp)
+
 //===================================================================
 // Extending sizes
 
@@ -842,19 +899,83 @@ static inline IData VL_MOSTSETBITP1_W(int words, WDataInP const lwp) VL_PURE {
     return 0;
 }
 
+//===================================================================
+// Vector helpers for wide bitwise operators, internal usage
+// VL_WVEC_WORDS_ is the number of EData words in a vector register, if any.
+// Loads and stores are unaligned, and may be in place (owp == lwp).
+
+// clang-format off
+#if defined(VL_HAVE_AVX2)
+# define VL_WVEC_WORDS_ 8
+using VlWVec_ = __m256i;
+static inline VlWVec_ _vl_wvec_load(const EData* p) VL_PURE {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+static inline void _vl_wvec_store(EData* p, VlWVec_ v) VL_MT_SAFE {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+static inline VlWVec_ _vl_wvec_and(VlWVec_ a, VlWVec_ b) VL_PURE { return _mm256_and_si256(a, b); }
+static inline VlWVec_ _vl_wvec_or(VlWVec_ a, VlWVec_ b) VL_PURE { return _mm256_or_si256(a, b); }
+static inline VlWVec_ _vl_wvec_xor(VlWVec_ a, VlWVec_ b) VL_PURE { return _mm256_xor_si256(a, b); }
+static inline VlWVec_ _vl_wvec_ones() VL_PURE { return _mm256_set1_epi32(-1); }
+static inline bool _vl_wvec_zero(VlWVec_ a) VL_PURE { return _mm256_testz_si256(a, a); }
+#elif defined(VL_HAVE_SSE2)
+# define VL_WVEC_WORDS_ 4
+using VlWVec_ = __m128i;
+static inline VlWVec_ _vl_wvec_load(const EData* p) VL_PURE {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+static inline void _vl_wvec_store(EData* p, VlWVec_ v) VL_MT_SAFE {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+static inline VlWVec_ _vl_wvec_and(VlWVec_ a, VlWVec_ b) VL_PURE { return _mm_and_si128(a, b); }
+static inline VlWVec_ _vl_wvec_or(VlWVec_ a, VlWVec_ b) VL_PURE { return _mm_or_si128(a, b); }
+static inline VlWVec_ _vl_wvec_xor(VlWVec_ a, VlWVec_ b) VL_PURE { return _mm_xor_si128(a, b); }
+static inline VlWVec_ _vl_wvec_ones() VL_PURE { return _mm_set1_epi32(-1); }
+static inline bool _vl_wvec_zero(VlWVec_ a) VL_PURE {
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(a, _mm_setzero_si128())) == 0xffff;
+}
+#elif defined(VL_HAVE_NEON)
+# define VL_WVEC_WORDS_ 4
+using VlWVec_ = uint32x4_t;
+static inline VlWVec_ _vl_wvec_load(const EData* p) VL_PURE { return vld1q_u32(p); }
+static inline void _vl_wvec_store(EData* p, VlWVec_ v) VL_MT_SAFE { vst1q_u32(p, v); }
+static inline VlWVec_ _vl_wvec_and(VlWVec_ a, VlWVec_ b) VL_PURE { return vandq_u32(a, b); }
+static inline VlWVec_ _vl_wvec_or(VlWVec_ a, VlWVec_ b) VL_PURE { return vorrq_u32(a, b); }
+static inline VlWVec_ _vl_wvec_xor(VlWVec_ a, VlWVec_ b) VL_PURE { return veorq_u32(a, b); }
+static inline VlWVec_ _vl_wvec_ones() VL_PURE { return vdupq_n_u32(~0U); }
+static inline bool _vl_wvec_zero(VlWVec_ a) VL_PURE {
+    const uint64x2_t q = vreinterpretq_u64_u32(a);
+    return (vgetq_lane_u64(q, 0) | vgetq_lane_u64(q, 1)) == 0;
+}
+#endif
+// clang-format on
+
 //===================================================================
 // SIMPLE LOGICAL OPERATORS
 
 // EMIT_RULE: VL_AND:  oclean=lclean||rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_AND_W(int words, WDataOutP owp, WDataInP const lwp,
                                  WDataInP const rwp) VL_MT_SAFE {
-    for (int i = 0; (i < words); ++i) owp[i] = (lwp[i] & rwp[i]);
+    int i = 0;
+#ifdef VL_WVEC_WORDS_
+    for (; i + VL_WVEC_WORDS_ <= words; i += VL_WVEC_WORDS_) {
+        _vl_wvec_store(owp + i, _vl_wvec_and(_vl_wvec_load(lwp + i), _vl_wvec_load(rwp + i)));
+    }
+#endif
+    for (; (i < words); ++i) owp[i] = (lwp[i] & rwp[i]);
     return owp;
 }
 // EMIT_RULE: VL_OR:   oclean=lclean&&rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_OR_W(int words, WDataOutP owp, WDataInP const lwp,
                                 WDataInP const rwp) VL_MT_SAFE {
-    for (int i = 0; (i < words); ++i) owp[i] = (lwp[i] | rwp[i]);
+    int i = 0;
+#ifdef VL_WVEC_WORDS_
+    for (; i + VL_WVEC_WORDS_ <= words; i += VL_WVEC_WORDS_) {
+        _vl_wvec_store(owp + i, _vl_wvec_or(_vl_wvec_load(lwp + i), _vl_wvec_load(rwp + i)));
+    }
+#endif
+    for (; (i < words); ++i) owp[i] = (lwp[i] | rwp[i]);
     return owp;
 }
 // EMIT_RULE: VL_CHANGEXOR:  oclean=1; obits=32; lbits==rbits;
@@ -866,12 +987,24 @@ static inline IData VL_CHANGEXOR_W(int words, WDataInP const lwp, WDataInP const
 // EMIT_RULE: VL_XOR:  oclean=lclean&&rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_XOR_W(int words, WDataOutP owp, WDataInP const lwp,
                                  WDataInP const rwp) VL_MT_SAFE {
-    for (int i = 0; (i < words); ++i) owp[i] = (lwp[i] ^ rwp[i]);
+    int i = 0;
+#ifdef VL_WVEC_WORDS_
+    for (; i + VL_WVEC_WORDS_ <= words; i += VL_WVEC_WORDS_) {
+        _vl_wvec_store(owp + i, _vl_wvec_xor(_vl_wvec_load(lwp + i), _vl_wvec_load(rwp + i)));
+    }
+#endif
+    for (; (i < words); ++i) owp[i] = (lwp[i] ^ rwp[i]);
     return owp;
 }
 // EMIT_RULE: VL_NOT:  oclean=dirty; obits=lbits;
 static inline WDataOutP VL_NOT_W(int words, WDataOutP owp, WDataInP const lwp) VL_MT_SAFE {
-    for (int i = 0; i < words; ++i) owp[i] = ~(lwp[i]);
+    int i = 0;
+#ifdef VL_WVEC_WORDS_
+    for (; i + VL_WVEC_WORDS_ <= words; i += VL_WVEC_WORDS_) {
+        _vl_wvec_store(owp + i, _vl_wvec_xor(_vl_wvec_load(lwp + i), _vl_wvec_ones()));
+    }
+#endif
+    for (; i < words; ++i) owp[i] = ~(lwp[i]);
     return owp;
 }
 
@@ -892,8 +1025,19 @@ static inline WDataOutP VL_NOT_W(int words, WDataOutP owp, WDataInP const lwp) V
 
 // Output clean, <lhs> AND <rhs> MUST BE CLEAN
 static inline IData VL_EQ_W(int words, WDataInP const lwp, WDataInP const rwp) VL_PURE {
+    int i = 0;
+#ifdef VL_WVEC_WORDS_
+    if (words >= VL_WVEC_WORDS_) {
+        VlWVec_ vnequal = _vl_wvec_xor(_vl_wvec_load(lwp), _vl_wvec_load(rwp));
+        for (i = VL_WVEC_WORDS_; i + VL_WVEC_WORDS_ <= words; i += VL_WVEC_WORDS_) {
+            vnequal = _vl_wvec_or(vnequal,
+                                  _vl_wvec_xor(_vl_wvec_load(lwp + i), _vl_wvec_load(rwp + i)));
+        }
+        if (!_vl_wvec_zero(vnequal)) return 0;
+    }
+#endif
     EData nequal = 0;
-    for (int i = 0; (i < words); ++i) nequal |= (lwp[i] ^ rwp[i]);
+    for (; (i < words); ++i) nequal |= (lwp[i] ^ rwp[i]);
     return (nequal == 0);
 }
 
@@ -1041,13 +1185,15 @@ static inline WDataOutP VL_MUL_W(int words, WDataOutP owp, WDataInP const lwp,
                                  WDataInP const rwp) VL_MT_SAFE {
     for (int i = 0; i < words; ++i) owp[i] = 0;
     for (int lword = 0; lword < words; ++lword) {
-        for (int rword = 0; rword < words; ++rword) {
-            QData mul = static_cast<QData>(lwp[lword]) * static_cast<QData>(rwp[rword]);
-            for (int qword = lword + rword; qword < words; ++qword) {
-                mul += static_cast<QData>(owp[qword]);
-                owp[qword] = (mul & 0xffffffffULL);
-                mul = (mul >> 32ULL) & 0xffffffffULL;
-            }
+        // Accumulate one row of partial products, carrying into the next column.
+        // lwp[i] * rwp[j] + owp[k] + carry always fits in a QData.
+        const QData lhs = static_cast<QData>(lwp[lword]);
+        if (!lhs) continue;
+        QData carry = 0;
+        for (int qword = lword; qword < words; ++qword) {
+            carry += lhs * static_cast<QData>(rwp[qword - lword]) + static_cast<QData>(owp[qword]);
+            owp[qword] = (carry & 0xffffffffULL);
+            carry = (carry >> 32ULL) & 0xffffffffULL;
         }
     }
     // Last output word is dirty
@@ -1902,8 +2048,16 @@ static inline WDataOutP VL_SHIFTL_WWI(int obits, int, int, WDataOutP owp, WDataI
         for (int i = 0; i < word_shift; ++i) owp[i] = 0;
         for (int i = word_shift; i < VL_WORDS_I(obits); ++i) owp[i] = lwp[i - word_shift];
     } else {
+        // Shift each word, carrying its upper bits into the next word
+        const int nbitsonleft = VL_EDATASIZE - bit_shift;
+        const int words = VL_WORDS_I(obits - rd);
         for (int i = 0; i < VL_WORDS_I(obits); ++i) owp[i] = 0;
-        _vl_insert_WW(owp, lwp, obits - 1, rd);
+        for (int i = 0; i < words; ++i) {
+            owp[i + word_shift] |= lwp[i] << bit_shift;
+            const int upperword = i + word_shift + 1;
+            if (upperword < VL_WORDS_I(obits)) owp[upperword] = lwp[i] >> nbitsonleft;
+        }
+        owp[VL_WORDS_I(obits) - 1] &= VL_MASK_E(obits);
     }
     return owp;
 }
@@ -2743,6 +2897,11 @@ inline std::string VL_CVT_PACK_STR_NI(IData lhs) VL_PURE {
 inline std::string VL_CONCATN_NNN(const std::string& lhs, const std::string& rhs) VL_PURE {
     return lhs + rhs;
 }
+// Temporary left operand, as in nested concatenations, append in place reusing its buffer
+inline std::string VL_CONCATN_NNN(std::string&& lhs, const std::string& rhs) VL_PURE {
+    lhs += rhs;
+    return std::move(lhs);
+}
 inline std::string VL_REPLICATEN_NNQ(const std::string& lhs, IData rep) VL_PURE {
     std::string result;
     result.reserve(lhs.length() * rep);
@@ -2767,11 +2926,54 @@ extern void VL_READMEM_N(bool hex, int bits, QData depth, int array_lsb,
 extern void VL_WRITEMEM_N(bool hex, int bits, QData depth, int array_lsb,
                           const std::string& filename, const void* memp, QData start,
                           QData end) VL_MT_SAFE;
+// Sparse memory, element pointers are not contiguous across pages
+template <typename T_Value, std::size_t N_Depth>
+void VL_READMEM_N(bool hex, int bits, QData depth, int array_lsb, const std::string& filename,
+                  VlSparseUnpacked<T_Value, N_Depth>* memp, QData start, QData end) VL_MT_SAFE {
+    if (start < static_cast<QData>(array_lsb)) start = array_lsb;
+    VlReadMem rmem{hex, bits, filename, start, end};
+    if (VL_UNLIKELY(!rmem.isOpen())) return;
+    while (true) {
+        QData addr = 0;
+        std::string value;
+        if (!rmem.get(addr /*ref*/, value /*ref*/)) break;
+        if (VL_UNLIKELY(addr < static_cast<QData>(array_lsb)
+                        || addr >= static_cast<QData>(array_lsb + depth))) {
+            VL_FATAL_MT(filename.c_str(), rmem.linenum(), "",
+                        "$readmem file address beyond bounds of array");
+        } else {
+            rmem.setData(&(*memp)[addr - array_lsb], value);
+        }
+    }
+}
+
+// Sparse memory, writes only pages that were accessed, with addresses, others are zero
+template <typename T_Value, std::size_t N_Depth>
+void VL_WRITEMEM_N(bool hex, int bits, QData depth, int array_lsb, const std::string& filename,
+                   const VlSparseUnpacked<T_Value, N_Depth>* memp, QData start,
+                   QData end) VL_MT_SAFE {
+    const QData addr_max = array_lsb + depth - 1;
+    if (start < static_cast<QData>(array_lsb)) start = array_lsb;
+    if (end > addr_max) end = addr_max;
+    VlWriteMem wmem{hex, bits, filename, start, end};
+    if (VL_UNLIKELY(!wmem.isOpen())) return;
+    constexpr size_t PAGE_ELEMENTS = VlSparseUnpacked<T_Value, N_Depth>::PAGE_ELEMENTS;
+    for (QData addr = start; addr <= end;) {
+        const QData row = addr - array_lsb;
+        const T_Value* const pagep = memp->pagep(row / PAGE_ELEMENTS);
+        if (!pagep) {  // Skip to next page
+            addr += PAGE_ELEMENTS - row % PAGE_ELEMENTS;
+            continue;
+        }
+        wmem.print(addr, true, &pagep[row % PAGE_ELEMENTS]);
+        ++addr;
+    }
+}
 extern IData VL_SSCANF_INNX(int lbits, const std::string& ld, const std::string& format, int argc,
                             ...) VL_MT_SAFE;
-extern void VL_SFORMAT_NX(int obits_ignored, std::string& output, const std::string& format,
+extern void VL_SFORMAT_NX(int obits_ignored, std::string& output, const char* formatp,
                           int argc, ...) VL_MT_SAFE;
-extern std::string VL_SFORMATF_N_NX(const std::string& format, int argc, ...) VL_MT_SAFE;
+extern std::string VL_SFORMATF_N_NX(const char* formatp, int argc, ...) VL_MT_SAFE;
 extern void VL_TIMEFORMAT_IINI(int units, int precision, const std::string& suffix, int width,
                                VerilatedContext* contextp) VL_MT_SAFE;
 extern IData VL_VALUEPLUSARGS_INW(int rbits, const std::string& ld, WDataOutP rwp) VL_MT_SAFE;
@@ -0,0 +1,181 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Verilated hierarchical block process header
+///
+/// This file is included by the wrappers of hierarchical blocks Verilated
+/// with --hierarchical-process, which evaluate each block in a separate
+/// process.
+///
+/// This file is not part of the Verilated public-facing API.
+/// It is only for internal use by Verilated library routines.
+///
+//=============================================================================
+
+#ifndef VERILATOR_VERILATED_HIER_PROCESS_H_
+#define VERILATOR_VERILATED_HIER_PROCESS_H_
+
+#include "verilatedos.h"
+
+#include "verilated.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#if defined(_WIN32) || defined(__MINGW32__)
+#error "--hierarchical-process is not supported on Windows"
+#endif
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//=============================================================================
+// VlHierProcess
+// Runs a hierarchical block's model in a forked process. The block's ports
+// live in shared memory; the upper model writes the inputs, requests an
+// evaluation and waits for the outputs. Each request carries the upper
+// model's time, so the block never runs ahead of the upper model.
+
+template <typename T_Ports>
+class VlHierProcess final {
+public:
+    // TYPES
+    enum Op : uint32_t {
+        OP_EVAL = 0,  // Evaluate with the current inputs
+        OP_FINAL = 1  // Call final and exit
+    };
+    // Server loop run in the block process, see the generated wrapper
+    using ServeFn = void (*)(VlHierProcess& process, const char* scopep);
+
+private:
+    // Shared between the processes
+    struct Shared final {
+        std::atomic<uint64_t> m_request{0};  // Sequence number of the last request
+        std::atomic<uint64_t> m_reply{0};  // Sequence number of the last reply
+        Op m_op = OP_EVAL;  // Requested operation
+        uint64_t m_time = 0;  // Upper model time of the request
+        bool m_gotFinish = false;  // Block model called $finish
+        T_Ports m_ports;  // Block port values
+    };
+
+    // MEMBERS
+    Shared* m_sharedp = nullptr;  // Shared memory
+    pid_t m_pid = 0;  // Block process, in the upper process
+    pid_t m_parentPid = 0;  // Upper process, in the block process
+    uint64_t m_seq = 0;  // Sequence number of the current request
+
+public:
+    long long m_seqnum = 0;  // Update sequence number, as in the in-process wrapper
+
+    // CONSTRUCTORS
+    // Create the shared memory and fork the block process, which runs 'serve'
+    VlHierProcess(const char* scopep, ServeFn serve) {
+        void* const memp = mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (VL_UNLIKELY(memp == MAP_FAILED)) {
+            VL_FATAL_MT(__FILE__, __LINE__, "",
+                        "--hierarchical-process could not map shared memory");
+        }
+        m_sharedp = new (memp) Shared;
+        // Otherwise buffered output would be written by both processes
+        Verilated::runFlushCallbacks();
+        std::fflush(nullptr);
+        m_parentPid = getpid();
+        m_pid = fork();
+        if (VL_UNLIKELY(m_pid < 0)) {
+            VL_FATAL_MT(__FILE__, __LINE__, "", "--hierarchical-process could not fork");
+        }
+        if (m_pid == 0) {
+            serve(*this, scopep);
+            std::fflush(nullptr);
+            // Skip destructors, which belong to the upper process
+            _exit(0);
+        }
+    }
+    ~VlHierProcess() {
+        if (m_pid > 0) {
+            int status = 0;
+            waitpid(m_pid, &status, 0);
+        }
+        m_sharedp->~Shared();
+        munmap(m_sharedp, sizeof(Shared));
+    }
+
+private:
+    VL_UNCOPYABLE(VlHierProcess);
+
+    // Wait until 'counter' reaches the current sequence number
+    void waitFor(const std::atomic<uint64_t>& counter) {
+        unsigned ct = 0;
+        while (VL_UNLIKELY(counter.load(std::memory_order_acquire) != m_seq)) {
+            if (VL_LIKELY(ct < VL_LOCK_SPINS)) {
+                ++ct;
+                VL_CPU_RELAX();
+                continue;
+            }
+            // Other process is slow, or shares our CPU
+            std::this_thread::yield();
+            if (VL_UNLIKELY((++ct & 0x3ff) == 0)) checkAlive();
+        }
+    }
+    // Give up if the other process has exited
+    void checkAlive() {
+        if (m_pid > 0) {
+            int status = 0;
+            if (VL_UNLIKELY(waitpid(m_pid, &status, WNOHANG) == m_pid)) {
+                m_pid = 0;
+                VL_FATAL_MT(__FILE__, __LINE__, "",
+                            "--hierarchical-process block process exited unexpectedly");
+            }
+        } else if (VL_UNLIKELY(getppid() != m_parentPid)) {
+            _exit(1);
+        }
+    }
+
+public:
+    // METHODS
+    T_Ports& ports() { return m_sharedp->m_ports; }
+
+    // Upper process: evaluate the block with the inputs in ports()
+    void eval() { request(OP_EVAL); }
+    // Upper process: final the block and wait for its process to exit
+    void final() { request(OP_FINAL); }
+    void request(Op op) {
+        m_sharedp->m_op = op;
+        m_sharedp->m_time = Verilated::threadContextp()->time();
+        m_sharedp->m_request.store(++m_seq, std::memory_order_release);
+        waitFor(m_sharedp->m_reply);
+        if (VL_UNLIKELY(m_sharedp->m_gotFinish)) Verilated::threadContextp()->gotFinish(true);
+    }
+
+    // Block process: wait for the next request, returning its operation
+    Op waitRequest() {
+        ++m_seq;
+        waitFor(m_sharedp->m_request);
+        return m_sharedp->m_op;
+    }
+    // Block process: time of the current request
+    uint64_t time() const { return m_sharedp->m_time; }
+    // Block process: complete the current request
+    void reply(bool gotFinish) {
+        m_sharedp->m_gotFinish = gotFinish;
+        m_sharedp->m_reply.store(m_seq, std::memory_order_release);
+    }
+};
+
+#endif  // Guard
@@ -24,7 +24,8 @@
 
 // clang-format off
 #if !defined(VERILATOR_VERILATED_CPP_) && !defined(VERILATOR_VERILATED_DPI_CPP_) \
-    && !defined(VERILATOR_VERILATED_VPI_CPP_) && !defined(VERILATOR_VERILATED_SAVE_CPP_)
+    && !defined(VERILATOR_VERILATED_VPI_CPP_) && !defined(VERILATOR_VERILATED_SAVE_CPP_) \
+    && !defined(VERILATOR_VERILATED_TIMING_CPP_)
 # error "verilated_imp.h only to be included by verilated*.cpp internals"
 #endif
 
@@ -33,12 +34,14 @@
 #include "verilated_syms.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <deque>
 #include <limits>
 #include <map>
 #include <numeric>
 #include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include <functional>
@@ -80,53 +83,64 @@ public:
     void run() const { m_cb(); }
 };
 
-// Each thread has a queue it pushes to
+// Messages of one mtask, handed to the eval queue in one operation
+struct VerilatedMsgBatch final {
+    std::vector<VerilatedMsg> m_msgs;  // Messages in order of posting
+    VerilatedMsgBatch* m_nextp = nullptr;  // Next batch in VerilatedEvalMsgQueue list
+};
+
+// Each thread builds a batch of the messages of an mtask, then pushes the
+// batch onto a lock-free list. The consumer takes the whole list at once,
+// and merges the batches by mtask sequence number.
 // This assumes no thread starts pushing the next tick until the previous has drained.
-// If more aggressiveness is needed, a double-buffered scheme might work well.
 class VerilatedEvalMsgQueue final {
-    using VerilatedThreadQueue = std::multiset<VerilatedMsg, VerilatedMsg::Cmp>;
-
-    std::atomic<uint64_t> m_depth;  // Current depth of queue (see comments below)
-
-    mutable VerilatedMutex m_mutex;  // Mutex protecting queue
-    VerilatedThreadQueue m_queue VL_GUARDED_BY(m_mutex);  // Message queue
+    std::atomic<VerilatedMsgBatch*> m_headp{nullptr};  // Most recently posted batch
 public:
     // CONSTRUCTORS
-    VerilatedEvalMsgQueue()
-        : m_depth{0} {
-        assert(atomic_is_lock_free(&m_depth));
+    VerilatedEvalMsgQueue() { assert(m_headp.is_lock_free()); }
+    ~VerilatedEvalMsgQueue() {
+        // The only call of destructor with a non-empty queue is a fatal error,
+        // so just release the messages
+        VerilatedMsgBatch* batchp = m_headp.exchange(nullptr);
+        while (batchp) {
+            VerilatedMsgBatch* const nextp = batchp->m_nextp;
+            delete batchp;
+            batchp = nextp;
+        }
     }
-    ~VerilatedEvalMsgQueue() = default;
 
 private:
     VL_UNCOPYABLE(VerilatedEvalMsgQueue);
 
 public:
     // METHODS
-    // Add message to queue (called by producer)
-    void post(const VerilatedMsg& msg) VL_MT_SAFE_EXCLUDES(m_mutex) {
-        const VerilatedLockGuard lock{m_mutex};
-        m_queue.insert(msg);  // Pass by value to copy the message into queue
-        ++m_depth;
+    // Add batch of messages to queue, taking ownership (called by producer)
+    void post(VerilatedMsgBatch* batchp) VL_MT_SAFE {
+        batchp->m_nextp = m_headp.load(std::memory_order_relaxed);
+        while (!m_headp.compare_exchange_weak(batchp->m_nextp, batchp, std::memory_order_release,
+                                              std::memory_order_relaxed)) {}
     }
     // Service queue until completion (called by consumer)
-    void process() VL_MT_SAFE_EXCLUDES(m_mutex) {
-        // Tracking m_depth is redundant to e.g. getting the mutex and looking at queue size,
-        // but on the reader side it's 4x faster to test an atomic then getting a mutex
-        while (m_depth) {
-            // Wait for a message to be added to the queue
-            // We don't use unique_lock as want to unlock with the message copy still in scope
-            m_mutex.lock();
-            assert(!m_queue.empty());  // Otherwise m_depth is wrong
-            // Unfortunately to release the lock we need to copy the message
-            // (Or have the message be a pointer, but then new/delete cost on each message)
-            // We assume messages are small, so copy
-            const auto it = m_queue.begin();
-            const VerilatedMsg msg = *(it);
-            m_queue.erase(it);
-            m_mutex.unlock();
-            --m_depth;  // Ok if outside critical section as only this code checks the value
-            {
+    void process() VL_MT_SAFE {
+        // Testing the atomic head is all that is needed when there are no messages
+        while (VerilatedMsgBatch* batchp = m_headp.exchange(nullptr, std::memory_order_acquire)) {
+            // List is most recent first, reverse it so equal mtaskIds keep posting order
+            VerilatedMsgBatch* firstp = nullptr;
+            while (batchp) {
+                VerilatedMsgBatch* const nextp = batchp->m_nextp;
+                batchp->m_nextp = firstp;
+                firstp = batchp;
+                batchp = nextp;
+            }
+            std::vector<VerilatedMsg> msgs;
+            while (firstp) {
+                VerilatedMsgBatch* const nextp = firstp->m_nextp;
+                for (VerilatedMsg& msg : firstp->m_msgs) msgs.push_back(std::move(msg));
+                delete firstp;
+                firstp = nextp;
+            }
+            std::stable_sort(msgs.begin(), msgs.end(), VerilatedMsg::Cmp{});
+            for (const VerilatedMsg& msg : msgs) {
                 VL_DEBUG_IF(VL_DBG_MSGF("Executing callback from mtaskId=%d\n", msg.mtaskId()););
                 msg.run();
             }
@@ -136,14 +150,14 @@ public:
 
 // Each thread has a local queue to build up messages until the end of the eval() call
 class VerilatedThreadMsgQueue final {
-    std::queue<VerilatedMsg> m_queue;
+    VerilatedMsgBatch* m_batchp = nullptr;  // Messages of current mtask, nullptr if none
 
 public:
     // CONSTRUCTORS
     VerilatedThreadMsgQueue() = default;
-    ~VerilatedThreadMsgQueue() = default;
     // The only call of destructor with a non-empty queue is a fatal error.
     // So this does not flush the queue, as the destination queue is not known to this class.
+    ~VerilatedThreadMsgQueue() { delete m_batchp; }
 
 private:
     VL_UNCOPYABLE(VerilatedThreadMsgQueue);
@@ -163,16 +177,18 @@ public:
             msg.run();
         } else {
             Verilated::endOfEvalReqdInc();
-            threadton().m_queue.push(msg);  // Pass by value to copy the message into queue
+            VerilatedMsgBatch*& batchpr = threadton().m_batchp;
+            if (!batchpr) batchpr = new VerilatedMsgBatch;
+            batchpr->m_msgs.push_back(msg);  // Pass by value to copy the message into queue
         }
     }
     // Push all messages to the eval's queue
     static void flush(VerilatedEvalMsgQueue* evalMsgQp) VL_MT_SAFE {
-        while (!threadton().m_queue.empty()) {
-            evalMsgQp->post(threadton().m_queue.front());
-            threadton().m_queue.pop();
-            Verilated::endOfEvalReqdDec();
-        }
+        VerilatedMsgBatch*& batchpr = threadton().m_batchp;
+        if (!batchpr) return;
+        for (size_t i = 0; i < batchpr->m_msgs.size(); ++i) Verilated::endOfEvalReqdDec();
+        evalMsgQp->post(batchpr);
+        batchpr = nullptr;
     }
 };
 
@@ -193,6 +209,63 @@ public:
     }
 };
 
+//======================================================================
+// VerilatedAsyncOutput
+// Process-wide writer of $display/$fwrite output on a separate I/O thread.
+// Producers append to a pending buffer under a short lock; the writer
+// thread swaps it with its own (empty) buffer and does the fwrite calls.
+
+class VerilatedAsyncOutput final {
+    // TYPES
+    struct Record final {
+        FILE* m_fp;  // Destination file
+        size_t m_size;  // Bytes of this record in the buffer
+    };
+    struct Batch final {
+        std::string m_data;  // Bytes of all records, in order
+        std::vector<Record> m_records;  // Record boundaries
+    };
+    // CONSTANTS
+    // Producers wait for the writer when this many bytes are pending
+    static constexpr size_t MAX_PENDING = 16 * 1024 * 1024;
+    // Writer is woken when this many bytes are pending, else polls
+    static constexpr size_t WAKE_PENDING = 64 * 1024;
+
+    // MEMBERS
+    mutable VerilatedMutex m_mutex;  // Protects below
+    std::condition_variable_any m_cv;  // Signals pending work and completed batches
+    Batch m_pending VL_GUARDED_BY(m_mutex);  // Records not yet taken by the writer
+    uint64_t m_posted VL_GUARDED_BY(m_mutex) = 0;  // Records posted
+    uint64_t m_written VL_GUARDED_BY(m_mutex) = 0;  // Records written by the writer
+    uint64_t m_drainTarget VL_GUARDED_BY(m_mutex) = 0;  // Records a drain() is waiting for
+    bool m_exit VL_GUARDED_BY(m_mutex) = false;  // Writer thread to exit
+    std::thread m_thread;  // Writer thread, if enabled
+    std::atomic<bool> m_enabled{false};  // Output is asynchronous
+
+    VerilatedAsyncOutput() = default;
+    ~VerilatedAsyncOutput() { enable(false); }
+    VL_UNCOPYABLE(VerilatedAsyncOutput);
+
+    void writerMain() VL_MT_SAFE_EXCLUDES(m_mutex);
+
+public:
+    // METHODS
+    static VerilatedAsyncOutput& singleton() VL_MT_SAFE {
+        static VerilatedAsyncOutput s_s;
+        return s_s;
+    }
+    bool enabled() const VL_MT_SAFE { return m_enabled.load(std::memory_order_relaxed); }
+    // Start or stop (after draining) the writer thread
+    void enable(bool flag) VL_MT_UNSAFE;
+    // Queue output for writing to the given file
+    void write(FILE* fp, const char* datap, size_t size) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Wait until all queued output has been written to the stdio buffers
+    void drain() VL_MT_SAFE_EXCLUDES(m_mutex);
+    static void drainIfEnabled() VL_MT_SAFE {
+        if (VL_UNLIKELY(singleton().enabled())) singleton().drain();
+    }
+};
+
 //======================================================================
 // VerilatedContextImpData
 
@@ -207,6 +280,15 @@ protected:
     // Used by scopeInsert, scopeFind, scopeErase, scopeNameMap
     mutable VerilatedMutex m_nameMutex;  // Protect m_nameMap
     VerilatedScopeNameMap m_nameMap VL_GUARDED_BY(m_nameMutex);
+    // Incremented on every scopeInsert/scopeErase, so caches of scope lookups can
+    // tell when they are stale
+    std::atomic<uint64_t> m_scopeGeneration{0};
+
+    // Map that represents scope hierarchy, per context so independent models constructed
+    // in parallel do not contend
+    // Used by hierarchyAdd, hierarchyRemove, hierarchyMap
+    VerilatedMutex m_hierMapMutex;  // Protect m_hierMap
+    VerilatedHierarchyMap m_hierMap VL_GUARDED_BY(m_hierMapMutex);
 };
 
 //======================================================================
@@ -269,6 +351,32 @@ public:  // But only for verilated*.cpp
     // METHODS - scope name - INTERNAL only for verilated*.cpp
     void scopeInsert(const VerilatedScope* scopep) VL_MT_SAFE;
     void scopeErase(const VerilatedScope* scopep) VL_MT_SAFE;
+    uint64_t scopeGeneration() const VL_MT_SAFE {
+        return m_impdatap->m_scopeGeneration.load(std::memory_order_acquire);
+    }
+
+    // METHODS - hierarchy - INTERNAL only for verilated*.cpp
+    void hierarchyAdd(const VerilatedScope* fromp, const VerilatedScope* top) VL_MT_SAFE {
+        // Slow ok - called at construction for VPI accessible elements
+        const VerilatedLockGuard lock{m_impdatap->m_hierMapMutex};
+        m_impdatap->m_hierMap[fromp].push_back(top);
+    }
+    void hierarchyRemove(const VerilatedScope* fromp, const VerilatedScope* top) VL_MT_SAFE {
+        // Slow ok - called at destruction for VPI accessible elements
+        const VerilatedLockGuard lock{m_impdatap->m_hierMapMutex};
+        VerilatedHierarchyMap& map = m_impdatap->m_hierMap;
+        if (map.find(fromp) == map.end()) return;
+        auto& scopes = map[fromp];
+        const auto it = find(scopes.begin(), scopes.end(), top);
+        if (it != scopes.end()) scopes.erase(it);
+    }
+    const VerilatedHierarchyMap* hierarchyMap() const VL_MT_SAFE_POSTINIT {
+        // Thread save only assuming this is called only after model construction completed
+        return &m_impdatap->m_hierMap;
+    }
+
+    // CONSTANTS - file IO
+    static constexpr size_t FD_READ_BUFFER_SIZE = 256 * 1024;  // Stdio buffer of read files
 
     // METHODS - file IO - INTERNAL only for verilated*.cpp
 
@@ -284,6 +392,8 @@ public:  // But only for verilated*.cpp
     IData fdNew(const char* filenamep, const char* modep) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
         FILE* const fp = std::fopen(filenamep, modep);
         if (VL_UNLIKELY(!fp)) return 0;
+        // Stimulus files are read a character at a time, use a larger buffer than the default
+        if (!std::strpbrk(modep, "wa+")) std::setvbuf(fp, nullptr, _IOFBF, FD_READ_BUFFER_SIZE);
         // Bit 31 indicates it's a descriptor not a MCD
         const VerilatedLockGuard lock{m_fdMutex};
         if (m_fdFree.empty()) {
@@ -305,12 +415,14 @@ public:  // But only for verilated*.cpp
     void fdFlush(IData fdi) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
+        VerilatedAsyncOutput::drainIfEnabled();
         for (const auto& i : fdlist) std::fflush(i);
     }
     IData fdSeek(IData fdi, IData offset, IData origin) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
         if (VL_UNLIKELY(fdlist.size() != 1)) return ~0U;  // -1
+        VerilatedAsyncOutput::drainIfEnabled();
         return static_cast<IData>(
             std::fseek(*fdlist.begin(), static_cast<long>(offset), static_cast<int>(origin)));
     }
@@ -318,18 +430,25 @@ public:  // But only for verilated*.cpp
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
         if (VL_UNLIKELY(fdlist.size() != 1)) return ~0U;  // -1
+        VerilatedAsyncOutput::drainIfEnabled();
         return static_cast<IData>(std::ftell(*fdlist.begin()));
     }
     void fdWrite(IData fdi, const std::string& output) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
+        VerilatedAsyncOutput& async = VerilatedAsyncOutput::singleton();
         for (const auto& i : fdlist) {
             if (VL_UNLIKELY(!i)) continue;
-            (void)fwrite(output.c_str(), 1, output.size(), i);
+            if (async.enabled()) {
+                async.write(i, output.data(), output.size());
+            } else {
+                (void)fwrite(output.c_str(), 1, output.size(), i);
+            }
         }
     }
     void fdClose(IData fdi) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
         const VerilatedLockGuard lock{m_fdMutex};
+        VerilatedAsyncOutput::drainIfEnabled();
         if (VL_BITISSET_I(fdi, 31)) {
             // Non-MCD case
             const IData idx = VL_MASK_I(31) & fdi;
@@ -356,6 +475,7 @@ public:  // But only for verilated*.cpp
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
         if (VL_UNLIKELY(fdlist.size() != 1)) return nullptr;
+        VerilatedAsyncOutput::drainIfEnabled();
         return *fdlist.begin();
     }
 
@@ -419,11 +539,8 @@ protected:
     VerilatedMutex m_userMapMutex;  // Protect m_userMap
     // For userInsert, userFind.  As indexed by pointer is common across contexts.
     UserMap m_userMap VL_GUARDED_BY(m_userMapMutex);  // Map of <(scope,userkey), userData>
-
-    VerilatedMutex m_hierMapMutex;  // Protect m_hierMap
-    // Map that represents scope hierarchy
-    // Used by hierarchyAdd, hierarchyRemove, hierarchyMap
-    VerilatedHierarchyMap m_hierMap VL_GUARDED_BY(m_hierMapMutex);
+    // Incremented on every m_userMap change, invalidates the per-thread svGetUserData caches
+    std::atomic<uint64_t> m_userGeneration{1};
 
     // Slow - somewhat static:
     VerilatedMutex m_exportMutex;  // Protect m_nameMap
@@ -433,6 +550,9 @@ protected:
     ExportNameMap m_exportMap VL_GUARDED_BY(m_exportMutex);
     int m_exportNext VL_GUARDED_BY(m_exportMutex) = 0;  // Next export funcnum
 
+    // Printer of coroutine frame statistics, set by verilated_timing.cpp when used
+    std::atomic<void (*)()> m_coroutineStatsCb{nullptr};
+
     // CONSTRUCTORS
     VerilatedImpData() = default;
 };
@@ -448,6 +568,13 @@ protected:
         return s_s;
     }
 
+    // Per-thread cache of export function numbers, see exportInsert
+    struct ExportCacheEntry final {
+        const char* m_namep = nullptr;
+        int m_funcnum = 0;
+    };
+    static ExportCacheEntry& exportCacheEntry(const char* namep) VL_MT_SAFE;
+
 public:  // But only for verilated*.cpp
     // CONSTRUCTORS
     VerilatedImp() = default;
@@ -460,6 +587,10 @@ public:
     // METHODS - debug
     static void versionDump() VL_MT_SAFE;
 
+    // METHODS - statistics
+    static void (*coroutineStatsCb())() VL_MT_SAFE { return s().m_coroutineStatsCb; }
+    static void coroutineStatsCb(void (*cb)()) VL_MT_SAFE { s().m_coroutineStatsCb = cb; }
+
     // METHODS - user scope tracking
     // We implement this as a single large map instead of one map per scope.
     // There's often many more scopes than userdata's and thus having a ~48byte
@@ -473,6 +604,7 @@ public:
         } else {
             s().m_userMap.emplace(std::make_pair(scopep, userKey), userData);
         }
+        s().m_userGeneration.fetch_add(1, std::memory_order_release);
     }
     static void* userFind(const void* scopep, void* userKey) VL_MT_SAFE {
         const VerilatedLockGuard lock{s().m_userMapMutex};
@@ -480,20 +612,24 @@ public:
         if (VL_UNLIKELY(it == s().m_userMap.end())) return nullptr;
         return it->second;
     }
+    // Changes whenever userInsert or userEraseScope may have changed a userFind result
+    static uint64_t userGeneration() VL_MT_SAFE {
+        return s().m_userGeneration.load(std::memory_order_acquire);
+    }
 
     // METHODS - But only for verilated.cpp
 
     // Symbol table destruction cleans up the entries for each scope.
     static void userEraseScope(const VerilatedScope* scopep) VL_MT_SAFE {
-        // Slow ok - called once/scope on destruction, so we only iterate.
+        // Called once/scope on destruction. The map is ordered by scope first, so only this
+        // scope's entries are visited, and other threads' caches are kept when it had none.
         const VerilatedLockGuard lock{s().m_userMapMutex};
-        for (auto it = s().m_userMap.begin(); it != s().m_userMap.end();) {
-            if (it->first.first == scopep) {
-                s().m_userMap.erase(it++);
-            } else {
-                ++it;
-            }
+        auto it = s().m_userMap.lower_bound(std::make_pair(scopep, nullptr));
+        if (it == s().m_userMap.end() || it->first.first != scopep) return;
+        while (it != s().m_userMap.end() && it->first.first == scopep) {
+            s().m_userMap.erase(it++);
         }
+        s().m_userGeneration.fetch_add(1, std::memory_order_release);
     }
     static void userDump() VL_MT_SAFE {
         const VerilatedLockGuard lock{s().m_userMapMutex};  // Avoid it changing in middle of dump
@@ -508,27 +644,6 @@ public:
         }
     }
 
-    // METHODS - hierarchy - only for verilated*.cpp
-    static void hierarchyAdd(const VerilatedScope* fromp, const VerilatedScope* top) VL_MT_SAFE {
-        // Slow ok - called at construction for VPI accessible elements
-        const VerilatedLockGuard lock{s().m_hierMapMutex};
-        s().m_hierMap[fromp].push_back(top);
-    }
-    static void hierarchyRemove(const VerilatedScope* fromp,
-                                const VerilatedScope* top) VL_MT_SAFE {
-        // Slow ok - called at destruction for VPI accessible elements
-        const VerilatedLockGuard lock{s().m_hierMapMutex};
-        VerilatedHierarchyMap& map = s().m_hierMap;
-        if (map.find(fromp) == map.end()) return;
-        auto& scopes = map[fromp];
-        const auto it = find(scopes.begin(), scopes.end(), top);
-        if (it != scopes.end()) scopes.erase(it);
-    }
-    static const VerilatedHierarchyMap* hierarchyMap() VL_MT_SAFE_POSTINIT {
-        // Thread save only assuming this is called only after model construction completed
-        return &s().m_hierMap;
-    }
-
     // METHODS - export names - only for verilated*.cpp
 
     // Each function prototype is converted to a function number which we
@@ -537,21 +652,34 @@ public:
     // in the design that also happen to have our same callback function.
     // Rather than a 2D map, the integer scheme saves 500ish ns on a likely
     // miss at the cost of a multiply, and all lookups move to slowpath.
+    //
+    // Numbers are never reassigned, so each thread keeps a cache of the names it has
+    // looked up, and constructing models in parallel does not contend on the lock.
     static int exportInsert(const char* namep) VL_MT_SAFE {
-        // Slow ok - called once/function at creation
+        // Called once/scope*function at creation
+        ExportCacheEntry& entry = exportCacheEntry(namep);
+        if (VL_LIKELY(entry.m_namep == namep)) return entry.m_funcnum;
         const VerilatedLockGuard lock{s().m_exportMutex};
         const auto it = s().m_exportMap.find(namep);
         if (it == s().m_exportMap.end()) {
             s().m_exportMap.emplace(namep, s().m_exportNext++);
             return s().m_exportNext++;
         } else {
+            entry.m_namep = namep;
+            entry.m_funcnum = it->second;
             return it->second;
         }
     }
     static int exportFind(const char* namep) VL_MT_SAFE {
+        ExportCacheEntry& entry = exportCacheEntry(namep);
+        if (VL_LIKELY(entry.m_namep == namep)) return entry.m_funcnum;
         const VerilatedLockGuard lock{s().m_exportMutex};
         const auto& it = s().m_exportMap.find(namep);
-        if (VL_LIKELY(it != s().m_exportMap.end())) return it->second;
+        if (VL_LIKELY(it != s().m_exportMap.end())) {
+            entry.m_namep = namep;
+            entry.m_funcnum = it->second;
+            return it->second;
+        }
         const std::string msg = ("%Error: Testbench C called "s + namep
                                  + " but no such DPI export function name exists in ANY model");
         VL_FATAL_MT("unknown", 0, "", msg.c_str());
@@ -0,0 +1,177 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+///
+/// \file
+/// \brief Verilated batched multi-instance evaluation header
+///
+/// This file is for inclusion by user wrappers that simulate many
+/// independent copies ("lanes") of the same model, e.g. running many
+/// short seeds of a small design in a single process.
+///
+/// Each lane has its own VerilatedContext, so its own time, $finish and
+/// random seed. VlLanes::eval() evaluates all lanes, spreading them over
+/// a pool of worker threads created once for the batch, so small models
+/// Verilated with --threads 1 use all requested cores without creating
+/// threads per evaluation.
+///
+/// Example:
+/// \code
+///     VlLanes<Vtop> lanes{64, 8};  // 64 lanes on 8 threads
+///     for (size_t i = 0; i < lanes.size(); ++i) lanes.contextp(i)->randSeed(i + 1);
+///     while (!lanes.allGotFinish()) {
+///         for (size_t i = 0; i < lanes.size(); ++i) lanes[i].clk = !lanes[i].clk;
+///         lanes.timeInc(1);
+///         lanes.eval();
+///     }
+/// \endcode
+///
+/// VlLanes::forEachLane() instead runs a user function on each unfinished
+/// lane, on that lane's worker thread, so applying a batch of stimuli,
+/// evaluating, and collecting outputs is all done in parallel:
+/// \code
+///     lanes.forEachLane([&](size_t lane, Vtop& top) {
+///         top.in = stimuli[lane][cycle];
+///         top.eval();
+///         results[lane][cycle] = top.out;
+///     });
+/// \endcode
+///
+//*************************************************************************
+
+#ifndef VERILATOR_VERILATED_LANES_H_
+#define VERILATOR_VERILATED_LANES_H_
+
+#include "verilatedos.h"
+
+#include "verilated.h"
+#include "verilated_threads.h"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//===========================================================================
+// VlLanes - Many independent copies of a model, evaluated together
+
+template <typename T_Model>
+class VlLanes final {
+    // MEMBERS
+    std::vector<std::unique_ptr<VerilatedContext>> m_contextps;  // Context of each lane
+    std::vector<std::unique_ptr<T_Model>> m_modelps;  // Model of each lane
+    std::unique_ptr<VlThreadPool> m_poolp;  // Workers evaluating lanes, nullptr if single thread
+    VlMTaskVertex m_done{0};  // Completion of an eval() across all workers
+    bool m_evenCycle = false;  // Even/odd for m_done flag alternation
+    // Function applied to each lane by the current dispatch
+    using LaneFn = void (*)(void* datap, size_t lane, T_Model& model);
+    LaneFn m_laneFnp = nullptr;
+    void* m_laneDatap = nullptr;  // User function object passed to m_laneFnp
+
+    VL_UNCOPYABLE(VlLanes);
+
+    // Evaluate one block of lanes, called from each thread
+    struct Block final {
+        VlLanes* m_selfp;
+        size_t m_begin;
+        size_t m_end;
+    };
+    std::vector<Block> m_blocks;  // Work of each worker thread, main thread does the last
+
+    static void evalBlock(VlSelfP blockp, bool evenCycle) VL_MT_UNSAFE {
+        const Block* const bp = static_cast<const Block*>(blockp);
+        VlLanes* const selfp = bp->m_selfp;
+        for (size_t lane = bp->m_begin; lane < bp->m_end; ++lane) {
+            VerilatedContext* const contextp = selfp->m_contextps[lane].get();
+            if (VL_UNLIKELY(contextp->gotFinish())) continue;
+            Verilated::threadContextp(contextp);
+            selfp->m_laneFnp(selfp->m_laneDatap, lane, *selfp->m_modelps[lane]);
+        }
+    }
+    static void evalWorkerBlock(VlSelfP blockp, bool evenCycle) VL_MT_UNSAFE {
+        evalBlock(blockp, evenCycle);
+        static_cast<const Block*>(blockp)->m_selfp->m_done.signalUpstreamDone(evenCycle);
+    }
+
+public:
+    // CONSTRUCTORS
+    // Create 'lanes' copies of the model, evaluated using 'threads' threads
+    // (including the calling thread)
+    explicit VlLanes(size_t lanes, unsigned threads = 1)
+        : m_done{threads > 1 ? static_cast<uint32_t>(std::min<size_t>(threads, lanes) - 1) : 0} {
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            m_contextps.emplace_back(new VerilatedContext);
+            m_contextps.back()->threads(1);
+            const std::string name = "lane" + std::to_string(lane);
+            m_modelps.emplace_back(new T_Model{m_contextps.back().get(), name.c_str()});
+        }
+        const size_t nBlocks = std::max<size_t>(1, std::min<size_t>(threads, lanes));
+        for (size_t i = 0; i < nBlocks; ++i) {
+            m_blocks.push_back(Block{this, lanes * i / nBlocks, lanes * (i + 1) / nBlocks});
+        }
+        if (nBlocks > 1) {
+            m_poolp.reset(new VlThreadPool{m_contextps.front().get(),
+                                           static_cast<unsigned>(nBlocks - 1)});
+        }
+    }
+    ~VlLanes() {
+        m_poolp.reset();  // Join the workers before the models go away
+        for (const auto& modelp : m_modelps) modelp->final();
+    }
+
+    // METHODS
+    // Number of lanes
+    size_t size() const { return m_modelps.size(); }
+    // Model of given lane
+    T_Model& operator[](size_t lane) { return *m_modelps[lane]; }
+    T_Model* modelp(size_t lane) { return m_modelps[lane].get(); }
+    // Context of given lane
+    VerilatedContext* contextp(size_t lane) { return m_contextps[lane].get(); }
+    // Advance time of every lane
+    void timeInc(uint64_t add) {
+        for (const auto& contextp : m_contextps) contextp->timeInc(add);
+    }
+    // True when every lane executed $finish
+    bool allGotFinish() const {
+        for (const auto& contextp : m_contextps) {
+            if (!contextp->gotFinish()) return false;
+        }
+        return true;
+    }
+    // Evaluate every lane that has not finished
+    void eval() {
+        forEachLane([](size_t, T_Model& model) { model.eval(); });
+    }
+    // Call fn(lane, model) for every lane that has not finished, with lanes
+    // spread over the worker threads. Calls for different lanes may run
+    // concurrently, so fn must only touch state of its own lane.
+    template <typename T_Fn>
+    void forEachLane(T_Fn&& fn) {
+        using Fn = typename std::remove_reference<T_Fn>::type;
+        m_laneFnp = [](void* datap, size_t lane, T_Model& model) {
+            (*static_cast<Fn*>(datap))(lane, model);
+        };
+        m_laneDatap = const_cast<void*>(static_cast<const void*>(&fn));
+        VerilatedContext* const callerp = Verilated::threadContextp();
+        m_evenCycle = !m_evenCycle;
+        const size_t last = m_blocks.size() - 1;
+        for (size_t i = 0; i < last; ++i) {
+            m_poolp->workerp(static_cast<int>(i))->addTask(evalWorkerBlock, &m_blocks[i],
+                                                            m_evenCycle);
+        }
+        evalBlock(&m_blocks[last], m_evenCycle);
+        m_done.waitUntilUpstreamDone(m_evenCycle);
+        Verilated::threadContextp(callerp);
+    }
+};
+
+#endif  // Guard
@@ -22,15 +22,28 @@
 
 #include "verilated_threads.h"
 
+#include <cerrno>
+#include <cstring>
 #include <fstream>
 #include <string>
 
+#if defined(__linux)
+# include <linux/perf_event.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# ifdef SYS_perf_event_open
+#  define VL_PERF_EVENT
+# endif
+#endif
+
 //=============================================================================
 // Globals
 
 // Internal note: Globals may multi-construct, see verilated.cpp top.
 
 thread_local VlExecutionProfiler::ExecutionTrace VlExecutionProfiler::t_trace;
+thread_local VlExecutionProfiler::HwCounterTrace VlExecutionProfiler::t_hwTrace;
+thread_local int VlExecutionProfiler::t_hwFd = -1;
 
 constexpr const char* const VlExecutionRecord::s_ascii[];
 
@@ -50,7 +63,19 @@ VlExecutionProfiler::VlExecutionProfiler(VerilatedContext& context)
     setupThread(0);
 }
 
+VlExecutionProfiler::~VlExecutionProfiler() {
+    if (m_samples) sampleDump(m_context.profVltFilename().c_str());
+#ifdef VL_PERF_EVENT
+    const VerilatedLockGuard lock{m_mutex};
+    for (const int fd : m_hwFds) close(fd);
+#endif
+}
+
 void VlExecutionProfiler::configure() {
+    if (VL_UNLIKELY(m_context.profExecSample())) {
+        configureSample();
+        return;
+    }
 
     if (VL_UNLIKELY(m_enabled)) {
         --m_windowCount;
@@ -79,6 +104,100 @@ void VlExecutionProfiler::configure() {
     }
 }
 
+void VlExecutionProfiler::configureSample() {
+    if (VL_UNLIKELY(m_enabled)) {
+        // The previous eval was sampled
+        m_enabled = false;
+        sampleCollect();
+        if (++m_samples % SAMPLE_DUMP_PERIOD == 0) {
+            sampleDump(m_context.profVltFilename().c_str());
+        }
+    }
+    if (VL_TIME_Q() < m_context.profExecStart()) return;
+    if (VL_UNLIKELY(m_sampleCountdown == 0)) {
+        m_sampleCountdown = m_context.profExecSample();
+        m_enabled = true;
+    }
+    --m_sampleCountdown;
+}
+
+void VlExecutionProfiler::addMTask(const char* modelp, uint32_t id, const char* hashNamep,
+                                   uint64_t costEstimate) VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    m_sampleModel = modelp;
+    if (id >= m_mtaskSamples.size()) m_mtaskSamples.resize(id + 1);
+    m_mtaskSamples[id].m_hashName = hashNamep;
+    m_mtaskSamples[id].m_costEstimate = costEstimate;
+}
+
+void VlExecutionProfiler::addMTaskDep(uint32_t fromId, uint32_t toId)
+    VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    m_mtaskDeps.emplace_back(fromId, toId);
+}
+
+void VlExecutionProfiler::sampleCollect() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    {
+        const VerilatedLockGuard lock{m_mutex};
+        for (const auto& pair : m_traceps) {
+            uint64_t beginTick = 0;
+            for (const VlExecutionRecord& er : *pair.second) {
+                if (er.m_type == VlExecutionRecord::Type::MTASK_BEGIN) {
+                    beginTick = er.m_tick;
+                } else if (er.m_type == VlExecutionRecord::Type::MTASK_END) {
+                    const uint32_t id = er.m_payload.mtaskEnd.m_id;
+                    if (id >= m_mtaskSamples.size()) m_mtaskSamples.resize(id + 1);
+                    MTaskSamples& samples = m_mtaskSamples[id];
+                    const uint64_t ticks = er.m_tick - beginTick;
+                    size_t bucket = 0;
+                    for (uint64_t t = ticks; t > 1 && bucket < SAMPLE_BUCKETS - 1; t >>= 1) {
+                        ++bucket;
+                    }
+                    ++samples.m_count;
+                    samples.m_ticks += ticks;
+                    ++samples.m_histogram[bucket];
+                }
+            }
+        }
+    }
+    clear();  // Keep memory constant, the traces only ever hold one eval
+}
+
+void VlExecutionProfiler::sampleDump(const char* filenamep) VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    VL_DEBUG_IF(VL_DBG_MSGF("+prof+exec+sample writing to '%s'\n", filenamep););
+
+    FILE* const fp = std::fopen(filenamep, "w");
+    if (VL_UNLIKELY(!fp)) VL_FATAL_MT(filenamep, 0, "", "+prof+vlt+file file not writable");
+
+    fprintf(fp, "// Verilated model sampled execution profile data dump file\n");
+    fprintf(fp, "// %" PRIu64 " evals sampled, one in %u\n", m_samples,
+            m_context.profExecSample());
+    fprintf(fp, "`verilator_config\n");
+    for (size_t id = 0; id < m_mtaskSamples.size(); ++id) {
+        const MTaskSamples& samples = m_mtaskSamples[id];
+        if (!samples.m_count) continue;
+        // Histogram as a comment, so the file can be read back by --prof-pgo
+        fprintf(fp, "// mtask %zu count %" PRIu64 " histogram log2(ticks)", id, samples.m_count);
+        for (size_t bucket = 0; bucket < SAMPLE_BUCKETS; ++bucket) {
+            if (samples.m_histogram[bucket]) {
+                fprintf(fp, " %zu:%" PRIu64, bucket, samples.m_histogram[bucket]);
+            }
+        }
+        fprintf(fp, "\n");
+        // Scaled to estimate the cost over all evals, as --prof-pgo would measure
+        if (!samples.m_hashName.empty()) {
+            fprintf(fp,
+                    "profile_data -model \"%s\" -mtask \"%s\" -cost 64'd%" PRIu64
+                    "  // estimate %" PRIu64 "\n",
+                    m_sampleModel.c_str(), samples.m_hashName.c_str(),
+                    samples.m_ticks * m_context.profExecSample(), samples.m_costEstimate);
+        }
+    }
+
+    std::fclose(fp);
+}
+
 VerilatedVirtualBase* VlExecutionProfiler::construct(VerilatedContext& context) {
     VlExecutionProfiler* const selfp = new VlExecutionProfiler{context};
     if (VlThreadPool* const threadPoolp = static_cast<VlThreadPool*>(context.threadPoolp())) {
@@ -117,6 +236,88 @@ void VlExecutionProfiler::setupThread(uint32_t threadId) {
     if (VL_UNLIKELY(exists)) {
         VL_FATAL_MT(__FILE__, __LINE__, "", "multiple initialization of profiler on some thread");
     }
+    t_hwFd = -1;
+    if (m_context.profExecHwCounters() && setupHwCounters(threadId)) {
+        t_hwTrace.reserve(RESERVED_TRACE_CAPACITY);
+    }
+}
+
+const char* VlExecutionProfiler::hwCounterName(HwCounter counter) {
+    static const char* const s_names[N_HW]
+        = {"cycles", "instrs", "l1dMisses", "llcMisses", "branchMisses"};
+    return s_names[counter];
+}
+
+bool VlExecutionProfiler::setupHwCounters(uint32_t threadId) VL_MT_SAFE_EXCLUDES(m_mutex) {
+#ifdef VL_PERF_EVENT
+    // Counted as one group, so all are scheduled onto the PMU together and read with one call
+    static constexpr struct {
+        uint32_t m_type;
+        uint64_t m_config;
+    } s_events[N_HW] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                 | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+    std::array<int, N_HW> fds;
+    fds.fill(-1);
+    for (int i = 0; i < N_HW; ++i) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = s_events[i].m_type;
+        attr.config = s_events[i].m_config;
+        attr.read_format = PERF_FORMAT_GROUP;
+        // User space only, so it works with the default perf_event_paranoid setting
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fds[i] = static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0 /*this thread*/, -1 /*any cpu*/, fds[0], 0));
+        if (VL_UNLIKELY(fds[i] < 0)) {
+            const std::string status = std::string{"unavailable, perf_event_open "}
+                                       + hwCounterName(static_cast<HwCounter>(i)) + ": "
+                                       + std::strerror(errno);
+            for (int j = 0; j < i; ++j) close(fds[j]);
+            const VerilatedLockGuard lock{m_mutex};
+            if (m_hwStatus.empty() || m_hwStatus == "enabled") {
+                VL_PRINTF_MT("%%Warning: +verilator+prof+exec+hwcounters %s\n", status.c_str());
+            }
+            m_hwStatus = status;
+            return false;
+        }
+    }
+    t_hwFd = fds[0];
+    const VerilatedLockGuard lock{m_mutex};
+    m_hwTraceps.emplace(threadId, &t_hwTrace);
+    m_hwFds.insert(m_hwFds.end(), fds.begin(), fds.end());
+    if (m_hwStatus.empty()) m_hwStatus = "enabled";
+    return true;
+#else
+    (void)threadId;
+    const VerilatedLockGuard lock{m_mutex};
+    m_hwStatus = "unavailable, not supported on this platform";
+    return false;
+#endif
+}
+
+void VlExecutionProfiler::addHwCounters() {
+    HwCounterValues values{};
+#ifdef VL_PERF_EVENT
+    struct {
+        uint64_t m_nr;  // Number of values, as PERF_FORMAT_GROUP
+        uint64_t m_values[N_HW];
+    } buf;
+    if (VL_LIKELY(read(t_hwFd, &buf, sizeof(buf)) == sizeof(buf))) {
+        for (int i = 0; i < N_HW; ++i) values[i] = buf.m_values[i];
+    }
+#endif
+    const uint32_t index = static_cast<uint32_t>(t_hwTrace.size());
+    t_hwTrace.push_back(values);
+    t_trace.emplace_back();
+    t_trace.back().hwCounters(index);
 }
 
 void VlExecutionProfiler::clear() VL_MT_SAFE_EXCLUDES(m_mutex) {
@@ -127,6 +328,12 @@ void VlExecutionProfiler::clear() VL_MT_SAFE_EXCLUDES(m_mutex) {
         tracep->clear();
         tracep->reserve(reserve);
     }
+    for (const auto& pair : m_hwTraceps) {
+        HwCounterTrace* const tracep = pair.second;
+        const size_t reserve = roundUptoMultipleOf<RESERVED_TRACE_CAPACITY>(tracep->size());
+        tracep->clear();
+        tracep->reserve(reserve);
+    }
 }
 
 void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
@@ -139,7 +346,7 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
 
     // TODO Perhaps merge with verilated_coverage output format, so can
     // have a common merging and reporting tool, etc.
-    fprintf(fp, "VLPROFVERSION 2.2 # Verilator execution profile version 2.2\n");
+    fprintf(fp, "VLPROFVERSION 2.3 # Verilator execution profile version 2.3\n");
     fprintf(fp, "VLPROF arg +verilator+prof+exec+start+%" PRIu64 "\n",
             Verilated::threadContextp()->profExecStart());
     fprintf(fp, "VLPROF arg +verilator+prof+exec+window+%u\n",
@@ -150,6 +357,7 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
         numa = threadPoolp->numaStatus();
     }
     fprintf(fp, "VLPROF info numa %s\n", numa.c_str());
+    if (!m_hwStatus.empty()) fprintf(fp, "VLPROF info hwcounters %s\n", m_hwStatus.c_str());
     // Note that VerilatedContext will by default create as many threads as there are hardware
     // processors, but not all of them might be utilized. Report the actual number that has trace
     // entries to avoid over-counting.
@@ -159,6 +367,11 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
     }
     fprintf(fp, "VLPROF stat threads %u\n", threads);
     fprintf(fp, "VLPROF stat yields %" PRIu64 "\n", VlMTaskVertex::yields());
+    fprintf(fp, "VLPROF stat parks %" PRIu64 "\n", VlMTaskVertex::parks());
+    fprintf(fp, "VLPROF stat parkTicks %" PRIu64 "\n", VlMTaskVertex::parkTicks());
+    for (const auto& dep : m_mtaskDeps) {
+        fprintf(fp, "VLPROF mtaskdep %" PRIu32 " %" PRIu32 "\n", dep.first, dep.second);
+    }
 
     // Copy /proc/cpuinfo into this output so verilator_gantt can be run on
     // a different machine
@@ -175,6 +388,8 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
         ExecutionTrace* const tracep = pair.second;
         if (tracep->empty()) continue;
         fprintf(fp, "VLPROFTHREAD %" PRIu32 "\n", threadId);
+        const auto hwIt = m_hwTraceps.find(threadId);
+        const HwCounterTrace* const hwTracep = hwIt == m_hwTraceps.end() ? nullptr : hwIt->second;
 
         for (const VlExecutionRecord& er : *tracep) {
             const char* const name = VlExecutionRecord::s_ascii[static_cast<uint8_t>(er.m_type)];
@@ -210,6 +425,16 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
                 fprintf(fp, " %s\n", payload.m_name);
                 break;
             }
+            case VlExecutionRecord::Type::HW_COUNTERS: {
+                const auto& payload = er.m_payload.hwCounters;
+                const HwCounterValues& values = hwTracep->at(payload.m_index);
+                for (int i = 0; i < N_HW; ++i) {
+                    fprintf(fp, " %s %" PRIu64, hwCounterName(static_cast<HwCounter>(i)),
+                            values[i]);
+                }
+                fprintf(fp, "\n");
+                break;
+            }
             default: abort();  // LCOV_EXCL_LINE
             }
         }
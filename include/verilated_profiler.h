@@ -65,7 +65,8 @@ VL_ATTR_ALWINLINE QData VL_CPU_TICK() {
     _VL_FOREACH_APPLY(macro, THREAD_SCHEDULE_WAIT_BEGIN) \
     _VL_FOREACH_APPLY(macro, THREAD_SCHEDULE_WAIT_END) \
     _VL_FOREACH_APPLY(macro, EXEC_GRAPH_BEGIN) \
-    _VL_FOREACH_APPLY(macro, EXEC_GRAPH_END)
+    _VL_FOREACH_APPLY(macro, EXEC_GRAPH_END) \
+    _VL_FOREACH_APPLY(macro, HW_COUNTERS)
 // clang-format on
 
 class VlExecutionRecord final {
@@ -100,6 +101,9 @@ class VlExecutionRecord final {
         struct {
             uint32_t m_cpu;  // Executing CPU id
         } threadScheduleWait;
+        struct {
+            uint32_t m_index;  // Index of values in the hardware counter trace
+        } hwCounters;
     };
 
     // STATE
@@ -141,6 +145,10 @@ public:
     }
     void execGraphBegin() { m_type = Type::EXEC_GRAPH_BEGIN; }
     void execGraphEnd() { m_type = Type::EXEC_GRAPH_END; }
+    void hwCounters(uint32_t index) {
+        m_payload.hwCounters.m_index = index;
+        m_type = Type::HW_COUNTERS;
+    }
 };
 
 static_assert(std::is_trivially_destructible<VlExecutionRecord>::value,
@@ -155,6 +163,10 @@ class VlExecutionProfiler final : public VerilatedVirtualBase {
     // In order to try to avoid dynamic memory allocations during the actual profiling phase,
     // trace buffers are pre-allocated to be able to hold [a multiple] of this many records.
     static constexpr size_t RESERVED_TRACE_CAPACITY = 4096;
+    // In sampling mode, rewrite the profile after this many sampled evals
+    static constexpr uint64_t SAMPLE_DUMP_PERIOD = 1024;
+    // In sampling mode, histogram buckets of mtask execution time, by log2(ticks)
+    static constexpr size_t SAMPLE_BUCKETS = 32;
 
     // TYPES
 
@@ -166,12 +178,35 @@ class VlExecutionProfiler final : public VerilatedVirtualBase {
     // verilated.cpp top.
     using ExecutionTrace = std::vector<VlExecutionRecord>;
 
+public:
+    // Hardware performance counters sampled with +verilator+prof+exec+hwcounters
+    enum HwCounter : uint8_t { CYCLES, INSTRS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, N_HW };
+    using HwCounterValues = std::array<uint64_t, N_HW>;
+
+private:
+    // Hardware counter values, referenced by index from HW_COUNTERS records
+    using HwCounterTrace = std::vector<HwCounterValues>;
+    // Sampling mode statistics of one mtask, aggregated in place
+    struct MTaskSamples final {
+        std::string m_hashName;  // Hashed name, as used by profile_data, or empty if unknown
+        uint64_t m_costEstimate = 0;  // Verilator's estimate of the cost
+        uint64_t m_count = 0;  // Number of sampled executions
+        uint64_t m_ticks = 0;  // Total ticks of sampled executions
+        std::array<uint64_t, SAMPLE_BUCKETS> m_histogram{};  // Executions by log2(ticks)
+    };
+
     // STATE
     VerilatedContext& m_context;  // The context this profiler is under
     static thread_local ExecutionTrace t_trace;  // thread-local trace buffers
+    static thread_local HwCounterTrace t_hwTrace;  // thread-local hardware counter buffers
+    static thread_local int t_hwFd;  // perf_event group of current thread, or -1 if none
     mutable VerilatedMutex m_mutex;
     // Map from thread id to &t_trace of given thread
     std::map<uint32_t, ExecutionTrace*> m_traceps VL_GUARDED_BY(m_mutex);
+    // Map from thread id to &t_hwTrace of given thread, if hardware counters opened
+    std::map<uint32_t, HwCounterTrace*> m_hwTraceps VL_GUARDED_BY(m_mutex);
+    std::vector<int> m_hwFds VL_GUARDED_BY(m_mutex);  // perf_event groups to close
+    std::string m_hwStatus VL_GUARDED_BY(m_mutex);  // Hardware counter status for dump
 
     bool m_enabled = false;  // Is profiling currently enabled
 
@@ -179,10 +214,18 @@ class VlExecutionProfiler final : public VerilatedVirtualBase {
     uint64_t m_lastStartReq = 0;  // Last requested profiling start (in simulation time)
     uint32_t m_windowCount = 0;  // Track our position in the cache warmup and profile window
 
+    // Sampling mode, see +verilator+prof+exec+sample
+    std::string m_sampleModel VL_GUARDED_BY(m_mutex);  // Model name for profile_data
+    std::vector<MTaskSamples> m_mtaskSamples VL_GUARDED_BY(m_mutex);  // Indexed by mtask id
+    // MTask dependencies as (from, to) ids, for verilator_gantt
+    std::vector<std::pair<uint32_t, uint32_t>> m_mtaskDeps VL_GUARDED_BY(m_mutex);
+    uint64_t m_samples = 0;  // Number of sampled evals
+    uint32_t m_sampleCountdown = 0;  // Evals until next sample
+
 public:
     // CONSTRUCTOR
     explicit VlExecutionProfiler(VerilatedContext& context);
-    ~VlExecutionProfiler() override = default;
+    ~VlExecutionProfiler() override;
 
     // METHODS
 
@@ -190,9 +233,13 @@ public:
     bool enabled() const { return m_enabled; }
     // Append a trace record to the trace buffer of the current thread
     static VlExecutionRecord& addRecord() {
+        // The counters are sampled just before the record that follows them
+        if (VL_UNLIKELY(t_hwFd >= 0)) addHwCounters();
         t_trace.emplace_back();
         return t_trace.back();
     }
+    // Names of hardware counters as written to the profile
+    static const char* hwCounterName(HwCounter counter);
     // Configure profiler (called in beginning of 'eval')
     void configure();
     // Setup profiling on a particular thread;
@@ -201,9 +248,26 @@ public:
     void clear() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Write profiling data into file
     void dump(const char* filenamep, uint64_t tickEnd) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Register the hashed name of an mtask, for sampling mode profile_data
+    void addMTask(const char* modelp, uint32_t id, const char* hashNamep, uint64_t costEstimate)
+        VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Register that mtask 'toId' depends on mtask 'fromId', for the dump
+    void addMTaskDep(uint32_t fromId, uint32_t toId) VL_MT_SAFE_EXCLUDES(m_mutex);
 
     // Passed to VerilatedContext to create the VlExecutionProfiler profiler instance
     static VerilatedVirtualBase* construct(VerilatedContext& context);
+
+private:
+    // Sampling mode part of configure
+    void configureSample();
+    // Aggregate the traces of a sampled eval into m_mtaskSamples, and clear them
+    void sampleCollect() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Write sampling mode statistics as profile_data into file
+    void sampleDump(const char* filenamep) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Open hardware counters on the current thread, return false if not available
+    bool setupHwCounters(uint32_t threadId) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Append a HW_COUNTERS record with the current counter values
+    VL_ATTR_NOINLINE static void addHwCounters();
 };
 
 //=============================================================================
@@ -215,6 +279,7 @@ class VlPgoProfiler final {
     struct Record final {
         const std::string m_name;  // Hashed name of mtask/etc
         const size_t m_counterNumber = 0;  // Which counter has data
+        const uint64_t m_costEstimate = 0;  // Verilator's estimate of the cost
     };
 
     // Counters are stored packed, all together to reduce cache effects
@@ -226,9 +291,9 @@ public:
     VlPgoProfiler() = default;
     ~VlPgoProfiler() = default;
     void write(const char* modelp, const std::string& filename, bool firstHierCall) VL_MT_SAFE;
-    void addCounter(size_t counter, const std::string& name) {
+    void addCounter(size_t counter, const std::string& name, uint64_t costEstimate = 0) {
         VL_DEBUG_IF(assert(counter < N_Entries););
-        m_records.emplace_back(Record{name, counter});
+        m_records.emplace_back(Record{name, counter, costEstimate});
     }
     void startCounter(size_t counter) {
         // -= so when we add end time in stopCounter, the net effect is adding the difference,
@@ -268,8 +333,68 @@ void VlPgoProfiler<N_Entries>::write(const char* modelp, const std::string& file
     s_firstCall = false;
 
     for (const Record& rec : m_records) {
-        fprintf(fp, "profile_data -model \"%s\" -mtask \"%s\" -cost 64'd%" PRIu64 "\n", modelp,
-                rec.m_name.c_str(), m_counters[rec.m_counterNumber]);
+        // The estimate is a comment, for verilator_pgo_merge drift reports
+        fprintf(fp,
+                "profile_data -model \"%s\" -mtask \"%s\" -cost 64'd%" PRIu64
+                "  // estimate %" PRIu64 "\n",
+                modelp, rec.m_name.c_str(), m_counters[rec.m_counterNumber], rec.m_costEstimate);
+    }
+
+    std::fclose(fp);
+}
+
+//=============================================================================
+// VlPgoBranchProfiler is for collecting branch outcomes for PGO
+
+template <std::size_t N_Entries>
+class VlPgoBranchProfiler final {
+    // Counters are stored packed, two per branch: [2*i] when taken, [2*i+1] when not taken.
+    // Increments are not atomic; with threads an occasional lost count does not matter here.
+    std::array<uint64_t, N_Entries> m_counters{};
+    std::vector<std::string> m_names;  // Source location of each branch, by branch number
+
+public:
+    // METHODS
+    VlPgoBranchProfiler() = default;
+    ~VlPgoBranchProfiler() = default;
+    void write(const std::string& filename, bool firstHierCall) VL_MT_SAFE;
+    void addBranch(const std::string& name) { m_names.emplace_back(name); }
+    void count(size_t counter) {
+        VL_DEBUG_IF(assert(counter < N_Entries););
+        ++m_counters[counter];
+    }
+};
+
+template <std::size_t N_Entries>
+void VlPgoBranchProfiler<N_Entries>::write(const std::string& filename,
+                                           bool firstHierCall) VL_MT_SAFE {
+    static VerilatedMutex s_mutex;
+    const VerilatedLockGuard lock{s_mutex};
+
+    // See VlPgoProfiler::write for how multiple models share the file
+    static bool s_firstCall = firstHierCall;
+
+    VL_DEBUG_IF(VL_DBG_MSGF("+prof+vlt+file writing branches to '%s'\n", filename.c_str()););
+
+    FILE* const fp = std::fopen(filename.c_str(), s_firstCall ? "w" : "a");
+    if (VL_UNLIKELY(!fp)) {
+        VL_FATAL_MT(filename.c_str(), 0, "", "+prof+vlt+file file not writable");
+    }
+    if (s_firstCall) {
+        fprintf(fp, "// Verilated model profile-guided optimization data dump file\n");
+        fprintf(fp, "`verilator_config\n");
+    }
+
+    s_firstCall = false;
+
+    for (size_t i = 0; i < m_names.size(); ++i) {
+        const uint64_t taken = m_counters[2 * i];
+        const uint64_t notTaken = m_counters[2 * i + 1];
+        if (!taken && !notTaken) continue;  // Never reached
+        fprintf(fp,
+                "profile_data -branch \"%s\" -taken 64'd%" PRIu64 " -not-taken 64'd%" PRIu64
+                "\n",
+                m_names[i].c_str(), taken, notTaken);
     }
 
     std::fclose(fp);
@@ -22,6 +22,8 @@
 
 #include "verilated_random.h"
 
+#include <algorithm>
+#include <cctype>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -365,34 +367,351 @@ void VlRandomizer::randomConstraint(std::ostream& os, VlRNG& rngr, int bits) {
     os << ')';
 }
 
+//======================================================================
+// Solving constraints without the SMT solver
+//
+// Constraints that each only bound a single variable by constants, as from
+// ranges, 'inside' and 'dist', are solved in process by intersecting the
+// allowed values of each variable, then picking uniformly from them.
+
+namespace {
+
+struct VlRandomSExpr final {
+    std::string m_atom;  // Atom, or empty if a list
+    std::vector<VlRandomSExpr> m_items;  // List items
+};
+
+// Parse S-expression starting at pos, advancing pos past it
+bool vlRandomParse(const std::string& str, size_t& pos, VlRandomSExpr& exprr) {
+    while (pos < str.size() && std::isspace(str[pos])) ++pos;
+    if (pos >= str.size() || str[pos] == ')') return false;
+    if (str[pos] != '(') {
+        const size_t start = pos;
+        while (pos < str.size() && !std::isspace(str[pos]) && str[pos] != '('
+               && str[pos] != ')')
+            ++pos;
+        exprr.m_atom = str.substr(start, pos - start);
+        return true;
+    }
+    ++pos;
+    while (true) {
+        while (pos < str.size() && std::isspace(str[pos])) ++pos;
+        if (pos >= str.size()) return false;
+        if (str[pos] == ')') break;
+        exprr.m_items.emplace_back();
+        if (!vlRandomParse(str, pos, exprr.m_items.back())) return false;
+    }
+    ++pos;
+    return !exprr.m_items.empty();
+}
+
+// Sorted, disjoint, inclusive ranges of values
+using VlRandomRanges = std::vector<std::pair<QData, QData>>;
+
+VlRandomRanges vlRandomIntersect(const VlRandomRanges& a, const VlRandomRanges& b) {
+    VlRandomRanges out;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < a.size() && j < b.size()) {
+        const QData lo = std::max(a[i].first, b[j].first);
+        const QData hi = std::min(a[i].second, b[j].second);
+        if (lo <= hi) out.emplace_back(lo, hi);
+        if (a[i].second < b[j].second) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    return out;
+}
+VlRandomRanges vlRandomUnion(const VlRandomRanges& a, const VlRandomRanges& b) {
+    VlRandomRanges all{a};
+    all.insert(all.end(), b.begin(), b.end());
+    std::sort(all.begin(), all.end());
+    VlRandomRanges out;
+    for (const auto& range : all) {
+        if (!out.empty()
+            && (out.back().second == ~0ULL || range.first <= out.back().second + 1)) {
+            out.back().second = std::max(out.back().second, range.second);
+        } else {
+            out.push_back(range);
+        }
+    }
+    return out;
+}
+VlRandomRanges vlRandomComplement(const VlRandomRanges& a, QData mask) {
+    VlRandomRanges out;
+    QData next = 0;
+    bool more = true;  // Values from 'next' up to 'mask' are not yet covered
+    for (const auto& range : a) {
+        if (range.first > next) out.emplace_back(next, range.first - 1);
+        if (range.second >= mask) {
+            more = false;
+            break;
+        }
+        next = range.second + 1;
+    }
+    if (more) out.emplace_back(next, mask);
+    return out;
+}
+
+// Parse SMT constant atom, false if not a constant that fits in 64 bits
+bool vlRandomConst(const std::string& atom, QData& valuer) {
+    if (atom.size() < 3 || atom[0] != '#' || (atom[1] != 'b' && atom[1] != 'x')) return false;
+    const int bitsPerDigit = atom[1] == 'b' ? 1 : 4;
+    valuer = 0;
+    for (size_t i = 2; i < atom.size(); ++i) {
+        const int digit = std::isdigit(atom[i])    ? atom[i] - '0'
+                          : std::isxdigit(atom[i]) ? std::tolower(atom[i]) - 'a' + 10
+                                                   : -1;
+        if (digit < 0 || digit >= (1 << bitsPerDigit)) return false;
+        if (valuer >> (64 - bitsPerDigit)) return false;  // Would overflow
+        valuer = (valuer << bitsPerDigit) | digit;
+    }
+    return true;
+}
+
+class VlRandomSimple final {
+    const std::string& m_name;  // Variable the constraint bounds
+    const int m_width;  // Variable width
+    const QData m_mask;  // Variable value mask
+
+    // Values of the variable for which var 'op' value holds, false if not simple
+    bool compare(const std::string& op, QData value, VlRandomRanges& out) const {
+        const QData sign = 1ULL << (m_width - 1);
+        if (value > m_mask) return false;
+        const bool isSigned = op.size() == 5 && op[2] == 's';
+        // Signed compares are made unsigned by inverting the sign bit of both sides
+        if (isSigned) value ^= sign;
+        const std::string uop = isSigned ? "bvu" + op.substr(3) : op;
+        QData lo = 0;
+        QData hi = m_mask;
+        if (uop == "=") {
+            lo = hi = value;
+        } else if (uop == "bvult") {
+            if (value == 0) return true;
+            hi = value - 1;
+        } else if (uop == "bvule") {
+            hi = value;
+        } else if (uop == "bvugt") {
+            if (value >= m_mask) return true;
+            lo = value + 1;
+        } else if (uop == "bvuge") {
+            lo = value;
+        } else {
+            return false;
+        }
+        if (lo > hi) return true;
+        if (!isSigned || (lo & sign) == (hi & sign)) {
+            out.emplace_back(lo ^ (isSigned ? sign : 0), hi ^ (isSigned ? sign : 0));
+        } else {
+            out.emplace_back(0, hi ^ sign);
+            out.emplace_back(lo ^ sign, m_mask);
+        }
+        return true;
+    }
+    static const char* swapped(const std::string& op) {
+        if (op == "bvult") return "bvugt";
+        if (op == "bvule") return "bvuge";
+        if (op == "bvugt") return "bvult";
+        if (op == "bvuge") return "bvule";
+        if (op == "bvslt") return "bvsgt";
+        if (op == "bvsle") return "bvsge";
+        if (op == "bvsgt") return "bvslt";
+        if (op == "bvsge") return "bvsle";
+        return op == "=" ? "=" : "";
+    }
+    // Values for which Bool expression holds
+    bool boolRanges(const VlRandomSExpr& expr, VlRandomRanges& out) const {
+        const std::vector<VlRandomSExpr>& items = expr.m_items;
+        if (items.size() == 2 && items[0].m_atom == "not") {
+            VlRandomRanges sub;
+            if (!boolRanges(items[1], sub)) return false;
+            out = vlRandomComplement(sub, m_mask);
+            return true;
+        }
+        if (items.size() == 2 && items[0].m_atom == "__Vbool") return ranges(items[1], out);
+        if (items.size() == 3 && items[0].m_atom == "=>") {
+            VlRandomRanges lhs;
+            VlRandomRanges rhs;
+            if (!boolRanges(items[1], lhs) || !boolRanges(items[2], rhs)) return false;
+            out = vlRandomUnion(vlRandomComplement(lhs, m_mask), rhs);
+            return true;
+        }
+        if (items.size() != 3) return false;
+        const std::string& op = items[0].m_atom;
+        QData value;
+        if (items[1].m_atom == m_name && vlRandomConst(items[2].m_atom, value)) {
+            return compare(op, value, out);
+        }
+        if (items[2].m_atom == m_name && vlRandomConst(items[1].m_atom, value)) {
+            return compare(swapped(op), value, out);
+        }
+        return false;
+    }
+
+public:
+    VlRandomSimple(const std::string& name, int width)
+        : m_name{name}
+        , m_width{width}
+        , m_mask{VL_MASK_Q(width)} {}
+    // Values for which 1-bit vector expression is one, false if not simple
+    bool ranges(const VlRandomSExpr& expr, VlRandomRanges& out) const {
+        QData value;
+        if (vlRandomConst(expr.m_atom, value)) {
+            if (value) out.emplace_back(0, m_mask);
+            return true;
+        }
+        const std::vector<VlRandomSExpr>& items = expr.m_items;
+        if (items.size() == 2 && items[0].m_atom == "__Vbv") return boolRanges(items[1], out);
+        if (items.size() < 3 || (items[0].m_atom != "bvand" && items[0].m_atom != "bvor")) {
+            return false;
+        }
+        const bool isAnd = items[0].m_atom == "bvand";
+        if (!ranges(items[1], out)) return false;
+        for (size_t i = 2; i < items.size(); ++i) {
+            VlRandomRanges sub;
+            if (!ranges(items[i], sub)) return false;
+            out = isAnd ? vlRandomIntersect(out, sub) : vlRandomUnion(out, sub);
+        }
+        return true;
+    }
+};
+
+// Find the only variable referenced in an expression, false if not one
+bool vlRandomVarName(const VlRandomSExpr& expr,
+                     const std::map<std::string, std::shared_ptr<const VlRandomVar>>& vars,
+                     const std::string*& namepr) {
+    if (expr.m_items.empty()) {
+        const auto it = vars.find(expr.m_atom);
+        if (it == vars.end()) return true;
+        if (namepr && *namepr != it->first) return false;
+        namepr = &it->first;
+        return true;
+    }
+    for (const VlRandomSExpr& item : expr.m_items) {
+        if (!vlRandomVarName(item, vars, namepr)) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+bool VlRandomizer::nextSimple(VlRNG& rngr) {
+    std::map<std::string, VlRandomRanges> allowed;
+    for (const auto& var : m_vars) {
+        const int width = var.second->width();
+        if (var.second->dimension() > 0 || width < 1 || width > VL_QUADSIZE) return false;
+        allowed.emplace(var.first, VlRandomRanges{{0, VL_MASK_Q(width)}});
+    }
+    for (const std::string& constraint : m_constraints) {
+        VlRandomSExpr expr;
+        size_t pos = 0;
+        if (!vlRandomParse(constraint, pos, expr)) return false;
+        const std::string* namep = nullptr;
+        if (!vlRandomVarName(expr, m_vars, namep)) return false;
+        if (!namep) {  // Constant, #b1 holds, leave others for the solver
+            QData value;
+            if (!vlRandomConst(expr.m_atom, value) || !value) return false;
+            continue;
+        }
+        VlRandomRanges values;
+        if (!VlRandomSimple{*namep, m_vars[*namep]->width()}.ranges(expr, values)) return false;
+        VlRandomRanges& rangesr = allowed[*namep];
+        rangesr = vlRandomIntersect(rangesr, values);
+        if (rangesr.empty()) return false;  // Report unsatisfiable from the solver
+    }
+    for (const auto& var : m_vars) {
+        const VlRandomVar& varr = *var.second;
+        if (m_randmode && !varr.randModeIdxNone()) {
+            if (!(m_randmode->at(varr.randModeIdx()))) continue;
+        }
+        const VlRandomRanges& ranges = allowed[var.first];
+        QData count = 0;  // Number of allowed values, zero if all 2^64
+        for (const auto& range : ranges) count += range.second - range.first + 1;
+        QData value = VL_RANDOM_RNG_Q(rngr);
+        if (count) {
+            value %= count;
+            for (const auto& range : ranges) {
+                if (value <= range.second - range.first) {
+                    value += range.first;
+                    break;
+                }
+                value -= range.second - range.first + 1;
+            }
+        }
+        const int width = varr.width();
+        void* const datap = varr.datap(0);
+        if (width <= VL_BYTESIZE) {
+            *static_cast<CData*>(datap) = static_cast<CData>(value);
+        } else if (width <= VL_SHORTSIZE) {
+            *static_cast<SData*>(datap) = static_cast<SData>(value);
+        } else if (width <= VL_IDATASIZE) {
+            *static_cast<IData*>(datap) = static_cast<IData>(value);
+        } else {
+            *static_cast<QData*>(datap) = value;
+        }
+    }
+    return true;
+}
+
+// State the solver process was left in, so later randomize() calls with the
+// same variables and constraints need not send them again
+struct VlSolverSession final {
+    std::string m_decls;  // Declarations made, at assertion level 0
+    std::vector<std::string> m_constraints;  // Constraints asserted, at level 1
+};
+static VlSolverSession& solverSession() {
+    static VlSolverSession s_session;
+    return s_session;
+}
+
 bool VlRandomizer::next(VlRNG& rngr) {
     if (m_vars.empty()) return true;
+    if (nextSimple(rngr)) return true;
     std::iostream& f = getSolver();
     if (!f) return false;
 
-    f << "(set-option :produce-models true)\n";
-    f << "(set-logic QF_ABV)\n";
-    f << "(define-fun __Vbv ((b Bool)) (_ BitVec 1) (ite b #b1 #b0))\n";
-    f << "(define-fun __Vbool ((v (_ BitVec 1))) Bool (= #b1 v))\n";
+    std::ostringstream decls;
     for (const auto& var : m_vars) {
         if (var.second->dimension() > 0) {
             auto arrVarsp = std::make_shared<const ArrayInfoMap>(m_arr_vars);
             var.second->setArrayInfo(arrVarsp);
         }
-        f << "(declare-fun " << var.first << " () ";
-        var.second->emitType(f);
-        f << ")\n";
+        decls << "(declare-fun " << var.first << " () ";
+        var.second->emitType(decls);
+        decls << ")\n";
     }
-    for (const std::string& constraint : m_constraints) {
-        f << "(assert (= #b1 " << constraint << "))\n";
+    VlSolverSession& session = solverSession();
+    if (session.m_decls != decls.str()) {
+        if (!session.m_decls.empty()) f << "(reset)\n";
+        f << "(set-option :produce-models true)\n";
+        f << "(set-logic QF_ABV)\n";
+        f << "(define-fun __Vbv ((b Bool)) (_ BitVec 1) (ite b #b1 #b0))\n";
+        f << "(define-fun __Vbool ((v (_ BitVec 1))) Bool (= #b1 v))\n";
+        f << decls.str();
+        session.m_decls = decls.str();
+        session.m_constraints.clear();
+        f << "(push 1)\n";
+    } else if (session.m_constraints != m_constraints) {
+        f << "(pop 1)\n";
+        f << "(push 1)\n";
+    }
+    if (session.m_constraints != m_constraints) {
+        for (const std::string& constraint : m_constraints) {
+            f << "(assert (= #b1 " << constraint << "))\n";
+        }
+        session.m_constraints = m_constraints;
     }
     f << "(check-sat)\n";
 
     bool sat = parseSolution(f);
     if (!sat) {
-        f << "(reset)\n";
+        session.m_decls = "unknown";  // Unsat, or solver error, so start over next time
         return false;
     }
+    // Randomize the solution with hash constraints, removed afterwards
+    f << "(push 1)\n";
     for (int i = 0; i < _VL_SOLVER_HASH_LEN_TOTAL && sat; i++) {
         f << "(assert ";
         randomConstraint(f, rngr, _VL_SOLVER_HASH_LEN);
@@ -400,8 +719,7 @@ bool VlRandomizer::next(VlRNG& rngr) {
         f << "\n(check-sat)\n";
         sat = parseSolution(f);
     }
-
-    f << "(reset)\n";
+    f << "(pop 1)\n";
     return true;
 }
 
@@ -206,6 +206,8 @@ class VlRandomizer final {
     // PRIVATE METHODS
     void randomConstraint(std::ostream& os, VlRNG& rngr, int bits);
     bool parseSolution(std::iostream& file);
+    // Solve without the SMT solver, false if constraints are not all simple bounds
+    bool nextSimple(VlRNG& rngr);
 
 public:
     // CONSTRUCTORS
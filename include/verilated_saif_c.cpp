@@ -64,22 +64,25 @@
 
 class VerilatedSaifActivityBit final {
     // MEMBERS
-    bool m_lastVal = false;  // Last emitted activity bit value
-    uint64_t m_highTime = 0;  // Total time when bit was high
-    size_t m_transitions = 0;  // Total number of bit transitions
+    // Total time when bit was high, less the time it last rose if it is
+    // now high (modulo 2^64), so only transitions need to update it
+    uint64_t m_highTime = 0;
+    uint64_t m_transitions = 0;  // Total number of bit transitions
 
 public:
     // METHODS
+    // Record bit changing to newVal at given time
     VL_ATTR_ALWINLINE
-    void aggregateVal(uint64_t dt, bool newVal) {
-        m_transitions += newVal != m_lastVal ? 1 : 0;
-        m_highTime += m_lastVal ? dt : 0;
-        m_lastVal = newVal;
+    void toggle(uint64_t time, bool newVal) {
+        ++m_transitions;
+        m_highTime += newVal ? (0 - time) : time;
     }
 
     // ACCESSORS
-    VL_ATTR_ALWINLINE bool bitValue() const { return m_lastVal; }
-    VL_ATTR_ALWINLINE uint64_t highTime() const { return m_highTime; }
+    // Total time when bit was high, up to given time, with bit's current value
+    VL_ATTR_ALWINLINE uint64_t highTime(uint64_t time, bool val) const {
+        return m_highTime + (val ? time : 0);
+    }
     VL_ATTR_ALWINLINE uint64_t toggleCount() const { return m_transitions; }
 };
 
@@ -88,14 +91,35 @@ public:
 
 class VerilatedSaifActivityVar final {
     // MEMBERS
-    uint64_t m_lastTime = 0;  // Last time when variable value was updated
     VerilatedSaifActivityBit* m_bits;  // Pointer to variable bits objects
+    EData* m_valuep;  // Pointer to last value, VL_WORDS_I(m_width) words
     uint32_t m_width;  // Width of variable (in bits)
 
+    // Update with new value of one word; only the bits that changed do any work
+    VL_ATTR_ALWINLINE void emitWord(uint64_t time, uint32_t word, EData newval) {
+        const uint32_t lsb = word * VL_EDATASIZE;
+        if (lsb + VL_EDATASIZE > m_width) newval &= VL_MASK_E(m_width);
+        EData changed = m_valuep[word] ^ newval;
+        if (VL_LIKELY(!changed)) return;
+        m_valuep[word] = newval;
+        VerilatedSaifActivityBit* const bitsp = m_bits + lsb;
+        do {
+#if defined(__GNUC__) && !defined(VL_NO_BUILTINS)
+            const int bit = __builtin_ctz(changed);
+#else
+            int bit = 0;
+            while (!((changed >> bit) & 1)) ++bit;
+#endif
+            bitsp[bit].toggle(time, (newval >> bit) & 1);
+            changed &= changed - 1;  // Clear lowest set bit
+        } while (changed);
+    }
+
 public:
     // CONSTRUCTORS
-    VerilatedSaifActivityVar(uint32_t width, VerilatedSaifActivityBit* bits)
+    VerilatedSaifActivityVar(uint32_t width, VerilatedSaifActivityBit* bits, EData* valuep)
         : m_bits{bits}
+        , m_valuep{valuep}
         , m_width{width} {}
 
     VerilatedSaifActivityVar(VerilatedSaifActivityVar&&) = default;
@@ -109,20 +133,20 @@ public:
         static_assert(std::is_integral<DataType>::value,
                       "The emitted value must be of integral type");
 
-        const uint64_t dt = time - m_lastTime;
-        for (size_t i = 0; i < std::min(m_width, bits); i++) {
-            m_bits[i].aggregateVal(dt, (newval >> i) & 1);
+        emitWord(time, 0, static_cast<EData>(newval));
+        if (sizeof(DataType) > sizeof(EData) && m_width > VL_EDATASIZE) {
+            emitWord(time, 1, static_cast<EData>(static_cast<QData>(newval) >> VL_EDATASIZE));
         }
-        updateLastTime(time);
     }
 
     VL_ATTR_ALWINLINE void emitWData(uint64_t time, const WData* newvalp, uint32_t bits);
-    VL_ATTR_ALWINLINE void updateLastTime(uint64_t val) { m_lastTime = val; }
 
     // ACCESSORS
     VL_ATTR_ALWINLINE uint32_t width() const { return m_width; }
     VL_ATTR_ALWINLINE VerilatedSaifActivityBit& bit(std::size_t index);
-    VL_ATTR_ALWINLINE uint64_t lastUpdateTime() const { return m_lastTime; }
+    VL_ATTR_ALWINLINE bool bitValue(std::size_t index) const {
+        return (m_valuep[VL_BITWORD_E(index)] >> VL_BITBIT_E(index)) & 1;
+    }
 
 private:
     // CONSTRUCTORS
@@ -199,6 +223,11 @@ class VerilatedSaifActivityAccumulator final {
     std::unordered_map<uint32_t, VerilatedSaifActivityVar> m_activity;
     // Memory pool for signals bits objects
     std::vector<std::vector<VerilatedSaifActivityBit>> m_activityArena;
+    // Memory pool for signals last values
+    std::vector<std::vector<EData>> m_valueArena;
+
+    template <typename T>
+    static T* arenaAllocate(std::vector<std::vector<T>>& arena, size_t n);
 
 public:
     // METHODS
@@ -222,22 +251,17 @@ private:
 
 VL_ATTR_ALWINLINE
 void VerilatedSaifActivityVar::emitBit(const uint64_t time, const CData newval) {
-    assert(m_lastTime <= time);
-    m_bits[0].aggregateVal(time - m_lastTime, newval);
-    updateLastTime(time);
+    const EData val = newval & 1;
+    if (VL_LIKELY(m_valuep[0] == val)) return;
+    m_valuep[0] = val;
+    m_bits[0].toggle(time, val);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedSaifActivityVar::emitWData(const uint64_t time, const WData* newvalp,
                                          const uint32_t bits) {
-    assert(m_lastTime <= time);
-    const uint64_t dt = time - m_lastTime;
-    for (std::size_t i = 0; i < std::min(m_width, bits); ++i) {
-        const size_t wordIndex = i / VL_EDATASIZE;
-        m_bits[i].aggregateVal(dt, (newvalp[wordIndex] >> VL_BITBIT_E(i)) & 1);
-    }
-
-    updateLastTime(time);
+    const uint32_t words = VL_WORDS_I(std::min(m_width, bits));
+    for (uint32_t i = 0; i < words; ++i) emitWord(time, i, newvalp[i]);
 }
 
 VerilatedSaifActivityBit& VerilatedSaifActivityVar::bit(const std::size_t index) {
@@ -250,17 +274,23 @@ VerilatedSaifActivityBit& VerilatedSaifActivityVar::bit(const std::size_t index)
 //=============================================================================
 // VerilatedSaifActivityAccumulator implementation
 
+template <typename T>
+T* VerilatedSaifActivityAccumulator::arenaAllocate(std::vector<std::vector<T>>& arena, size_t n) {
+    const size_t block_size = 1024;
+    if (arena.empty() || arena.back().size() + n > arena.back().capacity()) {
+        arena.emplace_back();
+        arena.back().reserve(std::max(block_size, n));
+    }
+    const size_t idx = arena.back().size();
+    arena.back().resize(idx + n);
+    return arena.back().data() + idx;
+}
+
 void VerilatedSaifActivityAccumulator::declare(uint32_t code, const std::string& absoluteScopePath,
                                                std::string variableName, int bits, bool array,
                                                int arraynum) {
-    const size_t block_size = 1024;
-    if (m_activityArena.empty()
-        || m_activityArena.back().size() + bits > m_activityArena.back().capacity()) {
-        m_activityArena.emplace_back();
-        m_activityArena.back().reserve(block_size);
-    }
-    const size_t bitsIdx = m_activityArena.back().size();
-    m_activityArena.back().resize(m_activityArena.back().size() + bits);
+    VerilatedSaifActivityBit* const bitsp = arenaAllocate(m_activityArena, bits);
+    EData* const valuep = arenaAllocate(m_valueArena, VL_WORDS_I(bits));
 
     if (array) {
         variableName += '[';
@@ -268,8 +298,7 @@ void VerilatedSaifActivityAccumulator::declare(uint32_t code, const std::string&
         variableName += ']';
     }
     m_scopeToActivities[absoluteScopePath].emplace_back(code, variableName);
-    m_activity.emplace(code, VerilatedSaifActivityVar{static_cast<uint32_t>(bits),
-                                                      m_activityArena.back().data() + bitsIdx});
+    m_activity.emplace(code, VerilatedSaifActivityVar{static_cast<uint32_t>(bits), bitsp, valuep});
 }
 
 //=============================================================================
@@ -399,9 +428,8 @@ void VerilatedSaif::closeNetScope() {
 bool VerilatedSaif::printActivityStats(VerilatedSaifActivityVar& activity,
                                        const std::string& activityName, bool anyNetWritten) {
     for (size_t i = 0; i < activity.width(); ++i) {
-        VerilatedSaifActivityBit& bit = activity.bit(i);
-
-        bit.aggregateVal(currentTime() - activity.lastUpdateTime(), bit.bitValue());
+        const VerilatedSaifActivityBit& bit = activity.bit(i);
+        const uint64_t highTime = bit.highTime(currentTime(), activity.bitValue(i));
 
         if (!anyNetWritten) {
             openNetScope();
@@ -419,16 +447,14 @@ bool VerilatedSaif::printActivityStats(VerilatedSaifActivityVar& activity,
 
         // We only have two-value logic so TZ, TX and TB will always be 0
         printStr(" (T0 ");
-        printStr(std::to_string(currentTime() - bit.highTime()));
+        printStr(std::to_string(currentTime() - highTime));
         printStr(") (T1 ");
-        printStr(std::to_string(bit.highTime()));
+        printStr(std::to_string(highTime));
         printStr(") (TZ 0) (TX 0) (TB 0) (TC ");
         printStr(std::to_string(bit.toggleCount()));
         printStr("))\n");
     }
 
-    activity.updateLastTime(currentTime());
-
     return anyNetWritten;
 }
 
@@ -531,7 +557,7 @@ void VerilatedSaif::declare(const uint32_t code, uint32_t fidx, const char* name
 
     const std::string hierarchicalName = m_prefixStack.back().first + name;
 
-    if (!Super::declCode(code, hierarchicalName, bits)) return;
+    if (!Super::declCode(code, fidx, hierarchicalName, bits)) return;
 
     std::string variableName = lastWord(hierarchicalName);
     m_currentScope->addActivityVar(code, variableName);
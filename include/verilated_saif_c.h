@@ -180,6 +180,8 @@ template <>
 void VerilatedSaif::Super::set_time_resolution(const std::string& unit);
 template <>
 void VerilatedSaif::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedSaif::Super::dumpvarsMatch(const std::string& pattern);
 #endif  // DOXYGEN
 
 //=============================================================================
@@ -284,6 +286,11 @@ public:
     void dumpvars(int level, const std::string& hier) VL_MT_SAFE {
         m_sptrace.dumpvars(level, hier);
     }
+    // Add variables to dump, those with a name matching the glob pattern
+    // ('*' any characters, '?' any character), e.g. "top.t.*.data*"
+    void dumpvarsMatch(const std::string& pattern) VL_MT_SAFE {
+        m_sptrace.dumpvarsMatch(pattern);
+    }
 
     // Internal class access
     VerilatedSaif* spTrace() { return &m_sptrace; }
@@ -30,13 +30,19 @@
 #include "verilated.h"
 #include "verilated_imp.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <deque>
 #include <fcntl.h>
+#include <future>
+#include <thread>
+#include <zlib.h>
 
 // clang-format off
 #if defined(_WIN32) && !defined(__MINGW32__) && !defined(__CYGWIN__)
 # include <io.h>
 #else
+# include <sys/wait.h>
 # include <unistd.h>
 #endif
 
@@ -56,6 +62,234 @@
 static const char* const VLTSAVE_HEADER_STR = "verilatorsave02\n";
 // Value of last bytes of each file (must be multiple of 8 bytes)
 static const char* const VLTSAVE_TRAILER_STR = "vltsaved";
+// Value of first bytes of each delta file (must be 16 bytes)
+static const char* const VLTSAVE_DELTA_STR = "verilatordelta01";
+// Page index marking the end of a delta file's pages
+static constexpr uint64_t VLTSAVE_DELTA_END = ~0ULL;
+// Size of pages the stream is divided into for delta files
+static constexpr size_t VLTSAVE_PAGE_SIZE = 16 * 1024;
+// Value of first bytes of each chunked file (must be 16 bytes)
+static const char* const VLTSAVE_CHUNKED_STR = "verilatorchunk01";
+// Value of last bytes of each chunked file, after its index (must be 8 bytes)
+static const char* const VLTSAVE_CHUNKED_END_STR = "vltchidx";
+// Bytes of stream in each chunk of a chunked file
+static constexpr size_t VLTSAVE_CHUNK_SIZE = 4 * 1024 * 1024;
+
+//=============================================================================
+// Utilities
+
+static uint64_t vlSavePageHash(const uint8_t* datap, size_t size) VL_PURE {
+    // Not cryptographic, just enough to find the pages a delta must write
+    uint64_t hash = 0x9e3779b97f4a7c15ULL ^ size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, datap + i, sizeof(word));
+        hash = (hash ^ word) * 0x9ddfea08eb382d69ULL;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; ++i) hash = (hash ^ datap[i]) * 0x100000001b3ULL;
+    return hash;
+}
+
+static bool vlSaveReadFd(int fd, void* datap, size_t size) VL_MT_SAFE {
+    uint8_t* dp = static_cast<uint8_t*>(datap);
+    while (size) {
+        errno = 0;
+        const ssize_t got = ::read(fd, dp, size);
+        if (got > 0) {
+            dp += got;
+            size -= got;
+        } else if (got == 0 || (errno != EAGAIN && errno != EINTR)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool vlSaveWriteFd(int fd, const void* datap, size_t size) VL_MT_SAFE {
+    const uint8_t* dp = static_cast<const uint8_t*>(datap);
+    while (size) {
+        errno = 0;
+        const ssize_t got = ::write(fd, dp, size);
+        if (got > 0) {
+            dp += got;
+            size -= got;
+        } else if (VL_UNCOVERABLE(got < 0 && errno != EAGAIN && errno != EINTR)) {
+            return false;  // LCOV_EXCL_LINE // Perhaps out of disk space
+        }
+    }
+    return true;
+}
+
+//=============================================================================
+// Chunked files
+//
+// A chunked file is VLTSAVE_CHUNKED_STR, then each chunk's compressed data,
+// then an index of VlSaveChunkEntry, one per chunk, then the uint64_t number
+// of chunks and VLTSAVE_CHUNKED_END_STR.
+
+struct VlSaveChunkEntry final {  // Index entry of a chunk, as in the file
+    uint64_t m_offset;  // File offset of chunk's data
+    uint32_t m_rawSize;  // Bytes of stream in chunk
+    uint32_t m_size;  // Bytes of data in file; if m_rawSize, stored uncompressed
+};
+
+struct VlSaveChunkResult final {  // Result of compressing and writing a chunk
+    bool m_ok;  // Written without error
+    uint64_t m_endOffset;  // File offset after the chunk's data
+    VlSaveChunkEntry m_entry;
+};
+
+static VlSaveChunkResult vlSaveChunkWrite(int fd, const std::vector<uint8_t>& raw,
+                                          const std::shared_future<VlSaveChunkResult>& prev) {
+    // Runs in its own thread; compress in parallel with other chunks
+    uLongf size = compressBound(raw.size());
+    std::vector<uint8_t> compressed(size);
+    const uint8_t* datap = compressed.data();
+    if (compress2(compressed.data(), &size, raw.data(), raw.size(), Z_BEST_SPEED) != Z_OK
+        || size >= raw.size()) {
+        datap = raw.data();  // Incompressible
+        size = raw.size();
+    }
+    // Then write after the previous chunk, while later chunks compress
+    VlSaveChunkResult result{true, std::strlen(VLTSAVE_CHUNKED_STR), {}};
+    if (prev.valid()) result = prev.get();
+    if (!result.m_ok) return result;
+    result.m_entry.m_offset = result.m_endOffset;
+    result.m_entry.m_rawSize = raw.size();
+    result.m_entry.m_size = size;
+    result.m_endOffset += size;
+    result.m_ok = vlSaveWriteFd(fd, datap, size);
+    return result;
+}
+
+static std::vector<uint8_t> vlSaveChunkRead(const std::vector<uint8_t>& data,
+                                            const VlSaveChunkEntry& entry) {
+    // Runs in its own thread; decompress in parallel with other chunks
+    // Returns empty vector if corrupt
+    if (data.size() != entry.m_size) return {};
+    if (entry.m_size == entry.m_rawSize) return data;  // Stored uncompressed
+    std::vector<uint8_t> raw(entry.m_rawSize);
+    uLongf size = entry.m_rawSize;
+    if (uncompress(raw.data(), &size, data.data(), data.size()) != Z_OK
+        || size != entry.m_rawSize) {
+        return {};
+    }
+    return raw;
+}
+
+static unsigned vlSaveChunkThreads(unsigned threads) VL_MT_SAFE {
+    if (threads) return threads;
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+// Chunks of a VerilatedSave::openChunked file being compressed and written
+class VerilatedSaveChunks final {
+    const int m_fd;  // File descriptor, owned by VerilatedSave
+    const unsigned m_threads;  // Maximum chunks compressing at once
+    std::vector<uint8_t> m_chunk;  // Stream not yet in a chunk
+    std::deque<std::shared_future<VlSaveChunkResult>> m_pending;  // Oldest first
+    std::vector<VlSaveChunkEntry> m_index;  // Completed chunks
+    bool m_ok = true;  // No write errors
+
+    void submit() {
+        if (m_chunk.empty()) return;
+        while (m_pending.size() >= m_threads) retire();
+        const std::shared_future<VlSaveChunkResult> prev
+            = m_pending.empty() ? std::shared_future<VlSaveChunkResult>{} : m_pending.back();
+        m_pending.push_back(
+            std::async(std::launch::async, vlSaveChunkWrite, m_fd, std::move(m_chunk), prev)
+                .share());
+        m_chunk.clear();
+        m_chunk.reserve(VLTSAVE_CHUNK_SIZE);
+    }
+    void retire() {
+        const VlSaveChunkResult result = m_pending.front().get();
+        m_pending.pop_front();
+        m_ok = m_ok && result.m_ok;
+        m_index.push_back(result.m_entry);
+    }
+
+public:
+    VerilatedSaveChunks(int fd, unsigned threads)
+        : m_fd{fd}
+        , m_threads{vlSaveChunkThreads(threads)} {
+        m_chunk.reserve(VLTSAVE_CHUNK_SIZE);
+    }
+    ~VerilatedSaveChunks() {
+        while (!m_pending.empty()) retire();
+    }
+    void write(const uint8_t* datap, size_t size) {
+        while (size) {
+            const size_t blk = std::min(size, VLTSAVE_CHUNK_SIZE - m_chunk.size());
+            m_chunk.insert(m_chunk.end(), datap, datap + blk);
+            datap += blk;
+            size -= blk;
+            if (m_chunk.size() == VLTSAVE_CHUNK_SIZE) submit();
+        }
+    }
+    // Write remaining chunks and the index, return true if no errors
+    bool finish() {
+        submit();
+        while (!m_pending.empty()) retire();
+        const uint64_t count = m_index.size();
+        return m_ok
+               && vlSaveWriteFd(m_fd, m_index.data(), m_index.size() * sizeof(VlSaveChunkEntry))
+               && vlSaveWriteFd(m_fd, &count, sizeof(count))
+               && vlSaveWriteFd(m_fd, VLTSAVE_CHUNKED_END_STR,
+                                std::strlen(VLTSAVE_CHUNKED_END_STR));
+    }
+};
+
+// Chunks of a chunked file being read and decompressed by VerilatedRestore
+class VerilatedRestoreChunks final {
+    const int m_fd;  // File descriptor, owned by VerilatedRestore
+    const unsigned m_threads;  // Maximum chunks decompressing at once
+    const std::vector<VlSaveChunkEntry> m_index;  // Every chunk
+    size_t m_nextChunk = 0;  // Next index entry to start decompressing
+    std::deque<std::future<std::vector<uint8_t>>> m_pending;  // Oldest first
+    std::vector<uint8_t> m_chunk;  // Decompressed chunk being read
+    size_t m_chunkPos = 0;  // Offset of next byte to read from m_chunk
+
+    void startChunks() {
+        // Read ahead, so that chunks are decompressed while earlier ones are deserialized
+        while (m_nextChunk < m_index.size() && m_pending.size() < m_threads) {
+            const VlSaveChunkEntry& entry = m_index[m_nextChunk++];
+            std::vector<uint8_t> data(entry.m_size);
+            const off_t offset = entry.m_offset;
+            if (VL_UNCOVERABLE(::lseek(m_fd, offset, SEEK_SET) != offset
+                               || !vlSaveReadFd(m_fd, data.data(), data.size()))) {
+                data.clear();  // LCOV_EXCL_LINE // Reported as corrupt
+            }
+            m_pending.push_back(
+                std::async(std::launch::async, vlSaveChunkRead, std::move(data), entry));
+        }
+    }
+
+public:
+    VerilatedRestoreChunks(int fd, std::vector<VlSaveChunkEntry>&& index)
+        : m_fd{fd}
+        , m_threads{vlSaveChunkThreads(0)}
+        , m_index{std::move(index)} {}
+    ~VerilatedRestoreChunks() = default;
+    // Read up to size bytes of stream, return bytes read, 0 at end, -1 if corrupt
+    ssize_t read(uint8_t* datap, size_t size) {
+        if (m_chunkPos == m_chunk.size()) {
+            startChunks();
+            if (m_pending.empty()) return 0;
+            m_chunk = m_pending.front().get();
+            m_pending.pop_front();
+            m_chunkPos = 0;
+            if (VL_UNLIKELY(m_chunk.empty())) return -1;
+            startChunks();
+        }
+        size = std::min(size, m_chunk.size() - m_chunkPos);
+        std::memcpy(datap, m_chunk.data() + m_chunkPos, size);
+        m_chunkPos += size;
+        return size;
+    }
+};
 
 //=============================================================================
 //=============================================================================
@@ -144,9 +378,40 @@ void VerilatedSave::open(const char* filenamep) VL_MT_UNSAFE_ONE {
     m_isOpen = true;
     m_filename = filenamep;
     m_cp = m_bufp;
+    m_delta = false;
+    m_pageHashes.clear();
+    m_streamSize = 0;
     header();
 }
 
+void VerilatedSave::openDelta(const char* filenamep) VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (isOpen()) return;
+    const std::string parent = m_parentFilename;
+    open(filenamep);
+    if (parent.empty() || !isOpen()) return;
+    VL_DEBUG_IF(VL_DBG_MSGF("- save: delta of parent %s\n", parent.c_str()););
+    m_delta = true;
+    // The header() above is still buffered, so this goes first in the file
+    const uint32_t pageSize = VLTSAVE_PAGE_SIZE;
+    const uint32_t len = parent.length();
+    writeFd(VLTSAVE_DELTA_STR, std::strlen(VLTSAVE_DELTA_STR));
+    writeFd(&pageSize, sizeof(pageSize));
+    writeFd(&len, sizeof(len));
+    writeFd(parent.data(), len);
+}
+
+void VerilatedSave::openChunked(const char* filenamep, unsigned threads) VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (isOpen()) return;
+    open(filenamep);
+    if (!isOpen()) return;
+    // The header() above is still buffered, so this goes first in the file
+    writeFd(VLTSAVE_CHUNKED_STR, std::strlen(VLTSAVE_CHUNKED_STR));
+    if (VL_UNLIKELY(!isOpen())) return;  // Write error
+    m_chunksp = new VerilatedSaveChunks{m_fd, threads};
+}
+
 void VerilatedRestore::open(const char* filenamep) VL_MT_UNSAFE_ONE {
     m_assertOne.check();
     if (isOpen()) return;
@@ -167,15 +432,156 @@ void VerilatedRestore::open(const char* filenamep) VL_MT_UNSAFE_ONE {
     m_filename = filenamep;
     m_cp = m_bufp;
     m_endp = m_bufp;
+    m_streamPos = 0;
+    m_streamSize = 0;
+    openChain();
+    if (VL_UNLIKELY(!isOpen())) return;
     header();
 }
 
+void VerilatedRestore::openChain() VL_MT_UNSAFE_ONE {
+    // If a delta file, find the pages in it and each of its parents
+    int fd = m_fd;
+    std::string filename = m_filename;
+    while (true) {
+        char magic[16];
+        const bool got = vlSaveReadFd(fd, magic, sizeof(magic));
+        if (got && m_chain.empty()
+            && std::memcmp(magic, VLTSAVE_CHUNKED_STR, sizeof(magic)) == 0) {
+            if (VL_UNLIKELY(!openChunks())) {
+                const std::string msg
+                    = "Can't deserialize; chunked file is truncated: " + filename;
+                VL_FATAL_MT(filename.c_str(), 0, "", msg.c_str());
+                // Die before we close() as close would check the trailer
+                m_isOpen = false;
+                ::close(m_fd);
+            }
+            return;
+        }
+        const bool delta = got && std::memcmp(magic, VLTSAVE_DELTA_STR, sizeof(magic)) == 0;
+        if (!delta) {
+            if (m_chain.empty()) {
+                ::lseek(fd, 0, SEEK_SET);  // Not a delta, read the stream directly
+            } else {
+                m_chain.push_back(ChainFile{fd, true, {}});
+            }
+            return;
+        }
+        uint32_t pageSize = 0;
+        uint32_t len = 0;
+        std::string parent;
+        bool ok = vlSaveReadFd(fd, &pageSize, sizeof(pageSize))
+                  && pageSize == VLTSAVE_PAGE_SIZE && vlSaveReadFd(fd, &len, sizeof(len));
+        if (ok) {
+            parent.resize(len);
+            ok = vlSaveReadFd(fd, &parent[0], len);
+        }
+        m_chain.push_back(ChainFile{fd, false, {}});
+        std::vector<int64_t>& offsets = m_chain.back().m_pageOffsets;
+        int64_t offset = sizeof(magic) + sizeof(pageSize) + sizeof(len) + len;
+        while (ok) {
+            uint64_t page = 0;
+            uint32_t size = 0;
+            ok = vlSaveReadFd(fd, &page, sizeof(page));
+            if (ok && page == VLTSAVE_DELTA_END) {
+                uint64_t streamSize = 0;
+                ok = vlSaveReadFd(fd, &streamSize, sizeof(streamSize));
+                if (m_chain.size() == 1) m_streamSize = streamSize;
+                break;
+            }
+            ok = ok && vlSaveReadFd(fd, &size, sizeof(size));
+            offset += sizeof(page) + sizeof(size);
+            if (page >= offsets.size()) offsets.resize(page + 1, -1);
+            offsets[page] = offset;
+            offset += size;
+            ok = ok && ::lseek(fd, offset, SEEK_SET) == offset;
+        }
+        if (VL_UNLIKELY(!ok)) {
+            const std::string msg = "Can't deserialize; delta file is truncated: " + filename;
+            VL_FATAL_MT(filename.c_str(), 0, "", msg.c_str());
+            // Die before we close() as close would check the trailer
+            m_isOpen = false;
+            closeChain();
+            ::close(m_fd);
+            return;
+        }
+        filename = parent;
+        fd = ::open(filename.c_str(), O_RDONLY | O_LARGEFILE | O_CLOEXEC);
+        if (VL_UNLIKELY(fd < 0)) {
+            const std::string msg
+                = "Can't deserialize; parent of delta file not found: " + filename;
+            VL_FATAL_MT(m_filename.c_str(), 0, "", msg.c_str());
+            // Die before we close() as close would check the trailer
+            m_isOpen = false;
+            closeChain();
+            ::close(m_fd);
+            return;
+        }
+    }
+}
+
+bool VerilatedRestore::openChunks() VL_MT_UNSAFE_ONE {
+    // Read the index from the end of a chunked file
+    const size_t endLen = std::strlen(VLTSAVE_CHUNKED_END_STR);
+    const off_t fileSize = ::lseek(m_fd, 0, SEEK_END);
+    uint64_t count = 0;
+    char end[8];
+    const off_t footer = fileSize - static_cast<off_t>(sizeof(count) + endLen);
+    if (footer < 0 || ::lseek(m_fd, footer, SEEK_SET) != footer
+        || !vlSaveReadFd(m_fd, &count, sizeof(count)) || !vlSaveReadFd(m_fd, end, endLen)
+        || std::memcmp(end, VLTSAVE_CHUNKED_END_STR, endLen) != 0
+        || count > static_cast<uint64_t>(footer) / sizeof(VlSaveChunkEntry)) {
+        return false;
+    }
+    std::vector<VlSaveChunkEntry> index(count);
+    const off_t indexOffset = footer - static_cast<off_t>(count * sizeof(VlSaveChunkEntry));
+    if (::lseek(m_fd, indexOffset, SEEK_SET) != indexOffset
+        || !vlSaveReadFd(m_fd, index.data(), count * sizeof(VlSaveChunkEntry))) {
+        return false;
+    }
+    for (const VlSaveChunkEntry& entry : index) {
+        if (entry.m_offset + entry.m_size > static_cast<uint64_t>(indexOffset)) return false;
+    }
+    m_chunksp = new VerilatedRestoreChunks{m_fd, std::move(index)};
+    return true;
+}
+
 void VerilatedSave::closeImp() VL_MT_UNSAFE_ONE {
     if (!isOpen()) return;
     trailer();
     flushImp();
+    if (m_cp != m_bufp) writePage(m_bufp, m_cp - m_bufp);  // Final partial page
+    m_cp = m_bufp;
+    if (m_delta) {
+        const uint64_t end[2] = {VLTSAVE_DELTA_END, m_streamSize};
+        writeFd(end, sizeof(end));
+    }
+    if (m_chunksp) {
+        const bool ok = m_chunksp->finish();
+        VL_DO_CLEAR(delete m_chunksp, m_chunksp = nullptr);
+        if (VL_UNCOVERABLE(!ok)) {
+            // LCOV_EXCL_START
+            const std::string msg = "Can't write chunked save file: " + m_filename;
+            VL_FATAL_MT(m_filename.c_str(), 0, "", msg.c_str());
+            m_isOpen = false;
+            ::close(m_fd);
+            return;
+            // LCOV_EXCL_STOP
+        }
+        // Chunks aren't at fixed stream offsets, so can't be the parent of a delta
+        m_parentFilename.clear();
+        m_parentHashes.clear();
+        m_isOpen = false;
+        ::close(m_fd);  // May get error, just ignore it
+        return;
+    }
+    if (VL_UNLIKELY(!isOpen())) return;  // Write error
     m_isOpen = false;
     ::close(m_fd);  // May get error, just ignore it
+    // Become the parent of the next delta
+    m_parentFilename = m_filename;
+    m_parentHashes.swap(m_pageHashes);
+    m_pageHashes.clear();
 }
 
 void VerilatedRestore::closeImp() VL_MT_UNSAFE_ONE {
@@ -183,44 +589,125 @@ void VerilatedRestore::closeImp() VL_MT_UNSAFE_ONE {
     trailer();
     flushImp();
     m_isOpen = false;
+    closeChain();
     ::close(m_fd);  // May get error, just ignore it
 }
 
+void VerilatedRestore::closeChain() VL_MT_UNSAFE_ONE {
+    if (m_chunksp) VL_DO_CLEAR(delete m_chunksp, m_chunksp = nullptr);
+    for (const ChainFile& cf : m_chain) {
+        if (cf.m_fd != m_fd) ::close(cf.m_fd);
+    }
+    m_chain.clear();
+}
+
+//=============================================================================
+// Background save
+
+void VerilatedSave::saveForked(const char* filenamep,
+                               const std::function<void(VerilatedSave&)>& saveCb)
+    VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    waitForked();
+    VL_DEBUG_IF(VL_DBG_MSGF("- save: forking save to file %s\n", filenamep););
+#if !defined(_WIN32) || defined(__MINGW32__) || defined(__CYGWIN__)
+    // Only the calling thread exists in the child, it must not wait on the
+    // other threads. Serialization is single threaded so this is fine.
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        open(filenamep);
+        if (VL_UNLIKELY(!isOpen())) ::_exit(1);
+        saveCb(*this);
+        closeImp();
+        // Don't run atexit()/destructors, or flush stdio buffers copied from the parent
+        ::_exit(0);
+    }
+    if (pid > 0) {
+        m_forkPid = pid;
+        return;
+    }
+    // Fork failed, fall back to saving in the foreground
+#endif
+    open(filenamep);
+    m_forkOk = isOpen();
+    if (VL_UNLIKELY(!m_forkOk)) return;
+    saveCb(*this);
+    closeImp();
+}
+
+bool VerilatedSave::waitForked() VL_MT_UNSAFE_ONE {
+#if !defined(_WIN32) || defined(__MINGW32__) || defined(__CYGWIN__)
+    if (m_forkPid) {
+        int status = 0;
+        while (::waitpid(m_forkPid, &status, 0) < 0) {
+            if (VL_UNCOVERABLE(errno != EINTR)) {
+                status = -1;  // LCOV_EXCL_LINE
+                break;  // LCOV_EXCL_LINE
+            }
+        }
+        m_forkPid = 0;
+        m_forkOk = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+#endif
+    return m_forkOk;
+}
+
 //=============================================================================
 // Buffer management
 
 void VerilatedSave::flushImp() VL_MT_UNSAFE_ONE {
     m_assertOne.check();
     if (VL_UNLIKELY(!isOpen())) return;
-    const uint8_t* wp = m_bufp;
-    while (true) {
-        const ssize_t remaining = (m_cp - wp);
-        if (remaining == 0) break;
-        errno = 0;
-        const ssize_t got = ::write(m_fd, wp, remaining);
-        if (got > 0) {
-            wp += got;
-        } else if (VL_UNCOVERABLE(got < 0)) {
-            if (VL_UNCOVERABLE(errno != EAGAIN && errno != EINTR)) {
-                // LCOV_EXCL_START
-                // write failed, presume error (perhaps out of disk space)
-                const std::string msg = std::string{__FUNCTION__} + ": " + std::strerror(errno);
-                VL_FATAL_MT("", 0, "", msg.c_str());
-                close();
-                break;
-                // LCOV_EXCL_STOP
-            }
-        }
+    // Write whole pages, keeping any partial page for later, so that
+    // pages are at the same stream offsets as in the parent of a delta
+    const uint8_t* pagep = m_bufp;
+    for (; static_cast<size_t>(m_cp - pagep) >= VLTSAVE_PAGE_SIZE; pagep += VLTSAVE_PAGE_SIZE) {
+        writePage(pagep, VLTSAVE_PAGE_SIZE);
+    }
+    const size_t remaining = m_cp - pagep;
+    std::memmove(m_bufp, pagep, remaining);
+    m_cp = m_bufp + remaining;
+}
+
+void VerilatedSave::writePage(const uint8_t* datap, size_t size) VL_MT_UNSAFE_ONE {
+    if (m_chunksp) {
+        m_chunksp->write(datap, size);
+        return;
+    }
+    const uint64_t page = m_pageHashes.size();
+    const uint64_t hash = vlSavePageHash(datap, size);
+    m_pageHashes.push_back(hash);
+    m_streamSize += size;
+    if (!m_delta) {
+        writeFd(datap, size);
+        return;
+    }
+    // Unchanged since the parent, so the restore will read it from there
+    if (page < m_parentHashes.size() && m_parentHashes[page] == hash) return;
+    const uint32_t len = size;
+    writeFd(&page, sizeof(page));
+    writeFd(&len, sizeof(len));
+    writeFd(datap, size);
+}
+
+void VerilatedSave::writeFd(const void* datap, size_t size) VL_MT_UNSAFE_ONE {
+    if (VL_UNLIKELY(!isOpen())) return;
+    if (VL_UNCOVERABLE(!vlSaveWriteFd(m_fd, datap, size))) {
+        // LCOV_EXCL_START
+        // write failed, presume error (perhaps out of disk space)
+        const std::string msg = std::string{__FUNCTION__} + ": " + std::strerror(errno);
+        VL_FATAL_MT("", 0, "", msg.c_str());
+        m_isOpen = false;
+        ::close(m_fd);
+        // LCOV_EXCL_STOP
     }
-    m_cp = m_bufp;  // Reset buffer
 }
 
 void VerilatedRestore::fill() VL_MT_UNSAFE_ONE {
     m_assertOne.check();
     if (VL_UNLIKELY(!isOpen())) return;
     // Move remaining characters down to start of buffer.  (No memcpy, overlaps allowed)
-    uint8_t* rp = m_bufp;
-    for (uint8_t* sp = m_cp; sp < m_endp; *rp++ = *sp++) {}  // Overlaps
+    std::memmove(m_bufp, m_cp, m_endp - m_cp);
     m_endp = m_bufp + (m_endp - m_cp);
     m_cp = m_bufp;  // Reset buffer
     // Read into buffer starting at m_endp
@@ -228,7 +715,7 @@ void VerilatedRestore::fill() VL_MT_UNSAFE_ONE {
         const ssize_t remaining = (m_bufp + bufferSize() - m_endp);
         if (remaining == 0) break;
         errno = 0;
-        const ssize_t got = ::read(m_fd, m_endp, remaining);
+        const ssize_t got = readStream(m_endp, remaining);
         if (got > 0) {
             m_endp += got;
         } else if (VL_UNCOVERABLE(got < 0)) {
@@ -250,6 +737,105 @@ void VerilatedRestore::fill() VL_MT_UNSAFE_ONE {
     }
 }
 
+ssize_t VerilatedRestore::readStream(uint8_t* datap, size_t size) VL_MT_UNSAFE_ONE {
+    if (m_chunksp) {
+        const ssize_t got = m_chunksp->read(datap, size);
+        if (VL_UNLIKELY(got < 0)) {
+            const std::string msg = "Can't deserialize; chunked file is corrupt: " + m_filename;
+            VL_FATAL_MT(m_filename.c_str(), 0, "", msg.c_str());
+            return 0;
+        }
+        return got;
+    }
+    if (m_chain.empty()) return ::read(m_fd, datap, size);
+    // Delta, read the rest of the page from the newest file holding it
+    if (m_streamPos >= m_streamSize) return 0;
+    const uint64_t page = m_streamPos / VLTSAVE_PAGE_SIZE;
+    const uint64_t pageOffset = m_streamPos % VLTSAVE_PAGE_SIZE;
+    size = std::min<uint64_t>({size, VLTSAVE_PAGE_SIZE - pageOffset, m_streamSize - m_streamPos});
+    for (const ChainFile& cf : m_chain) {
+        int64_t offset;
+        if (cf.m_base) {
+            offset = m_streamPos;
+        } else if (page < cf.m_pageOffsets.size() && cf.m_pageOffsets[page] >= 0) {
+            offset = cf.m_pageOffsets[page] + pageOffset;
+        } else {
+            continue;
+        }
+        if (VL_UNCOVERABLE(::lseek(cf.m_fd, offset, SEEK_SET) != offset)) return -1;
+        const ssize_t got = ::read(cf.m_fd, datap, size);
+        if (got > 0) m_streamPos += got;
+        return got;
+    }
+    return 0;  // LCOV_EXCL_LINE // Base file is shorter, corrupt
+}
+
+//=============================================================================
+// Memory images
+
+void VerilatedSaveMem::open() VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (isOpen()) return;
+    m_image.clear();
+    m_isOpen = true;
+    m_filename = "<memory>";
+    m_cp = m_bufp;
+    header();
+}
+
+void VerilatedSaveMem::closeImp() VL_MT_UNSAFE_ONE {
+    if (!isOpen()) return;
+    trailer();
+    flushImp();
+    m_isOpen = false;
+}
+
+void VerilatedSaveMem::flushImp() VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (VL_UNLIKELY(!isOpen())) return;
+    m_image.insert(m_image.end(), m_bufp, m_cp);
+    m_cp = m_bufp;  // Reset buffer
+}
+
+void VerilatedRestoreMem::open(const uint8_t* datap, size_t size) VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (isOpen()) return;
+    m_imageCp = datap;
+    m_imageEndp = datap + size;
+    m_isOpen = true;
+    m_filename = "<memory>";
+    m_cp = m_bufp;
+    m_endp = m_bufp;
+    header();
+}
+
+void VerilatedRestoreMem::closeImp() VL_MT_UNSAFE_ONE {
+    if (!isOpen()) return;
+    trailer();
+    flushImp();
+    m_isOpen = false;
+}
+
+void VerilatedRestoreMem::fill() VL_MT_UNSAFE_ONE {
+    m_assertOne.check();
+    if (VL_UNLIKELY(!isOpen())) return;
+    // Move remaining characters down to start of buffer.  (No memcpy, overlaps allowed)
+    std::memmove(m_bufp, m_cp, m_endp - m_cp);
+    m_endp = m_bufp + (m_endp - m_cp);
+    m_cp = m_bufp;  // Reset buffer
+    const size_t avail = m_bufp + bufferSize() - m_endp;
+    const size_t got = std::min<size_t>(avail, m_imageEndp - m_imageCp);
+    std::memcpy(m_endp, m_imageCp, got);
+    m_imageCp += got;
+    m_endp += got;
+    // At end of image, fill buffer from here to end with NULLs so reader's
+    // don't need to check eof each character.
+    if (got < avail) {
+        std::memset(m_endp, 0, avail - got);
+        m_endp = m_bufp + bufferSize();
+    }
+}
+
 //=============================================================================
 // Serialization of types
 
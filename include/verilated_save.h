@@ -26,7 +26,10 @@
 
 #include "verilated.h"
 
+#include <cstring>
+#include <functional>
 #include <string>
+#include <vector>
 
 //=============================================================================
 // VerilatedSerialize
@@ -83,8 +86,9 @@ public:
             bufferCheck();
             size_t blk = size;
             if (blk > bufferInsertSize()) blk = bufferInsertSize();
-            const uint8_t* __restrict maxp = dp + blk;
-            for (; dp < maxp; *m_cp++ = *dp++) {}
+            std::memcpy(m_cp, dp, blk);
+            m_cp += blk;
+            dp += blk;
             size -= blk;
         }
         return *this;  // For function chaining
@@ -156,8 +160,9 @@ public:
             bufferCheck();
             size_t blk = size;
             if (blk > bufferInsertSize()) blk = bufferInsertSize();
-            const uint8_t* __restrict maxp = dp + blk;
-            for (; dp < maxp; *dp++ = *m_cp++) {}
+            std::memcpy(dp, m_cp, blk);
+            m_cp += blk;
+            dp += blk;
             size -= blk;
         }
         return *this;  // For function chaining
@@ -180,6 +185,9 @@ private:
     }
 };
 
+class VerilatedRestoreChunks;
+class VerilatedSaveChunks;
+
 //=============================================================================
 // VerilatedSave
 /// Stream-like object that serializes Verilated model to a file.
@@ -189,25 +197,60 @@ private:
 class VerilatedSave final : public VerilatedSerialize {
 private:
     int m_fd = -1;  // File descriptor we're writing to
+    int m_forkPid = 0;  // Child process of saveForked, 0 if none
+    bool m_forkOk = true;  // Last saveForked succeeded
+    bool m_delta = false;  // Writing only pages that differ from m_parentFilename
+    std::string m_parentFilename;  // Last file saved, parent of next delta
+    std::vector<uint64_t> m_parentHashes;  // Hash of each page of m_parentFilename
+    std::vector<uint64_t> m_pageHashes;  // Hash of each page written to current file
+    uint64_t m_streamSize = 0;  // Bytes of pages written to current file
+    VerilatedSaveChunks* m_chunksp = nullptr;  // If openChunked, chunks being written
 
     void closeImp() VL_MT_UNSAFE_ONE;
     void flushImp() VL_MT_UNSAFE_ONE;
+    void writePage(const uint8_t* datap, size_t size) VL_MT_UNSAFE_ONE;
+    void writeFd(const void* datap, size_t size) VL_MT_UNSAFE_ONE;
 
 public:
     // CONSTRUCTORS
     /// Construct new object
     VerilatedSave() = default;
     /// Flush, close and destruct
-    ~VerilatedSave() override { closeImp(); }
+    ~VerilatedSave() override {
+        closeImp();
+        waitForked();
+    }
     // METHODS
     /// Open the file; call isOpen() to see if errors
     void open(const char* filenamep) VL_MT_UNSAFE_ONE;
     /// Open the file; call isOpen() to see if errors
     void open(const std::string& filename) VL_MT_UNSAFE_ONE { open(filename.c_str()); }
+    /// Open the file as a delta, which holds only the pages of the stream
+    /// that differ from the last file closed by this object, and refers to
+    /// that file for other pages. VerilatedRestore reads the delta's chain
+    /// of parents, which must not be removed. Same as open() if no file has
+    /// been closed by this object.
+    void openDelta(const char* filenamep) VL_MT_UNSAFE_ONE;
+    /// Open the file in chunked format, for large saves. The stream is
+    /// divided into chunks, which are compressed in parallel by up to the
+    /// given number of threads (0 for one per CPU), and written in the
+    /// background while serialization continues. The file ends with an
+    /// index of the chunks, so VerilatedRestore can also decompress them in
+    /// parallel. A chunked file cannot be the parent of a later delta.
+    void openChunked(const char* filenamep, unsigned threads = 0) VL_MT_UNSAFE_ONE;
     /// Flush and close the file
     void close() override VL_MT_UNSAFE_ONE { closeImp(); }
     /// Flush data to file
     void flush() override VL_MT_UNSAFE_ONE { flushImp(); }
+    /// Save in the background. Fork a child process which opens the file,
+    /// calls saveCb (e.g. to do "os << *topp"), then closes and exits. The
+    /// child writes from a copy-on-write image of the process, so the caller
+    /// may continue simulating immediately. Where fork is not available, or
+    /// fails, saves in the foreground. Waits for any earlier forked save.
+    void saveForked(const char* filenamep,
+                    const std::function<void(VerilatedSave&)>& saveCb) VL_MT_UNSAFE_ONE;
+    /// Wait for any forked save to complete, return true if it succeeded
+    bool waitForked() VL_MT_UNSAFE_ONE;
 };
 
 //=============================================================================
@@ -219,9 +262,22 @@ public:
 class VerilatedRestore final : public VerilatedDeserialize {
 private:
     int m_fd = -1;  // File descriptor we're writing to
+    struct ChainFile final {  // File of a delta chain
+        int m_fd;  // File descriptor
+        bool m_base;  // Non-delta file, holding every page at its stream offset
+        std::vector<int64_t> m_pageOffsets;  // File offset of each page, -1 if in a parent
+    };
+    std::vector<ChainFile> m_chain;  // If a delta, its files, newest first
+    uint64_t m_streamPos = 0;  // Offset of next byte to read from delta stream
+    uint64_t m_streamSize = 0;  // Total bytes in delta stream
+    VerilatedRestoreChunks* m_chunksp = nullptr;  // If a chunked file, chunks being read
 
     void closeImp() VL_MT_UNSAFE_ONE;
     void flushImp() VL_MT_UNSAFE_ONE {}
+    void openChain() VL_MT_UNSAFE_ONE;
+    bool openChunks() VL_MT_UNSAFE_ONE;
+    void closeChain() VL_MT_UNSAFE_ONE;
+    ssize_t readStream(uint8_t* datap, size_t size) VL_MT_UNSAFE_ONE;
 
 public:
     // CONSTRUCTORS
@@ -241,6 +297,76 @@ public:
     void fill() override VL_MT_UNSAFE_ONE;
 };
 
+//=============================================================================
+// VerilatedSaveMem
+/// Stream-like object that serializes Verilated model to memory, e.g. to
+/// restore many times with VerilatedRestoreMem without file I/O.
+///
+/// This class is not thread safe, it must be called by a single thread
+
+class VerilatedSaveMem final : public VerilatedSerialize {
+private:
+    std::vector<uint8_t> m_image;  // Saved data
+
+    void closeImp() VL_MT_UNSAFE_ONE;
+    void flushImp() VL_MT_UNSAFE_ONE;
+
+public:
+    // CONSTRUCTORS
+    /// Construct new object
+    VerilatedSaveMem() = default;
+    /// Flush, close and destruct
+    ~VerilatedSaveMem() override { closeImp(); }
+    // METHODS
+    /// Discard any previous image, and start saving
+    void open() VL_MT_UNSAFE_ONE;
+    /// Flush and finish the image
+    void close() override VL_MT_UNSAFE_ONE { closeImp(); }
+    /// Flush data to image
+    void flush() override VL_MT_UNSAFE_ONE { flushImp(); }
+    /// Return the saved image, complete once closed
+    const uint8_t* data() const { return m_image.data(); }
+    /// Return size of the saved image
+    size_t size() const { return m_image.size(); }
+};
+
+//=============================================================================
+// VerilatedRestoreMem
+/// Stream-like object that serializes Verilated model from memory, e.g.
+/// from a VerilatedSaveMem image, or a shared memory segment with the
+/// contents of a VerilatedSave file. The memory is not copied, so must
+/// remain until closed.
+///
+/// This class is not thread safe, it must be called by a single thread
+
+class VerilatedRestoreMem final : public VerilatedDeserialize {
+private:
+    const uint8_t* m_imageCp = nullptr;  // Next byte of image to read
+    const uint8_t* m_imageEndp = nullptr;  // End of image
+
+    void closeImp() VL_MT_UNSAFE_ONE;
+    void flushImp() VL_MT_UNSAFE_ONE {}
+
+public:
+    // CONSTRUCTORS
+    /// Construct new object
+    VerilatedRestoreMem() = default;
+    /// Flush, close and destruct
+    ~VerilatedRestoreMem() override { closeImp(); }
+
+    // METHODS
+    /// Start restoring from the given image
+    void open(const uint8_t* datap, size_t size) VL_MT_UNSAFE_ONE;
+    /// Start restoring from the image of a closed VerilatedSaveMem
+    void open(const VerilatedSaveMem& image) VL_MT_UNSAFE_ONE {
+        open(image.data(), image.size());
+    }
+    /// Close the image
+    void close() override VL_MT_UNSAFE_ONE { closeImp(); }
+    void flush() override VL_MT_UNSAFE_ONE { flushImp(); }
+    void fill() override VL_MT_UNSAFE_ONE;
+};
+
 //=============================================================================
 
 inline VerilatedSerialize& operator<<(VerilatedSerialize& os, const uint64_t& rhs) {
@@ -327,5 +453,37 @@ VerilatedDeserialize& operator>>(VerilatedDeserialize& os, VlAssocArray<T_Key, T
     }
     return os;
 }
+template <typename T_Value, std::size_t N_Depth>
+VerilatedSerialize& operator<<(VerilatedSerialize& os, VlSparseUnpacked<T_Value, N_Depth>& rhs) {
+    using Sparse = VlSparseUnpacked<T_Value, N_Depth>;
+    const Sparse& crhs = rhs;
+    uint32_t len = 0;
+    for (size_t page = 0; page < Sparse::PAGES; ++page) {
+        if (crhs.pagep(page)) ++len;
+    }
+    os << len;
+    for (size_t page = 0; page < Sparse::PAGES; ++page) {
+        if (const T_Value* const datap = crhs.pagep(page)) {
+            const uint32_t index = page;
+            os << index;
+            os.write(datap, sizeof(T_Value) * Sparse::PAGE_ELEMENTS);
+        }
+    }
+    return os;
+}
+template <typename T_Value, std::size_t N_Depth>
+VerilatedDeserialize& operator>>(VerilatedDeserialize& os,
+                                 VlSparseUnpacked<T_Value, N_Depth>& rhs) {
+    using Sparse = VlSparseUnpacked<T_Value, N_Depth>;
+    uint32_t len = 0;
+    os >> len;
+    rhs.clear();
+    for (uint32_t i = 0; i < len; ++i) {
+        uint32_t index = 0;
+        os >> index;
+        os.read(rhs.pagep(index), sizeof(T_Value) * Sparse::PAGE_ELEMENTS);
+    }
+    return os;
+}
 
 #endif  // Guard
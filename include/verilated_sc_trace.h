@@ -60,6 +60,8 @@ class VerilatedScTraceBase VL_NOT_FINAL : private sc_core::sc_object,
                                           private sc_core::sc_trace_file {
     bool m_enableDeltaCycles = false;
     bool m_traceFileAdded = false;
+    bool m_didDump = false;  // A dump was made, at m_lastDumpTime
+    uint64_t m_lastDumpTime = 0;  // Time of last dump
     static void stubReportHandler(const sc_core::sc_report&, const sc_core::sc_actions&){};
 
 public:
@@ -149,6 +151,20 @@ protected:
     static std::string getScTimeResolution() {
         return sc_core::sc_get_time_resolution().to_string();
     }
+    // Return time to dump at, or false if there should be no dump now: a
+    // time may be dumped only once, so further delta cycles of a time step
+    // are coalesced into its first dump, and there is no dump if no model
+    // was evaluated since the last dump, as nothing can have changed
+    template <typename T_Trace>
+    bool dumpTime(const T_Trace* tracep, uint64_t& timer) {
+        const uint64_t time = static_cast<uint64_t>(sc_core::sc_time_stamp().to_double());
+        if (m_didDump && time <= m_lastDumpTime) return false;
+        if (!tracep->dumpNeeded()) return false;
+        m_didDump = true;
+        m_lastDumpTime = time;
+        timer = time;
+        return true;
+    }
     static void checkScElaborationDone() {
         if (!sc_core::sc_get_curr_simcontext()->elaboration_done()) {
             Verilated::scTraceBeforeElaborationError();
@@ -32,6 +32,7 @@ package std;
    class mailbox #(type T);
       protected int m_bound;
       protected T m_queue[$];
+      protected event m_changed;  // Fired on put/get, waking only this mailbox's waiters
 
       function new(int bound = 0);
          m_bound = bound;
@@ -43,15 +44,18 @@ package std;
 
       task put(T message);
 `ifdef VERILATOR_TIMING
-         while (m_bound != 0 && m_queue.size() >= m_bound)
-            wait (m_queue.size() < m_bound);
+         while (m_bound != 0 && m_queue.size() >= m_bound) @m_changed;
          m_queue.push_back(message);
+         ->m_changed;
 `endif
       endtask
 
       function int try_put(T message);
          if (m_bound == 0 || num() < m_bound) begin
             m_queue.push_back(message);
+`ifdef VERILATOR_TIMING
+            ->m_changed;
+`endif
             return 1;
          end
          return 0;
@@ -59,16 +63,18 @@ package std;
 
       task get(ref T message);
 `ifdef VERILATOR_TIMING
-         while (m_queue.size() == 0) begin
-            wait (m_queue.size() > 0);
-         end
+         while (m_queue.size() == 0) @m_changed;
          message = m_queue.pop_front();
+         ->m_changed;
 `endif
       endtask
 
       function int try_get(ref T message);
          if (num() > 0) begin
             message = m_queue.pop_front();
+`ifdef VERILATOR_TIMING
+            ->m_changed;
+`endif
             return 1;
          end
          return 0;
@@ -76,9 +82,7 @@ package std;
 
       task peek(ref T message);
 `ifdef VERILATOR_TIMING
-         while (m_queue.size() == 0) begin
-            wait (m_queue.size() > 0);
-         end
+         while (m_queue.size() == 0) @m_changed;
          message = m_queue[0];
 `endif
       endtask
@@ -94,6 +98,7 @@ package std;
 
    class semaphore;
       protected int m_keyCount;
+      protected event m_changed;  // Fired on put, waking only this semaphore's waiters
 
       function new(int keyCount = 0);
          m_keyCount = keyCount;
@@ -101,13 +106,14 @@ package std;
 
       function void put(int keyCount = 1);
          m_keyCount += keyCount;
+`ifdef VERILATOR_TIMING
+         ->m_changed;
+`endif
       endfunction
 
       task get(int keyCount = 1);
 `ifdef VERILATOR_TIMING
-         while (m_keyCount < keyCount) begin
-            wait (m_keyCount >= keyCount);
-         end
+         while (m_keyCount < keyCount) @m_changed;
          m_keyCount -= keyCount;
 `endif
       endtask
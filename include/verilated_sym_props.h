@@ -252,6 +252,7 @@ class VerilatedVar final : public VerilatedVarProps {
     // MEMBERS
     void* const m_datap;  // Location of data
     const char* const m_namep;  // Name - slowpath
+    CData* m_changedp = nullptr;  // Flag set when the model writes, nullptr if not tracked
 protected:
     const bool m_isParam;
     friend class VerilatedScope;
@@ -269,6 +270,14 @@ public:
     void* datap() const { return m_datap; }
     const char* name() const { return m_namep; }
     bool isParam() const { return m_isParam; }
+    CData* changedp() const { return m_changedp; }
+    // Mark as written outside the model, e.g. by VPI
+    void markChanged() const {
+        if (m_changedp) *m_changedp = 1;
+    }
+    void clearChanged() const {
+        if (m_changedp) *m_changedp = 0;
+    }
 };
 
 #endif  // Guard
@@ -36,6 +36,7 @@
 
 #include <map>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 //======================================================================
@@ -46,10 +47,65 @@ struct VerilatedCStrCmp final {
     bool operator()(const char* a, const char* b) const { return std::strcmp(a, b) < 0; }
 };
 
+// Classes to hash and compare const char*'s by contents
+struct VerilatedCStrHash final {
+    size_t operator()(const char* a) const {
+        // FNV-1a
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (; *a; ++a) hash = (hash ^ static_cast<unsigned char>(*a)) * 0x100000001b3ULL;
+        return static_cast<size_t>(hash);
+    }
+};
+struct VerilatedCStrEq final {
+    bool operator()(const char* a, const char* b) const { return std::strcmp(a, b) == 0; }
+};
+
+// Map keyed by const char*'s, iterating in sorted order, with a hash index
+// so find() is constant time instead of a string compare per tree level.
+// Only emplace/find/erase/clear keep the index, so use only those to modify.
+template <typename T_Value>
+class VerilatedCStrMap VL_NOT_FINAL : public std::map<const char*, T_Value, VerilatedCStrCmp> {
+    using Base = std::map<const char*, T_Value, VerilatedCStrCmp>;
+    using Index = std::unordered_map<const char*, typename Base::iterator, VerilatedCStrHash,
+                                     VerilatedCStrEq>;
+    Index m_index;  // Name to entry in the map
+
+    VL_UNCOPYABLE(VerilatedCStrMap);
+
+public:
+    VerilatedCStrMap() = default;
+    ~VerilatedCStrMap() = default;
+
+    using typename Base::const_iterator;
+    using typename Base::iterator;
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        const std::pair<iterator, bool> result = Base::emplace(std::forward<Args>(args)...);
+        if (result.second) m_index.emplace(result.first->first, result.first);
+        return result;
+    }
+    iterator find(const char* namep) {
+        const auto it = m_index.find(namep);
+        return it == m_index.end() ? Base::end() : it->second;
+    }
+    const_iterator find(const char* namep) const {
+        const auto it = m_index.find(namep);
+        return it == m_index.end() ? Base::end() : const_iterator{it->second};
+    }
+    iterator erase(iterator it) {
+        m_index.erase(it->first);
+        return Base::erase(it);
+    }
+    void clear() {
+        m_index.clear();
+        Base::clear();
+    }
+};
+
 // Map of sorted scope names to find associated scope class
 // This is a class instead of typedef/using to allow forward declaration in verilated.h
-class VerilatedScopeNameMap final
-    : public std::map<const char*, const VerilatedScope*, VerilatedCStrCmp> {
+class VerilatedScopeNameMap final : public VerilatedCStrMap<const VerilatedScope*> {
 public:
     VerilatedScopeNameMap() = default;
     ~VerilatedScopeNameMap() = default;
@@ -57,7 +113,7 @@ public:
 
 // Map of sorted variable names to find associated variable class
 // This is a class instead of typedef/using to allow forward declaration in verilated.h
-class VerilatedVarNameMap final : public std::map<const char*, VerilatedVar, VerilatedCStrCmp> {
+class VerilatedVarNameMap final : public VerilatedCStrMap<VerilatedVar> {
 public:
     VerilatedVarNameMap() = default;
     ~VerilatedVarNameMap() = default;
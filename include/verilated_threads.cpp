@@ -25,6 +25,14 @@
 
 #include "verilated_threads.h"
 
+#if defined(__linux)
+# include <linux/futex.h>
+# include <linux/mempolicy.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# define VL_FUTEX
+#endif
+
 #include <cstdio>
 #include <fstream>
 #include <iostream>
@@ -37,6 +45,11 @@
 // Internal note: Globals may multi-construct, see verilated.cpp top.
 
 std::atomic<uint64_t> VlMTaskVertex::s_yields;
+std::atomic<uint64_t> VlMTaskVertex::s_parks;
+std::atomic<uint64_t> VlMTaskVertex::s_parkTicks;
+
+// Index of the work-stealing deque owned by this thread, or -1 if the main thread
+static thread_local int t_dynQueueIndex = -1;
 
 //=============================================================================
 // VlMTaskVertex
@@ -47,12 +60,45 @@ VlMTaskVertex::VlMTaskVertex(uint32_t upstreamDepCount)
     assert(atomic_is_lock_free(&m_upstreamDepsDone));
 }
 
+void VlMTaskVertex::waitSlow(bool evenCycle) {
+    switch (Verilated::threadContextp()->threadsWait()) {
+    case VerilatedThreadsWait::SPIN: return;
+    case VerilatedThreadsWait::YIELD: yieldThread(); return;
+    case VerilatedThreadsWait::PARK: break;
+    }
+#ifdef VL_FUTEX
+    // Announce we are parked; whoever completes the dependencies will wake us.
+    // Only the single thread executing this MTaskVertex ever waits on it.
+    const uint32_t value = PARKED | m_upstreamDepsDone.fetch_or(PARKED, std::memory_order_acq_rel);
+    if (!areUpstreamDepsDone(evenCycle)) {
+        ++s_parks;  // Statistics
+        uint64_t tickStart;
+        VL_GET_CPU_TICK(tickStart);
+        // Returns immediately if the value already changed
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_upstreamDepsDone), FUTEX_WAIT_PRIVATE,
+                value, nullptr, nullptr, 0);
+        uint64_t tickEnd;
+        VL_GET_CPU_TICK(tickEnd);
+        s_parkTicks += tickEnd - tickStart;  // Statistics
+    }
+    m_upstreamDepsDone.fetch_and(~PARKED, std::memory_order_relaxed);
+#else
+    yieldThread();
+#endif
+}
+
+void VlMTaskVertex::unpark() {
+#ifdef VL_FUTEX
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_upstreamDepsDone), FUTEX_WAKE_PRIVATE, 1,
+            nullptr, nullptr, 0);
+#endif
+}
+
 //=============================================================================
 // VlWorkerThread
 
 VlWorkerThread::VlWorkerThread(VerilatedContext* contextp)
-    : m_ready_size{0}
-    , m_cthread{startWorker, this, contextp} {}
+    : m_cthread{startWorker, this, contextp} {}
 
 VlWorkerThread::~VlWorkerThread() {
     shutdown();
@@ -87,6 +133,10 @@ void VlWorkerThread::workerLoop() {
 
     while (true) {
         if (VL_UNLIKELY(work.m_fnp == shutdownTask)) break;
+        // With a shared pool, tasks may come from models in different contexts
+        if (VL_UNLIKELY(work.m_contextp && work.m_contextp != Verilated::threadContextp())) {
+            Verilated::threadContextp(work.m_contextp);
+        }
         work.m_fnp(work.m_selfp, work.m_evenCycle);
         // Wait for next task with spinning.
         dequeWork</* SpinWait: */ true>(&work);
@@ -106,6 +156,7 @@ VlThreadPool::VlThreadPool(VerilatedContext* contextp, unsigned nThreads) {
         m_workers.push_back(new VlWorkerThread{contextp});
         m_unassignedWorkers.push(i);
     }
+    for (unsigned i = 0; i <= nThreads; ++i) m_dynQueues.emplace_back(new DynQueue);
     m_numaStatus = numaAssign();
 }
 
@@ -114,6 +165,135 @@ VlThreadPool::~VlThreadPool() {
     for (auto& i : m_workers) delete i;
 }
 
+void VlThreadPool::assignWorkerIndexes(size_t n, std::vector<size_t>& indexes)
+    VL_MT_SAFE_EXCLUDES(m_mutex) {
+    assert(n <= m_workers.size());
+    {
+        const VerilatedLockGuard lock{m_mutex};
+        const uint64_t ticket = m_nextTicket++;
+        while (ticket != m_servedTicket || m_unassignedWorkers.size() < n) m_cv.wait(m_mutex);
+        ++m_servedTicket;
+        for (size_t i = 0; i < n; ++i) {
+            indexes.push_back(m_unassignedWorkers.top());
+            m_unassignedWorkers.pop();
+        }
+    }
+    m_cv.notify_all();  // Next ticket holder may proceed
+}
+
+void VlThreadPool::pushDynamic(VlExecFnp fnp, VlSelfP selfp, bool evenCycle) VL_MT_SAFE {
+    const size_t index = t_dynQueueIndex < 0 ? m_workers.size() : t_dynQueueIndex;
+    DynQueue& queue = *m_dynQueues[index];
+    const VerilatedLockGuard lock{queue.m_mutex};
+    queue.m_tasks.push_back(DynTask{fnp, selfp, evenCycle});
+    queue.m_size.fetch_add(1, std::memory_order_release);
+}
+
+bool VlThreadPool::popDynamic(size_t index, DynTask& task) VL_MT_SAFE {
+    DynQueue& queue = *m_dynQueues[index];
+    if (!queue.m_size.load(std::memory_order_acquire)) return false;
+    const VerilatedLockGuard lock{queue.m_mutex};
+    if (queue.m_tasks.empty()) return false;
+    // Newest first, it is most likely to use data still in our cache
+    task = queue.m_tasks.back();
+    queue.m_tasks.pop_back();
+    queue.m_size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool VlThreadPool::stealDynamic(size_t index, DynTask& task) VL_MT_SAFE {
+    // Start with our neighbour, so thieves spread over the victims
+    const size_t nQueues = m_dynQueues.size();
+    for (size_t i = 1; i < nQueues; ++i) {
+        DynQueue& queue = *m_dynQueues[(index + i) % nQueues];
+        if (!queue.m_size.load(std::memory_order_acquire)) continue;
+        const VerilatedLockGuard lock{queue.m_mutex};
+        if (queue.m_tasks.empty()) continue;
+        // Oldest first, the owner is working at the other end
+        task = queue.m_tasks.front();
+        queue.m_tasks.pop_front();
+        queue.m_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void VlThreadPool::dynamicLoop(size_t index, bool evenCycle) VL_MT_SAFE {
+    DynTask task;
+    unsigned ct = 0;
+    while (!m_dynFinalp->areUpstreamDepsDone(evenCycle)) {
+        if (popDynamic(index, task) || stealDynamic(index, task)) {
+            task.m_fnp(task.m_selfp, task.m_evenCycle);
+            ct = 0;
+            continue;
+        }
+        VL_CPU_RELAX();
+        if (VL_UNLIKELY(++ct > VL_LOCK_SPINS)) {
+            ct = 0;
+            VlMTaskVertex::yieldThread();
+        }
+    }
+}
+
+void VlThreadPool::dynamicWorkerTask(VlSelfP poolp, bool evenCycle) VL_MT_SAFE {
+    VlThreadPool* const selfp = static_cast<VlThreadPool*>(poolp);
+    // Find our own index, the worker thread is the one running this task
+    if (VL_UNLIKELY(t_dynQueueIndex < 0)) {
+        for (size_t i = 0; i < selfp->m_workers.size(); ++i) {
+            if (selfp->m_workers[i]->cthread().get_id() == std::this_thread::get_id()) {
+                t_dynQueueIndex = static_cast<int>(i);
+            }
+        }
+    }
+    selfp->dynamicLoop(t_dynQueueIndex, evenCycle);
+    selfp->m_dynHelpers.fetch_sub(1, std::memory_order_release);
+}
+
+void VlThreadPool::execDynamic(const VlMTaskVertex& finalState, bool evenCycle) VL_MT_SAFE {
+    // With a shared pool, take all workers, so only one graph runs dynamically at a time
+    std::vector<size_t> indexes;
+    if (shared()) assignWorkerIndexes(m_workers.size(), indexes);
+    m_dynFinalp = &finalState;
+    m_dynHelpers.store(static_cast<unsigned>(m_workers.size()), std::memory_order_relaxed);
+    for (VlWorkerThread* const workerp : m_workers) {
+        workerp->addTask(dynamicWorkerTask, this, evenCycle);
+    }
+    dynamicLoop(m_workers.size(), evenCycle);
+    // All mtasks are done, wait for the workers to leave dynamicLoop, so a
+    // following graph cannot be confused with this one.
+    unsigned ct = 0;
+    while (m_dynHelpers.load(std::memory_order_acquire)) {
+        VL_CPU_RELAX();
+        if (VL_UNLIKELY(++ct > VL_LOCK_SPINS)) {
+            ct = 0;
+            VlMTaskVertex::yieldThread();
+        }
+    }
+    if (!indexes.empty()) freeWorkerIndexes(indexes);
+}
+
+void VlThreadPool::numaBind(const void* beginp, const void* endp) VL_MT_SAFE {
+#if defined(__linux) && defined(SYS_mbind) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return;
+    // Whole pages only, the model places each thread's variables on their own pages
+    const uintptr_t pageMask = VL_PAGE_BYTES - 1;
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(beginp) + pageMask) & ~pageMask;
+    const uintptr_t end = reinterpret_cast<uintptr_t>(endp) & ~pageMask;
+    if (end <= begin) return;
+    constexpr size_t MASK_BITS = 8 * sizeof(unsigned long);
+    unsigned long nodeMask[1024 / MASK_BITS] = {};
+    if (node >= 1024) return;
+    nodeMask[node / MASK_BITS] = 1UL << (node % MASK_BITS);
+    // Failure is harmless, e.g. single node hosts or no permission, the pages just stay
+    (void)syscall(SYS_mbind, begin, end - begin, MPOL_PREFERRED, nodeMask, 1024, MPOL_MF_MOVE);
+#else
+    (void)beginp;
+    (void)endp;
+#endif
+}
+
 bool VlThreadPool::isNumactlRunning() {
     // We assume if current thread is CPU-masked, then under numactl, otherwise not.
     // This shows that numactl is visible through the affinity mask
@@ -28,7 +28,10 @@
 #include "verilated.h"  // for VerilatedMutex and clang annotations
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <set>
 #include <stack>
 #include <thread>
@@ -46,8 +49,14 @@ using VlExecFnp = void (*)(VlSelfP, bool);
 
 // Track dependencies for a single MTask.
 class VlMTaskVertex final {
+    // CONSTANTS
+    // Flag bit in m_upstreamDepsDone, set while the waiting thread is parked
+    static constexpr uint32_t PARKED = 1U << 31;
+
     // MEMBERS
     static std::atomic<uint64_t> s_yields;  // Statistics
+    static std::atomic<uint64_t> s_parks;  // Statistics
+    static std::atomic<uint64_t> s_parkTicks;  // Statistics: CPU ticks spent parked
 
     // On even cycles, _upstreamDepsDone increases as upstream
     // dependencies complete. When it reaches _upstreamDepCount,
@@ -78,6 +87,8 @@ public:
     ~VlMTaskVertex() = default;
 
     static uint64_t yields() { return s_yields; }
+    static uint64_t parks() { return s_parks; }
+    static uint64_t parkTicks() { return s_parkTicks; }
     static void yieldThread() {
         ++s_yields;  // Statistics
         std::this_thread::yield();
@@ -87,33 +98,169 @@ public:
     // Returns true when the current MTaskVertex becomes ready to execute,
     // false while it's still waiting on more dependencies.
     bool signalUpstreamDone(bool evenCycle) {
+        bool ready;
+        uint32_t prev;
         if (evenCycle) {
-            const uint32_t upstreamDepsDone
-                = 1 + m_upstreamDepsDone.fetch_add(1, std::memory_order_release);
+            prev = m_upstreamDepsDone.fetch_add(1, std::memory_order_release);
+            const uint32_t upstreamDepsDone = 1 + (prev & ~PARKED);
             assert(upstreamDepsDone <= m_upstreamDepCount);
-            return (upstreamDepsDone == m_upstreamDepCount);
+            ready = (upstreamDepsDone == m_upstreamDepCount);
         } else {
-            const uint32_t upstreamDepsDone_prev
-                = m_upstreamDepsDone.fetch_sub(1, std::memory_order_release);
-            assert(upstreamDepsDone_prev > 0);
-            return (upstreamDepsDone_prev == 1);
+            prev = m_upstreamDepsDone.fetch_sub(1, std::memory_order_release);
+            assert((prev & ~PARKED) > 0);
+            ready = ((prev & ~PARKED) == 1);
         }
+        if (VL_UNLIKELY(ready && (prev & PARKED))) unpark();
+        return ready;
     }
     bool areUpstreamDepsDone(bool evenCycle) const {
         const uint32_t target = evenCycle ? m_upstreamDepCount : 0;
-        return m_upstreamDepsDone.load(std::memory_order_acquire) == target;
+        return (m_upstreamDepsDone.load(std::memory_order_acquire) & ~PARKED) == target;
     }
-    void waitUntilUpstreamDone(bool evenCycle) const {
+    void waitUntilUpstreamDone(bool evenCycle) {
         unsigned ct = 0;
         while (VL_UNLIKELY(!areUpstreamDepsDone(evenCycle))) {
             VL_CPU_RELAX();
             ++ct;
             if (VL_UNLIKELY(ct > VL_LOCK_SPINS)) {
                 ct = 0;
-                yieldThread();
+                waitSlow(evenCycle);
+            }
+        }
+    }
+
+private:
+    // Called after spinning for a while, applies VerilatedContext::threadsWait
+    void waitSlow(bool evenCycle);
+    void unpark();
+};
+
+// Chooses between the serial and parallel schedule of one exec graph of a
+// model Verilated with --threads-adaptive. In AUTO mode the first evaluations
+// alternate between the two and are timed, after which the faster is kept.
+class VlAdaptiveSchedule final {
+    // Evaluations timed with each schedule before choosing
+    static constexpr uint32_t WARMUP_EVALS = 64;
+
+    // MEMBERS
+    std::chrono::steady_clock::time_point m_start;  // Start of the timed evaluation
+    uint64_t m_serialNs = 0;  // Warm-up time spent in the serial schedule
+    uint64_t m_parallelNs = 0;  // Warm-up time spent in the parallel schedule
+    uint32_t m_evals = 0;  // Warm-up evaluations so far
+    VerilatedThreadsAdaptive m_lastMode = VerilatedThreadsAdaptive::AUTO;  // Mode last seen
+    bool m_serial = false;  // Running the serial schedule
+    bool m_timing = false;  // Timing the current evaluation
+
+    VL_UNCOPYABLE(VlAdaptiveSchedule);
+
+public:
+    // CONSTRUCTORS
+    VlAdaptiveSchedule() = default;
+    ~VlAdaptiveSchedule() = default;
+
+    // METHODS
+    // Called before the exec graph; returns true to run the serial schedule
+    bool beginEval(const VerilatedContext* contextp) {
+        const VerilatedThreadsAdaptive mode = contextp->threadsAdaptive();
+        if (VL_UNLIKELY(mode != m_lastMode)) {
+            m_lastMode = mode;
+            // Measure again when switched back to AUTO
+            m_serialNs = m_parallelNs = 0;
+            m_evals = 0;
+        }
+        if (VL_UNLIKELY(mode != VerilatedThreadsAdaptive::AUTO)) {
+            m_timing = false;
+            m_serial = mode == VerilatedThreadsAdaptive::SERIAL;
+            return m_serial;
+        }
+        m_timing = m_evals < 2 * WARMUP_EVALS;
+        if (VL_UNLIKELY(m_timing)) {
+            m_serial = m_evals & 1;
+            m_start = std::chrono::steady_clock::now();
+        }
+        return m_serial;
+    }
+    // Called after the exec graph
+    void endEval() {
+        if (VL_LIKELY(!m_timing)) return;
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        const uint64_t ns
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        (m_serial ? m_serialNs : m_parallelNs) += ns;
+        if (++m_evals == 2 * WARMUP_EVALS) m_serial = m_serialNs < m_parallelNs;
+    }
+    // Accessors, for debug and tests
+    bool serial() const { return m_serial; }
+    bool decided() const { return m_evals >= 2 * WARMUP_EVALS; }
+};
+
+// Bounded, lock-free, multi-producer single-consumer FIFO of tasks.
+// Based on Dmitry Vyukov's bounded MPMC queue; each slot carries a
+// sequence number that tells producers and the consumer whether the slot
+// is free or filled, so neither side ever takes a lock.
+template <typename T_Elem, size_t N_Capacity>
+class VlMpscQueue final {
+    static_assert((N_Capacity & (N_Capacity - 1)) == 0, "Capacity must be a power of 2");
+    static constexpr size_t MASK = N_Capacity - 1;
+
+    // TYPES
+    struct Slot final {
+        std::atomic<size_t> m_seq;  // Sequence number of this slot
+        T_Elem m_elem;  // Payload
+    };
+
+    // MEMBERS
+    std::atomic<size_t> m_enqPos{0};  // Next position to claim for producers
+    Slot m_slots[N_Capacity];  // Ring buffer
+    size_t m_deqPos = 0;  // Next position to pop; consumer only
+
+    VL_UNCOPYABLE(VlMpscQueue);
+
+public:
+    // CONSTRUCTORS
+    VlMpscQueue() {
+        for (size_t i = 0; i < N_Capacity; ++i) m_slots[i].m_seq.store(i, std::memory_order_relaxed);
+    }
+    ~VlMpscQueue() = default;
+
+    // METHODS
+    // Push element, returns false if the queue is full. Callable from any thread.
+    template <typename... T_Args>
+    bool tryPush(T_Args&&... args) VL_MT_SAFE {
+        size_t pos = m_enqPos.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = m_slots[pos & MASK];
+            const size_t seq = slot.m_seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (VL_LIKELY(diff == 0)) {
+                if (VL_LIKELY(m_enqPos.compare_exchange_weak(pos, pos + 1,
+                                                              std::memory_order_relaxed))) {
+                    slot.m_elem = T_Elem{std::forward<T_Args>(args)...};
+                    slot.m_seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+                // 'pos' was reloaded by failing compare_exchange_weak
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = m_enqPos.load(std::memory_order_relaxed);
             }
         }
     }
+    // Pop element into 'elemp', returns false if the queue is empty.
+    // Only the single consumer thread may call this.
+    bool tryPop(T_Elem* elemp) {
+        Slot& slot = m_slots[m_deqPos & MASK];
+        if (slot.m_seq.load(std::memory_order_acquire) != m_deqPos + 1) return false;
+        *elemp = slot.m_elem;
+        slot.m_seq.store(m_deqPos + N_Capacity, std::memory_order_release);
+        ++m_deqPos;
+        return true;
+    }
+    // True if an element is available to pop. Only the consumer thread may call this.
+    bool readable() const {
+        return m_slots[m_deqPos & MASK].m_seq.load(std::memory_order_acquire) == m_deqPos + 1;
+    }
 };
 
 class VlWorkerThread final {
@@ -122,26 +269,30 @@ private:
     struct ExecRec final {
         VlExecFnp m_fnp = nullptr;  // Function to execute
         VlSelfP m_selfp = nullptr;  // Symbol table to execute
+        VerilatedContext* m_contextp = nullptr;  // Context of the thread adding the task
         bool m_evenCycle = false;  // Even/odd for flag alternation
         ExecRec() = default;
-        ExecRec(VlExecFnp fnp, VlSelfP selfp, bool evenCycle)
+        ExecRec(VlExecFnp fnp, VlSelfP selfp, VerilatedContext* contextp, bool evenCycle)
             : m_fnp{fnp}
             , m_selfp{selfp}
+            , m_contextp{contextp}
             , m_evenCycle{evenCycle} {}
     };
 
+    // We expect the pending list to be very short, typically 0 or 1 or 2,
+    // a producer finding it full just spins until the worker catches up.
+    static constexpr size_t READY_CAPACITY = 64;
+
     // MEMBERS
+    // Tasks ready to run, pushed by any thread, popped only by this worker
+    VlMpscQueue<ExecRec, READY_CAPACITY> m_ready;
+
+    // The mutex and condition_variable are only used for parking an idle
+    // worker, never on the task handoff itself
     mutable VerilatedMutex m_mutex;
     std::condition_variable_any m_cv;
     // Only notify the condition_variable if the worker is waiting
-    bool m_waiting VL_GUARDED_BY(m_mutex) = false;
-
-    // Why a vector? We expect the pending list to be very short, typically
-    // 0 or 1 or 2, so popping from the front shouldn't be
-    // expensive. Revisit if we ever have longer queues...
-    std::vector<ExecRec> m_ready VL_GUARDED_BY(m_mutex);
-    // Store the size atomically, so we can spin wait
-    std::atomic<size_t> m_ready_size;
+    std::atomic<bool> m_waiting{false};
 
     std::thread m_cthread;  // Underlying C++ thread record
 
@@ -162,32 +313,57 @@ public:
         // Spin for a while, waiting for new data
         if VL_CONSTEXPR_CXX17 (N_SpinWait) {
             for (unsigned i = 0; i < VL_LOCK_SPINS; ++i) {
-                if (VL_LIKELY(m_ready_size.load(std::memory_order_relaxed))) break;
+                if (VL_LIKELY(m_ready.tryPop(workp))) return;
                 VL_CPU_RELAX();
             }
         }
-        VerilatedLockGuard lock{m_mutex};
-        while (m_ready.empty()) {
-            m_waiting = true;
-            m_cv.wait(m_mutex);
+        if (VL_LIKELY(m_ready.tryPop(workp))) return;
+        if VL_CONSTEXPR_CXX17 (N_SpinWait) {
+            // Between exec graphs, apply VerilatedContext::threadsWait, so with
+            // "spin" or "yield" the next eval finds the worker hot, rather than
+            // paying to wake it up.  The final join of each exec graph then
+            // costs no more than the slowest thread.
+            const VerilatedContext* const contextp = Verilated::threadContextp();
+            const VerilatedThreadsWait policy
+                = contextp ? contextp->threadsWait() : VerilatedThreadsWait::PARK;
+            if (policy != VerilatedThreadsWait::PARK) {
+                while (!m_ready.tryPop(workp)) {
+                    if (policy == VerilatedThreadsWait::YIELD) {
+                        std::this_thread::yield();
+                    } else {
+                        VL_CPU_RELAX();
+                    }
+                }
+                return;
+            }
         }
-        m_waiting = false;
-        // As noted above this is inefficient if our ready list is ever
-        // long (but it shouldn't be)
-        *workp = m_ready.front();
-        m_ready.erase(m_ready.begin());
-        m_ready_size.fetch_sub(1, std::memory_order_relaxed);
+        // Park until a producer notifies us. Setting m_waiting before the
+        // final check pairs with the fence in addTask, so either we see the
+        // new task, or the producer sees m_waiting and wakes us.
+        VerilatedLockGuard lock{m_mutex};
+        m_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!m_ready.tryPop(workp)) m_cv.wait(m_mutex);
+        m_waiting.store(false, std::memory_order_relaxed);
     }
     void addTask(VlExecFnp fnp, VlSelfP selfp, bool evenCycle = false)
         VL_MT_SAFE_EXCLUDES(m_mutex) {
-        bool notify;
-        {
-            const VerilatedLockGuard lock{m_mutex};
-            m_ready.emplace_back(fnp, selfp, evenCycle);
-            m_ready_size.fetch_add(1, std::memory_order_relaxed);
-            notify = m_waiting;
+        unsigned ct = 0;
+        VerilatedContext* const contextp = Verilated::threadContextp();
+        while (VL_UNLIKELY(!m_ready.tryPush(fnp, selfp, contextp, evenCycle))) {
+            // Full, wait for the worker to drain some tasks
+            VL_CPU_RELAX();
+            if (VL_UNLIKELY(++ct > VL_LOCK_SPINS)) {
+                ct = 0;
+                std::this_thread::yield();
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_waiting.load(std::memory_order_relaxed)) {
+            // Taking the lock ensures the worker is inside m_cv.wait
+            { const VerilatedLockGuard lock{m_mutex}; }
+            m_cv.notify_one();
         }
-        if (notify) m_cv.notify_one();
     }
 
     void shutdown();  // Finish current tasks, then terminate thread
@@ -198,12 +374,37 @@ public:
 };
 
 class VlThreadPool final : public VerilatedVirtualBase {
+    // TYPES
+    // Ready mtasks when using '--threads-schedule dynamic'
+    struct DynTask final {
+        VlExecFnp m_fnp;  // Function to execute
+        VlSelfP m_selfp;  // Symbol table to execute
+        bool m_evenCycle;  // Even/odd for flag alternation
+    };
+    // Each participating thread owns one deque. The owner pushes and pops
+    // at the back, idle threads steal from the front.
+    struct DynQueue final {
+        VerilatedMutex m_mutex;
+        std::deque<DynTask> m_tasks VL_GUARDED_BY(m_mutex);
+        std::atomic<size_t> m_size{0};  // Stored atomically, so thieves can skip empty queues
+    };
+
     // MEMBERS
     std::vector<VlWorkerThread*> m_workers;  // our workers
+    // Work-stealing deques, one per worker, plus one (the last) for the main thread
+    std::vector<std::unique_ptr<DynQueue>> m_dynQueues;
+    const VlMTaskVertex* m_dynFinalp = nullptr;  // Final mtask of current dynamic graph
+    std::atomic<unsigned> m_dynHelpers{0};  // Number of workers still in dynamicLoop
 
     mutable VerilatedMutex m_mutex;  // Guards indexes of unassigned workers
+    std::condition_variable_any m_cv;  // Signals workers freed by freeWorkerIndexes
     // Indexes of unassigned workers
     std::stack<size_t> m_unassignedWorkers VL_GUARDED_BY(m_mutex);
+    // Tickets, so contexts sharing the pool get workers in request order
+    uint64_t m_nextTicket VL_GUARDED_BY(m_mutex) = 0;
+    uint64_t m_servedTicket VL_GUARDED_BY(m_mutex) = 0;
+    // Pool is used by multiple contexts, see VerilatedContext::threadPoolShare
+    std::atomic<bool> m_shared{false};
     // For sequentially generating task IDs to avoid shadowing
     std::atomic<unsigned> m_assignedTasks{0};
     std::string m_numaStatus;  // Status of NUMA assignment
@@ -224,25 +425,48 @@ public:
         m_unassignedWorkers.pop();
         return index;
     }
-    void freeWorkerIndexes(std::vector<size_t>& indexes) {
-        const VerilatedLockGuard lock{m_mutex};
-        for (size_t index : indexes) m_unassignedWorkers.push(index);
+    // Assign 'n' workers at once, blocking until that many are free. Used when
+    // the pool is shared, so a model never holds some workers while waiting
+    // for others.
+    void assignWorkerIndexes(size_t n, std::vector<size_t>& indexes) VL_MT_SAFE_EXCLUDES(m_mutex);
+    void freeWorkerIndexes(std::vector<size_t>& indexes) VL_MT_SAFE_EXCLUDES(m_mutex) {
+        {
+            const VerilatedLockGuard lock{m_mutex};
+            for (size_t index : indexes) m_unassignedWorkers.push(index);
+        }
         indexes.clear();
+        if (shared()) m_cv.notify_all();
     }
+    bool shared() const { return m_shared.load(std::memory_order_relaxed); }
+    void shared(bool flag) { m_shared.store(flag, std::memory_order_relaxed); }
     unsigned assignTaskIndex() { return m_assignedTasks++; }
     int numThreads() const { return static_cast<int>(m_workers.size()); }
     std::string numaStatus() const { return m_numaStatus; }
+    // Move the memory pages in [beginp, endp) to the NUMA node of the calling thread.
+    // Used by models Verilated with --numa-layout.
+    static void numaBind(const void* beginp, const void* endp) VL_MT_SAFE;
     VlWorkerThread* workerp(int index) {
         assert(index >= 0);
         assert(index < static_cast<int>(m_workers.size()));
         return m_workers[index];
     }
 
+    // Work-stealing execution, used with '--threads-schedule dynamic'
+    // Make a ready mtask available to any thread
+    void pushDynamic(VlExecFnp fnp, VlSelfP selfp, bool evenCycle) VL_MT_SAFE;
+    // Execute ready mtasks on all threads, until 'finalState' is done.
+    // Called from the main thread only.
+    void execDynamic(const VlMTaskVertex& finalState, bool evenCycle) VL_MT_SAFE;
+
 private:
     VL_UNCOPYABLE(VlThreadPool);
 
     static bool isNumactlRunning();
     std::string numaAssign();
+    bool popDynamic(size_t index, DynTask& task) VL_MT_SAFE;
+    bool stealDynamic(size_t index, DynTask& task) VL_MT_SAFE;
+    void dynamicLoop(size_t index, bool evenCycle) VL_MT_SAFE;
+    static void dynamicWorkerTask(VlSelfP poolp, bool evenCycle) VL_MT_SAFE;
 };
 
 #endif
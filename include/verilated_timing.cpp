@@ -20,8 +20,14 @@
 ///
 //=========================================================================
 
+#define VERILATOR_VERILATED_TIMING_CPP_
+
 #include "verilated_timing.h"
 
+#include "verilated_imp.h"
+
+#include <atomic>
+
 //======================================================================
 // VlCoroutineHandle:: Methods
 
@@ -53,15 +59,88 @@ void VlCoroutineHandle::dump() const {
 //======================================================================
 // VlDelayScheduler:: Methods
 
+static int vlLowestBit(uint64_t word) VL_PURE {
+#ifdef __GNUC__
+    return __builtin_ctzll(word);
+#else
+    int bit = 0;
+    while (!((word >> bit) & 1ULL)) ++bit;
+    return bit;
+#endif
+}
+
+void VlDelayScheduler::advanceWheel(uint64_t time) {
+    if (time <= m_wheelTime) return;
+    // Times skipped over must have nothing left to resume, else a time slot was missed
+    if (m_wheelCount && wheelEarliest() < time) return;
+    // Buckets before 'time' were resumed, so are empty and may be reused for later times
+    m_wheelTime = time;
+    while (!m_far.empty() && inWheel(m_far.front().m_time)) {
+        std::pop_heap(m_far.begin(), m_far.end());
+        FarDelayed& farr = m_far.back();
+        const uint64_t bucket = farr.m_time % WHEEL_SIZE;
+        m_wheel[bucket].emplace_back(std::move(farr.m_handle));
+        m_wheelUsed[bucket / 64] |= 1ULL << (bucket % 64);
+        ++m_wheelCount;
+        m_far.pop_back();
+    }
+}
+
+void VlDelayScheduler::insert(uint64_t time, VlCoroutineHandle&& handle) {
+    advanceWheel(m_context.time());
+    if (inWheel(time)) {
+        const uint64_t bucket = time % WHEEL_SIZE;
+        m_wheel[bucket].emplace_back(std::move(handle));
+        m_wheelUsed[bucket / 64] |= 1ULL << (bucket % 64);
+        ++m_wheelCount;
+    } else {
+        m_far.push_back(FarDelayed{time, m_farOrder++, std::move(handle)});
+        std::push_heap(m_far.begin(), m_far.end());
+    }
+}
+
+uint64_t VlDelayScheduler::wheelEarliest() const {
+    // Search the used bits from the bucket of m_wheelTime, wrapping around
+    const uint64_t start = m_wheelTime % WHEEL_SIZE;
+    for (uint64_t n = 0; n <= WHEEL_WORDS; ++n) {
+        const uint64_t bucket = (start & ~63ULL) + n * 64;
+        uint64_t used = m_wheelUsed[(bucket / 64) % WHEEL_WORDS];
+        if (n == 0) used &= ~0ULL << (start % 64);  // Only from the start bucket
+        if (n == WHEEL_WORDS) used &= ~(~0ULL << (start % 64));  // Only up to the start bucket
+        if (used) {
+            const uint64_t found = bucket + vlLowestBit(used);
+            return m_wheelTime + (found - start);
+        }
+    }
+    VL_FATAL_MT(__FILE__, __LINE__, "", "Internal: Timing wheel count without any coroutines");
+    return m_wheelTime;
+}
+
 void VlDelayScheduler::resume() {
 #ifdef VL_DEBUG
     VL_DEBUG_IF(dump(); VL_DBG_MSGF("         Resuming delayed processes\n"););
 #endif
     bool resumed = false;
 
-    while (!m_queue.empty() && (m_queue.cbegin()->first == m_context.time())) {
-        VlCoroutineHandle handle = std::move(m_queue.begin()->second);
-        m_queue.erase(m_queue.begin());
+    const uint64_t now = m_context.time();
+    advanceWheel(now);
+    if (inWheel(now)) {
+        const uint64_t bucket = now % WHEEL_SIZE;
+        if (!m_wheel[bucket].empty()) {
+            // Resumed coroutines may delay again, but always to another bucket or the heap
+            m_resumed.swap(m_wheel[bucket]);
+            m_wheelUsed[bucket / 64] &= ~(1ULL << (bucket % 64));
+            m_wheelCount -= m_resumed.size();
+            for (auto&& handle : m_resumed) handle.resume();
+            m_resumed.clear();
+            resumed = true;
+        }
+    }
+    while (!m_far.empty() && m_far.front().m_time == now) {
+        // Only if the time moved backwards, or a slot was missed
+        std::pop_heap(m_far.begin(), m_far.end());
+        VlCoroutineHandle handle = std::move(m_far.back().m_handle);
+        m_far.pop_back();
         handle.resume();
         resumed = true;
     }
@@ -86,8 +165,20 @@ void VlDelayScheduler::resume() {
     }
 }
 
+uint64_t VlDelayScheduler::periodicEarliest() const {
+    uint64_t time = ~0ULL;
+    for (const Periodic& periodic : m_periodics) {
+        if (periodic.m_period) time = std::min(time, periodic.m_next);
+    }
+    return time;
+}
+
 uint64_t VlDelayScheduler::nextTimeSlot() const {
-    if (!m_queue.empty()) return m_queue.cbegin()->first;
+    if (m_wheelCount || !m_far.empty()) {
+        const uint64_t time = earliest();
+        return m_periodicCount ? std::min(time, periodicEarliest()) : time;
+    }
+    if (m_periodicCount) return periodicEarliest();
     if (m_zeroDelayed.empty())
         VL_FATAL_MT(__FILE__, __LINE__, "", "There is no next time slot scheduled");
     return m_context.time();
@@ -95,7 +186,7 @@ uint64_t VlDelayScheduler::nextTimeSlot() const {
 
 #ifdef VL_DEBUG
 void VlDelayScheduler::dump() const {
-    if (m_queue.empty()) {
+    if (empty()) {
         VL_DBG_MSGF("         No delayed processes:\n");
     } else {
         VL_DBG_MSGF("         Delayed processes:\n");
@@ -105,9 +196,22 @@ void VlDelayScheduler::dump() const {
                         m_context.time());
             susp.dump();
         }
-        for (const auto& susp : m_queue) {
-            VL_DBG_MSGF("             Awaiting time %" PRIu64 ": ", susp.first);
-            susp.second.dump();
+        for (uint64_t n = 0; n < WHEEL_SIZE; ++n) {
+            const uint64_t time = m_wheelTime + n;
+            for (const auto& susp : m_wheel[time % WHEEL_SIZE]) {
+                VL_DBG_MSGF("             Awaiting time %" PRIu64 ": ", time);
+                susp.dump();
+            }
+        }
+        for (const auto& susp : m_far) {
+            VL_DBG_MSGF("             Awaiting time %" PRIu64 ": ", susp.m_time);
+            susp.m_handle.dump();
+        }
+        for (size_t id = 0; id < m_periodics.size(); ++id) {
+            if (!m_periodics[id].m_period) continue;
+            VL_DBG_MSGF("             Periodic process %zu awaiting time %" PRIu64
+                        ", period %" PRIu64 "\n",
+                        id, m_periodics[id].m_next, m_periodics[id].m_period);
         }
     }
 }
@@ -127,18 +231,20 @@ void VlTriggerScheduler::resume(const char* eventDescription) {
     commit(eventDescription);
 }
 
-void VlTriggerScheduler::commit(const char* eventDescription) {
+void VlTriggerScheduler::commitUncommitted(const char* eventDescription) {
 #ifdef VL_DEBUG
-    if (!m_uncommitted.empty()) {
-        VL_DEBUG_IF(
-            VL_DBG_MSGF("         Committing processes waiting for %s:\n", eventDescription);
-            for (const auto& susp
-                 : m_uncommitted) {
-                VL_DBG_MSGF("           - ");
-                susp.dump();
-            });
-    }
+    VL_DEBUG_IF(VL_DBG_MSGF("         Committing processes waiting for %s:\n", eventDescription);
+                for (const auto& susp
+                     : m_uncommitted) {
+                    VL_DBG_MSGF("           - ");
+                    susp.dump();
+                });
 #endif
+    if (m_ready.empty()) {
+        // Usual case after resume(): exchange the lists instead of moving each coroutine
+        std::swap(m_ready, m_uncommitted);
+        return;
+    }
     m_ready.reserve(m_ready.size() + m_uncommitted.size());
     m_ready.insert(m_ready.end(), std::make_move_iterator(m_uncommitted.begin()),
                    std::make_move_iterator(m_uncommitted.end()));
@@ -170,7 +276,9 @@ void VlTriggerScheduler::dump(const char* eventDescription) const {
 // VlDynamicTriggerScheduler:: Methods
 
 bool VlDynamicTriggerScheduler::evaluate() {
-    m_anyTriggered = false;
+    // Coroutines woken by named events are already awaiting resumption
+    m_anyTriggered = m_woken;
+    m_woken = false;
     VL_DEBUG_IF(dump(););
     std::swap(m_suspended, m_evaluated);
     for (auto& coro : m_evaluated) coro.resume();
@@ -197,8 +305,10 @@ void VlDynamicTriggerScheduler::resume() {
                     VL_DBG_MSGF("           - ");
                     susp.dump();
                 });
-    for (auto& coro : m_triggered) coro.resume();
-    m_triggered.clear();
+    // Resumed coroutines may fire named events, waking others into m_triggered
+    std::swap(m_triggered, m_resuming);
+    for (auto& coro : m_resuming) coro.resume();
+    m_resuming.clear();
 }
 
 #ifdef VL_DEBUG
@@ -218,10 +328,112 @@ void VlDynamicTriggerScheduler::dump() const {
 //======================================================================
 // VlForkSync:: Methods
 
+namespace {
+
+struct VlFreeJoin final {
+    VlFreeJoin* m_nextp;  // Next free join
+};
+
+// Per thread free list, plain data so no thread_local constructor is required
+thread_local VlFreeJoin* t_freeJoinsp = nullptr;
+
+}  // namespace
+
+VlForkSync::VlJoin* VlForkSync::newJoin(size_t count, VlProcessRef process) {
+    static_assert(sizeof(VlJoin) >= sizeof(VlFreeJoin), "Join too small for free list");
+    void* memp;
+    if (VlFreeJoin* const freep = t_freeJoinsp) {
+        t_freeJoinsp = freep->m_nextp;
+        memp = freep;
+    } else {
+        memp = ::operator new(sizeof(VlJoin));
+    }
+    return new (memp) VlJoin{count, process};
+}
+
+void VlForkSync::releaseJoin(VlJoin* joinp) {
+    if (--joinp->m_refCount) return;
+    joinp->~VlJoin();
+    // A join released by another thread than allocated it joins this thread's list
+    VlFreeJoin* const freep = reinterpret_cast<VlFreeJoin*>(joinp);
+    freep->m_nextp = t_freeJoinsp;
+    t_freeJoinsp = freep;
+}
+
 void VlForkSync::done(const char* filename, int lineno) {
     VL_DEBUG_IF(VL_DBG_MSGF("             Process forked at %s:%d finished\n", filename, lineno););
-    if (m_join->m_counter > 0) m_join->m_counter--;
-    if (m_join->m_counter == 0) m_join->m_susp.resume();
+    if (m_joinp->m_counter > 0) m_joinp->m_counter--;
+    if (m_joinp->m_counter == 0) m_joinp->m_susp.resume();
+}
+
+//======================================================================
+// VlCoroutineFramePool:: Methods
+
+namespace {
+
+struct VlFreeFrame final {
+    VlFreeFrame* m_nextp;  // Next free frame of same size class
+};
+
+constexpr size_t FRAME_CLASSES = VlCoroutineFramePool::MAX_SIZE / VlCoroutineFramePool::GRAIN;
+
+// Per thread free lists, plain data so no thread_local constructor is required
+thread_local VlFreeFrame* t_freeFramesp[FRAME_CLASSES];
+
+struct VlFrameStats final {
+    std::atomic<uint64_t> m_allocs{0};  // Frames allocated
+    std::atomic<uint64_t> m_news{0};  // Frames allocated from the global allocator
+};
+VlFrameStats s_frameStats[FRAME_CLASSES + 1];  // Last is for frames above MAX_SIZE
+
+size_t frameClass(size_t size) {
+    return (size + VlCoroutineFramePool::GRAIN - 1) / VlCoroutineFramePool::GRAIN - 1;
+}
+
+}  // namespace
+
+void* VlCoroutineFramePool::allocate(size_t size) VL_MT_SAFE {
+    const size_t cls = size > MAX_SIZE ? FRAME_CLASSES : frameClass(size);
+    VlFrameStats& stats = s_frameStats[cls];
+    stats.m_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (VL_UNLIKELY(cls == FRAME_CLASSES)) {
+        stats.m_news.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+    if (VlFreeFrame* const framep = t_freeFramesp[cls]) {
+        t_freeFramesp[cls] = framep->m_nextp;
+        return framep;
+    }
+    if (stats.m_news.fetch_add(1, std::memory_order_relaxed) == 0) {
+        VerilatedImp::coroutineStatsCb(statsPrint);  // First use, so report statistics
+    }
+    return ::operator new((cls + 1) * GRAIN);
+}
+
+void VlCoroutineFramePool::deallocate(void* framep, size_t size) VL_MT_SAFE {
+    if (!framep) return;
+    if (VL_UNLIKELY(size > MAX_SIZE)) {
+        ::operator delete(framep);
+        return;
+    }
+    // A frame freed by another thread than allocated it joins this thread's list
+    const size_t cls = frameClass(size);
+    VlFreeFrame* const itemp = static_cast<VlFreeFrame*>(framep);
+    itemp->m_nextp = t_freeFramesp[cls];
+    t_freeFramesp[cls] = itemp;
+}
+
+void VlCoroutineFramePool::statsPrint() VL_MT_SAFE {
+    for (size_t cls = 0; cls <= FRAME_CLASSES; ++cls) {
+        const VlFrameStats& stats = s_frameStats[cls];
+        if (!stats.m_allocs) continue;
+        const std::string sizes = cls == FRAME_CLASSES
+                                      ? "over " + std::to_string(MAX_SIZE)
+                                      : "up to " + std::to_string((cls + 1) * GRAIN);
+        VL_PRINTF("- Verilator: coroutine frames %s bytes: %" PRIu64 " allocated, %" PRIu64
+                  " new\n",
+                  sizes.c_str(), stats.m_allocs.load(), stats.m_news.load());
+    }
 }
 
 //======================================================================
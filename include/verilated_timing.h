@@ -27,6 +27,7 @@
 
 #include "verilated.h"
 
+#include <algorithm>
 #include <vector>
 
 // clang-format off
@@ -159,20 +160,66 @@ enum class VlDelayPhase : bool { ACTIVE, INACTIVE };
 //=============================================================================
 // VlDelayScheduler stores coroutines to be resumed at a certain simulation time. If the current
 // time is equal to a coroutine's resume time, the coroutine gets resumed.
+//
+// Coroutines delayed to within WHEEL_SIZE time units of the current time are kept in a timing
+// wheel, a bucket per time, reusing the buckets' storage. Others are kept in a heap, and moved
+// to the wheel when the time gets near. Coroutines with equal times resume in delay order.
 
 class VlDelayScheduler final {
+    // CONSTANTS
+    static constexpr uint64_t WHEEL_SIZE = 256;  // Number of wheel buckets, power of 2
+    static constexpr size_t WHEEL_WORDS = WHEEL_SIZE / 64;  // Words of m_wheelUsed
+
     // TYPES
-    // Time-sorted queue of timestamps and handles
-    using VlDelayedCoroutineQueue = std::multimap<uint64_t, VlCoroutineHandle>;
+    struct FarDelayed final {  // Coroutine delayed beyond the wheel
+        uint64_t m_time;  // Time to resume
+        uint64_t m_order;  // Order delayed, for resuming equal times in order
+        VlCoroutineHandle m_handle;
+        // Order for std::push_heap, earliest on top
+        bool operator<(const FarDelayed& other) const {
+            return m_time != other.m_time ? m_time > other.m_time : m_order > other.m_order;
+        }
+    };
+    struct Periodic final {  // Process repeating after a constant delay, without a coroutine
+        uint64_t m_next = 0;  // Time of the next occurrence
+        uint64_t m_period = 0;  // Delay between occurrences, zero if not started
+    };
 
     // MEMBERS
     VerilatedContext& m_context;
-    VlDelayedCoroutineQueue m_queue;  // Coroutines to be restored at a certain simulation time
+    uint64_t m_wheelTime = 0;  // Earliest time the wheel holds, times up to WHEEL_SIZE later
+    size_t m_wheelCount = 0;  // Number of coroutines in the wheel
+    uint64_t m_wheelUsed[WHEEL_WORDS] = {};  // Bit per non-empty bucket
+    std::vector<VlCoroutineHandle> m_wheel[WHEEL_SIZE];  // Bucket for each time modulo size
+    std::vector<FarDelayed> m_far;  // Heap of coroutines beyond the wheel
+    uint64_t m_farOrder = 0;  // Next FarDelayed::m_order
+    std::vector<VlCoroutineHandle> m_resumed;  // Bucket being resumed, kept to avoid reallocation
     std::vector<VlCoroutineHandle> m_zeroDelayed;  // Coroutines waiting for #0
+    std::vector<Periodic> m_periodics;  // Periodic processes, indexed by id
+    size_t m_periodicCount = 0;  // Number of started periodic processes
     std::vector<VlCoroutineHandle> m_zeroDlyResumed;  // Coroutines that waited for #0 and are
                                                       // to be resumed. Kept as a field to avoid
                                                       // reallocation.
 
+    // PRIVATE METHODS
+    bool inWheel(uint64_t time) const {
+        return time >= m_wheelTime && time - m_wheelTime < WHEEL_SIZE;
+    }
+    // Move the wheel to start at given later time, moving in coroutines from the heap
+    void advanceWheel(uint64_t time);
+    // Schedule coroutine to resume at given time
+    void insert(uint64_t time, VlCoroutineHandle&& handle);
+    // Earliest time in the wheel, m_wheelCount must be non-zero
+    uint64_t wheelEarliest() const;
+    // Earliest time of a delayed coroutine, which must exist
+    uint64_t earliest() const {
+        if (!m_wheelCount) return m_far.front().m_time;
+        const uint64_t wheelTime = wheelEarliest();
+        return m_far.empty() ? wheelTime : std::min(wheelTime, m_far.front().m_time);
+    }
+    // Earliest time of a periodic process, m_periodicCount must be non-zero
+    uint64_t periodicEarliest() const;
+
 public:
     // CONSTRUCTORS
     explicit VlDelayScheduler(VerilatedContext& context)
@@ -183,13 +230,32 @@ public:
     // Returns the simulation time of the next time slot (aborts if there are no delayed
     // coroutines)
     uint64_t nextTimeSlot() const;
-    // Are there no delayed coroutines awaiting?
-    bool empty() const { return m_queue.empty() && m_zeroDelayed.empty(); }
+    // Are there no delayed coroutines or periodic processes awaiting?
+    bool empty() const {
+        return !m_wheelCount && m_far.empty() && m_zeroDelayed.empty() && !m_periodicCount;
+    }
     // Are there coroutines to resume at the current simulation time?
     bool awaitingCurrentTime() const {
-        return (!m_queue.empty() && (m_queue.cbegin()->first <= m_context.time()))
+        return ((m_wheelCount || !m_far.empty()) && earliest() <= m_context.time())
                || !m_zeroDelayed.empty();
     }
+    // Start periodic process 'id', first occurring 'period' after the current time
+    void periodic(size_t id, uint64_t period) {
+        if (id >= m_periodics.size()) m_periodics.resize(id + 1);
+        if (!m_periodics[id].m_period) ++m_periodicCount;
+        m_periodics[id].m_next = m_context.time() + period;
+        m_periodics[id].m_period = period;
+    }
+    // Is periodic process 'id' due at the current simulation time? If so, schedules its next
+    // occurrence, so only the first evaluation in a time slot returns true.
+    bool periodicTriggered(size_t id) {
+        if (id >= m_periodics.size()) return false;
+        Periodic& periodic = m_periodics[id];
+        const uint64_t now = m_context.time();
+        if (!periodic.m_period || periodic.m_next > now) return false;
+        periodic.m_next = now + periodic.m_period;
+        return true;
+    }
 #ifdef VL_DEBUG
     void dump() const;
 #endif
@@ -198,8 +264,7 @@ public:
                int lineno = 0) {
         struct Awaitable final {
             VlProcessRef process;  // Data of the suspended process, null if not needed
-            VlDelayedCoroutineQueue& queue;
-            std::vector<VlCoroutineHandle>& queueZeroDelay;
+            VlDelayScheduler& scheduler;
             const uint64_t delay;
             const VlDelayPhase phase;
             const VlFileLineDebug fileline;
@@ -207,9 +272,10 @@ public:
             bool await_ready() const { return false; }  // Always suspend
             void await_suspend(std::coroutine_handle<> coro) {
                 if (phase == VlDelayPhase::ACTIVE) {
-                    queue.emplace(delay, VlCoroutineHandle{coro, process, fileline});
+                    scheduler.insert(delay, VlCoroutineHandle{coro, process, fileline});
                 } else {
-                    queueZeroDelay.emplace_back(VlCoroutineHandle{coro, process, fileline});
+                    scheduler.m_zeroDelayed.emplace_back(
+                        VlCoroutineHandle{coro, process, fileline});
                 }
             }
             void await_resume() const {}
@@ -224,9 +290,8 @@ public:
         }
 #endif
 
-        return Awaitable{process,       m_queue,
-                         m_zeroDelayed, m_context.time() + delay,
-                         phase,         VlFileLineDebug{filename, lineno}};
+        return Awaitable{process, *this, m_context.time() + delay, phase,
+                         VlFileLineDebug{filename, lineno}};
     }
 };
 
@@ -251,12 +316,18 @@ class VlTriggerScheduler final {
                                    // m_resumeQueue to allow adding coroutines to m_ready
                                    // during resume(). Outside of resume() should always be empty.
 
-public:
     // METHODS
+    void commitUncommitted(const char* eventDescription);
+
+public:
     // Resumes all coroutines from the 'ready' stage
     void resume(const char* eventDescription = VL_UNKNOWN);
-    // Moves all coroutines from m_uncommitted to m_ready
-    void commit(const char* eventDescription = VL_UNKNOWN);
+    // Moves all coroutines from m_uncommitted to m_ready. Called on every evaluation where the
+    // trigger is not set, so cheap when no coroutine started waiting since the last call.
+    void commit(const char* eventDescription = VL_UNKNOWN) {
+        if (VL_LIKELY(m_uncommitted.empty())) return;
+        commitUncommitted(eventDescription);
+    }
     // Are there no coroutines awaiting?
     bool empty() const { return m_ready.empty() && m_uncommitted.empty(); }
 #ifdef VL_DEBUG
@@ -305,15 +376,37 @@ class VlDynamicTriggerScheduler final {
     // TYPES
     using VlCoroutineVec = std::vector<VlCoroutineHandle>;
 
+    // Coroutines waiting directly on a named event, moved to m_triggered when it is fired
+    class EventWaiters final : public VlEventWaiters {
+        VlDynamicTriggerScheduler& m_sched;  // Scheduler resuming the waiting coroutines
+        VlCoroutineVec m_waiting;  // Coroutines waiting for the event
+
+    public:
+        explicit EventWaiters(VlDynamicTriggerScheduler& sched)
+            : m_sched{sched} {}
+        ~EventWaiters() override = default;
+        void wake() override { m_sched.wake(m_waiting); }
+        VlCoroutineVec& waiting() { return m_waiting; }
+    };
+
     // MEMBERS
     bool m_anyTriggered = false;  // If true, at least one trigger was set
+    bool m_woken = false;  // If true, a named event woke coroutines since the last evaluate()
     VlCoroutineVec m_suspended;  // Suspended coroutines awaiting trigger evaluation
     VlCoroutineVec m_evaluated;  // Coroutines currently being evaluated (for evaluate())
     VlCoroutineVec m_triggered;  // Coroutines whose triggers were set, and are awaiting resumption
+    VlCoroutineVec m_resuming;  // Coroutines currently being resumed (for resume())
     VlCoroutineVec m_post;  // Coroutines awaiting the post update step (only relevant for triggers
                             // with destructive post updates, e.g. named events)
 
     // METHODS
+    // Moves coroutines woken by a named event to await resumption
+    void wake(VlCoroutineVec& coros) {
+        if (coros.empty()) return;
+        for (auto& coro : coros) m_triggered.emplace_back(std::move(coro));
+        coros.clear();
+        m_woken = true;
+    }
     auto awaitable(VlProcessRef process, VlCoroutineVec& queue, const char* filename, int lineno) {
         struct Awaitable final {
             VlProcessRef process;  // Data of the suspended process, null if not needed
@@ -363,6 +456,17 @@ public:
                                 eventDescription, filename, lineno););
         return awaitable(process, m_triggered, filename, lineno);
     }
+    // Used by coroutines for co_awaiting a named event directly. The coroutine is not resumed
+    // for trigger evaluation, but only when the event is fired, and then awaits resumption.
+    auto eventFired(VlEvent& event, VlProcessRef process,
+                    const char* eventDescription = VL_UNKNOWN, const char* filename = VL_UNKNOWN,
+                    int lineno = 0) {
+        VL_DEBUG_IF(VL_DBG_MSGF("         Suspending process waiting for %s at %s:%d\n",
+                                eventDescription, filename, lineno););
+        if (!event.m_waitersp) event.m_waitersp.reset(new EventWaiters{*this});
+        EventWaiters& waiters = static_cast<EventWaiters&>(*event.m_waitersp);
+        return awaitable(process, waiters.waiting(), filename, lineno);
+    }
 };
 
 //=============================================================================
@@ -380,41 +484,90 @@ struct VlForever final {
 
 class VlForkSync final {
     // VlJoin stores the handle of a suspended coroutine that did a fork..join or fork..join_any.
-    // If the counter reaches 0, the suspended coroutine shall be resumed.
+    // If the counter reaches 0, the suspended coroutine shall be resumed. Joins are reference
+    // counted by the VlForkSync copies given to the forked processes, and recycled through a
+    // per-thread free list, as forks are frequent in testbench code.
     struct VlJoin final {
+        size_t m_refCount = 1;  // Number of VlForkSync's referencing this join
         size_t m_counter = 0;  // When reaches 0, resume suspended coroutine
         VlCoroutineHandle m_susp;  // Coroutine to resume
+
+        VlJoin(size_t counter, VlProcessRef process)
+            : m_counter{counter}
+            , m_susp{process} {}
     };
 
     // The join info is shared among all forked processes
-    std::shared_ptr<VlJoin> m_join;
+    VlJoin* m_joinp = nullptr;
+
+    // METHODS
+    static VlJoin* newJoin(size_t count, VlProcessRef process);
+    static void releaseJoin(VlJoin* joinp);
 
 public:
+    // CONSTRUCTORS
+    VlForkSync() = default;
+    VlForkSync(const VlForkSync& other)
+        : m_joinp{other.m_joinp} {
+        if (m_joinp) ++m_joinp->m_refCount;
+    }
+    VlForkSync(VlForkSync&& other) noexcept
+        : m_joinp{std::exchange(other.m_joinp, nullptr)} {}
+    VlForkSync& operator=(VlForkSync other) noexcept {
+        std::swap(m_joinp, other.m_joinp);
+        return *this;
+    }
+    ~VlForkSync() {
+        if (m_joinp) releaseJoin(m_joinp);
+    }
+
+    // METHODS
     // Create the join object and set the counter to the specified number
-    void init(size_t count, VlProcessRef process) { m_join.reset(new VlJoin{count, {process}}); }
+    void init(size_t count, VlProcessRef process) {
+        if (m_joinp) releaseJoin(m_joinp);
+        m_joinp = newJoin(count, process);
+    }
     // Called whenever any of the forked processes finishes. If the join counter reaches 0, the
     // main process gets resumed
     void done(const char* filename = VL_UNKNOWN, int lineno = 0);
     // Used by coroutines for co_awaiting a join
     auto join(VlProcessRef process, const char* filename = VL_UNKNOWN, int lineno = 0) {
-        assert(m_join);
+        assert(m_joinp);
         VL_DEBUG_IF(
             VL_DBG_MSGF("             Awaiting join of fork at: %s:%d\n", filename, lineno););
         struct Awaitable final {
             VlProcessRef process;  // Data of the suspended process, null if not needed
-            const std::shared_ptr<VlJoin> join;  // Join to await on
+            const VlForkSync sync;  // Join to await on, kept referenced
             VlFileLineDebug fileline;
 
-            bool await_ready() { return join->m_counter == 0; }  // Suspend if join still exists
+            // Suspend if join still exists
+            bool await_ready() { return sync.m_joinp->m_counter == 0; }
             void await_suspend(std::coroutine_handle<> coro) {
-                join->m_susp = {coro, process, fileline};
+                sync.m_joinp->m_susp = {coro, process, fileline};
             }
             void await_resume() const {}
         };
-        return Awaitable{process, m_join, VlFileLineDebug{filename, lineno}};
+        return Awaitable{process, *this, VlFileLineDebug{filename, lineno}};
     }
 };
 
+//=============================================================================
+// VlCoroutineFramePool allocates coroutine frames from per-thread free lists of each size
+// class, as processes are often started and finished, e.g. by fork.
+
+class VlCoroutineFramePool final {
+public:
+    // CONSTANTS
+    static constexpr size_t GRAIN = 64;  // Size class granularity
+    static constexpr size_t MAX_SIZE = 4096;  // Larger frames use the global allocator
+
+    // METHODS
+    static void* allocate(size_t size) VL_MT_SAFE;
+    static void deallocate(void* framep, size_t size) VL_MT_SAFE;
+    // Print number of frames allocated of each size class
+    static void statsPrint() VL_MT_SAFE;
+};
+
 //=============================================================================
 // VlCoroutine
 // Return value of a coroutine. Used for chaining coroutine suspension/resumption.
@@ -428,6 +581,12 @@ private:
 
         ~VlPromise();
 
+        // Coroutine frames are allocated from the pool
+        static void* operator new(size_t size) { return VlCoroutineFramePool::allocate(size); }
+        static void operator delete(void* framep, size_t size) {
+            VlCoroutineFramePool::deallocate(framep, size);
+        }
+
         VlCoroutine get_return_object() { return {this}; }
 
         // Never suspend at the start of the coroutine
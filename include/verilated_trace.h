@@ -96,6 +96,38 @@ enum class VerilatedTraceSigType : uint8_t {
     TIME,
 };
 
+// Operation of a declaration table entry
+enum class VerilatedTraceDeclOp : uint8_t {
+    PUSH,  // pushPrefix
+    POP,  // popPrefix
+    EVENT,  // declEvent, and so on
+    BIT,
+    BUS,
+    QUAD,
+    ARRAY,
+    DOUBLE,
+};
+
+// Entry of a table of signal declarations, passed by the generated trace
+// initialization code to declTable() in bulk instead of calling decl* per
+// signal. Scopes are PUSH/POP entries around their signals, so each entry
+// holds only the last component of its name.
+struct VerilatedTraceDecl final {
+    VerilatedTraceDeclOp m_op;
+    const char* m_namep;  // Signal name, or prefix name if PUSH
+    uint32_t m_code;  // Code, relative to the table's base code
+    uint32_t m_fidx;  // Function index
+    int m_dtypenum;  // Enumeration type number, or -1 if none
+    VerilatedTraceSigDirection m_direction;
+    VerilatedTraceSigKind m_kind;
+    VerilatedTraceSigType m_type;
+    uint32_t m_elements;  // Number of unpacked array elements, 0 if not an array
+    int m_arrayLo;  // Index of first unpacked array element
+    int m_msb;  // Most significant bit, if BUS/QUAD/ARRAY
+    int m_lsb;  // Least significant bit, if BUS/QUAD/ARRAY
+    VerilatedTracePrefixType m_prefixType;  // Prefix type if PUSH
+};
+
 //=============================================================================
 // Offloaded tracing
 
@@ -231,6 +263,7 @@ private:
         };
         const uint32_t m_fidx;  // The index of the tracing function
         void* const m_userp;  // The user pointer to pass to the callback (the symbol table)
+        bool m_enabled = true;  // Function traces enabled signals, else it is not called
         CallbackRecord(initCb_t cb, void* userp)
             : m_initCb{cb}
             , m_fidx{0}
@@ -285,6 +318,7 @@ private:
     std::vector<CallbackRecord> m_chgCbs;  // Routines to perform incremental dump
     std::vector<CallbackRecord> m_chgOffloadCbs;  // Routines to perform offloaded incremental dump
     std::vector<CallbackRecord> m_cleanupCbs;  // Routines to call at the end of dump
+    std::vector<const bool*> m_activityps;  // Activity flag of each model, set by its eval
     bool m_constDump = true;  // Whether a const dump is required on the next call to 'dump'
     bool m_fullDump = true;  // Whether a full dump is required on the next call to 'dump'
     uint32_t m_nextCode = 0;  // Next code number to assign
@@ -292,6 +326,10 @@ private:
     uint32_t m_maxBits = 0;  // Number of bits in the widest signal
     // TODO: Should keep this as a Trie, that is how it's accessed all the time.
     std::vector<std::pair<int, std::string>> m_dumpvars;  // dumpvar() entries
+    std::vector<std::string> m_dumpvarsMatch;  // dumpvarsMatch() patterns
+    void* m_declUserp = nullptr;  // User pointer of init callback declaring signals
+    // Functions (user pointer, function index) with enabled signals
+    std::set<std::pair<const void*, uint32_t>> m_enabledFuncs;
     double m_timeRes = 1e-9;  // Time resolution (ns/ms etc)
     double m_timeUnit = 1e-0;  // Time units (ns/ms etc)
     uint64_t m_timeLastDump = 0;  // Last time we did a dump
@@ -316,6 +354,10 @@ private:
 
     // Number of total offload buffers that have been allocated
     uint32_t m_numOffloadBuffers = 0;
+    // Maximum bytes of offload buffers, 0 = default of 8 buffers
+    size_t m_offloadBytesMax = 0;
+    // If all offload buffers are in use, skip dump instead of waiting
+    bool m_offloadDrop = false;
     // Size of offload buffers
     size_t m_offloadBufferSize = 0;
     // Buffers handed to worker for processing
@@ -333,8 +375,9 @@ private:
     // The offload worker thread itself
     std::unique_ptr<std::thread> m_workerThread;
 
-    // Get a new offload buffer that can be populated. May block if none available
-    uint32_t* getOffloadBuffer();
+    // Get a new offload buffer that can be populated. May block if none available,
+    // or if mayDrop and dropping is enabled, return nullptr
+    uint32_t* getOffloadBuffer(bool mayDrop = false);
 
     // The function executed by the offload worker thread
     void offloadWorkerThreadMain();
@@ -367,7 +410,9 @@ protected:
     void traceInit() VL_MT_UNSAFE;
 
     // Declare new signal and return true if enabled
-    bool declCode(uint32_t code, const std::string& declName, uint32_t bits);
+    bool declCode(uint32_t code, uint32_t fidx, const std::string& declName, uint32_t bits);
+    // Return true if the name matches the glob pattern
+    static bool globMatch(const char* patternp, const char* namep);
 
     void closeBase();
     void flushBase();
@@ -416,9 +461,18 @@ public:
     // Set variables to dump, using $dumpvars format
     // If level = 0, dump everything and hier is then ignored
     void dumpvars(int level, const std::string& hier) VL_MT_SAFE;
+    // Add variables to dump, those with a name matching the glob pattern
+    void dumpvarsMatch(const std::string& pattern) VL_MT_SAFE;
+    // Set maximum bytes of buffers handed to the offload thread, 0 for default
+    void offloadBytesMax(size_t bytes) VL_MT_SAFE { m_offloadBytesMax = bytes; }
+    // Set to skip dumps when all offload buffers are in use, instead of waiting
+    void offloadDrop(bool flag) VL_MT_SAFE { m_offloadDrop = flag; }
 
     // Call
     void dump(uint64_t timeui) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Return false if a dump would have nothing to write, as no model was
+    // evaluated since the last dump, so the caller may skip the dump
+    bool dumpNeeded() const VL_MT_SAFE_EXCLUDES(m_mutex);
 
     //=========================================================================
     // Internal interface to Verilator generated code
@@ -435,6 +489,11 @@ public:
     void addChgCb(dumpCb_t cb, uint32_t fidx, void* userp) VL_MT_SAFE;
     void addChgCb(dumpOffloadCb_t cb, uint32_t fidx, void* userp) VL_MT_SAFE;
     void addCleanupCb(cleanupCb_t cb, void* userp) VL_MT_SAFE;
+    // Flag the model sets when evaluated, and a cleanup callback clears
+    void addActivityFlag(const bool* flagp) VL_MT_SAFE_EXCLUDES(m_mutex);
+
+    // Declare signals of a table, codes relative to 'base', as if calling decl* on each
+    void declTable(uint32_t base, const VerilatedTraceDecl* tablep, size_t size) VL_MT_UNSAFE;
 };
 
 //=============================================================================
@@ -520,12 +579,22 @@ public:
         if (VL_UNLIKELY(diff)) fullQData(oldp, newval, bits);
     }
     VL_ATTR_ALWINLINE void chgWData(uint32_t* oldp, const WData* newvalp, int bits) {
-        for (int i = 0; i < (bits + 31) / 32; ++i) {
-            if (VL_UNLIKELY(oldp[i] ^ newvalp[i])) {
+        // Most calls find no change, so compare a block of words without branches,
+        // which the compiler vectorizes, and only check for a difference per block.
+        constexpr int BLOCK_WORDS = 8;
+        const int words = (bits + 31) / 32;
+        int i = 0;
+        for (; i + BLOCK_WORDS <= words; i += BLOCK_WORDS) {
+            uint32_t diff = 0;
+            for (int j = 0; j < BLOCK_WORDS; ++j) diff |= oldp[i + j] ^ newvalp[i + j];
+            if (VL_UNLIKELY(diff)) {
                 fullWData(oldp, newvalp, bits);
                 return;
             }
         }
+        uint32_t diff = 0;
+        for (; i < words; ++i) diff |= oldp[i] ^ newvalp[i];
+        if (VL_UNLIKELY(diff)) fullWData(oldp, newvalp, bits);
     }
     VL_ATTR_ALWINLINE void chgEvent(uint32_t* oldp, const VlEventBase* newvalp) {
         if (newvalp->isTriggered()) fullEvent(oldp, newvalp);
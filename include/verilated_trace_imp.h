@@ -27,6 +27,7 @@
 #include "verilated_intrinsics.h"
 #include "verilated_trace.h"
 #include "verilated_threads.h"
+#include <cstring>
 #include <list>
 
 #if 0
@@ -64,21 +65,32 @@ static double timescaleToDouble(const char* unitp) VL_PURE {
 // Buffer management
 
 template <>
-uint32_t* VerilatedTrace<VL_SUB_T, VL_BUF_T>::getOffloadBuffer() {
+uint32_t* VerilatedTrace<VL_SUB_T, VL_BUF_T>::getOffloadBuffer(bool mayDrop) {
     uint32_t* bufferp;
+    // Note: over allocate a bit so pointer comparison is well defined
+    // if we overflow only by a small amount
+    const size_t bufferBytes = (m_offloadBufferSize + 16) * sizeof(uint32_t);
     // Some jitter is expected, so some number of alternative offload buffers are
-    // required, but don't allocate more than 8 buffers.
-    if (m_numOffloadBuffers < 8) {
-        // Allocate a new buffer if none is available
-        if (!m_offloadBuffersFromWorker.tryGet(bufferp)) {
-            ++m_numOffloadBuffers;
-            // Note: over allocate a bit so pointer comparison is well defined
-            // if we overflow only by a small amount
-            bufferp = new uint32_t[m_offloadBufferSize + 16];
-        }
+    // required, but don't allocate more than 8 buffers, or the configured budget.
+    const size_t maxBuffers
+        = m_offloadBytesMax ? std::max<size_t>(2, m_offloadBytesMax / bufferBytes) : 8;
+    if (m_offloadBuffersFromWorker.tryGet(bufferp)) return bufferp;
+    if (m_numOffloadBuffers < maxBuffers) {
+        // Allocate a new buffer as none is available
+        ++m_numOffloadBuffers;
+        bufferp = new uint32_t[m_offloadBufferSize + 16];
+        if (m_contextp) m_contextp->statTraceAdd(0, m_numOffloadBuffers * bufferBytes, 0);
+    } else if (mayDrop && m_offloadDrop) {
+        // Skip the dump, the next dump will include its changes
+        if (m_contextp) m_contextp->statTraceAdd(0, 0, 1);
+        return nullptr;
     } else {
         // Block until a buffer becomes available
+        const VlOs::DeltaWallTime stall{true};
         bufferp = m_offloadBuffersFromWorker.get();
+        if (m_contextp) {
+            m_contextp->statTraceAdd(static_cast<uint64_t>(stall.deltaTime() * 1e9), 0, 0);
+        }
     }
     return bufferp;
 }
@@ -315,7 +327,12 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::traceInit() VL_MT_UNSAFE {
     // Call all initialize callbacks, which will:
     // - Call decl* for each signal (these eventually call ::declCode)
     // - Store the base code
-    for (const CallbackRecord& cbr : m_initCbs) cbr.m_initCb(cbr.m_userp, self(), nextCode());
+    m_enabledFuncs.clear();
+    for (const CallbackRecord& cbr : m_initCbs) {
+        m_declUserp = cbr.m_userp;
+        cbr.m_initCb(cbr.m_userp, self(), nextCode());
+    }
+    m_declUserp = nullptr;
 
     if (expectedCodes && nextCode() != expectedCodes) {
         VL_FATAL_MT(__FILE__, __LINE__, "",
@@ -328,13 +345,13 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::traceInit() VL_MT_UNSAFE {
 
     // Apply enables
     if (m_sigs_enabledp) VL_DO_CLEAR(delete[] m_sigs_enabledp, m_sigs_enabledp = nullptr);
-    if (!m_sigs_enabledVec.empty()) {
-        // Else if was empty, m_sigs_enabledp = nullptr to short circuit tests
-        // But it isn't, so alloc one bit for each code to indicate enablement
+    if (!m_dumpvars.empty() || !m_dumpvarsMatch.empty()) {
+        // Else if not filtering, m_sigs_enabledp = nullptr to short circuit tests
+        // But it is, so alloc one bit for each code to indicate enablement
         // We don't want to still use m_signs_enabledVec as std::vector<bool> is not
         // guaranteed to be fast
         m_sigs_enabledp = new uint32_t[1 + VL_WORDS_I(nextCode())]{0};
-        m_sigs_enabledVec.reserve(nextCode());
+        m_sigs_enabledVec.resize(std::max<size_t>(m_sigs_enabledVec.size(), nextCode()));
         for (size_t code = 0; code < nextCode(); ++code) {
             if (m_sigs_enabledVec[code]) {
                 m_sigs_enabledp[VL_BITWORD_I(code)] |= 1U << VL_BITBIT_I(code);
@@ -343,6 +360,16 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::traceInit() VL_MT_UNSAFE {
         m_sigs_enabledVec.clear();
     }
 
+    // Functions tracing only disabled signals need not be called at all
+    for (std::vector<CallbackRecord>* const cbVecp :
+         {&m_constCbs, &m_constOffloadCbs, &m_fullCbs, &m_fullOffloadCbs, &m_chgCbs,
+          &m_chgOffloadCbs}) {
+        for (CallbackRecord& cbr : *cbVecp) {
+            cbr.m_enabled = !m_sigs_enabledp || m_enabledFuncs.count({cbr.m_userp, cbr.m_fidx});
+        }
+    }
+    m_enabledFuncs.clear();
+
     // Set callback so flush/abort will flush this file
     Verilated::addFlushCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onFlush, this);
     Verilated::addExitCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onExit, this);
@@ -362,14 +389,37 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::traceInit() VL_MT_UNSAFE {
 }
 
 template <>
-bool VerilatedTrace<VL_SUB_T, VL_BUF_T>::declCode(uint32_t code, const std::string& declName,
-                                                  uint32_t bits) {
+bool VerilatedTrace<VL_SUB_T, VL_BUF_T>::globMatch(const char* patternp, const char* namep) {
+    // Iterative match, on a '*' mismatch retry with the '*' consuming one more character
+    const char* starp = nullptr;  // Last '*' in pattern
+    const char* starNamep = nullptr;  // Name position matched by starp
+    while (*namep) {
+        if (*patternp == '*') {
+            starp = patternp++;
+            starNamep = namep;
+        } else if (*patternp == '?' || *patternp == *namep) {
+            ++patternp;
+            ++namep;
+        } else if (starp) {
+            patternp = starp + 1;
+            namep = ++starNamep;
+        } else {
+            return false;
+        }
+    }
+    while (*patternp == '*') ++patternp;
+    return !*patternp;
+}
+
+template <>
+bool VerilatedTrace<VL_SUB_T, VL_BUF_T>::declCode(uint32_t code, uint32_t fidx,
+                                                  const std::string& declName, uint32_t bits) {
     if (VL_UNCOVERABLE(!code)) {
         VL_FATAL_MT(__FILE__, __LINE__, "", "Internal: internal trace problem, code 0 is illegal");
     }
     // To keep it simple, this is O(enables * signals), but we expect few enables
     bool enabled = false;
-    if (m_dumpvars.empty()) enabled = true;
+    if (m_dumpvars.empty() && m_dumpvarsMatch.empty()) enabled = true;
     for (const auto& item : m_dumpvars) {
         const int dumpvarsLevel = item.first;
         const char* dvp = item.second.c_str();
@@ -392,6 +442,16 @@ bool VerilatedTrace<VL_SUB_T, VL_BUF_T>::declCode(uint32_t code, const std::stri
         enabled = true;
         break;
     }
+    if (!enabled) {
+        for (const std::string& pattern : m_dumpvarsMatch) {
+            if (!globMatch(pattern.c_str(), declName.c_str())) continue;
+            if (m_sigs_enabledVec.size() <= code) m_sigs_enabledVec.resize((code + 1024) * 2);
+            m_sigs_enabledVec[code] = true;
+            enabled = true;
+            break;
+        }
+    }
+    if (enabled) m_enabledFuncs.emplace(m_declUserp, fidx);
 
     int codesNeeded = VL_WORDS_I(bits);
     m_nextCode = std::max(m_nextCode, code + codesNeeded);
@@ -431,6 +491,7 @@ template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dumpvars(int level, const std::string& hier) VL_MT_SAFE {
     if (level == 0) {
         m_dumpvars.clear();  // empty = everything on
+        m_dumpvarsMatch.clear();
     } else {
         // Convert Verilog . separators to trace space separators
         std::string hierSpaced = hier;
@@ -440,6 +501,15 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dumpvars(int level, const std::string&
         m_dumpvars.emplace_back(level, hierSpaced);
     }
 }
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dumpvarsMatch(const std::string& pattern) VL_MT_SAFE {
+    // Convert Verilog . separators to trace space separators
+    std::string patternSpaced = pattern;
+    for (auto& i : patternSpaced) {
+        if (i == '.') i = ' ';
+    }
+    m_dumpvarsMatch.push_back(patternSpaced);
+}
 
 template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::parallelWorkerTask(void* datap, bool) {
@@ -468,9 +538,10 @@ VL_ATTR_NOINLINE void VerilatedTrace<VL_SUB_T, VL_BUF_T>::ParallelWorkerData::wa
 
 template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runCallbacks(const std::vector<CallbackRecord>& cbVec) {
-    if (parallel()) {
+    VlThreadPool* const threadPoolp
+        = parallel() ? static_cast<VlThreadPool*>(m_contextp->threadPoolp()) : nullptr;
+    if (threadPoolp) {
         // If tracing in parallel, dispatch to the thread pool
-        VlThreadPool* threadPoolp = static_cast<VlThreadPool*>(m_contextp->threadPoolp());
         // List of work items for thread (std::list, as ParallelWorkerData is not movable)
         std::list<ParallelWorkerData> workerData;
         // We use the whole pool + the main thread
@@ -479,6 +550,7 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runCallbacks(const std::vector<Callback
         std::vector<ParallelWorkerData*> mainThreadWorkerData;
         // Enqueue all the jobs
         for (const CallbackRecord& cbr : cbVec) {
+            if (!cbr.m_enabled) continue;
             // Always get the trace buffer on the main thread
             Buffer* const bufp = getTraceBuffer(cbr.m_fidx);
             // Create new work item
@@ -509,6 +581,7 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runCallbacks(const std::vector<Callback
     }
     // Fall back on sequential execution
     for (const CallbackRecord& cbr : cbVec) {
+        if (!cbr.m_enabled) continue;
         Buffer* const traceBufferp = getTraceBuffer(cbr.m_fidx);
         cbr.m_dumpCb(cbr.m_userp, traceBufferp);
         commitTraceBuffer(traceBufferp);
@@ -520,12 +593,24 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runOffloadedCallbacks(
     const std::vector<CallbackRecord>& cbVec) {
     // Fall back on sequential execution
     for (const CallbackRecord& cbr : cbVec) {
+        if (!cbr.m_enabled) continue;
         Buffer* traceBufferp = getTraceBuffer(cbr.m_fidx);
         cbr.m_dumpOffloadCb(cbr.m_userp, static_cast<OffloadBuffer*>(traceBufferp));
         commitTraceBuffer(traceBufferp);
     }
 }
 
+template <>
+bool VerilatedTrace<VL_SUB_T, VL_BUF_T>::dumpNeeded() const VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    // If any model does not register an activity flag, always dump
+    if (m_fullDump || m_constDump || m_activityps.empty()) return true;
+    for (const bool* const flagp : m_activityps) {
+        if (*flagp) return true;
+    }
+    return false;
+}
+
 template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dump(uint64_t timeui) VL_MT_SAFE_EXCLUDES(m_mutex) {
     // Not really VL_MT_SAFE but more VL_MT_UNSAFE_ONE.
@@ -555,7 +640,9 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dump(uint64_t timeui) VL_MT_SAFE_EXCLUD
         // Currently only incremental dumps run on the worker thread
         if (VL_LIKELY(!m_fullDump)) {
             // Get the offload buffer we are about to fill
-            bufferp = getOffloadBuffer();
+            bufferp = getOffloadBuffer(true);
+            // Dropped, the activity flags and old values are left for the next dump
+            if (VL_UNLIKELY(!bufferp)) return;
             m_offloadBufferWritep = bufferp;
             m_offloadBufferEndp = bufferp + m_offloadBufferSize;
 
@@ -717,6 +804,67 @@ template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::addCleanupCb(cleanupCb_t cb, void* userp) VL_MT_SAFE {
     addCallbackRecord(m_cleanupCbs, CallbackRecord{cb, userp});
 }
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::addActivityFlag(const bool* flagp)
+    VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    m_activityps.push_back(flagp);
+}
+
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::declTable(uint32_t base, const VerilatedTraceDecl* tablep,
+                                                   size_t size) VL_MT_UNSAFE {
+    for (const VerilatedTraceDecl* ep = tablep; ep != tablep + size; ++ep) {
+        if (ep->m_op == VerilatedTraceDeclOp::PUSH) {
+            self()->pushPrefix(ep->m_namep, ep->m_prefixType);
+            continue;
+        }
+        if (ep->m_op == VerilatedTraceDeclOp::POP) {
+            self()->popPrefix();
+            continue;
+        }
+        // Unpacked array elements are consecutive, each widthWords codes apart
+        const bool array = ep->m_elements != 0;
+        const uint32_t elements = array ? ep->m_elements : 1;
+        const uint32_t bits = std::abs(ep->m_msb - ep->m_lsb) + 1;
+        const uint32_t stride = ep->m_op == VerilatedTraceDeclOp::ARRAY ? VL_WORDS_I(bits)
+                                : (ep->m_op == VerilatedTraceDeclOp::QUAD
+                                   || ep->m_op == VerilatedTraceDeclOp::DOUBLE)
+                                    ? 2
+                                    : 1;
+        for (uint32_t i = 0; i < elements; ++i) {
+            const uint32_t code = base + ep->m_code + i * stride;
+            const int arraynum = array ? ep->m_arrayLo + static_cast<int>(i) : -1;
+            switch (ep->m_op) {
+            case VerilatedTraceDeclOp::EVENT:
+                self()->declEvent(code, ep->m_fidx, ep->m_namep, ep->m_dtypenum, ep->m_direction,
+                                  ep->m_kind, ep->m_type, array, arraynum);
+                break;
+            case VerilatedTraceDeclOp::BIT:
+                self()->declBit(code, ep->m_fidx, ep->m_namep, ep->m_dtypenum, ep->m_direction,
+                                ep->m_kind, ep->m_type, array, arraynum);
+                break;
+            case VerilatedTraceDeclOp::BUS:
+                self()->declBus(code, ep->m_fidx, ep->m_namep, ep->m_dtypenum, ep->m_direction,
+                                ep->m_kind, ep->m_type, array, arraynum, ep->m_msb, ep->m_lsb);
+                break;
+            case VerilatedTraceDeclOp::QUAD:
+                self()->declQuad(code, ep->m_fidx, ep->m_namep, ep->m_dtypenum, ep->m_direction,
+                                 ep->m_kind, ep->m_type, array, arraynum, ep->m_msb, ep->m_lsb);
+                break;
+            case VerilatedTraceDeclOp::ARRAY:
+                self()->declArray(code, ep->m_fidx, ep->m_namep, ep->m_dtypenum, ep->m_direction,
+                                  ep->m_kind, ep->m_type, array, arraynum, ep->m_msb, ep->m_lsb);
+                break;
+            case VerilatedTraceDeclOp::DOUBLE:
+                self()->declDouble(code, ep->m_fidx, ep->m_namep, ep->m_dtypenum, ep->m_direction,
+                                   ep->m_kind, ep->m_type, array, arraynum);
+                break;
+            default: break;  // LCOV_EXCL_LINE
+            }
+        }
+    }
+}
 
 //=========================================================================
 // Primitives converting binary values to strings...
@@ -734,6 +882,16 @@ static inline void cvtCDataToStr(char* dstp, CData value) {
     const __m128i d = _mm_cmpeq_epi8(_mm_and_si128(c, m), m);
     const __m128i result = _mm_sub_epi8(_mm_set1_epi8('0'), d);
     _mm_storel_epi64(reinterpret_cast<__m128i*>(dstp), result);
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    // Same as the SSE2 version, but within a 64-bit integer register
+    // Replicate value into each byte, then keep bit 7-N in byte N
+    const uint64_t a = (static_cast<uint64_t>(value) * 0x0101010101010101ULL)
+                       & 0x0102040810204080ULL;
+    // Set the top bit of non-zero bytes (no carries, as each byte is <= 0x80),
+    // move it down to the bottom bit, and convert to ASCII '0'/'1'
+    const uint64_t result
+        = (((a + 0x7f7f7f7f7f7f7f7fULL) >> 7) & 0x0101010101010101ULL) | 0x3030303030303030ULL;
+    std::memcpy(dstp, &result, sizeof(result));
 #else
     dstp[0] = '0' | static_cast<char>((value >> 7) & 1);
     dstp[1] = '0' | static_cast<char>((value >> 6) & 1);
@@ -31,12 +31,17 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <cstddef>
 #include <deque>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <new>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 //=========================================================================
 // Debug functions
@@ -227,20 +232,42 @@ public:
     virtual void clearTriggered() = 0;
 };
 
+// Processes directly waiting on a VlEvent, woken when the event is fired (see
+// VlDynamicTriggerScheduler::eventFired)
+class VlEventWaiters VL_NOT_FINAL {
+public:
+    virtual ~VlEventWaiters() = default;
+    virtual void wake() = 0;
+};
+
 class VlEvent final : public VlEventBase {
     // MEMBERS
     bool m_fired = false;  // Fired on this scheduling iteration
     bool m_triggered = false;  // Triggered state of event persisting until next time step
+    std::unique_ptr<VlEventWaiters> m_waitersp;  // Directly waiting processes, null if none yet
 
 public:
     // CONSTRUCTOR
     VlEvent() = default;
+    // Copies only the state, waiters stay with the original event
+    VlEvent(const VlEvent& other)
+        : m_fired{other.m_fired}
+        , m_triggered{other.m_triggered} {}
+    VlEvent& operator=(const VlEvent& other) {
+        m_fired = other.m_fired;
+        m_triggered = other.m_triggered;
+        return *this;
+    }
     ~VlEvent() override = default;
 
     friend std::string VL_TO_STRING(const VlEvent& e);
     friend class VlAssignableEvent;
+    friend class VlDynamicTriggerScheduler;
     // METHODS
-    void fire() override { m_fired = m_triggered = true; }
+    void fire() override {
+        m_fired = m_triggered = true;
+        if (VL_UNLIKELY(m_waitersp)) m_waitersp->wake();
+    }
     bool isFired() const override { return m_fired; }
     bool isTriggered() const override { return m_triggered; }
     void clearFired() override { m_fired = false; }
@@ -295,7 +322,16 @@ public:
     void srandom(uint64_t n) VL_MT_UNSAFE;
     std::string get_randstate() const VL_MT_UNSAFE;
     void set_randstate(const std::string& state) VL_MT_UNSAFE;
-    uint64_t rand64() VL_MT_UNSAFE;
+    uint64_t rand64() VL_MT_UNSAFE {
+        // Xoroshiro128+ algorithm, inline as called per value by class randomize()
+        const uint64_t result = m_state[0] + m_state[1];
+        m_state[1] ^= m_state[0];
+        m_state[0] = (((m_state[0] << 55) | (m_state[0] >> 9)) ^ m_state[1] ^ (m_state[1] << 14));
+        m_state[1] = (m_state[1] << 36) | (m_state[1] >> 28);
+        return result;
+    }
+    // Fill memory with random bytes, from generators seeded by this one
+    void fill(void* datap, size_t bytes) VL_MT_UNSAFE;
     // Threadsafe, but requires use on vl_thread_rng
     static uint64_t vl_thread_rng_rand64() VL_MT_SAFE;
     static VlRNG& vl_thread_rng() VL_MT_SAFE;
@@ -368,6 +404,8 @@ public:
 inline IData VL_RANDOM_RNG_I(VlRNG& rngr) VL_MT_UNSAFE { return rngr.rand64(); }
 inline QData VL_RANDOM_RNG_Q(VlRNG& rngr) VL_MT_UNSAFE { return rngr.rand64(); }
 extern WDataOutP VL_RANDOM_RNG_W(VlRNG& rngr, int obits, WDataOutP outwp) VL_MT_UNSAFE;
+/// Randomize all elements of an unpacked array of a given element width
+extern void VL_RANDOM_RNG_ARRAY(VlRNG& rngr, int obits, void* datap, size_t bytes) VL_MT_UNSAFE;
 
 //===================================================================
 // Readmem/Writemem operation classes
@@ -377,14 +415,18 @@ class VlReadMem final {
     const int m_bits;  // Bit width of values
     const std::string& m_filename;  // Filename
     const QData m_end;  // End address (as specified by user)
-    FILE* m_fp = nullptr;  // File handle for filename
+    const char* m_datap = nullptr;  // File contents, mapped or in m_buffer; nullptr if not open
+    const char* m_curp = nullptr;  // Next character to read
+    const char* m_endp = nullptr;  // End of file contents
+    size_t m_mappedSize = 0;  // Bytes mapped with mmap, 0 if read into m_buffer
+    std::string m_buffer;  // File contents when not mapped
     QData m_addr = 0;  // Next address to read
     int m_linenum = 0;  // Line number last read from file
     bool m_anyAddr = false;  // Had address directive in the file
 public:
     VlReadMem(bool hex, int bits, const std::string& filename, QData start, QData end);
     ~VlReadMem();
-    bool isOpen() const { return m_fp != nullptr; }
+    bool isOpen() const { return m_datap != nullptr; }
     int linenum() const { return m_linenum; }
     bool get(QData& addrr, std::string& valuer);
     void setData(void* valuep, const std::string& rhs);
@@ -474,6 +516,223 @@ std::string VL_TO_STRING(const VlWide<N_Words>& obj) {
     return VL_TO_STRING_W(N_Words, obj.data());
 }
 
+//===================================================================
+// Expression templates for wide bitwise operators.
+// Verilated code evaluates a nested expression such as "(a & b) | ~c" as
+//     VL_ASSIGN_WE(words, owp, (VlWideExpr{a} & VlWideExpr{b}) | ~VlWideExpr{c})
+// in a single loop over the words, without a temporary for each operator.
+// Each result word depends only on the same word of the operands, so the
+// output may also be an operand.
+
+// Base of all wide expressions, enables the operators below
+struct VlWideExprBase {};
+
+template <typename T_Expr>
+using VlWideExprIf = typename std::enable_if<std::is_base_of<VlWideExprBase, T_Expr>::value>::type;
+
+// Wide operand, the leaf of an expression
+struct VlWideExpr final : public VlWideExprBase {
+    const EData* const m_datap;  // Operand words
+    explicit VlWideExpr(WDataInP datap)
+        : m_datap{datap} {}
+    EData operator[](size_t index) const VL_PURE { return m_datap[index]; }
+};
+
+template <typename T_Lhs>
+struct VlWideNotExpr final : public VlWideExprBase {
+    const T_Lhs m_lhs;
+    explicit VlWideNotExpr(const T_Lhs& lhs)
+        : m_lhs{lhs} {}
+    EData operator[](size_t index) const VL_PURE { return ~m_lhs[index]; }
+};
+
+#define VL_WIDE_EXPR_BIOP_(name, op) \
+    template <typename T_Lhs, typename T_Rhs> \
+    struct name final : public VlWideExprBase { \
+        const T_Lhs m_lhs; \
+        const T_Rhs m_rhs; \
+        name(const T_Lhs& lhs, const T_Rhs& rhs) \
+            : m_lhs{lhs} \
+            , m_rhs{rhs} {} \
+        EData operator[](size_t index) const VL_PURE { return m_lhs[index] op m_rhs[index]; } \
+    }; \
+    template <typename T_Lhs, typename T_Rhs, typename = VlWideExprIf<T_Lhs>, \
+              typename = VlWideExprIf<T_Rhs>> \
+    name<T_Lhs, T_Rhs> operator op(const T_Lhs& lhs, const T_Rhs& rhs) VL_PURE { \
+        return name<T_Lhs, T_Rhs>{lhs, rhs}; \
+    }
+VL_WIDE_EXPR_BIOP_(VlWideAndExpr, &)
+VL_WIDE_EXPR_BIOP_(VlWideOrExpr, |)
+VL_WIDE_EXPR_BIOP_(VlWideXorExpr, ^)
+#undef VL_WIDE_EXPR_BIOP_
+
+template <typename T_Lhs, typename = VlWideExprIf<T_Lhs>>
+VlWideNotExpr<T_Lhs> operator~(const T_Lhs& lhs) VL_PURE {
+    return VlWideNotExpr<T_Lhs>{lhs};
+}
+
+// Assign a wide expression
+template <typename T_Expr>
+static inline WDataOutP VL_ASSIGN_WE(int words, WDataOutP owp, const T_Expr& expr) VL_MT_SAFE {
+    for (int i = 0; i < words; ++i) owp[i] = expr[i];
+    return owp;
+}
+
+//===================================================================
+// Double ended queue in a single ring buffer, the storage of VlQueue.
+// Unlike std::deque, an empty queue makes no allocation, and a small one a
+// single allocation, as testbenches may have millions of small queues.
+// Provides only the parts of the std::deque interface VlQueue needs.
+// Removed elements are reset to a default value, releasing their resources.
+
+template <typename T_Value>
+class VlRingDeque final {
+    // MEMBERS
+    std::vector<T_Value> m_buf;  // Element storage, size is zero or a power of two
+    size_t m_head = 0;  // Index in m_buf of the first element
+    size_t m_size = 0;  // Number of elements
+
+    // Random access iterator, T_Elem is T_Value or const T_Value
+    template <typename T_Elem, typename T_Ring>
+    class Iter final {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T_Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T_Elem*;
+        using reference = T_Elem&;
+
+        T_Ring* m_ringp = nullptr;  // Container
+        difference_type m_index = 0;  // Position in container
+
+        Iter() = default;
+        Iter(T_Ring* ringp, difference_type index)
+            : m_ringp{ringp}
+            , m_index{index} {}
+        // Conversion of iterator to const_iterator
+        template <typename T_OElem, typename T_ORing>
+        Iter(const Iter<T_OElem, T_ORing>& other)  // NOLINT(google-explicit-constructor)
+            : m_ringp{other.m_ringp}
+            , m_index{other.m_index} {}
+
+        reference operator*() const { return (*m_ringp)[m_index]; }
+        pointer operator->() const { return &(*m_ringp)[m_index]; }
+        reference operator[](difference_type n) const { return (*m_ringp)[m_index + n]; }
+        Iter& operator++() {
+            ++m_index;
+            return *this;
+        }
+        Iter operator++(int) { return Iter{m_ringp, m_index++}; }
+        Iter& operator--() {
+            --m_index;
+            return *this;
+        }
+        Iter operator--(int) { return Iter{m_ringp, m_index--}; }
+        Iter& operator+=(difference_type n) {
+            m_index += n;
+            return *this;
+        }
+        Iter& operator-=(difference_type n) {
+            m_index -= n;
+            return *this;
+        }
+        Iter operator+(difference_type n) const { return Iter{m_ringp, m_index + n}; }
+        friend Iter operator+(difference_type n, const Iter& it) { return it + n; }
+        Iter operator-(difference_type n) const { return Iter{m_ringp, m_index - n}; }
+        difference_type operator-(const Iter& rhs) const { return m_index - rhs.m_index; }
+        bool operator==(const Iter& rhs) const { return m_index == rhs.m_index; }
+        bool operator!=(const Iter& rhs) const { return m_index != rhs.m_index; }
+        bool operator<(const Iter& rhs) const { return m_index < rhs.m_index; }
+        bool operator>(const Iter& rhs) const { return m_index > rhs.m_index; }
+        bool operator<=(const Iter& rhs) const { return m_index <= rhs.m_index; }
+        bool operator>=(const Iter& rhs) const { return m_index >= rhs.m_index; }
+    };
+
+    // METHODS
+    size_t mask() const { return m_buf.size() - 1; }
+    void reallocate(size_t capacity) {
+        std::vector<T_Value> buf(capacity);
+        for (size_t i = 0; i < m_size; ++i) buf[i] = std::move((*this)[i]);
+        m_buf.swap(buf);
+        m_head = 0;
+    }
+    void grow() { reallocate(m_buf.empty() ? 2 : m_buf.size() * 2); }
+
+public:
+    // TYPES
+    using iterator = Iter<T_Value, VlRingDeque>;
+    using const_iterator = Iter<const T_Value, const VlRingDeque>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // METHODS
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    T_Value& operator[](size_t index) { return m_buf[(m_head + index) & mask()]; }
+    const T_Value& operator[](size_t index) const { return m_buf[(m_head + index) & mask()]; }
+    T_Value& front() { return (*this)[0]; }
+    const T_Value& front() const { return (*this)[0]; }
+    T_Value& back() { return (*this)[m_size - 1]; }
+    const T_Value& back() const { return (*this)[m_size - 1]; }
+
+    void push_back(const T_Value& value) {
+        if (VL_UNLIKELY(m_size == m_buf.size())) grow();
+        (*this)[m_size++] = value;
+    }
+    void push_front(const T_Value& value) {
+        if (VL_UNLIKELY(m_size == m_buf.size())) grow();
+        m_head = (m_head - 1) & mask();
+        ++m_size;
+        front() = value;
+    }
+    void pop_back() { (*this)[--m_size] = T_Value{}; }
+    void pop_front() {
+        front() = T_Value{};
+        m_head = (m_head + 1) & mask();
+        --m_size;
+    }
+    void clear() { resize(0); }
+    void resize(size_t size) { resize(size, T_Value{}); }
+    void resize(size_t size, const T_Value& value) {
+        while (m_size > size) pop_back();
+        if (size > m_buf.size()) {
+            size_t capacity = 2;
+            while (capacity < size) capacity *= 2;
+            reallocate(capacity);
+        }
+        while (m_size < size) (*this)[m_size++] = value;
+    }
+    iterator erase(const_iterator pos) {
+        const size_t index = pos.m_index;
+        for (size_t i = index + 1; i < m_size; ++i) (*this)[i - 1] = std::move((*this)[i]);
+        pop_back();
+        return iterator{this, pos.m_index};
+    }
+    iterator insert(const_iterator pos, const T_Value& value) {
+        push_back(value);
+        std::rotate(begin() + pos.m_index, end() - 1, end());
+        return iterator{this, pos.m_index};
+    }
+
+    iterator begin() { return iterator{this, 0}; }
+    iterator end() { return iterator{this, static_cast<std::ptrdiff_t>(m_size)}; }
+    const_iterator begin() const { return const_iterator{this, 0}; }
+    const_iterator end() const {
+        return const_iterator{this, static_cast<std::ptrdiff_t>(m_size)};
+    }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator{end()}; }
+    reverse_iterator rend() { return reverse_iterator{begin()}; }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+    const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+
+    bool operator==(const VlRingDeque& rhs) const {
+        return m_size == rhs.m_size && std::equal(begin(), end(), rhs.begin());
+    }
+    bool operator!=(const VlRingDeque& rhs) const { return !(*this == rhs); }
+};
+
 //===================================================================
 // Verilog queue and dynamic array container
 // There are no multithreaded locks on this; the base variable must
@@ -485,7 +744,7 @@ template <typename T_Value, size_t N_MaxSize = 0>
 class VlQueue final {
 private:
     // TYPES
-    using Deque = std::deque<T_Value>;
+    using Deque = VlRingDeque<T_Value>;
 
 public:
     using const_iterator = typename Deque::const_iterator;
@@ -1267,6 +1526,68 @@ std::string VL_TO_STRING(const VlAssocArray<T_Key, T_Value>& obj) {
 template <typename T_Key, typename T_Value>
 struct VlContainsCustomStruct<VlAssocArray<T_Key, T_Value>> : VlContainsCustomStruct<T_Key> {};
 
+//===================================================================
+// Verilog associative array container with integral keys, as a hash table.
+// Verilator uses this instead of VlAssocArray only when the order of the
+// elements is never observed, i.e. the array is only indexed, and used
+// with exists(), delete() and size()/num().
+// There are no multithreaded locks on this; the base variable must
+// be protected by other means
+//
+template <typename T_Key, typename T_Value>
+class VlUnorderedAssocArray final {
+private:
+    // TYPES
+    using Map = std::unordered_map<T_Key, T_Value>;
+
+    // MEMBERS
+    Map m_map;  // State of the assoc array
+    T_Value m_defaultValue;  // Default value
+
+public:
+    // CONSTRUCTORS
+    // m_defaultValue isn't defaulted. Caller's constructor must do it.
+    VlUnorderedAssocArray() = default;
+    ~VlUnorderedAssocArray() = default;
+    VlUnorderedAssocArray(const VlUnorderedAssocArray&) = default;
+    VlUnorderedAssocArray(VlUnorderedAssocArray&&) = default;
+    VlUnorderedAssocArray& operator=(const VlUnorderedAssocArray&) = default;
+    VlUnorderedAssocArray& operator=(VlUnorderedAssocArray&&) = default;
+    bool operator==(const VlUnorderedAssocArray& rhs) const { return m_map == rhs.m_map; }
+    bool operator!=(const VlUnorderedAssocArray& rhs) const { return m_map != rhs.m_map; }
+    // METHODS
+    T_Value& atDefault() { return m_defaultValue; }
+    const T_Value& atDefault() const { return m_defaultValue; }
+
+    // Size of array. Verilog: function int size(), or int num()
+    int size() const { return m_map.size(); }
+    // Clear array. Verilog: function void delete([input index])
+    void clear() { m_map.clear(); }
+    void erase(const T_Key& index) { m_map.erase(index); }
+    // Return 0/1 if element exists. Verilog: function int exists(input index)
+    int exists(const T_Key& index) const { return m_map.find(index) != m_map.end(); }
+    // Setting. Verilog: assoc[index] = v
+    T_Value& at(const T_Key& index) {
+        const auto it = m_map.find(index);
+        if (it == m_map.end()) return m_map.emplace(index, m_defaultValue).first->second;
+        return it->second;
+    }
+    // Accessing. Verilog: v = assoc[index]
+    const T_Value& at(const T_Key& index) const {
+        const auto it = m_map.find(index);
+        return it == m_map.end() ? m_defaultValue : it->second;
+    }
+    // Setting as a chained operation
+    VlUnorderedAssocArray& set(const T_Key& index, const T_Value& value) {
+        at(index) = value;
+        return *this;
+    }
+    VlUnorderedAssocArray& setDefault(const T_Value& value) {
+        atDefault() = value;
+        return *this;
+    }
+};
+
 template <typename T_Key, typename T_Value>
 void VL_READMEM_N(bool hex, int bits, const std::string& filename,
                   VlAssocArray<T_Key, T_Value>& obj, QData start, QData end) VL_MT_SAFE {
@@ -1331,6 +1652,8 @@ public:
     const WData* data() const { return &m_storage[0]; }
 
     constexpr std::size_t size() const { return N_Depth; }
+    // Zero all elements at once, only used when the elements are plain numbers
+    void zero() { std::memset(static_cast<void*>(m_storage), 0, sizeof(m_storage)); }
     // To fit C++14
     template <std::size_t N_CurrentDimension = 0, typename U = T_Value>
     int find_length(int dimension, std::false_type) const {
@@ -1600,6 +1923,104 @@ std::string VL_TO_STRING(const VlUnpacked<T_Value, N_Depth>& obj) {
 template <typename T, int N>
 struct VlContainsCustomStruct<VlUnpacked<T, N>> : VlContainsCustomStruct<T> {};
 
+//===================================================================
+/// Verilog unpacked array container for huge memories, in lazily allocated
+/// pages of about 4 KB, through a two level page table.  Elements of a page
+/// are zero until the page is first accessed, so only memory used by the
+/// model is allocated.  Verilator uses this instead of VlUnpacked for arrays
+/// of packed elements above --sparse-array-limit bytes, when every reference
+/// to the array is an element select or $readmem/$writemem.
+
+template <typename T_Value, std::size_t N_Depth>
+class VlSparseUnpacked final {
+    static constexpr size_t pow2Floor(size_t n) { return n <= 1 ? 1 : 2 * pow2Floor(n / 2); }
+
+public:
+    // CONSTANTS
+    static constexpr size_t PAGE_ELEMENTS = pow2Floor(4096 / sizeof(T_Value));
+    static constexpr size_t TABLE_PAGES = 512;  // Pages in each second level table
+    static constexpr size_t PAGES = (N_Depth + PAGE_ELEMENTS - 1) / PAGE_ELEMENTS;
+
+private:
+    // TYPES
+    struct Page final {
+        T_Value m_elements[PAGE_ELEMENTS];
+    };
+    struct Table final {
+        std::unique_ptr<Page> m_pageps[TABLE_PAGES];
+    };
+    static constexpr size_t TABLES = (PAGES + TABLE_PAGES - 1) / TABLE_PAGES;
+
+    // MEMBERS
+    std::unique_ptr<Table> m_tableps[TABLES];  // First level of page table
+
+    static const T_Value& zero() VL_MT_SAFE {
+        static const T_Value s_zero{};
+        return s_zero;
+    }
+
+public:
+    // CONSTRUCTORS
+    VlSparseUnpacked() = default;
+    ~VlSparseUnpacked() = default;
+    VlSparseUnpacked(const VlSparseUnpacked& rhs) { *this = rhs; }
+    VlSparseUnpacked(VlSparseUnpacked&&) = default;
+    VlSparseUnpacked& operator=(const VlSparseUnpacked& rhs) {
+        if (this == &rhs) return *this;
+        clear();
+        for (size_t page = 0; page < PAGES; ++page) {
+            if (const T_Value* const rhsp = rhs.pagep(page)) {
+                std::copy(rhsp, rhsp + PAGE_ELEMENTS, pagep(page));
+            }
+        }
+        return *this;
+    }
+    VlSparseUnpacked& operator=(VlSparseUnpacked&&) = default;
+
+    // METHODS
+    constexpr std::size_t size() const { return N_Depth; }
+    // Release all pages, so all elements are zero
+    void clear() {
+        for (std::unique_ptr<Table>& tablep : m_tableps) tablep.reset();
+    }
+    // Elements of given page, or nullptr if the page was never accessed
+    const T_Value* pagep(size_t page) const {
+        const Table* const tablep = m_tableps[page / TABLE_PAGES].get();
+        if (!tablep) return nullptr;
+        const Page* const pp = tablep->m_pageps[page % TABLE_PAGES].get();
+        return pp ? pp->m_elements : nullptr;
+    }
+    // Elements of given page, allocating it if needed
+    T_Value* pagep(size_t page) {
+        std::unique_ptr<Table>& tablep = m_tableps[page / TABLE_PAGES];
+        if (VL_UNLIKELY(!tablep)) tablep.reset(new Table{});
+        std::unique_ptr<Page>& pp = tablep->m_pageps[page % TABLE_PAGES];
+        if (VL_UNLIKELY(!pp)) pp.reset(new Page{});
+        return pp->m_elements;
+    }
+    // Access elements, allocating their page when not const
+    T_Value& operator[](size_t index) {
+        return pagep(index / PAGE_ELEMENTS)[index % PAGE_ELEMENTS];
+    }
+    const T_Value& operator[](size_t index) const {
+        const T_Value* const pp = pagep(index / PAGE_ELEMENTS);
+        return pp ? pp[index % PAGE_ELEMENTS] : zero();
+    }
+
+    bool operator==(const VlSparseUnpacked& rhs) const {
+        for (size_t page = 0; page < PAGES; ++page) {
+            const T_Value* const lp = pagep(page);
+            const T_Value* const rp = rhs.pagep(page);
+            if (!lp && !rp) continue;
+            for (size_t i = 0; i < PAGE_ELEMENTS; ++i) {
+                if (!((lp ? lp[i] : zero()) == (rp ? rp[i] : zero()))) return false;
+            }
+        }
+        return true;
+    }
+    bool operator!=(const VlSparseUnpacked& rhs) const { return !(*this == rhs); }
+};
+
 //===================================================================
 // Helper to apply the given indices to a target expression
 
@@ -1643,6 +2064,10 @@ struct VlApplyIndices<N_Rank, N_Rank, T_Target> final {
 //   derived from the bit selects (_[3:1]), which masks the bits that
 //   need to be updated, and additionally the RHS is widened to a full
 //   element size, with the bits inserted into the masked region.
+//   Successive updates of the same element are merged into one entry.
+//   When the number of pending updates exceeds a fraction of the array
+//   size, updates are instead merged into dense shadow arrays of values
+//   and masks, which are applied in one pass over the array at commit.
 template <typename T_Target,  // Type of the variable this commit queue updates
           bool Partial,  // Whether partial element updates are necessary
           // The following we could figure out from 'T_Target using type traits, but passing
@@ -1697,8 +2122,17 @@ class VlNBACommitQueue<T_Target, /* Partial: */ true, T_Element, N_Rank> final {
         size_t indices[N_Rank];
     };
 
+    // CONSTANTS
+    static constexpr size_t ELEMENTS = sizeof(T_Target) / sizeof(T_Element);
+    // Switch to dense mode when pending updates exceed this
+    static constexpr size_t DENSE_THRESHOLD = ELEMENTS / 8 > 64 ? ELEMENTS / 8 : 64;
+
     // STATE
     std::vector<Entry> m_pending;  // Pending updates, in program order
+    std::unique_ptr<T_Target> m_valuesp;  // Dense mode: masked new value of each element
+    std::unique_ptr<T_Target> m_masksp;  // Dense mode: pending bits of each element
+    size_t m_denseCount = 0;  // Dense mode: updates merged since last commit
+    bool m_dense = false;  // Merging updates into m_valuesp/m_masksp
 
     // STATIC METHODS
 
@@ -1749,6 +2183,64 @@ class VlNBACommitQueue<T_Target, /* Partial: */ true, T_Element, N_Rank> final {
         return result;
     }
 
+    template <typename T>
+    VL_ATTR_ALWINLINE static typename std::enable_if<!VlIsVlWide<T>::value, bool>::type
+    bIsZero(const T& a) {
+        return a == 0;
+    }
+
+    template <typename T>
+    VL_ATTR_ALWINLINE static typename std::enable_if<VlIsVlWide<T>::value, bool>::type
+    bIsZero(const T& a) {
+        for (size_t i = 0; i < T::Words; ++i) {
+            if (a.m_storage[i]) return false;
+        }
+        return true;
+    }
+
+    // Replace the masked bits of 'ref' with those of 'value'
+    template <typename T_Ref>
+    VL_ATTR_ALWINLINE static void bMerge(T_Ref& ref, const T_Element& value,
+                                         const T_Element& mask) {
+        ref = bOr(bAnd(value, mask), bAnd(ref, bNot(mask)));
+    }
+
+    // Apply dense shadow arrays to the target, clearing the masks, one dimension at a time
+    template <typename T_Commit, typename T_Shadow>
+    static void denseCommit(T_Commit& target, const T_Shadow& values, T_Shadow& masks,
+                            std::integral_constant<size_t, 0>) {
+        if (bIsZero(masks)) return;
+        bMerge(target, values, masks);
+        masks = T_Element{};
+    }
+    template <typename T_Commit, typename T_Shadow, size_t N_Dims>
+    static void denseCommit(T_Commit& target, const T_Shadow& values, T_Shadow& masks,
+                            std::integral_constant<size_t, N_Dims>) {
+        for (size_t i = 0; i < values.size(); ++i) {
+            denseCommit(target[i], values[i], masks[i],
+                        std::integral_constant<size_t, N_Dims - 1>{});
+        }
+    }
+
+    // Merge an update into the dense shadow arrays
+    void denseEnqueue(const T_Element& value, const T_Element& mask, const size_t* indicesp) {
+        bMerge(VlApplyIndices<0, N_Rank, T_Target>::apply(*m_valuesp, indicesp), value, mask);
+        T_Element& maskr = VlApplyIndices<0, N_Rank, T_Target>::apply(*m_masksp, indicesp);
+        maskr = bOr(maskr, mask);
+        ++m_denseCount;
+    }
+
+    // Move pending updates into the dense shadow arrays
+    VL_ATTR_NOINLINE void toDense() {
+        if (!m_valuesp) {
+            m_valuesp.reset(new T_Target{});
+            m_masksp.reset(new T_Target{});
+        }
+        m_dense = true;
+        for (const Entry& entry : m_pending) denseEnqueue(entry.value, entry.mask, entry.indices);
+        m_pending.clear();
+    }
+
 public:
     // CONSTRUCTOR
     VlNBACommitQueue() = default;
@@ -1757,19 +2249,39 @@ public:
     // METHODS
     template <typename... T_Args>
     void enqueue(const T_Element& value, const T_Element& mask, T_Args... indices) {
+        const size_t indicesArray[N_Rank] = {static_cast<size_t>(indices)...};
+        if (m_dense) {
+            denseEnqueue(value, mask, indicesArray);
+            return;
+        }
+        if (!m_pending.empty()) {
+            // Merge with the previous update if the same element, e.g. loops over byte enables
+            Entry& last = m_pending.back();
+            if (std::equal(indicesArray, indicesArray + N_Rank, last.indices)) {
+                bMerge(last.value, value, mask);
+                last.mask = bOr(last.mask, mask);
+                return;
+            }
+        }
         m_pending.emplace_back(Entry{value, mask, {indices...}});
+        if (VL_UNLIKELY(m_pending.size() > DENSE_THRESHOLD)) toDense();
     }
 
     // Note: T_Commit might be different from T_Target. Specifically, when the signal is a
     // top-level IO port, T_Commit will be a native C array, while T_Target, will be a VlUnpacked
     template <typename T_Commit>
     void commit(T_Commit& target) {
+        if (VL_UNLIKELY(m_dense)) {
+            denseCommit(target, *m_valuesp, *m_masksp, std::integral_constant<size_t, N_Rank>{});
+            // Return to the queue if this evaluation had few updates, keeping the shadow arrays
+            m_dense = m_denseCount > DENSE_THRESHOLD;
+            m_denseCount = 0;
+            return;
+        }
         if (m_pending.empty()) return;
         for (const Entry& entry : m_pending) {  //
-            auto& ref = VlApplyIndices<0, N_Rank, T_Commit>::apply(target, entry.indices);
-            // Maybe inefficient, but it works for now ...
-            const auto oldValue = ref;
-            ref = bOr(bAnd(entry.value, entry.mask), bAnd(oldValue, bNot(entry.mask)));
+            bMerge(VlApplyIndices<0, N_Rank, T_Commit>::apply(target, entry.indices), entry.value,
+                   entry.mask);
         }
         m_pending.clear();
     }
@@ -1779,6 +2291,10 @@ public:
 // Object that VlDeleter is capable of deleting
 
 class VlDeletable VL_NOT_FINAL {
+    friend class VlDeleter;  // Needed for access to the pool size
+
+    size_t m_poolSize = 0;  // Size of the allocation from VlDeleter's pool, 0 if not pooled
+
 public:
     VlDeletable() = default;
     virtual ~VlDeletable() = default;
@@ -1787,8 +2303,16 @@ public:
 //===================================================================
 // Class providing delayed deletion of garbage objects. Objects get deleted only when 'deleteAll()'
 // is called, or the deleter itself is destroyed.
+//
+// A serial deleter is used by models that never share class objects between threads (models
+// verilated without multithreading). It queues garbage without locking, and recycles the memory
+// of deleted objects through per-size free lists, instead of returning it to the heap.
 
 class VlDeleter final {
+    // CONSTANTS
+    static constexpr size_t POOL_GRANULE = 16;  // Pool size class granularity in bytes
+    static constexpr size_t POOL_MAX_SIZE = 1024;  // Larger objects are not pooled
+
     // MEMBERS
     // Queue of new objects that should be deleted
     std::vector<VlDeletable*> m_newGarbage VL_GUARDED_BY(m_mutex);
@@ -1796,25 +2320,82 @@ class VlDeleter final {
     std::vector<VlDeletable*> m_deleteNow VL_GUARDED_BY(m_deleteMutex);
     mutable VerilatedMutex m_mutex;  // Mutex protecting the 'new garbage' queue
     mutable VerilatedMutex m_deleteMutex;  // Mutex protecting the delete queue
+    const bool m_serial;  // Objects are never shared between threads, no locking needed
+    // Serial mode only: queue of new objects that should be deleted
+    std::vector<VlDeletable*> m_serialGarbage;
+    // Serial mode only: free lists of memory for reuse, indexed by size class
+    std::vector<std::vector<void*>> m_pool;
 
 public:
     // CONSTRUCTOR
-    VlDeleter() = default;
-    ~VlDeleter() { deleteAll(); }
+    explicit VlDeleter(bool serial = false)
+        : m_serial{serial} {}
+    ~VlDeleter();
 
 private:
     VL_UNCOPYABLE(VlDeleter);
 
+    static size_t poolClass(size_t size) { return (size + POOL_GRANULE - 1) / POOL_GRANULE; }
+    static size_t poolSize(size_t size) { return poolClass(size) * POOL_GRANULE; }
+
 public:
     // METHODS
+    bool serial() const { return m_serial; }
+
     // Adds a new object to the 'new garbage' queue.
     void put(VlDeletable* const objp) VL_MT_SAFE {
+        if (m_serial) {
+            m_serialGarbage.push_back(objp);
+            return;
+        }
         const VerilatedLockGuard lock{m_mutex};
         m_newGarbage.push_back(objp);
     }
 
+    // Creates a new object, from the pool if serial
+    template <typename T_Class, typename... T_Args>
+    T_Class* create(T_Args&&... args) {
+        if (!m_serial || sizeof(T_Class) > POOL_MAX_SIZE
+            || alignof(T_Class) > alignof(std::max_align_t)) {
+            // () required here to avoid narrowing conversion warnings,
+            // when a new() has an e.g. CData type and passed a 1U.
+            return new T_Class(std::forward<T_Args>(args)...);
+        }
+        const size_t size = poolSize(sizeof(T_Class));
+        std::vector<void*>* const freep
+            = poolClass(size) < m_pool.size() ? &m_pool[poolClass(size)] : nullptr;
+        void* memp;
+        if (freep && !freep->empty()) {
+            memp = freep->back();
+            freep->pop_back();
+        } else {
+            memp = ::operator new(size);
+        }
+        T_Class* const objp = new (memp) T_Class(std::forward<T_Args>(args)...);
+        objp->m_poolSize = size;
+        return objp;
+    }
+
+    // Deletes an object immediately; there must be no other references to it, and none of its
+    // methods may be running.
+    void deleteNow(VlDeletable* const objp) VL_MT_SAFE { destroy(objp); }
+
     // Deletes all queued garbage objects.
     void deleteAll() VL_EXCLUDES(m_mutex) VL_EXCLUDES(m_deleteMutex) VL_MT_SAFE;
+
+private:
+    void deleteSerial();
+    // Destroys the object, returning pooled memory to the free lists
+    void destroy(VlDeletable* objp) {
+        const size_t size = objp->m_poolSize;
+        if (!size) {
+            delete objp;
+            return;
+        }
+        objp->~VlDeletable();
+        if (poolClass(size) >= m_pool.size()) m_pool.resize(poolClass(size) + 1);
+        m_pool[poolClass(size)].push_back(objp);
+    }
 };
 
 //===================================================================
@@ -1830,17 +2411,38 @@ class VlClass VL_NOT_FINAL : public VlDeletable {
     // MEMBERS
     std::atomic<size_t> m_counter{1};  // Reference count for this object
     VlDeleter* m_deleterp = nullptr;  // The deleter that will delete this object
+    bool m_serial = false;  // Only referenced from one thread, so counter needs no atomic RMW
+    bool m_local = false;  // Only referenced from one variable, so delete without deferring
 
     // METHODS
-    // Atomically increments the reference counter
+    // Atomically (unless serial) increments the reference counter
     void refCountInc() VL_MT_SAFE {
         VL_DEBUG_IFDEF(assert(m_counter););  // If zero, we might have already deleted
-        ++m_counter;
+        if (m_serial) {
+            m_counter.store(m_counter.load(std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+        } else {
+            ++m_counter;
+        }
     }
-    // Atomically decrements the reference counter. Assuming VlClassRef semantics are sound, it
-    // should never get called at m_counter == 0.
+    // Atomically (unless serial) decrements the reference counter. Assuming VlClassRef semantics
+    // are sound, it should never get called at m_counter == 0.
     void refCountDec() VL_MT_SAFE {
-        if (!--m_counter) m_deleterp->put(this);
+        if (m_serial) {
+            const size_t count = m_counter.load(std::memory_order_relaxed) - 1;
+            m_counter.store(count, std::memory_order_relaxed);
+            if (!count) released();
+        } else {
+            if (!--m_counter) released();
+        }
+    }
+    // Called when the last reference is gone
+    void released() VL_MT_SAFE {
+        if (m_local) {
+            m_deleterp->deleteNow(this);
+        } else {
+            m_deleterp->put(this);
+        }
     }
 
 public:
@@ -1862,6 +2464,13 @@ struct VlNull final {
 };
 inline bool operator==(const void* ptr, VlNull) { return !ptr; }
 
+//===================================================================
+// Tag for constructing a VlClassRef to an object that is only ever referenced from the variable
+// the new object is assigned to (see VL_NEW_LOCAL). Such objects are deleted as soon as that
+// variable releases them, instead of at the end of the evaluation.
+
+struct VlNewLocal final {};
+
 //===================================================================
 // Verilog class reference container
 // There are no multithreaded locks on this; the base variable must
@@ -1895,12 +2504,16 @@ public:
     VlClassRef(VlNull){};
     template <typename... T_Args>
     VlClassRef(VlDeleter& deleter, T_Args&&... args)
-        // () required here to avoid narrowing conversion warnings,
-        // when a new() has an e.g. CData type and passed a 1U.
-        : m_objp{new T_Class(std::forward<T_Args>(args)...)} {
+        : m_objp{deleter.create<T_Class>(std::forward<T_Args>(args)...)} {
         // refCountInc was moved to the constructor of T_Class
         // to fix self references in constructor.
         m_objp->m_deleterp = &deleter;
+        m_objp->m_serial = deleter.serial();
+    }
+    template <typename... T_Args>
+    VlClassRef(VlNewLocal, VlDeleter& deleter, T_Args&&... args)
+        : VlClassRef{deleter, std::forward<T_Args>(args)...} {
+        m_objp->m_local = true;
     }
     // Explicit to avoid implicit conversion from 0
     explicit VlClassRef(T_Class* objp)
@@ -2050,6 +2663,10 @@ public:
 #define VL_NEW(Class, ...) \
     VlClassRef<Class> { vlSymsp->__Vm_deleter, __VA_ARGS__ }
 
+// New object whose handle is never copied out of the variable it is assigned to
+#define VL_NEW_LOCAL(Class, ...) \
+    VlClassRef<Class> { VlNewLocal{}, vlSymsp->__Vm_deleter, __VA_ARGS__ }
+
 #define VL_KEEP_THIS \
     VlClassRef<std::remove_pointer<decltype(this)>::type> __Vthisref { this }
 
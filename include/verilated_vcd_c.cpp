@@ -36,6 +36,14 @@
 #else
 # include <unistd.h>
 #endif
+#ifndef _WIN32
+# include <netdb.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+#endif
+#ifndef MSG_NOSIGNAL  // Not on all platforms, then SIGPIPE must be ignored by the user
+# define MSG_NOSIGNAL 0
+#endif
 
 #ifndef O_LARGEFILE  // WIN32 headers omit this
 # define O_LARGEFILE 0
@@ -87,6 +95,86 @@ ssize_t VerilatedVcdFile::write(const char* bufp, ssize_t len) VL_MT_UNSAFE {
     return ::write(m_fd, bufp, len);
 }
 
+//=============================================================================
+// VerilatedVcdSocket
+
+bool VerilatedVcdSocket::open(const std::string& name) VL_MT_UNSAFE {
+    close();
+#ifdef _WIN32
+    return false;
+#else
+    if (name.compare(0, 5, "unix:") == 0) {
+        const std::string path = name.substr(5);
+        sockaddr_un addr{};
+        if (path.size() >= sizeof(addr.sun_path)) return false;
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (m_fd < 0) return false;
+        if (::connect(m_fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close();
+            return false;
+        }
+    } else if (name.compare(0, 4, "tcp:") == 0) {
+        const std::string::size_type colon = name.rfind(':');
+        if (colon <= 4) return false;
+        const std::string host = name.substr(4, colon - 4);
+        const std::string port = name.substr(colon + 1);
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* resultsp = nullptr;
+        if (::getaddrinfo(host.c_str(), port.c_str(), &hints, &resultsp) != 0) return false;
+        for (const addrinfo* aip = resultsp; aip; aip = aip->ai_next) {
+            m_fd = ::socket(aip->ai_family, aip->ai_socktype, aip->ai_protocol);
+            if (m_fd < 0) continue;
+            if (::connect(m_fd, aip->ai_addr, aip->ai_addrlen) == 0) break;
+            close();
+        }
+        ::freeaddrinfo(resultsp);
+        if (m_fd < 0) return false;
+    } else {
+        return false;
+    }
+    // Receive subscriptions, one pattern per line, up to an empty line
+    m_patterns.clear();
+    std::string line;
+    while (true) {
+        char c;
+        const ssize_t got = ::recv(m_fd, &c, 1, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) {  // Viewer went away before subscribing
+            close();
+            return false;
+        }
+        if (c == '\r') continue;
+        if (c != '\n') {
+            line += c;
+        } else if (line.empty()) {
+            break;
+        } else {
+            m_patterns.push_back(line);
+            line.clear();
+        }
+    }
+    return true;
+#endif
+}
+
+void VerilatedVcdSocket::close() VL_MT_UNSAFE {
+    if (m_fd < 0) return;
+    ::close(m_fd);
+    m_fd = -1;
+}
+
+ssize_t VerilatedVcdSocket::write(const char* bufp, ssize_t len) VL_MT_UNSAFE {
+#ifdef _WIN32
+    return -1;
+#else
+    return ::send(m_fd, bufp, len, MSG_NOSIGNAL);
+#endif
+}
+
 //=============================================================================
 //=============================================================================
 //=============================================================================
@@ -114,6 +202,9 @@ void VerilatedVcd::open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
     openNextImp(m_rolloverSize != 0);
     if (!isOpen()) return;
 
+    // Signals the reader subscribed to, e.g. a viewer with VerilatedVcdSocket
+    for (const std::string& pattern : m_filep->dumpvarsMatches()) Super::dumpvarsMatch(pattern);
+
     printStr("$version Generated by VerilatedVcd $end\n");
     printStr("$timescale ");
     printStr(timeResStr().c_str());  // lintok-begin-on-ref
@@ -129,7 +220,14 @@ void VerilatedVcd::open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
     printStr("$enddefinitions $end\n\n\n");
 
     // When using rollover, the first chunk contains the header only.
-    if (m_rolloverSize) openNextImp(true);
+    if (m_rolloverSize && !m_windowSize) openNextImp(true);
+
+    // When capturing a window, only the header is written now
+    if (m_windowSize) {
+        bufferFlush();
+        m_windowing = true;
+        m_windowCount = 0;
+    }
 }
 
 void VerilatedVcd::openNext(bool incFilename) VL_MT_SAFE_EXCLUDES(m_mutex) {
@@ -183,11 +281,43 @@ void VerilatedVcd::openNextImp(bool incFilename) {
     m_wroteBytes = 0;
 }
 
+bool VerilatedVcd::preFullDump() {
+    if (VL_UNLIKELY(m_windowing)) windowAdvance();
+    return isOpen();
+}
+
 bool VerilatedVcd::preChangeDump() {
-    if (VL_UNLIKELY(m_rolloverSize && m_wroteBytes > m_rolloverSize)) openNextImp(true);
+    if (VL_UNLIKELY(m_windowing)) {
+        windowAdvance();
+    } else if (VL_UNLIKELY(m_rolloverSize && m_wroteBytes > m_rolloverSize)) {
+        openNextImp(true);
+    }
     return isOpen();
 }
 
+void VerilatedVcd::windowAdvance() {
+    // Called before each dump. When the current segment is full it becomes
+    // the previous segment, dropping the older one, and the new segment
+    // starts with a full dump so it is viewable without the dropped data.
+    if (++m_windowCount <= m_windowSize) return;
+    bufferFlush();
+    m_windowPrev.swap(m_windowCur);
+    m_windowCur.clear();
+    m_windowCount = 1;
+    fullDump(true);
+}
+
+void VerilatedVcd::windowWrite() {
+    // This function is on the flush() call path
+    bufferFlush();
+    bufferWrite(m_windowPrev.data(), m_windowPrev.size());
+    bufferWrite(m_windowCur.data(), m_windowCur.size());
+    m_windowPrev.clear();
+    m_windowCur.clear();
+    // Next dump starts a new segment, written by a later trigger
+    m_windowCount = m_windowSize;
+}
+
 void VerilatedVcd::emitTimeChange(uint64_t timeui) {
     // Remember pointers when last emitted time stamp; if last output was
     // timestamp backup and overwrite it.
@@ -220,6 +350,10 @@ void VerilatedVcd::closePrev() {
 
     Super::flushBase();
     bufferFlush();
+    // Window not triggered is discarded
+    m_windowing = false;
+    m_windowPrev.clear();
+    m_windowCur.clear();
     m_isOpen = false;
     m_filep->close();
 }
@@ -248,7 +382,18 @@ void VerilatedVcd::close() VL_MT_SAFE_EXCLUDES(m_mutex) {
 void VerilatedVcd::flush() VL_MT_SAFE_EXCLUDES(m_mutex) {
     const VerilatedLockGuard lock{m_mutex};
     Super::flushBase();
-    bufferFlush();
+    if (m_windowing) {
+        windowWrite();
+    } else {
+        bufferFlush();
+    }
+}
+
+void VerilatedVcd::dumpWindow() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    if (!m_windowing) return;
+    Super::flushBase();
+    windowWrite();
 }
 
 void VerilatedVcd::printStr(const char* str) {
@@ -284,9 +429,25 @@ void VerilatedVcd::bufferFlush() VL_MT_UNSAFE_ONE {
     // When it gets nearly full we dump it using this routine which calls write()
     // This is much faster than using buffered I/O
     if (VL_UNLIKELY(!m_isOpen)) return;
-    const char* wp = m_wrBufp;
-    while (true) {
-        const ssize_t remaining = (m_writep - wp);
+    if (VL_UNLIKELY(m_windowing)) {
+        m_windowCur.append(m_wrBufp, m_writep - m_wrBufp);
+    } else {
+        bufferWrite(m_wrBufp, m_writep - m_wrBufp);
+    }
+
+    // Reset buffer
+    m_writep = m_wrBufp;
+    m_wrTimeBeginp = nullptr;
+    m_wrTimeEndp = nullptr;
+}
+
+void VerilatedVcd::bufferWrite(const char* bufp, size_t len) VL_MT_UNSAFE_ONE {
+    // This function is on the flush() call path
+    // Write the given data to the file
+    const char* wp = bufp;
+    const char* const endp = bufp + len;
+    while (m_isOpen) {
+        const ssize_t remaining = (endp - wp);
         if (remaining == 0) break;
         errno = 0;
         const ssize_t got = m_filep->write(wp, remaining);
@@ -305,11 +466,6 @@ void VerilatedVcd::bufferFlush() VL_MT_UNSAFE_ONE {
             }
         }
     }
-
-    // Reset buffer
-    m_writep = m_wrBufp;
-    m_wrTimeBeginp = nullptr;
-    m_wrTimeEndp = nullptr;
 }
 
 //=============================================================================
@@ -374,13 +530,15 @@ void VerilatedVcd::popPrefix() {
     assert(!m_prefixStack.empty());  // Always one left, the constructor's initial one
 }
 
-void VerilatedVcd::declare(uint32_t code, const char* name, const char* wirep, bool array,
-                           int arraynum, bool bussed, int msb, int lsb) {
+void VerilatedVcd::declare(uint32_t code, uint32_t fidx, const char* name, const char* wirep,
+                           bool array, int arraynum, bool bussed, int msb, int lsb) {
     const int bits = ((msb > lsb) ? (msb - lsb) : (lsb - msb)) + 1;
 
-    const std::string hierarchicalName = m_prefixStack.back().first + name;
+    std::string& hierarchicalName = m_declName;
+    hierarchicalName.assign(m_prefixStack.back().first);
+    hierarchicalName += name;
 
-    const bool enabled = Super::declCode(code, hierarchicalName, bits);
+    const bool enabled = Super::declCode(code, fidx, hierarchicalName, bits);
 
     if (m_suffixes.size() <= nextCode() * VL_TRACE_SUFFIX_ENTRY_SIZE) {
         m_suffixes.resize(nextCode() * VL_TRACE_SUFFIX_ENTRY_SIZE * 2, 0);
@@ -422,14 +580,17 @@ void VerilatedVcd::declare(uint32_t code, const char* name, const char* wirep, b
     }
 
     // Assemble the declaration
-    std::string decl = "$var ";
+    std::string& decl = m_declStr;
+    decl.assign("$var ");
     decl += wirep;
     decl += ' ';
     decl += std::to_string(bits);
     decl += ' ';
     decl += vcdCode;
     decl += ' ';
-    decl += lastWord(hierarchicalName);
+    const size_t lastSpace = hierarchicalName.rfind(' ');  // As lastWord, without a copy
+    decl.append(hierarchicalName, lastSpace == std::string::npos ? 0 : lastSpace + 1,
+                std::string::npos);
     if (array) {
         decl += '[';
         decl += std::to_string(arraynum);
@@ -450,32 +611,32 @@ void VerilatedVcd::declare(uint32_t code, const char* name, const char* wirep, b
 void VerilatedVcd::declEvent(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                              VerilatedTraceSigDirection, VerilatedTraceSigKind,
                              VerilatedTraceSigType, bool array, int arraynum) {
-    declare(code, name, "event", array, arraynum, false, 0, 0);
+    declare(code, fidx, name, "event", array, arraynum, false, 0, 0);
 }
 void VerilatedVcd::declBit(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                            VerilatedTraceSigDirection, VerilatedTraceSigKind,
                            VerilatedTraceSigType, bool array, int arraynum) {
-    declare(code, name, "wire", array, arraynum, false, 0, 0);
+    declare(code, fidx, name, "wire", array, arraynum, false, 0, 0);
 }
 void VerilatedVcd::declBus(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                            VerilatedTraceSigDirection, VerilatedTraceSigKind,
                            VerilatedTraceSigType, bool array, int arraynum, int msb, int lsb) {
-    declare(code, name, "wire", array, arraynum, true, msb, lsb);
+    declare(code, fidx, name, "wire", array, arraynum, true, msb, lsb);
 }
 void VerilatedVcd::declQuad(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                             VerilatedTraceSigDirection, VerilatedTraceSigKind,
                             VerilatedTraceSigType, bool array, int arraynum, int msb, int lsb) {
-    declare(code, name, "wire", array, arraynum, true, msb, lsb);
+    declare(code, fidx, name, "wire", array, arraynum, true, msb, lsb);
 }
 void VerilatedVcd::declArray(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                              VerilatedTraceSigDirection, VerilatedTraceSigKind,
                              VerilatedTraceSigType, bool array, int arraynum, int msb, int lsb) {
-    declare(code, name, "wire", array, arraynum, true, msb, lsb);
+    declare(code, fidx, name, "wire", array, arraynum, true, msb, lsb);
 }
 void VerilatedVcd::declDouble(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
                               VerilatedTraceSigDirection, VerilatedTraceSigKind,
                               VerilatedTraceSigType, bool array, int arraynum) {
-    declare(code, name, "real", array, arraynum, false, 63, 0);
+    declare(code, fidx, name, "real", array, arraynum, false, 63, 0);
 }
 
 //=============================================================================
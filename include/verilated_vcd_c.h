@@ -61,7 +61,16 @@ private:
     size_t m_maxSignalBytes = 0;  // Upper bound on number of bytes a single signal can generate
     uint64_t m_wroteBytes = 0;  // Number of bytes written to this file
 
+    // Time window capture, see VerilatedVcdC::dumpWindowSize
+    uint64_t m_windowSize = 0;  // Dumps in each window segment, 0 to write all dumps
+    uint64_t m_windowCount = 0;  // Number of dumps in m_windowCur
+    bool m_windowing = false;  // Output is kept in the window segments, not written
+    std::string m_windowPrev;  // Previous window segment, starts with a full dump
+    std::string m_windowCur;  // Current window segment, starts with a full dump
+
     std::vector<char> m_suffixes;  // VCD line end string codes + metadata
+    std::string m_declName;  // Scratch hierarchical name in declare, reused to avoid allocation
+    std::string m_declStr;  // Scratch declaration text in declare, reused likewise
 
     // Prefixes to add to signal names/scope types
     std::vector<std::pair<std::string, VerilatedTracePrefixType>> m_prefixStack{
@@ -73,18 +82,21 @@ private:
 
     void bufferResize(size_t minsize);
     void bufferFlush() VL_MT_UNSAFE_ONE;
+    void bufferWrite(const char* bufp, size_t len) VL_MT_UNSAFE_ONE;
     void bufferCheck() {
         // Flush the write buffer if there's not enough space left for new information
         // We only call this once per vector, so we need enough slop for a very wide "b###" line
         if (VL_UNLIKELY(m_writep > m_wrFlushp)) bufferFlush();
     }
     void openNextImp(bool incFilename);
+    void windowAdvance();
+    void windowWrite();
     void closePrev();
     void closeErr();
     void printIndent(int level_change);
     void printStr(const char* str);
-    void declare(uint32_t code, const char* name, const char* wirep, bool array, int arraynum,
-                 bool bussed, int msb, int lsb);
+    void declare(uint32_t code, uint32_t fidx, const char* name, const char* wirep, bool array,
+                 int arraynum, bool bussed, int msb, int lsb);
 
     // CONSTRUCTORS
     VL_UNCOPYABLE(VerilatedVcd);
@@ -97,7 +109,7 @@ protected:
     void emitTimeChange(uint64_t timeui) override;
 
     // Hooks called from VerilatedTrace
-    bool preFullDump() override { return isOpen(); }
+    bool preFullDump() override;
     bool preChangeDump() override;
 
     // Trace buffer management
@@ -118,6 +130,8 @@ public:
     // ACCESSORS
     // Set size in bytes after which new file should be created.
     void rolloverSize(uint64_t size) VL_MT_SAFE { m_rolloverSize = size; }
+    // Set number of dumps to keep in memory, 0 to write all dumps
+    void dumpWindowSize(uint64_t dumps) VL_MT_SAFE { m_windowSize = dumps; }
 
     // METHODS - All must be thread safe
     // Open the file; call isOpen() to see if errors
@@ -128,6 +142,8 @@ public:
     void close() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Flush any remaining data to this file
     void flush() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Write the dumps kept in memory when capturing a time window
+    void dumpWindow() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Return if file is open
     bool isOpen() const VL_MT_SAFE { return m_isOpen; }
 
@@ -171,6 +187,8 @@ template <>
 void VerilatedVcd::Super::set_time_resolution(const std::string& unit);
 template <>
 void VerilatedVcd::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedVcd::Super::dumpvarsMatch(const std::string& pattern);
 #endif  // DOXYGEN
 
 //=============================================================================
@@ -246,6 +264,38 @@ public:
     virtual void close() VL_MT_UNSAFE;
     /// Write data to file (if it is open)
     virtual ssize_t write(const char* bufp, ssize_t len) VL_MT_UNSAFE;
+    /// Patterns of the signals the reader asked for, as for
+    /// VerilatedVcdC::dumpvarsMatch; called after open(), empty for all signals
+    virtual std::vector<std::string> dumpvarsMatches() VL_MT_UNSAFE { return {}; }
+};
+
+//=============================================================================
+// VerilatedVcdSocket
+/// VerilatedVcdFile streaming the VCD to a viewer over a socket, for live
+/// waveform viewing.  Pass to the VerilatedVcdC constructor, then open with a
+/// "unix:<path>" or "tcp:<host>:<port>" name of the viewer's listening socket.
+///
+/// After connecting, the viewer first sends the patterns of the signals it
+/// subscribes to, one per line, then an empty line.  Patterns are as for
+/// VerilatedVcdC::dumpvarsMatch, and no patterns subscribes to all signals.
+/// Signals not subscribed to are not declared, and their changes are never
+/// formatted.  Not supported on Windows.
+
+class VerilatedVcdSocket final : public VerilatedVcdFile {
+    int m_fd = -1;  // Socket we're writing to
+    std::vector<std::string> m_patterns;  // Subscriptions received from the viewer
+
+public:
+    // METHODS
+    VerilatedVcdSocket() = default;
+    ~VerilatedVcdSocket() override { close(); }
+    /// Connect to the viewer, and receive its subscriptions
+    bool open(const std::string& name) override VL_MT_UNSAFE;
+    /// Disconnect from the viewer
+    void close() override VL_MT_UNSAFE;
+    /// Send data to the viewer
+    ssize_t write(const char* bufp, ssize_t len) override VL_MT_UNSAFE;
+    std::vector<std::string> dumpvarsMatches() override VL_MT_UNSAFE { return m_patterns; }
 };
 
 //=============================================================================
@@ -284,6 +334,15 @@ public:
     /// alignment to a start of a given time's dump).  Any file but the
     /// first may be removed.  Cat files together to create viewable vcd.
     void rolloverSize(size_t size) VL_MT_SAFE { m_sptrace.rolloverSize(size); }
+    /// Capture only a time window, call before open()
+    /// After the header, dumps are kept in memory instead of written.  At
+    /// least the last 'dumps' dumps (and at most twice that) are written
+    /// when triggered by dumpWindow(), flush(), $dumpflush, or an error or
+    /// warning from the model.  The window written starts with a full dump.
+    /// Not compatible with rolloverSize() or openNext().
+    void dumpWindowSize(uint64_t dumps) VL_MT_SAFE { m_sptrace.dumpWindowSize(dumps); }
+    /// Write the time window kept in memory, see dumpWindowSize()
+    void dumpWindow() VL_MT_SAFE { m_sptrace.dumpWindow(); }
     /// Close dump
     void close() VL_MT_SAFE {
         m_sptrace.close();
@@ -321,6 +380,11 @@ public:
     void dumpvars(int level, const std::string& hier) VL_MT_SAFE {
         m_sptrace.dumpvars(level, hier);
     }
+    // Add variables to dump, those with a name matching the glob pattern
+    // ('*' any characters, '?' any character), e.g. "top.t.*.data*"
+    void dumpvarsMatch(const std::string& pattern) VL_MT_SAFE {
+        m_sptrace.dumpvarsMatch(pattern);
+    }
 
     // Internal class access
     VerilatedVcd* spTrace() { return &m_sptrace; }
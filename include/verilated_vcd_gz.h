@@ -0,0 +1,86 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+///
+/// \file
+/// \brief Verilated gzip compressed VCD file header
+///
+/// This file is for inclusion by user wrappers that want the VCD trace
+/// compressed as it is written, instead of piping it through an external
+/// gzip process. The model's link must include zlib (-lz).
+///
+/// Example:
+/// \code
+///     VerilatedVcdGzFile gzFile{6};  // Compression level 1-9
+///     VerilatedVcdC tfp{&gzFile};
+///     topp->trace(&tfp, 99);
+///     tfp.open("dump.vcd.gz");
+/// \endcode
+///
+//*************************************************************************
+
+#ifndef VERILATOR_VERILATED_VCD_GZ_H_
+#define VERILATOR_VERILATED_VCD_GZ_H_
+
+#include "verilated_vcd_c.h"
+
+#include <cerrno>
+#include <string>
+#include <zlib.h>
+
+//=============================================================================
+// VerilatedVcdGzFile
+/// VCD file writer compressing the trace with zlib, in the gzip file format.
+/// The VCD buffer is handed to zlib when it is flushed, without a copy.
+
+class VerilatedVcdGzFile VL_NOT_FINAL : public VerilatedVcdFile {
+    gzFile m_gzp = nullptr;  // Compressed file being written
+    const int m_level;  // Compression level
+
+public:
+    // CONSTRUCTORS
+    /// Construct a (as yet) closed file, with given zlib compression level
+    /// 1 (fastest) to 9 (smallest)
+    explicit VerilatedVcdGzFile(int level = 6)
+        : m_level{level} {}
+    /// Close and destruct
+    ~VerilatedVcdGzFile() override {
+        if (m_gzp) close();
+    }
+
+    // METHODS
+    /// Open a file with given filename
+    bool open(const std::string& name) override VL_MT_UNSAFE {
+        const std::string mode = "wb" + std::to_string(m_level);
+        m_gzp = ::gzopen(name.c_str(), mode.c_str());
+        if (!m_gzp) return false;
+        // Compress in large blocks, the VCD buffer is flushed in chunks anyway
+        ::gzbuffer(m_gzp, 256 * 1024);
+        return true;
+    }
+    /// Close object's file
+    void close() override VL_MT_UNSAFE {
+        if (m_gzp) ::gzclose(m_gzp);
+        m_gzp = nullptr;
+    }
+    /// Write data to file (if it is open)
+    ssize_t write(const char* bufp, ssize_t len) override VL_MT_UNSAFE {
+        const int got = ::gzwrite(m_gzp, bufp, static_cast<unsigned>(len));
+        if (VL_UNLIKELY(got <= 0 && len > 0)) {
+            errno = EIO;
+            return -1;
+        }
+        return got;
+    }
+};
+
+#endif  // Guard
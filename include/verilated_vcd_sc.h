@@ -51,7 +51,10 @@ public:
 
     // METHODS - for SC kernel
     // Called from SystemC kernel
-    void cycle() override { VerilatedVcdC::dump(sc_core::sc_time_stamp().to_double()); }
+    void cycle() override {
+        uint64_t time;
+        if (VerilatedScTraceBase::dumpTime(spTrace(), time)) VerilatedVcdC::dump(time);
+    }
 };
 
 #endif  // Guard
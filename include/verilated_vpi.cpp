@@ -39,6 +39,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -94,8 +95,21 @@ public:
             *(reinterpret_cast<uint32_t*>(newp)) = activeMagic();
             return newp + 8;
         }
+#ifdef VL_VPI_IMMEDIATE_FREE
         // +8: 8 bytes for next
         uint8_t* newp = reinterpret_cast<uint8_t*>(::operator new(CHUNK_SIZE + 8));
+#else
+        // Allocate a slab of chunks at once, and put all but the first on the
+        // free list.  Like freed chunks, slabs are kept for the process lifetime.
+        static constexpr size_t SLAB_CHUNKS = 64;
+        uint8_t* newp
+            = reinterpret_cast<uint8_t*>(::operator new((CHUNK_SIZE + 8) * SLAB_CHUNKS));
+        for (size_t i = SLAB_CHUNKS - 1; i > 0; --i) {
+            uint8_t* const chunkp = newp + i * (CHUNK_SIZE + 8);
+            *(reinterpret_cast<uint8_t**>(chunkp)) = t_freeHeadp;
+            t_freeHeadp = chunkp;
+        }
+#endif
         *(reinterpret_cast<uint32_t*>(newp)) = activeMagic();
         return newp + 8;
     }
@@ -881,6 +895,15 @@ class VerilatedVpiImp final {
     VerilatedAssertOneThread m_assertOne;  // Assert only called from single thread
     uint64_t m_nextCallbackId = 1;  // Id to identify callback
     bool m_evalNeeded = false;  // Model has had signals updated via vpi_put_value()
+    // Resolution of names by vpi_handle_by_name, valid for m_nameCacheContextp
+    // while its scopes are unchanged, see VerilatedContextImp::scopeGeneration
+    struct NameCacheEnt final {
+        const VerilatedScope* m_scopep;  // Scope found
+        const VerilatedVar* m_varp;  // Variable found, or nullptr if the name is a scope
+    };
+    std::unordered_map<std::string, NameCacheEnt> m_nameCache;
+    const VerilatedContext* m_nameCacheContextp = nullptr;  // Context of m_nameCache
+    uint64_t m_nameCacheGeneration = 0;  // Scope generation of m_nameCache
 
     static VerilatedVpiImp& s() {  // Singleton
         static VerilatedVpiImp s_s;
@@ -1025,6 +1048,12 @@ public:
             VerilatedVpiCbHolder& ho = *it++;
             VerilatedVpioVar* const varop
                 = reinterpret_cast<VerilatedVpioVar*>(ho.cb_datap()->obj);
+            // Variables the model flags when written are compared only if flagged
+            CData* const changedp = varop->varp()->changedp();
+            if (changedp && !*changedp) {
+                if (was_last) break;
+                continue;
+            }
             void* const newDatap = varop->varDatap();
             void* const prevDatap = varop->prevDatap();  // Was malloced when we added the callback
             VL_DEBUG_IF_PLI(VL_DBG_MSGF("- vpi: value_test %s v[0]=%d/%d %p %p\n",
@@ -1038,11 +1067,14 @@ public:
                 vpi_get_value(ho.cb_datap()->obj, ho.cb_datap()->value);
                 (ho.cb_rtnp())(ho.cb_datap());
                 called = true;
+            } else if (changedp) {
+                *changedp = 0;
             }
             if (was_last) break;
         }
         for (const auto& ip : update) {
             std::memcpy(ip->prevDatap(), ip->varDatap(), ip->entSize());
+            ip->varp()->clearChanged();
         }
         return called;
     }
@@ -1059,6 +1091,23 @@ public:
         }
         s().m_inertialPuts.clear();
     }
+    // Find a previous vpi_handle_by_name resolution of given full name
+    static const NameCacheEnt* nameCacheFind(const std::string& name) {
+        VerilatedContext* const contextp = Verilated::threadContextp();
+        const uint64_t generation = contextp->impp()->scopeGeneration();
+        if (s().m_nameCacheContextp != contextp || s().m_nameCacheGeneration != generation) {
+            s().m_nameCache.clear();
+            s().m_nameCacheContextp = contextp;
+            s().m_nameCacheGeneration = generation;
+            return nullptr;
+        }
+        const auto it = s().m_nameCache.find(name);
+        return it == s().m_nameCache.end() ? nullptr : &it->second;
+    }
+    static void nameCacheInsert(const std::string& name, const VerilatedScope* scopep,
+                                const VerilatedVar* varp) {
+        s().m_nameCache.emplace(name, NameCacheEnt{scopep, varp});
+    }
 };
 
 //======================================================================
@@ -2050,6 +2099,23 @@ void vpi_get_systf_info(vpiHandle /*object*/, p_vpi_systf_data /*systf_data_p*/)
 
 // for obtaining handles
 
+static vpiHandle vlVpiHandleByNameFound(const VerilatedScope* scopep, const VerilatedVar* varp) {
+    if (!varp) {  // Whole name is a scope
+        if (scopep->type() == VerilatedScope::SCOPE_MODULE) {
+            return (new VerilatedVpioModule{scopep})->castVpiHandle();
+        } else if (scopep->type() == VerilatedScope::SCOPE_PACKAGE) {
+            return (new VerilatedVpioPackage{scopep})->castVpiHandle();
+        } else {
+            return (new VerilatedVpioScope{scopep})->castVpiHandle();
+        }
+    }
+    if (varp->isParam()) {
+        return (new VerilatedVpioParam{varp, scopep})->castVpiHandle();
+    } else {
+        return (new VerilatedVpioVar{varp, scopep})->castVpiHandle();
+    }
+}
+
 vpiHandle vpi_handle_by_name(PLI_BYTE8* namep, vpiHandle scope) {
     VerilatedVpiImp::assertOneCheck();
     VL_VPI_ERROR_RESET_();
@@ -2064,18 +2130,17 @@ vpiHandle vpi_handle_by_name(PLI_BYTE8* namep, vpiHandle scope) {
         scopeAndName = std::string{voScopep->fullname()} + (scopeIsPackage ? "" : ".") + namep;
         namep = const_cast<PLI_BYTE8*>(scopeAndName.c_str());
     }
+    // Testbenches often look up the same names repeatedly
+    if (const auto* const entp = VerilatedVpiImp::nameCacheFind(scopeAndName)) {
+        return vlVpiHandleByNameFound(entp->m_scopep, entp->m_varp);
+    }
     {
         // This doesn't yet follow the hierarchy in the proper way
         bool isPackage = false;
         scopep = Verilated::threadContextp()->scopeFind(namep);
         if (scopep) {  // Whole thing found as a scope
-            if (scopep->type() == VerilatedScope::SCOPE_MODULE) {
-                return (new VerilatedVpioModule{scopep})->castVpiHandle();
-            } else if (scopep->type() == VerilatedScope::SCOPE_PACKAGE) {
-                return (new VerilatedVpioPackage{scopep})->castVpiHandle();
-            } else {
-                return (new VerilatedVpioScope{scopep})->castVpiHandle();
-            }
+            VerilatedVpiImp::nameCacheInsert(scopeAndName, scopep, nullptr);
+            return vlVpiHandleByNameFound(scopep, nullptr);
         }
         std::string basename = scopeAndName;
         std::string scopename;
@@ -2118,12 +2183,8 @@ vpiHandle vpi_handle_by_name(PLI_BYTE8* namep, vpiHandle scope) {
         }
     }
     if (!varp) return nullptr;
-
-    if (varp->isParam()) {
-        return (new VerilatedVpioParam{varp, scopep})->castVpiHandle();
-    } else {
-        return (new VerilatedVpioVar{varp, scopep})->castVpiHandle();
-    }
+    VerilatedVpiImp::nameCacheInsert(scopeAndName, scopep, varp);
+    return vlVpiHandleByNameFound(scopep, varp);
 }
 
 vpiHandle vpi_handle_by_index(vpiHandle object, PLI_INT32 indx) {
@@ -2240,7 +2301,8 @@ vpiHandle vpi_iterate(PLI_INT32 type, vpiHandle object) {
     }
     case vpiModule: {
         const VerilatedVpioScope* const vop = VerilatedVpioScope::castp(object);
-        const VerilatedHierarchyMap* const map = VerilatedImp::hierarchyMap();
+        const VerilatedHierarchyMap* const map
+            = Verilated::threadContextp()->impp()->hierarchyMap();
         const VerilatedScope* const modp = vop ? vop->scopep() : nullptr;
         const auto it = vlstd::as_const(map)->find(const_cast<VerilatedScope*>(modp));
         if (it == map->end()) return nullptr;
@@ -2248,7 +2310,8 @@ vpiHandle vpi_iterate(PLI_INT32 type, vpiHandle object) {
     }
     case vpiInternalScope: {
         const VerilatedVpioScope* const vop = VerilatedVpioScope::castp(object);
-        const VerilatedHierarchyMap* const map = VerilatedImp::hierarchyMap();
+        const VerilatedHierarchyMap* const map
+            = Verilated::threadContextp()->impp()->hierarchyMap();
         const VerilatedScope* const modp = vop ? vop->scopep() : nullptr;
         const auto it = vlstd::as_const(map)->find(const_cast<VerilatedScope*>(modp));
         if (it == map->end()) return nullptr;
@@ -2256,7 +2319,8 @@ vpiHandle vpi_iterate(PLI_INT32 type, vpiHandle object) {
     }
     case vpiInstance: {
         if (object) return nullptr;
-        const VerilatedHierarchyMap* const map = VerilatedImp::hierarchyMap();
+        const VerilatedHierarchyMap* const map
+            = Verilated::threadContextp()->impp()->hierarchyMap();
         const auto it = vlstd::as_const(map)->find(nullptr);
         if (it == map->end()) return nullptr;
         return ((new VerilatedVpioInstanceIter{it->second})->castVpiHandle());
@@ -2755,6 +2819,7 @@ vpiHandle vpi_put_value(vpiHandle object, p_vpi_value valuep, p_vpi_time /*time_
             return object;
         }
         VerilatedVpiImp::evalNeeded(true);
+        vop->varp()->markChanged();
         const int varBits = vop->bitSize();
         if (valuep->format == vpiVectorVal) {
             if (VL_UNLIKELY(!valuep->value.vector)) return nullptr;
@@ -2890,6 +2955,107 @@ vpiHandle vpi_put_value(vpiHandle object, p_vpi_value valuep, p_vpi_time /*time_
     return nullptr;
 }
 
+//======================================================================
+// VerilatedVpiBatch implementation
+
+int VerilatedVpiBatch::add(vpiHandle object) VL_MT_UNSAFE_ONE {
+    VerilatedVpiImp::assertOneCheck();
+    VL_VPI_ERROR_RESET_();
+    const VerilatedVpioVar* const vop = VerilatedVpioVar::castp(object);
+    if (VL_UNLIKELY(!vop || vop->type() != vpiReg)) {
+        VL_VPI_ERROR_(__FILE__, __LINE__, "%s: Unsupported vpiHandle (%p)", __func__, object);
+        return -1;
+    }
+    switch (vop->varp()->vltype()) {
+    case VLVT_UINT8:
+    case VLVT_UINT16:
+    case VLVT_UINT32:
+    case VLVT_UINT64:
+    case VLVT_WDATA: break;
+    default:
+        VL_VPI_ERROR_(__FILE__, __LINE__, "%s: Unsupported vltype (%d) for %s", __func__,
+                      vop->varp()->vltype(), vop->fullname());
+        return -1;
+    }
+    if (!vop->varp()->isPublicRW()) m_writable = false;
+    const bool direct = vop->bitOffset() == 0
+                        && vop->bitSize() == static_cast<uint32_t>(vop->varp()->entBits());
+    m_entries.push_back(Entry{vop, m_bytes, direct});
+    m_bytes += VL_WORDS_I(vop->bitSize()) * sizeof(uint32_t);
+    return static_cast<int>(m_entries.size() - 1);
+}
+
+void VerilatedVpiBatch::get(void* bufp) const VL_MT_UNSAFE_ONE {
+    VerilatedVpiImp::assertOneCheck();
+    uint8_t* const basep = static_cast<uint8_t*>(bufp);
+    for (const Entry& entry : m_entries) {
+        const VerilatedVpioVar* const vop = entry.m_vop;
+        uint32_t* const outp = reinterpret_cast<uint32_t*>(basep + entry.m_offset);
+        const int bits = vop->bitSize();
+        if (!entry.m_direct) {
+            for (int i = 0; i < VL_WORDS_I(bits); ++i) outp[i] = vl_vpi_get_word(vop, 32, i * 32);
+            continue;
+        }
+        // Model values have no bits set above their width
+        switch (vop->varp()->vltype()) {
+        case VLVT_UINT8: outp[0] = *vop->varCDatap(); break;
+        case VLVT_UINT16: outp[0] = *vop->varSDatap(); break;
+        case VLVT_UINT32: outp[0] = *vop->varIDatap(); break;
+        case VLVT_UINT64: {
+            const QData value = *vop->varQDatap();
+            outp[0] = static_cast<uint32_t>(value);
+            if (bits > 32) outp[1] = static_cast<uint32_t>(value >> 32ULL);
+            break;
+        }
+        default:  // VLVT_WDATA
+            std::memcpy(outp, vop->varEDatap(), VL_WORDS_I(bits) * sizeof(uint32_t));
+            break;
+        }
+    }
+}
+
+bool VerilatedVpiBatch::put(const void* bufp) VL_MT_UNSAFE_ONE {
+    VerilatedVpiImp::assertOneCheck();
+    VL_VPI_ERROR_RESET_();
+    if (VL_UNLIKELY(!m_writable)) {
+        VL_VPI_ERROR_(__FILE__, __LINE__,
+                      "%s: Batch includes signal marked read-only,"
+                      " use public_flat_rw instead",
+                      __func__);
+        return false;
+    }
+    VerilatedVpiImp::evalNeeded(true);
+    const uint8_t* const basep = static_cast<const uint8_t*>(bufp);
+    for (const Entry& entry : m_entries) {
+        const VerilatedVpioVar* const vop = entry.m_vop;
+        const uint32_t* const inp = reinterpret_cast<const uint32_t*>(basep + entry.m_offset);
+        const int bits = vop->bitSize();
+        vop->varp()->markChanged();
+        if (!entry.m_direct) {
+            for (int i = 0; i < VL_WORDS_I(bits); ++i) vl_vpi_put_word(vop, inp[i], 32, i * 32);
+            continue;
+        }
+        switch (vop->varp()->vltype()) {
+        case VLVT_UINT8: *vop->varCDatap() = inp[0] & VL_MASK_I(bits); break;
+        case VLVT_UINT16: *vop->varSDatap() = inp[0] & VL_MASK_I(bits); break;
+        case VLVT_UINT32: *vop->varIDatap() = inp[0] & VL_MASK_I(bits); break;
+        case VLVT_UINT64: {
+            const QData value = (static_cast<QData>(inp[1]) << 32ULL) | inp[0];
+            *vop->varQDatap() = value & VL_MASK_Q(bits);
+            break;
+        }
+        default: {  // VLVT_WDATA
+            EData* const datap = vop->varEDatap();
+            const int words = VL_WORDS_I(bits);
+            std::memcpy(datap, inp, words * sizeof(uint32_t));
+            datap[words - 1] &= VL_MASK_E(bits);
+            break;
+        }
+        }
+    }
+    return true;
+}
+
 bool vl_check_array_format(const VerilatedVar* varp, const p_vpi_arrayvalue arrayvalue_p,
                            const char* fullname) {
     if (arrayvalue_p->format == vpiVectorVal) {
@@ -34,6 +34,10 @@
 
 #include "vltstd/sv_vpi_user.h"
 
+#include <vector>
+
+class VerilatedVpioVar;
+
 //======================================================================
 
 /// Class for namespace-like grouping of Verilator VPI functions.
@@ -69,4 +73,47 @@ public:
     static void selfTest() VL_MT_UNSAFE_ONE;
 };
 
+//======================================================================
+/// Verilator specific batched access to the values of a set of variables.
+///
+/// Variable handles are registered once with add(), then each get() or
+/// put() copies the values of all registered variables to or from one flat
+/// buffer, instead of a vpi_get_value or vpi_put_value call and format
+/// conversion per variable.
+///
+/// Each value occupies (bits+31)/32 32-bit words of the buffer, at
+/// offset(index), least significant word first as in the aval words of
+/// vpiVectorVal; unused upper bits read as zero.  The buffer must be at
+/// least bytes() long and 32-bit aligned.  It is provided by the caller, so
+/// may be in shared memory mapped by an out-of-process testbench.
+
+class VerilatedVpiBatch final {
+    struct Entry final {
+        const VerilatedVpioVar* m_vop;  // Variable
+        size_t m_offset;  // Byte offset of value in buffer
+        bool m_direct;  // Whole variable, so copied without bit shifting
+    };
+    std::vector<Entry> m_entries;  // Registered variables
+    size_t m_bytes = 0;  // Buffer size required
+    bool m_writable = true;  // All variables are public_flat_rw
+
+public:
+    /// Register a variable handle, returning its index, or -1 if not a
+    /// scalar or vector variable (see vpi_chk_error).  The handle must
+    /// stay valid while the batch is used.
+    int add(vpiHandle object) VL_MT_UNSAFE_ONE;
+    /// Number of registered variables
+    size_t size() const { return m_entries.size(); }
+    /// Buffer bytes required for all of the variables
+    size_t bytes() const { return m_bytes; }
+    /// Byte offset of the given variable's value in the buffer
+    size_t offset(int index) const { return m_entries[index].m_offset; }
+    /// Read all variables into the buffer
+    void get(void* bufp) const VL_MT_UNSAFE_ONE;
+    /// Write all variables from the buffer, like vpi_put_value with
+    /// vpiNoDelay.  Returns false, writing nothing, if any variable is
+    /// not public_flat_rw.
+    bool put(const void* bufp) VL_MT_UNSAFE_ONE;
+};
+
 #endif  // Guard
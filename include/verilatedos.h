@@ -438,6 +438,7 @@ using ssize_t = uint32_t;  ///< signed size_t; returned from read()
 #define VL_EDATASIZE 32  ///< Bits in an EData (WData entry)
 #define VL_EDATASIZE_LOG2 5  ///< log2(VL_EDATASIZE)
 #define VL_CACHE_LINE_BYTES 64  ///< Bytes in a cache line (for alignment)
+#define VL_PAGE_BYTES 4096  ///< Bytes in a memory page (for alignment)
 
 #ifndef VL_NO_LEGACY
 # define VL_WORDSIZE VL_IDATASIZE  // Legacy define
@@ -0,0 +1,414 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Microbenchmarks of the Verilated runtime library
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//*************************************************************************
+//
+// Times the hot paths of the runtime library that Verilated models spend
+// most of their time in, independently of any model, so changes to
+// include/ can be measured, and compared across compilers and flags.
+// Usually run by the nodist/runtime_bench/run script, which builds this
+// file in each configuration; see there for details.
+//
+// Usage: runtime_bench [--list] [--min-ms <ms>] [--repeat <n>] [<substring>...]
+//
+// Prints one "<benchmark> <ns/op>" line per benchmark run, the best of the
+// repeats. Benchmarks are selected by substrings of their names.
+//
+//*************************************************************************
+
+#include "verilated.h"
+#include "verilated_save.h"
+#include "verilated_vcd_c.h"
+#ifndef VL_BENCH_NO_TIMING
+#include "verilated_timing.h"
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+//======================================================================
+// Benchmark registry
+
+// A benchmark runs its operation 'iters' times, returning a value derived
+// from the results so that the work cannot be optimized away
+using BenchFunc = std::function<uint64_t(uint64_t iters)>;
+
+struct Bench final {
+    const char* m_name;
+    BenchFunc m_func;
+};
+
+static volatile uint64_t s_sink = 0;  // Results of benchmarks, so they are not optimized away
+
+// Inputs not known to the compiler, so operations are not constant folded
+static uint64_t s_seed = 0x9e3779b97f4a7c15ULL;
+static uint32_t nextRand() {
+    s_seed ^= s_seed << 13;
+    s_seed ^= s_seed >> 7;
+    s_seed ^= s_seed << 17;
+    return static_cast<uint32_t>(s_seed);
+}
+template <std::size_t N_Words>
+static void randomize(VlWide<N_Words>& w) {
+    for (std::size_t i = 0; i < N_Words; ++i) w[i] = nextRand();
+}
+
+//======================================================================
+// Wide arithmetic (verilated_funcs.h)
+
+template <int N_Bits>
+static uint64_t benchWideAdd(uint64_t iters) {
+    constexpr int words = VL_WORDS_I(N_Bits);
+    VlWide<words> a, b, o;
+    randomize(a);
+    randomize(b);
+    for (uint64_t i = 0; i < iters; ++i) {
+        VL_ADD_W(words, o, a, b);
+        a[0] = o[words - 1];
+    }
+    return o[0];
+}
+
+template <int N_Bits>
+static uint64_t benchWideMul(uint64_t iters) {
+    constexpr int words = VL_WORDS_I(N_Bits);
+    VlWide<words> a, b, o;
+    randomize(a);
+    randomize(b);
+    for (uint64_t i = 0; i < iters; ++i) {
+        VL_MUL_W(words, o, a, b);
+        a[0] = o[words - 1] | 1;
+    }
+    return o[0];
+}
+
+template <int N_Bits>
+static uint64_t benchWideDiv(uint64_t iters) {
+    constexpr int words = VL_WORDS_I(N_Bits);
+    VlWide<words> a, b, o;
+    randomize(a);
+    randomize(b);
+    for (int i = words / 2; i < words; ++i) b[i] = 0;
+    for (uint64_t i = 0; i < iters; ++i) {
+        VL_DIV_WWW(N_Bits, o, a, b);
+        a[0] ^= o[0];
+    }
+    return o[0];
+}
+
+template <int N_Bits>
+static uint64_t benchWideShift(uint64_t iters) {
+    constexpr int words = VL_WORDS_I(N_Bits);
+    VlWide<words> a, o;
+    randomize(a);
+    for (uint64_t i = 0; i < iters; ++i) {
+        VL_SHIFTL_WWI(N_Bits, N_Bits, 32, o, a, static_cast<IData>(i % N_Bits));
+        a[0] ^= o[words - 1];
+    }
+    return o[0];
+}
+
+template <int N_Bits>
+static uint64_t benchWideEq(uint64_t iters) {
+    constexpr int words = VL_WORDS_I(N_Bits);
+    VlWide<words> a, b;
+    randomize(a);
+    for (int i = 0; i < words; ++i) b[i] = a[i];
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; ++i) {
+        b[words - 1] = a[words - 1] ^ static_cast<EData>(i & 1);
+        sum += VL_EQ_W(words, a, b);
+    }
+    return sum;
+}
+
+//======================================================================
+// Containers (verilated_types.h)
+
+static uint64_t benchQueuePushPop(uint64_t iters) {
+    VlQueue<IData> q;
+    for (int i = 0; i < 64; ++i) q.push_back(nextRand());
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; ++i) {
+        q.push_back(static_cast<IData>(i));
+        sum += q.pop_front();
+    }
+    return sum;
+}
+
+static uint64_t benchQueueAt(uint64_t iters) {
+    VlQueue<IData> q;
+    for (int i = 0; i < 1024; ++i) q.push_back(nextRand());
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; ++i) sum += q.at(static_cast<int32_t>(i & 1023));
+    return sum;
+}
+
+static uint64_t benchAssocQData(uint64_t iters) {
+    VlAssocArray<QData, IData> a;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; ++i) {
+        const QData key = (i * 0x9e3779b97f4a7c15ULL) & 0xffff;
+        a.at(key) += 1;
+        sum += a.exists(key ^ 1);
+    }
+    return sum + a.size();
+}
+
+static uint64_t benchAssocString(uint64_t iters) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 4096; ++i) keys.push_back("top.dut.core.reg_" + std::to_string(i));
+    VlAssocArray<std::string, IData> a;
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; ++i) {
+        const std::string& key = keys[(i * 2654435761ULL) & 4095];
+        a.at(key) += 1;
+        sum += a.exists(key);
+    }
+    return sum + a.size();
+}
+
+//======================================================================
+// Formatting (_vl_vsformat)
+
+static uint64_t benchSformatf(uint64_t iters) {
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; ++i) {
+        const std::string s = VL_SFORMATF_N_NX("cycle %0d addr %08x data %b", 0,  //
+                                               32, static_cast<IData>(i),  //
+                                               32, static_cast<IData>(i * 4),  //
+                                               8, static_cast<CData>(i));
+        sum += s.size();
+    }
+    return sum;
+}
+
+static uint64_t benchSformatfWide(uint64_t iters) {
+    VlWide<VL_WORDS_I(256)> w;
+    randomize(w);
+    uint64_t sum = 0;
+    for (uint64_t i = 0; i < iters; ++i) {
+        w[0] = static_cast<EData>(i);
+        const std::string s = VL_SFORMATF_N_NX("%x %d", 0, 256, w.data(), 256, w.data());
+        sum += s.size();
+    }
+    return sum;
+}
+
+//======================================================================
+// Save (verilated_save.h)
+
+static uint64_t benchSave(uint64_t iters) {
+    // Each operation serializes a 4 KiB model state, as 'os << *topp' would
+    std::vector<uint32_t> state(1024);
+    for (uint32_t& v : state) v = nextRand();
+    VerilatedSave os;
+    os.open("/dev/null");
+    if (!os.isOpen()) return 0;
+    for (uint64_t i = 0; i < iters; ++i) {
+        state[i & 1023] = static_cast<uint32_t>(i);
+        for (const uint32_t& v : state) os << v;
+    }
+    os.close();
+    return state[0];
+}
+
+//======================================================================
+// Tracing (verilated_trace.h, VerilatedTraceBuffer)
+
+// A stand-in for a model's trace callbacks, with TRACE_SIGNALS 32-bit signals,
+// of which one in TRACE_CHANGE_RATIO change every dump
+static constexpr uint32_t TRACE_SIGNALS = 1024;
+static constexpr uint32_t TRACE_CHANGE_RATIO = 8;
+struct TraceModel final {
+    uint32_t m_baseCode = 0;
+    uint64_t m_cycle = 0;
+    IData m_values[TRACE_SIGNALS] = {};
+
+    static void init(void* userp, VerilatedVcd* tracep, uint32_t code) {
+        TraceModel* const selfp = static_cast<TraceModel*>(userp);
+        selfp->m_baseCode = code;
+        tracep->pushPrefix("top", VerilatedTracePrefixType::SCOPE_MODULE);
+        for (uint32_t i = 0; i < TRACE_SIGNALS; ++i) {
+            const std::string name = "sig" + std::to_string(i);
+            tracep->declBus(code + i, 0, name.c_str(), -1, VerilatedTraceSigDirection::NONE,
+                            VerilatedTraceSigKind::WIRE, VerilatedTraceSigType::LOGIC, false,
+                            -1, 31, 0);
+        }
+        tracep->popPrefix();
+    }
+    static void full(void* userp, VerilatedVcd::Buffer* bufp) {
+        const TraceModel* const selfp = static_cast<TraceModel*>(userp);
+        uint32_t* const oldp = bufp->oldp(selfp->m_baseCode);
+        for (uint32_t i = 0; i < TRACE_SIGNALS; ++i) {
+            bufp->fullIData(oldp + i, selfp->m_values[i], 32);
+        }
+    }
+    static void chg(void* userp, VerilatedVcd::Buffer* bufp) {
+        const TraceModel* const selfp = static_cast<TraceModel*>(userp);
+        uint32_t* const oldp = bufp->oldp(selfp->m_baseCode);
+        for (uint32_t i = 0; i < TRACE_SIGNALS; ++i) {
+            bufp->chgIData(oldp + i, selfp->m_values[i], 32);
+        }
+    }
+    void step() {
+        ++m_cycle;
+        for (uint32_t i = m_cycle % TRACE_CHANGE_RATIO; i < TRACE_SIGNALS;
+             i += TRACE_CHANGE_RATIO) {
+            m_values[i] += static_cast<IData>(m_cycle);
+        }
+    }
+};
+
+static uint64_t benchTraceVcd(uint64_t iters) {
+    TraceModel model;
+    VerilatedVcd trace;
+    trace.addInitCb(&TraceModel::init, &model);
+    trace.addFullCb(&TraceModel::full, 0, &model);
+    trace.addChgCb(&TraceModel::chg, 0, &model);
+    trace.open("/dev/null");
+    for (uint64_t i = 0; i < iters; ++i) {
+        model.step();
+        trace.dump(i);
+    }
+    trace.close();
+    return model.m_values[0];
+}
+
+//======================================================================
+// Delay scheduling (verilated_timing.h)
+
+#ifndef VL_BENCH_NO_TIMING
+// A process like 'forever #period ++count', until count reaches the limit
+static VlCoroutine delayProcess(VlDelayScheduler& sched, uint64_t period, uint64_t& count,
+                                uint64_t limit) {
+    while (count < limit) {
+        co_await sched.delay(period, nullptr, __FILE__, __LINE__);
+        ++count;
+    }
+}
+
+static uint64_t benchDelaySchedule(uint64_t iters) {
+    // Processes of a mix of periods, some beyond the scheduler's timing wheel
+    static constexpr uint64_t PERIODS[] = {1, 2, 3, 5, 7, 10, 25, 100, 300, 1000};
+    VerilatedContext context;
+    VlDelayScheduler sched{context};
+    uint64_t count = 0;
+    for (int copy = 0; copy < 10; ++copy) {
+        for (const uint64_t period : PERIODS) delayProcess(sched, period, count, iters);
+    }
+    while (count < iters) {
+        context.time(sched.nextTimeSlot());
+        sched.resume();
+    }
+    // Let the remaining processes see they are done, so their frames are freed
+    while (!sched.empty()) {
+        context.time(sched.nextTimeSlot());
+        sched.resume();
+    }
+    return context.time();
+}
+#endif
+
+//======================================================================
+
+static std::vector<Bench> benches() {
+    return {
+        {"wide_add_256", benchWideAdd<256>},
+        {"wide_add_1024", benchWideAdd<1024>},
+        {"wide_mul_256", benchWideMul<256>},
+        {"wide_mul_1024", benchWideMul<1024>},
+        {"wide_div_256", benchWideDiv<256>},
+        {"wide_shiftl_1024", benchWideShift<1024>},
+        {"wide_eq_1024", benchWideEq<1024>},
+        {"queue_push_pop", benchQueuePushPop},
+        {"queue_at", benchQueueAt},
+        {"assoc_qdata", benchAssocQData},
+        {"assoc_string", benchAssocString},
+        {"sformatf", benchSformatf},
+        {"sformatf_wide", benchSformatfWide},
+        {"save_4k", benchSave},
+        {"trace_vcd_1k", benchTraceVcd},
+#ifndef VL_BENCH_NO_TIMING
+        {"delay_schedule", benchDelaySchedule},
+#endif
+    };
+}
+
+static double nowNs() {
+    return std::chrono::duration<double, std::nano>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Return nanoseconds per operation, best of 'repeat' runs each of at least minNs
+static double measure(const Bench& bench, double minNs, int repeat) {
+    // Find an iteration count taking at least minNs
+    uint64_t iters = 1;
+    double elapsed = 0;
+    while (true) {
+        const double start = nowNs();
+        s_sink = s_sink + bench.m_func(iters);
+        elapsed = nowNs() - start;
+        if (elapsed >= minNs || iters >= (1ULL << 40)) break;
+        // Aim a little over, so the next run is usually the last
+        const double scale = elapsed > 0 ? (minNs * 1.2) / elapsed : 100;
+        iters = static_cast<uint64_t>(iters * std::min(std::max(scale, 2.0), 100.0));
+    }
+    double best = elapsed / iters;
+    for (int r = 1; r < repeat; ++r) {
+        const double start = nowNs();
+        s_sink = s_sink + bench.m_func(iters);
+        best = std::min(best, (nowNs() - start) / iters);
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    double minMs = 200;
+    int repeat = 3;
+    bool list = false;
+    std::vector<std::string> filters;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--list") {
+            list = true;
+        } else if (arg == "--min-ms" && i + 1 < argc) {
+            minMs = std::atof(argv[++i]);
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg[0] == '-') {
+            std::fprintf(stderr, "%%Error: Unknown argument: %s\n", arg.c_str());
+            return 1;
+        } else {
+            filters.push_back(arg);
+        }
+    }
+
+    for (const Bench& bench : benches()) {
+        bool selected = filters.empty();
+        for (const std::string& filter : filters) {
+            if (std::strstr(bench.m_name, filter.c_str())) selected = true;
+        }
+        if (!selected) continue;
+        if (list) {
+            std::printf("%s\n", bench.m_name);
+            continue;
+        }
+        const double nsPerOp = measure(bench, minMs * 1e6, repeat);
+        std::printf("%-20s %12.3f\n", bench.m_name, nsPerOp);
+        std::fflush(stdout);
+    }
+    return 0;
+}
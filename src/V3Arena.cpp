@@ -0,0 +1,168 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Pooled allocation of small objects
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "V3Arena.h"
+
+#include "V3Mutex.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#if !defined(_WIN32) && !defined(__MINGW32__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define VL_ARENA_SPILL 1
+#endif
+
+//######################################################################
+
+namespace {
+
+struct FreeItem final {
+    FreeItem* m_nextp;  // Next free object of same size class
+};
+
+constexpr size_t NUM_CLASSES = V3Arena::MAX_SIZE / V3Arena::GRAIN + 1;
+
+// Per thread state, plain data so no thread_local constructor is required
+thread_local FreeItem* t_freeps[NUM_CLASSES];  // Free list of each size class
+thread_local char* t_curp = nullptr;  // Next unused byte in current chunk
+thread_local char* t_endp = nullptr;  // End of current chunk
+
+// Chunks of all threads.  Never destructed, as objects may still be deleted
+// by other static destructors, but keeps the chunks reachable for leak checkers.
+struct ChunkList final {
+    V3Mutex m_mutex;
+    std::vector<char*> m_chunkps VL_GUARDED_BY(m_mutex);
+    std::atomic<size_t> m_bytes{0};
+    // Spill file, when chunks are mapped from a file rather than the heap
+    int m_spillFd VL_GUARDED_BY(m_mutex) = -1;  // File descriptor, -1 if not spilling
+    size_t m_spillSize VL_GUARDED_BY(m_mutex) = 0;  // Bytes of file mapped so far
+    char* m_regionp VL_GUARDED_BY(m_mutex) = nullptr;  // Current region of file
+    size_t m_regionUsed VL_GUARDED_BY(m_mutex) = 0;  // Bytes of current region given out
+    std::vector<char*> m_regionps VL_GUARDED_BY(m_mutex);  // All mapped regions
+    std::atomic<size_t> m_spillBytes{0};
+};
+ChunkList& chunkList() VL_MT_SAFE {
+    static ChunkList* const s_chunksp = new ChunkList;
+    return *s_chunksp;
+}
+
+size_t sizeClass(size_t size) { return (size + V3Arena::GRAIN - 1) / V3Arena::GRAIN; }
+
+// Bytes of spill file mapped at once, and carved into chunks
+constexpr size_t SPILL_REGION_SIZE = 64 * V3Arena::CHUNK_SIZE;
+
+// Return a chunk from the spill file, or nullptr if not spilling or mapping failed
+char* spillChunk(ChunkList& chunks) VL_REQUIRES(chunks.m_mutex) {
+#ifdef VL_ARENA_SPILL
+    if (chunks.m_spillFd < 0) return nullptr;
+    if (!chunks.m_regionp || chunks.m_regionUsed == SPILL_REGION_SIZE) {
+        const size_t offset = chunks.m_spillSize;
+        if (::ftruncate(chunks.m_spillFd, static_cast<off_t>(offset + SPILL_REGION_SIZE))) {
+            return nullptr;
+        }
+        void* const regionp = ::mmap(nullptr, SPILL_REGION_SIZE, PROT_READ | PROT_WRITE,
+                                     MAP_SHARED, chunks.m_spillFd, static_cast<off_t>(offset));
+        if (regionp == MAP_FAILED) return nullptr;
+        chunks.m_spillSize = offset + SPILL_REGION_SIZE;
+        chunks.m_regionp = static_cast<char*>(regionp);
+        chunks.m_regionUsed = 0;
+        chunks.m_regionps.push_back(chunks.m_regionp);
+    }
+    char* const chunkp = chunks.m_regionp + chunks.m_regionUsed;
+    chunks.m_regionUsed += V3Arena::CHUNK_SIZE;
+    chunks.m_spillBytes += V3Arena::CHUNK_SIZE;
+    return chunkp;
+#else
+    return nullptr;
+#endif
+}
+
+}  // namespace
+
+//######################################################################
+
+void* V3Arena::allocate(size_t size) VL_MT_SAFE {
+    if (VL_UNLIKELY(size > MAX_SIZE)) return ::operator new(size);
+    const size_t cls = sizeClass(size);
+    if (FreeItem* const itemp = t_freeps[cls]) {
+        t_freeps[cls] = itemp->m_nextp;
+        return itemp;
+    }
+    const size_t bytes = cls * GRAIN;
+    if (VL_UNLIKELY(t_curp + bytes > t_endp)) {
+        // The remainder of the old chunk is lost, at most MAX_SIZE bytes
+        ChunkList& chunks = chunkList();
+        char* chunkp;
+        {
+            const V3LockGuard lock{chunks.m_mutex};
+            chunkp = spillChunk(chunks);
+            if (!chunkp) chunkp = static_cast<char*>(::operator new(CHUNK_SIZE));
+            chunks.m_chunkps.push_back(chunkp);
+        }
+        chunks.m_bytes += CHUNK_SIZE;
+        t_curp = chunkp;
+        t_endp = chunkp + CHUNK_SIZE;
+    }
+    void* const objp = t_curp;
+    t_curp += bytes;
+    return objp;
+}
+
+void V3Arena::deallocate(void* objp, size_t size) VL_MT_SAFE {
+    if (!objp) return;
+    if (VL_UNLIKELY(size > MAX_SIZE)) {
+        ::operator delete(objp);
+        return;
+    }
+    const size_t cls = sizeClass(size);
+    FreeItem* const itemp = static_cast<FreeItem*>(objp);
+    itemp->m_nextp = t_freeps[cls];
+    t_freeps[cls] = itemp;
+}
+
+bool V3Arena::spillTo(const std::string& dirname) VL_MT_SAFE {
+#ifdef VL_ARENA_SPILL
+    ChunkList& chunks = chunkList();
+    const V3LockGuard lock{chunks.m_mutex};
+    if (chunks.m_spillFd >= 0) return true;
+    std::string filename = dirname + "/verilator_spill_XXXXXX";
+    const int fd = ::mkstemp(&filename[0]);
+    if (fd < 0) return false;
+    // Unlinked at once, so the system removes it at exit, however we exit
+    ::unlink(filename.c_str());
+    chunks.m_spillFd = fd;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void V3Arena::markCold() VL_MT_SAFE {
+#if defined(VL_ARENA_SPILL) && defined(MADV_COLD)
+    ChunkList& chunks = chunkList();
+    const V3LockGuard lock{chunks.m_mutex};
+    for (char* const regionp : chunks.m_regionps) {
+        ::madvise(regionp, SPILL_REGION_SIZE, MADV_COLD);
+    }
+#endif
+}
+
+size_t V3Arena::reservedBytes() VL_MT_SAFE { return chunkList().m_bytes; }
+size_t V3Arena::spilledBytes() VL_MT_SAFE { return chunkList().m_spillBytes; }
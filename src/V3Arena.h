@@ -0,0 +1,73 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Pooled allocation of small objects
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+//
+// V3Arena allocates AstNode, V3GraphVertex, V3GraphEdge and DfgVertex
+// objects from large chunks, with a free list for each size class.
+// This avoids the per-object malloc header and heap fragmentation from
+// millions of small objects, and makes new/delete a few instructions.
+//
+// Freed objects are kept for reuse by later objects of the same size
+// class, so the temporary graphs of a pass give their memory to the
+// next pass.  Chunks are never released; the system reclaims them at exit.
+//
+// Free lists are per thread, so V3ThreadPool workers need no locking.
+// An object may be freed by a different thread than allocated it.
+//
+// With --ast-spill-dir, chunks are instead mapped from an unlinked file in
+// that directory, so the system can write cold parts of the tree out to the
+// file under memory pressure, and read them back when next touched, rather
+// than exhausting memory or swap.  At the end of each stage markCold() hints
+// that all chunks are cold; those the next stage touches become hot again,
+// and the rest, e.g. modules a pass does not visit, are the first written out.
+//
+//*************************************************************************
+
+#ifndef VERILATOR_V3ARENA_H_
+#define VERILATOR_V3ARENA_H_
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include <cstddef>
+#include <string>
+
+//============================================================================
+
+class V3Arena final {
+public:
+    // CONSTANTS
+    static constexpr size_t GRAIN = 16;  // Size class granularity, and alignment
+    static constexpr size_t MAX_SIZE = 1024;  // Larger objects use the global allocator
+    static constexpr size_t CHUNK_SIZE = 1024 * 1024;  // Bytes in each chunk
+
+    // METHODS
+    static void* allocate(size_t size) VL_MT_SAFE;
+    static void deallocate(void* objp, size_t size) VL_MT_SAFE;
+    // Map new chunks from a file in given directory, return false if not possible
+    static bool spillTo(const std::string& dirname) VL_MT_SAFE;
+    // Hint that chunks mapped from the spill file are not needed soon
+    static void markCold() VL_MT_SAFE;
+    // Statistics
+    static size_t reservedBytes() VL_MT_SAFE;  // Bytes in chunks
+    static size_t spilledBytes() VL_MT_SAFE;  // Bytes in chunks mapped from spill file
+};
+
+// Add pooled operator new/delete to a class with a virtual destructor
+#define VL_ARENA_OPERATORS \
+    static void* operator new(size_t size) { return V3Arena::allocate(size); } \
+    static void operator delete(void* objp, size_t size) { V3Arena::deallocate(objp, size); }
+
+#endif  // Guard
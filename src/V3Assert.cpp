@@ -44,6 +44,7 @@ class AssertVisitor final : public VNVisitor {
     unsigned m_modPastNum = 0;  // Module past numbering
     unsigned m_modStrobeNum = 0;  // Module $strobe numbering
     const AstNodeProcedure* m_procedurep = nullptr;  // Current procedure
+    const AstNodeCoverOrAssert* m_assertp = nullptr;  // Current concurrent assertion
     VDouble0 m_statCover;  // Statistic tracking
     VDouble0 m_statAsNotImm;  // Statistic tracking
     VDouble0 m_statAsImm;  // Statistic tracking
@@ -201,6 +202,20 @@ class AssertVisitor final : public VNVisitor {
         return bodysp;
     }
 
+    void iterateAssertion(AstNodeCoverOrAssert* nodep) {
+        VL_RESTORER(m_assertp);
+        if (!nodep->immediate()) {
+            m_assertp = nodep;
+            if (v3Global.opt.assertOffload() && nodep->sentreep()) {
+                // Evaluate the property on sampled values only, so the check does not
+                // depend on, and need not be ordered after, other logic of the time step
+                AstNodeExpr* const propp = VN_AS(nodep->propp()->unlinkFrBack(), NodeExpr);
+                nodep->propp(newSampledExpr(propp));
+            }
+        }
+        iterateChildren(nodep);
+    }
+
     void newPslAssertion(AstNodeCoverOrAssert* nodep, AstNode* failsp) {
         if (m_beginp && nodep->name() == "") nodep->name(m_beginp->name());
 
@@ -464,6 +479,17 @@ class AssertVisitor final : public VNVisitor {
         AstAlways* const alwaysp
             = new AstAlways{nodep->fileline(), VAlwaysKwd::ALWAYS, sentreep, nullptr};
         m_modp->addStmtsp(alwaysp);
+        // With --assert-gate-past, history only used by a concurrent assertion
+        // is not updated while that assertion is disabled
+        AstIf* gateIfp = nullptr;
+        if (v3Global.opt.assertGatePast() && m_assertp) {
+            gateIfp = new AstIf{nodep->fileline(),
+                                assertOnCond(nodep->fileline(), m_assertp->type(),
+                                             m_assertp->directive())};
+            gateIfp->isBoundsCheck(true);  // To avoid LATCH warning
+            gateIfp->user1(true);  // Don't assert/cover this if
+            alwaysp->addStmtsp(gateIfp);
+        }
         for (uint32_t i = 0; i < ticks; ++i) {
             AstVar* const outvarp = new AstVar{
                 nodep->fileline(), VVarType::MODULETEMP,
@@ -471,11 +497,21 @@ class AssertVisitor final : public VNVisitor {
             m_modp->addStmtsp(outvarp);
             AstNode* const assp = new AstAssignDly{
                 nodep->fileline(), new AstVarRef{nodep->fileline(), outvarp, VAccess::WRITE}, inp};
-            alwaysp->addStmtsp(assp);
+            if (gateIfp) {
+                gateIfp->addThensp(assp);
+            } else {
+                alwaysp->addStmtsp(assp);
+            }
             // if (debug() >= 9) assp->dumpTree("-  ass: ");
             invarp = outvarp;
             inp = new AstVarRef{nodep->fileline(), invarp, VAccess::READ};
         }
+        if (m_inSampled) {
+            // Sampled value of the history equals its value before this time step's updates
+            inp = newSampledExpr(inp);
+            inp->user1(1);
+            v3Global.setHasSampled();
+        }
         nodep->replaceWith(inp);
         VL_DO_DANGLING(pushDeletep(nodep), nodep);
     }
@@ -594,7 +630,7 @@ class AssertVisitor final : public VNVisitor {
         VL_DO_DANGLING(pushDeletep(nodep), nodep);
     }
     void visit(AstAssert* nodep) override {
-        iterateChildren(nodep);
+        iterateAssertion(nodep);
         newPslAssertion(nodep, nodep->failsp());
     }
     void visit(AstAssertCtl* nodep) override {
@@ -673,11 +709,11 @@ class AssertVisitor final : public VNVisitor {
         VL_DO_DANGLING(pushDeletep(nodep), nodep);
     }
     void visit(AstAssertIntrinsic* nodep) override {
-        iterateChildren(nodep);
+        iterateAssertion(nodep);
         newPslAssertion(nodep, nodep->failsp());
     }
     void visit(AstCover* nodep) override {
-        iterateChildren(nodep);
+        iterateAssertion(nodep);
         newPslAssertion(nodep, nullptr);
     }
     void visit(AstRestrict* nodep) override {
@@ -0,0 +1,126 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Hash tables for unordered associative arrays
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// V3Assoc's Transformations:
+//
+// For each associative array variable with an integral key:
+//    If every reference only indexes the array, or calls exists(),
+//    delete() or size()/num() on it, the order of the elements is never
+//    observed, so change the variable to an unordered dtype, which is
+//    emitted as a VlUnorderedAssocArray hash table instead of a tree.
+//
+//*************************************************************************
+
+#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+
+#include "V3Assoc.h"
+
+#include "V3Stats.h"
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+
+class AssocVisitor final : public VNVisitor {
+    // NODE STATE
+    //  AstVar::user1()                 -> bool. Element order may be observed
+    //  AstAssocArrayDType::user2p()    -> AstAssocArrayDType*. Unordered copy of this dtype
+    const VNUser1InUse m_inuser1;
+    const VNUser2InUse m_inuser2;
+
+    // STATE
+    std::vector<AstVar*> m_varps;  // Candidate variables
+    std::vector<AstNodeVarRef*> m_refps;  // References to candidate variables
+    VDouble0 m_statUnordered;  // Statistic tracking
+
+    // METHODS
+    static AstAssocArrayDType* candidateDTypep(const AstVar* varp) {
+        AstAssocArrayDType* const adtypep = VN_CAST(varp->dtypeSkipRefp(), AssocArrayDType);
+        if (!adtypep || adtypep->unordered()) return nullptr;
+        if (varp->isIO() || varp->isSigPublic() || varp->isDpiOpenArray()) return nullptr;
+        // Keys must be integers with a std::hash
+        const AstBasicDType* const keyp = VN_CAST(adtypep->keyDTypep()->skipRefp(), BasicDType);
+        if (!keyp || keyp->isOpaque() || keyp->isWide()) return nullptr;
+        return adtypep;
+    }
+    static bool isUnorderedUse(const AstNodeVarRef* refp) {
+        // Indexing the array does not depend on the order of the elements
+        if (const AstAssocSel* const selp = VN_CAST(refp->backp(), AssocSel)) {
+            return selp->fromp() == refp;
+        }
+        // Neither do these methods, the others iterate over the elements
+        if (const AstCMethodHard* const methodp = VN_CAST(refp->backp(), CMethodHard)) {
+            if (methodp->fromp() != refp) return false;
+            const string& name = methodp->name();
+            return name == "exists" || name == "erase" || name == "clear" || name == "size";
+        }
+        return false;
+    }
+    AstAssocArrayDType* unorderedDTypep(AstAssocArrayDType* dtypep) {
+        if (!dtypep->user2p()) {
+            AstAssocArrayDType* const newp = new AstAssocArrayDType{
+                dtypep->fileline(), dtypep->subDTypep(), dtypep->keyDTypep()};
+            newp->unordered(true);
+            v3Global.rootp()->typeTablep()->addTypesp(newp);
+            dtypep->user2p(newp);
+        }
+        return VN_AS(dtypep->user2p(), AssocArrayDType);
+    }
+
+    // VISITORS
+    void visit(AstVar* nodep) override {
+        if (candidateDTypep(nodep)) m_varps.push_back(nodep);
+        iterateChildren(nodep);
+    }
+    void visit(AstNodeVarRef* nodep) override {
+        if (!candidateDTypep(nodep->varp())) return;
+        if (isUnorderedUse(nodep)) {
+            m_refps.push_back(nodep);
+        } else {
+            nodep->varp()->user1(true);
+        }
+    }
+    void visit(AstMemberSel* nodep) override {
+        if (nodep->varp()) nodep->varp()->user1(true);
+        iterateChildren(nodep);
+    }
+    void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit AssocVisitor(AstNetlist* nodep) {
+        iterate(nodep);
+        for (AstVar* const varp : m_varps) {
+            if (varp->user1()) continue;
+            varp->dtypep(unorderedDTypep(candidateDTypep(varp)));
+            ++m_statUnordered;
+        }
+        for (AstNodeVarRef* const refp : m_refps) {
+            if (!refp->varp()->user1()) refp->dtypeFrom(refp->varp());
+        }
+    }
+    ~AssocVisitor() override {
+        V3Stats::addStat("Optimizations, Unordered associative arrays", m_statUnordered);
+    }
+};
+
+//######################################################################
+// Assoc class functions
+
+void V3Assoc::assocAll(AstNetlist* nodep) {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    { AssocVisitor{nodep}; }  // Destruct before checking
+    V3Global::dumpCheckGlobalTree("assoc", 0, dumpTreeEitherLevel() >= 3);
+}
@@ -36,16 +36,36 @@ uint64_t AstNode::s_editCntGbl = 0;  // Hot cache line
 // To allow for fast clearing of all user pointers, we keep a "timestamp"
 // along with each userp, and thus by bumping this count we can make it look
 // as if we iterated across the entire tree to set all the userp's to null.
-int AstNode::s_cloneCntGbl = 0;
-uint32_t VNUser1InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
-uint32_t VNUser2InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
-uint32_t VNUser3InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
-uint32_t VNUser4InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
-
-bool VNUser1InUse::s_userBusy = false;
-bool VNUser2InUse::s_userBusy = false;
-bool VNUser3InUse::s_userBusy = false;
-bool VNUser4InUse::s_userBusy = false;
+thread_local int AstNode::s_cloneCntGbl = 0;
+std::atomic<int> AstNode::s_cloneCntNext{0};
+thread_local uint32_t VNUser1InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
+thread_local uint32_t VNUser2InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
+thread_local uint32_t VNUser3InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
+thread_local uint32_t VNUser4InUse::s_userCntGbl = 0;  // Hot cache line, leave adjacent
+
+thread_local bool VNUser1InUse::s_userBusy = false;
+thread_local bool VNUser2InUse::s_userBusy = false;
+thread_local bool VNUser3InUse::s_userBusy = false;
+thread_local bool VNUser4InUse::s_userBusy = false;
+
+std::atomic<uint32_t> VNUserInUseBase::s_userCntNext{0};
+
+VNUserInUseBase::ThreadState VNUserInUseBase::threadState() VL_MT_SAFE {
+    return ThreadState{{VNUser1InUse::s_userCntGbl, VNUser2InUse::s_userCntGbl,
+                        VNUser3InUse::s_userCntGbl, VNUser4InUse::s_userCntGbl},
+                       {VNUser1InUse::s_userBusy, VNUser2InUse::s_userBusy,
+                        VNUser3InUse::s_userBusy, VNUser4InUse::s_userBusy}};
+}
+void VNUserInUseBase::threadState(const ThreadState& state) VL_MT_SAFE {
+    VNUser1InUse::s_userCntGbl = state.m_cnt[0];
+    VNUser2InUse::s_userCntGbl = state.m_cnt[1];
+    VNUser3InUse::s_userCntGbl = state.m_cnt[2];
+    VNUser4InUse::s_userCntGbl = state.m_cnt[3];
+    VNUser1InUse::s_userBusy = state.m_busy[0];
+    VNUser2InUse::s_userBusy = state.m_busy[1];
+    VNUser3InUse::s_userBusy = state.m_busy[2];
+    VNUser4InUse::s_userBusy = state.m_busy[3];
+}
 
 int AstNodeDType::s_uniqueNum = 0;
 
@@ -81,6 +101,7 @@ AstNode::AstNode(VNType t, FileLine* fl)
     m_flags.didWidth = false;
     m_flags.doingWidth = false;
     m_flags.protect = true;
+    m_flags.brokenDirty = true;
     m_flags.unused = 0;  // Initializing this avoids a read-modify-write on construction
     editCountInc();
 }
@@ -804,6 +825,7 @@ AstNode* AstNode::cloneTreeIter(bool needPure) {
     // private: Clone single node and children
     if (needPure) purityCheck();
     AstNode* const newp = this->clone();
+    newp->m_flags.brokenDirty = true;
     if (this->m_op1p) newp->op1p(this->m_op1p->cloneTreeIterList(needPure));
     if (this->m_op2p) newp->op2p(this->m_op2p->cloneTreeIterList(needPure));
     if (this->m_op3p) newp->op3p(this->m_op3p->cloneTreeIterList(needPure));
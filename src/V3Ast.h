@@ -20,6 +20,7 @@
 #include "config_build.h"
 #include "verilatedos.h"
 
+#include "V3Arena.h"
 #include "V3Broken.h"
 #include "V3Error.h"
 #include "V3FileLine.h"
@@ -30,6 +31,7 @@
 
 #include "V3Ast__gen_forward_class_decls.h"  // From ./astgen
 
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <functional>
@@ -167,6 +169,40 @@ inline std::ostream& operator<<(std::ostream& os, const VLifetime& rhs) {
 
 // ######################################################################
 
+class VDpiThreads final {
+public:
+    // How calls to a DPI import may run in parallel mtasks
+    enum en : uint8_t {
+        DEFAULT,  // As per --threads-dpi
+        SAFE,  // Thread safe, never serialized
+        CONTEXT,  // Serialized only with calls from the same DPI context scope
+        SERIAL  // Always serialized
+    };
+    enum en m_e;
+    const char* ascii() const {
+        static const char* const names[] = {"DEFAULT", "SAFE", "CONTEXT", "SERIAL"};
+        return names[m_e];
+    }
+    VDpiThreads()
+        : m_e{DEFAULT} {}
+    // cppcheck-suppress noExplicitConstructor
+    constexpr VDpiThreads(en _e)
+        : m_e{_e} {}
+    explicit VDpiThreads(int _e)
+        : m_e(static_cast<en>(_e)) {}  // Need () or GCC 4.8 false warning
+    constexpr operator en() const { return m_e; }
+};
+constexpr bool operator==(const VDpiThreads& lhs, const VDpiThreads& rhs) {
+    return lhs.m_e == rhs.m_e;
+}
+constexpr bool operator==(const VDpiThreads& lhs, VDpiThreads::en rhs) { return lhs.m_e == rhs; }
+constexpr bool operator==(VDpiThreads::en lhs, const VDpiThreads& rhs) { return lhs == rhs.m_e; }
+inline std::ostream& operator<<(std::ostream& os, const VDpiThreads& rhs) {
+    return os << rhs.ascii();
+}
+
+// ######################################################################
+
 class VIsCached final {
     // Used in some nodes to cache results of boolean methods
     // If cachedCnt == 0, not cached
@@ -1767,9 +1803,28 @@ public:
 //  This will clear the tree, and prevent another visitor from clobbering
 //  user2.  When the member goes out of scope it will be automagically
 //  freed up.
+//
+//  The in-use state is per thread, so independent parts of the tree
+//  (e.g. different modules) may be processed concurrently, each with its
+//  own user#().  Counts are unique over all threads, so a value set
+//  under one thread never appears set under another.  Jobs submitted with
+//  V3ThreadScope start with the state of the submitting thread, so may
+//  use the user#() it has in use.
 
 class VNUserInUseBase VL_NOT_FINAL {
+public:
+    // user#() state of a thread
+    struct ThreadState final {
+        uint32_t m_cnt[4];
+        bool m_busy[4];
+    };
+    // Get state of current thread
+    static ThreadState threadState() VL_MT_SAFE;
+    // Set state of current thread, e.g. to that of another thread submitting a job
+    static void threadState(const ThreadState& state) VL_MT_SAFE;
+
 protected:
+    static std::atomic<uint32_t> s_userCntNext;  // Next count to use, over all threads
     static void allocate(int id, uint32_t& cntGblRef, bool& userBusyRef) {
         // Perhaps there's still a AstUserInUse in scope for this?
         UASSERT_STATIC(!userBusyRef, "Conflicting user use; AstUser" + cvtToStr(id)
@@ -1786,7 +1841,7 @@ protected:
         UASSERT_STATIC(userBusyRef, "Clear of User" + cvtToStr(id) + "() not under AstUserInUse");
         // If this really fires and is real (after 2^32 edits???)
         // we could just walk the tree and clear manually
-        ++cntGblRef;
+        cntGblRef = s_userCntNext.fetch_add(1, std::memory_order_relaxed) + 1;
         UASSERT_STATIC(cntGblRef, "User*() overflowed!");
     }
     static void checkcnt(int id, uint32_t&, const bool& userBusyRef) {
@@ -1802,8 +1857,9 @@ protected:
 class VNUser1InUse final : VNUserInUseBase {
 protected:
     friend class AstNode;
-    static uint32_t s_userCntGbl;  // Count of which usage of userp() this is
-    static bool s_userBusy;  // Count is in use
+    friend class VNUserInUseBase;
+    static thread_local uint32_t s_userCntGbl;  // Count of which usage of userp() this is
+    static thread_local bool s_userBusy;  // Count is in use
 public:
     VNUser1InUse()      { allocate(1, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
     ~VNUser1InUse()     { free    (1, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
@@ -1813,8 +1869,9 @@ public:
 class VNUser2InUse final : VNUserInUseBase {
 protected:
     friend class AstNode;
-    static uint32_t s_userCntGbl;  // Count of which usage of userp() this is
-    static bool s_userBusy;  // Count is in use
+    friend class VNUserInUseBase;
+    static thread_local uint32_t s_userCntGbl;  // Count of which usage of userp() this is
+    static thread_local bool s_userBusy;  // Count is in use
 public:
     VNUser2InUse()      { allocate(2, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
     ~VNUser2InUse()     { free    (2, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
@@ -1824,8 +1881,9 @@ public:
 class VNUser3InUse final : VNUserInUseBase {
 protected:
     friend class AstNode;
-    static uint32_t s_userCntGbl;  // Count of which usage of userp() this is
-    static bool s_userBusy;  // Count is in use
+    friend class VNUserInUseBase;
+    static thread_local uint32_t s_userCntGbl;  // Count of which usage of userp() this is
+    static thread_local bool s_userBusy;  // Count is in use
 public:
     VNUser3InUse()      { allocate(3, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
     ~VNUser3InUse()     { free    (3, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
@@ -1835,8 +1893,9 @@ public:
 class VNUser4InUse final : VNUserInUseBase {
 protected:
     friend class AstNode;
-    static uint32_t s_userCntGbl;  // Count of which usage of userp() this is
-    static bool s_userBusy;  // Count is in use
+    friend class VNUserInUseBase;
+    static thread_local uint32_t s_userCntGbl;  // Count of which usage of userp() this is
+    static thread_local bool s_userBusy;  // Count is in use
 public:
     VNUser4InUse()      { allocate(4, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
     ~VNUser4InUse()     { free    (4, s_userCntGbl/*ref*/, s_userBusy/*ref*/); }
@@ -2004,8 +2063,9 @@ class AstNode VL_NOT_FINAL {
         bool didWidth : 1;  // Did V3Width computation
         bool doingWidth : 1;  // Inside V3Width
         bool protect : 1;  // Protect name if protection is on
+        bool brokenDirty : 1;  // Created or edited since the last V3Broken check
         // Space for more flags here (there must be 8 bits in total)
-        uint8_t unused : 5;
+        uint8_t unused : 4;
     } m_flags;  // Attribute flags
 
     // State variable used by V3Broken for consistency checking. The top bit of this is byte is a
@@ -2035,7 +2095,8 @@ class AstNode VL_NOT_FINAL {
     static uint64_t s_editCntLast;  // Last committed value of global edit counter
 
     AstNode* m_clonep = nullptr;  // Pointer to clone/source of node (only for *LAST* cloneTree())
-    static int s_cloneCntGbl;  // Count of which userp is set
+    static thread_local int s_cloneCntGbl;  // Count of which userp is set
+    static std::atomic<int> s_cloneCntNext;  // Next count to use, over all threads
 
     // This member ordering both allows 64 bit alignment and puts associated data together
     VNUser m_user1u{0};  // Contains any information the user iteration routine wants
@@ -2118,7 +2179,7 @@ protected:
         m_cloneCnt = s_cloneCntGbl;
     }
     static void cloneClearTree() {
-        s_cloneCntGbl++;
+        s_cloneCntGbl = s_cloneCntNext.fetch_add(1, std::memory_order_relaxed) + 1;
         UASSERT_STATIC(s_cloneCntGbl, "Rollover");
     }
 
@@ -2153,6 +2214,8 @@ public:
     }
     uint8_t brokenState() const VL_MT_SAFE { return m_brokenState; }
     void brokenState(uint8_t value) { m_brokenState = value; }
+    bool brokenDirty() const { return m_flags.brokenDirty; }
+    void brokenDirty(bool flag) { m_flags.brokenDirty = flag; }
 
     // Used by AstNode::broken()
     bool brokeExists() const { return V3Broken::isLinkable(this); }
@@ -2165,6 +2228,8 @@ public:
 #ifdef VL_LEAK_CHECKS
     static void* operator new(size_t size);
     static void operator delete(void* obj, size_t size);
+#else
+    VL_ARENA_OPERATORS
 #endif
 
     // CONSTANTS
@@ -2301,10 +2366,14 @@ public:
     uint64_t editCount() const { return m_editCount; }
     void editCountInc() {
         m_editCount = ++s_editCntGbl;  // Preincrement, so can "watch AstNode::s_editCntGbl=##"
+        m_flags.brokenDirty = true;
         VIsCached::clearCacheTree();  // Any edit clears all caching
     }
 #else
-    void editCountInc() { ++s_editCntGbl; }
+    void editCountInc() {
+        ++s_editCntGbl;
+        m_flags.brokenDirty = true;
+    }
 #endif
     static uint64_t editCountLast() VL_MT_SAFE { return s_editCntLast; }
     static uint64_t editCountGbl() VL_MT_SAFE { return s_editCntGbl; }
@@ -2457,6 +2526,8 @@ public:
     void dumpJsonGen(std::ostream& os) const {};
     virtual void dumpTreeJsonOpGen(std::ostream& os, const string& indent) const {};
     void dumpTreeJson(std::ostream& os, const string& indent = "") const;
+    // Open this node's JSON object and dump its fields, but not its children
+    void dumpTreeJsonHead(std::ostream& os, const string& indent = "") const;
     void dumpTreeJsonFile(const string& filename, bool doDump = true);
     static void dumpJsonMetaFileGdb(const char* filename);
     static void dumpJsonMetaFile(const string& filename);
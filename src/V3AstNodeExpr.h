@@ -4381,10 +4381,13 @@ public:
 };
 class AstCNew final : public AstNodeCCall {
     // C++ new() call
+    bool m_noEscape = false;  // Only referenced from one variable, delete when released
 public:
     AstCNew(FileLine* fl, AstCFunc* funcp, AstNodeExpr* argsp = nullptr)
         : ASTGEN_SUPER_CNew(fl, funcp, argsp) {}
     ASTGEN_MEMBERS_AstCNew;
+    bool noEscape() const { return m_noEscape; }
+    void noEscape(bool flag) { m_noEscape = flag; }
 };
 
 // === AstNodeFTaskRef ===
@@ -4423,6 +4426,7 @@ class AstNew final : public AstNodeFTaskRef {
     // New as constructor
     // Don't need the class we are extracting from, as the "fromp()"'s datatype can get us to it
     bool m_isImplicit = false;  // Implicitly generated from extends args
+    bool m_noEscape = false;  // Only referenced from one variable, delete when released
 public:
     AstNew(FileLine* fl, AstNodeExpr* pinsp)
         : ASTGEN_SUPER_New(fl, "new", pinsp) {}
@@ -4431,6 +4435,8 @@ public:
     int instrCount() const override { return widthInstrs(); }
     bool isImplicit() const { return m_isImplicit; }
     void isImplicit(bool flag) { m_isImplicit = flag; }
+    bool noEscape() const { return m_noEscape; }
+    void noEscape(bool flag) { m_noEscape = flag; }
 };
 class AstTaskRef final : public AstNodeFTaskRef {
     // A reference to a task
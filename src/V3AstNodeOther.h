@@ -87,6 +87,7 @@ class AstNodeFTask VL_NOT_FINAL : public AstNode {
     bool m_virtual : 1;  // Virtual method in class
     bool m_needProcess : 1;  // Needs access to VlProcess of the caller
     VBaseOverride m_baseOverride;  // BaseOverride (inital/final/extends)
+    VDpiThreads m_dpiThreads;  // DPI import parallel calls attribute
     VLifetime m_lifetime;  // Default lifetime of local vars
     VIsCached m_purity;  // Pure state
 
@@ -168,6 +169,8 @@ public:
     void isHideProtected(bool flag) { m_isHideProtected = flag; }
     bool dpiPure() const { return m_dpiPure; }
     void dpiPure(bool flag) { m_dpiPure = flag; }
+    VDpiThreads dpiThreads() const { return m_dpiThreads; }
+    void dpiThreads(const VDpiThreads& flag) { m_dpiThreads = flag; }
     bool pureVirtual() const { return m_pureVirtual; }
     void pureVirtual(bool flag) { m_pureVirtual = flag; }
     bool recursive() const { return m_recursive; }
@@ -621,12 +624,15 @@ class AstCFunc final : public AstNode {
     string m_argTypes;  // Argument types
     string m_ifdef;  // #ifdef symbol around this function
     VBoolOrUnknown m_isConst;  // Function is declared const (*this not changed)
+    VDpiThreads m_dpiThreads;  // DPI import wrapper parallel calls attribute
     bool m_isStatic : 1;  // Function is static (no need for a 'this' pointer)
     bool m_isTrace : 1;  // Function is related to tracing
     bool m_dontCombine : 1;  // V3Combine shouldn't compare this func tree, it's special
     bool m_declPrivate : 1;  // Declare it private
     bool m_keepIfEmpty : 1;  // Keep declaration and definition separate, even if empty
     bool m_slow : 1;  // Slow routine, called once or just at init time
+    bool m_cold : 1;  // Rarely executed according to profile data, emitted as if slow
+    bool m_hot : 1;  // Executed on every evaluation, or hot according to profile data
     bool m_funcPublic : 1;  // From user public task/function
     bool m_isConstructor : 1;  // Is C class constructor
     bool m_isDestructor : 1;  // Is C class destructor
@@ -658,6 +664,8 @@ public:
         m_declPrivate = false;
         m_keepIfEmpty = false;
         m_slow = false;
+        m_cold = false;
+        m_hot = false;
         m_funcPublic = false;
         m_isConstructor = false;
         m_isDestructor = false;
@@ -705,13 +713,19 @@ public:
     void rtnType(const string& rtnType) { m_rtnType = rtnType; }
     bool dontCombine() const { return m_dontCombine || isTrace() || entryPoint(); }
     void dontCombine(bool flag) { m_dontCombine = flag; }
-    bool dontInline() const { return dontCombine() || slow() || funcPublic(); }
+    bool dontInline() const { return dontCombine() || slow() || cold() || funcPublic(); }
     bool declPrivate() const { return m_declPrivate; }
     void declPrivate(bool flag) { m_declPrivate = flag; }
     bool keepIfEmpty() const VL_MT_SAFE { return m_keepIfEmpty; }
     void keepIfEmpty(bool flag) { m_keepIfEmpty = flag; }
     bool slow() const VL_MT_SAFE { return m_slow; }
     void slow(bool flag) { m_slow = flag; }
+    bool cold() const VL_MT_SAFE { return m_cold; }
+    void cold(bool flag) { m_cold = flag; }
+    // Emit into the __Slow files with VL_ATTR_COLD
+    bool emitSlow() const VL_MT_SAFE { return m_slow || m_cold; }
+    bool hot() const VL_MT_SAFE { return m_hot; }
+    void hot(bool flag) { m_hot = flag; }
     bool funcPublic() const { return m_funcPublic; }
     void funcPublic(bool flag) { m_funcPublic = flag; }
     void argTypes(const string& str) { m_argTypes = str; }
@@ -739,6 +753,8 @@ public:
     void dpiPure(bool flag) { m_dpiPure = flag; }
     bool dpiContext() const { return m_dpiContext; }
     void dpiContext(bool flag) { m_dpiContext = flag; }
+    VDpiThreads dpiThreads() const { return m_dpiThreads; }
+    void dpiThreads(const VDpiThreads& flag) { m_dpiThreads = flag; }
     bool dpiExportDispatcher() const VL_MT_SAFE { return m_dpiExportDispatcher; }
     void dpiExportDispatcher(bool flag) { m_dpiExportDispatcher = flag; }
     bool dpiExportImpl() const { return m_dpiExportImpl; }
@@ -1319,6 +1335,7 @@ class AstNetlist final : public AstNode {
     // @astgen ptr := m_evalNbap : Optional[AstCFunc]  // The '_eval__nba' function
     // @astgen ptr := m_dpiExportTriggerp : Optional[AstVarScope]  // DPI export trigger variable
     // @astgen ptr := m_delaySchedulerp : Optional[AstVar]  // Delay scheduler variable
+    // @astgen ptr := m_icoSkipp : Optional[AstVar]  // evalClock 'ico' skip flag variable
     // @astgen ptr := m_nbaEventp : Optional[AstVarScope]  // NBA event variable
     // @astgen ptr := m_nbaEventTriggerp : Optional[AstVarScope]  // NBA event trigger
     // @astgen ptr := m_topScopep : Optional[AstTopScope]  // Singleton AstTopScope
@@ -1347,6 +1364,8 @@ public:
     void dpiExportTriggerp(AstVarScope* varScopep) { m_dpiExportTriggerp = varScopep; }
     AstVar* delaySchedulerp() const { return m_delaySchedulerp; }
     void delaySchedulerp(AstVar* const varScopep) { m_delaySchedulerp = varScopep; }
+    AstVar* icoSkipp() const { return m_icoSkipp; }
+    void icoSkipp(AstVar* const varp) { m_icoSkipp = varp; }
     AstVarScope* nbaEventp() const { return m_nbaEventp; }
     void nbaEventp(AstVarScope* const varScopep) { m_nbaEventp = varScopep; }
     AstVarScope* nbaEventTriggerp() const { return m_nbaEventTriggerp; }
@@ -1733,6 +1752,8 @@ public:
     AstQueueDType* findQueueIndexDType(FileLine* fl);
     AstStreamDType* findStreamDType(FileLine* fl);
     AstVoidDType* findVoidDType(FileLine* fl);
+    // As addTypesp, but may be used while other threads look up basic types
+    void addTypespLocked(AstNodeDType* nodep);
     void clearCache();
     void repairCache();
     void dump(std::ostream& str = std::cout) const override;
@@ -1909,6 +1930,8 @@ class AstVar final : public AstNode {
     bool m_isWrittenBySuspendable : 1;  // This variable can be written by a suspendable process
     bool m_ignorePostWrite : 1;  // Ignore writes in 'Post' blocks during ordering
     bool m_ignoreSchedWrite : 1;  // Ignore writes in scheduling (for coverage increments)
+    bool m_alignCacheLine : 1;  // Start on a new cache line, to avoid false sharing
+    bool m_alignPage : 1;  // Start on a new memory page, for NUMA placement
 
     void init() {
         m_ansi = false;
@@ -1955,6 +1978,8 @@ class AstVar final : public AstNode {
         m_isWrittenBySuspendable = false;
         m_ignorePostWrite = false;
         m_ignoreSchedWrite = false;
+        m_alignCacheLine = false;
+        m_alignPage = false;
         m_attrClocker = VVarAttrClocker::CLOCKER_UNKNOWN;
     }
 
@@ -2114,6 +2139,10 @@ public:
     void setIgnorePostWrite() { m_ignorePostWrite = true; }
     bool ignoreSchedWrite() const { return m_ignoreSchedWrite; }
     void setIgnoreSchedWrite() { m_ignoreSchedWrite = true; }
+    bool alignCacheLine() const { return m_alignCacheLine; }
+    void setAlignCacheLine() { m_alignCacheLine = true; }
+    bool alignPage() const { return m_alignPage; }
+    void setAlignPage() { m_alignPage = true; }
 
     // METHODS
     void name(const string& name) override { m_name = name; }
@@ -2944,6 +2973,11 @@ public:
 };
 class AstCoverInc final : public AstNodeStmt {
     // Coverage analysis point; increment coverage count
+    // With toggledp, increment the count of each bit set in toggledp, bit N's point
+    // being the Nth consecutive AstCoverDecl starting at declp.  Set by V3Clock for
+    // toggle coverage, and by V3Coverage for the branches of expression coverage
+    //
+    // @astgen op1 := toggledp : Optional[AstNodeExpr]  // Toggled or matched bits
     //
     // @astgen ptr := m_declp : AstCoverDecl  // [After V3CoverageJoin] Declaration
 public:
@@ -2966,19 +3000,27 @@ public:
 class AstCoverToggle final : public AstNodeStmt {
     // Toggle analysis of given signal
     // Parents:  MODULE
+    // With points() > 1, each bit of origp has its own point, the AstCoverDecls
+    // of the bits being consecutive starting at incp's declaration
     // @astgen op1 := incp : AstCoverInc
     // @astgen op2 := origp : AstNodeExpr
     // @astgen op3 := changep : AstNodeExpr
+    uint32_t m_points;  // Number of points, 1 for whole origp, or one per bit of origp
 public:
-    AstCoverToggle(FileLine* fl, AstCoverInc* incp, AstNodeExpr* origp, AstNodeExpr* changep)
-        : ASTGEN_SUPER_CoverToggle(fl) {
+    AstCoverToggle(FileLine* fl, AstCoverInc* incp, AstNodeExpr* origp, AstNodeExpr* changep,
+                   uint32_t points = 1)
+        : ASTGEN_SUPER_CoverToggle(fl)
+        , m_points{points} {
         this->incp(incp);
         this->origp(origp);
         this->changep(changep);
     }
     ASTGEN_MEMBERS_AstCoverToggle;
+    uint32_t points() const { return m_points; }
     int instrCount() const override { return 3 + INSTR_COUNT_BRANCH + INSTR_COUNT_LD; }
-    bool sameNode(const AstNode* /*samep*/) const override { return true; }
+    bool sameNode(const AstNode* samep) const override {
+        return points() == VN_DBG_AS(samep, CoverToggle)->points();
+    }
     bool isGateOptimizable() const override { return false; }
     bool isPredictOptimizable() const override { return true; }
     bool isOutputter() override {
@@ -894,7 +894,8 @@ AstNodeDType::CTypeRecursed AstNodeDType::cTypeRecurse(bool compound, bool packe
         UASSERT_OBJ(!packed, this, "Unsupported type for packed struct or union");
         const CTypeRecursed key = adtypep->keyDTypep()->cTypeRecurse(true, false);
         const CTypeRecursed val = adtypep->subDTypep()->cTypeRecurse(true, false);
-        info.m_type = "VlAssocArray<" + key.m_type + ", " + val.m_type + ">";
+        info.m_type = (adtypep->unordered() ? "VlUnorderedAssocArray<" : "VlAssocArray<")
+                      + key.m_type + ", " + val.m_type + ">";
     } else if (const auto* const adtypep = VN_CAST(dtypep, CDType)) {
         UASSERT_OBJ(!packed, this, "Unsupported type for packed struct or union");
         info.m_type = adtypep->name();
@@ -927,7 +928,7 @@ AstNodeDType::CTypeRecursed AstNodeDType::cTypeRecurse(bool compound, bool packe
         UASSERT_OBJ(!packed, this, "Unsupported type for packed struct or union");
         if (adtypep->isCompound()) compound = true;
         const CTypeRecursed sub = adtypep->subDTypep()->cTypeRecurse(compound, false);
-        info.m_type = "VlUnpacked<" + sub.m_type;
+        info.m_type = (adtypep->isSparse() ? "VlSparseUnpacked<" : "VlUnpacked<") + sub.m_type;
         info.m_type += ", " + cvtToStr(adtypep->declRange().elements());
         info.m_type += ">";
     } else if (const auto* const adtypep = VN_CAST(dtypep, NBACommitQueueDType)) {
@@ -1229,6 +1230,10 @@ bool AstSenTree::hasHybrid() const {
     return false;
 }
 
+// Protects the basic type lookups, which passes running on multiple
+// threads may use to create new data types
+static V3Mutex s_typeTableMutex;
+
 AstTypeTable::AstTypeTable(FileLine* fl)
     : ASTGEN_SUPER_TypeTable(fl) {
     for (int i = 0; i < VBasicDTypeKwd::_ENUM_MAX; ++i) m_basicps[i] = nullptr;
@@ -1296,7 +1301,13 @@ AstVoidDType* AstTypeTable::findVoidDType(FileLine* fl) {
     return m_voidp;
 }
 
+void AstTypeTable::addTypespLocked(AstNodeDType* nodep) {
+    const V3LockGuard lock{s_typeTableMutex};
+    addTypesp(nodep);
+}
+
 AstBasicDType* AstTypeTable::findBasicDType(FileLine* fl, VBasicDTypeKwd kwd) {
+    const V3LockGuard lock{s_typeTableMutex};
     if (m_basicps[kwd]) return m_basicps[kwd];
     //
     AstBasicDType* const new1p = new AstBasicDType{fl, kwd};
@@ -1316,6 +1327,7 @@ AstBasicDType* AstTypeTable::findBasicDType(FileLine* fl, VBasicDTypeKwd kwd) {
 
 AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, VBasicDTypeKwd kwd, int width,
                                                int widthMin, VSigning numeric) {
+    const V3LockGuard lock{s_typeTableMutex};
     AstBasicDType* const new1p = new AstBasicDType{fl, kwd, numeric, width, widthMin};
     AstBasicDType* const newp = findInsertSameDType(new1p);
     if (newp != new1p) {
@@ -1329,6 +1341,7 @@ AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, VBasicDTypeKwd kwd,
 AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, VBasicDTypeKwd kwd,
                                                const VNumRange& range, int widthMin,
                                                VSigning numeric) {
+    const V3LockGuard lock{s_typeTableMutex};
     AstBasicDType* const new1p = new AstBasicDType{fl, kwd, numeric, range, widthMin};
     AstBasicDType* const newp = findInsertSameDType(new1p);
     if (newp != new1p) {
@@ -1574,6 +1587,12 @@ static void dumpFileInfo(std::ostream& os, const FileLine* fileinfop) {
 }
 
 void AstNode::dumpTreeJson(std::ostream& os, const string& indent) const {
+    dumpTreeJsonHead(os, indent);
+    dumpTreeJsonOpGen(os, indent);
+    os << "}";
+}
+
+void AstNode::dumpTreeJsonHead(std::ostream& os, const string& indent) const {
     os << indent << "{\"type\":\"" << typeName() << '"';
     dumpJsonStr(os, "name", V3OutFormatter::quoteNameControls(prettyName()));
     dumpJsonPtr(os, "addr", this);
@@ -1589,8 +1608,6 @@ void AstNode::dumpTreeJson(std::ostream& os, const string& indent) const {
         }
     }
     dumpJson(os);
-    dumpTreeJsonOpGen(os, indent);
-    os << "}";
 }
 
 void AstNodeProcedure::dump(std::ostream& str) const {
@@ -2230,6 +2247,9 @@ void AstNodeArrayDType::dumpSmall(std::ostream& str) const {
 void AstNodeArrayDType::dump(std::ostream& str) const {
     this->AstNodeDType::dump(str);
     if (isCompound()) str << " [COMPOUND]";
+    if (const AstUnpackArrayDType* const adtypep = VN_CAST(this, UnpackArrayDType)) {
+        if (adtypep->isSparse()) str << " [SPARSE]";
+    }
     str << " " << declRange();
 }
 void AstNodeArrayDType::dumpJson(std::ostream& str) const {
@@ -2412,6 +2432,7 @@ void AstTypeTable::dumpJson(std::ostream& str) const { dumpJsonGen(str); }
 void AstAssocArrayDType::dumpSmall(std::ostream& str) const {
     this->AstNodeDType::dumpSmall(str);
     str << "[assoc-" << nodeAddr(keyDTypep()) << "]";
+    if (unordered()) str << " [UNORDERED]";
 }
 string AstAssocArrayDType::prettyDTypeName(bool full) const {
     return subDTypep()->prettyDTypeName(full) + "$[" + keyDTypep()->prettyDTypeName(full) + "]";
@@ -2585,6 +2606,8 @@ void AstVar::dump(std::ostream& str) const {
     if (isDpiOpenArray()) str << " [DPIOPENA]";
     if (ignorePostWrite()) str << " [IGNPWR]";
     if (ignoreSchedWrite()) str << " [IGNWR]";
+    if (alignCacheLine()) str << " [CLALIGN]";
+    if (alignPage()) str << " [PGALIGN]";
     if (!attrClocker().unknown()) str << " [" << attrClocker().ascii() << "] ";
     if (!lifetime().isNone()) str << " [" << lifetime().ascii() << "] ";
     str << " " << varType();
@@ -2930,6 +2953,8 @@ void AstCFile::dumpJson(std::ostream& str) const {
 void AstCFunc::dump(std::ostream& str) const {
     this->AstNode::dump(str);
     if (slow()) str << " [SLOW]";
+    if (cold()) str << " [COLD]";
+    if (hot()) str << " [HOT]";
     if (isStatic()) str << " [STATIC]";
     if (dpiContext()) str << " [DPICTX]";
     if (dpiExportDispatcher()) str << " [DPIED]";
@@ -2937,6 +2962,7 @@ void AstCFunc::dump(std::ostream& str) const {
     if (dpiImportPrototype()) str << " [DPIIP]";
     if (dpiImportWrapper()) str << " [DPIIW]";
     if (dpiPure()) str << " [DPIPURE]";
+    if (dpiThreads() != VDpiThreads::DEFAULT) str << " [DPITHREADS_" << dpiThreads() << "]";
     if (isConstructor()) str << " [CTOR]";
     if (isDestructor()) str << " [DTOR]";
     if (isMethod()) str << " [METHOD]";
@@ -3000,6 +3026,7 @@ void AstCMethodHard::setPurity() {
                                                           {"erase", false},
                                                           {"evaluate", false},
                                                           {"evaluation", false},
+                                                          {"eventFired", false},
                                                           {"exists", true},
                                                           {"find", true},
                                                           {"find_first", true},
@@ -3021,6 +3048,8 @@ void AstCMethodHard::setPurity() {
                                                           {"min", true},
                                                           {"neq", true},
                                                           {"next", false},
+                                                          {"periodic", false},
+                                                          {"periodicTriggered", false},
                                                           {"pop", false},
                                                           {"pop_back", false},
                                                           {"pop_front", false},
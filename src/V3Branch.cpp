@@ -21,14 +21,81 @@
 //         Count calls into the function
 //      Then, if FTASK is called only once, add inline attribute
 //
+//      With profile_data -branch records, predict each IF from how often
+//      conditionals at the same source location were taken.
+//      With --prof-pgo-branches, count the outcome of each IF instead.
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
 
 #include "V3Branch.h"
 
+#include "V3Config.h"
+
+#include <unordered_map>
+
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+// Minimum profiled executions of a conditional for its profile data to be used
+constexpr uint64_t PROFILE_MIN = 16;
+// Minimum fraction of executions going the same way for a conditional to be predicted
+constexpr double PROFILE_BIAS = 0.9;
+
+static std::vector<std::string>& profileLocationsRef() {
+    static std::vector<std::string> s_locations;
+    return s_locations;
+}
+
+//######################################################################
+// Instrument conditionals for --prof-pgo-branches
+
+class BranchProfileVisitor final : public VNVisitor {
+    // STATE
+    std::unordered_map<string, size_t> m_ids;  // Location -> branch number
+
+    // METHODS
+    size_t branchId(const FileLine* flp) {
+        const string location = V3Branch::profileLocation(flp);
+        const auto pair = m_ids.emplace(location, m_ids.size());
+        if (pair.second) profileLocationsRef().push_back(location);
+        return pair.first->second;
+    }
+    static AstCStmt* newCount(FileLine* flp, size_t counter) {
+        return new AstCStmt{flp, "vlSymsp->_vm_pgoBranches.count(" + cvtToStr(counter) + ");\n"};
+    }
+
+    // VISITORS
+    void visit(AstNodeIf* nodep) override {
+        iterateChildren(nodep);
+        FileLine* const flp = nodep->fileline();
+        const size_t id = branchId(flp);
+        if (AstNode* const thensp = nodep->thensp()) {
+            thensp->addHereThisAsNext(newCount(flp, 2 * id));
+        } else {
+            nodep->addThensp(newCount(flp, 2 * id));
+        }
+        if (AstNode* const elsesp = nodep->elsesp()) {
+            elsesp->addHereThisAsNext(newCount(flp, 2 * id + 1));
+        } else {
+            nodep->addElsesp(newCount(flp, 2 * id + 1));
+        }
+    }
+    void visit(AstCFunc* nodep) override {
+        // Run once code is not worth predicting
+        if (nodep->slow()) return;
+        iterateChildren(nodep);
+    }
+    void visit(AstClass*) override {}  // Class methods have no symbol table
+    void visit(AstNodeExpr*) override {}  // Accelerate
+    void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit BranchProfileVisitor(AstNetlist* nodep) { iterate(nodep); }
+    ~BranchProfileVisitor() override = default;
+};
+
 //######################################################################
 // Branch state, as a visitor of each AstNode
 
@@ -81,6 +148,9 @@ class BranchVisitor final : public VNVisitorConst {
             } else if (likeness < 0) {
                 nodep->branchPred(VBranchPred::BP_UNLIKELY);
             }  // else leave unknown
+            // Measured outcomes take precedence over the heuristics
+            const VBranchPred profPred = V3Branch::profilePred(nodep->fileline());
+            if (!profPred.unknown()) nodep->branchPred(profPred);
         }
     }
     void visit(AstNodeCCall* nodep) override {
@@ -120,5 +190,30 @@ public:
 
 void V3Branch::branchAll(AstNetlist* nodep) {
     UINFO(2, __FUNCTION__ << ": " << endl);
+    if (v3Global.opt.profPgoBranches()) { BranchProfileVisitor{nodep}; }
     { BranchVisitor{nodep}; }
 }
+
+std::string V3Branch::profileLocation(const FileLine* flp) {
+    return flp->filename() + ":" + cvtToStr(flp->firstLineno()) + ":"
+           + cvtToStr(flp->firstColumn());
+}
+
+double V3Branch::profileTakenFraction(const FileLine* flp) {
+    if (!V3Config::containsBranchProfileData()) return -1.0;
+    uint64_t taken = 0;
+    uint64_t notTaken = 0;
+    if (!V3Config::getProfileBranch(profileLocation(flp), taken, notTaken)) return -1.0;
+    if (taken + notTaken < PROFILE_MIN) return -1.0;
+    return static_cast<double>(taken) / static_cast<double>(taken + notTaken);
+}
+
+VBranchPred V3Branch::profilePred(const FileLine* flp) {
+    const double taken = profileTakenFraction(flp);
+    if (taken < 0.0) return VBranchPred::BP_UNKNOWN;
+    if (taken >= PROFILE_BIAS) return VBranchPred::BP_LIKELY;
+    if (taken <= 1.0 - PROFILE_BIAS) return VBranchPred::BP_UNLIKELY;
+    return VBranchPred::BP_UNKNOWN;
+}
+
+const std::vector<std::string>& V3Branch::profileLocations() { return profileLocationsRef(); }
@@ -20,7 +20,12 @@
 #include "config_build.h"
 #include "verilatedos.h"
 
+#include <string>
+#include <vector>
+
 class AstNetlist;
+class FileLine;
+class VBranchPred;
 
 //============================================================================
 
@@ -28,6 +33,16 @@ class V3Branch final {
 public:
     // CONSTRUCTORS
     static void branchAll(AstNetlist* nodep) VL_MT_DISABLED;
+
+    // Source location of a conditional, as used in profile_data -branch records
+    static std::string profileLocation(const FileLine* flp) VL_MT_DISABLED;
+    // Fraction of profiled executions that took the conditional at the given location,
+    // or negative if there is not enough profile data for it
+    static double profileTakenFraction(const FileLine* flp) VL_MT_DISABLED;
+    // Prediction for the conditional at the given location from profile data, if biased
+    static VBranchPred profilePred(const FileLine* flp) VL_MT_DISABLED;
+    // Locations of the conditionals instrumented by --prof-pgo-branches, by branch number
+    static const std::vector<std::string>& profileLocations() VL_MT_DISABLED;
 };
 
 #endif  // Guard
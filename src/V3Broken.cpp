@@ -55,6 +55,7 @@ public:
 } s_brokenCntGlobal;
 
 static bool s_brokenAllowMidvisitorCheck = false;
+static int s_brokenChecksSinceFull = 0;  // Incremental checks since the last full check
 
 //######################################################################
 // Table of allocated AstNode pointers
@@ -149,6 +150,9 @@ class BrokenCheckVisitor final : public VNVisitorConst {
     // Local variables declared in the scope of the current statement
     std::vector<std::unordered_set<const AstVar*>> m_localsStack;
 
+    // Check all nodes, not only those created or edited since the last check
+    const bool m_full;
+
     // STATE - for current visit position (use VL_RESTORER)
     const AstCFunc* m_cfuncp = nullptr;  // Current CFunc, if any
     bool m_inScope = false;  // Under AstScope
@@ -164,6 +168,8 @@ private:
 
     void processEnter(AstNode* nodep) {
         nodep->brokenState(m_brokenCntCurrentUnder);
+        if (!m_full && !nodep->brokenDirty()) return;
+        nodep->brokenDirty(false);
         const char* const whyp = nodep->brokenGen();
         UASSERT_OBJ(!whyp, nodep,
                     "Broken link in node (or something without maybePointedTo): " << whyp);
@@ -324,7 +330,10 @@ private:
 
 public:
     // CONSTRUCTORS
-    explicit BrokenCheckVisitor(AstNetlist* nodep) { iterateConstNull(nodep); }
+    BrokenCheckVisitor(AstNetlist* nodep, bool full)
+        : m_full{full} {
+        iterateConstNull(nodep);
+    }
     ~BrokenCheckVisitor() override = default;
 };
 
@@ -353,10 +362,18 @@ void V3Broken::brokenAll(AstNetlist* nodep) {
             nodep->brokenState(brokenCntCurrent);
         });
 
+        // With --debug-check-full, check in depth only the nodes created or edited since the
+        // previous check, except every Nth check. Links from unedited nodes to since deleted
+        // nodes, and leaks, are found by the next full check.
+        const int fullInterval = v3Global.opt.debugCheckFull();
+        const bool full = fullInterval <= 1 || ++s_brokenChecksSinceFull >= fullInterval;
+        if (full) s_brokenChecksSinceFull = 0;
+        UINFO(9, "Broken check " << (full ? "full" : "incremental") << endl);
+
         // Check every node in tree
-        const BrokenCheckVisitor cvisitor{nodep};
+        const BrokenCheckVisitor cvisitor{nodep, full};
 
-        s_allocTable.checkForLeaks();
+        if (full) s_allocTable.checkForLeaks();
         s_linkableTable.clear();
         s_brokenCntGlobal.inc();
         inBroken = false;
@@ -24,9 +24,11 @@
 //                                                  (other items))
 //                                              body
 //              Or, converts to a if/else tree.
+//          Wide cases with many constant items and no masking (e.g. state
+//          machines with wide or one-hot state encodings): sort the items by
+//          value and use a balanced tree of < compares, with == compares of a
+//          few items at each leaf.
 //      FUTURES:
-//          Large 16+ bit tables with constants and no masking (address muxes)
-//              Enter all into std::multimap, sort by value and use a tree of < and == compares.
 //          "Diagonal" find of {rightmost,leftmost} bit {set,clear}
 //              Ignoring mask, check each value is unique (using std::multimap as above?)
 //              Each branch is then mask-and-compare operation (IE
@@ -45,6 +47,8 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 #define CASE_OVERLAP_WIDTH 16  // Maximum width we can check for overlaps in
 #define CASE_BARF 999999  // Magic width when non-constant
 #define CASE_ENCODER_GROUP_DEPTH 8  // Levels of priority to be ORed together in top IF tree
+#define CASE_SEARCH_MIN_ITEMS 8  // Minimum number of values to use a search tree
+#define CASE_SEARCH_LEAF_ITEMS 4  // Maximum number of values compared in a search tree leaf
 
 //######################################################################
 
@@ -122,6 +126,7 @@ class CaseVisitor final : public VNVisitor {
     // STATE
     VDouble0 m_statCaseFast;  // Statistic tracking
     VDouble0 m_statCaseSlow;  // Statistic tracking
+    VDouble0 m_statCaseSearch;  // Statistic tracking
     const AstNode* m_alwaysp = nullptr;  // Always in which case is located
 
     // Per-CASE
@@ -130,6 +135,8 @@ class CaseVisitor final : public VNVisitor {
     bool m_caseNoOverlapsAllCovered = false;  // Proven to be synopsys parallel_case compliant
     // For each possible value, the case branch we need
     std::array<AstNode*, 1 << CASE_OVERLAP_WIDTH> m_valueItem;
+    // For search trees, the distinct item values in ascending order, with their case item
+    std::vector<std::pair<AstConst*, AstCaseItem*>> m_searchItems;
 
     // METHODS
     //! Determine whether we should check case items are complete
@@ -399,6 +406,101 @@ class CaseVisitor final : public VNVisitor {
         if (debug() >= 9) ifrootp->dumpTree("-    _simp: ");
     }
 
+    bool isCaseSearchable(AstCase* nodep) {
+        // All items must be distinct constants without wildcards, so they can be ordered
+        m_searchItems.clear();
+        const AstNodeExpr* const cexprp = nodep->exprp();
+        if (cexprp->isDouble() || cexprp->isString() || cexprp->width() <= 0) return false;
+        std::map<V3Number, AstCaseItem*> valueItems;
+        const AstCaseItem* defaultp = nullptr;
+        int origCount = 0;
+        for (AstCaseItem* itemp = nodep->itemsp(); itemp;
+             itemp = VN_AS(itemp->nextp(), CaseItem)) {
+            if (itemp->stmtsp()) origCount += itemp->stmtsp()->nodeCount();
+            if (itemp->isDefault()) defaultp = itemp;
+            for (AstNode* icondp = itemp->condsp(); icondp; icondp = icondp->nextp()) {
+                const AstConst* const iconstp = VN_CAST(icondp, Const);
+                if (!iconstp || iconstp->num().isFourState()) return false;
+                if (iconstp->width() != cexprp->width()) return false;
+                // Earlier items take priority
+                valueItems.emplace(iconstp->num(), itemp);
+            }
+        }
+        if (valueItems.size() < CASE_SEARCH_MIN_ITEMS) return false;
+        for (const auto& pair : valueItems) {
+            for (AstNode* icondp = pair.second->condsp(); icondp; icondp = icondp->nextp()) {
+                AstConst* const iconstp = VN_AS(icondp, Const);
+                if (iconstp->num().isCaseEq(pair.first)) {
+                    m_searchItems.emplace_back(iconstp, pair.second);
+                    break;
+                }
+            }
+        }
+        // Statements are cloned into each leaf, don't let the code grow out of control
+        const int defaultCount
+            = defaultp && defaultp->stmtsp() ? defaultp->stmtsp()->nodeCount() : 0;
+        int newCount = 0;
+        for (size_t lo = 0; lo < m_searchItems.size(); lo += CASE_SEARCH_LEAF_ITEMS) {
+            const size_t hi = std::min(lo + CASE_SEARCH_LEAF_ITEMS, m_searchItems.size());
+            for (size_t i = lo; i < hi; ++i) {
+                if (AstNode* const stmtsp = m_searchItems[i].second->stmtsp()) {
+                    newCount += stmtsp->nodeCount();
+                }
+            }
+            newCount += defaultCount;
+        }
+        return newCount <= 2 * origCount + 100;
+    }
+
+    AstNode* replaceCaseSearchRecurse(AstNodeExpr* cexprp, AstCaseItem* defaultp, size_t lo,
+                                      size_t hi) {
+        FileLine* const flp = cexprp->fileline();
+        if (hi - lo > CASE_SEARCH_LEAF_ITEMS) {
+            // Split at the middle value
+            const size_t mid = lo + (hi - lo) / 2;
+            AstNodeExpr* const condp
+                = new AstLt{flp, cexprp->cloneTreePure(false),
+                            m_searchItems[mid].first->cloneTree(false)};
+            AstNode* const lowerp = replaceCaseSearchRecurse(cexprp, defaultp, lo, mid);
+            AstNode* const upperp = replaceCaseSearchRecurse(cexprp, defaultp, mid, hi);
+            return new AstIf{flp, condp, lowerp, upperp};
+        }
+        // Compare each remaining value, falling through to the default
+        AstNode* resultp
+            = defaultp && defaultp->stmtsp() ? defaultp->stmtsp()->cloneTree(true) : nullptr;
+        for (size_t i = hi; i-- > lo;) {
+            AstConst* const iconstp = m_searchItems[i].first;
+            const AstCaseItem* const itemp = m_searchItems[i].second;
+            AstNodeExpr* const condp = AstEq::newTyped(
+                iconstp->fileline(), cexprp->cloneTreePure(false), iconstp->cloneTree(false));
+            AstNode* const stmtsp = itemp->stmtsp() ? itemp->stmtsp()->cloneTree(true) : nullptr;
+            resultp = new AstIf{itemp->fileline(), condp, stmtsp, resultp};
+        }
+        return resultp;
+    }
+
+    void replaceCaseSearch(AstCase* nodep) {
+        // CASE(cexpr, ITEM(c1, s1), ITEM(c2, s2), ..., ITEM(default, sd)), with c1 < c2 < ...
+        // ->  IF(cexpr < cmid, IF(cexpr == c1, s1, IF(cexpr == c2, s2, sd)), IF(...))
+        AstCaseItem* defaultp = nullptr;
+        for (AstCaseItem* itemp = nodep->itemsp(); itemp;
+             itemp = VN_AS(itemp->nextp(), CaseItem)) {
+            if (itemp->isDefault()) defaultp = itemp;
+        }
+        AstNode* const rootp
+            = replaceCaseSearchRecurse(nodep->exprp(), defaultp, 0, m_searchItems.size());
+        m_searchItems.clear();
+        // Handle any assertions
+        replaceCaseParallel(nodep, false);
+        if (debug() >= 9 && rootp) rootp->dumpTree("-     _search: ");
+        if (rootp) {
+            nodep->replaceWith(rootp);
+        } else {
+            nodep->unlinkFrBack();
+        }
+        VL_DO_DANGLING(nodep->deleteTree(), nodep);
+    }
+
     void replaceCaseComplicated(AstCase* nodep) {
         // CASEx(cexpr,ITEM(icond1,istmts1),ITEM(icond2,istmts2),ITEM(default,istmts3))
         // ->  IF((cexpr==icond1),istmts1,
@@ -569,6 +671,11 @@ class CaseVisitor final : public VNVisitor {
             // we can make a tree of statements to avoid extra comparisons
             ++m_statCaseFast;
             VL_DO_DANGLING(replaceCaseFast(nodep), nodep);
+        } else if (v3Global.opt.fCase() && isCaseSearchable(nodep)) {
+            // Many constant items, too wide for a tree over each bit. Use a binary search.
+            if (m_alwaysp) m_alwaysp->fileline()->warnOff(V3ErrorCode::LATCH, true);
+            ++m_statCaseSearch;
+            VL_DO_DANGLING(replaceCaseSearch(nodep), nodep);
         } else {
             // If a case statement is whole, presume signals involved aren't forming a latch
             if (m_alwaysp) m_alwaysp->fileline()->warnOff(V3ErrorCode::LATCH, true);
@@ -593,6 +700,7 @@ public:
     ~CaseVisitor() override {
         V3Stats::addStat("Optimizations, Cases parallelized", m_statCaseFast);
         V3Stats::addStat("Optimizations, Cases complex", m_statCaseSlow);
+        V3Stats::addStat("Optimizations, Cases search tree", m_statCaseSearch);
     }
 };
 
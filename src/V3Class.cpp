@@ -18,12 +18,17 @@
 // Each class:
 //      Move to be modules under AstNetlist
 //
+// Each 'new' assigned to a variable:
+//      If the variable's handle never escapes, and constructing never leaks 'this',
+//      mark the new so the object is deleted as soon as the variable releases it
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
 
 #include "V3Class.h"
 
+#include "V3Stats.h"
 #include "V3UniqueNames.h"
 
 #include <queue>
@@ -290,11 +295,91 @@ public:
     }
 };
 
+//######################################################################
+// Find class objects that are only ever referenced through one variable
+
+class ClassEscapeAnalysis final {
+    // NODE STATE
+    //  AstVar::user2()     -> bool.  Handle held in variable may escape
+    //  AstClass::user2()   -> int.  Constructing may leak 'this': 1 = no, 2 = yes (cached)
+    const VNUser2InUse m_inuser2;
+
+    // MEMBERS
+    VDouble0 m_statNoEscape;  // Statistic tracking
+
+    // METHODS
+    static bool isCandidate(const AstVar* varp) {
+        return VN_IS(varp->dtypep()->skipRefp(), ClassRefDType) && !varp->isIO()
+               && !varp->isFuncReturn() && !varp->isSigPublic() && !varp->isClassMember();
+    }
+    // True if the reference only reads or writes members, compares, or assigns a new object
+    static bool isNonEscapingUse(const AstNodeVarRef* refp) {
+        const AstNode* const abovep = refp->firstAbovep();
+        if (const AstMemberSel* const selp = VN_CAST(abovep, MemberSel)) {
+            return selp->fromp() == refp;
+        }
+        if (VN_IS(abovep, Eq) || VN_IS(abovep, Neq) || VN_IS(abovep, EqCase)
+            || VN_IS(abovep, NeqCase)) {
+            return true;
+        }
+        if (const AstAssign* const assignp = VN_CAST(abovep, Assign)) {
+            if (assignp->lhsp() != refp) return false;
+            if (VN_IS(assignp->rhsp(), New)) return true;
+            const AstConst* const constp = VN_CAST(assignp->rhsp(), Const);
+            return constp && constp->num().isNull();
+        }
+        return false;
+    }
+    // True if constructing an object of the class may let 'this' outlive the constructor.
+    // Anything stored or passed needs an explicit 'this', and any suspended process
+    // holds an implicit one.
+    static bool constructMayLeak(AstClass* classp) {
+        if (!classp->user2()) {
+            bool leaks = classp->exists([](const AstNode* nodep) {
+                return VN_IS(nodep, ThisRef) || VN_IS(nodep, Fork) || VN_IS(nodep, Delay)
+                       || VN_IS(nodep, EventControl) || VN_IS(nodep, Wait)
+                       || VN_IS(nodep, WaitFork);
+            });
+            for (const AstClassExtends* extp = classp->extendsp(); extp && !leaks;
+                 extp = VN_AS(extp->nextp(), ClassExtends)) {
+                leaks = constructMayLeak(extp->classp());
+            }
+            classp->user2(leaks ? 2 : 1);
+        }
+        return classp->user2() == 2;
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit ClassEscapeAnalysis(AstNetlist* nodep) {
+        nodep->foreach([](const AstNodeVarRef* refp) {
+            AstVar* const varp = refp->varp();
+            if (varp && isCandidate(varp) && !isNonEscapingUse(refp)) varp->user2(true);
+        });
+        nodep->foreach([this](AstNew* newp) {
+            const AstAssign* const assignp = VN_CAST(newp->firstAbovep(), Assign);
+            if (!assignp || assignp->rhsp() != newp) return;
+            const AstVarRef* const refp = VN_CAST(assignp->lhsp(), VarRef);
+            if (!refp || !isCandidate(refp->varp()) || refp->varp()->user2()) return;
+            const AstClassRefDType* const dtypep
+                = VN_CAST(newp->dtypep()->skipRefp(), ClassRefDType);
+            if (!dtypep || constructMayLeak(dtypep->classp())) return;
+            UINFO(9, "Non-escaping new " << newp << endl);
+            newp->noEscape(true);
+            ++m_statNoEscape;
+        });
+    }
+    ~ClassEscapeAnalysis() {
+        V3Stats::addStat("Optimizations, Classes non-escaping new", m_statNoEscape);
+    }
+};
+
 //######################################################################
 // Class class functions
 
 void V3Class::classAll(AstNetlist* nodep) {
     UINFO(2, __FUNCTION__ << ": " << endl);
+    { ClassEscapeAnalysis{nodep}; }
     { ClassVisitor{nodep}; }  // Destruct before checking
     V3Global::dumpCheckGlobalTree("class", 0, dumpTreeEitherLevel() >= 3);
 }
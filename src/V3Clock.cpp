@@ -24,6 +24,8 @@
 //                      Set the __Vlast_{clock} at the end of the block
 //              Replace UNTILSTABLEs with loops until specified signals become const.
 //   Create global calling function for any per-scope functions.  (For FINALs).
+//   Put runs of IFs testing bits of the same trigger word under an IF of the word.
+//   Call functions made only of trigger IFs only if any of their triggers are set.
 //
 //*************************************************************************
 
@@ -67,6 +69,14 @@ public:
 // Clock state, as a visitor of each AstNode
 
 class ClockVisitor final : public VNVisitor {
+    // CONSTANTS
+    static constexpr size_t GUARD_MIN_IFS = 4;  // Minimum run of trigger word IFs to guard
+    static constexpr size_t GUARD_MAX_WORDS = 4;  // Maximum trigger words tested to guard a call
+
+    // TYPES
+    // Trigger vector words, as the 'word' call reading them, and the mask of bits tested
+    using TriggerMasks = std::vector<std::pair<AstCMethodHard*, uint64_t>>;
+
     // NODE STATE
     // STATE
     AstCFunc* m_evalp = nullptr;  // The '_eval' function
@@ -94,12 +104,119 @@ class ClockVisitor final : public VNVisitor {
         m_lastSenp = nullptr;
         m_lastIfp = nullptr;
     }
+    // Is this a 'word' call reading a constant word of a trigger vector?
+    static bool isTriggerWord(const AstCMethodHard* callp) {
+        if (!callp || callp->name() != "word" || !VN_IS(callp->pinsp(), Const)) return false;
+        const AstBasicDType* const basicp = callp->fromp()->dtypep()->basicp();
+        return basicp && basicp->isTriggerVec();
+    }
+    // If the condition only tests bits of a single word of a trigger vector, return the
+    // 'word' call reading it, else nullptr
+    static AstCMethodHard* triggerWordp(AstNodeExpr* condp) {
+        if (AstOr* const orp = VN_CAST(condp, Or)) {
+            AstCMethodHard* const lhsp = triggerWordp(orp->lhsp());
+            AstCMethodHard* const rhsp = triggerWordp(orp->rhsp());
+            return lhsp && rhsp && lhsp->sameTree(rhsp) ? lhsp : nullptr;
+        }
+        AstAnd* const andp = VN_CAST(condp, And);
+        if (!andp || !VN_IS(andp->lhsp(), Const)) return nullptr;
+        AstCMethodHard* const callp = VN_CAST(andp->rhsp(), CMethodHard);
+        return isTriggerWord(callp) ? callp : nullptr;
+    }
+    // Add the trigger bits tested by the condition to 'masks', return false if the condition
+    // tests anything else
+    static bool addTriggerMasks(AstNodeExpr* condp, TriggerMasks& masks) {
+        if (AstOr* const orp = VN_CAST(condp, Or)) {
+            return addTriggerMasks(orp->lhsp(), masks) && addTriggerMasks(orp->rhsp(), masks);
+        }
+        uint64_t mask = ~0ULL;  // A whole word, as tested by guardTriggerWords
+        AstCMethodHard* wordp = VN_CAST(condp, CMethodHard);
+        if (AstAnd* const andp = VN_CAST(condp, And)) {
+            const AstConst* const constp = VN_CAST(andp->lhsp(), Const);
+            if (!constp) return false;
+            mask = constp->toUQuad();
+            wordp = VN_CAST(andp->rhsp(), CMethodHard);
+        }
+        if (!isTriggerWord(wordp)) return false;
+        for (auto& pair : masks) {
+            if (!pair.first->sameTree(wordp)) continue;
+            pair.second |= mask;
+            return true;
+        }
+        masks.emplace_back(wordp, mask);
+        return true;
+    }
+    // Put each run of IFs testing bits of the same trigger word under an IF testing the
+    // whole word, so regions with few triggers set skip most of the tests
+    static void guardTriggerWords(AstNode* stmtsp) {
+        for (AstNode* nodep = stmtsp; nodep;) {
+            AstIf* const ifp = VN_CAST(nodep, If);
+            AstCMethodHard* const wordp = ifp && !ifp->elsesp() ? triggerWordp(ifp->condp())
+                                                                : nullptr;
+            if (!wordp) {
+                nodep = nodep->nextp();
+                continue;
+            }
+            std::vector<AstIf*> runps{ifp};
+            for (AstNode* nextp = nodep->nextp(); nextp; nextp = nextp->nextp()) {
+                AstIf* const nextIfp = VN_CAST(nextp, If);
+                if (!nextIfp || nextIfp->elsesp()) break;
+                AstCMethodHard* const nextWordp = triggerWordp(nextIfp->condp());
+                if (!nextWordp || !nextWordp->sameTree(wordp)) break;
+                runps.push_back(nextIfp);
+            }
+            nodep = runps.back()->nextp();
+            if (runps.size() < GUARD_MIN_IFS) continue;
+            AstIf* const guardp = new AstIf{ifp->fileline(), wordp->cloneTree(false)};
+            ifp->addHereThisAsNext(guardp);
+            for (AstIf* const runp : runps) guardp->addThensp(runp->unlinkFrBack());
+        }
+    }
+    // When all statements of a function are IFs testing trigger bits, put each call of the
+    // function under an IF testing all those bits. The pieces of a region's function split by
+    // --output-split-cfuncs are then only called when some of their logic is triggered.
+    static void guardTriggeredCalls(AstNetlist* netlistp) {
+        std::unordered_map<const AstCFunc*, TriggerMasks> funcMasks;
+        netlistp->foreach([&](AstCFunc* funcp) {
+            if (!funcp->stmtsp() || funcp->initsp() || funcp->finalsp()) return;
+            TriggerMasks masks;
+            for (AstNode* stmtp = funcp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+                AstIf* const ifp = VN_CAST(stmtp, If);
+                if (!ifp || ifp->elsesp() || !addTriggerMasks(ifp->condp(), masks)) return;
+            }
+            if (masks.size() <= GUARD_MAX_WORDS) funcMasks.emplace(funcp, std::move(masks));
+        });
+        if (funcMasks.empty()) return;
+        std::vector<AstStmtExpr*> callps;
+        netlistp->foreach([&](AstStmtExpr* stmtp) {
+            const AstCCall* const callp = VN_CAST(stmtp->exprp(), CCall);
+            if (callp && funcMasks.count(callp->funcp())) callps.push_back(stmtp);
+        });
+        for (AstStmtExpr* const stmtp : callps) {
+            FileLine* const flp = stmtp->fileline();
+            AstNodeExpr* condp = nullptr;
+            for (const auto& pair : funcMasks.at(VN_AS(stmtp->exprp(), CCall)->funcp())) {
+                AstNodeExpr* termp = pair.first->cloneTree(false);
+                if (pair.second != ~0ULL) {
+                    termp = new AstAnd{flp, new AstConst{flp, AstConst::Unsized64{}, pair.second},
+                                       termp};
+                }
+                condp = condp ? new AstOr{flp, condp, termp} : termp;
+            }
+            VNRelinker relinker;
+            stmtp->unlinkFrBack(&relinker);
+            relinker.relink(new AstIf{flp, condp, stmtp});
+        }
+    }
+
     // VISITORS
     void visit(AstCoverToggle* nodep) override {
         // nodep->dumpTree("-  ct: ");
         // COVERTOGGLE(INC, ORIG, CHANGE) ->
         //   IF(ORIG ^ CHANGE) { INC; CHANGE = ORIG; }
-        AstNode* const incp = nodep->incp()->unlinkFrBack();
+        // With a point per bit, or saturating, INC gets the toggled bits:
+        //   IF(ORIG ^ CHANGE) { INC(ORIG ^ CHANGE); CHANGE = ORIG; }
+        AstCoverInc* const incp = nodep->incp()->unlinkFrBack();
         AstNodeExpr* const origp = nodep->origp()->unlinkFrBack();
         AstNodeExpr* const changeWrp = nodep->changep()->unlinkFrBack();
         AstNodeExpr* const changeRdp = ConvertWriteRefsToRead::main(changeWrp->cloneTree(false));
@@ -111,6 +228,12 @@ class ClockVisitor final : public VNVisitor {
             if (!bdtypep->isOpaque()) comparedp = new AstXor{nodep->fileline(), origp, changeRdp};
         }
         if (!comparedp) comparedp = AstEq::newTyped(nodep->fileline(), origp, changeRdp);
+        if (nodep->points() > 1) {
+            incp->toggledp(new AstXor{nodep->fileline(), origp->cloneTree(false),
+                                      changeRdp->cloneTree(false)});
+        } else if (v3Global.opt.coverageToggleSaturate()) {
+            incp->toggledp(new AstConst{nodep->fileline(), AstConst::WidthedValue{}, 32, 1});
+        }
         AstIf* const newp = new AstIf{nodep->fileline(), comparedp, incp};
         // We could add another IF to detect posedges, and only increment if so.
         // It's another whole branch though versus a potential memory miss.
@@ -182,6 +305,11 @@ public:
             V3Const::constifyExpensiveEdit(senTreep);
         }
         iterate(netlistp);
+        std::vector<AstNode*> stmtsps;
+        netlistp->foreach([&](AstCFunc* funcp) { stmtsps.push_back(funcp->stmtsp()); });
+        netlistp->foreach([&](AstMTaskBody* bodyp) { stmtsps.push_back(bodyp->stmtsp()); });
+        for (AstNode* const stmtsp : stmtsps) guardTriggerWords(stmtsp);
+        guardTriggeredCalls(netlistp);
     }
     ~ClockVisitor() override = default;
 };
@@ -26,6 +26,52 @@
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+//######################################################################
+// Index of wildcard patterns
+
+// Trie of patterns by their literal prefix, the text before the first wildcard. Only patterns
+// whose literal prefix is a prefix of a name can match that name, so finding the candidates
+// costs the length of the name rather than the number of patterns.
+class V3ConfigPatternTrie final {
+    struct Node final {
+        std::map<char, size_t> m_children;  // Next character -> index of node
+        std::vector<size_t> m_values;  // Patterns with literal prefix ending here
+    };
+    std::vector<Node> m_nodes{1};  // Root is the empty prefix
+
+public:
+    void clear() {
+        m_nodes.clear();
+        m_nodes.emplace_back();
+    }
+    void add(const string& pattern, size_t value) {
+        size_t nodeIdx = 0;
+        for (const char c : pattern) {
+            if (c == '*' || c == '?') break;
+            const auto pair = m_nodes[nodeIdx].m_children.emplace(c, m_nodes.size());
+            const size_t nextIdx = pair.first->second;
+            if (pair.second) m_nodes.emplace_back();
+            nodeIdx = nextIdx;
+        }
+        m_nodes[nodeIdx].m_values.push_back(value);
+    }
+    // Values of patterns that might match the name, in ascending order
+    std::vector<size_t> candidates(const string& name) const {
+        std::vector<size_t> result;
+        size_t nodeIdx = 0;
+        for (size_t pos = 0; true; ++pos) {
+            const Node& node = m_nodes[nodeIdx];
+            result.insert(result.end(), node.m_values.begin(), node.m_values.end());
+            if (pos == name.size()) break;
+            const auto it = node.m_children.find(name[pos]);
+            if (it == node.m_children.end()) break;
+            nodeIdx = it->second;
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
 //######################################################################
 // Resolve wildcards in files, modules, ftasks or variables
 
@@ -40,6 +86,20 @@ class V3ConfigWildcardResolver final {
     std::map<const std::string, T> m_mapPatterns VL_GUARDED_BY(m_mutex);
     // Resolved strings to converged entities - nullptr, iff none of the patterns applies
     std::map<const std::string, std::unique_ptr<T>> m_mapResolved VL_GUARDED_BY(m_mutex);
+    // Index of m_mapPatterns, built when first needed, values index m_patterns
+    V3ConfigPatternTrie m_trie VL_GUARDED_BY(m_mutex);
+    std::vector<const std::pair<const std::string, T>*> m_patterns VL_GUARDED_BY(m_mutex);
+    bool m_indexed VL_GUARDED_BY(m_mutex) = false;  // m_trie/m_patterns are up to date
+
+    void buildIndex() VL_REQUIRES(m_mutex) {
+        m_trie.clear();
+        m_patterns.clear();
+        for (const auto& patEnt : m_mapPatterns) {
+            m_trie.add(patEnt.first, m_patterns.size());
+            m_patterns.push_back(&patEnt);
+        }
+        m_indexed = true;
+    }
 
 public:
     V3ConfigWildcardResolver() = default;
@@ -53,6 +113,7 @@ public:
         // Clear the resolved cache, as 'other' might add new patterns that need to be applied as
         // well.
         m_mapResolved.clear();
+        m_indexed = false;
         for (const auto& itr : other.m_mapPatterns) m_mapPatterns[itr.first].update(itr.second);
     }
 
@@ -61,6 +122,7 @@ public:
         V3LockGuard lock{m_mutex};
         // We might be adding a new entry under this, so clear the cache.
         m_mapResolved.clear();
+        m_indexed = false;
         return m_mapPatterns[name];
     }
     // Access an entity and resolve patterns that match it
@@ -71,8 +133,10 @@ public:
         std::unique_ptr<T>& entryr = pair.first->second;
         // Resolve entry when first requested, cache the result
         if (pair.second) {
-            // Update the entity with all matches in the patterns
-            for (const auto& patEnt : m_mapPatterns) {
+            if (!m_indexed) buildIndex();
+            // Update the entity with all matches in the patterns, in pattern order
+            for (const size_t idx : m_trie.candidates(name)) {
+                const auto& patEnt = *m_patterns[idx];
                 if (VString::wildmatch(name, patEnt.first)) {
                     if (!entryr) entryr.reset(new T{});
                     entryr->update(patEnt.second);
@@ -190,6 +254,7 @@ class V3ConfigFTask final {
     bool m_isolate = false;  // Isolate function return
     bool m_noinline = false;  // Don't inline function/task
     bool m_public = false;  // Public function/task
+    VDpiThreads m_dpiThreads;  // DPI import parallel calls attribute
 
 public:
     V3ConfigFTask() = default;
@@ -198,6 +263,7 @@ public:
         if (f.m_isolate) m_isolate = true;
         if (f.m_noinline) m_noinline = true;
         if (f.m_public) m_public = true;
+        if (f.m_dpiThreads != VDpiThreads::DEFAULT) m_dpiThreads = f.m_dpiThreads;
         m_vars.update(f.m_vars);
     }
 
@@ -206,6 +272,7 @@ public:
     void setIsolate(bool set) { m_isolate = set; }
     void setNoInline(bool set) { m_noinline = set; }
     void setPublic(bool set) { m_public = set; }
+    void setDpiThreads(VDpiThreads dpiThreads) { m_dpiThreads = dpiThreads; }
 
     void apply(AstNodeFTask* ftaskp) const {
         if (m_noinline)
@@ -214,6 +281,10 @@ public:
             ftaskp->addStmtsp(new AstPragma{ftaskp->fileline(), VPragmaType::PUBLIC_TASK});
         // Only functions can have isolate (return value)
         if (VN_IS(ftaskp, Func)) ftaskp->attrIsolateAssign(m_isolate);
+        // Only DPI imports have DPI threading, others are matched by wildcards
+        if (m_dpiThreads != VDpiThreads::DEFAULT && ftaskp->dpiImport()) {
+            ftaskp->dpiThreads(m_dpiThreads);
+        }
     }
 };
 
@@ -347,12 +418,18 @@ class V3ConfigFile final {
     LineAttrMap m_lineAttrs;  // Attributes to line mapping
     IgnLines m_ignLines;  // Ignore line settings
     Waivers m_waivers;  // Waive messages
+    V3ConfigPatternTrie m_waiverTrie;  // Index of m_waivers by match
 
     struct {
         int lineno;  // Last line number
         IgnLines::const_iterator it;  // Point with next linenumber > current line number
     } m_lastIgnore;  // Last ignore line run
 
+    void addWaiver(const WaiverSetting& waiver) {
+        m_waiverTrie.add(waiver.m_match, m_waivers.size());
+        m_waivers.push_back(waiver);
+    }
+
     // Match a given line and attribute to the map, line 0 is any
     bool lineMatch(int lineno, VPragmaType type) {
         if (m_lineAttrs.find(0) != m_lineAttrs.end() && m_lineAttrs[0][type]) return true;
@@ -373,7 +450,7 @@ public:
         // Update the iterator after the list has changed
         m_lastIgnore.it = m_ignLines.begin();
         m_waivers.reserve(m_waivers.size() + file.m_waivers.size());
-        m_waivers.insert(m_waivers.end(), file.m_waivers.begin(), file.m_waivers.end());
+        for (const WaiverSetting& waiver : file.m_waivers) addWaiver(waiver);
     }
     void addLineAttribute(int lineno, VPragmaType attr) { m_lineAttrs[lineno].set(attr); }
     void addIgnore(V3ErrorCode code, int lineno, bool on) {
@@ -385,7 +462,7 @@ public:
         // allow old rules to still match using a final '*'
         string newMatch = match;
         if (newMatch.empty() || newMatch.back() != '*') newMatch += '*';
-        m_waivers.emplace_back(WaiverSetting{code, contents, newMatch});
+        addWaiver(WaiverSetting{code, contents, newMatch});
     }
 
     void applyBlock(AstNodeBlock* nodep) {
@@ -422,7 +499,8 @@ public:
     }
     bool waive(V3ErrorCode code, const string& match) {
         if (code.hardError()) return false;
-        for (const auto& itr : m_waivers) {
+        for (const size_t idx : m_waiverTrie.candidates(match)) {
+            const WaiverSetting& itr = m_waivers[idx];
             if ((code.isUnder(itr.m_code) || (itr.m_code == V3ErrorCode::I_LINT))
                 && VString::wildmatch(match, itr.m_match)
                 && WildcardContents::resolve(itr.m_contents)) {
@@ -533,12 +611,16 @@ public:
 // Resolve modules and files in the design
 
 class V3ConfigResolver final {
-    enum ProfileDataMode : uint8_t { NONE = 0, MTASK = 1, HIER_DPI = 2 };
+    enum ProfileDataMode : uint8_t { NONE = 0, MTASK = 1, HIER_DPI = 2, CFUNC = 4, BRANCH = 8 };
     V3ConfigModuleResolver m_modules;  // Access to module names (with wildcards)
     V3ConfigFileResolver m_files;  // Access to file names (with wildcards)
     V3ConfigScopeTraceResolver m_scopeTraces;  // Regexp to trace enables
     std::unordered_map<string, std::unordered_map<string, uint64_t>>
         m_profileData;  // Access to profile_data records
+    std::unordered_map<string, uint64_t> m_profileCFuncs;  // profile_data -cfunc records
+    uint64_t m_profileCFuncTotal = 0;  // Sum of m_profileCFuncs costs
+    // profile_data -branch records, as taken/not taken counts
+    std::unordered_map<string, std::pair<uint64_t, uint64_t>> m_profileBranches;
     uint8_t m_mode = NONE;
     std::unordered_map<string, int> m_hierWorkers;
     FileLine* m_hierWorkersFileLine = nullptr;
@@ -567,7 +649,36 @@ public:
         m_profileData[model][key] += cost;
         m_mode |= mode;
     }
+    void addProfileCFunc(FileLine* fl, const string& cfunc, uint64_t cost) {
+        if (!m_profileFileLine) m_profileFileLine = fl;
+        if (cost == 0) cost = 1;  // Cost 0 means delete (or no data)
+        m_profileCFuncs[cfunc] += cost;
+        m_profileCFuncTotal += cost;
+        m_mode |= CFUNC;
+    }
+    void addProfileBranch(FileLine* fl, const string& location, uint64_t taken,
+                          uint64_t notTaken) {
+        if (!m_profileFileLine) m_profileFileLine = fl;
+        std::pair<uint64_t, uint64_t>& counts = m_profileBranches[location];
+        counts.first += taken;
+        counts.second += notTaken;
+        m_mode |= BRANCH;
+    }
     bool containsMTaskProfileData() const { return m_mode & MTASK; }
+    bool containsCFuncProfileData() const { return m_mode & CFUNC; }
+    bool containsBranchProfileData() const { return m_mode & BRANCH; }
+    bool getProfileBranch(const string& location, uint64_t& taken, uint64_t& notTaken) const {
+        const auto it = m_profileBranches.find(location);
+        if (it == m_profileBranches.cend()) return false;
+        taken = it->second.first;
+        notTaken = it->second.second;
+        return true;
+    }
+    double getProfileCFuncFraction(const string& cfunc) const {
+        const auto it = m_profileCFuncs.find(cfunc);
+        if (it == m_profileCFuncs.cend()) return 0.0;
+        return static_cast<double>(it->second) / m_profileCFuncTotal;
+    }
     uint64_t getProfileData(const string& hierDpi) const {
         // Empty key for hierarchical DPI wrapper costs.
         return getProfileData(hierDpi, "");
@@ -614,6 +725,15 @@ void V3Config::addCoverageBlockOff(const string& module, const string& blockname
     V3ConfigResolver::s().modules().at(module).addCoverageBlockOff(blockname);
 }
 
+void V3Config::addDpiThreads(FileLine* fl, const string& module, const string& ftask,
+                             VDpiThreads dpiThreads) {
+    if (ftask.empty()) {
+        fl->v3error("dpi_threads attributes require -function or -task");
+    } else {
+        V3ConfigResolver::s().modules().at(module).ftasks().at(ftask).setDpiThreads(dpiThreads);
+    }
+}
+
 void V3Config::addHierWorkers(FileLine* fl, const string& model, int workers) {
     V3ConfigResolver::s().addHierWorkers(fl, model, workers);
 }
@@ -657,6 +777,15 @@ void V3Config::addProfileData(FileLine* fl, const string& model, const string& k
     V3ConfigResolver::s().addProfileData(fl, model, key, cost);
 }
 
+void V3Config::addProfileCFunc(FileLine* fl, const string& cfunc, uint64_t cost) {
+    V3ConfigResolver::s().addProfileCFunc(fl, cfunc, cost);
+}
+
+void V3Config::addProfileBranch(FileLine* fl, const string& location, uint64_t taken,
+                                uint64_t notTaken) {
+    V3ConfigResolver::s().addProfileBranch(fl, location, taken, notTaken);
+}
+
 void V3Config::addScopeTraceOn(bool on, const string& scope, int levels) {
     V3ConfigResolver::s().scopeTraces().addScopeTraceOn(on, scope, levels);
 }
@@ -769,6 +898,12 @@ uint64_t V3Config::getProfileData(const string& hierDpi) {
 uint64_t V3Config::getProfileData(const string& model, const string& key) {
     return V3ConfigResolver::s().getProfileData(model, key);
 }
+double V3Config::getProfileCFuncFraction(const string& cfunc) {
+    return V3ConfigResolver::s().getProfileCFuncFraction(cfunc);
+}
+bool V3Config::getProfileBranch(const string& location, uint64_t& taken, uint64_t& notTaken) {
+    return V3ConfigResolver::s().getProfileBranch(location, taken, notTaken);
+}
 FileLine* V3Config::getProfileDataFileLine() {
     return V3ConfigResolver::s().getProfileDataFileLine();
 }
@@ -781,6 +916,12 @@ void V3Config::contentsPushText(const string& text) { return WildcardContents::p
 bool V3Config::containsMTaskProfileData() {
     return V3ConfigResolver::s().containsMTaskProfileData();
 }
+bool V3Config::containsCFuncProfileData() {
+    return V3ConfigResolver::s().containsCFuncProfileData();
+}
+bool V3Config::containsBranchProfileData() {
+    return V3ConfigResolver::s().containsBranchProfileData();
+}
 
 bool V3Config::waive(FileLine* filelinep, V3ErrorCode code, const string& message) {
     V3ConfigFile* filep = V3ConfigResolver::s().files().resolve(filelinep->filename());
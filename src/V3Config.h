@@ -33,6 +33,8 @@ public:
     static void addCaseParallel(const string& file, int lineno);
     static void addCoverageBlockOff(const string& file, int lineno);
     static void addCoverageBlockOff(const string& module, const string& blockname);
+    static void addDpiThreads(FileLine* fl, const string& module, const string& ftask,
+                              VDpiThreads dpiThreads);
     static void addHierWorkers(FileLine* fl, const string& model, int workers);
     static void addIgnore(V3ErrorCode code, bool on, const string& filename, int min, int max);
     static void addIgnoreMatch(V3ErrorCode code, const string& filename, const string& contents,
@@ -42,6 +44,9 @@ public:
     static void addProfileData(FileLine* fl, const string& hierDpi, uint64_t cost);
     static void addProfileData(FileLine* fl, const string& model, const string& key,
                                uint64_t cost);
+    static void addProfileCFunc(FileLine* fl, const string& cfunc, uint64_t cost);
+    static void addProfileBranch(FileLine* fl, const string& location, uint64_t taken,
+                                 uint64_t notTaken);
     static void addScopeTraceOn(bool on, const string& scope, int levels);
     static void addVarAttr(FileLine* fl, const string& module, const string& ftask,
                            const string& signal, VAttrType type, AstSenTree* nodep);
@@ -57,12 +62,18 @@ public:
     static FileLine* getHierWorkersFileLine();
     static uint64_t getProfileData(const string& hierDpi);
     static uint64_t getProfileData(const string& model, const string& key);
+    // Fraction of the total profiled time spent in the logic named by profileFuncname()
+    static double getProfileCFuncFraction(const string& cfunc);
+    // Branch outcome counts for the location named by V3Branch::profileLocation()
+    static bool getProfileBranch(const string& location, uint64_t& taken, uint64_t& notTaken);
     static FileLine* getProfileDataFileLine();
     static bool getScopeTraceOn(const string& scope);
 
     static void contentsPushText(const string& text);
 
     static bool containsMTaskProfileData();
+    static bool containsCFuncProfileData();
+    static bool containsBranchProfileData();
 
     static bool waive(FileLine* filelinep, V3ErrorCode code, const string& message);
 };
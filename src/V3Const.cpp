@@ -20,7 +20,7 @@
 //          If operands are constant, replace this node with constant.
 //*************************************************************************
 
-#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+#include "V3PchAstMT.h"
 
 #include "config_build.h"
 #include "verilatedos.h"
@@ -32,12 +32,15 @@
 #include "V3Simulate.h"
 #include "V3Stats.h"
 #include "V3String.h"
+#include "V3ThreadPool.h"
 #include "V3UniqueNames.h"
 #include "V3Width.h"
 
 #include <algorithm>
 #include <memory>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
@@ -82,9 +85,8 @@ static int countTrailingZeroes(uint64_t val) {
 // - Variables are scoped.
 class ConstBitOpTreeVisitor final : public VNVisitorConst {
     // NODE STATE
-    // AstVarRef::user4u      -> Base index of m_varInfos that points VarInfo
-    // AstVarScope::user4u    -> Same as AstVarRef::user4
-    const VNUser4InUse m_inuser4;
+    // None; variables may be shared with other modules processed in parallel,
+    // so m_baseIdxs is used instead of user4
 
     // TYPES
 
@@ -366,6 +368,8 @@ class ConstBitOpTreeVisitor final : public VNVisitorConst {
         m_frozenNodes;  // Nodes that cannot be optimized
     std::vector<BitPolarityEntry> m_bitPolarities;  // Polarity of bits found during iterate()
     std::vector<std::unique_ptr<VarInfo>> m_varInfos;  // VarInfo for each variable, [0] is nullptr
+    // AstVar/AstVarScope -> Base index of m_varInfos that points VarInfo
+    std::unordered_map<const AstNode*, int> m_baseIdxs;
 
     // METHODS
 
@@ -395,13 +399,12 @@ class ConstBitOpTreeVisitor final : public VNVisitorConst {
         UASSERT_OBJ(ref.refp(), m_rootp, "null varref in And/Or/Xor optimization");
         AstNode* nodep = ref.refp()->varScopep();
         if (!nodep) nodep = ref.refp()->varp();  // Not scoped
-        int baseIdx = nodep->user4();
+        int& baseIdx = m_baseIdxs[nodep];
         if (baseIdx == 0) {  // Not set yet
             baseIdx = m_varInfos.size();
             const int numWords
                 = ref.refp()->dtypep()->isWide() ? ref.refp()->dtypep()->widthWords() : 1;
             m_varInfos.resize(m_varInfos.size() + numWords);
-            nodep->user4(baseIdx);
         }
         const size_t idx = baseIdx + std::max(0, ref.wordIdx());
         VarInfo* varInfop = m_varInfos[idx].get();
@@ -656,7 +659,7 @@ class ConstBitOpTreeVisitor final : public VNVisitorConst {
     ConstBitOpTreeVisitor(AstNodeExpr* nodep, unsigned externalOps)
         : m_ops{externalOps}
         , m_rootp{nodep} {
-        // Fill nullptr at [0] because AstVarScope::user4 is 0 by default
+        // Fill nullptr at [0] because m_baseIdxs is 0 by default
         m_varInfos.push_back(nullptr);
         CONST_BITOP_RETURN_IF(!isAndTree() && !isOrTree() && !isXorTree(), nodep);
         if (AstNodeBiop* const biopp = VN_CAST(nodep, NodeBiop)) {
@@ -897,7 +900,6 @@ class ConstVisitor final : public VNVisitor {
     // NODE STATE
     // ** only when m_warn/m_doExpensive is set.  If state is needed other times,
     // ** must track down everywhere V3Const is called and make sure no overlaps.
-    // AstVar::user4p           -> Used by variable marking/finding
     // AstJumpLabel::user4      -> bool.  Set when AstJumpGo uses this label
     // AstEnum::user4           -> bool.  Recursing.
 
@@ -924,9 +926,17 @@ class ConstVisitor final : public VNVisitor {
     static uint32_t s_globalPassNum;  // Counts number of times ConstVisitor invoked as global pass
     V3UniqueNames m_concswapNames;  // For generating unique temporary variable names
     std::map<const AstNode*, bool> m_containsMemberAccess;  // Caches results of matchBiopToBitwise
+    // When processing modules in parallel, variables and enum items of the current module, others
+    // are read only
+    const std::unordered_set<const AstNode*>* m_localsp = nullptr;
+    // Modules to skip, as processed in parallel
+    const std::unordered_set<const AstNodeModule*>* m_skipModsp = nullptr;
 
     // METHODS
 
+    // Declared in another module while processing in parallel, so must not be edited
+    bool isForeign(const AstNode* nodep) const { return m_localsp && !m_localsp->count(nodep); }
+
     bool operandConst(AstNode* nodep) { return VN_IS(nodep, Const); }
     bool operandAsvConst(const AstNode* nodep) {
         // BIASV(CONST, BIASV(CONST,...)) -> BIASV( BIASV_CONSTED(a,b), ...)
@@ -2075,14 +2085,13 @@ class ConstVisitor final : public VNVisitor {
         } else if (m_doV && VN_IS(nodep->lhsp(), Concat) && nodep->isPure()) {
             bool need_temp = false;
             if (m_warn && !VN_IS(nodep, AssignDly)) {  // Is same var on LHS and RHS?
-                // Note only do this (need user4) when m_warn, which is
-                // done as unique visitor
-                const VNUser4InUse m_inuser4;
-                nodep->lhsp()->foreach([](const AstVarRef* nodep) {
-                    if (nodep->varp()) nodep->varp()->user4(1);
+                // Note only do this when m_warn, which is done as unique visitor
+                std::unordered_set<const AstVar*> lhsVars;
+                nodep->lhsp()->foreach([&lhsVars](const AstVarRef* nodep) {
+                    if (nodep->varp()) lhsVars.insert(nodep->varp());
                 });
-                nodep->rhsp()->foreach([&need_temp](const AstVarRef* nodep) {
-                    if (nodep->varp() && nodep->varp()->user4()) need_temp = true;
+                nodep->rhsp()->foreach([&](const AstVarRef* nodep) {
+                    if (nodep->varp() && lhsVars.count(nodep->varp())) need_temp = true;
                 });
             }
             if (need_temp) {
@@ -2348,6 +2357,7 @@ class ConstVisitor final : public VNVisitor {
         iterateChildrenBackwardsConst(nodep);
     }
     void visit(AstNodeModule* nodep) override {
+        if (m_skipModsp && m_skipModsp->count(nodep)) return;
         VL_RESTORER(m_modp);
         m_modp = nodep;
         m_concswapNames.reset();
@@ -2745,7 +2755,9 @@ class ConstVisitor final : public VNVisitor {
         bool did = false;
         if (m_doV && nodep->varp()->valuep() && !m_attrp) {
             // if (debug()) valuep->dumpTree("-  visitvaref: ");
-            iterateAndNextNull(nodep->varp()->valuep());  // May change nodep->varp()->valuep()
+            if (!isForeign(nodep->varp())) {
+                iterateAndNextNull(nodep->varp()->valuep());  // May change varp()->valuep()
+            }
             AstNode* const valuep = nodep->varp()->valuep();
             if (nodep->access().isReadOnly()
                 && ((!m_params  // Can reduce constant wires into equations
@@ -2808,7 +2820,9 @@ class ConstVisitor final : public VNVisitor {
         bool did = false;
         if (nodep->itemp()->valuep()) {
             // if (debug()) nodep->itemp()->valuep()->dumpTree("-  visitvaref: ");
-            if (nodep->itemp()->user4()) {
+            if (isForeign(nodep->itemp())) {
+                // Value already processed, before the parallel modules
+            } else if (nodep->itemp()->user4()) {
                 nodep->v3error("Recursive enum value: " << nodep->itemp()->prettyNameQ());
             } else {
                 nodep->itemp()->user4(true);
@@ -3066,6 +3080,7 @@ class ConstVisitor final : public VNVisitor {
             && !varrefp->varp()->valuep()  // Not already constified
             && !varrefp->varScopep()  // Not scoped (or each scope may have different initial val.)
             && !varrefp->varp()->isForced()  // Not forced (not really a constant)
+            && !isForeign(varrefp->varp())  // Others may be reading it in parallel
         ) {
             // ASSIGNW (VARREF, const) -> INITIAL ( ASSIGN (VARREF, const) )
             UINFO(4, "constAssignW " << nodep << endl);
@@ -3815,8 +3830,11 @@ public:
 
     // CONSTRUCTORS
     ConstVisitor(ProcMode pmode, bool globalPass)
+        : ConstVisitor{pmode, globalPass, globalPass ? s_globalPassNum++ : 0} {}
+    // Part of a global pass 'passNum', e.g. a module processed in parallel
+    ConstVisitor(ProcMode pmode, bool globalPass, uint32_t passNum)
         : m_globalPass{globalPass}
-        , m_concswapNames{globalPass ? ("__Vconcswap_" + cvtToStr(s_globalPassNum++)) : ""} {
+        , m_concswapNames{globalPass ? ("__Vconcswap_" + cvtToStr(passNum)) : ""} {
         // clang-format off
         switch (pmode) {
         case PROC_PARAMS_NOWARN:  m_doV = true;  m_doNConst = true; m_params = true;
@@ -3849,10 +3867,86 @@ public:
         // Operate starting at a random place
         return iterateSubtreeReturnEdits(nodep);
     }
+    // Process the netlist, except the given modules which are processed separately
+    void mainAcceptSkipping(AstNetlist* nodep,
+                            const std::unordered_set<const AstNodeModule*>* skipModsp) {
+        m_skipModsp = skipModsp;
+        iterate(nodep);
+    }
+    // Process a module in parallel with others, 'localsp' are its variables and enum items
+    void mainAcceptModule(AstNodeModule* nodep, const std::unordered_set<const AstNode*>* localsp) {
+        m_localsp = localsp;
+        iterate(nodep);
+    }
+    static uint32_t newGlobalPassNum() { return s_globalPassNum++; }
 };
 
 uint32_t ConstVisitor::s_globalPassNum = 0;
 
+//######################################################################
+// Global pass, processing modules in parallel where possible
+
+static void constifyAllParallel(AstNetlist* netlistp, ConstVisitor::ProcMode pmode) {
+    // Modules with variables, enum items or functions referenced by other
+    // modules are processed serially first, so may be read by the others,
+    // which are then processed in parallel.
+    std::unordered_set<const AstNodeModule*> sharedMods;
+    std::unordered_set<const AstNodeModule*> parallelMods;
+    {
+        // AstVar/AstEnumItem/AstNodeFTask::user1p -> AstNodeModule declaring it
+        const VNUser1InUse user1InUse;
+        for (AstNodeModule* modp = netlistp->modulesp(); modp;
+             modp = VN_AS(modp->nextp(), NodeModule)) {
+            modp->foreach([modp](AstNode* nodep) {
+                if (VN_IS(nodep, Var) || VN_IS(nodep, EnumItem) || VN_IS(nodep, NodeFTask)) {
+                    nodep->user1p(modp);
+                }
+            });
+        }
+        for (AstNodeModule* modp = netlistp->modulesp(); modp;
+             modp = VN_AS(modp->nextp(), NodeModule)) {
+            modp->foreach([&](const AstNode* nodep) {
+                const AstNode* targetp = nullptr;
+                if (const AstNodeVarRef* const refp = VN_CAST(nodep, NodeVarRef)) {
+                    targetp = refp->varp();
+                } else if (const AstEnumItemRef* const refp = VN_CAST(nodep, EnumItemRef)) {
+                    targetp = refp->itemp();
+                } else if (const AstNodeFTaskRef* const refp = VN_CAST(nodep, NodeFTaskRef)) {
+                    targetp = refp->taskp();
+                }
+                if (!targetp) return;
+                const AstNodeModule* const ownerp = VN_AS(targetp->user1p(), NodeModule);
+                if (ownerp && ownerp != modp) sharedMods.emplace(ownerp);
+            });
+        }
+    }
+    for (AstNodeModule* modp = netlistp->modulesp(); modp;
+         modp = VN_AS(modp->nextp(), NodeModule)) {
+        if (!sharedMods.count(modp)) parallelMods.emplace(modp);
+    }
+    UINFO(4, "  Modules in parallel: " << parallelMods.size() << endl);
+
+    VIsCached::clearCacheTree();  // Avoid using any stale isPure
+    const uint32_t passNum = ConstVisitor::newGlobalPassNum();
+    {
+        ConstVisitor visitor{pmode, /* globalPass: */ true, passNum};
+        visitor.mainAcceptSkipping(netlistp, &parallelMods);
+    }
+    V3ThreadScope threadScope;
+    for (AstNodeModule* modp = netlistp->modulesp(); modp;
+         modp = VN_AS(modp->nextp(), NodeModule)) {
+        if (!parallelMods.count(modp)) continue;
+        threadScope.enqueue([modp, pmode, passNum]() {
+            std::unordered_set<const AstNode*> locals;
+            modp->foreach([&locals](const AstNode* nodep) {
+                if (VN_IS(nodep, Var) || VN_IS(nodep, EnumItem)) locals.emplace(nodep);
+            });
+            ConstVisitor visitor{pmode, /* globalPass: */ true, passNum};
+            visitor.mainAcceptModule(modp, &locals);
+        });
+    }
+}
+
 //######################################################################
 // Const class functions
 
@@ -3935,7 +4029,9 @@ AstNode* V3Const::constifyGenerateParamsEdit(AstNode* nodep) {
 void V3Const::constifyAllLint(AstNetlist* nodep) {
     // Only call from Verilator.cpp, as it uses user#'s
     UINFO(2, __FUNCTION__ << ": " << endl);
-    {
+    if (v3Global.opt.verilateJobs() > 1) {
+        constifyAllParallel(nodep, ConstVisitor::PROC_V_WARN);
+    } else {
         ConstVisitor visitor{ConstVisitor::PROC_V_WARN, /* globalPass: */ true};
         (void)visitor.mainAcceptEdit(nodep);
     }  // Destruct before checking
@@ -3968,7 +4064,9 @@ void V3Const::constifyAllLive(AstNetlist* nodep) {
     // This only pushes constants up, doesn't make any other edits
     // IE doesn't prune dead statements, as we need to do some usability checks after this
     UINFO(2, __FUNCTION__ << ": " << endl);
-    {
+    if (v3Global.opt.verilateJobs() > 1) {
+        constifyAllParallel(nodep, ConstVisitor::PROC_LIVE);
+    } else {
         ConstVisitor visitor{ConstVisitor::PROC_LIVE, /* globalPass: */ true};
         (void)visitor.mainAcceptEdit(nodep);
     }  // Destruct before checking
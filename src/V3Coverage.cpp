@@ -168,9 +168,8 @@ class CoverageVisitor final : public VNVisitor {
         return nullptr;
     }
 
-    AstCoverInc* newCoverInc(FileLine* fl, const string& hier, const string& page_prefix,
-                             const string& comment, const string& linescov, int offset,
-                             const string& trace_var_name) {
+    AstCoverDecl* newCoverDecl(FileLine* fl, const string& hier, const string& page_prefix,
+                               const string& comment, const string& linescov, int offset) {
         // We could use the basename of the filename to the page, but seems
         // better for code from an include file to be listed under the
         // module using it rather than the include file.
@@ -183,7 +182,13 @@ class CoverageVisitor final : public VNVisitor {
         declp->hier(hier);
         m_modp->addStmtsp(declp);
         UINFO(9, "new " << declp << endl);
-
+        return declp;
+    }
+    AstCoverInc* newCoverInc(FileLine* fl, const string& hier, const string& page_prefix,
+                             const string& comment, const string& linescov, int offset,
+                             const string& trace_var_name) {
+        AstCoverDecl* const declp
+            = newCoverDecl(fl, hier, page_prefix, comment, linescov, offset);
         AstCoverInc* const incp = new AstCoverInc{fl, declp};
         if (!trace_var_name.empty()
             && v3Global.opt.traceCoverage()
@@ -378,22 +383,38 @@ class CoverageVisitor final : public VNVisitor {
             above.m_varRefp->cloneTree(true), above.m_chgRefp->cloneTree(true)};
         m_modp->addStmtsp(newp);
     }
+    void toggleVarBits(const ToggleEnt& above, const AstVar* varp,
+                       const AstBasicDType* bdtypep) {
+        // One toggle per word of bits, V3Clock then increments the point of each
+        // toggled bit with a word operation, instead of an if() per bit
+        FileLine* const fl = varp->fileline();
+        for (int lsb = 0; lsb < bdtypep->width(); lsb += VL_QUADSIZE) {
+            const int width = std::min(VL_QUADSIZE, bdtypep->width() - lsb);
+            // Points of the word's bits must be consecutive, see AstCoverToggle
+            AstCoverDecl* firstDeclp = nullptr;
+            for (int index_code = lsb; index_code < lsb + width; ++index_code) {
+                const int index_docs = index_code + bdtypep->lo();
+                AstCoverDecl* const declp = newCoverDecl(
+                    fl, "", "v_toggle",
+                    varp->name() + above.m_comment + "["s + cvtToStr(index_docs) + "]", "", 0);
+                if (!firstDeclp) firstDeclp = declp;
+            }
+            AstNodeExpr* origp = above.m_varRefp->cloneTree(true);
+            AstNodeExpr* changep = above.m_chgRefp->cloneTree(true);
+            if (width != bdtypep->width()) {
+                origp = new AstSel{fl, origp, lsb, width};
+                changep = new AstSel{fl, changep, lsb, width};
+            }
+            m_modp->addStmtsp(new AstCoverToggle{fl, new AstCoverInc{fl, firstDeclp}, origp,
+                                                 changep, static_cast<uint32_t>(width)});
+        }
+    }
 
     void toggleVarRecurse(AstNodeDType* dtypep, int depth,  // per-iteration
                           const ToggleEnt& above, AstVar* varp, AstVar* chgVarp) {  // Constant
         if (const AstBasicDType* const bdtypep = VN_CAST(dtypep, BasicDType)) {
             if (bdtypep->isRanged()) {
-                for (int index_docs = bdtypep->lo(); index_docs < bdtypep->hi() + 1;
-                     ++index_docs) {
-                    const int index_code = index_docs - bdtypep->lo();
-                    ToggleEnt newent{above.m_comment + "["s + cvtToStr(index_docs) + "]",
-                                     new AstSel{varp->fileline(), above.m_varRefp->cloneTree(true),
-                                                index_code, 1},
-                                     new AstSel{varp->fileline(), above.m_chgRefp->cloneTree(true),
-                                                index_code, 1}};
-                    toggleVarBottom(newent, varp);
-                    newent.cleanup();
-                }
+                toggleVarBits(above, varp, bdtypep);
             } else {
                 toggleVarBottom(above, varp);
             }
@@ -481,6 +502,8 @@ class CoverageVisitor final : public VNVisitor {
         }
     }
 
+    void visit(AstCoverInc*) override {}  // Coverage-generated, don't cover it again
+
     // VISITORS - LINE COVERAGE
     // Note not AstNodeIf; other types don't get covered
     void visit(AstIf* nodep) override {
@@ -653,6 +676,22 @@ class CoverageVisitor final : public VNVisitor {
 
     void addExprCoverInc(AstNodeExpr* nodep, int start = 0) {
         FileLine* const fl = nodep->fileline();
+        // Without per-point trace variables, count up to a word of branches with
+        // one increment, of the points of the set bits of the branch conditions
+        // concatenated, instead of an if() per branch
+        const bool packed = !v3Global.opt.traceCoverage();
+        AstNodeExpr* matchedp = nullptr;
+        AstCoverDecl* firstDeclp = nullptr;
+        int matchedWidth = 0;
+        const auto flushMatched = [&]() {
+            if (!matchedp) return;
+            AstCoverInc* const incp = new AstCoverInc{fl, firstDeclp};
+            incp->toggledp(matchedp);
+            insertProcStatement(m_exprStmtsp, incp);
+            matchedp = nullptr;
+            firstDeclp = nullptr;
+            matchedWidth = 0;
+        };
         int count = start;
         for (CoverExpr& expr : m_exprs) {
             const string name = "expr_" + std::to_string(count);
@@ -673,14 +712,24 @@ class CoverageVisitor final : public VNVisitor {
             }
             comment += ") => ";
             comment += (m_objective ? '1' : '0');
-            AstNode* const newp
-                = newCoverInc(fl, "", "v_expr", comment, "", 0, traceNameForLine(nodep, name));
             UASSERT_OBJ(condp, nodep, "No terms in expression coverage branch");
-            AstIf* const ifp = new AstIf{fl, condp, newp, nullptr};
-            ifp->user2(true);
-            insertProcStatement(m_exprStmtsp, ifp);
+            if (packed) {
+                // Points of the word's bits must be consecutive, see AstCoverInc
+                AstCoverDecl* const declp = newCoverDecl(fl, "", "v_expr", comment, "", 0);
+                if (!firstDeclp) firstDeclp = declp;
+                if (condp->width() != 1) condp = new AstRedOr{fl, condp};
+                matchedp = matchedp ? new AstConcat{fl, condp, matchedp} : condp;
+                if (++matchedWidth == VL_QUADSIZE) flushMatched();
+            } else {
+                AstNode* const newp = newCoverInc(fl, "", "v_expr", comment, "", 0,
+                                                  traceNameForLine(nodep, name));
+                AstIf* const ifp = new AstIf{fl, condp, newp, nullptr};
+                ifp->user2(true);
+                insertProcStatement(m_exprStmtsp, ifp);
+            }
             ++count;
         }
+        flushMatched();
     }
 
     void coverExprs(AstNodeExpr* nodep) {
@@ -70,19 +70,30 @@ class CoverageJoinVisitor final : public VNVisitor {
                 // covertoggle which is immediately above, so:
                 AstCoverToggle* const removep = VN_AS(duporigp->backp(), CoverToggle);
                 UASSERT_OBJ(removep, nodep, "CoverageJoin duplicate of wrong type");
+                // Same expression, but perhaps one counted per bit and one as a whole
+                if (removep->points() != nodep->points()) continue;
                 UINFO(8, "  Orig " << nodep << " -->> " << nodep->incp()->declp() << endl);
                 UINFO(8, "   dup " << removep << " -->> " << removep->incp()->declp() << endl);
                 // The CoverDecl the duplicate pointed to now needs to point to the
                 // original's data. I.e. the duplicate will get the coverage number
                 // from the non-duplicate
-                AstCoverDecl* const datadeclp = nodep->incp()->declp()->dataDeclThisp();
-                removep->incp()->declp()->dataDeclp(datadeclp);
+                // With a point per bit, the declarations of each bit are consecutive
+                AstCoverDecl* origDeclp = nodep->incp()->declp();
+                AstCoverDecl* dupDeclp = removep->incp()->declp();
+                for (uint32_t point = 0; point < nodep->points(); ++point) {
+                    if (point) {
+                        origDeclp = VN_AS(origDeclp->nextp(), CoverDecl);
+                        dupDeclp = VN_AS(dupDeclp->nextp(), CoverDecl);
+                        UASSERT_OBJ(origDeclp && dupDeclp, nodep, "Toggle points not consecutive");
+                    }
+                    dupDeclp->dataDeclp(origDeclp->dataDeclThisp());
+                }
                 UINFO(8, "   new " << removep->incp()->declp() << endl);
                 // Mark the found node as a duplicate of the first node
                 // (Not vice-versa as we have the iterator for the found node)
                 removep->unlinkFrBack();
                 VL_DO_DANGLING(pushDeletep(removep), removep);
-                ++m_statToggleJoins;
+                m_statToggleJoins += nodep->points();
             }
         }
     }
@@ -84,6 +84,13 @@
 //         LHS = __VdlyVal__LHS;
 //      }
 //
+// "In place" scheme. Used for non-array target variables that are referenced
+// only by the single clocked process containing their only NBA, and only read
+// before that NBA. No other logic can observe the difference, so E.g.:
+//   LHS <= RHS;
+// is converted to:
+//      LHS = RHS;
+//
 // The "Value Queue Whole/Partial" schemes are used for cases where the
 // target of an assignment cannot be statically determined, for example,
 // with an array LHS in a loop:
@@ -113,6 +120,64 @@
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+//######################################################################
+// Find the NBA targets that can be updated in place (see "In place" scheme)
+
+class DelayedInPlaceVisitor final : public VNVisitorConst {
+public:
+    // TYPES
+    struct Candidate final {
+        const AstNodeProcedure* m_procp;  // The process containing the NBA
+        const AstAssignDly* m_nbap;  // The only NBA updating the variable
+        bool m_nbaSeen = false;  // Iteration passed the NBA
+        bool m_ok = true;  // All references seen so far allow updating in place
+    };
+
+private:
+    // NODE STATE
+    //  AstVarScope::user3p()   -> Candidate*, if a candidate
+    const VNUser3InUse m_user3InUse;
+
+    // STATE
+    const AstNodeProcedure* m_procp = nullptr;  // Current process
+    const AstAssignDly* m_nbap = nullptr;  // Current NBA
+
+    // VISITORS
+    void visit(AstNodeProcedure* nodep) override {
+        VL_RESTORER(m_procp);
+        m_procp = nodep;
+        iterateChildrenConst(nodep);
+    }
+    void visit(AstAssignDly* nodep) override {
+        VL_RESTORER(m_nbap);
+        m_nbap = nodep;
+        // Right hand side is evaluated before the target is written
+        iterateConst(nodep->rhsp());
+        iterateConst(nodep->lhsp());
+    }
+    void visit(AstVarRef* nodep) override {
+        Candidate* const candp = nodep->varScopep()->user3u().to<Candidate*>();
+        if (!candp || !candp->m_ok) return;
+        if (m_procp != candp->m_procp) {
+            candp->m_ok = false;  // Referenced by other logic
+        } else if (nodep->access().isWriteOrRW()) {
+            if (m_nbap != candp->m_nbap) candp->m_ok = false;  // Other write
+            candp->m_nbaSeen = true;
+        } else if (candp->m_nbaSeen) {
+            candp->m_ok = false;  // Read after the NBA, which must see the old value
+        }
+    }
+    void visit(AstNode* nodep) override { iterateChildrenConst(nodep); }
+
+public:
+    // CONSTRUCTORS
+    DelayedInPlaceVisitor(AstNetlist* netlistp,
+                          std::vector<std::pair<AstVarScope*, Candidate>>& candidates) {
+        for (auto& pair : candidates) pair.first->user3p(&pair.second);
+        iterateConst(netlistp);
+    }
+};
+
 //######################################################################
 // Convert AstAssignDlys (NBAs)
 
@@ -124,6 +189,7 @@ class DelayedVisitor final : public VNVisitor {
         Undecided = 0,
         UnsupportedCompoundArrayInLoop,
         ShadowVar,
+        InPlace,
         FlagShared,
         FlagUnique,
         ValueQueueWhole,
@@ -137,6 +203,10 @@ class DelayedVisitor final : public VNVisitor {
         const AstVarRef* m_firstNbaRefp = nullptr;
         // Active block 'm_firstNbaRefp' is under
         const AstActive* m_fistActivep = nullptr;
+        // First NBA to the VarScope, and the process it is under
+        const AstAssignDly* m_firstNbap = nullptr;
+        const AstNodeProcedure* m_firstProcp = nullptr;
+        uint32_t m_nNbas = 0;  // Number of NBAs targeting this variable
         bool m_partial = false;  // Used on LHS of NBA under a Sel
         bool m_inLoop = false;  // Used on LHS of NBA in a loop
         bool m_inSuspOrFork = false;  // Used on LHS of NBA in suspendable process or fork
@@ -238,6 +308,7 @@ class DelayedVisitor final : public VNVisitor {
 
     // STATE - Statistic tracking
     VDouble0 m_nSchemeShadowVar;  // Number of variables using Scheme::ShadowVar
+    VDouble0 m_nSchemeInPlace;  // Number of variables using Scheme::InPlace
     VDouble0 m_nSchemeFlagShared;  // Number of variables using Scheme::FlagShared
     VDouble0 m_nSchemeFlagUnique;  // Number of variables using Scheme::FlagUnique
     VDouble0 m_nSchemeValueQueuesWhole;  //  Number of variables using Scheme::ValueQueueWhole
@@ -283,6 +354,34 @@ class DelayedVisitor final : public VNVisitor {
         return Scheme::ShadowVar;
     }
 
+    // Return the Scheme::ShadowVar variables that can use Scheme::InPlace instead
+    std::unordered_set<const AstVarScope*> findInPlace(AstNetlist* netlistp) {
+        std::vector<std::pair<AstVarScope*, DelayedInPlaceVisitor::Candidate>> candidates;
+        for (AstVarScope* const vscp : m_vscps) {
+            const VarScopeInfo& vscpInfo = m_vscpInfo(vscp);
+            if (vscpInfo.m_scheme != Scheme::ShadowVar) continue;
+            if (vscpInfo.m_nNbas != 1 || vscpInfo.m_partial || vscpInfo.m_inLoop) continue;
+            if (!vscpInfo.m_fistActivep->hasClocked()) continue;
+            const AstAssignDly* const nbap = vscpInfo.m_firstNbap;
+            if (!VN_IS(nbap->lhsp(), VarRef) || nbap->timingControlp()) continue;
+            // Might be accessed outside the model while evaluating
+            const AstVar* const varp = vscp->varp();
+            if (varp->isSigPublic() || varp->isPrimaryIO() || varp->isForceable()
+                || varp->isWrittenByDpi()) {
+                continue;
+            }
+            candidates.emplace_back(
+                vscp, DelayedInPlaceVisitor::Candidate{vscpInfo.m_firstProcp, nbap});
+        }
+        std::unordered_set<const AstVarScope*> result;
+        if (candidates.empty()) return result;
+        { DelayedInPlaceVisitor{netlistp, candidates}; }
+        for (const auto& pair : candidates) {
+            if (pair.second.m_ok) result.emplace(pair.first);
+        }
+        return result;
+    }
+
     // Create new AstVarScope in the given 'scopep', with the given 'name' and 'dtypep'
     AstVarScope* createTemp(FileLine* flp, AstScope* scopep, const std::string& name,
                             AstNodeDType* dtypep) {
@@ -408,6 +507,15 @@ class DelayedVisitor final : public VNVisitor {
         });
     }
 
+    // Scheme::InPlace
+    void convertSchemeInPlace(AstAssignDly* nodep) {
+        // Just make it a blocking assignment
+        AstAssign* const newp = new AstAssign{nodep->fileline(), nodep->lhsp()->unlinkFrBack(),
+                                              nodep->rhsp()->unlinkFrBack()};
+        nodep->replaceWith(newp);
+        VL_DO_DANGLING(pushDeletep(nodep), nodep);
+    }
+
     // Scheme::FlagShared
     void prepareSchemeFlagShared(AstVarScope* vscp, VarScopeInfo& vscpInfo) {
         UASSERT_OBJ(vscpInfo.m_scheme == Scheme::FlagShared, vscp, "Inconsistent NBA scheme");
@@ -755,10 +863,19 @@ class DelayedVisitor final : public VNVisitor {
     // VISITORS
     void visit(AstNetlist* nodep) override {
         iterateChildren(nodep);
-        // Decide which scheme to use for each variable and do the 'prepare' step
+        // Decide which scheme to use for each variable
         for (AstVarScope* const vscp : m_vscps) {
             VarScopeInfo& vscpInfo = m_vscpInfo(vscp);
             vscpInfo.m_scheme = chooseScheme(vscp, vscpInfo);
+        }
+        if (v3Global.opt.fNbaInPlace()) {
+            for (const AstVarScope* const vscp : findInPlace(nodep)) {
+                m_vscpInfo(vscp).m_scheme = Scheme::InPlace;
+            }
+        }
+        // Do the 'prepare' step
+        for (AstVarScope* const vscp : m_vscps) {
+            VarScopeInfo& vscpInfo = m_vscpInfo(vscp);
             // Run 'prepare' step
             switch (vscpInfo.m_scheme) {
             case Scheme::Undecided:  // LCOV_EXCL_START
@@ -773,6 +890,10 @@ class DelayedVisitor final : public VNVisitor {
                 prepareSchemeShadowVar(vscp, vscpInfo);
                 break;
             }
+            case Scheme::InPlace: {
+                ++m_nSchemeInPlace;
+                break;
+            }
             case Scheme::FlagShared: {
                 ++m_nSchemeFlagShared;
                 prepareSchemeFlagShared(vscp, vscpInfo);
@@ -816,6 +937,10 @@ class DelayedVisitor final : public VNVisitor {
                 convertSchemeShadowVar(nbap, vscp, vscpInfo);
                 break;
             }
+            case Scheme::InPlace: {
+                convertSchemeInPlace(nbap);
+                break;
+            }
             case Scheme::FlagShared: {
                 convertSchemeFlagShared(nbap, vscp, vscpInfo);
                 break;
@@ -980,8 +1105,11 @@ class DelayedVisitor final : public VNVisitor {
         if (!vscpInfo.m_firstNbaRefp) {
             vscpInfo.m_firstNbaRefp = m_currNbaLhsRefp;
             vscpInfo.m_fistActivep = m_activep;
+            vscpInfo.m_firstNbap = nodep;
+            vscpInfo.m_firstProcp = m_procp;
             m_vscps.emplace_back(vscp);
         }
+        ++vscpInfo.m_nNbas;
         // Note usage context
         vscpInfo.m_partial |= VN_IS(nodep->lhsp(), Sel);
         vscpInfo.m_inLoop |= m_inLoop;
@@ -1054,6 +1182,7 @@ public:
     explicit DelayedVisitor(AstNetlist* nodep) { iterate(nodep); }
     ~DelayedVisitor() override {
         V3Stats::addStat("NBA, variables using ShadowVar scheme", m_nSchemeShadowVar);
+        V3Stats::addStat("NBA, variables using InPlace scheme", m_nSchemeInPlace);
         V3Stats::addStat("NBA, variables using FlagShared scheme", m_nSchemeFlagShared);
         V3Stats::addStat("NBA, variables using FlagUnique scheme", m_nSchemeFlagUnique);
         V3Stats::addStat("NBA, variables using ValueQueueWhole scheme", m_nSchemeValueQueuesWhole);
@@ -49,6 +49,8 @@ class DepthBlockVisitor final : public VNVisitor {
         const string name = m_cfuncp->name() + "__deep" + cvtToStr(++m_deepNum);
         AstCFunc* const funcp = new AstCFunc{nodep->fileline(), name, scopep};
         funcp->slow(m_cfuncp->slow());
+        funcp->cold(m_cfuncp->cold());
+        funcp->hot(m_cfuncp->hot());
         funcp->isStatic(m_cfuncp->isStatic());
         funcp->isLoose(m_cfuncp->isLoose());
         funcp->addStmtsp(nodep);
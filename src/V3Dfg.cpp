@@ -26,6 +26,9 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 // DfgGraph
 //------------------------------------------------------------------------------
 
+thread_local uint32_t DfgGraph::s_userCurrent = 0;
+std::atomic<uint32_t> DfgGraph::s_userCntNext{0};
+
 DfgGraph::DfgGraph(AstModule& module, const string& name)
     : m_modulep{&module}
     , m_name{name} {}
@@ -37,21 +40,9 @@ DfgGraph::~DfgGraph() {
 void DfgGraph::addGraph(DfgGraph& other) {
     m_size += other.m_size;
     other.m_size = 0;
-
-    for (DfgVertexVar& vtx : other.m_varVertices) {
-        vtx.m_userCnt = 0;
-        vtx.m_graphp = this;
-    }
+    // Vertices hold no reference to their graph, so just splice the lists
     m_varVertices.splice(m_varVertices.end(), other.m_varVertices);
-    for (DfgConst& vtx : other.m_constVertices) {
-        vtx.m_userCnt = 0;
-        vtx.m_graphp = this;
-    }
     m_constVertices.splice(m_constVertices.end(), other.m_constVertices);
-    for (DfgVertex& vtx : other.m_opVertices) {
-        vtx.m_userCnt = 0;
-        vtx.m_graphp = this;
-    }
     m_opVertices.splice(m_opVertices.end(), other.m_opVertices);
 }
 
@@ -43,6 +43,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <functional>
 #include <new>
 #include <type_traits>
@@ -137,7 +138,6 @@ protected:
     DfgEdge* m_sinksp = nullptr;  // List of sinks of this vertex
     FileLine* const m_filelinep;  // Source location
     AstNodeDType* m_dtypep;  // Data type of the result of this vertex - mutable for efficiency
-    DfgGraph* m_graphp;  // The containing DfgGraph
     const VDfgType m_type;  // Vertex type tag
     uint32_t m_userCnt = 0;  // User data generation number
     UserDataStorage m_userDataStorage;  // User data storage
@@ -147,6 +147,7 @@ protected:
 
 public:
     virtual ~DfgVertex() VL_MT_DISABLED;
+    VL_ARENA_OPERATORS
 
 private:
     V3ListLinks<DfgVertex>& links() { return m_links; }
@@ -209,7 +210,7 @@ public:
             AstNodeDType* const adtypep = new AstUnpackArrayDType{
                 typep->fileline(), dtypeForWidth(typep->subDTypep()->width()),
                 typep->rangep()->cloneTree(false)};
-            v3Global.rootp()->typeTablep()->addTypesp(adtypep);
+            v3Global.rootp()->typeTablep()->addTypespLocked(adtypep);
             return adtypep;
         }
         return dtypeForWidth(nodep->width());
@@ -524,13 +525,18 @@ class DfgVertexVariadic VL_NOT_FINAL : public DfgVertex {
 
     // Allocate a new source edge array
     DfgEdge* allocSources(size_t n) {
-        DfgEdge* const srcsp = new DfgEdge[n];
-        for (size_t i = 0; i < n; ++i) srcsp[i].init(this);
+        DfgEdge* const srcsp = static_cast<DfgEdge*>(V3Arena::allocate(n * sizeof(DfgEdge)));
+        for (size_t i = 0; i < n; ++i) (new (srcsp + i) DfgEdge{})->init(this);
         return srcsp;
     }
+    // Free a source edge array with capacity 'n'
+    static void freeSources(DfgEdge* srcsp, size_t n) {
+        V3Arena::deallocate(srcsp, n * sizeof(DfgEdge));
+    }
 
     // Double the capacity of m_srcsp
     void growSources() {
+        const uint32_t oldCap = m_srcCap;
         m_srcCap *= 2;
         DfgEdge* const newsp = allocSources(m_srcCap);
         for (size_t i = 0; i < m_srcCnt; ++i) {
@@ -543,7 +549,7 @@ class DfgVertexVariadic VL_NOT_FINAL : public DfgVertex {
             oldp->unlinkSource();
         }
         // Delete old source edges
-        delete[] m_srcsp;
+        freeSources(m_srcsp, oldCap);
         // Keep hold of new source edges
         m_srcsp = newsp;
     }
@@ -555,7 +561,7 @@ protected:
         , m_srcsp{allocSources(initialCapacity)}
         , m_srcCap{initialCapacity} {}
 
-    ~DfgVertexVariadic() override { delete[] m_srcsp; };
+    ~DfgVertexVariadic() override { freeSources(m_srcsp, m_srcCap); };
 
     DfgEdge* addSource() {
         if (m_srcCnt == m_srcCap) growSources();
@@ -598,26 +604,25 @@ class DfgGraph final {
 
     // RAII handle for DfgVertex user data
     class UserDataInUse final {
-        DfgGraph* m_graphp;  // The referenced graph
+        bool m_inUse;  // This handle holds the user data
 
     public:
-        // cppcheck-suppress noExplicitConstructor
-        UserDataInUse(DfgGraph* graphp)
-            : m_graphp{graphp} {}
+        UserDataInUse()
+            : m_inUse{true} {}
         // cppcheck-suppress noExplicitConstructor
         UserDataInUse(UserDataInUse&& that) {
-            UASSERT(that.m_graphp, "Moving from empty");
-            m_graphp = std::exchange(that.m_graphp, nullptr);
+            UASSERT(that.m_inUse, "Moving from empty");
+            m_inUse = std::exchange(that.m_inUse, false);
         }
         VL_UNCOPYABLE(UserDataInUse);
         UserDataInUse& operator=(UserDataInUse&& that) {
-            UASSERT(that.m_graphp, "Moving from empty");
-            m_graphp = std::exchange(that.m_graphp, nullptr);
+            UASSERT(that.m_inUse, "Moving from empty");
+            m_inUse = std::exchange(that.m_inUse, false);
             return *this;
         }
 
         ~UserDataInUse() {
-            if (m_graphp) m_graphp->m_userCurrent = 0;
+            if (m_inUse) s_userCurrent = 0;
         }
     };
 
@@ -632,8 +637,11 @@ class DfgGraph final {
     DfgVertex::List<DfgVertex> m_opVertices;  // The operation vertices in the graph
 
     size_t m_size = 0;  // Number of vertices in the graph
-    uint32_t m_userCurrent = 0;  // Vertex user data generation number currently in use
-    uint32_t m_userCnt = 0;  // Vertex user data generation counter
+    // Vertex user data generation number currently in use. This is per thread rather than per
+    // graph, so vertices need no pointer to their graph, and keep their user data when moved
+    // between graphs. Only one graph may use the user data at a time on each thread.
+    static thread_local uint32_t s_userCurrent;
+    static std::atomic<uint32_t> s_userCntNext;  // Next generation number, over all threads
     // Parent of the graph (i.e.: the module containing the logic represented by this graph).
     AstModule* const m_modulep;
     const string m_name;  // Name of graph (for debugging)
@@ -659,11 +667,10 @@ public:
 
     // Reset Vertex user data
     UserDataInUse userDataInUse() {
-        UASSERT(!m_userCurrent, "Conflicting use of DfgVertex user data");
-        ++m_userCnt;
-        UASSERT(m_userCnt, "'m_userCnt' overflow");
-        m_userCurrent = m_userCnt;
-        return UserDataInUse{this};
+        UASSERT(!s_userCurrent, "Conflicting use of DfgVertex user data");
+        s_userCurrent = s_userCntNext.fetch_add(1, std::memory_order_relaxed) + 1;
+        UASSERT(s_userCurrent, "'s_userCntNext' overflow");
+        return UserDataInUse{};
     }
 
     // Access to vertex lists
@@ -735,7 +742,7 @@ T& DfgVertex::user() {
     static_assert(alignof(T) <= alignof(UserDataStorage),
                   "Alignment of user data type 'T' is larger than allocated storage");
     T* const storagep = reinterpret_cast<T*>(&m_userDataStorage);
-    const uint32_t userCurrent = m_graphp->m_userCurrent;
+    const uint32_t userCurrent = DfgGraph::s_userCurrent;
     UDEBUGONLY(UASSERT_OBJ(userCurrent, this, "DfgVertex user data used without reserving"););
     if (m_userCnt != userCurrent) {
         m_userCnt = userCurrent;
@@ -754,7 +761,7 @@ T& DfgVertex::getUser() {
                   "Alignment of user data type 'T' is larger than allocated storage");
     T* const storagep = reinterpret_cast<T*>(&m_userDataStorage);
 #if VL_DEBUG
-    const uint32_t userCurrent = m_graphp->m_userCurrent;
+    const uint32_t userCurrent = DfgGraph::s_userCurrent;
     UASSERT_OBJ(userCurrent, this, "DfgVertex user data used without reserving");
     UASSERT_OBJ(m_userCnt == userCurrent, this, "DfgVertex user data is stale");
 #endif
@@ -768,7 +775,7 @@ void DfgVertex::setUser(T value) {
     static_assert(alignof(T) <= alignof(UserDataStorage),
                   "Alignment of user data type 'T' is larger than allocated storage");
     T* const storagep = reinterpret_cast<T*>(&m_userDataStorage);
-    const uint32_t userCurrent = m_graphp->m_userCurrent;
+    const uint32_t userCurrent = DfgGraph::s_userCurrent;
 #if VL_DEBUG
     UASSERT_OBJ(userCurrent, this, "DfgVertex user data used without reserving");
 #endif
@@ -888,7 +895,6 @@ void DfgGraph::addVertex(DfgVertex& vtx) {
         m_opVertices.linkBack(&vtx);
     }
     vtx.m_userCnt = 0;
-    vtx.m_graphp = this;
 }
 
 void DfgGraph::removeVertex(DfgVertex& vtx) {
@@ -902,7 +908,6 @@ void DfgGraph::removeVertex(DfgVertex& vtx) {
         m_opVertices.unlink(&vtx);
     }
     vtx.m_userCnt = 0;
-    vtx.m_graphp = nullptr;
 }
 
 void DfgGraph::forEachVertex(std::function<void(DfgVertex&)> f) {
@@ -0,0 +1,266 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Break false combinational cycles in DfgGraph
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+//
+// Many apparent combinational cycles go through different bits of the same
+// packed variable, e.g.:
+//      assign x[0] = a;
+//      assign x[1] = x[0] & b;
+// These are not real cycles, but as 'x' both reads and writes itself they
+// would cause an UNOPTFLAT warning, and settle loops at run time.
+//
+// For each select of a variable in a cyclic graph, we trace the selected
+// bits back through the drivers of the variable (concatenations, selects,
+// and bitwise operations), and replace the select with the expression
+// computing those bits. If no bit depends on itself, the graph becomes
+// acyclic.
+//
+//*************************************************************************
+
+#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+
+#include "V3Dfg.h"
+#include "V3DfgPasses.h"
+
+#include <tuple>
+#include <unordered_set>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+class DfgBreakCycles final {
+    // Limits on the effort spent tracing a single select
+    static constexpr size_t MAX_DEPTH = 64;  // Maximum depth of tracing
+    static constexpr size_t MAX_NEW_VERTICES = 1024;  // Maximum number of vertices created
+    static constexpr size_t MAX_CONE_SIZE = 100000;  // Maximum vertices visited in checking
+
+    // TYPES
+    using VarRange = std::tuple<const DfgVarPacked*, uint32_t, uint32_t>;
+    struct VarRangeHash final {
+        size_t operator()(const VarRange& item) const {
+            V3Hash hash{static_cast<uint64_t>(reinterpret_cast<uintptr_t>(std::get<0>(item)))};
+            hash += std::get<1>(item);
+            hash += std::get<2>(item);
+            return hash.value();
+        }
+    };
+
+    // STATE
+    DfgGraph& m_dfg;  // The graph being processed
+    V3DfgBreakCyclesContext& m_ctx;  // The context for stats
+    // Variable ranges being traced, to detect bits that depend on themselves
+    std::unordered_set<VarRange, VarRangeHash> m_tracing;
+    std::vector<DfgVertex*> m_newVertices;  // Vertices created by the current trace
+    size_t m_depth = 0;  // Current depth of tracing
+
+    // METHODS
+
+    // Whether the value of the variable is fully described by its drivers in the graph
+    static bool isTraceable(const DfgVarPacked& vtx) {
+        const AstVar* const varp = vtx.varp();
+        if (!vtx.isDrivenByDfg()) return false;
+        // Might be overridden
+        if (varp->isForced()) return false;
+        // Might be written by other logic
+        if (varp->user3() || vtx.hasExtRefs() || varp->isSigUserRWPublic()) return false;
+        return true;
+    }
+
+    template <typename Vertex>
+    Vertex* make(FileLine* flp, uint32_t width) {
+        Vertex* const vtxp = new Vertex{m_dfg, flp, DfgVertex::dtypeForWidth(width)};
+        m_newVertices.push_back(vtxp);
+        return vtxp;
+    }
+
+    DfgVertex* makeSel(DfgVertex* fromp, uint32_t lsb, uint32_t width) {
+        if (lsb == 0 && width == fromp->width()) return fromp;
+        DfgSel* const selp = make<DfgSel>(fromp->fileline(), width);
+        selp->fromp(fromp);
+        selp->lsb(lsb);
+        return selp;
+    }
+
+    DfgVertex* makeConcat(FileLine* flp, DfgVertex* lhsp, DfgVertex* rhsp) {
+        DfgConcat* const concatp = make<DfgConcat>(flp, lhsp->width() + rhsp->width());
+        concatp->lhsp(lhsp);
+        concatp->rhsp(rhsp);
+        return concatp;
+    }
+
+    // Trace the given bits of a bitwise binary operation
+    template <typename Vertex>
+    DfgVertex* traceBitwise(Vertex* vtxp, uint32_t lsb, uint32_t width) {
+        DfgVertex* const lhsp = trace(vtxp->lhsp(), lsb, width);
+        if (!lhsp) return nullptr;
+        DfgVertex* const rhsp = trace(vtxp->rhsp(), lsb, width);
+        if (!rhsp) return nullptr;
+        if (lhsp == vtxp->lhsp() && rhsp == vtxp->rhsp()) return makeSel(vtxp, lsb, width);
+        Vertex* const resp = make<Vertex>(vtxp->fileline(), width);
+        resp->lhsp(lhsp);
+        resp->rhsp(rhsp);
+        return resp;
+    }
+
+    // Trace the given bits of a variable through its drivers
+    DfgVertex* traceVar(DfgVarPacked* varp, uint32_t lsb, uint32_t width) {
+        if (!isTraceable(*varp)) return makeSel(varp, lsb, width);
+        // If these bits are already being traced, they depend on themselves
+        const VarRange key{varp, lsb, width};
+        if (!m_tracing.emplace(key).second) return nullptr;
+        DfgVertex* resultp = nullptr;
+        for (size_t i = 0; i < varp->arity(); ++i) {
+            DfgVertex* const driverp = varp->source(i);
+            if (!driverp) continue;
+            const uint32_t dLsb = varp->driverLsb(i);
+            const uint32_t dMsb = dLsb + driverp->width() - 1;
+            if (lsb < dLsb || lsb > dMsb) continue;
+            // Bits covered by this driver, the rest are traced separately
+            const uint32_t chunk = std::min(width, dMsb - lsb + 1);
+            DfgVertex* const lop = trace(driverp, lsb - dLsb, chunk);
+            if (!lop) break;
+            if (chunk == width) {
+                resultp = lop;
+                break;
+            }
+            DfgVertex* const hip = traceVar(varp, lsb + chunk, width - chunk);
+            if (hip) resultp = makeConcat(varp->fileline(), hip, lop);
+            break;
+        }
+        m_tracing.erase(key);
+        return resultp;
+    }
+
+    // Return a vertex computing the given bits of 'vtxp', not going through selects of variables
+    // that are driven in this graph. Returns nullptr if this is not possible.
+    DfgVertex* trace(DfgVertex* vtxp, uint32_t lsb, uint32_t width) {
+        if (m_depth >= MAX_DEPTH || m_newVertices.size() >= MAX_NEW_VERTICES) return nullptr;
+        ++m_depth;
+        DfgVertex* const resultp = traceImpl(vtxp, lsb, width);
+        --m_depth;
+        return resultp;
+    }
+
+    DfgVertex* traceImpl(DfgVertex* vtxp, uint32_t lsb, uint32_t width) {
+        if (DfgVarPacked* const varp = vtxp->cast<DfgVarPacked>()) {
+            return traceVar(varp, lsb, width);
+        }
+        if (DfgSel* const selp = vtxp->cast<DfgSel>()) {
+            return trace(selp->fromp(), selp->lsb() + lsb, width);
+        }
+        if (DfgConcat* const concatp = vtxp->cast<DfgConcat>()) {
+            DfgVertex* const rhsp = concatp->rhsp();
+            const uint32_t rWidth = rhsp->width();
+            if (lsb + width <= rWidth) return trace(rhsp, lsb, width);
+            if (lsb >= rWidth) return trace(concatp->lhsp(), lsb - rWidth, width);
+            DfgVertex* const lop = trace(rhsp, lsb, rWidth - lsb);
+            if (!lop) return nullptr;
+            DfgVertex* const hip = trace(concatp->lhsp(), 0, width - (rWidth - lsb));
+            if (!hip) return nullptr;
+            return makeConcat(concatp->fileline(), hip, lop);
+        }
+        if (DfgConst* const constp = vtxp->cast<DfgConst>()) {
+            if (lsb == 0 && width == constp->width()) return constp;
+            DfgConst* const resp = new DfgConst{m_dfg, constp->fileline(), width};
+            m_newVertices.push_back(resp);
+            resp->num().opSel(constp->num(), lsb + width - 1, lsb);
+            return resp;
+        }
+        if (DfgNot* const notp = vtxp->cast<DfgNot>()) {
+            DfgVertex* const srcp = trace(notp->lhsp(), lsb, width);
+            if (!srcp) return nullptr;
+            if (srcp == notp->lhsp()) return makeSel(notp, lsb, width);
+            DfgNot* const resp = make<DfgNot>(notp->fileline(), width);
+            resp->lhsp(srcp);
+            return resp;
+        }
+        if (DfgAnd* const andp = vtxp->cast<DfgAnd>()) return traceBitwise(andp, lsb, width);
+        if (DfgOr* const orp = vtxp->cast<DfgOr>()) return traceBitwise(orp, lsb, width);
+        if (DfgXor* const xorp = vtxp->cast<DfgXor>()) return traceBitwise(xorp, lsb, width);
+        // Cannot look inside other operations, their own selects are resolved separately
+        return makeSel(vtxp, lsb, width);
+    }
+
+    // Whether 'targetp' is in the cone of logic driving 'vtxp' (including 'vtxp')
+    static bool inCone(DfgVertex* vtxp, const DfgVertex* targetp) {
+        std::unordered_set<const DfgVertex*> visited;
+        std::vector<DfgVertex*> stack{vtxp};
+        while (!stack.empty()) {
+            DfgVertex* const currp = stack.back();
+            stack.pop_back();
+            if (currp == targetp) return true;
+            if (!visited.emplace(currp).second) continue;
+            // Give up, assume the worst
+            if (visited.size() > MAX_CONE_SIZE) return true;
+            currp->forEachSource([&](DfgVertex& src) { stack.push_back(&src); });
+        }
+        return false;
+    }
+
+    // Delete the vertices created by an unsuccessful trace
+    void deleteNewVertices() {
+        for (auto it = m_newVertices.rbegin(); it != m_newVertices.rend(); ++it) {
+            DfgVertex* const vtxp = *it;
+            UASSERT_OBJ(!vtxp->hasSinks(), vtxp, "Created vertex should be unused");
+            VL_DO_DANGLING(vtxp->unlinkDelete(m_dfg), vtxp);
+        }
+        m_newVertices.clear();
+    }
+
+    // Replace select with the logic computing the selected bits, return true if replaced
+    bool resolve(DfgSel* selp) {
+        DfgVarPacked* const varp = selp->fromp()->as<DfgVarPacked>();
+        UASSERT_OBJ(m_tracing.empty() && m_newVertices.empty(), selp, "Stale tracing state");
+        DfgVertex* const resultp = traceVar(varp, selp->lsb(), selp->width());
+        // Replacing with logic depending on the select itself would make a new cycle
+        if (!resultp || resultp == selp || inCone(resultp, selp)) {
+            deleteNewVertices();
+            return false;
+        }
+        m_newVertices.clear();
+        selp->replaceWith(resultp);
+        VL_DO_DANGLING(selp->unlinkDelete(m_dfg), selp);
+        ++m_ctx.m_selsResolved;
+        return true;
+    }
+
+    // CONSTRUCTOR
+    DfgBreakCycles(DfgGraph& dfg, V3DfgBreakCyclesContext& ctx)
+        : m_dfg{dfg}
+        , m_ctx{ctx} {}
+
+public:
+    static bool apply(DfgGraph& dfg, V3DfgBreakCyclesContext& ctx) {
+        DfgBreakCycles breakCycles{dfg, ctx};
+        // Gather selects of variables driven in this graph. Created vertices are not selects of
+        // traceable variables, so there is no need to revisit.
+        std::vector<DfgSel*> selps;
+        for (DfgVertexVar& vtx : dfg.varVertices()) {
+            DfgVarPacked* const varp = vtx.cast<DfgVarPacked>();
+            if (!varp || !isTraceable(*varp)) continue;
+            varp->forEachSink([&](DfgVertex& sink) {
+                if (DfgSel* const selp = sink.cast<DfgSel>()) selps.push_back(selp);
+            });
+        }
+        bool changed = false;
+        for (DfgSel* const selp : selps) {
+            if (breakCycles.resolve(selp)) changed = true;
+        }
+        return changed;
+    }
+};
+
+bool V3DfgPasses::breakCycles(DfgGraph& dfg, V3DfgBreakCyclesContext& ctx) {
+    return DfgBreakCycles::apply(dfg, ctx);
+}
@@ -18,7 +18,7 @@
 //
 //*************************************************************************
 
-#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+#include "V3PchAstMT.h"
 
 #include "V3DfgOptimizer.h"
 
@@ -26,6 +26,7 @@
 #include "V3Dfg.h"
 #include "V3DfgPasses.h"
 #include "V3Graph.h"
+#include "V3ThreadPool.h"
 #include "V3UniqueNames.h"
 
 #include <vector>
@@ -236,11 +237,90 @@ void V3DfgOptimizer::extract(AstNetlist* netlistp) {
     V3Global::dumpCheckGlobalTree("dfg-extract", 0, dumpTreeEitherLevel() >= 3);
 }
 
+// Apply the DFG optimizations to one module
+static void optimizeModule(AstModule* modp, V3DfgOptimizationContext& ctx) {
+    UINFO(4, "Applying DFG optimization to module '" << modp->name() << "'" << endl);
+    ++ctx.m_modules;
+
+    // Build the DFG of this module
+    const std::unique_ptr<DfgGraph> dfg{V3DfgPasses::astToDfg(*modp, ctx)};
+    if (dumpDfgLevel() >= 8) dfg->dumpDotFilePrefixed(ctx.prefix() + "whole-input");
+
+    // Extract the cyclic sub-graphs. We do this because a lot of the optimizations assume a
+    // DAG, and large, mostly acyclic graphs could not be optimized due to the presence of
+    // small cycles.
+    std::vector<std::unique_ptr<DfgGraph>> cyclicComponents
+        = dfg->extractCyclicComponents("cyclic");
+
+    // Try to break false cycles going through different bits of the same variable. The parts
+    // that become acyclic are optimized separately below.
+    std::vector<std::unique_ptr<DfgGraph>> brokenComponents;
+    if (v3Global.opt.fDfgBreakCycles()) {
+        std::vector<std::unique_ptr<DfgGraph>> stillCyclic;
+        for (auto& component : cyclicComponents) {
+            if (!V3DfgPasses::breakCycles(*component, ctx.m_breakCyclesContext)) {
+                stillCyclic.emplace_back(std::move(component));
+                continue;
+            }
+            V3DfgPasses::removeUnused(*component);
+            std::vector<std::unique_ptr<DfgGraph>> remaining
+                = component->extractCyclicComponents("cyclic");
+            if (remaining.empty()) ++ctx.m_breakCyclesContext.m_cyclesFixed;
+            for (auto& cyclicp : remaining) stillCyclic.emplace_back(std::move(cyclicp));
+            if (component->size()) brokenComponents.emplace_back(std::move(component));
+        }
+        cyclicComponents = std::move(stillCyclic);
+    }
+
+    // Split the remaining acyclic DFG into [weakly] connected components
+    const std::vector<std::unique_ptr<DfgGraph>>& acyclicComponents
+        = dfg->splitIntoComponents("acyclic");
+
+    // Quick sanity check
+    UASSERT_OBJ(dfg->size() == 0, modp, "DfgGraph should have become empty");
+
+    // For each acyclic component
+    for (auto& component : acyclicComponents) {
+        if (dumpDfgLevel() >= 7) component->dumpDotFilePrefixed(ctx.prefix() + "source");
+        // Optimize the component
+        V3DfgPasses::optimize(*component, ctx);
+        // Add back under the main DFG (we will convert everything back in one go)
+        dfg->addGraph(*component);
+    }
+
+    // Eliminate redundant variables. Run this on the whole acyclic DFG. It needs to traverse
+    // the module to perform variable substitutions. Doing this by component would do
+    // redundant traversals and can be extremely slow in large modules with many components.
+    V3DfgPasses::eliminateVars(*dfg, ctx.m_eliminateVarsContext);
+
+    // For each component made acyclic by breaking cycles
+    for (auto& component : brokenComponents) {
+        if (dumpDfgLevel() >= 7) component->dumpDotFilePrefixed(ctx.prefix() + "source");
+        V3DfgPasses::optimize(*component, ctx);
+        dfg->addGraph(*component);
+    }
+
+    // For each cyclic component
+    for (auto& component : cyclicComponents) {
+        if (dumpDfgLevel() >= 7) component->dumpDotFilePrefixed(ctx.prefix() + "source");
+        // Converting back to Ast assumes the 'regularize' pass was run, so we must run it
+        V3DfgPasses::regularize(*component, ctx.m_regularizeContext);
+        // Add back under the main DFG (we will convert everything back in one go)
+        dfg->addGraph(*component);
+    }
+
+    // Convert back to Ast
+    if (dumpDfgLevel() >= 8) dfg->dumpDotFilePrefixed(ctx.prefix() + "whole-optimized");
+    AstModule* const resultModp = V3DfgPasses::dfgToAst(*dfg, ctx);
+    UASSERT_OBJ(resultModp == modp, modp, "Should be the same module");
+}
+
 void V3DfgOptimizer::optimize(AstNetlist* netlistp, const string& label) {
     UINFO(2, __FUNCTION__ << ": " << endl);
 
     // NODE STATE
     // AstVar::user1 -> Used by V3DfgPasses::astToDfg, V3DfgPasses::eliminateVars
+    //                  AstNodeModule* declaring the variable (while partitioning modules)
     // AstVar::user2 -> bool: Flag indicating referenced by AstVarXRef (set just below)
     // AstVar::user3 -> bool: Flag indicating written by logic not representable as DFG
     //                        (set by V3DfgPasses::astToDfg)
@@ -250,61 +330,50 @@ void V3DfgOptimizer::optimize(AstNetlist* netlistp, const string& label) {
     // Mark cross-referenced variables
     netlistp->foreach([](const AstVarXRef* xrefp) { xrefp->varp()->user2(true); });
 
+    // The passes set state on, and may remove, the variables a module references. Modules
+    // referencing variables declared elsewhere (e.g. in packages) are optimized serially, the
+    // others in parallel, each with its own context.
+    std::vector<AstModule*> serialModps;
+    std::vector<AstModule*> parallelModps;
+    const bool parallel = v3Global.opt.verilateJobs() > 1 && !dumpDfgLevel();
+    {
+        const VNUser1InUse user1InUse;
+        if (parallel) {
+            for (AstNode* nodep = netlistp->modulesp(); nodep; nodep = nodep->nextp()) {
+                nodep->foreach([nodep](AstVar* varp) { varp->user1p(nodep); });
+            }
+        }
+        for (AstNode* nodep = netlistp->modulesp(); nodep; nodep = nodep->nextp()) {
+            // Only optimize proper modules
+            AstModule* const modp = VN_CAST(nodep, Module);
+            if (!modp) continue;
+            if (parallel && modp->forall([modp](const AstVarRef* refp) {  //
+                    return refp->varp()->user1p() == modp;
+                })) {
+                parallelModps.push_back(modp);
+            } else {
+                serialModps.push_back(modp);
+            }
+        }
+    }
+    UINFO(4, "  Modules in parallel: " << parallelModps.size() << endl);
+
     V3DfgOptimizationContext ctx{label};
 
     // Run the optimization phase
-    for (AstNode* nodep = netlistp->modulesp(); nodep; nodep = nodep->nextp()) {
-        // Only optimize proper modules
-        AstModule* const modp = VN_CAST(nodep, Module);
-        if (!modp) continue;
-
-        UINFO(4, "Applying DFG optimization to module '" << modp->name() << "'" << endl);
-        ++ctx.m_modules;
-
-        // Build the DFG of this module
-        const std::unique_ptr<DfgGraph> dfg{V3DfgPasses::astToDfg(*modp, ctx)};
-        if (dumpDfgLevel() >= 8) dfg->dumpDotFilePrefixed(ctx.prefix() + "whole-input");
-
-        // Extract the cyclic sub-graphs. We do this because a lot of the optimizations assume a
-        // DAG, and large, mostly acyclic graphs could not be optimized due to the presence of
-        // small cycles.
-        const std::vector<std::unique_ptr<DfgGraph>>& cyclicComponents
-            = dfg->extractCyclicComponents("cyclic");
-
-        // Split the remaining acyclic DFG into [weakly] connected components
-        const std::vector<std::unique_ptr<DfgGraph>>& acyclicComponents
-            = dfg->splitIntoComponents("acyclic");
-
-        // Quick sanity check
-        UASSERT_OBJ(dfg->size() == 0, nodep, "DfgGraph should have become empty");
-
-        // For each acyclic component
-        for (auto& component : acyclicComponents) {
-            if (dumpDfgLevel() >= 7) component->dumpDotFilePrefixed(ctx.prefix() + "source");
-            // Optimize the component
-            V3DfgPasses::optimize(*component, ctx);
-            // Add back under the main DFG (we will convert everything back in one go)
-            dfg->addGraph(*component);
+    for (AstModule* const modp : serialModps) optimizeModule(modp, ctx);
+    {
+        // Created and destroyed on this thread, which adds their stats to 'ctx'
+        std::vector<std::unique_ptr<V3DfgOptimizationContext>> modCtxps;
+        for (size_t i = 0; i < parallelModps.size(); ++i) {
+            modCtxps.emplace_back(new V3DfgOptimizationContext{ctx});
         }
-
-        // Eliminate redundant variables. Run this on the whole acyclic DFG. It needs to traverse
-        // the module to perform variable substitutions. Doing this by component would do
-        // redundant traversals and can be extremely slow in large modules with many components.
-        V3DfgPasses::eliminateVars(*dfg, ctx.m_eliminateVarsContext);
-
-        // For each cyclic component
-        for (auto& component : cyclicComponents) {
-            if (dumpDfgLevel() >= 7) component->dumpDotFilePrefixed(ctx.prefix() + "source");
-            // Converting back to Ast assumes the 'regularize' pass was run, so we must run it
-            V3DfgPasses::regularize(*component, ctx.m_regularizeContext);
-            // Add back under the main DFG (we will convert everything back in one go)
-            dfg->addGraph(*component);
+        V3ThreadScope threadScope;
+        for (size_t i = 0; i < parallelModps.size(); ++i) {
+            AstModule* const modp = parallelModps[i];
+            V3DfgOptimizationContext* const modCtxp = modCtxps[i].get();
+            threadScope.enqueue([modp, modCtxp]() { optimizeModule(modp, *modCtxp); });
         }
-
-        // Convert back to Ast
-        if (dumpDfgLevel() >= 8) dfg->dumpDotFilePrefixed(ctx.prefix() + "whole-optimized");
-        AstModule* const resultModp = V3DfgPasses::dfgToAst(*dfg, ctx);
-        UASSERT_OBJ(resultModp == modp, modp, "Should be the same module");
     }
 
     V3Global::dumpCheckGlobalTree("dfg-optimize", 0, dumpTreeEitherLevel() >= 3);
@@ -26,22 +26,47 @@
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 V3DfgCseContext::~V3DfgCseContext() {
+    if (m_parentp) {
+        m_parentp->m_eliminated += m_eliminated;
+        return;
+    }
     V3Stats::addStat("Optimizations, DFG " + m_label + " CSE, expressions eliminated",
                      m_eliminated);
 }
 
 V3DfgRegularizeContext::~V3DfgRegularizeContext() {
+    if (m_parentp) {
+        m_parentp->m_temporariesIntroduced += m_temporariesIntroduced;
+        return;
+    }
     V3Stats::addStat("Optimizations, DFG " + m_label + " Regularize, temporaries introduced",
                      m_temporariesIntroduced);
 }
 
 V3DfgEliminateVarsContext::~V3DfgEliminateVarsContext() {
+    if (m_parentp) {
+        m_parentp->m_varsReplaced += m_varsReplaced;
+        m_parentp->m_varsRemoved += m_varsRemoved;
+        return;
+    }
     V3Stats::addStat("Optimizations, DFG " + m_label + " EliminateVars, variables replaced",
                      m_varsReplaced);
     V3Stats::addStat("Optimizations, DFG " + m_label + " EliminateVars, variables removed",
                      m_varsRemoved);
 }
 
+V3DfgBreakCyclesContext::~V3DfgBreakCyclesContext() {
+    if (m_parentp) {
+        m_parentp->m_selsResolved += m_selsResolved;
+        m_parentp->m_cyclesFixed += m_cyclesFixed;
+        return;
+    }
+    V3Stats::addStat("Optimizations, DFG " + m_label + " BreakCycles, selects resolved",
+                     m_selsResolved);
+    V3Stats::addStat("Optimizations, DFG " + m_label + " BreakCycles, cycles fixed",
+                     m_cyclesFixed);
+}
+
 static std::string getPrefix(const std::string& label) {
     if (label.empty()) return "";
     std::string str = VString::removeWhitespace(label);
@@ -54,9 +79,43 @@ static std::string getPrefix(const std::string& label) {
 
 V3DfgOptimizationContext::V3DfgOptimizationContext(const std::string& label)
     : m_label{label}
-    , m_prefix{getPrefix(label)} {}
+    , m_prefix{getPrefix(label)}
+    , m_cseContext0{m_label + " 1st"}
+    , m_cseContext1{m_label + " 2nd"}
+    , m_peepholeContext{m_label}
+    , m_regularizeContext{m_label}
+    , m_eliminateVarsContext{m_label}
+    , m_breakCyclesContext{m_label} {}
+
+V3DfgOptimizationContext::V3DfgOptimizationContext(V3DfgOptimizationContext& parent)
+    : m_label{parent.m_label}
+    , m_prefix{parent.m_prefix}
+    , m_parentp{&parent}
+    , m_cseContext0{parent.m_cseContext0}
+    , m_cseContext1{parent.m_cseContext1}
+    , m_peepholeContext{parent.m_peepholeContext}
+    , m_regularizeContext{parent.m_regularizeContext}
+    , m_eliminateVarsContext{parent.m_eliminateVarsContext}
+    , m_breakCyclesContext{parent.m_breakCyclesContext} {}
 
 V3DfgOptimizationContext::~V3DfgOptimizationContext() {
+    if (m_parentp) {
+        m_parentp->m_modules += m_modules;
+        m_parentp->m_coalescedAssignments += m_coalescedAssignments;
+        m_parentp->m_inputEquations += m_inputEquations;
+        m_parentp->m_representable += m_representable;
+        m_parentp->m_nonRepDType += m_nonRepDType;
+        m_parentp->m_nonRepImpure += m_nonRepImpure;
+        m_parentp->m_nonRepTiming += m_nonRepTiming;
+        m_parentp->m_nonRepLhs += m_nonRepLhs;
+        m_parentp->m_nonRepNode += m_nonRepNode;
+        m_parentp->m_nonRepUnknown += m_nonRepUnknown;
+        m_parentp->m_nonRepVarRef += m_nonRepVarRef;
+        m_parentp->m_nonRepWidth += m_nonRepWidth;
+        m_parentp->m_resultEquations += m_resultEquations;
+        m_parentp->m_patternStats.add(m_patternStats);
+        return;
+    }
     const string prefix = "Optimizations, DFG " + m_label + " ";
     V3Stats::addStat(prefix + "General, modules", m_modules);
     V3Stats::addStat(prefix + "Ast2Dfg, coalesced assignments", m_coalescedAssignments);
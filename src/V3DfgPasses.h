@@ -28,20 +28,27 @@ class DfgGraph;
 
 //===========================================================================
 // Various context objects hold data that need to persist across invocations
-// of a DFG pass.
+// of a DFG pass. A context constructed from a parent context adds its
+// statistics to the parent when destroyed, instead of emitting them, so that
+// modules optimized in parallel can each use their own context.
 
 class V3DfgCseContext final {
     const std::string m_label;  // Label to apply to stats
+    V3DfgCseContext* const m_parentp = nullptr;  // Context to add stats to, instead of emitting
 
 public:
     VDouble0 m_eliminated;  // Number of common sub-expressions eliminated
     explicit V3DfgCseContext(const std::string& label)
         : m_label{label} {}
+    explicit V3DfgCseContext(V3DfgCseContext& parent)
+        : m_label{parent.m_label}
+        , m_parentp{&parent} {}
     ~V3DfgCseContext() VL_MT_DISABLED;
 };
 
 class V3DfgRegularizeContext final {
     const std::string m_label;  // Label to apply to stats
+    V3DfgRegularizeContext* const m_parentp = nullptr;  // Context to add stats to
 
     // Used to generate unique names for different DFGs within the same hashed name
     std::unordered_map<std::string, uint32_t> m_multiplicity;
@@ -53,11 +60,15 @@ public:
 
     explicit V3DfgRegularizeContext(const std::string& label)
         : m_label{label} {}
+    explicit V3DfgRegularizeContext(V3DfgRegularizeContext& parent)
+        : m_label{parent.m_label}
+        , m_parentp{&parent} {}
     ~V3DfgRegularizeContext() VL_MT_DISABLED;
 };
 
 class V3DfgEliminateVarsContext final {
     const std::string m_label;  // Label to apply to stats
+    V3DfgEliminateVarsContext* const m_parentp = nullptr;  // Context to add stats to
 
 public:
     VDouble0 m_varsReplaced;  // Number of variables replaced
@@ -65,12 +76,32 @@ public:
 
     explicit V3DfgEliminateVarsContext(const std::string& label)
         : m_label{label} {}
+    explicit V3DfgEliminateVarsContext(V3DfgEliminateVarsContext& parent)
+        : m_label{parent.m_label}
+        , m_parentp{&parent} {}
     ~V3DfgEliminateVarsContext() VL_MT_DISABLED;
 };
 
+class V3DfgBreakCyclesContext final {
+    const std::string m_label;  // Label to apply to stats
+    V3DfgBreakCyclesContext* const m_parentp = nullptr;  // Context to add stats to
+
+public:
+    VDouble0 m_selsResolved;  // Number of variable selects replaced with their drivers
+    VDouble0 m_cyclesFixed;  // Number of cyclic components made acyclic
+
+    explicit V3DfgBreakCyclesContext(const std::string& label)
+        : m_label{label} {}
+    explicit V3DfgBreakCyclesContext(V3DfgBreakCyclesContext& parent)
+        : m_label{parent.m_label}
+        , m_parentp{&parent} {}
+    ~V3DfgBreakCyclesContext() VL_MT_DISABLED;
+};
+
 class V3DfgOptimizationContext final {
     const std::string m_label;  // Label to add to stats, etc.
     const std::string m_prefix;  // Prefix to add to file dumps (derived from label)
+    V3DfgOptimizationContext* const m_parentp = nullptr;  // Context to add stats to
 
 public:
     VDouble0 m_modules;  // Number of modules optimized
@@ -87,15 +118,19 @@ public:
     VDouble0 m_nonRepWidth;  // Equations non-representable due to width mismatch
     VDouble0 m_resultEquations;  // Number of result combinational equations
 
-    V3DfgCseContext m_cseContext0{m_label + " 1st"};
-    V3DfgCseContext m_cseContext1{m_label + " 2nd"};
-    V3DfgPeepholeContext m_peepholeContext{m_label};
-    V3DfgRegularizeContext m_regularizeContext{m_label};
-    V3DfgEliminateVarsContext m_eliminateVarsContext{m_label};
+    V3DfgCseContext m_cseContext0;
+    V3DfgCseContext m_cseContext1;
+    V3DfgPeepholeContext m_peepholeContext;
+    V3DfgRegularizeContext m_regularizeContext;
+    V3DfgEliminateVarsContext m_eliminateVarsContext;
+    V3DfgBreakCyclesContext m_breakCyclesContext;
 
     V3DfgPatternStats m_patternStats;
 
     explicit V3DfgOptimizationContext(const std::string& label) VL_MT_DISABLED;
+    // Context of a module optimized in parallel with others. Its stats are added to 'parent'
+    // when it is destroyed, which must be on the main thread.
+    explicit V3DfgOptimizationContext(V3DfgOptimizationContext& parent) VL_MT_DISABLED;
     ~V3DfgOptimizationContext() VL_MT_DISABLED;
 
     const std::string& prefix() const { return m_prefix; }
@@ -104,36 +139,43 @@ public:
 namespace V3DfgPasses {
 //===========================================================================
 // Top level entry points
+//
+// The passes only modify the module of the given graph, and the variables
+// declared in it, so different modules may be processed concurrently, each
+// with its own context.
 //===========================================================================
 
 // Construct a DfGGraph representing the combinational logic in the given AstModule. The logic
 // that is represented by the graph is removed from the given AstModule. Returns the
 // constructed DfgGraph.
-DfgGraph* astToDfg(AstModule&, V3DfgOptimizationContext&) VL_MT_DISABLED;
+DfgGraph* astToDfg(AstModule&, V3DfgOptimizationContext&);
 
 // Optimize the given DfgGraph
-void optimize(DfgGraph&, V3DfgOptimizationContext&) VL_MT_DISABLED;
+void optimize(DfgGraph&, V3DfgOptimizationContext&);
 
 // Convert DfgGraph back into Ast, and insert converted graph back into its parent module.
 // Returns the parent module.
-AstModule* dfgToAst(DfgGraph&, V3DfgOptimizationContext&) VL_MT_DISABLED;
+AstModule* dfgToAst(DfgGraph&, V3DfgOptimizationContext&);
 
 //===========================================================================
 // Intermediate/internal operations
 //===========================================================================
 
+// Replace selects of variables in a cyclic graph with the logic driving the selected bits, to
+// break false cycles through different bits of the same variable. Returns true if changed.
+bool breakCycles(DfgGraph&, V3DfgBreakCyclesContext&);
 // Common subexpression elimination
-void cse(DfgGraph&, V3DfgCseContext&) VL_MT_DISABLED;
+void cse(DfgGraph&, V3DfgCseContext&);
 // Inline fully driven variables
-void inlineVars(DfgGraph&) VL_MT_DISABLED;
+void inlineVars(DfgGraph&);
 // Peephole optimizations
-void peephole(DfgGraph&, V3DfgPeepholeContext&) VL_MT_DISABLED;
+void peephole(DfgGraph&, V3DfgPeepholeContext&);
 // Regularize graph. This must be run before converting back to Ast.
-void regularize(DfgGraph&, V3DfgRegularizeContext&) VL_MT_DISABLED;
+void regularize(DfgGraph&, V3DfgRegularizeContext&);
 // Remove unused nodes
-void removeUnused(DfgGraph&) VL_MT_DISABLED;
+void removeUnused(DfgGraph&);
 // Eliminate (remove or replace) redundant variables. Also removes resulting unused logic.
-void eliminateVars(DfgGraph&, V3DfgEliminateVarsContext&) VL_MT_DISABLED;
+void eliminateVars(DfgGraph&, V3DfgEliminateVarsContext&);
 
 }  // namespace V3DfgPasses
 
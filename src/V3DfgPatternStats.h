@@ -167,6 +167,15 @@ public:
         });
     }
 
+    // Add the patterns accumulated by 'other'
+    void add(const V3DfgPatternStats& other) {
+        for (uint32_t i = MIN_PATTERN_DEPTH; i <= MAX_PATTERN_DEPTH; ++i) {
+            for (const auto& pair : other.m_patterCounts[i]) {
+                m_patterCounts[i][pair.first] += pair.second;
+            }
+        }
+    }
+
     void dump(const std::string& stage, std::ostream& os) {
         using Line = std::pair<std::string, size_t>;
         for (uint32_t i = MIN_PATTERN_DEPTH; i <= MAX_PATTERN_DEPTH; ++i) {
@@ -133,7 +133,13 @@ string EmitCBaseVisitorConst::cFuncArgs(const AstCFunc* nodep) {
                 } else if (nodep->funcPublic()) {
                     args += portp->cPubArgType(true, false);
                 } else {
-                    args += portp->vlArgType(true, false, true);
+                    // DPI import wrappers pass arguments by pointer, so take large
+                    // inputs by reference, avoiding a copy
+                    const bool asRef
+                        = nodep->dpiImportWrapper() && portp->isReadOnly()
+                          && (portp->isWide()
+                              || VN_IS(portp->dtypep()->skipRefp(), UnpackArrayDType));
+                    args += portp->vlArgType(true, false, true, "", asRef);
                 }
             }
         }
@@ -143,7 +149,13 @@ string EmitCBaseVisitorConst::cFuncArgs(const AstCFunc* nodep) {
 
 void EmitCBaseVisitorConst::emitCFuncHeader(const AstCFunc* funcp, const AstNodeModule* modp,
                                             bool withScope) {
-    if (funcp->slow()) putns(funcp, "VL_ATTR_COLD ");
+    // With GCC these also place the function in .text.unlikely or .text.hot, keeping
+    // hot code together to reduce instruction cache and TLB misses
+    if (funcp->emitSlow()) {
+        putns(funcp, "VL_ATTR_COLD ");
+    } else if (funcp->hot()) {
+        putns(funcp, "VL_ATTR_HOT ");
+    }
     if (!funcp->isConstructor() && !funcp->isDestructor()) {
         putns(funcp, funcp->rtnTypeVoid());
         puts(" ");
@@ -262,6 +274,11 @@ void EmitCBaseVisitorConst::emitVarDecl(const AstVar* nodep, bool asRef) {
                                   && name.substr(name.size() - suffix.size()) == suffix;
             if (beStatic) puts("static thread_local ");
         }
+        if (nodep->alignPage() && !asRef) {
+            puts("alignas(VL_PAGE_BYTES) ");
+        } else if (nodep->alignCacheLine() && !asRef) {
+            puts("alignas(VL_CACHE_LINE_BYTES) ");
+        }
         putns(nodep, nodep->vlArgType(true, false, false, "", asRef));
         puts(";\n");
     }
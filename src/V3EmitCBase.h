@@ -79,6 +79,15 @@ public:
     static bool isConstPoolMod(const AstNode* modp) {
         return modp == v3Global.rootp()->constPoolp()->modp();
     }
+    // Number of per-thread blocks of coverage counters, indexed by
+    // Verilated::coverSlot(), or 0 if all threads share atomic counters.
+    // Only a static schedule runs each thread function on its own thread.
+    static uint32_t coverBlocks() {
+        if (v3Global.opt.threads() <= 1 || v3Global.opt.threadsDynamic()) return 0;
+        uint32_t blocks = 1;
+        while (blocks < static_cast<uint32_t>(v3Global.opt.threads())) blocks <<= 1;
+        return blocks;
+    }
 };
 
 class EmitCBaseVisitorConst VL_NOT_FINAL : public VNVisitorConst, public EmitCBase {
@@ -138,6 +147,16 @@ public:
     static string ifNoProtect(const string& in) VL_MT_SAFE {
         return v3Global.opt.protectIds() ? "" : in;
     }
+    // Return true if the variable has a flag the model sets when writing it,
+    // so VPI value change callbacks need only compare flagged variables
+    static bool hasVpiChangedFlag(const AstVar* varp) {
+        return v3Global.opt.vpi() && (varp->isSigUserRdPublic() || varp->isSigUserRWPublic())
+               && !varp->isParam() && !varp->isStatic() && !varp->isFuncLocal()
+               && !varp->isPrimaryInish();
+    }
+    static string vpiChangedName(const AstVar* varp) {
+        return protect("__Vvpichg__" + varp->name());
+    }
     static string funcNameProtect(const AstCFunc* nodep, const AstNodeModule* modp = nullptr);
     static AstCFile* newCFile(const string& filename, bool slow, bool source);
     static AstCFile* createCFile(const string& filename, bool slow, bool source) VL_MT_SAFE;
@@ -20,9 +20,12 @@
 #include "V3EmitCConstInit.h"
 #include "V3File.h"
 #include "V3Stats.h"
+#include "V3ThreadPool.h"
 
 #include <algorithm>
 #include <cinttypes>
+#include <deque>
+#include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
@@ -30,68 +33,98 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 // Const pool emitter
 
 class EmitCConstPool final : public EmitCConstInit {
-    // TYPES
-    using OutCFilePair = std::pair<V3OutCFile*, AstCFile*>;
-
     // MEMBERS
-    uint32_t m_outFileCount = 0;
-    int m_outFileSize = 0;
+    std::deque<AstCFile*>& m_cfilesr;  // cfiles generated by this emit
     VDouble0 m_tablesEmitted;
     VDouble0 m_constsEmitted;
+    VDouble0 m_asmTablesEmitted;
 
     // METHODS
 
-    OutCFilePair newOutCFile() const {
+    void openOutputFile(uint32_t fileNum) {
         const string fileName = v3Global.opt.makeDir() + "/" + topClassName() + "__ConstPool_"
-                                + cvtToStr(m_outFileCount) + ".cpp";
-        AstCFile* const cfilep = newCFile(fileName, /* slow: */ true, /* source: */ true);
-        V3OutCFile* const ofp = new V3OutCFile{fileName};
-        ofp->putsHeader();
-        ofp->puts("// DESCRIPTION: Verilator output: Constant pool\n");
-        ofp->puts("//\n");
-        ofp->puts("\n");
-        ofp->puts("#include \"verilated.h\"\n");
-        return {ofp, cfilep};
+                                + cvtToStr(fileNum) + ".cpp";
+        AstCFile* const cfilep = createCFile(fileName, /* slow: */ true, /* source: */ true);
+        m_cfilesr.push_back(cfilep);
+        setOutputFile(new V3OutCFile{fileName}, cfilep);
+        putsHeader();
+        puts("// DESCRIPTION: Verilator output: Constant pool\n");
+        puts("//\n");
+        puts("\n");
+        puts("#include \"verilated.h\"\n");
     }
 
-    void maybeSplitCFile() {
-        if (v3Global.opt.outputSplit() && m_outFileSize < v3Global.opt.outputSplit()) return;
-        // Splitting file, so using parallel build.
-        v3Global.useParallelBuild(true);
-        // Close current file
-        closeOutputFile();
-        // Open next file
-        m_outFileSize = 0;
-        ++m_outFileCount;
-        const OutCFilePair outFileAndNodePair = newOutCFile();
-        setOutputFile(outFileAndNodePair.first, outFileAndNodePair.second);
-    }
-
-    void emitVars(const AstConstPool* poolp) {
-        std::vector<const AstVar*> varps;
-        for (AstNode* nodep = poolp->modp()->stmtsp(); nodep; nodep = nodep->nextp()) {
-            if (const AstVar* const varp = VN_CAST(nodep, Var)) varps.push_back(varp);
+    // Emit a large table as assembler data, which is much cheaper to compile than a C++
+    // initializer. The assembler defines the symbol with the layout of the VlUnpacked. Returns
+    // true if emitted, the C++ definition that follows is then only the fallback.
+    bool emitAsmTable(const AstVar* varp, const string& name) {
+        const int minElements = v3Global.opt.outputAsmTables();
+        if (!minElements) return false;
+        const AstUnpackArrayDType* const dtypep
+            = VN_CAST(varp->dtypep()->skipRefp(), UnpackArrayDType);
+        if (!dtypep || dtypep->elementsConst() < minElements) return false;
+        const AstBasicDType* const subp = VN_CAST(dtypep->subDTypep()->skipRefp(), BasicDType);
+        if (!subp || !subp->isIntegralOrPacked()) return false;
+        const AstInitArray* const initp = VN_CAST(varp->valuep(), InitArray);
+        if (!initp) return false;
+
+        // Values as in the VlUnpacked, each wide element is a VlWide of 32-bit words
+        const uint32_t elemWords = subp->isWide() ? subp->widthWords() : 1;
+        const uint32_t valueBytes = subp->isWide()       ? 4
+                                    : subp->isQuad()     ? 8
+                                    : subp->width() > 16 ? 4
+                                    : subp->width() > 8  ? 2
+                                                         : 1;
+        const string directive = valueBytes == 1 ? ".byte" : "." + cvtToStr(valueBytes) + "byte";
+        const uint64_t size = dtypep->elementsConst();
+
+        putns(varp, "#if defined(__GNUC__) && defined(__ELF__)\n");
+        ofp()->putsNoTracking("__asm__(\".pushsection .rodata\\n\"\n");
+        ofp()->putsNoTracking("        \".balign 8\\n\"\n");
+        ofp()->putsNoTracking("        \".globl " + name + "\\n\"\n");
+        ofp()->putsNoTracking("        \"" + name + ":");
+        // Each row closes the string of the previous one
+        uint32_t column = 0;
+        for (uint64_t n = 0; n < size; ++n) {
+            const AstConst* const constp = VN_AS(initp->getIndexDefaultedValuep(n), Const);
+            const V3Number& num = constp->num();
+            for (uint32_t w = 0; w < elemWords; ++w) {
+                if (column) {
+                    ofp()->putsNoTracking(",");
+                } else {
+                    ofp()->putsNoTracking("\\n\"\n        \"" + directive + " ");
+                }
+                if (subp->isWide()) {
+                    ofp()->printf("0x%" PRIx32, num.edataWord(w));
+                } else if (subp->isQuad()) {
+                    ofp()->printf("0x%" PRIx64, static_cast<uint64_t>(num.toUQuad()));
+                } else {
+                    ofp()->printf("0x%" PRIx32, num.toUInt());
+                }
+                column = (column + 1) % 16;
+            }
         }
+        ofp()->putsNoTracking("\\n\"\n");
+        const uint64_t bytes = size * elemWords * valueBytes;
+        ofp()->putsNoTracking("        \".size " + name + ", " + cvtToStr(bytes) + "\\n\"\n");
+        ofp()->putsNoTracking("        \".popsection\");\n");
+        puts("#else\n");
+        ++m_asmTablesEmitted;
+        return true;
+    }
 
-        if (varps.empty()) return;  // Constant pool is empty, so we are done
-
-        stable_sort(varps.begin(), varps.end(), [](const AstVar* ap, const AstVar* bp) {  //
-            return ap->name() < bp->name();
-        });
-
-        const OutCFilePair outFileAndNodePair = newOutCFile();
-        setOutputFile(outFileAndNodePair.first, outFileAndNodePair.second);
-
+    void emitVars(const std::vector<const AstVar*>& varps) {
         for (const AstVar* varp : varps) {
-            maybeSplitCFile();
             const string nameProtect = topClassName() + "__ConstPool__" + varp->nameProtect();
             puts("\n");
+            const bool asmTable = emitAsmTable(varp, nameProtect);
             putns(varp, "extern const ");
             putns(varp, varp->dtypep()->cType(nameProtect, false, false));
             putns(varp, " = ");
             UASSERT_OBJ(varp, varp->valuep(), "Var without value");
             iterateConst(varp->valuep());
             putns(varp, ";\n");
+            if (asmTable) puts("#endif\n");
             // Keep track of stats
             if (VN_IS(varp->dtypep(), UnpackArrayDType)) {
                 ++m_tablesEmitted;
@@ -99,21 +132,75 @@ class EmitCConstPool final : public EmitCConstInit {
                 ++m_constsEmitted;
             }
         }
-
-        closeOutputFile();
     }
 
-    // VISITORS
-    void visit(AstConst* nodep) override {
-        m_outFileSize += nodep->num().isString() ? 10 : nodep->isWide() ? nodep->widthWords() : 1;
-        EmitCConstInit::visit(nodep);
+    // Size of the value as emitted, in the units of --output-split. Tables emitted as
+    // assembler are counted as the initializer would be, so file boundaries do not depend
+    // on --output-asm-tables.
+    static uint64_t valueSize(const AstNode* nodep) {
+        if (const AstConst* const constp = VN_CAST(nodep, Const)) {
+            return constp->num().isString() ? 10 : constp->isWide() ? constp->widthWords() : 1;
+        }
+        const AstInitArray* const initp = VN_AS(nodep, InitArray);
+        uint64_t size = 0;
+        if (VN_IS(initp->dtypep()->skipRefp(), AssocArrayDType)) {
+            for (const auto& itr : initp->map()) {
+                size += valueSize(initp->getIndexValuep(itr.first));
+            }
+        } else {
+            const AstUnpackArrayDType* const dtypep
+                = VN_AS(initp->dtypep()->skipRefp(), UnpackArrayDType);
+            const uint64_t elements = dtypep->elementsConst();
+            for (uint64_t n = 0; n < elements; ++n) {
+                size += valueSize(initp->getIndexDefaultedValuep(n));
+            }
+        }
+        return size;
     }
 
 public:
-    explicit EmitCConstPool(AstConstPool* poolp) {
-        emitVars(poolp);
+    // Distribute the entries of the pool into output files. Split where the name of the next
+    // entry (a hash of its value) says so, between half and twice the --output-split size.
+    // The file boundaries then mostly do not move when entries are added or removed, and
+    // unchanged files can hit in ccache.
+    static std::vector<std::vector<const AstVar*>> partition(const AstConstPool* poolp) {
+        std::vector<const AstVar*> varps;
+        for (AstNode* nodep = poolp->modp()->stmtsp(); nodep; nodep = nodep->nextp()) {
+            if (const AstVar* const varp = VN_CAST(nodep, Var)) varps.push_back(varp);
+        }
+        stable_sort(varps.begin(), varps.end(), [](const AstVar* ap, const AstVar* bp) {  //
+            return ap->name() < bp->name();
+        });
+
+        std::vector<std::vector<const AstVar*>> files;
+        const uint64_t splitSize = v3Global.opt.outputSplit();
+        uint64_t size = 0;
+        for (const AstVar* varp : varps) {
+            const bool boundary = V3Hash{varp->name()}.value() % 4 == 0;
+            if (files.empty()
+                || (splitSize && size
+                    && (size >= 2 * splitSize || (boundary && 2 * size >= splitSize)))) {
+                // Splitting file, so using parallel build.
+                if (!files.empty()) v3Global.useParallelBuild(true);
+                files.emplace_back();
+                size = 0;
+            }
+            files.back().push_back(varp);
+            UASSERT_OBJ(varp->valuep(), varp, "Var without value");
+            size += valueSize(varp->valuep());
+        }
+        return files;
+    }
+
+    EmitCConstPool(uint32_t fileNum, const std::vector<const AstVar*>& varps,
+                   std::deque<AstCFile*>& cfilesr)
+        : m_cfilesr{cfilesr} {
+        openOutputFile(fileNum);
+        emitVars(varps);
+        closeOutputFile();
         V3Stats::addStatSum("ConstPool, Tables emitted", m_tablesEmitted);
         V3Stats::addStatSum("ConstPool, Constants emitted", m_constsEmitted);
+        V3Stats::addStatSum("ConstPool, Tables emitted as assembler", m_asmTablesEmitted);
     }
 };
 
@@ -122,5 +209,16 @@ public:
 
 void V3EmitC::emitcConstPool() {
     UINFO(2, __FUNCTION__ << ": " << endl);
-    EmitCConstPool(v3Global.rootp()->constPoolp());
+    const std::vector<std::vector<const AstVar*>> files
+        = EmitCConstPool::partition(v3Global.rootp()->constPoolp());
+    // Emit each file in parallel, adding them to the netlist in order
+    std::vector<std::deque<AstCFile*>> cfiles(files.size());
+    V3ThreadScope threadScope;
+    for (uint32_t i = 0; i < files.size(); ++i) {
+        threadScope.enqueue([i, &files, &cfiles] { EmitCConstPool{i, files[i], cfiles[i]}; });
+    }
+    threadScope.wait();
+    for (const auto& collr : cfiles) {
+        for (AstCFile* const cfilep : collr) v3Global.rootp()->addFilesp(cfilep);
+    }
 }
@@ -439,6 +439,22 @@ void EmitCFunc::emitCCallArgs(const AstNodeCCall* nodep, const string& selfPoint
     puts(")");
 }
 
+void EmitCFunc::emitVpiChangedFlags(const AstCFunc* funcp) {
+    // Flag the VPI visible variables this function writes as possibly changed.
+    // Setting on entry is conservative, callbacks still compare the values.
+    if (!v3Global.opt.vpi()) return;
+    std::set<std::pair<const AstVar*, string>> done;
+    funcp->foreach([&](const AstVarRef* refp) {
+        const AstVar* const varp = refp->varp();
+        if (!refp->access().isWriteOrRW() || !hasVpiChangedFlag(varp)) return;
+        if (refp->selfPointer().isEmpty() || VN_IS(EmitCParentModule::get(varp), Class)) return;
+        const string pointer = refp->selfPointerProtect(m_useSelfForThis);
+        if (!done.emplace(varp, pointer).second) return;
+        emitDereference(nullptr, pointer);
+        puts(vpiChangedName(varp) + " = 1U;\n");
+    });
+}
+
 void EmitCFunc::emitDereference(AstNode* nodep, const string& pointer) {
     if (pointer[0] == '(' && pointer[1] == '&') {
         // remove "address of" followed by immediate dereference
@@ -485,6 +501,30 @@ void EmitCFunc::emitCvtWideArray(AstNode* nodep, AstNode* fromp) {
     puts(")");
 }
 
+bool EmitCFunc::isWideBitOp(const AstNode* nodep) {
+    return nodep && nodep->isWide()
+           && (VN_IS(nodep, And) || VN_IS(nodep, Or) || VN_IS(nodep, Xor) || VN_IS(nodep, Not));
+}
+
+void EmitCFunc::emitWideBitExpr(AstNode* nodep) {
+    // Emit expression template of a tree of wide bitwise operators, see VlWideExpr
+    if (!isWideBitOp(nodep)) {
+        putns(nodep, "VlWideExpr{");
+        iterateConst(nodep);
+        puts("}");
+    } else if (const AstNot* const notp = VN_CAST(nodep, Not)) {
+        putns(nodep, "~");
+        emitWideBitExpr(notp->lhsp());
+    } else {
+        const AstNodeBiop* const biopp = VN_AS(nodep, NodeBiop);
+        putns(nodep, "(");
+        emitWideBitExpr(biopp->lhsp());
+        puts(VN_IS(nodep, And) ? " & " : VN_IS(nodep, Or) ? " | " : " ^ ");
+        emitWideBitExpr(biopp->rhsp());
+        puts(")");
+    }
+}
+
 void EmitCFunc::emitConstant(AstConst* nodep, AstVarRef* assigntop, const string& assignString) {
     // Put out constant set to the specified variable, or given variable in a string
     putns(nodep, "");
@@ -666,6 +706,28 @@ void EmitCFunc::emitVarReset(AstVar* varp, bool constructing) {
     }
 }
 
+bool EmitCFunc::resetToZero(const AstVar* varp, const AstBasicDType* basicp) {
+    return varp->attrFileDescr()  // Zero so we don't do file IO if never $fopen
+           || varp->isFuncLocal()  // Randomization too slow
+           || basicp->isZeroInit()
+           || (v3Global.opt.underlineZero() && !varp->name().empty() && varp->name()[0] == '_')
+           || (v3Global.opt.xInitial() == "fast" || v3Global.opt.xInitial() == "0");
+}
+
+const AstNodeDType* EmitCFunc::bulkResetDTypep(const AstVar* varp,
+                                               const AstUnpackArrayDType* adtypep) {
+    if (varp->valuep()) return nullptr;
+    if (v3Global.opt.xInitialEdge() && varp->isUsedClock()) return nullptr;
+    const AstNodeDType* elemDtypep = adtypep->subDTypep()->skipRefp();
+    while (const AstUnpackArrayDType* const subp = VN_CAST(elemDtypep, UnpackArrayDType)) {
+        if (subp->isSparse()) return nullptr;
+        elemDtypep = subp->subDTypep()->skipRefp();
+    }
+    if (!elemDtypep->isIntegralOrPacked()) return nullptr;
+    const AstBasicDType* const basicp = elemDtypep->basicp();
+    return basicp && !basicp->isOpaque() ? elemDtypep : nullptr;
+}
+
 string EmitCFunc::emitVarResetRecurse(const AstVar* varp, bool constructing,
                                       const string& varNameProtected, AstNodeDType* dtypep,
                                       int depth, const string& suffix) {
@@ -709,8 +771,21 @@ string EmitCFunc::emitVarResetRecurse(const AstVar* varp, bool constructing,
     } else if (VN_IS(dtypep, SampleQueueDType)) {
         return "";
     } else if (const AstUnpackArrayDType* const adtypep = VN_CAST(dtypep, UnpackArrayDType)) {
+        // Sparse arrays are zero when constructed, reset releases the pages
+        if (adtypep->isSparse()) {
+            return constructing ? "" : varNameProtected + suffix + ".clear();\n";
+        }
         UASSERT_OBJ(adtypep->hi() >= adtypep->lo(), varp,
                     "Should have swapped msb & lsb earlier.");
+        // Arrays of plain numbers are zeroed or randomized in bulk, instead of a loop per
+        // element, as large memories otherwise dominate model construction time
+        if (const AstNodeDType* const elemDtypep
+            = depth ? nullptr : bulkResetDTypep(varp, adtypep)) {
+            const string name = varNameProtected + suffix;
+            if (resetToZero(varp, elemDtypep->basicp())) return name + ".zero();\n";
+            return "VL_RAND_RESET_ARRAY(" + cvtToStr(elemDtypep->widthMin()) + ", &" + name
+                   + ", sizeof(" + name + "));\n";
+        }
         const string ivar = "__Vi"s + cvtToStr(depth);
         const string pre = ("for (int " + ivar + " = " + cvtToStr(0) + "; " + ivar + " < "
                             + cvtToStr(adtypep->elementsConst()) + "; ++" + ivar + ") {\n");
@@ -746,12 +821,7 @@ string EmitCFunc::emitVarResetRecurse(const AstVar* varp, bool constructing,
     } else if (basicp && basicp->isRandomGenerator()) {
         return "";
     } else if (basicp) {
-        const bool zeroit
-            = (varp->attrFileDescr()  // Zero so we don't do file IO if never $fopen
-               || varp->isFuncLocal()  // Randomization too slow
-               || (basicp && basicp->isZeroInit())
-               || (v3Global.opt.underlineZero() && !varp->name().empty() && varp->name()[0] == '_')
-               || (v3Global.opt.xInitial() == "fast" || v3Global.opt.xInitial() == "0"));
+        const bool zeroit = resetToZero(varp, basicp);
         const bool slow = !varp->isFuncLocal() && !varp->isClassMember();
         splitSizeInc(1);
         if (dtypep->isWide()) {  // Handle unpacked; not basicp->isWide
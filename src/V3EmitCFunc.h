@@ -120,6 +120,7 @@ class EmitCFunc VL_NOT_FINAL : public EmitCConstInit {
     int m_labelNum = 0;  // Next label number
     bool m_inUC = false;  // Inside an AstUCStmt or AstUCExpr
     bool m_emitConstInit = false;  // Emitting constant initializer
+    uint32_t m_coverPoints = 0;  // Number of points in current AstCoverDecl table
 
     // State associated with processing $display style string formatting
     struct EmitDispState final {
@@ -205,12 +206,18 @@ public:
                     AstNode* thsp);
     void emitCCallArgs(const AstNodeCCall* nodep, const string& selfPointer, bool inProcess);
     void emitDereference(AstNode* nodep, const string& pointer);
+    void emitVpiChangedFlags(const AstCFunc* funcp);
     void emitCvtPackStr(AstNode* nodep);
     void emitCvtWideArray(AstNode* nodep, AstNode* fromp);
+    static bool isWideBitOp(const AstNode* nodep);
+    void emitWideBitExpr(AstNode* nodep);
     void emitConstant(AstConst* nodep, AstVarRef* assigntop, const string& assignString);
     void emitConstantString(const AstConst* nodep);
     void emitSetVarConstant(const string& assignString, AstConst* constp);
     void emitVarReset(AstVar* varp, bool constructing);
+    static bool resetToZero(const AstVar* varp, const AstBasicDType* basicp);
+    static const AstNodeDType* bulkResetDTypep(const AstVar* varp,
+                                               const AstUnpackArrayDType* adtypep);
     string emitVarResetRecurse(const AstVar* varp, bool constructing,
                                const string& varNameProtected, AstNodeDType* dtypep, int depth,
                                const string& suffix);
@@ -360,6 +367,7 @@ public:
             // run faster.
             puts("auto& vlSelfRef = std::ref(*vlSelf).get();\n");
         }
+        emitVpiChangedFlags(nodep);
 
         if (nodep->initsp()) {
             putsDecoration(nodep, "// Init\n");
@@ -436,7 +444,8 @@ public:
             iterateAndNextConstNull(selp->rhsp());
             puts(", ");
         } else if (AstVar* const varp = AstVar::scVarRecurse(nodep->lhsp())) {
-            putnbs(varp, "VL_ASSIGN_");  // Set a systemC variable
+            // Set a systemC variable, with --sc-clocked-eval only if changed
+            putnbs(varp, v3Global.opt.scClockedEval() ? "VL_ASSIGNCHG_" : "VL_ASSIGN_");
             emitScIQW(varp);
             emitIQW(nodep);
             puts("(");
@@ -465,6 +474,16 @@ public:
             puts(", ");
             rhs = false;
             iterateAndNextConstNull(castp->fromp());
+        } else if (nodep->isWide() && VN_IS(nodep->lhsp(), VarRef)
+                   && isWideBitOp(nodep->rhsp())
+                   && (isWideBitOp(nodep->rhsp()->op1p()) || isWideBitOp(nodep->rhsp()->op2p()))) {
+            // Nested bitwise operators left by V3Premit, evaluate in one loop
+            putnbs(nodep, "VL_ASSIGN_WE(");
+            puts(cvtToStr(nodep->widthWords()) + ", ");
+            iterateAndNextConstNull(nodep->lhsp());
+            puts(", ");
+            rhs = false;
+            emitWideBitExpr(nodep->rhsp());
         } else if (nodep->isWide() && VN_IS(nodep->lhsp(), VarRef)  //
                    && !VN_IS(nodep->rhsp(), CExpr)  //
                    && !VN_IS(nodep->rhsp(), CMethodHard)  //
@@ -560,7 +579,8 @@ public:
             return;
         }
         // assignment case;
-        putns(nodep, "VL_NEW(" + prefixNameProtect(nodep->dtypep()) + ", "
+        putns(nodep, (nodep->noEscape() ? "VL_NEW_LOCAL("s : "VL_NEW("s)
+                         + prefixNameProtect(nodep->dtypep()) + ", "
                          + optionalProcArg(nodep->dtypep()) + "vlSymsp");
         putCommaIterateNext(nodep->argsp(), true);
         puts(")");
@@ -615,23 +635,24 @@ public:
         iterateChildrenConst(nodep);
     }
     void visit(AstCoverDecl* nodep) override {
-        putns(nodep, "vlSelf->__vlCoverInsert(");  // As Declared in emitCoverageDecl
-        puts("&(vlSymsp->__Vcoverage[");
+        // Consecutive declarations are emitted as one table, inserted with one call,
+        // as a call per point is slow to compile and to run for large designs
+        const AstCoverDecl* const prevp = VN_CAST(nodep->backp(), CoverDecl);
+        if (!prevp || prevp->nextp() != nodep) {
+            putns(nodep, "{\n");
+            puts("static const VerilatedCovPoint __Vpoints[] = {\n");
+            m_coverPoints = 0;
+        }
+        ++m_coverPoints;
+        puts("{");
         puts(cvtToStr(nodep->dataDeclThisp()->binNum()));
-        puts("])");
-        // If this isn't the first instantiation of this module under this
-        // design, don't really count the bucket, and rely on verilator_cov to
-        // aggregate counts.  This is because Verilator combines all
-        // hierarchies itself, and if verilator_cov also did it, you'd end up
-        // with (number-of-instant) times too many counts in this bin.
-        puts(", first");  // Enable, passed from __Vconfigure parameter
-        puts(", ");
-        putsQuoted(protect(nodep->fileline()->filename()));
         puts(", ");
         puts(cvtToStr(nodep->fileline()->lineno()));
         puts(", ");
         puts(cvtToStr(nodep->offset() + nodep->fileline()->firstColumn()));
         puts(", ");
+        putsQuoted(protect(nodep->fileline()->filename()));
+        puts(", ");
         putsQuoted((!nodep->hier().empty() ? "." : "")
                    + protectWordsIf(nodep->hier(), nodep->protect()));
         puts(", ");
@@ -640,10 +661,50 @@ public:
         putsQuoted(protectWordsIf(nodep->comment(), nodep->protect()));
         puts(", ");
         putsQuoted(nodep->linescov());
+        puts("},\n");
+        if (VN_IS(nodep->nextp(), CoverDecl)) return;
+        puts("};\n");
+        puts("vlSymsp->_vm_contextp__->coveragep()->_insertTable(vlSelf->name(), ");
+        const uint32_t blocks = coverBlocks();
+        puts(blocks                               ? "&vlSymsp->__Vcoverage[0][0]"
+             : v3Global.opt.threads() > 1 ? "reinterpret_cast<uint32_t*>(vlSymsp->__Vcoverage)"
+                                          : "vlSymsp->__Vcoverage");
+        // If this isn't the first instantiation of this module under this
+        // design, don't really count the bucket, and rely on verilator_cov to
+        // aggregate counts.  This is because Verilator combines all
+        // hierarchies itself, and if verilator_cov also did it, you'd end up
+        // with (number-of-instant) times too many counts in this bin.
+        puts(", first");  // Enable, passed from __Vconfigure parameter
+        puts(", __Vpoints, " + cvtToStr(m_coverPoints));
+        if (blocks) {
+            puts(", " + cvtToStr(blocks) + ", sizeof(vlSymsp->__Vcoverage[0]) / sizeof(uint32_t)");
+            puts(v3Global.opt.coverageToggleSaturate() ? ", true" : ", false");
+        }
         puts(");\n");
+        puts("}\n");
+    }
+    // Index of this thread's block of coverage counters, see coverBlocks()
+    static string coverSlot() {
+        const uint32_t blocks = coverBlocks();
+        if (!blocks) return "";
+        return "[Verilated::coverSlot() & " + cvtToStr(blocks - 1) + "]";
     }
     void visit(AstCoverInc* nodep) override {
-        if (v3Global.opt.threads() > 1) {
+        if (nodep->toggledp()) {
+            // Expression coverage also counts bits, but never saturates
+            const bool saturate = v3Global.opt.coverageToggleSaturate()
+                                  && VString::startsWith(nodep->declp()->page(), "v_toggle");
+            putns(nodep, saturate ? "VL_COVER_TOGGLE_SAT(" : "VL_COVER_TOGGLE(");
+            puts("&vlSymsp->__Vcoverage" + coverSlot() + "[");
+            puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
+            puts("], ");
+            iterateConst(nodep->toggledp());
+            puts(");\n");
+        } else if (coverBlocks()) {
+            putns(nodep, "++(vlSymsp->__Vcoverage" + coverSlot() + "[");
+            puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
+            puts("]);\n");
+        } else if (v3Global.opt.threads() > 1) {
             putns(nodep, "vlSymsp->__Vcoverage[");
             puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
             puts("].fetch_add(1, std::memory_order_relaxed);\n");
@@ -688,8 +749,8 @@ public:
             // $dumpall currently ignored
             break;
         case VDumpCtlType::FLUSH:
-            // $dumpall currently ignored; would need rework of VCD single thread,
-            // or flag we pass-through to next eval() iteration
+            // Flushes all trace files, also triggers writing a VCD time window
+            if (v3Global.opt.trace()) putns(nodep, "Verilated::runFlushCallbacks();\n");
             break;
         case VDumpCtlType::LIMIT:
             // $dumplimit currently ignored
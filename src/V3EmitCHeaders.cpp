@@ -19,10 +19,13 @@
 #include "V3EmitC.h"
 #include "V3EmitCConstInit.h"
 #include "V3File.h"
+#include "V3ThreadPool.h"
 #include "V3UniqueNames.h"
 
 #include <algorithm>
 #include <cstdint>
+#include <deque>
+#include <list>
 #include <set>
 #include <string>
 #include <vector>
@@ -130,6 +133,12 @@ class EmitCHeader final : public EmitCConstInit {
         } else {  // not class
             putsDecoration(nullptr, "\n// INTERNAL VARIABLES\n");
             puts(symClassName() + "* const vlSymsp;\n");
+            for (const AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+                const AstVar* const varp = VN_CAST(nodep, Var);
+                if (varp && hasVpiChangedFlag(varp)) {
+                    putns(varp, "CData " + vpiChangedName(varp) + " = 1U;\n");
+                }
+            }
         }
     }
     void emitParamDecls(const AstNodeModule* modp) {
@@ -171,15 +180,6 @@ class EmitCHeader final : public EmitCConstInit {
             puts("void " + protect("__Vconfigure") + "(bool first);\n");
         }
 
-        if (v3Global.opt.coverage() && !VN_IS(modp, Class)) {
-            decorateFirst(first, section);
-            puts("void __vlCoverInsert(");
-            puts(v3Global.opt.threads() > 1 ? "std::atomic<uint32_t>" : "uint32_t");
-            puts("* countp, bool enable, const char* filenamep, int lineno, int column,\n");
-            puts("const char* hierp, const char* pagep, const char* commentp, const char* "
-                 "linescovp);\n");
-        }
-
         if (v3Global.opt.savable()) {
             decorateFirst(first, section);
             puts("void " + protect("__Vserialize") + "(VerilatedSerialize& os);\n");
@@ -604,12 +604,13 @@ class EmitCHeader final : public EmitCConstInit {
         emitTextSection(modp, VNType::atScHdrPost);
     }
 
-    explicit EmitCHeader(const AstNodeModule* modp) {
+    EmitCHeader(const AstNodeModule* modp, std::deque<AstCFile*>& cfilesr) {
         UINFO(5, "  Emitting header for " << prefixNameProtect(modp) << endl);
 
         // Open output file
         const string filename = v3Global.opt.makeDir() + "/" + prefixNameProtect(modp) + ".h";
-        AstCFile* const cfilep = newCFile(filename, /* slow: */ false, /* source: */ false);
+        AstCFile* const cfilep = createCFile(filename, /* slow: */ false, /* source: */ false);
+        cfilesr.push_back(cfilep);
         V3OutCFile* const ofilep
             = v3Global.opt.systemC() ? new V3OutScFile{filename} : new V3OutCFile{filename};
 
@@ -658,7 +659,9 @@ class EmitCHeader final : public EmitCConstInit {
     ~EmitCHeader() override = default;
 
 public:
-    static void main(const AstNodeModule* modp) { EmitCHeader emitCHeader{modp}; }
+    static void main(const AstNodeModule* modp, std::deque<AstCFile*>& cfilesr) VL_MT_STABLE {
+        EmitCHeader emitCHeader{modp, cfilesr};
+    }
 };
 
 //######################################################################
@@ -667,9 +670,21 @@ public:
 void V3EmitC::emitcHeaders() {
     UINFO(2, __FUNCTION__ << ": " << endl);
 
-    // Process each module in turn
+    std::list<std::deque<AstCFile*>> cfiles;
+    V3ThreadScope threadScope;
+
+    // Process each module in parallel
     for (const AstNode* nodep = v3Global.rootp()->modulesp(); nodep; nodep = nodep->nextp()) {
         if (VN_IS(nodep, Class)) continue;  // Declared with the ClassPackage
-        EmitCHeader::main(VN_AS(nodep, NodeModule));
+        const AstNodeModule* const modp = VN_AS(nodep, NodeModule);
+        cfiles.emplace_back();
+        auto& cfilesr = cfiles.back();
+        threadScope.enqueue([modp, &cfilesr] { EmitCHeader::main(modp, cfilesr); });
+    }
+    // Wait for futures
+    threadScope.wait();
+    // Add the files in module order, so the output is deterministic
+    for (const auto& collr : cfiles) {
+        for (AstCFile* const cfilep : collr) v3Global.rootp()->addFilesp(cfilep);
     }
 }
@@ -21,6 +21,7 @@
 #include "V3ThreadPool.h"
 #include "V3UniqueNames.h"
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <vector>
@@ -127,6 +128,10 @@ class EmitCGatherDependencies final : VNVisitorConst {
         addSymsDependency();
         iterateChildrenConst(nodep);
     }
+    void visit(AstTimePrecision* nodep) override {
+        addSymsDependency();
+        iterateChildrenConst(nodep);
+    }
     void visit(AstNodeSimpleText* nodep) override {
         if (nodep->text().find("vlSymsp") != string::npos) addSymsDependency();
         iterateChildrenConst(nodep);
@@ -274,6 +279,13 @@ class EmitCImp final : EmitCFunc {
                         puts(", ");
                         putns(varp, varp->nameProtect());
                         puts("{*symsp->_vm_contextp__}\n");
+                    } else if (varp->alignPage() && varp->valuep()) {
+                        // NUMA page markers, created after _ctor_var_reset
+                        puts(", ");
+                        putns(varp, varp->nameProtect());
+                        puts("{");
+                        iterateConst(varp->valuep());
+                        puts("}\n");
                     }
                 }
             }
@@ -306,44 +318,6 @@ class EmitCImp final : EmitCFunc {
         puts("}\n");
         splitSizeInc(10);
     }
-    void emitCoverageImp() {
-        if (v3Global.opt.coverage()) {
-            puts("\n// Coverage\n");
-            // Rather than putting out VL_COVER_INSERT calls directly, we do it via this
-            // function. This gets around gcc slowness constructing all of the template
-            // arguments.
-            puts("void " + prefixNameProtect(m_modp) + "::__vlCoverInsert(");
-            puts(v3Global.opt.threads() > 1 ? "std::atomic<uint32_t>" : "uint32_t");
-            puts("* countp, bool enable, const char* filenamep, int lineno, int column,\n");
-            puts("const char* hierp, const char* pagep, const char* commentp, const char* "
-                 "linescovp) "
-                 "{\n");
-            if (v3Global.opt.threads() > 1) {
-                puts("assert(sizeof(uint32_t) == sizeof(std::atomic<uint32_t>));\n");
-                puts("uint32_t* count32p = reinterpret_cast<uint32_t*>(countp);\n");
-            } else {
-                puts("uint32_t* count32p = countp;\n");
-            }
-            // static doesn't need save-restore as is constant
-            puts("static uint32_t fake_zero_count = 0;\n");
-            puts("std::string fullhier = std::string{VerilatedModule::name()} + hierp;\n");
-            puts("if (!fullhier.empty() && fullhier[0] == '.') fullhier = fullhier.substr(1);\n");
-            // Used for second++ instantiation of identical bin
-            puts("if (!enable) count32p = &fake_zero_count;\n");
-            puts("*count32p = 0;\n");
-            puts("VL_COVER_INSERT(vlSymsp->_vm_contextp__->coveragep(), VerilatedModule::name(), "
-                 "count32p,");
-            puts("  \"filename\",filenamep,");
-            puts("  \"lineno\",lineno,");
-            puts("  \"column\",column,\n");
-            puts("\"hier\",fullhier,");
-            puts("  \"page\",pagep,");
-            puts("  \"comment\",commentp,");
-            puts("  (linescovp[0] ? \"linescov\" : \"\"), linescovp);\n");
-            puts("}\n");
-            splitSizeInc(10);
-        }
-    }
     void emitDestructorImp(const AstNodeModule* modp) {
         puts("\n");
         putns(modp, prefixNameProtect(modp) + "::~" + prefixNameProtect(modp) + "() {\n");
@@ -395,23 +369,43 @@ class EmitCImp final : EmitCFunc {
                         } else if (varp->isStatic() && varp->isConst()) {
                         } else if (varp->basicp() && varp->basicp()->isTriggerVec()) {
                         } else if (VN_IS(varp->dtypep(), NBACommitQueueDType)) {
+                        } else if (VN_IS(varp->dtypeSkipRefp(), UnpackArrayDType)
+                                   && VN_AS(varp->dtypeSkipRefp(), UnpackArrayDType)->isSparse()) {
+                            // Sparse arrays save only allocated pages
+                            putns(varp, "os " + op + " " + varp->nameProtect() + ";\n");
                         } else {
-                            int vects = 0;
+                            std::vector<uint32_t> elements;  // Elements of each unpacked dimension
                             AstNodeDType* elementp = varp->dtypeSkipRefp();
                             for (AstUnpackArrayDType* arrayp = VN_CAST(elementp, UnpackArrayDType);
                                  arrayp; arrayp = VN_CAST(elementp, UnpackArrayDType)) {
-                                const int vecnum = vects++;
                                 UASSERT_OBJ(arrayp->hi() >= arrayp->lo(), varp,
                                             "Should have swapped msb & lsb earlier.");
-                                const string ivar = "__Vi"s + cvtToStr(vecnum);
-                                puts("for (int __Vi" + cvtToStr(vecnum) + " = " + cvtToStr(0));
-                                puts("; " + ivar + " < " + cvtToStr(arrayp->elementsConst()));
-                                puts("; ++" + ivar + ") {\n");
+                                elements.push_back(arrayp->elementsConst());
                                 elementp = arrayp->subDTypep()->skipRefp();
                             }
                             const AstBasicDType* const basicp = elementp->basicp();
                             // Do not save MTask state, only matters within an evaluation
                             if (basicp && basicp->keyword().isMTaskState()) continue;
+                            // Arrays of plain data are contiguous in memory, with the
+                            // same bytes as each element saved in turn, so save as one block
+                            if ((!elements.empty() || elementp->isWide())
+                                && (elementp->isIntegralOrPacked()
+                                    || (basicp && basicp->isDouble()))) {
+                                const string name = varp->nameProtect();
+                                // NOLINTNEXTLINE(performance-inefficient-string-concatenation)
+                                putns(varp, de ? "os.read(&" + name + ", sizeof(" + name + "));\n"
+                                               : "os.write(&" + name + ", sizeof(" + name
+                                                     + "));\n");
+                                continue;
+                            }
+                            int vects = 0;
+                            for (const uint32_t elems : elements) {
+                                const int vecnum = vects++;
+                                const string ivar = "__Vi"s + cvtToStr(vecnum);
+                                puts("for (int __Vi" + cvtToStr(vecnum) + " = " + cvtToStr(0));
+                                puts("; " + ivar + " < " + cvtToStr(elems));
+                                puts("; ++" + ivar + ") {\n");
+                            }
                             // Want to detect types that are represented as arrays
                             // (i.e. packed types of more than 64 bits).
                             if (elementp->isWide()
@@ -429,6 +423,15 @@ class EmitCImp final : EmitCFunc {
                         }
                     }
                 }
+                // Restored values may differ from those VPI callbacks last saw
+                if (de) {
+                    for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+                        const AstVar* const varp = VN_CAST(nodep, Var);
+                        if (varp && hasVpiChangedFlag(varp)) {
+                            puts(vpiChangedName(varp) + " = 1U;\n");
+                        }
+                    }
+                }
 
                 puts("}\n");
             }
@@ -456,7 +459,6 @@ class EmitCImp final : EmitCFunc {
                 emitCtorImp(modp);
                 emitConfigureImp(modp);
                 emitDestructorImp(modp);
-                emitCoverageImp();
             }
             emitSavableImp(modp);
         } else {
@@ -498,7 +500,7 @@ class EmitCImp final : EmitCFunc {
                     if (funcp->isTrace()) continue;
                     if (funcp->dpiImportPrototype()) continue;
                     if (funcp->dpiExportDispatcher()) continue;
-                    if (funcp->slow() != m_slow) continue;
+                    if (funcp->emitSlow() != m_slow) continue;
                     const auto& depSet = EmitCGatherDependencies::gather(funcp);
                     depSet2funcps[depSet].push_back(funcp);
                 }
@@ -511,7 +513,10 @@ class EmitCImp final : EmitCFunc {
         }
 
         // Emit all functions in each dependency set into separate files
-        for (const auto& pair : depSet2funcps) {
+        for (auto& pair : depSet2funcps) {
+            // Emit hot functions first, so when splitting they end up together
+            std::stable_partition(pair.second.begin(), pair.second.end(),
+                                  [](const AstCFunc* funcp) { return funcp->hot(); });
             m_requiredHeadersp = &pair.first;
             // Compute the hash of the dependencies, so we can add it to the filenames to
             // disambiguate them
@@ -589,6 +594,8 @@ class EmitCTrace final : EmitCFunc {
     V3OutCFile* m_typesFp = nullptr;  // File for type declarations
     int m_traceTypeSubs = 0;  // Number of trace type declaration sub-functions
     int m_typeSplitSize = 0;  // # of cfunc nodes placed into output file
+    bool m_declTable = false;  // Emitting current function's declarations as a table
+    size_t m_declTableRows = 0;  // Rows emitted into current declaration table
 
     // METHODS
     void openNextOutputFile() {
@@ -702,20 +709,36 @@ class EmitCTrace final : EmitCFunc {
         return varp->isSc() && (varp->isScUint() || varp->isScUintBool());
     }
 
-    void emitTraceInitOne(AstTraceDecl* nodep, int enumNum) {
-        if (nodep->dtypep()->basicp()->isDouble()) {
-            puts("tracep->declDouble(");
-        } else if (nodep->isWide()) {
-            puts("tracep->declArray(");
-        } else if (nodep->isQuad()) {
-            puts("tracep->declQuad(");
-        } else if (nodep->bitRange().ranged()) {
-            puts("tracep->declBus(");
-        } else if (nodep->dtypep()->basicp()->isEvent()) {
-            puts("tracep->declEvent(");
+    static string traceDeclOp(const AstTraceDecl* nodep) {
+        if (nodep->dtypep()->basicp()->isDouble()) return "Double";
+        if (nodep->isWide()) return "Array";
+        if (nodep->isQuad()) return "Quad";
+        if (nodep->bitRange().ranged()) return "Bus";
+        if (nodep->dtypep()->basicp()->isEvent()) return "Event";
+        return "Bit";
+    }
+
+    static string traceDeclAttrs(const AstTraceDecl* nodep) {
+        string out;
+        // Direction
+        if (nodep->declDirection().isInout()) {
+            out += ", VerilatedTraceSigDirection::INOUT";
+        } else if (nodep->declDirection().isWritable()) {
+            out += ", VerilatedTraceSigDirection::OUTPUT";
+        } else if (nodep->declDirection().isNonOutput()) {
+            out += ", VerilatedTraceSigDirection::INPUT";
         } else {
-            puts("tracep->declBit(");
+            out += ", VerilatedTraceSigDirection::NONE";
         }
+        // Kind
+        out += ", VerilatedTraceSigKind::"s + nodep->varType().traceSigKind();
+        // Type
+        out += ", VerilatedTraceSigType::"s + nodep->dtypep()->basicp()->keyword().traceSigType();
+        return out;
+    }
+
+    void emitTraceInitOne(AstTraceDecl* nodep, int enumNum) {
+        puts("tracep->decl" + traceDeclOp(nodep) + "(");
 
         // Code
         puts("c+" + cvtToStr(nodep->code()));
@@ -732,24 +755,8 @@ class EmitCTrace final : EmitCFunc {
         // Enum number
         puts("," + cvtToStr(enumNum));
 
-        // Direction
-        if (nodep->declDirection().isInout()) {
-            puts(", VerilatedTraceSigDirection::INOUT");
-        } else if (nodep->declDirection().isWritable()) {
-            puts(", VerilatedTraceSigDirection::OUTPUT");
-        } else if (nodep->declDirection().isNonOutput()) {
-            puts(", VerilatedTraceSigDirection::INPUT");
-        } else {
-            puts(", VerilatedTraceSigDirection::NONE");
-        }
-
-        // Kind
-        puts(", VerilatedTraceSigKind::");
-        puts(nodep->varType().traceSigKind());
-
-        // Type
-        puts(", VerilatedTraceSigType::");
-        puts(nodep->dtypep()->basicp()->keyword().traceSigType());
+        // Direction, kind and type
+        puts(traceDeclAttrs(nodep));
 
         // Array range
         if (nodep->arrayRange().ranged()) {
@@ -768,6 +775,57 @@ class EmitCTrace final : EmitCFunc {
         puts(");");
     }
 
+    // Declaration table rows, see VerilatedTraceDecl
+    static bool isDeclTableFunc(const AstCFunc* nodep) {
+        // Sub-functions made by V3TraceDecl hold only declarations, and define the base 'c'
+        if (!nodep->slow() || !nodep->initsp() || !nodep->stmtsp()) return false;
+        for (const AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            if (!VN_IS(stmtp, TraceDecl) && !VN_IS(stmtp, TracePushPrefix)
+                && !VN_IS(stmtp, TracePopPrefix)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    void emitDeclTableRow(const AstNode* nodep, const string& op, const string& name,
+                          const string& fields) {
+        if (nodep == m_cfuncp->stmtsp()) {
+            puts("static const VerilatedTraceDecl " + protect("__Vdecls") + "[] = {\n");
+        }
+        puts("{VerilatedTraceDeclOp::" + op + ", ");
+        if (op == "POP") {
+            puts("nullptr");
+        } else {
+            putsQuoted(name);
+        }
+        puts(fields + "},\n");
+        ++m_declTableRows;
+        if (!nodep->nextp()) {
+            puts("};\n");
+            puts("tracep->declTable(c, " + protect("__Vdecls") + ", "
+                 + cvtToStr(m_declTableRows) + ");\n");
+        }
+    }
+    void emitDeclTableRow(AstTraceDecl* nodep, int enumNum) {
+        string fields = ", " + cvtToStr(nodep->code()) + ", " + cvtToStr(nodep->fidx());
+        fields += ", " + cvtToStr(enumNum) + traceDeclAttrs(nodep);
+        if (nodep->arrayRange().ranged()) {
+            fields += ", " + cvtToStr(nodep->arrayRange().elements()) + ", "
+                      + cvtToStr(nodep->arrayRange().lo());
+        } else {
+            fields += ", 0, -1";
+        }
+        if (!nodep->dtypep()->basicp()->isDouble() && nodep->bitRange().ranged()) {
+            fields += ", " + cvtToStr(nodep->bitRange().left()) + ", "
+                      + cvtToStr(nodep->bitRange().right());
+        } else {
+            fields += ", 0, 0";
+        }
+        fields += ", {}";
+        emitDeclTableRow(nodep, VString::upcase(traceDeclOp(nodep)),
+                         VIdProtect::protectWordsIf(nodep->showname(), nodep->protect()), fields);
+    }
+
     int getEnumMapNum(AstEnumDType* nodep) {
         int enumNum = m_enumNumMap[nodep];
         if (!enumNum) {
@@ -913,9 +971,22 @@ class EmitCTrace final : EmitCFunc {
             openNextOutputFile();
         }
 
+        // Declarations are emitted as a table, to be much smaller and faster to run than
+        // a call per signal
+        VL_RESTORER(m_declTable);
+        VL_RESTORER(m_declTableRows);
+        m_declTable = isDeclTableFunc(nodep);
+        m_declTableRows = 0;
         EmitCFunc::visit(nodep);
     }
     void visit(AstTracePushPrefix* nodep) override {
+        if (m_declTable) {
+            emitDeclTableRow(nodep, "PUSH",
+                             VIdProtect::protectWordsIf(nodep->prefix(), nodep->protect()),
+                             ", 0, 0, 0, {}, {}, {}, 0, 0, 0, 0, VerilatedTracePrefixType::"s
+                                 + nodep->prefixType().ascii());
+            return;
+        }
         putns(nodep, "tracep->pushPrefix(");
         putsQuoted(VIdProtect::protectWordsIf(nodep->prefix(), nodep->protect()));
         puts(", VerilatedTracePrefixType::");
@@ -923,10 +994,18 @@ class EmitCTrace final : EmitCFunc {
         puts(");\n");
     }
     void visit(AstTracePopPrefix* nodep) override {  //
+        if (m_declTable) {
+            emitDeclTableRow(nodep, "POP", "", ", 0, 0, 0, {}, {}, {}, 0, 0, 0, 0, {}");
+            return;
+        }
         putns(nodep, "tracep->popPrefix();\n");
     }
     void visit(AstTraceDecl* nodep) override {
         const int enumNum = emitTraceDeclDType(nodep->dtypep());
+        if (m_declTable) {
+            emitDeclTableRow(nodep, enumNum);
+            return;
+        }
         putns(nodep, "");
         if (nodep->arrayRange().ranged()) {
             puts("for (int i = 0; i < " + cvtToStr(nodep->arrayRange().elements()) + "; ++i) {\n");
@@ -46,6 +46,32 @@ class EmitCModel final : public EmitCFunc {
         return funcps;
     }
 
+    // Clock inputs, in evalClock's enum
+    std::vector<const AstVar*> findClockInputps(AstNodeModule* modp) {
+        std::vector<const AstVar*> varps;
+        for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+            if (const AstVar* const varp = VN_CAST(nodep, Var)) {
+                if (varp->isPrimaryInish() && varp->isUsedClock()
+                    && !VN_IS(varp->dtypeSkipRefp(), UnpackArrayDType)) {
+                    varps.push_back(varp);
+                }
+            }
+        }
+        return varps;
+    }
+
+    // The clock input step() toggles, or nullptr if none. With --cycle-mode step() ticks
+    // instead, otherwise the model needs a single one bit clock input.
+    const AstVar* findStepClockp(AstNodeModule* modp) {
+        if (optSystemC() || v3Global.opt.cycleMode()) return nullptr;
+        const std::vector<const AstVar*> clockps = findClockInputps(modp);
+        if (clockps.size() != 1 || clockps[0]->width() != 1) return nullptr;
+        return clockps[0];
+    }
+    bool hasStep(AstNodeModule* modp) {
+        return v3Global.opt.cycleMode() || findStepClockp(modp);
+    }
+
     void putSectionDelimiter(const string& name) {
         puts("\n");
         puts("//============================================================\n");
@@ -200,6 +226,21 @@ class EmitCModel final : public EmitCFunc {
                 puts(";\n");
             }
         }
+        if (v3Global.opt.cycleMode()) {
+            puts("/// Evaluate one active edge of the clock, with --cycle-mode.\n");
+            puts("/// Application must call once per clock cycle instead of eval().\n");
+            puts("void tick();\n");
+        }
+        if (hasStep(modp)) {
+            puts("/// Evaluate the given number of clock cycles, returning early on $finish.\n");
+            if (!v3Global.opt.cycleMode()) {
+                puts("/// Each cycle sets the clock input to 0 then 1, evaluating each time.\n");
+            }
+            puts("/// If cb is given, it is called with datap after every cbEvery cycles.\n");
+            puts("/// Returns the number of cycles evaluated.\n");
+            puts("uint64_t step(uint64_t cycles, Verilated::VoidPCb cb = nullptr, "
+                 "void* datap = nullptr, uint64_t cbEvery = 1);\n");
+        }
         if (!optSystemC()) {
             puts("/// Simulation complete, run final blocks.  Application "
                  "must call on completion.\n");
@@ -211,6 +252,29 @@ class EmitCModel final : public EmitCFunc {
         puts("bool eventsPending();\n");
         puts("/// Returns time at next time slot. Aborts if !eventsPending()\n");
         puts("uint64_t nextTimeSlot();\n");
+        if (!optSystemC()) {
+            puts("/// Evaluate, then advance time to and evaluate each time slot with\n");
+            puts("/// events before the given time, then set the time to it.\n");
+            puts("/// Returns early on $finish.\n");
+            puts("void evalUntil(uint64_t time);\n");
+        }
+        if (!optSystemC()) {
+            const std::vector<const AstVar*> clockps = findClockInputps(modp);
+            if (!clockps.empty()) {
+                puts("/// Clock inputs, for evalClock()\n");
+                puts("enum Clock {");
+                string comma;
+                for (const AstVar* const varp : clockps) {
+                    puts(comma);
+                    comma = ", ";
+                    putns(varp, "CLK_" + varp->nameProtect());
+                }
+                puts("};\n");
+                puts("/// Evaluate the model. Application may call instead of eval() when only\n");
+                puts("/// the given clock input changed since the last evaluation.\n");
+                puts("void evalClock(Clock clock);\n");
+            }
+        }
 
         if (v3Global.opt.trace() || !optSystemC()) {
             puts("/// Trace signals in the model; called by application code\n");
@@ -281,11 +345,13 @@ class EmitCModel final : public EmitCFunc {
         if (optSystemC()) {
             puts("(sc_core::sc_module_name /* unused */)\n");
             puts("    : VerilatedModel{*Verilated::threadContextp()}\n");
-            puts("    , vlSymsp{new " + symClassName() + "(contextp(), name(), this)}\n");
+            puts("    , vlSymsp{new (contextp()) " + symClassName()
+                 + "(contextp(), name(), this)}\n");
         } else {
             puts(+"(VerilatedContext* _vcontextp__, const char* _vcname__)\n");
             puts("    : VerilatedModel{*_vcontextp__}\n");
-            puts("    , vlSymsp{new " + symClassName() + "(contextp(), _vcname__, this)}\n");
+            puts("    , vlSymsp{new (contextp()) " + symClassName()
+                 + "(contextp(), _vcname__, this)}\n");
         }
 
         // Set up IO references
@@ -321,12 +387,25 @@ class EmitCModel final : public EmitCFunc {
 
         if (optSystemC()) {
             // Create sensitivity list for when to evaluate the model.
-            putsDecoration(nullptr, "// Sensitivities on all clocks and combinational inputs\n");
+            // With --sc-clocked-eval, only clocks, if there are any; combinational inputs
+            // are then sampled by the evaluation at the next clock edge.
+            bool clocksOnly = false;
+            if (v3Global.opt.scClockedEval()) {
+                for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+                    if (const AstVar* const varp = VN_CAST(nodep, Var)) {
+                        if (varp->isNonOutput() && varp->isUsedClock()) clocksOnly = true;
+                    }
+                }
+            }
+            putsDecoration(nullptr, clocksOnly ? "// Sensitivities on all clocks\n"
+                                               : "// Sensitivities on all clocks and "
+                                                 "combinational inputs\n");
             puts("SC_METHOD(eval);\n");
             if (v3Global.usesTiming()) puts("SC_METHOD(eval_sens);\n");
             for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
                 if (const AstVar* const varp = VN_CAST(nodep, Var)) {
-                    if (varp->isNonOutput() && (varp->isScSensitive() || varp->isUsedClock())) {
+                    if (varp->isNonOutput()
+                        && ((varp->isScSensitive() && !clocksOnly) || varp->isUsedClock())) {
                         int vects = 0;
                         // This isn't very robust and may need cleanup for other data types
                         for (AstUnpackArrayDType* arrayp
@@ -388,6 +467,9 @@ class EmitCModel final : public EmitCFunc {
         puts("void " + topModNameProtected + "__" + protect("_eval_initial") + selfDecl + ";\n");
         puts("void " + topModNameProtected + "__" + protect("_eval_settle") + selfDecl + ";\n");
         puts("void " + topModNameProtected + "__" + protect("_eval") + selfDecl + ";\n");
+        if (v3Global.opt.cycleMode()) {
+            puts("void " + topModNameProtected + "__" + protect("_eval_tick") + selfDecl + ";\n");
+        }
 
         if (optSystemC() && v3Global.usesTiming()) {
             // ::eval
@@ -436,12 +518,97 @@ class EmitCModel final : public EmitCFunc {
             puts("vlSymsp->__Vm_executionProfilerp->configure();\n");
 
         puts("VL_DEBUG_IF(VL_DBG_MSGF(\"+ Eval\\n\"););\n");
-        puts(topModNameProtected + "__" + protect("_eval") + "(&(vlSymsp->TOP));\n");
+        emitTimedEval(topModNameProtected + "__" + protect("_eval") + "(&(vlSymsp->TOP));\n");
 
         putsDecoration(nullptr, "// Evaluate cleanup\n");
         puts("Verilated::endOfEval(vlSymsp->__Vm_evalMsgQp);\n");
 
         puts("}\n");
+
+        // ::tick
+        if (v3Global.opt.cycleMode()) {
+            puts("\nvoid " + topClassName() + "::tick() {\n");
+            puts("VL_DEBUG_IF(VL_DBG_MSGF(\"+++++TOP Evaluate " + topClassName()
+                 + "::tick\\n\"); );\n");
+            putsDecoration(nullptr, "// Initialize with a full evaluation\n");
+            puts("if (VL_UNLIKELY(!vlSymsp->__Vm_didInit)) eval_step();\n");
+            emitTickBody(modp);
+            puts("}\n");
+        }
+
+        // ::step
+        if (hasStep(modp)) {
+            puts("\nuint64_t " + topClassName()
+                 + "::step(uint64_t cycles, Verilated::VoidPCb cb, void* datap, "
+                   "uint64_t cbEvery) {\n");
+            if (v3Global.opt.cycleMode()) {
+                putsDecoration(nullptr, "// Initialize with a full evaluation\n");
+                puts("if (VL_UNLIKELY(!vlSymsp->__Vm_didInit)) eval_step();\n");
+            }
+            puts("uint64_t cycle = 0;\n");
+            puts("uint64_t untilCb = cbEvery;\n");
+            puts("while (cycle < cycles && VL_LIKELY(!contextp()->gotFinish())) {\n");
+            if (v3Global.opt.cycleMode()) {
+                emitTickBody(modp);
+            } else {
+                const string clockName = findStepClockp(modp)->nameProtect();
+                puts(clockName + " = 0;\n");
+                puts("eval();\n");
+                puts(clockName + " = 1;\n");
+                puts("eval();\n");
+            }
+            puts("++cycle;\n");
+            puts("if (cb && --untilCb == 0) {\n");
+            puts("cb(datap);\n");
+            puts("untilCb = cbEvery;\n");
+            puts("}\n");
+            puts("}\n");
+            puts("return cycle;\n");
+            puts("}\n");
+        }
+
+        // ::evalClock
+        const std::vector<const AstVar*> clockps = findClockInputps(modp);
+        if (!optSystemC() && !clockps.empty()) {
+            puts("\nvoid " + topClassName() + "::evalClock(Clock clock) {\n");
+            if (const AstVar* const skipp = v3Global.rootp()->icoSkipp()) {
+                putsDecoration(nullptr,
+                               "// Input combinational logic need not be evaluated if it does "
+                               "not read the clock\n");
+                puts("switch (clock) {\n");
+                for (const AstVar* const varp : clockps) {
+                    if (varp->isScSensitive()) continue;
+                    putns(varp, "case CLK_" + varp->nameProtect() + ": ");
+                    puts("vlSymsp->TOP." + skipp->nameProtect() + " = 1; break;\n");
+                }
+                puts("default: break;\n");
+                puts("}\n");
+            }
+            puts("eval();\n");
+            puts("}\n");
+        }
+    }
+
+    // Emit the call evaluating the model, recording its latency with --stats-runtime
+    void emitTimedEval(const string& evalCall) {
+        if (!v3Global.opt.statsRuntime() || v3Global.opt.hierChild()) {
+            puts(evalCall);
+            return;
+        }
+        puts("const uint64_t __VevalStartNs = VerilatedStatsRuntime::evalStartNs();\n");
+        puts(evalCall);
+        puts("vlSymsp->_vm_contextp__->statsRuntime().evalEnd(__VevalStartNs);\n");
+    }
+
+    // Evaluate one --cycle-mode clock edge, after initialization
+    void emitTickBody(AstNodeModule* modp) {
+        if (v3Global.opt.trace()) puts("vlSymsp->__Vm_activity = true;\n");
+        if (v3Global.hasEvents()) puts("vlSymsp->clearTriggeredEvents();\n");
+        if (v3Global.hasClasses()) puts("vlSymsp->__Vm_deleter.deleteAll();\n");
+        emitTimedEval(prefixNameProtect(modp) + "__" + protect("_eval_tick")
+                      + "(&(vlSymsp->TOP));\n");
+        puts("Verilated::endOfEval(vlSymsp->__Vm_evalMsgQp);\n");
+        if (v3Global.needTraceDumper()) puts("eval_end_step();\n");
     }
 
     void emitStandardMethods2(AstNodeModule* modp) {
@@ -478,6 +645,22 @@ class EmitCModel final : public EmitCFunc {
             puts("return 0;\n}\n");
         }
 
+        if (!optSystemC()) {
+            // ::evalUntil
+            puts("\n");
+            putns(modp, "void " + topClassName() + "::evalUntil(uint64_t time) {\n");
+            puts("eval();\n");
+            puts("while (eventsPending() && !contextp()->gotFinish()) {\n");
+            puts("const uint64_t nextTime = nextTimeSlot();\n");
+            puts("if (nextTime >= time) break;\n");
+            puts("contextp()->time(nextTime);\n");
+            puts("eval();\n");
+            puts("}\n");
+            puts("if (!contextp()->gotFinish() && contextp()->time() < time) "
+                 "contextp()->time(time);\n");
+            puts("}\n");
+        }
+
         putSectionDelimiter("Utilities");
 
         if (!optSystemC()) {
@@ -626,6 +809,7 @@ class EmitCModel final : public EmitCFunc {
 
         puts("\n");
         puts("#include \"" + pchClassName() + ".h\"\n");
+        puts("#include \"" + symClassName() + ".h\"\n");
         if (v3Global.opt.trace()) {
             puts("#include \"" + v3Global.opt.traceSourceLang() + ".h\"\n");
         }
@@ -53,9 +53,11 @@ public:
         of.puts("\n#include \"verilated.h\"\n");
         if (v3Global.dpi()) of.puts("#include \"verilated_dpi.h\"\n");
 
-        of.puts("\n");
-        of.puts("#include \"" + symClassName() + ".h\"\n");
-        of.puts("#include \"" + topClassName() + ".h\"\n");
+        if (v3Global.opt.fPchSyms()) {
+            of.puts("\n");
+            of.puts("#include \"" + symClassName() + ".h\"\n");
+            of.puts("#include \"" + topClassName() + ".h\"\n");
+        }
 
         of.puts("\n// Additional include files added using '--compiler-include'\n");
         for (const string& filename : v3Global.opt.compilerIncludes()) {
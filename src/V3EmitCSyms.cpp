@@ -16,6 +16,7 @@
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
 
+#include "V3Branch.h"
 #include "V3EmitC.h"
 #include "V3EmitCBase.h"
 #include "V3ExecGraph.h"
@@ -128,6 +129,43 @@ class EmitCSyms final : EmitCBaseVisitorConst {
     void emitDpiHdr();
     void emitDpiImp();
 
+    // Whether the function is a --dpi-export-handles call through a handle
+    static bool isDpiExportCall(const AstCFunc* nodep) {
+        return nodep->dpiExportDispatcher() && VString::endsWith(nodep->name(), "__Vcall");
+    }
+    // Make the arguments of the batched variant of the handle call 'nodep', each an array of
+    // the call's arguments, and the call's arguments for element '__Vi' of the arrays.
+    // Return false if it cannot be batched, as it has unpacked or open array arguments.
+    static bool dpiBatchArgs(const AstCFunc* nodep, string& batchArgs, string& callArgs) {
+        batchArgs = "const VlDpiExportHandle* __Vhandlep, int __Vn";
+        callArgs = "__Vhandlep";
+        if (nodep->rtnTypeVoid() != "void") {
+            batchArgs += ", " + nodep->rtnTypeVoid() + "* __Vrtnp";
+        }
+        for (const AstNode* stmtp = nodep->argsp(); stmtp; stmtp = stmtp->nextp()) {
+            const AstVar* const portp = VN_CAST(stmtp, Var);
+            if (!portp || !portp->isIO() || portp->isFuncReturn()) continue;
+            if (portp->isDpiOpenArray() || VN_IS(portp->dtypep()->skipRefp(), UnpackArrayDType)) {
+                return false;
+            }
+            const string type = portp->dpiArgType(false, false);
+            callArgs += ", ";
+            if (!portp->basicp()->isDpiPrimitive()) {
+                // Consecutive svBitVecVal or svLogicVecVal vectors
+                batchArgs += ", " + type + " " + portp->name();
+                callArgs += portp->name() + " + " + cvtToStr(VL_WORDS_I(portp->width()))
+                            + " * __Vi";
+            } else if (portp->isWritable()) {
+                batchArgs += ", " + type + " " + portp->name();
+                callArgs += portp->name() + " + __Vi";
+            } else {
+                batchArgs += ", " + type + " const* " + portp->name();
+                callArgs += portp->name() + "[__Vi]";
+            }
+        }
+        return true;
+    }
+
     static void nameCheck(AstNode* nodep) {
         // Prevent GCC compile time error; name check all things that reach C++ code
         if (nodep->name() != ""
@@ -479,7 +517,11 @@ void EmitCSyms::emitSymHdr() {
             puts("std::vector<VlEvent*> __Vm_triggeredEvents;\n");
         }
     }
-    if (v3Global.hasClasses()) puts("VlDeleter __Vm_deleter;\n");
+    if (v3Global.hasClasses()) {
+        // Without mtasks class objects are never shared between threads
+        puts(v3Global.opt.mtasks() ? "VlDeleter __Vm_deleter;\n"
+                                   : "VlDeleter __Vm_deleter{/* serial: */ true};\n");
+    }
     puts("bool __Vm_didInit = false;\n");
 
     if (v3Global.opt.mtasks()) {
@@ -488,6 +530,11 @@ void EmitCSyms::emitSymHdr() {
         puts("bool __Vm_even_cycle__ico = false;\n");
         puts("bool __Vm_even_cycle__act = false;\n");
         puts("bool __Vm_even_cycle__nba = false;\n");
+        if (v3Global.opt.threadsAdaptive()) {
+            puts("VlAdaptiveSchedule __Vm_adaptive__ico;\n");
+            puts("VlAdaptiveSchedule __Vm_adaptive__act;\n");
+            puts("VlAdaptiveSchedule __Vm_adaptive__nba;\n");
+        }
     }
 
     if (v3Global.opt.profExec()) {
@@ -507,16 +554,29 @@ void EmitCSyms::emitSymHdr() {
 
     if (m_coverBins) {
         puts("\n// COVERAGE\n");
-        puts(v3Global.opt.threads() > 1 ? "std::atomic<uint32_t>" : "uint32_t");
-        puts(" __Vcoverage[");
-        puts(cvtToStr(m_coverBins));
-        puts("];\n");
+        if (const uint32_t blocks = coverBlocks()) {
+            // Each thread counts in its own cache lines, summed when written
+            const int lineCounters = VL_CACHE_LINE_BYTES / sizeof(uint32_t);
+            const int stride = (m_coverBins + lineCounters - 1) / lineCounters * lineCounters;
+            puts("alignas(VL_CACHE_LINE_BYTES) uint32_t __Vcoverage[" + cvtToStr(blocks) + "]["
+                 + cvtToStr(stride) + "];\n");
+        } else {
+            puts(v3Global.opt.threads() > 1 ? "std::atomic<uint32_t>" : "uint32_t");
+            puts(" __Vcoverage[");
+            puts(cvtToStr(m_coverBins));
+            puts("];\n");
+        }
     }
 
     if (v3Global.opt.profPgo()) {
         puts("\n// PGO PROFILING\n");
         puts("VlPgoProfiler<" + std::to_string(ExecMTask::numUsedIds()) + "> _vm_pgoProfiler;\n");
     }
+    if (v3Global.opt.profPgoBranches()) {
+        puts("\n// PGO BRANCH PROFILING\n");
+        puts("VlPgoBranchProfiler<" + std::to_string(2 * V3Branch::profileLocations().size())
+             + "> _vm_pgoBranches;\n");
+    }
 
     if (!m_scopeNames.empty()) {  // Scope names
         puts("\n// SCOPE NAMES\n");
@@ -631,6 +691,7 @@ void EmitCSyms::emitSymImpPreamble() {
 
     // Includes
     puts("#include \"" + pchClassName() + ".h\"\n");
+    puts("#include \"" + symClassName() + ".h\"\n");
     puts("#include \"" + topClassName() + ".h\"\n");
     for (AstNodeModule* nodep = v3Global.rootp()->modulesp(); nodep;
          nodep = VN_AS(nodep->nextp(), NodeModule)) {
@@ -737,6 +798,16 @@ void EmitCSyms::emitSymImp() {
         puts("_vm_pgoProfiler.write(\"" + topClassName()
              + "\", _vm_contextp__->profVltFilename(), " + firstHierCall + ");\n");
     }
+    if (v3Global.opt.profPgoBranches()) {
+        // Append after the mtask data if there is any
+        const string firstHierCall
+            = (!v3Global.opt.profPgo()
+               && (v3Global.opt.hierBlocks().empty() || v3Global.opt.hierChild()))
+                  ? "true"
+                  : "false";
+        puts("_vm_pgoBranches.write(_vm_contextp__->profVltFilename(), " + firstHierCall
+             + ");\n");
+    }
     puts("}\n");
 
     if (v3Global.needTraceDumper()) {
@@ -842,12 +913,37 @@ void EmitCSyms::emitSymImp() {
                 for (const V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
                     const ExecMTask& mt = static_cast<const ExecMTask&>(vtx);
                     puts("_vm_pgoProfiler.addCounter(" + cvtToStr(mt.id()) + ", \"" + mt.hashName()
-                         + "\");\n");
+                         + "\", " + cvtToStr(mt.costEstimate()) + "ULL);\n");
                 }
             });
         }
     }
 
+    if (v3Global.opt.profPgoBranches()) {
+        puts("// Configure branch profiling for PGO\n");
+        for (const string& location : V3Branch::profileLocations()) {
+            puts("_vm_pgoBranches.addBranch(\"" + V3OutFormatter::quoteNameControls(location)
+                 + "\");\n");
+        }
+    }
+
+    if (v3Global.opt.profExec() && v3Global.opt.mtasks()) {
+        puts("// Configure profiling for sampling mode, +verilator+prof+exec+sample\n");
+        v3Global.rootp()->topModulep()->foreach([&](const AstExecGraph* execGraphp) {
+            for (const V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
+                const ExecMTask& mt = static_cast<const ExecMTask&>(vtx);
+                puts("__Vm_executionProfilerp->addMTask(\"" + topClassName() + "\", "
+                     + cvtToStr(mt.id()) + ", \"" + mt.hashName() + "\", "
+                     + cvtToStr(mt.costEstimate()) + "ULL);\n");
+                for (const V3GraphEdge& edge : mt.outEdges()) {
+                    const ExecMTask* const toMtp = edge.top()->as<ExecMTask>();
+                    puts("__Vm_executionProfilerp->addMTaskDep(" + cvtToStr(mt.id()) + ", "
+                         + cvtToStr(toMtp->id()) + ");\n");
+                }
+            }
+        });
+    }
+
     puts("// Configure time unit / time precision\n");
     if (!v3Global.rootp()->timeunit().isNone()) {
         puts("_vm_contextp__->timeunit(");
@@ -886,7 +982,7 @@ void EmitCSyms::emitSymImp() {
         AstScope* const scopep = i.first;
         AstNodeModule* const modp = i.second;
         checkSplit(false);
-        // first is used by AstCoverDecl's call to __vlCoverInsert
+        // first is used by AstCoverDecl's call to _insertTable
         const bool first = !modp->user1();
         modp->user1(true);
         putns(scopep, protectIf(scopep->nameDotless(), scopep->protect()) + "."
@@ -1011,6 +1107,16 @@ void EmitCSyms::emitSymImp() {
             puts(bounds);
             puts(");\n");
             ++m_numStmts;
+            if (hasVpiChangedFlag(varp)) {
+                putns(scopep, protect("__Vscope_" + it->second.m_scopeName));
+                puts(".varChangedInsert(__Vfinal,");
+                putsQuoted(protect(it->second.m_varBasePretty));
+                puts(", &(");
+                puts(protectIf(scopep->nameDotless(), scopep->protect()) + ".");
+                puts(vpiChangedName(varp));
+                puts("));\n");
+                ++m_numStmts;
+            }
         }
         m_ofpBase->puts("}\n");
     }
@@ -1050,6 +1156,20 @@ void EmitCSyms::emitDpiHdr() {
     puts("#endif\n");
     puts("\n");
 
+    if (v3Global.opt.dpiExportHandles()) {
+        puts("\n// DPI EXPORT HANDLES\n");
+        puts("// An export resolved in a scope by <export>__Vresolve, and called by\n");
+        puts("// <export>__Vcall, or <export>__Vbatch with arrays of the arguments\n");
+        // Same as in verilated.h
+        puts("#ifndef VL_DPI_EXPORT_HANDLE_DEFINED_\n");
+        puts("#define VL_DPI_EXPORT_HANDLE_DEFINED_\n");
+        puts("typedef struct VlDpiExportHandle {\n");
+        puts("const void* scopep;\n");
+        puts("void* cbp;\n");
+        puts("} VlDpiExportHandle;\n");
+        puts("#endif\n");
+    }
+
     int firstExp = 0;
     int firstImp = 0;
     for (AstCFunc* nodep : m_dpis) {
@@ -1059,6 +1179,12 @@ void EmitCSyms::emitDpiHdr() {
                                       + ifNoProtect(" at " + nodep->fileline()->ascii()) + "\n");
             putns(nodep, "extern " + nodep->rtnTypeVoid() + " " + nodep->nameProtect() + "("
                              + cFuncArgs(nodep) + ");\n");
+            string batchArgs;
+            string callArgs;
+            if (isDpiExportCall(nodep) && dpiBatchArgs(nodep, batchArgs, callArgs)) {
+                const string name = nodep->name().substr(0, nodep->name().size() - 7);
+                putns(nodep, "extern void " + name + "__Vbatch(" + batchArgs + ");\n");
+            }
         } else if (nodep->dpiImportPrototype()) {
             if (!firstImp++) puts("\n// DPI IMPORTS\n");
             putsDecoration(nodep, "// DPI import"
@@ -1116,6 +1242,16 @@ void EmitCSyms::emitDpiImp() {
             puts("// DPI export" + ifNoProtect(" at " + nodep->fileline()->ascii()) + "\n");
             putns(nodep, "return " + topClassName() + "::" + nodep->name() + "(");
             string comma;
+            // Names of the --dpi-export-handles arguments, each last in its declaration
+            const string& argTypes = nodep->argTypes();
+            for (size_t pos = 0; pos < argTypes.size();) {
+                const size_t end = std::min(argTypes.find(',', pos), argTypes.size());
+                const string arg = argTypes.substr(pos, end - pos);
+                puts(comma);
+                comma = ", ";
+                puts(arg.substr(arg.find_last_of(" *") + 1));
+                pos = end + 1;
+            }
             for (AstNode* stmtp = nodep->argsp(); stmtp; stmtp = stmtp->nextp()) {
                 if (const AstVar* const portp = VN_CAST(stmtp, Var)) {
                     if (portp->isIO() && !portp->isFuncReturn()) {
@@ -1127,6 +1263,17 @@ void EmitCSyms::emitDpiImp() {
             }
             puts(");\n");
             puts("}\n");
+            string batchArgs;
+            string callArgs;
+            if (isDpiExportCall(nodep) && dpiBatchArgs(nodep, batchArgs, callArgs)) {
+                const string name = nodep->name().substr(0, nodep->name().size() - 7);
+                putns(nodep, "void " + name + "__Vbatch(" + batchArgs + ") {\n");
+                puts("for (int __Vi = 0; __Vi < __Vn; ++__Vi) {\n");
+                if (nodep->rtnTypeVoid() != "void") puts("__Vrtnp[__Vi] = ");
+                puts(topClassName() + "::" + nodep->name() + "(" + callArgs + ");\n");
+                puts("}\n");
+                puts("}\n");
+            }
             puts("#endif\n");
             puts("\n");
         }
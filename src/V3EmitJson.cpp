@@ -0,0 +1,189 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Emit JSON tree for --json-only
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// V3EmitJson's Transformations:
+//
+// Stream the netlist through AstNode::dumpTreeJson to the .tree.json file.
+// With --json-only-split, write each module to its own file, in parallel
+// when --no-json-ids, leaving a stub in the main file naming that file.
+// With --json-only-index, also write an index giving the file, byte
+// offset and length of each module's JSON object.
+//
+//*************************************************************************
+
+#include "V3PchAstMT.h"
+
+#include "V3EmitJson.h"
+
+#include "V3File.h"
+#include "V3Os.h"
+#include "V3ThreadPool.h"
+
+#include <fstream>
+#include <memory>
+#include <vector>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+// Output file with a large stream buffer, as the output may be many GB
+
+class EmitJsonFile final {
+    static constexpr size_t BUFFER_SIZE = 1024 * 1024;
+    std::unique_ptr<char[]> m_bufp{new char[BUFFER_SIZE]};
+    std::ofstream m_os;
+
+public:
+    explicit EmitJsonFile(const string& filename) {
+        UINFO(2, "Dumping " << filename << endl);
+        V3File::addTgtDepend(filename);
+        m_os.rdbuf()->pubsetbuf(m_bufp.get(), BUFFER_SIZE);  // Must precede open
+        m_os.open(filename.c_str());
+        if (m_os.fail()) v3fatal("Can't write file: " << filename);
+    }
+    ~EmitJsonFile() = default;
+    std::ofstream& os() { return m_os; }
+};
+
+//######################################################################
+
+class EmitJson final {
+    // TYPES
+    struct ModuleEntry final {
+        const AstNodeModule* m_modp = nullptr;
+        string m_filename;  // File holding the module, without directory
+        uint64_t m_offset = 0;  // Byte offset of the module's object in the file
+        uint64_t m_length = 0;  // Length in bytes of the module's object
+    };
+
+    // MEMBERS
+    const string m_filename;  // Main output file
+    std::vector<ModuleEntry> m_modules;
+
+    // METHODS
+    string baseName() const {
+        const string suffix = ".json";
+        if (m_filename.size() > suffix.size()
+            && m_filename.compare(m_filename.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            return m_filename.substr(0, m_filename.size() - suffix.size());
+        }
+        return m_filename;
+    }
+    string shardFilename(size_t n) const { return baseName() + "__" + cvtToStr(n) + ".json"; }
+
+    static void emitModule(const string& filename, ModuleEntry& entry) {
+        EmitJsonFile file{filename};
+        std::ostream& os = file.os();
+        entry.m_modp->dumpTreeJson(os);
+        entry.m_length = static_cast<uint64_t>(os.tellp());
+        os << '\n';
+    }
+
+    void emitMain() {
+        const bool split = v3Global.opt.jsonOnlySplit();
+        const AstNetlist* const netlistp = v3Global.rootp();
+        EmitJsonFile file{m_filename};
+        std::ostream& os = file.os();
+        // As AstNode::dumpTreeJson, but with the modules separately
+        netlistp->dumpTreeJsonHead(os);
+        if (!netlistp->modulesp()) {
+            os << ",\"modulesp\": []";
+        } else {
+            os << ",\n \"modulesp\": [\n";
+            for (const AstNode* nodep = netlistp->modulesp(); nodep; nodep = nodep->nextp()) {
+                m_modules.emplace_back();
+                ModuleEntry& entry = m_modules.back();
+                entry.m_modp = VN_AS(nodep, NodeModule);
+                if (split) {
+                    entry.m_filename = V3Os::filenameNonDir(shardFilename(m_modules.size() - 1));
+                    entry.m_modp->dumpTreeJsonHead(os, "  ");
+                    os << ",\"file\":\"" << entry.m_filename << "\"}";
+                } else {
+                    entry.m_filename = V3Os::filenameNonDir(m_filename);
+                    entry.m_offset = static_cast<uint64_t>(os.tellp()) + 2;  // After indent
+                    entry.m_modp->dumpTreeJson(os, "  ");
+                    entry.m_length = static_cast<uint64_t>(os.tellp()) - entry.m_offset;
+                }
+                if (nodep->nextp()) os << ',';
+                os << '\n';
+            }
+            os << ']';
+        }
+        // Remaining children, as AstNetlist::dumpTreeJsonOpGen
+        dumpNodeListJson(os, netlistp->filesp(), "filesp", "");
+        dumpNodeListJson(os, netlistp->miscsp(), "miscsp", "");
+        os << "}\n";
+    }
+
+    void emitShards() {
+        // With --json-ids, ids are given out in order of first reference, and
+        // V3Global::ptrToId is not thread safe, so then write in order
+        if (v3Global.opt.jsonIds()) {
+            for (size_t i = 0; i < m_modules.size(); ++i) {
+                emitModule(shardFilename(i), m_modules[i]);
+            }
+            return;
+        }
+        V3ThreadScope threadScope;
+        for (size_t i = 0; i < m_modules.size(); ++i) {
+            const string filename = shardFilename(i);
+            ModuleEntry& entry = m_modules[i];
+            threadScope.enqueue([filename, &entry] { emitModule(filename, entry); });
+        }
+        threadScope.wait();
+    }
+
+    void emitIndex() {
+        EmitJsonFile file{baseName() + ".index.json"};
+        std::ostream& os = file.os();
+        os << "{\"file\":\"" << V3Os::filenameNonDir(m_filename) << "\",\n";
+        os << " \"modules\": [";
+        for (size_t i = 0; i < m_modules.size(); ++i) {
+            const ModuleEntry& entry = m_modules[i];
+            os << (i ? ",\n" : "\n");
+            const string addr = v3Global.opt.jsonIds() ? v3Global.ptrToId(entry.m_modp)
+                                                       : cvtToHex(entry.m_modp);
+            os << "  {\"name\":\""
+               << V3OutFormatter::quoteNameControls(entry.m_modp->prettyName()) << '"';
+            os << ",\"addr\":\"" << addr << '"';
+            os << ",\"file\":\"" << entry.m_filename << '"';
+            os << ",\"offset\":" << entry.m_offset;
+            os << ",\"length\":" << entry.m_length << '}';
+        }
+        os << "\n ]}\n";
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit EmitJson(const string& filename)
+        : m_filename{filename} {
+        emitMain();
+        if (v3Global.opt.jsonOnlySplit()) emitShards();
+        if (v3Global.opt.jsonOnlyIndex()) emitIndex();
+    }
+};
+
+//######################################################################
+// EmitJson class functions
+
+void V3EmitJson::emitJson() {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    const string filename
+        = (v3Global.opt.jsonOnlyOutput().empty()
+               ? v3Global.opt.makeDir() + "/" + v3Global.opt.prefix() + ".tree.json"
+               : v3Global.opt.jsonOnlyOutput());
+    V3File::createMakeDirFor(filename);
+    { EmitJson{filename}; }
+}
@@ -30,6 +30,7 @@ public:
     struct FileOrConcatenatedFilesList final {
         const std::string m_filename;  // Filename or output group filename if grouping
         std::vector<std::string> m_concatenatedFilenames;  // Grouped filenames if grouping
+        uint64_t m_score = 0;  // Estimated compile cost, sum of the input file complexities
 
         bool isConcatenatingFile() const { return !m_concatenatedFilenames.empty(); }
     };
@@ -198,7 +199,7 @@ private:
 
         m_outputFiles.reserve(m_inputFiles.size());
         for (const FilenameWithScore& filename : m_inputFiles) {
-            m_outputFiles.push_back({std::move(filename.m_filename), {}});
+            m_outputFiles.push_back({filename.m_filename, {}, filename.m_score});
         }
         return true;
     }
@@ -314,7 +315,7 @@ private:
         for (WorkList& list : m_workLists) {
             if (!list.m_isConcatenable) {
                 for (FilenameWithScore& file : list.m_files) {
-                    m_outputFiles.push_back({std::move(file.m_filename), {}});
+                    m_outputFiles.push_back({std::move(file.m_filename), {}, file.m_score});
                 }
                 continue;
             }
@@ -326,7 +327,8 @@ private:
             for (int i = 0; i < list.m_bucketsNum; ++i) {
                 FileOrConcatenatedFilesList bucket{v3Global.opt.prefix() + "_" + m_groupFilePrefix
                                                        + std::to_string(concatenatedFileId++),
-                                                   {}};
+                                                   {},
+                                                   0};
 
                 uint64_t bucketScore = 0;
 
@@ -339,6 +341,7 @@ private:
                         // Bucket score will be better with the file in it.
                         bucketScore += fileIt->m_score;
                         bucket.m_concatenatedFilenames.push_back(std::move(fileIt->m_filename));
+                        bucket.m_score = bucketScore;
                     } else {
                         // Best possible bucket score reached, process next bucket.
                         break;
@@ -352,7 +355,7 @@ private:
                 } else if (bucket.m_concatenatedFilenames.size() == 1) {
                     // Unwrap the bucket if it contains only one file.
                     m_outputFiles.push_back(
-                        {std::move(bucket.m_concatenatedFilenames.front()), {}});
+                        {std::move(bucket.m_concatenatedFilenames.front()), {}, bucket.m_score});
                 }
                 // Most likely no bucket will be empty in normal situations. If it happen the
                 // bucket will just be dropped.
@@ -363,6 +366,7 @@ private:
                 UASSERT(m_outputFiles.back().isConcatenatingFile(),
                         "Cannot add leftover files to a single file");
                 m_outputFiles.back().m_concatenatedFilenames.push_back(fileIt->m_filename);
+                m_outputFiles.back().m_score += fileIt->m_score;
             }
         }
     }
@@ -456,6 +460,13 @@ private:
 
         buildOutputList();
 
+        // With enough make jobs, the build takes as long as the largest output file
+        uint64_t criticalPathScore = 0;
+        for (const FileOrConcatenatedFilesList& entry : m_outputFiles) {
+            criticalPathScore = std::max(criticalPathScore, entry.m_score);
+        }
+        V3Stats::addStat("Concatenation critical path score", criticalPathScore);
+
         if (m_logp) dumpOutputList(*m_logp);
         assertFilesSame();
     }
@@ -473,12 +484,272 @@ public:
 // ######################################################################
 //  Emit statements and expressions
 
+// Ninja build file, compiling the same files as listed for make. The
+// compiler flags are resolved once by 'make ninja-vars' into
+// {prefix}__vars.ninja, so they match verilated.mk exactly.
+class EmitNinja final {
+    using FilenameWithScore = EmitGroup::FilenameWithScore;
+    using ClassMap = std::map<string, std::vector<FilenameWithScore>>;
+
+    // Files scoring over this multiple of the mean compile in the heavy pool
+    static constexpr uint64_t HEAVY_SCORE_RATIO = 4;
+
+    // MEMBERS
+    const ClassMap& m_classes;  // Files listed for make, by make variable
+    V3OutMkFile m_of;  // Output file
+    std::vector<string> m_objs;  // Objects of the model itself
+    std::vector<string> m_slowLibObjs;  // Objects of the --slow-shared-lib library
+    std::vector<string> m_globalObjs;  // Objects from the run-time library
+    std::vector<string> m_userObjs;  // Objects from user .cpp files
+    uint64_t m_heavyScore = 0;  // Files scoring over this use the heavy pool
+    size_t m_heavyCount = 0;  // Number of compiles in the heavy pool
+
+    // METHODS
+    static string filename() {
+        // Hierarchical blocks are only built as part of the top's build.ninja
+        const string name
+            = v3Global.opt.hierChild() ? v3Global.opt.prefix() + ".ninja" : "build.ninja";
+        return v3Global.opt.makeDir() + "/" + name;
+    }
+    static string escape(const string& path) {
+        string out;
+        for (const char c : path) {
+            if (c == '$' || c == ' ' || c == ':') out += '$';
+            out += c;
+        }
+        return out;
+    }
+    static string inDir(const string& name) { return "$vm_dir/" + escape(name); }
+    const std::vector<FilenameWithScore>& classes(const string& targetVar) const {
+        static const std::vector<FilenameWithScore> s_empty;
+        const auto it = m_classes.find(targetVar);
+        return it == m_classes.end() ? s_empty : it->second;
+    }
+    static string joined(const std::vector<string>& objs) {
+        string out;
+        for (const string& obj : objs) out += " " + obj;
+        return out;
+    }
+
+    void emitRules() {
+        const auto compileRule = [this](const string& name, const string& cmd) {
+            m_of.puts("rule " + name + "\n");
+            m_of.puts("  command = " + cmd + " -MF $out.d\n");
+            m_of.puts("  depfile = $out.d\n");
+            m_of.puts("  deps = gcc\n");
+            m_of.puts("  description = CXX $out\n");
+        };
+        // Flag order matches the rules in verilated.mk, so USER_CPPFLAGS can override
+        const string flags = "$cxxflags $cppflags -I$vm_dir";
+        m_of.puts("\n### Rules...\n");
+        compileRule("cxx_fast", "$cxx $opt_fast " + flags + " $pch -c -o $out $in");
+        compileRule("cxx_slow", "$cxx $opt_slow " + flags + " $pch -c -o $out $in");
+        compileRule("cxx_global", "$cxx $opt_global " + flags + " -c -o $out $in");
+        compileRule("cxx_user", "$cxx " + flags + " $opt_fast -c -o $out $in");
+        compileRule("pch_fast", "$cxx $opt_fast " + flags + " $pch_flags $in -o $out");
+        compileRule("pch_slow", "$cxx $opt_slow " + flags + " $pch_flags $in -o $out");
+        // Archive via a response file, as the object list may exceed command line limits
+        m_of.puts("rule ar\n");
+        m_of.puts("  command = rm -f $out && xargs $ar -rc $out < $out.rsp && $ar -s $out\n");
+        m_of.puts("  rspfile = $out.rsp\n");
+        m_of.puts("  rspfile_content = $in\n");
+        m_of.puts("  description = AR $out\n");
+        m_of.puts("rule link\n");
+        m_of.puts("  command = $link $ldflags @$out.rsp $hier_libs $ldlibs -o $out\n");
+        m_of.puts("  rspfile = $out.rsp\n");
+        m_of.puts("  rspfile_content = $in\n");
+        m_of.puts("  description = LINK $out\n");
+        m_of.puts("rule shared\n");
+        m_of.puts("  command = $cxx $cxxflags $cppflags $opt_fast $ldflags_shared -o $out "
+                  "@$out.rsp\n");
+        m_of.puts("  rspfile = $out.rsp\n");
+        m_of.puts("  rspfile_content = $in\n");
+        m_of.puts("  description = LINK $out\n");
+        if (v3Global.opt.slowSharedLib()) {
+            m_of.puts("rule shared_slow\n");
+            m_of.puts("  command = $link $ldflags_slow_lib $ldflags @$out.rsp -o $out\n");
+            m_of.puts("  rspfile = $out.rsp\n");
+            m_of.puts("  rspfile_content = $in\n");
+            m_of.puts("  description = LINK $out\n");
+        }
+    }
+
+    void computeHeavyScore() {
+        uint64_t total = 0;
+        size_t count = 0;
+        for (const char* const targetVar : {"VM_CLASSES_FAST", "VM_CLASSES_SLOW"}) {
+            for (const FilenameWithScore& entry : classes(targetVar)) {
+                total += entry.m_score;
+                ++count;
+            }
+        }
+        if (count) m_heavyScore = HEAVY_SCORE_RATIO * (total / count);
+    }
+
+    void emitCompiles(const string& targetVar, bool slow) {
+        const string prefix = v3Global.opt.prefix();
+        const string speed = slow ? "slow" : "fast";
+        const string gch = inDir(prefix + "__pch.h." + speed + ".gch");
+        std::vector<string>& objs
+            = slow && v3Global.opt.slowSharedLib() ? m_slowLibObjs : m_objs;
+        for (const FilenameWithScore& entry : classes(targetVar)) {
+            const string obj = inDir(entry.m_filename + ".o");
+            objs.push_back(obj);
+            m_of.puts("build " + obj + ": cxx_" + speed + " " + inDir(entry.m_filename + ".cpp")
+                      + " | " + gch + "\n");
+            m_of.puts("  pch = $pch_i " + inDir(prefix + "__pch.h." + speed)
+                      + "$gch_if_clang\n");
+            if (m_heavyScore && entry.m_score > m_heavyScore) {
+                m_of.puts("  pool = vm_heavy\n");
+                ++m_heavyCount;
+            }
+        }
+    }
+
+    void emitObjects() {
+        const string prefix = v3Global.opt.prefix();
+        computeHeavyScore();
+
+        m_of.puts("\n### Precompiled headers...\n");
+        for (const char* const speed : {"fast", "slow"}) {
+            m_of.puts("build " + inDir(prefix + "__pch.h." + speed + ".gch") + ": pch_"s + speed
+                      + " " + inDir(prefix + "__pch.h") + "\n");
+        }
+
+        m_of.puts("\n### Generated classes, fast-path, compile with highest optimization\n");
+        emitCompiles("VM_CLASSES_FAST", false);
+        emitCompiles("VM_SUPPORT_FAST", false);
+        m_of.puts("\n### Generated classes, non-fast-path, compile with low/medium "
+                  "optimization\n");
+        emitCompiles("VM_CLASSES_SLOW", true);
+        emitCompiles("VM_SUPPORT_SLOW", true);
+
+        m_of.puts("\n### Global classes, need linked once per executable\n");
+        for (const FilenameWithScore& entry : classes("VM_GLOBAL_FAST")) {
+            const string obj = inDir(entry.m_filename + ".o");
+            m_globalObjs.push_back(obj);
+            m_of.puts("build " + obj + ": cxx_global $verilator_root/include/"
+                      + escape(entry.m_filename) + ".cpp\n");
+        }
+
+        m_of.puts("\n### User .cpp files (from .cpp's on Verilator command line)\n");
+        for (const string& cppfile : v3Global.opt.cppFiles()) {
+            const string obj = inDir(V3Os::filenameNonDirExt(cppfile) + ".o");
+            m_userObjs.push_back(obj);
+            m_of.puts("build " + obj + ": cxx_user "
+                      + inDir(V3Os::filenameRelativePath(cppfile, v3Global.opt.makeDir()))
+                      + "\n");
+        }
+        if (!v3Global.opt.libCreate().empty()) {
+            const string name = v3Global.opt.libCreate();
+            m_userObjs.push_back(inDir(name + ".o"));
+            m_of.puts("build " + inDir(name + ".o") + ": cxx_fast " + inDir(name + ".cpp")
+                      + "\n");
+        }
+        V3Stats::addStat("Ninja targets, heavy pool", m_heavyCount);
+    }
+
+    void emitLinks() {
+        const string prefix = v3Global.opt.prefix();
+        string hierLibs;
+        if (v3Global.opt.hierTop()) {
+            hierLibs = " |";
+            for (const auto& pair : v3Global.opt.hierBlocks()) {
+                const string& name = pair.second.mangledName();
+                hierLibs += " " + escape("V" + name + "/lib" + name + ".a");
+            }
+        }
+        string slowLib;
+        if (v3Global.opt.slowSharedLib()) {
+            slowLib = " " + inDir("lib" + prefix + "__Slow.so");
+            m_of.puts("\n### Slow code library (from --slow-shared-lib)\n");
+            m_of.puts("build" + slowLib + ": shared_slow" + joined(m_slowLibObjs) + "\n");
+        }
+        if (v3Global.opt.exe()) {
+            const string exe = inDir(v3Global.opt.exeName());
+            m_of.puts("\n### Link rules... (from --exe)\n");
+            m_of.puts("build " + exe + ": link" + joined(m_userObjs) + joined(m_globalObjs)
+                      + joined(m_objs) + slowLib + hierLibs + "\n");
+            m_of.puts("default " + exe + "\n");
+        } else if (!v3Global.opt.libCreate().empty()) {
+            const string objs = joined(m_objs) + joined(m_userObjs) + joined(m_globalObjs);
+            const string lib = inDir(v3Global.opt.libCreateName(false));
+            m_of.puts("\n### Library rules from --lib-create\n");
+            m_of.puts("build " + lib + ": ar" + objs + "\n");
+            if (!v3Global.opt.hierChild()) {
+                // Hierarchical child does not need .so because hierTop() will create .so
+                const string shared = inDir(v3Global.opt.libCreateName(true));
+                m_of.puts("build " + shared + ": shared" + objs + "\n");
+                m_of.puts("default " + lib + " " + shared + "\n");
+            }
+        } else {
+            const string lib = inDir("lib" + prefix + ".a");
+            const string verilatedLib = inDir("libverilated.a");
+            m_of.puts("\n### Library rules (default lib mode)\n");
+            m_of.puts("build " + lib + ": ar" + joined(m_objs) + joined(m_userObjs) + "\n");
+            m_of.puts("build " + verilatedLib + ": ar" + joined(m_globalObjs) + "\n");
+            m_of.puts("default " + lib + " " + verilatedLib + slowLib + "\n");
+        }
+    }
+
+    void emit() {
+        const string prefix = v3Global.opt.prefix();
+        const bool child = v3Global.opt.hierChild();
+        m_of.puts("# Verilated -*- Ninja -*-\n");
+        m_of.puts("# DESCR"
+                  "IPTION: Verilator output: Ninja build file for " + prefix + "\n");
+        m_of.puts("#\n");
+        if (child) {
+            m_of.puts("# Included by the build.ninja of the hierarchical top\n");
+        } else {
+            m_of.puts("# Execute from the object directory, after resolving flags:\n");
+            m_of.puts("#    make -f " + prefix + ".mk ninja-vars && ninja\n");
+        }
+        m_of.puts("\nninja_required_version = 1.10\n");
+        // Blocks are built from the top's directory, so all paths are under vm_dir
+        m_of.puts("vm_dir = "
+                  + (child ? escape(V3Os::filenameNonDir(v3Global.opt.makeDir())) : "."s)
+                  + "\n");
+        m_of.puts("include $vm_dir/" + escape(prefix) + "__vars.ninja\n");
+        if (!child) {
+            // Pools are global to the build, so only the top declares them
+            const int depth = std::max(1, v3Global.opt.buildJobs() / 2);
+            m_of.puts("\n# Limit concurrent compiles of the costliest files, which need the "
+                      "most memory\n");
+            m_of.puts("pool vm_heavy\n");
+            m_of.puts("  depth = " + std::to_string(depth) + "\n");
+        }
+        emitRules();
+        emitObjects();
+        if (v3Global.opt.hierTop()) {
+            m_of.puts("\n### Hierarchical blocks\n");
+            for (const auto& pair : v3Global.opt.hierBlocks()) {
+                const string blockPrefix = "V" + pair.second.mangledName();
+                m_of.puts("subninja " + escape(blockPrefix + "/" + blockPrefix + ".ninja")
+                          + "\n");
+            }
+        }
+        emitLinks();
+    }
+
+public:
+    explicit EmitNinja(const ClassMap& classes)
+        : m_classes{classes}
+        , m_of{filename()} {
+        emit();
+    }
+};
+
+//######################################################################
+
 class EmitMk final {
     using FileOrConcatenatedFilesList = EmitGroup::FileOrConcatenatedFilesList;
     using FilenameWithScore = EmitGroup::FilenameWithScore;
 
     // MEMBERS
     double m_putClassCount = 0;  // Number of classEntries printed
+    string m_targetVar;  // Make variable whose entries are being printed
+    std::map<string, std::vector<FilenameWithScore>> m_classes;  // Entries by make variable
 
 public:
     // METHODS
@@ -493,8 +764,9 @@ public:
         }
     }
 
-    void putMakeClassEntry(V3OutMkFile& of, const string& name) {
+    void putMakeClassEntry(V3OutMkFile& of, const string& name, uint64_t score = 0) {
         of.puts("\t" + V3Os::filenameNonDirExt(name) + " \\\n");
+        m_classes[m_targetVar].push_back({V3Os::filenameNonDirExt(name), score});
         ++m_putClassCount;
     }
 
@@ -551,6 +823,10 @@ public:
         of.puts("VM_PARALLEL_BUILDS = ");
         of.puts(v3Global.useParallelBuild() ? "1" : "0");
         of.puts("\n");
+        of.puts("# Slow code in a shared library?  0/1 (from --slow-shared-lib)\n");
+        of.puts("VM_SLOW_SHARED = ");
+        of.puts(v3Global.opt.slowSharedLib() ? "1" : "0");
+        of.puts("\n");
         of.puts("# Tracing output mode?  0/1 (from --trace-fst/--trace-saif/--trace-vcd)\n");
         of.puts("VM_TRACE = ");
         of.puts(v3Global.opt.trace() ? "1" : "0");
@@ -588,6 +864,7 @@ public:
                                                          : "VM_CLASSES"s)
                                          + (slow ? "_SLOW" : "_FAST");
                 m_putClassCount = 0;
+                m_targetVar = targetVar;
                 of.puts(targetVar + " += \\\n");
                 if (support == 2 && v3Global.opt.hierChild()) {
                     // Do nothing because VM_GLOBAL is necessary per executable. Top module will
@@ -599,19 +876,39 @@ public:
                 } else if (support == 0 && v3Global.opt.outputGroups() > 0) {
                     const std::vector<FileOrConcatenatedFilesList>& list
                         = slow ? vmClassesSlowList : vmClassesFastList;
+                    std::vector<const FileOrConcatenatedFilesList*> entryps;
                     for (const FileOrConcatenatedFilesList& entry : list) {
-                        if (entry.isConcatenatingFile()) emitConcatenatingFile(entry);
-                        putMakeClassEntry(of, entry.m_filename);
+                        entryps.push_back(&entry);
+                    }
+                    // Make starts jobs in the listed order, so list the most costly first,
+                    // otherwise a large file started last would extend the build
+                    std::stable_sort(entryps.begin(), entryps.end(),
+                                     [](const FileOrConcatenatedFilesList* ap,
+                                        const FileOrConcatenatedFilesList* bp) {
+                                         return ap->m_score > bp->m_score;
+                                     });
+                    for (const FileOrConcatenatedFilesList* const entryp : entryps) {
+                        if (entryp->isConcatenatingFile()) emitConcatenatingFile(*entryp);
+                        putMakeClassEntry(of, entryp->m_filename, entryp->m_score);
                     }
                 } else {
+                    std::vector<const AstCFile*> cfileps;
                     for (AstNodeFile* nodep = v3Global.rootp()->filesp(); nodep;
                          nodep = VN_AS(nodep->nextp(), NodeFile)) {
                         const AstCFile* const cfilep = VN_CAST(nodep, CFile);
                         if (cfilep && cfilep->source() && cfilep->slow() == (slow != 0)
                             && cfilep->support() == (support != 0)) {
-                            putMakeClassEntry(of, cfilep->name());
+                            cfileps.push_back(cfilep);
                         }
                     }
+                    // Largest first, as above
+                    std::stable_sort(cfileps.begin(), cfileps.end(),
+                                     [](const AstCFile* ap, const AstCFile* bp) {
+                                         return ap->complexityScore() > bp->complexityScore();
+                                     });
+                    for (const AstCFile* const cfilep : cfileps) {
+                        putMakeClassEntry(of, cfilep->name(), cfilep->complexityScore());
+                    }
                 }
                 of.puts("\n");
                 V3Stats::addStat("Makefile targets, " + targetVar, m_putClassCount);
@@ -751,7 +1048,8 @@ public:
             of.puts("\n### Link rules... (from --exe)\n");
             // let default rule depend on '{prefix}__ALL.a', for compatibility
             of.puts(v3Global.opt.exeName()
-                    + ": $(VK_USER_OBJS) $(VK_GLOBAL_OBJS) $(VM_PREFIX)__ALL.a $(VM_HIER_LIBS)\n");
+                    + ": $(VK_USER_OBJS) $(VK_GLOBAL_OBJS) $(VM_PREFIX)__ALL.a $(VM_HIER_LIBS)"
+                      " $(VK_SLOW_LIB)\n");
             of.puts("\t$(LINK) $(LDFLAGS) $^ $(LOADLIBES) $(LDLIBS) $(LIBS) $(SC_LIBS) -o $@\n");
             of.puts("\n");
         } else if (!v3Global.opt.libCreate().empty()) {
@@ -789,7 +1087,17 @@ public:
             of.puts("libverilated.a: $(VK_GLOBAL_OBJS)\n");
             // let default rule depend on '{prefix}__ALL.a', for compatibility
             of.puts("lib" + v3Global.opt.prefix() + ": " + libname
-                    + " libverilated.a $(VM_PREFIX)__ALL.a\n");
+                    + " libverilated.a $(VM_PREFIX)__ALL.a $(VK_SLOW_LIB)\n");
+        }
+
+        if (v3Global.opt.hierChild() || v3Global.opt.hierTop()) {
+            // Lets the hierarchical makefile compile this model while the
+            // libraries of the blocks below it are still being built
+            of.puts("\n### Objects only, for hierarchical builds\n");
+            of.puts(".PHONY: $(VM_PREFIX)__objs\n");
+            of.puts("$(VM_PREFIX)__objs: $(VK_OBJS) $(VK_USER_OBJS) $(VK_GLOBAL_OBJS)");
+            if (!v3Global.opt.libCreate().empty()) of.puts(" " + v3Global.opt.libCreate() + ".o");
+            of.puts("\n");
         }
 
         of.puts("\n");
@@ -799,6 +1107,7 @@ public:
     explicit EmitMk() {
         emitClassMake();
         emitOverallMake();
+        if (v3Global.opt.buildNinja()) EmitNinja{m_classes};
     }
     virtual ~EmitMk() = default;
 };
@@ -855,9 +1164,17 @@ class EmitMkHierVerilation final {
         }
         of.puts("\n");
 
-        // Build hierarchical libraries as soon as possible to get maximum parallelism
-        of.puts("hier_build: $(VM_HIER_LIBS) " + v3Global.opt.prefix() + ".mk\n");
+        // Build hierarchical libraries as soon as possible to get maximum parallelism.
+        // Each model's objects are compiled without waiting for the libraries
+        // below it, which are only needed to archive or link.
+        const string topObjsStamp = v3Global.opt.prefix() + "__objs.stamp";
+        of.puts("hier_build: " + topObjsStamp + " $(VM_HIER_LIBS) " + v3Global.opt.prefix()
+                + ".mk\n");
         of.puts("\t$(MAKE) -f " + v3Global.opt.prefix() + ".mk\n");
+        of.puts(topObjsStamp + ": " + v3Global.opt.prefix() + ".mk\n");
+        of.puts("\t$(MAKE) -f " + v3Global.opt.prefix() + ".mk " + v3Global.opt.prefix()
+                + "__objs\n");
+        of.puts("\ttouch $@\n");
         of.puts("hier_verilation: " + v3Global.opt.prefix() + ".mk\n");
         emitCommonOpts(of);
 
@@ -896,11 +1213,18 @@ class EmitMkHierVerilation final {
             of.puts("\n");
             emitLaunchVerilator(of, argsFilename);
 
+            // Rule to compile the block, which need not wait for its children
+            const string objsStamp = prefix + "/" + prefix + "__objs.stamp";
+            of.puts(objsStamp + ": " + blockp->hierMkFilename(true) + "\n");
+            of.puts("\t$(MAKE) -f " + blockp->hierMkFilename(false) + " -C " + prefix);
+            of.puts(" VM_PREFIX=" + prefix + " " + prefix + "__objs\n");
+            of.puts("\ttouch $@\n\n");
+
             // Rule to build lib*.a
             of.puts(blockp->hierLibFilename(true));
             of.puts(": ");
             of.puts(blockp->hierMkFilename(true));
-            of.puts(" ");
+            of.puts(" " + objsStamp + " ");
             for (V3HierBlock::HierBlockSet::const_iterator child = children.begin();
                  child != children.end(); ++child) {
                 of.puts((*child)->hierLibFilename(true));
@@ -910,6 +1234,20 @@ class EmitMkHierVerilation final {
             of.puts(" VM_PREFIX=" + prefix);
             of.puts("\n\n");
         }
+
+        if (v3Global.opt.buildNinja()) {
+            // The top's build.ninja includes each block's, which needs its flags too
+            of.puts("# Resolve compiler flags of hierarchical blocks for ninja\n");
+            of.puts(".PHONY: hier_ninja_vars\n");
+            of.puts("ninja-vars: hier_ninja_vars\n");
+            of.puts("hier_ninja_vars:\n");
+            for (const V3HierBlock* const blockp : m_planp->hierBlocksSorted()) {
+                const string prefix = blockp->hierPrefix();
+                of.puts("\t$(MAKE) -f " + blockp->hierMkFilename(false) + " -C " + prefix
+                        + " VM_PREFIX=" + prefix + " ninja-vars\n");
+            }
+            of.puts("\n");
+        }
         of.puts("endif  # Guard\n");
     }
 
@@ -26,7 +26,9 @@
 #include "V3InstrCount.h"
 #include "V3Os.h"
 #include "V3Stats.h"
+#include "V3VariableOrder.h"
 
+#include <limits>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -239,6 +241,11 @@ class PackThreads final {
         }
     };
 
+    // CONSTANTS
+    // Estimated cost of observing the completion of an MTask run on another thread, in the same
+    // units as ExecMTask::cost(). Covers the cache line transfer and the wake up latency.
+    static constexpr uint64_t SYNC_LATENCY = 100;
+
     // MEMBERS
     const uint32_t m_nThreads;  // Number of threads
     const uint32_t m_sandbagNumerator;  // Numerator padding for est runtime
@@ -525,11 +532,98 @@ public:
         UASSERT_SELFTEST(uint32_t, packer.completionTime(scheduled[1], t4, 0), 1329);
         UASSERT_SELFTEST(uint32_t, packer.completionTime(scheduled[1], t4, 1), 1359);
 
+        // Predicted run time: t0, t1 on thread 0, then a barrier, t2 and t3 on thread 1 and t4
+        // waiting on t2 from thread 0
+        UASSERT_SELFTEST(uint64_t, simulate(scheduled), 1300 + 2 * SYNC_LATENCY);
+
         for (AstNode* const nodep : mTaskBodyps) nodep->deleteTree();
     }
 
+    // Predict the run time of the given packing with an event driven simulation. Each
+    // thread runs its MTasks in order; an MTask may start once its thread is free and all its
+    // dependencies are complete. Waiting on an MTask completed on another thread, or in an earlier
+    // schedule, costs an additional SYNC_LATENCY. Consecutive schedules are joined by a barrier.
+    static uint64_t simulate(const std::vector<ThreadSchedule>& schedules) {
+        std::unordered_map<const ExecMTask*, uint64_t> endTimes;
+        std::unordered_map<const ExecMTask*, uint32_t> threadIds;
+        uint64_t phaseStart = 0;
+        uint64_t phaseEnd = 0;
+        for (const ThreadSchedule& schedule : schedules) {
+            threadIds.clear();
+            for (uint32_t threadId = 0; threadId < schedule.threads.size(); ++threadId) {
+                for (const ExecMTask* const mtaskp : schedule.threads[threadId]) {
+                    threadIds.emplace(mtaskp, threadId);
+                }
+            }
+            std::vector<uint64_t> busyUntil(schedule.threads.size(), phaseStart);
+            std::vector<size_t> next(schedule.threads.size(), 0);
+            // Keep sweeping the threads until every MTask has been retired. The packing
+            // respects dependencies, so each sweep retires at least one MTask.
+            bool progress = true;
+            while (progress) {
+                progress = false;
+                for (uint32_t threadId = 0; threadId < schedule.threads.size(); ++threadId) {
+                    const std::vector<const ExecMTask*>& thread = schedule.threads[threadId];
+                    while (next[threadId] < thread.size()) {
+                        const ExecMTask* const mtaskp = thread[next[threadId]];
+                        uint64_t start = busyUntil[threadId];
+                        bool ready = true;
+                        for (const V3GraphEdge& edge : mtaskp->inEdges()) {
+                            const ExecMTask* const prevp = edge.fromp()->as<ExecMTask>();
+                            const auto it = endTimes.find(prevp);
+                            if (it == endTimes.end()) {
+                                ready = false;
+                                break;
+                            }
+                            const auto tit = threadIds.find(prevp);
+                            const bool local = tit != threadIds.end() && tit->second == threadId;
+                            start = std::max(start, it->second + (local ? 0 : SYNC_LATENCY));
+                        }
+                        if (!ready) break;
+                        busyUntil[threadId] = start + mtaskp->cost();
+                        endTimes.emplace(mtaskp, busyUntil[threadId]);
+                        phaseEnd = std::max(phaseEnd, busyUntil[threadId]);
+                        ++next[threadId];
+                        progress = true;
+                    }
+                }
+            }
+            phaseStart = phaseEnd + SYNC_LATENCY;
+        }
+        return phaseEnd;
+    }
+
     static std::vector<ThreadSchedule> apply(V3Graph& mtaskGraph) {
-        return PackThreads{}.pack(mtaskGraph);
+        // Our cost estimates are imprecise, and the right amount of padding for cross-thread
+        // dependencies depends on the shape of the graph, so pack with a few different amounts,
+        // predict the run time of each with 'simulate', and keep the best. Packing is cheap
+        // compared to the rest of the compilation.
+        static constexpr uint32_t sandbagCandidates[] = {30, 0, 15, 60, 100};
+        const uint32_t firstId = ThreadSchedule::s_nextId;
+        const auto packWith = [&](uint32_t sandbag) {
+            // Forget the previous candidate, and reuse the same schedule IDs
+            for (const V3GraphVertex& vtx : mtaskGraph.vertices()) {
+                ThreadSchedule::mtaskState.erase(vtx.as<ExecMTask>());
+            }
+            ThreadSchedule::s_nextId = firstId;
+            const uint32_t nThreads = static_cast<uint32_t>(v3Global.opt.threads());
+            return PackThreads{nThreads, sandbag, 100}.pack(mtaskGraph);
+        };
+
+        uint32_t bestSandbag = sandbagCandidates[0];
+        uint64_t bestTime = std::numeric_limits<uint64_t>::max();
+        for (const uint32_t sandbag : sandbagCandidates) {
+            const uint64_t time = simulate(packWith(sandbag));
+            UINFO(4, "Packing with sandbag " << sandbag << "% predicts " << time << endl);
+            // Strictly better only, earlier candidates are preferred on ties
+            if (time < bestTime) {
+                bestTime = time;
+                bestSandbag = sandbag;
+            }
+        }
+        V3Stats::addStatSum("Optimizations, Thread schedule predicted time",
+                            static_cast<double>(bestTime));
+        return packWith(bestSandbag);
     }
 };
 
@@ -598,6 +692,7 @@ void fillinCosts(V3Graph* execMTaskGraphp) {
         ExecMTask* const mtp = vtx.as<ExecMTask>();
         // This estimate is 64 bits, but the final mtask graph algorithm needs 32 bits
         const uint64_t costEstimate = V3InstrCount::count(mtp->bodyp(), false);
+        mtp->costEstimate(costEstimate);
         const uint64_t costProfiled
             = V3Config::getProfileData(v3Global.opt.prefix(), mtp->hashName());
         if (costProfiled) {
@@ -705,6 +800,24 @@ void finalizeCosts(V3Graph* execMTaskGraphp) {
     }
 }
 
+// Code waiting for the upstream dependencies of an mtask state, with --stats-runtime also
+// counting the waits that did not find the dependencies already done
+string waitUntilUpstreamDone(const string& statep, const string& evenCycle) {
+    const string waitp = statep + ".waitUntilUpstreamDone(" + evenCycle + ");\n";
+    if (!v3Global.opt.statsRuntime()) return waitp;
+    const string statsp = "vlSymsp->_vm_contextp__->statsRuntime()";
+    return "if (VL_UNLIKELY(!" + statep + ".areUpstreamDepsDone(" + evenCycle + "))) {\n"
+           + "uint64_t __VwaitStart;\n"  //
+           + "VL_GET_CPU_TICK(__VwaitStart);\n"  //
+           + waitp  //
+           + "uint64_t __VwaitEnd;\n"  //
+           + "VL_GET_CPU_TICK(__VwaitEnd);\n"  //
+           + statsp + ".add(VerilatedStatsRuntime::THREAD_WAITS);\n"  //
+           + statsp + ".add(VerilatedStatsRuntime::THREAD_WAIT_TICKS, "
+           + "__VwaitEnd - __VwaitStart);\n"  //
+           + "}\n";
+}
+
 void addMTaskToFunction(const ThreadSchedule& schedule, const uint32_t threadId, AstCFunc* funcp,
                         const ExecMTask* mtaskp) {
     AstNodeModule* const modp = v3Global.rootp()->topModulep();
@@ -729,7 +842,7 @@ void addMTaskToFunction(const ThreadSchedule& schedule, const uint32_t threadId,
         if (v3Global.opt.profExec()) {
             addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).threadScheduleWaitBegin();\n");
         }
-        addStrStmt("vlSelf->" + name + +".waitUntilUpstreamDone(even_cycle);\n");
+        addStrStmt(waitUntilUpstreamDone("vlSelf->" + name, "even_cycle"));
         if (v3Global.opt.profExec()) {
             addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).threadScheduleWaitEnd();\n");
         }
@@ -767,9 +880,16 @@ const std::vector<AstCFunc*> createThreadFunctions(const ThreadSchedule& schedul
 
     std::vector<AstCFunc*> funcps;
 
+    // The last thread function runs on the main thread, see addThreadStartToExecGraph
+    const size_t nFuncs = std::count_if(
+        schedule.threads.begin(), schedule.threads.end(),
+        [](const std::vector<const ExecMTask*>& thread) { return !thread.empty(); });
+
     // For each thread, create a function representing its entry point
     for (const std::vector<const ExecMTask*>& thread : schedule.threads) {
         if (thread.empty()) continue;
+        const int runThread = funcps.size() + 1 == nFuncs ? v3Global.opt.threads() - 1
+                                                          : static_cast<int>(funcps.size());
         const uint32_t threadId = schedule.threadId(thread.front());
         const string name{"__Vthread__" + tag + "__t" + cvtToStr(threadId) + "__s"
                           + cvtToStr(schedule.id())};
@@ -785,8 +905,26 @@ const std::vector<AstCFunc*> createThreadFunctions(const ThreadSchedule& schedul
         funcp->addStmtsp(new AstCStmt{fl, EmitCBase::voidSelfAssign(modp)});
         funcp->addStmtsp(new AstCStmt{fl, EmitCBase::symClassAssign()});
 
+        // Count coverage in this thread's own block of counters, see EmitCBase::coverBlocks
+        if (v3Global.opt.coverage() && EmitCBase::coverBlocks()) {
+            funcp->addStmtsp(
+                new AstCStmt{fl, "Verilated::coverSlot(" + cvtToStr(runThread) + ");\n"});
+        }
+
+        // Move the variables of this thread to its NUMA node on first run, see V3VariableOrder
+        if (V3VariableOrder::numaLayout()) {
+            const string beginName = V3VariableOrder::numaMarkerName(runThread);
+            const string endName = V3VariableOrder::numaMarkerName(runThread + 1);
+            funcp->addStmtsp(new AstCStmt{
+                fl, "if (VL_UNLIKELY(!vlSelf->" + beginName + ")) {\n"  //
+                        + "vlSelf->" + beginName + " = 1;\n"  //
+                        + "VlThreadPool::numaBind(&vlSelf->" + beginName + ", &vlSelf->"
+                        + endName + ");\n}\n"});
+        }
+
         // Invoke each mtask scheduled to this thread from the thread function
         for (const ExecMTask* const mtaskp : thread) {
+            const_cast<ExecMTask*>(mtaskp)->runThread(runThread);
             addMTaskToFunction(schedule, threadId, funcp, mtaskp);
         }
 
@@ -809,7 +947,27 @@ const std::vector<AstCFunc*> createThreadFunctions(const ThreadSchedule& schedul
     return funcps;
 }
 
-void addThreadStartWrapper(AstExecGraph* const execGraphp) {
+// Run each mtask in dependency order on the evaluating thread, the
+// alternative to the thread pool under --threads-adaptive
+void addSerialSchedule(AstExecGraph* const execGraphp,
+                       const std::unordered_map<const ExecMTask*, AstCFunc*>& funcps) {
+    FileLine* const fl = v3Global.rootp()->fileline();
+    const string& tag = execGraphp->name();
+
+    execGraphp->addStmtsp(new AstCStmt{fl, "if (vlSymsp->__Vm_adaptive__" + tag
+                                               + ".beginEval(vlSymsp->_vm_contextp__)) {\n"});
+    GraphStreamUnordered ser(execGraphp->depGraphp());
+    while (const V3GraphVertex* const vxp = ser.nextp()) {
+        AstCCall* const callp = new AstCCall{fl, funcps.at(vxp->as<ExecMTask>())};
+        callp->selfPointer(VSelfPointerText{VSelfPointerText::This{}});
+        callp->dtypeSetVoid();
+        execGraphp->addStmtsp(callp->makeStmt());
+    }
+    execGraphp->addStmtsp(new AstCStmt{fl, "} else {\n"});
+}
+
+void addThreadStartWrapper(AstExecGraph* const execGraphp,
+                           const std::unordered_map<const ExecMTask*, AstCFunc*>& serialFuncps) {
     // FileLine used for constructing nodes below
     FileLine* const fl = v3Global.rootp()->fileline();
     const string& tag = execGraphp->name();
@@ -823,19 +981,27 @@ void addThreadStartWrapper(AstExecGraph* const execGraphp) {
         addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).execGraphBegin();\n");
     }
 
+    // The serial schedule does not use the mtask states, so does not flip the cycle
+    if (!serialFuncps.empty()) addSerialSchedule(execGraphp, serialFuncps);
+
     addStrStmt("vlSymsp->__Vm_even_cycle__" + tag + " = !vlSymsp->__Vm_even_cycle__" + tag
                + ";\n");
 
-    if (!v3Global.opt.hierBlocks().empty()) addStrStmt("std::vector<size_t> indexes;\n");
+    // When the pool is shared with other contexts, the workers are assigned at run time
+    addStrStmt("std::vector<size_t> indexes;\n");
 }
 
-void addThreadEndWrapper(AstExecGraph* const execGraphp) {
+void addThreadEndWrapper(AstExecGraph* const execGraphp, bool adaptive) {
     // Add thread function invocations to execGraph
     const auto addStrStmt = [=](const string& stmt) -> void {  //
         FileLine* const flp = v3Global.rootp()->fileline();
         execGraphp->addStmtsp(new AstCStmt{flp, stmt});
     };
 
+    if (adaptive) {
+        addStrStmt("}\n");
+        addStrStmt("vlSymsp->__Vm_adaptive__" + execGraphp->name() + ".endEval();\n");
+    }
     addStrStmt("Verilated::mtaskId(0);\n");
     if (v3Global.opt.profExec()) {
         addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).execGraphEnd();\n");
@@ -856,20 +1022,26 @@ void addThreadStartToExecGraph(AstExecGraph* const execGraphp,
     };
 
     const uint32_t last = funcps.size() - 1;
+    const bool hier = v3Global.opt.hierChild() || !v3Global.opt.hierBlocks().empty();
     if (!v3Global.opt.hierBlocks().empty() && last > 0) {
         addStrStmt(
             "for (size_t i = 0; i < " + cvtToStr(last)
             + "; ++i) indexes.push_back(vlSymsp->__Vm_threadPoolp->assignWorkerIndex());\n");
+    } else if (!hier && last > 0) {
+        addStrStmt("if (VL_UNLIKELY(vlSymsp->__Vm_threadPoolp->shared())) "
+                   "vlSymsp->__Vm_threadPoolp->assignWorkerIndexes("
+                   + cvtToStr(last) + ", indexes);\n");
     }
     uint32_t i = 0;
     for (AstCFunc* const funcp : funcps) {
         if (i != last) {
             // The first N-1 will run on the thread pool.
-            if (v3Global.opt.hierChild() || !v3Global.opt.hierBlocks().empty()) {
+            if (hier) {
                 addTextStmt("vlSymsp->__Vm_threadPoolp->workerp(indexes[" + cvtToStr(i)
                             + "])->addTask(");
             } else {
-                addTextStmt("vlSymsp->__Vm_threadPoolp->workerp(" + cvtToStr(i) + ")->addTask(");
+                addTextStmt("vlSymsp->__Vm_threadPoolp->workerp(indexes.empty() ? "
+                            + cvtToStr(i) + " : indexes[" + cvtToStr(i) + "])->addTask(");
             }
             execGraphp->addStmtsp(new AstAddrOfCFunc{fl, funcp});
             addTextStmt(", vlSelf, vlSymsp->__Vm_even_cycle__" + tag + ");\n");
@@ -887,21 +1059,26 @@ void addThreadStartToExecGraph(AstExecGraph* const execGraphp,
     if (v3Global.opt.profExec()) {
         addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).threadScheduleWaitBegin();\n");
     }
-    addStrStmt("vlSelf->__Vm_mtaskstate_final__" + std::to_string(scheduleId) + tag
-               + ".waitUntilUpstreamDone(vlSymsp->__Vm_even_cycle__" + tag + ");\n");
+    addStrStmt(waitUntilUpstreamDone(
+        "vlSelf->__Vm_mtaskstate_final__" + std::to_string(scheduleId) + tag,
+        "vlSymsp->__Vm_even_cycle__" + tag));
     if (v3Global.opt.profExec()) {
         addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).threadScheduleWaitEnd();\n");
     }
     // Free all assigned worker indices in this section
     if (!v3Global.opt.hierBlocks().empty() && last > 0) {
         addStrStmt("vlSymsp->__Vm_threadPoolp->freeWorkerIndexes(indexes);\n");
+    } else if (!hier && last > 0) {
+        addStrStmt("if (!indexes.empty()) "
+                   "vlSymsp->__Vm_threadPoolp->freeWorkerIndexes(indexes);\n");
     }
 }
 
-void wrapMTaskBodies(AstExecGraph* const execGraphp) {
+std::unordered_map<const ExecMTask*, AstCFunc*> wrapMTaskBodies(AstExecGraph* const execGraphp) {
     FileLine* const flp = execGraphp->fileline();
     const string& tag = execGraphp->name();
     AstNodeModule* const modp = v3Global.rootp()->topModulep();
+    std::unordered_map<const ExecMTask*, AstCFunc*> funcps;
 
     for (AstMTaskBody* mtaskBodyp = execGraphp->mTaskBodiesp(); mtaskBodyp;
          mtaskBodyp = VN_AS(mtaskBodyp->nextp(), MTaskBody)) {
@@ -910,6 +1087,7 @@ void wrapMTaskBodies(AstExecGraph* const execGraphp) {
         AstCFunc* const funcp = new AstCFunc{flp, name, nullptr};
         funcp->isLoose(true);
         modp->addStmtsp(funcp);
+        funcps.emplace(mtaskp, funcp);
 
         // Helper function to make the code a bit more legible
         const auto addStrStmt = [=](const string& stmt) -> void {  //
@@ -951,6 +1129,7 @@ void wrapMTaskBodies(AstExecGraph* const execGraphp) {
         callp->dtypeSetVoid();
         mtaskBodyp->addStmtsp(callp->makeStmt());
     }
+    return funcps;
 }
 
 void implementExecGraph(AstExecGraph* const execGraphp, const ThreadSchedule& schedule) {
@@ -966,6 +1145,105 @@ void implementExecGraph(AstExecGraph* const execGraphp, const ThreadSchedule& sc
     addThreadStartToExecGraph(execGraphp, funcps, schedule.id());
 }
 
+void implementExecGraphDynamic(AstExecGraph* const execGraphp) {
+    // Nothing to be done if there are no MTasks in the graph at all.
+    if (execGraphp->depGraphp()->empty()) return;
+
+    AstNodeModule* const modp = v3Global.rootp()->topModulep();
+    FileLine* const fl = modp->fileline();
+    const string& tag = execGraphp->name();
+    AstBasicDType* const mtaskStateDtypep
+        = v3Global.rootp()->typeTablep()->findBasicDType(fl, VBasicDTypeKwd::MTASKSTATE);
+    const string finalName = "__Vm_mtaskstate_final__" + tag;
+
+    // Create a function for each mtask, which on completion makes its
+    // successors available to the whole thread pool, once all their
+    // dependencies are satisfied
+    std::unordered_map<const ExecMTask*, AstCFunc*> funcps;
+    for (V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
+        const ExecMTask* const mtaskp = vtx.as<ExecMTask>();
+        const string name{"__Vmtask__" + tag + "__" + cvtToStr(mtaskp->id())};
+        AstCFunc* const funcp = new AstCFunc{fl, name, nullptr, "void"};
+        modp->addStmtsp(funcp);
+        funcp->isStatic(true);  // Uses void self pointer, so static and hand rolled
+        funcp->isLoose(true);
+        funcp->entryPoint(true);
+        funcp->argTypes("void* voidSelf, bool even_cycle");
+        funcps.emplace(mtaskp, funcp);
+    }
+    size_t nSinks = 0;
+    for (V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
+        const ExecMTask* const mtaskp = vtx.as<ExecMTask>();
+        AstCFunc* const funcp = funcps.at(mtaskp);
+        funcp->addStmtsp(new AstCStmt{fl, EmitCBase::voidSelfAssign(modp)});
+        funcp->addStmtsp(new AstCStmt{fl, EmitCBase::symClassAssign()});
+
+        if (const uint32_t nDependencies = mtaskp->inEdges().size()) {
+            const string name = "__Vm_mtaskstate_" + cvtToStr(mtaskp->id());
+            AstVar* const varp = new AstVar{fl, VVarType::MODULETEMP, name, mtaskStateDtypep};
+            varp->valuep(new AstConst{fl, nDependencies});
+            varp->protect(false);  // Do not protect as we still have references in AstText
+            modp->addStmtsp(varp);
+        }
+
+        if (v3Global.opt.profPgo()) {
+            // No lock around startCounter, as counter numbers are unique per thread
+            funcp->addStmtsp(new AstCStmt{fl, "vlSymsp->_vm_pgoProfiler.startCounter("
+                                                  + std::to_string(mtaskp->id()) + ");\n"});
+        }
+        // Move the actual body into this function
+        funcp->addStmtsp(mtaskp->bodyp()->unlinkFrBack());
+        if (v3Global.opt.profPgo()) {
+            funcp->addStmtsp(new AstCStmt{fl, "vlSymsp->_vm_pgoProfiler.stopCounter("
+                                                  + std::to_string(mtaskp->id()) + ");\n"});
+        }
+
+        if (mtaskp->outEmpty()) {
+            ++nSinks;
+            funcp->addStmtsp(
+                new AstCStmt{fl, "vlSelf->" + finalName + ".signalUpstreamDone(even_cycle);\n"});
+            continue;
+        }
+        for (const V3GraphEdge& edge : mtaskp->outEdges()) {
+            const ExecMTask* const nextp = edge.top()->as<ExecMTask>();
+            AstCStmt* const stmtp = new AstCStmt{
+                fl, new AstText{fl, "if (vlSelf->__Vm_mtaskstate_" + cvtToStr(nextp->id())
+                                        + ".signalUpstreamDone(even_cycle)) "
+                                        + "vlSymsp->__Vm_threadPoolp->pushDynamic("}};
+            stmtp->addExprsp(new AstAddrOfCFunc{fl, funcps.at(nextp)});
+            stmtp->addExprsp(new AstText{fl, ", voidSelf, even_cycle);\n"});
+            funcp->addStmtsp(stmtp);
+        }
+    }
+
+    // Create the fake "final" mtask state variable, signalled by each sink
+    AstVar* const varp = new AstVar{fl, VVarType::MODULETEMP, finalName, mtaskStateDtypep};
+    varp->valuep(new AstConst(fl, static_cast<uint32_t>(nSinks)));
+    varp->protect(false);  // Do not protect as we still have references in AstText
+    modp->addStmtsp(varp);
+
+    // Seed the pool with the mtasks that have no dependencies, then help execute
+    const auto addTextStmt = [=](const string& text) -> void {
+        execGraphp->addStmtsp(new AstText{fl, text, /* tracking: */ true});
+    };
+    for (V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
+        const ExecMTask* const mtaskp = vtx.as<ExecMTask>();
+        if (!mtaskp->inEmpty()) continue;
+        addTextStmt("vlSymsp->__Vm_threadPoolp->pushDynamic(");
+        execGraphp->addStmtsp(new AstAddrOfCFunc{fl, funcps.at(mtaskp)});
+        addTextStmt(", vlSelf, vlSymsp->__Vm_even_cycle__" + tag + ");\n");
+    }
+    V3Stats::addStatSum("Optimizations, Thread schedule total tasks", funcps.size());
+    if (v3Global.opt.profExec()) {
+        addTextStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).threadScheduleWaitBegin();\n");
+    }
+    addTextStmt("vlSymsp->__Vm_threadPoolp->execDynamic(vlSelf->" + finalName
+                + ", vlSymsp->__Vm_even_cycle__" + tag + ");\n");
+    if (v3Global.opt.profExec()) {
+        addTextStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).threadScheduleWaitEnd();\n");
+    }
+}
+
 void implement(AstNetlist* netlistp) {
     // Called by Verilator top stage
     netlistp->topModulep()->foreach([&](AstExecGraph* execGraphp) {
@@ -979,8 +1257,6 @@ void implement(AstNetlist* netlistp) {
 
         if (dumpGraphLevel() >= 4) execGraphp->depGraphp()->dumpDotFilePrefixedAlways("pack");
 
-        addThreadStartWrapper(execGraphp);
-
         // Schedule the mtasks: statically associate each mtask with a thread,
         // and determine the order in which each thread will run its mtasks.
         const std::vector<ThreadSchedule> packed = PackThreads::apply(*execGraphp->depGraphp());
@@ -988,14 +1264,25 @@ void implement(AstNetlist* netlistp) {
                             static_cast<double>(packed.size()));
 
         // Wrap each MTask body into a CFunc for better profiling/debugging
-        wrapMTaskBodies(execGraphp);
+        const std::unordered_map<const ExecMTask*, AstCFunc*> funcps = wrapMTaskBodies(execGraphp);
+
+        // Hierarchical blocks share the pool with their parent, so always run parallel
+        const bool hier = v3Global.opt.hierChild() || !v3Global.opt.hierBlocks().empty();
+        const bool adaptive = v3Global.opt.threadsAdaptive() && !hier && !funcps.empty();
+        addThreadStartWrapper(execGraphp, adaptive ? funcps : decltype(funcps){});
 
-        for (const ThreadSchedule& schedule : packed) {
-            // Replace the graph body with its multi-threaded implementation.
-            implementExecGraph(execGraphp, schedule);
+        if (v3Global.opt.threadsDynamic() && !hier) {
+            // Threads pick up ready mtasks at run time, the static packing
+            // is only used for profiling predictions.
+            implementExecGraphDynamic(execGraphp);
+        } else {
+            for (const ThreadSchedule& schedule : packed) {
+                // Replace the graph body with its multi-threaded implementation.
+                implementExecGraph(execGraphp, schedule);
+            }
         }
 
-        addThreadEndWrapper(execGraphp);
+        addThreadEndWrapper(execGraphp, adaptive);
     });
 }
 
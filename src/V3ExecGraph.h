@@ -42,8 +42,10 @@ private:
     uint32_t m_priority = 0;
     // Predicted runtime of this mtask, in the same abstract time units as priority().
     uint32_t m_cost = 0;
+    uint64_t m_costEstimate = 0;  // V3InstrCount estimate of the cost, before any scaling
     uint64_t m_predictStart = 0;  // Predicted start time of task
     int m_threads = 1;  // Threads used by this mtask
+    int m_runThread = -1;  // Pool worker index running this mtask, threads-1 for main thread
     VL_UNCOPYABLE(ExecMTask);
 
 public:
@@ -54,12 +56,16 @@ public:
     void priority(uint32_t pri) { m_priority = pri; }
     uint32_t cost() const { return m_cost; }
     void cost(uint32_t cost) { m_cost = cost; }
+    uint64_t costEstimate() const { return m_costEstimate; }
+    void costEstimate(uint64_t cost) { m_costEstimate = cost; }
     uint64_t predictStart() const { return m_predictStart; }
     void predictStart(uint64_t time) { m_predictStart = time; }
     string name() const override VL_MT_STABLE { return "mt"s + std::to_string(id()); }
     string hashName() const { return m_hashName; }
     void threads(int threads) { m_threads = threads; }
     int threads() const { return m_threads; }
+    void runThread(int thread) { m_runThread = thread; }
+    int runThread() const { return m_runThread; }
     void dump(std::ostream& str) const;
 
     static uint32_t numUsedIds() VL_MT_SAFE { return s_nextId; }
@@ -80,6 +80,11 @@ class ExpandVisitor final : public VNVisitor {
     VDouble0 m_statWides;  // Statistic tracking
     VDouble0 m_statWideWords;  // Statistic tracking
     VDouble0 m_statWideLimited;  // Statistic tracking
+    VDouble0 m_statWideVector;  // Statistic tracking
+
+    // Minimum words before a bitwise operation is left to the vectorized runtime function.
+    // Below this, the unrolled per-word form is as fast and gives V3Const more to work with.
+    static constexpr int VECTOR_WORDS_MIN = 8;
 
     // METHODS
     // Use state that ExpandOkVisitor calculated
@@ -101,6 +106,17 @@ class ExpandVisitor final : public VNVisitor {
         }
     }
 
+    // Wide bitwise operation that is better left as a call to the vectorized VL_*_W
+    // function, as expanding per word would neither fold constants nor shrink the code
+    bool keepVector(AstNodeAssign* nodep, AstNodeExpr* lhsp, AstNodeExpr* rhsp = nullptr) {
+        if (!v3Global.opt.fExpandVector()) return false;
+        if (nodep->widthWords() < VECTOR_WORDS_MIN) return false;
+        if (nodep->widthWords() > v3Global.opt.expandLimit()) return false;  // Limited anyway
+        if (VN_IS(lhsp, Const) || (rhsp && VN_IS(rhsp, Const))) return false;
+        ++m_statWideVector;
+        return true;
+    }
+
     static int longOrQuadWidth(AstNode* nodep) {
         return (nodep->width() + (VL_EDATASIZE - 1)) & ~(VL_EDATASIZE - 1);
     }
@@ -296,6 +312,7 @@ class ExpandVisitor final : public VNVisitor {
     bool expandWide(AstNodeAssign* nodep, AstNot* rhsp) {
         UINFO(8, "    Wordize ASSIGN(NOT) " << nodep << endl);
         // -> {for each_word{ ASSIGN(WORDSEL(wide,#),NOT(WORDSEL(lhs,#))) }}
+        if (keepVector(nodep, rhsp->lhsp())) return false;
         if (!doExpandWide(nodep)) return false;
         FileLine* const fl = rhsp->fileline();
         for (int w = 0; w < nodep->widthWords(); ++w) {
@@ -306,6 +323,7 @@ class ExpandVisitor final : public VNVisitor {
     //-------- Biops
     bool expandWide(AstNodeAssign* nodep, AstAnd* rhsp) {
         UINFO(8, "    Wordize ASSIGN(AND) " << nodep << endl);
+        if (keepVector(nodep, rhsp->lhsp(), rhsp->rhsp())) return false;
         if (!doExpandWide(nodep)) return false;
         FileLine* const fl = nodep->fileline();
         for (int w = 0; w < nodep->widthWords(); ++w) {
@@ -317,6 +335,7 @@ class ExpandVisitor final : public VNVisitor {
     }
     bool expandWide(AstNodeAssign* nodep, AstOr* rhsp) {
         UINFO(8, "    Wordize ASSIGN(OR) " << nodep << endl);
+        if (keepVector(nodep, rhsp->lhsp(), rhsp->rhsp())) return false;
         if (!doExpandWide(nodep)) return false;
         FileLine* const fl = nodep->fileline();
         for (int w = 0; w < nodep->widthWords(); ++w) {
@@ -328,6 +347,7 @@ class ExpandVisitor final : public VNVisitor {
     }
     bool expandWide(AstNodeAssign* nodep, AstXor* rhsp) {
         UINFO(8, "    Wordize ASSIGN(XOR) " << nodep << endl);
+        if (keepVector(nodep, rhsp->lhsp(), rhsp->rhsp())) return false;
         if (!doExpandWide(nodep)) return false;
         FileLine* const fl = nodep->fileline();
         for (int w = 0; w < nodep->widthWords(); ++w) {
@@ -951,6 +971,7 @@ public:
         V3Stats::addStat("Optimizations, expand wides", m_statWides);
         V3Stats::addStat("Optimizations, expand wide words", m_statWideWords);
         V3Stats::addStat("Optimizations, expand limited", m_statWideLimited);
+        V3Stats::addStat("Optimizations, expand kept vector", m_statWideVector);
     }
 };
 
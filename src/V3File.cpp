@@ -20,6 +20,7 @@
 
 #include "V3Os.h"
 #include "V3String.h"
+#include "V3ThreadPool.h"
 
 #include <cerrno>
 #include <cstdarg>
@@ -136,7 +137,7 @@ public:
     void writeDepend(const string& filename);
     std::vector<string> getAllDeps() const;
     void writeTimes(const string& filename, const string& cmdlineIn);
-    bool checkTimes(const string& filename, const string& cmdlineIn);
+    bool checkTimes(const string& filename, const string& cmdlineIn, bool targetsOnly);
 };
 
 V3FileDependImp dependImp;  // Depend implementation class
@@ -212,7 +213,8 @@ void V3FileDependImp::writeTimes(const string& filename, const string& cmdlineIn
     }
 }
 
-bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn) {
+bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn,
+                                 bool targetsOnly) {
     const std::unique_ptr<std::ifstream> ifp{V3File::new_ifstream_nodepend(filename)};
     if (ifp->fail()) {
         UINFO(2, "   --check-times failed: no input " << filename << endl);
@@ -236,6 +238,7 @@ bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn
         }
     }
 
+    std::vector<string> targets;  // Outputs of previous run, when targetsOnly
     while (!ifp->eof()) {
         char chkDir;
         *ifp >> chkDir;
@@ -255,6 +258,10 @@ bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn
         char quote;
         *ifp >> quote;
         const string chkFilename = V3Os::getline(*ifp, '"');
+        if (targetsOnly) {
+            if (chkDir != 'T') continue;
+            targets.push_back(chkFilename);
+        }
 
         V3Os::filesystemFlush(chkFilename);
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
@@ -291,6 +298,8 @@ bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn
             }
         }
     }
+    // Outputs are reused, so still outputs of this run
+    for (const string& target : targets) addTgtDepend(target);
     return true;
 }
 
@@ -304,8 +313,8 @@ std::vector<string> V3File::getAllDeps() { return dependImp.getAllDeps(); }
 void V3File::writeTimes(const string& filename, const string& cmdlineIn) {
     dependImp.writeTimes(filename, cmdlineIn);
 }
-bool V3File::checkTimes(const string& filename, const string& cmdlineIn) {
-    return dependImp.checkTimes(filename, cmdlineIn);
+bool V3File::checkTimes(const string& filename, const string& cmdlineIn, bool targetsOnly) {
+    return dependImp.checkTimes(filename, cmdlineIn, targetsOnly);
 }
 void V3File::createMakeDirFor(const string& filename) {
     if (filename != VL_DEV_NULL
@@ -331,6 +340,7 @@ class VInFilterImp final {
     using StrList = VInFilter::StrList;
 
     std::map<const std::string, std::string> m_contentsMap;  // Cache of file contents
+    std::map<const std::string, StrList> m_prefetchMap;  // Contents read ahead, used once
     bool m_readEof = false;  // Received EOF on read
 #ifdef INFILTER_PIPE
     pid_t m_pid = 0;  // fork() process id
@@ -353,10 +363,45 @@ private:
         }
     }
     bool readContentsFile(const string& filename, StrList& outl) {
+        return readContentsFileMT(filename, outl);
+    }
+    static bool readContentsFileMT(const string& filename, StrList& outl) VL_MT_SAFE {
+        // Does not use member state, so may run from any thread
         const int fd = open(filename.c_str(), O_RDONLY);
         if (fd < 0) return false;
-        m_readEof = false;
-        readBlocks(fd, -1, outl);
+        // Read regular files into a single string of the file's size, avoiding
+        // concatenating blocks later. Anything past the size (a growing file), or
+        // non-regular files, are read in blocks.
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            string contents(static_cast<size_t>(st.st_size), '\0');
+            size_t size = 0;
+            while (size < contents.size()) {
+                errno = 0;
+                const ssize_t got = read(fd, &contents[size], contents.size() - size);
+                if (got > 0) {
+                    size += got;
+                } else if (got < 0 && errno == EINTR) {
+                    continue;
+                } else {
+                    break;
+                }
+            }
+            contents.resize(size);
+            outl.push_back(std::move(contents));
+        }
+        char buf[INFILTER_IPC_BUFSIZ];
+        while (true) {
+            errno = 0;
+            const ssize_t got = read(fd, buf, INFILTER_IPC_BUFSIZ);
+            if (got > 0) {
+                outl.push_back(string(buf, got));
+            } else if (got < 0 && errno == EINTR) {
+                continue;
+            } else {
+                break;
+            }
+        }
         close(fd);
         return true;
     }
@@ -572,7 +617,13 @@ protected:
             outl.push_back(it->second);
             return true;
         }
-        if (!readContents(filename, outl)) return false;
+        const auto pit = m_prefetchMap.find(filename);
+        if (pit != m_prefetchMap.end()) {
+            outl.splice(outl.end(), pit->second);
+            m_prefetchMap.erase(pit);
+        } else if (!readContents(filename, outl)) {
+            return false;
+        }
         if (listSize(outl) < INFILTER_CACHE_MAX) {
             // Cache small files (only to save space)
             // It's quite common to `include "timescale" thousands of times
@@ -581,6 +632,27 @@ protected:
         }
         return true;
     }
+    // Read ahead file contents using the thread pool
+    void prefetch(const std::vector<string>& filenames) {
+        if (m_pid) return;  // Filter process answers requests in order
+        std::vector<StrList> contents(filenames.size());
+        std::vector<uint8_t> oks(filenames.size(), 0);
+        {
+            V3ThreadScope threadScope;
+            for (size_t i = 0; i < filenames.size(); ++i) {
+                if (m_contentsMap.count(filenames[i]) || m_prefetchMap.count(filenames[i])) {
+                    continue;
+                }
+                threadScope.enqueue([&filenames, &contents, &oks, i]() {
+                    oks[i] = readContentsFileMT(filenames[i], contents[i]);
+                });
+            }
+        }
+        for (size_t i = 0; i < filenames.size(); ++i) {
+            // If it failed, the later serial read will report the error
+            if (oks[i]) m_prefetchMap.emplace(filenames[i], std::move(contents[i]));
+        }
+    }
     static size_t listSize(const StrList& sl) {
         size_t result = 0;
         for (const string& i : sl) result += i.length();
@@ -610,6 +682,11 @@ bool VInFilter::readWholefile(const string& filename, VInFilter::StrList& outl)
     return m_impp->readWholefile(filename, outl);
 }
 
+void VInFilter::prefetch(const std::vector<string>& filenames) {
+    UASSERT(m_impp, "prefetch on invalid filter");
+    m_impp->prefetch(filenames);
+}
+
 //######################################################################
 // V3OutFormatter: A class for printing to a file, with automatic indentation of C++ code.
 
@@ -697,12 +774,12 @@ int V3OutFormatter::endLevels(const char* strg) {
 
 void V3OutFormatter::putns(const AstNode* nodep, const char* strg) {
     if (!v3Global.opt.decoration()) {
-        putsOutput(strg);
+        putsOutput(strg, std::strlen(strg));
         return;
     }
 
     if (m_prependIndent && strg[0] != '\n') {
-        putsNoTracking(indentSpaces(endLevels(strg)));
+        putsIndent(endLevels(strg));
         m_prependIndent = false;
     }
 
@@ -717,11 +794,15 @@ void V3OutFormatter::putns(const AstNode* nodep, const char* strg) {
                        + "*/");
     }
 
+    // Characters are tracked one at a time, but output in runs between the places where
+    // indentation is inserted
+    const char* runp = strg;  // Start of characters not yet output
     bool notstart = false;
     bool wordstart = true;
     bool equalsForBracket = false;  // Looking for "= {"
-    for (const char* cp = strg; *cp; ++cp) {
-        putcNoTracking(*cp);
+    const char* cp = strg;
+    for (; *cp; ++cp) {
+        trackChar(*cp);
         if (std::isalpha(*cp)) {
             if (wordstart && m_lang == LA_VERILOG && tokenNotStart(cp)) notstart = true;
             if (wordstart && m_lang == LA_VERILOG && !notstart && tokenStart(cp)) indentInc();
@@ -737,7 +818,9 @@ void V3OutFormatter::putns(const AstNode* nodep, const char* strg) {
                 m_prependIndent = true;
             } else {
                 m_prependIndent = false;
-                putsNoTracking(indentSpaces(endLevels(cp + 1)));
+                putsOutput(runp, cp + 1 - runp);
+                runp = cp + 1;
+                putsIndent(endLevels(cp + 1));
             }
             break;
         case ' ': wordstart = true; break;
@@ -751,8 +834,8 @@ void V3OutFormatter::putns(const AstNode* nodep, const char* strg) {
                 if (cp > strg && cp[-1] == '/' && !m_inStringLiteral) {
                     // Output ignoring contents to EOL
                     ++cp;
-                    while (*cp && cp[1] && cp[1] != '\n') putcNoTracking(*cp++);
-                    if (*cp) putcNoTracking(*cp);
+                    while (*cp && cp[1] && cp[1] != '\n') trackChar(*cp++);
+                    if (*cp) trackChar(*cp);
                 }
             }
             break;
@@ -808,6 +891,7 @@ void V3OutFormatter::putns(const AstNode* nodep, const char* strg) {
         default: equalsForBracket = false; break;
         }
     }
+    putsOutput(runp, cp - runp);
 }
 
 void V3OutFormatter::putBreakExpr() {
@@ -821,7 +905,7 @@ void V3OutFormatter::putBreak() {
         // char s[1000]; sprintf(s, "{%d,%d}", m_column, m_parenVec.top()); putsNoTracking(s);
         if (exceededWidth()) {
             putcNoTracking('\n');
-            if (!m_parenVec.empty()) putsNoTracking(indentSpaces(m_parenVec.top()));
+            if (!m_parenVec.empty()) putsIndent(m_parenVec.top());
         }
     }
 }
@@ -831,43 +915,30 @@ void V3OutFormatter::putsQuoted(const string& strg) {
     // Don't use to quote a filename for #include - #include doesn't \ escape.
     const string quoted = quoteNameControls(strg);
     putcNoTracking('"');
-    for (const char c : quoted) putcNoTracking(c);
+    putsNoTracking(quoted);
     putcNoTracking('"');
     if (strg.find('\0') != std::string::npos) putcNoTracking('s');  // C++14 std::string
 }
-void V3OutFormatter::putsNoTracking(const string& strg) {
-    if (!v3Global.opt.decoration()) {
-        putsOutput(strg.c_str());
-        return;
-    }
+void V3OutFormatter::putsNoTracking(const char* strg, size_t len) {
     // Don't track {}'s, probably because it's a $display format string
-    for (const char c : strg) putcNoTracking(c);
+    if (v3Global.opt.decoration()) {
+        for (size_t i = 0; i < len; ++i) trackChar(strg[i]);
+    }
+    putsOutput(strg, len);
 }
 
 void V3OutFormatter::putcNoTracking(char chr) {
-    if (!v3Global.opt.decoration()) {
-        putcOutput(chr);
-        return;
-    }
-    switch (chr) {
-    case '\n':
-        ++m_lineno;
-        m_column = 0;
-        m_nobreak = true;
-        break;
-    case '\t': m_column = ((m_column + 9) / 8) * 8; break;
-    case ' ':
-    case '(':
-    case '|':
-    case '&': ++m_column; break;
-    default:
-        ++m_column;
-        m_nobreak = false;
-        break;
-    }
+    if (v3Global.opt.decoration()) trackChar(chr);
     putcOutput(chr);
 }
 
+void V3OutFormatter::putsIndent(int num) {
+    // Indent the specified number of spaces, without a temporary string
+    static const std::string s_spaces(MAXSPACE, ' ');
+    if (num <= 0) return;
+    putsNoTracking(s_spaces.data(), num < MAXSPACE ? num : MAXSPACE);
+}
+
 string V3OutFormatter::quoteNameControls(const string& namein,
                                          V3OutFormatter::Language lang) VL_PURE {
     // Encode control chars into output-appropriate escapes
@@ -934,6 +1005,7 @@ void V3OutFormatter::printf(const char* fmt...) {
 
 V3OutFile::V3OutFile(const string& filename, V3OutFormatter::Language lang)
     : V3OutFormatter{filename, lang}
+    , m_profScope{"file", filename}
     , m_bufferp{new std::array<char, WRITE_BUFFER_SIZE_BYTES>{}} {
     if ((m_fp = V3File::new_fopen_w(filename)) == nullptr) {
         v3fatal("Can't write file: " << filename);
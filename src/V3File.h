@@ -21,6 +21,7 @@
 #include "verilatedos.h"
 
 #include "V3Error.h"
+#include "V3ProfVerilation.h"
 #include "V3Stats.h"
 
 #include <array>
@@ -69,7 +70,9 @@ public:
     static void writeDepend(const string& filename);
     static std::vector<string> getAllDeps();
     static void writeTimes(const string& filename, const string& cmdlineIn);
-    static bool checkTimes(const string& filename, const string& cmdlineIn);
+    // Check sources and outputs unchanged, or with targetsOnly, just the outputs
+    static bool checkTimes(const string& filename, const string& cmdlineIn,
+                           bool targetsOnly = false);
 
     // Directory utilities
     static void createMakeDirFor(const string& filename);
@@ -99,6 +102,8 @@ public:
     // METHODS
     // Read file contents and return it.  Return true on success.
     bool readWholefile(const string& filename, StrList& outl);
+    // Read ahead given files in parallel, so later readWholefile calls are from memory
+    void prefetch(const std::vector<std::string>& filenames);
 };
 
 //============================================================================
@@ -134,7 +139,27 @@ private:
     int m_bracketLevel = 0;  // Indenting = { block, indicates number of {'s seen.
 
     int endLevels(const char* strg);
+    // Update the position for a character being output
+    void trackChar(char chr) {
+        switch (chr) {
+        case '\n':
+            ++m_lineno;
+            m_column = 0;
+            m_nobreak = true;
+            break;
+        case '\t': m_column = ((m_column + 9) / 8) * 8; break;
+        case ' ':
+        case '(':
+        case '|':
+        case '&': ++m_column; break;
+        default:
+            ++m_column;
+            m_nobreak = false;
+            break;
+        }
+    }
     void putcNoTracking(char chr);
+    void putsIndent(int num);
 
 public:
     V3OutFormatter(const string& filename, Language lang);
@@ -150,7 +175,9 @@ public:
     void puts(const string& strg) { putns(nullptr, strg); }
     void putns(const AstNode* nodep, const char* strg);
     void putns(const AstNode* nodep, const string& strg) { putns(nodep, strg.c_str()); }
-    void putsNoTracking(const string& strg);
+    void putsNoTracking(const string& strg) { putsNoTracking(strg.data(), strg.size()); }
+    void putsNoTracking(const char* strg) { putsNoTracking(strg, std::strlen(strg)); }
+    void putsNoTracking(const char* strg, size_t len);
     void putsQuoted(const string& strg);
     void putBreak();  // Print linebreak if line is too wide
     void putBreakExpr();  // Print linebreak in expression if line is too wide
@@ -190,7 +217,7 @@ public:
 
     // CALLBACKS - MUST OVERRIDE
     virtual void putcOutput(char chr) = 0;
-    virtual void putsOutput(const char* str) = 0;
+    virtual void putsOutput(const char* str, size_t len) = 0;
 };
 
 //============================================================================
@@ -206,6 +233,7 @@ class V3OutFile VL_NOT_FINAL : public V3OutFormatter {
     static constexpr std::size_t WRITE_BUFFER_SIZE_BYTES = 128 * 1024;
 
     // MEMBERS
+    const V3ProfVerilationScope m_profScope;  // Profile of writing this file, first constructed
     FILE* m_fp = nullptr;
     std::size_t m_usedBytes = 0;  // Number of bytes stored in m_bufferp
     std::size_t m_writtenBytes = 0;  // Number of bytes written to output
@@ -236,11 +264,10 @@ private:
     }
     // CALLBACKS
     void putcOutput(char chr) override {
-        m_bufferp->at(m_usedBytes++) = chr;
+        (*m_bufferp)[m_usedBytes++] = chr;
         if (VL_UNLIKELY(m_usedBytes >= WRITE_BUFFER_SIZE_BYTES)) writeBlock();
     }
-    void putsOutput(const char* str) override {
-        std::size_t len = strlen(str);
+    void putsOutput(const char* str, std::size_t len) override {
         std::size_t availableBytes = WRITE_BUFFER_SIZE_BYTES - m_usedBytes;
         while (VL_UNLIKELY(len >= availableBytes)) {
             std::memcpy(m_bufferp->data() + m_usedBytes, str, availableBytes);
@@ -24,6 +24,8 @@
 //          initial <name>__VforceEn = 0;
 //      add a continuous assignment:
 //          assign <name>__VforceRd = <name>__VforceEn ? <name>__VforceVal : <name>;
+//      (for wide ranged signals the bitwise merge is guarded by |<name>__VforceEn, so the
+//      common unforced case is a plain copy)
 //      replace all READ references to <name> with a read reference to <name>_VforceRd
 //
 //  Replace each AstAssignForce with 3 assignments:
@@ -131,12 +133,20 @@ public:
             AstVarRef* const origp = new AstVarRef{flp, vscp, VAccess::READ};
             ForceState::markNonReplaceable(origp);
             if (ForceState::isRangedDType(vscp)) {
-                return new AstOr{
+                AstNodeExpr* const mergedp = new AstOr{
                     flp,
                     new AstAnd{flp, new AstVarRef{flp, m_enVscp, VAccess::READ},
                                new AstVarRef{flp, m_valVscp, VAccess::READ}},
                     new AstAnd{flp, new AstNot{flp, new AstVarRef{flp, m_enVscp, VAccess::READ}},
                                origp}};
+                if (!vscp->isWide()) return mergedp;
+                // For wide signals the bitwise merge needs several word loops and temporaries,
+                // so only take that path when some bit is forced, and copy otherwise.
+                AstVarRef* const unforcedp = new AstVarRef{flp, vscp, VAccess::READ};
+                ForceState::markNonReplaceable(unforcedp);
+                return new AstCond{flp,
+                                   new AstRedOr{flp, new AstVarRef{flp, m_enVscp, VAccess::READ}},
+                                   mergedp, unforcedp};
             }
             return new AstCond{flp, new AstVarRef{flp, m_enVscp, VAccess::READ},
                                new AstVarRef{flp, m_valVscp, VAccess::READ}, origp};
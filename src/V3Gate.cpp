@@ -674,6 +674,10 @@ class GateInline final {
     // Variable substitutions to apply to a given logic block
     AstUser2Allocator<AstNode, Substitutions> m_substitutions;
 
+    // GateLogicVertex::user() values, logic rejected by GateOkVisitor (non-clock/clock)
+    static constexpr uint32_t OK_REJECTED = 1;
+    static constexpr uint32_t OK_REJECTED_CLOCK = 2;
+
     // STATE
     GateGraph& m_graph;
     size_t m_ord = 0;  // Counter for sorting
@@ -803,6 +807,11 @@ class GateInline final {
             if (!lVtxp->reducible()) continue;
             AstNode* const logicp = lVtxp->nodep();
 
+            // If the driving logic was rejected by GateOkVisitor before, and has not had
+            // substitutions since, the answer would be the same, so skip the re-analysis
+            const uint32_t okKey = vVtxp->isClock() ? OK_REJECTED_CLOCK : OK_REJECTED;
+            if (lVtxp->user() == okKey) continue;
+
             // Commit pending optimizations to driving logic, as we will re-analyze
             commitSubstitutions(logicp);
 
@@ -810,7 +819,10 @@ class GateInline final {
             const GateOkVisitor okVisitor{logicp, vVtxp->isClock(), false};
 
             // Was it ok?
-            if (!okVisitor.isSimple()) continue;
+            if (!okVisitor.isSimple()) {
+                lVtxp->user(okKey);
+                continue;
+            }
             // If the varScope is already removed from logicp, no need to try substitution.
             if (!okVisitor.varAssigned(vVtxp->varScp())) continue;
             if (excludedWide(vVtxp, okVisitor.substitutionp())) {
@@ -884,6 +896,7 @@ class GateInline final {
                 }
 
                 recordSubstitution(vscp, substp, dstVtxp->nodep());
+                dstVtxp->user(0);  // Logic will change, so must re-analyze
 
                 // If the new replacement referred to a signal,
                 // Correct the graph to point to this new generating variable
@@ -913,7 +926,7 @@ class GateInline final {
     explicit GateInline(GateGraph& graph)
         : m_graph{graph} {
         // Find gate interconnect and optimize
-        graph.userClearVertices();  // vertex->user(): bool. Indicates we've set it as consumed
+        graph.userClearVertices();  // GateLogicVertex::user(): OK_REJECTED* if rejected
         // Get rid of buffers first,
         optimizeSignals(false);
         // Then propagate more complicated equations
@@ -18,6 +18,7 @@
 
 #include "V3Global.h"
 
+#include "V3Arena.h"
 #include "V3EmitV.h"
 #include "V3Error.h"
 #include "V3File.h"
@@ -25,6 +26,7 @@
 #include "V3LinkCells.h"
 #include "V3Parse.h"
 #include "V3ParseSym.h"
+#include "V3ProfVerilation.h"
 #include "V3Stats.h"
 #include "V3ThreadPool.h"
 
@@ -78,8 +80,26 @@ void V3Global::readFiles() {
                          "Cannot find verilated_std.sv containing built-in std:: definitions: ");
     }
 
-    // Read top module
     const V3StringList& vFiles = v3Global.opt.vFiles();
+    const V3StringSet& libraryFiles = v3Global.opt.libraryFiles();
+    if (v3Global.opt.verilateJobs() > 1) {
+        // Read the command line files in parallel; preprocessing and parsing remain in order
+        // as `defines and symbols carry from one file to the next
+        FileLine* const flp = new FileLine{FileLine::commandLineFilename()};
+        v3Global.opt.prefetchDirs();
+        std::vector<string> filenames;
+        for (const string& filename : vFiles) {
+            const string path = v3Global.opt.filePath(flp, filename, "", "");
+            if (!path.empty()) filenames.push_back(path);
+        }
+        for (const string& filename : libraryFiles) {
+            const string path = v3Global.opt.filePath(flp, filename, "", "");
+            if (!path.empty()) filenames.push_back(path);
+        }
+        filter.prefetch(filenames);
+    }
+
+    // Read top module
     for (const string& filename : vFiles) {
         parser.parseFile(new FileLine{FileLine::commandLineFilename()}, filename, false,
                          "Cannot find file containing module: ");
@@ -88,7 +108,6 @@ void V3Global::readFiles() {
     // Read libraries
     // To be compatible with other simulators,
     // this needs to be done after the top file is read
-    const V3StringSet& libraryFiles = v3Global.opt.libraryFiles();
     for (const string& filename : libraryFiles) {
         parser.parseFile(new FileLine{FileLine::commandLineFilename()}, filename, true,
                          "Cannot find file containing library module: ");
@@ -135,6 +154,7 @@ string V3Global::digitsFilename(int number) {
 }
 
 void V3Global::dumpCheckGlobalTree(const string& stagename, int newNumber, bool doDump) {
+    V3ProfVerilation::passEnd(stagename);
     const string treeFilename = v3Global.debugFilename(stagename + ".tree", newNumber);
     if (dumpTreeLevel()) v3Global.rootp()->dumpTreeFile(treeFilename, doDump);
     if (dumpTreeJsonLevel()) {
@@ -144,6 +164,7 @@ void V3Global::dumpCheckGlobalTree(const string& stagename, int newNumber, bool
         v3Global.rootp()->dumpTreeDotFile(treeFilename + ".dot", doDump);
     }
     if (v3Global.opt.stats()) V3Stats::statsStage(stagename);
+    if (!v3Global.opt.astSpillDir().empty()) V3Arena::markCold();
 
     if (doDump && v3Global.opt.debugEmitV()) V3EmitV::debugEmitV(treeFilename + ".v");
     if (v3Global.opt.debugCheck() || dumpTreeEitherLevel()) {
@@ -153,6 +174,7 @@ void V3Global::dumpCheckGlobalTree(const string& stagename, int newNumber, bool
         // set by other steps if it is called in the middle of other operations
         V3Broken::brokenAll(v3Global.rootp());
     }
+    V3ProfVerilation::checkEnd(stagename);
 }
 
 void V3Global::idPtrMapDumpJson(std::ostream& os) {
@@ -166,11 +188,13 @@ void V3Global::idPtrMapDumpJson(std::ostream& os) {
 }
 
 void V3Global::saveJsonPtrFieldName(const std::string& fieldName) {
+    const V3LockGuard lock{m_jsonPtrNamesMutex};
     m_jsonPtrNames.insert(fieldName);
 }
 
 void V3Global::ptrNamesDumpJson(std::ostream& os) {
     std::string sep = "\n  ";
+    const V3LockGuard lock{m_jsonPtrNamesMutex};
     os << "\"ptrFieldNames\": [";
     for (const auto& itr : m_jsonPtrNames) {
         os << sep << '"' << itr << '"';
@@ -132,8 +132,9 @@ class V3Global final {
     std::unordered_map<const void*, std::string>
         m_ptrToId;  // The actual 'address' <=> 'short string' bijection
 
-    // Names of fields that were dumped by dumpJsonPtr()
-    std::unordered_set<std::string> m_jsonPtrNames;
+    // Names of fields that were dumped by dumpJsonPtr(), which may be called in parallel
+    V3Mutex m_jsonPtrNamesMutex;
+    std::unordered_set<std::string> m_jsonPtrNames VL_GUARDED_BY(m_jsonPtrNamesMutex);
 
     // Id of the main thread
     const std::thread::id m_mainThreadId = std::this_thread::get_id();
@@ -206,8 +207,9 @@ public:
     void useParallelBuild(bool flag) { m_useParallelBuild = flag; }
     bool useRandomizeMethods() const { return m_useRandomizeMethods; }
     void useRandomizeMethods(bool flag) { m_useRandomizeMethods = flag; }
-    void saveJsonPtrFieldName(const std::string& fieldName);
-    void ptrNamesDumpJson(std::ostream& os);
+    void saveJsonPtrFieldName(const std::string& fieldName)
+        VL_MT_SAFE_EXCLUDES(m_jsonPtrNamesMutex);
+    void ptrNamesDumpJson(std::ostream& os) VL_MT_SAFE_EXCLUDES(m_jsonPtrNamesMutex);
     void idPtrMapDumpJson(std::ostream& os);
     const std::string& ptrToId(const void* p);
     std::thread::id mainThreadId() const { return m_mainThreadId; }
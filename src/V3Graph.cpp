@@ -179,6 +179,12 @@ int V3GraphEdge::sortCmp(const V3GraphEdge* rhsp) const {
     return top()->sortCmp(rhsp->top());
 }
 
+//######################################################################
+// Graph memory usage
+
+V3GraphMemory V3GraphMemory::s_vertices;
+V3GraphMemory V3GraphMemory::s_edges;
+
 //######################################################################
 //######################################################################
 // Graph top level
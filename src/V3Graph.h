@@ -20,6 +20,7 @@
 #include "config_build.h"
 #include "verilatedos.h"
 
+#include "V3Arena.h"
 #include "V3Error.h"
 #include "V3List.h"
 #include "V3Rtti.h"
@@ -77,6 +78,40 @@ constexpr bool operator==(const GraphWay& lhs, const GraphWay& rhs) { return lhs
 constexpr bool operator==(const GraphWay& lhs, GraphWay::en rhs) { return lhs.m_e == rhs; }
 constexpr bool operator==(GraphWay::en lhs, const GraphWay& rhs) { return lhs == rhs.m_e; }
 
+//============================================================================
+// Bytes used by live vertices or edges, and the peak since the last reset,
+// for --stats-memory.  Graphs are built single threaded, so no locking.
+
+class V3GraphMemory final {
+    size_t m_bytes = 0;  // Bytes currently allocated
+    size_t m_peakBytes = 0;  // Maximum of m_bytes since resetPeak()
+
+public:
+    static V3GraphMemory s_vertices;  // Usage of V3GraphVertex and subclasses
+    static V3GraphMemory s_edges;  // Usage of V3GraphEdge and subclasses
+
+    // METHODS
+    void add(size_t size) {
+        m_bytes += size;
+        if (m_bytes > m_peakBytes) m_peakBytes = m_bytes;
+    }
+    void sub(size_t size) { m_bytes -= size; }
+    size_t bytes() const { return m_bytes; }
+    size_t peakBytes() const { return m_peakBytes; }
+    void resetPeak() { m_peakBytes = m_bytes; }
+};
+
+// As VL_ARENA_OPERATORS, also accounting the usage in the given V3GraphMemory
+#define VL_GRAPH_ARENA_OPERATORS(usage) \
+    static void* operator new(size_t size) { \
+        V3GraphMemory::usage.add(size); \
+        return V3Arena::allocate(size); \
+    } \
+    static void operator delete(void* objp, size_t size) { \
+        if (objp) V3GraphMemory::usage.sub(size); \
+        V3Arena::deallocate(objp, size); \
+    }
+
 //============================================================================
 // TODO should we have a smaller edge structure when we don't need weight etc?
 
@@ -134,6 +169,7 @@ public:
         return new V3GraphEdge{graphp, fromp, top, *this};
     }
     virtual ~V3GraphEdge() = default;
+    VL_GRAPH_ARENA_OPERATORS(s_edges)
     // METHODS
     // Return true iff of type T
     template <typename T>
@@ -236,6 +272,7 @@ public:
         return new V3GraphVertex{graphp, *this};
     }
     virtual ~V3GraphVertex() = default;
+    VL_GRAPH_ARENA_OPERATORS(s_vertices)
     void unlinkEdges(V3Graph* graphp) VL_MT_DISABLED;
     void unlinkDelete(V3Graph* graphp) VL_MT_DISABLED;
 
@@ -14,8 +14,6 @@
 //
 //*************************************************************************
 
-#define VL_MT_DISABLED_CODE_UNIT 1
-
 #include "config_build.h"
 #include "verilatedos.h"
 
@@ -25,10 +23,13 @@
 #include "V3GraphPathChecker.h"
 #include "V3GraphStream.h"
 #include "V3Stats.h"
+#include "V3ThreadPool.h"
 
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -174,80 +175,99 @@ void V3Graph::weaklyConnected(V3EdgeFuncP edgeFuncp) { GraphAlgWeakly{this, edge
 // Changes user() and color()
 
 class GraphAlgStrongly final : GraphAlg<> {
+    struct Frame final {
+        uint32_t m_vtx;  // Vertex being iterated
+        uint32_t m_edge;  // Next out edge to visit
+        uint32_t m_dfsNum;  // DFS number assigned on entry
+    };
+    const GraphCsr m_csr;  // Snapshot of the followed edges
+    std::vector<uint32_t> m_dfs;  // Per vertex DFS number, 0=not iterated
+    std::vector<uint32_t> m_color;  // Per vertex output subtree number (fully processed)
     uint32_t m_currentDfs = 0;  // DFS count
-    std::vector<V3GraphVertex*> m_callTrace;  // List of everything we hit processing so far
+    std::vector<uint32_t> m_callTrace;  // List of everything we hit processing so far
+    std::vector<Frame> m_stack;  // Iteration stack, as graphs may be too deep to recurse
 
     void main() {
         // Use Pearce's algorithm to color the strongly connected components. For reference see
         // "An Improved Algorithm for Finding the Strongly Connected Components of a Directed
         // Graph", David J.Pearce, 2005
         //
-        // Node State:
-        //     Vertex::user     // DFS number indicating possible root of subtree, 0=not iterated
+        // Results are written back as:
+        //     Vertex::user     // DFS number indicating possible root of subtree
         //     Vertex::color    // Output subtree number (fully processed)
-
-        // Clear info
-        for (V3GraphVertex& vertex : m_graphp->vertices()) {
-            vertex.color(0);
-            vertex.user(0);
-        }
+        const uint32_t size = m_csr.size();
+        m_dfs.resize(size, 0);
+        m_color.resize(size, 0);
         // Color graph
-        for (V3GraphVertex& vertex : m_graphp->vertices()) {
-            if (!vertex.user()) {
+        for (uint32_t i = 0; i < size; ++i) {
+            if (!m_dfs[i]) {
                 m_currentDfs++;
-                vertexIterate(&vertex);
+                vertexIterate(i);
             }
         }
         // If there's a single vertex of a color, it doesn't need a subgraph
         // This simplifies the consumer's code, and reduces graph debugging clutter
-        for (V3GraphVertex& vertex : m_graphp->vertices()) {
+        for (uint32_t i = 0; i < size; ++i) {
             bool onecolor = true;
-            for (V3GraphEdge& edge : vertex.outEdges()) {
-                if (followEdge(&edge)) {
-                    if (vertex.color() == edge.top()->color()) {
-                        onecolor = false;
-                        break;
-                    }
+            for (uint32_t e = m_csr.begin(i); e < m_csr.end(i); ++e) {
+                if (m_color[i] == m_color[m_csr.target(e)]) {
+                    onecolor = false;
+                    break;
                 }
             }
-            if (onecolor) vertex.color(0);
+            V3GraphVertex* const vertexp = m_csr.vertexp(i);
+            vertexp->user(m_dfs[i]);
+            vertexp->color(onecolor ? 0 : m_color[i]);
         }
     }
 
-    void vertexIterate(V3GraphVertex* vertexp) {
+    void vertexEnter(uint32_t vtx) {
         const uint32_t thisDfsNum = m_currentDfs++;
-        vertexp->user(thisDfsNum);
-        vertexp->color(0);
-        for (V3GraphEdge& edge : vertexp->outEdges()) {
-            if (followEdge(&edge)) {
-                V3GraphVertex* top = edge.top();
-                if (!top->user()) {  // Dest not computed yet
-                    vertexIterate(top);
+        m_dfs[vtx] = thisDfsNum;
+        m_color[vtx] = 0;
+        m_stack.push_back(Frame{vtx, m_csr.begin(vtx), thisDfsNum});
+    }
+
+    void vertexIterate(uint32_t root) {
+        vertexEnter(root);
+        while (!m_stack.empty()) {
+            Frame& frame = m_stack.back();
+            const uint32_t vtx = frame.m_vtx;
+            if (frame.m_edge < m_csr.end(vtx)) {
+                const uint32_t top = m_csr.target(frame.m_edge);
+                if (!m_dfs[top]) {  // Dest not computed yet, revisit this edge after
+                    vertexEnter(top);
+                    continue;
                 }
-                if (!top->color()) {  // Dest not in a component
-                    if (vertexp->user() > top->user()) vertexp->user(top->user());
+                if (!m_color[top]) {  // Dest not in a component
+                    if (m_dfs[vtx] > m_dfs[top]) m_dfs[vtx] = m_dfs[top];
                 }
+                ++frame.m_edge;
+                continue;
             }
-        }
-        if (vertexp->user() == thisDfsNum) {  // New head of subtree
-            vertexp->color(thisDfsNum);  // Mark as component
-            while (!m_callTrace.empty()) {
-                V3GraphVertex* popVertexp = m_callTrace.back();
-                if (popVertexp->user() >= thisDfsNum) {  // Lower node is part of this subtree
-                    m_callTrace.pop_back();
-                    popVertexp->color(thisDfsNum);
-                } else {
-                    break;
+            const uint32_t thisDfsNum = frame.m_dfsNum;
+            m_stack.pop_back();
+            if (m_dfs[vtx] == thisDfsNum) {  // New head of subtree
+                m_color[vtx] = thisDfsNum;  // Mark as component
+                while (!m_callTrace.empty()) {
+                    const uint32_t popVtx = m_callTrace.back();
+                    if (m_dfs[popVtx] >= thisDfsNum) {  // Lower node is part of this subtree
+                        m_callTrace.pop_back();
+                        m_color[popVtx] = thisDfsNum;
+                    } else {
+                        break;
+                    }
                 }
+            } else {  // In another subtree (maybe...)
+                m_callTrace.push_back(vtx);
             }
-        } else {  // In another subtree (maybe...)
-            m_callTrace.push_back(vertexp);
         }
     }
 
 public:
     GraphAlgStrongly(V3Graph* graphp, V3EdgeFuncP edgeFuncp)
-        : GraphAlg<>{graphp, edgeFuncp} {
+        : GraphAlg<>{graphp, edgeFuncp}
+        , m_csr{graphp, [this](V3GraphEdge* edgep) { return followEdge(edgep); }} {
         main();
     }
     ~GraphAlgStrongly() = default;
@@ -261,7 +281,92 @@ void V3Graph::stronglyConnected(V3EdgeFuncP edgeFuncp) { GraphAlgStrongly{this,
 // Changes user() and rank()
 
 class GraphAlgRank final : GraphAlg<> {
+    // Minimum vertices in a level to process it on the thread pool
+    static constexpr size_t PARALLEL_LEVEL_MIN = 4096;
+
     void main() {
+        if (!rankLevels()) rankDepthFirst();
+    }
+
+    bool rankLevels() {
+        // A vertex's rank is the longest path to it from any source, so on an acyclic graph
+        // the ranks are computed level by level (Kahn's algorithm), with large levels split
+        // over the thread pool. The maximum is order independent, so the result is the same
+        // as the depth first search. Returns false if there is a loop, leaving the graph
+        // unchanged, so the depth first search can report it.
+        const GraphCsr csr{m_graphp, [this](V3GraphEdge* edgep) { return followEdge(edgep); }};
+        const uint32_t size = csr.size();
+        std::unique_ptr<std::atomic<uint32_t>[]> inDegrees{new std::atomic<uint32_t>[size]};
+        std::unique_ptr<std::atomic<uint32_t>[]> ranks{new std::atomic<uint32_t>[size]};
+        std::vector<uint32_t> adders(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            inDegrees[i].store(0, std::memory_order_relaxed);
+            ranks[i].store(1, std::memory_order_relaxed);
+            adders[i] = csr.vertexp(i)->rankAdder();
+        }
+        for (uint32_t i = 0; i < size; ++i) {
+            for (uint32_t e = csr.begin(i); e < csr.end(i); ++e) {
+                inDegrees[csr.target(e)].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        std::vector<uint32_t> level;
+        for (uint32_t i = 0; i < size; ++i) {
+            if (!inDegrees[i].load(std::memory_order_relaxed)) level.push_back(i);
+        }
+        // Rank the successors of level[begin, end), appending those now ready to nextp
+        const auto rankRange = [&](size_t begin, size_t end, std::vector<uint32_t>* nextp) {
+            for (size_t li = begin; li < end; ++li) {
+                const uint32_t vtx = level[li];
+                const uint32_t newRank = ranks[vtx].load(std::memory_order_relaxed) + adders[vtx];
+                for (uint32_t e = csr.begin(vtx); e < csr.end(vtx); ++e) {
+                    const uint32_t top = csr.target(e);
+                    uint32_t oldRank = ranks[top].load(std::memory_order_relaxed);
+                    while (oldRank < newRank
+                           && !ranks[top].compare_exchange_weak(oldRank, newRank,
+                                                                std::memory_order_relaxed)) {}
+                    if (inDegrees[top].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                        nextp->push_back(top);
+                    }
+                }
+            }
+        };
+        const size_t jobs = v3Global.opt.verilateJobs();
+        size_t ranked = 0;
+        std::vector<uint32_t> next;
+        while (!level.empty()) {
+            ranked += level.size();
+            next.clear();
+            if (jobs > 1 && level.size() >= PARALLEL_LEVEL_MIN) {
+                std::vector<std::vector<uint32_t>> nexts(jobs);
+                {
+                    V3ThreadScope threadScope;
+                    const size_t chunk = (level.size() + jobs - 1) / jobs;
+                    for (size_t j = 0; j < jobs; ++j) {
+                        const size_t begin = std::min(level.size(), j * chunk);
+                        const size_t end = std::min(level.size(), begin + chunk);
+                        threadScope.enqueue([&rankRange, &nexts, begin, end, j]() {
+                            rankRange(begin, end, &nexts[j]);
+                        });
+                    }
+                }
+                for (const std::vector<uint32_t>& part : nexts) {
+                    next.insert(next.end(), part.begin(), part.end());
+                }
+            } else {
+                rankRange(0, level.size(), &next);
+            }
+            level.swap(next);
+        }
+        if (ranked != size) return false;  // Loop found
+        for (uint32_t i = 0; i < size; ++i) {
+            V3GraphVertex* const vertexp = csr.vertexp(i);
+            vertexp->rank(ranks[i].load(std::memory_order_relaxed));
+            vertexp->user(2);
+        }
+        return true;
+    }
+
+    void rankDepthFirst() {
         // Rank each vertex, ignoring cutable edges
         // Vertex::m_user begin: 1 indicates processing, 2 indicates completed
         // Clear existing ranks
@@ -23,6 +23,8 @@
 #include "V3Global.h"
 #include "V3Graph.h"
 
+#include <vector>
+
 //=============================================================================
 // Algorithms - common class
 // For internal use, most graph algorithms use this as a base class
@@ -41,6 +43,46 @@ protected:
     bool followEdge(V3GraphEdge* edgep) { return (edgep->weight() && (m_edgeFuncp)(edgep)); }
 };
 
+//=============================================================================
+// Compact read-only snapshot of a graph's followed edges, in compressed sparse
+// row form. Vertices are numbered in list order, and the out edges of vertex
+// 'i' are targets [begin(i), end(i)). Traversing this avoids chasing the
+// V3GraphEdge lists, so algorithms over large graphs stay in cache.
+// Changes user() of vertices
+
+class GraphCsr final {
+    std::vector<V3GraphVertex*> m_vertices;  // Vertex of each index
+    std::vector<uint32_t> m_offsets;  // Index of first edge of each vertex, plus end sentinel
+    std::vector<uint32_t> m_targets;  // Index of the target vertex of each edge
+
+public:
+    // CONSTRUCTORS
+    template <typename T_FollowEdge>
+    GraphCsr(V3Graph* graphp, T_FollowEdge&& followEdge) {
+        for (V3GraphVertex& vertex : graphp->vertices()) {
+            vertex.user(m_vertices.size());
+            m_vertices.push_back(&vertex);
+        }
+        m_offsets.reserve(m_vertices.size() + 1);
+        for (V3GraphVertex* const vertexp : m_vertices) {
+            m_offsets.push_back(m_targets.size());
+            for (V3GraphEdge& edge : vertexp->outEdges()) {
+                if (followEdge(&edge)) m_targets.push_back(edge.top()->user());
+            }
+        }
+        m_offsets.push_back(m_targets.size());
+    }
+    ~GraphCsr() = default;
+    VL_UNCOPYABLE(GraphCsr);
+
+    // ACCESSORS
+    uint32_t size() const { return m_vertices.size(); }
+    V3GraphVertex* vertexp(uint32_t i) const { return m_vertices[i]; }
+    uint32_t begin(uint32_t i) const { return m_offsets[i]; }
+    uint32_t end(uint32_t i) const { return m_offsets[i + 1]; }
+    uint32_t target(uint32_t edge) const { return m_targets[edge]; }
+};
+
 //============================================================================
 
 #endif  // Guard
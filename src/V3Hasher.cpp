@@ -568,6 +568,31 @@ V3Hash V3Hasher::uncachedHash(const AstNode* nodep) {
     return visitor.finalHash();
 }
 
+V3Hash V3Hasher::elabHash(AstNetlist* netlistp) {
+    const V3Hasher hasher;
+    V3Hash hash;
+    // Structure, modules themselves hash by name only, so hash their contents
+    for (AstNodeModule* modp = netlistp->modulesp(); modp;
+         modp = VN_AS(modp->nextp(), NodeModule)) {
+        hash += hasher(modp);
+        for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+            hash += hasher(nodep);
+        }
+    }
+    for (AstNode* nodep = netlistp->typeTablep()->typesp(); nodep; nodep = nodep->nextp()) {
+        hash += hasher(nodep);
+    }
+    // Equivalent code above may still differ in what is emitted, e.g. line
+    // numbers in messages, or port directions, so add those too
+    netlistp->foreach([&](const AstNode* nodep) {
+        std::ostringstream os;
+        nodep->dumpJson(os);
+        hash += nodep->fileline()->ascii();
+        hash += os.str();
+    });
+    return hash;
+}
+
 //######################################################################
 // This is used by the std::hash specialization for VNRef.
 // Declared separately to avoid a circular header dependency.
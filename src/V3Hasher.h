@@ -49,6 +49,10 @@ public:
 
     // Compute hash of node, without caching in user4.
     static V3Hash uncachedHash(const AstNode* nodep);
+
+    // Compute hash of whole elaborated design, for --skip-identical-elab.
+    // Unlike the above also covers file lines and all node attributes.
+    static V3Hash elabHash(AstNetlist* netlistp);
 };
 
 #endif  // Guard
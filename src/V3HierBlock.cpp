@@ -194,6 +194,9 @@ V3StringList V3HierBlock::commandArgs(bool forCMake) const {
         if (hasParent()) {
             V3Config::getHierWorkersFileLine()->v3warn(
                 E_UNSUPPORTED, "Specifying workers for nested hierarchical blocks");
+        } else if (v3Global.opt.hierProcess()) {
+            V3Config::getHierWorkersFileLine()->v3warn(
+                E_UNSUPPORTED, "Specifying workers with --hierarchical-process");
         } else {
             if (v3Global.opt.threads() < blockThreads) {
                 m_modp->v3error("Hierarchical blocks cannot be scheduled on more threads than in "
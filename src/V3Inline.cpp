@@ -29,6 +29,7 @@
 #include "V3Inline.h"
 
 #include "V3AstUserAllocator.h"
+#include "V3Config.h"
 #include "V3Inst.h"
 #include "V3Stats.h"
 
@@ -39,6 +40,14 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 
 // CONFIG
 static const int INLINE_MODS_SMALLER = 100;  // If a mod is < this # nodes, can always inline it
+// ... unless it has so many instances that inlining would add more than this many times
+// --inline-mult nodes, as in large instance arrays. Instances then share the module's code.
+static const int INLINE_MODS_SMALLER_MULT = 16;
+// Modules taking at least this fraction of the run time according to profile_data -cfunc
+// records are hot, and are inlined unless that would add more than this many times
+// --inline-mult nodes.
+static const double INLINE_MODS_HOT_FRACTION = 0.01;
+static const int INLINE_MODS_HOT_MULT = 64;
 
 //######################################################################
 // Inlining state. Kept as AstNodeModule::user1p via AstUser1Allocator
@@ -81,7 +90,14 @@ class InlineMarkVisitor final : public VNVisitor {
     // STATE
     AstNodeModule* m_modp = nullptr;  // Current module
     VDouble0 m_statUnsup;  // Statistic tracking
+    VDouble0 m_statSharedCells;  // Statistic tracking
+    VDouble0 m_statSharedCellsMax;  // Statistic tracking
+    VDouble0 m_statHot;  // Statistic tracking
     std::vector<AstNodeModule*> m_allMods;  // All modules, in top-down order.
+    // Whether to use profile_data -cfunc records
+    const bool m_profile = v3Global.opt.fProfileGuided() && V3Config::containsCFuncProfileData();
+    // Profile names (FileLine::profileFuncname) of the logic in each module
+    std::unordered_map<const AstNodeModule*, std::unordered_set<std::string>> m_profileNames;
 
     // Within the context of a given module, LocalInstanceMap maps
     // from child modules to the count of each child's local instantiations.
@@ -91,6 +107,22 @@ class InlineMarkVisitor final : public VNVisitor {
     std::unordered_map<AstNodeModule*, LocalInstanceMap> m_instances;
 
     // METHODS
+    void addProfileName(const AstNode* nodep) {
+        if (m_profile && m_modp) {
+            m_profileNames[m_modp].emplace(nodep->fileline()->profileFuncname());
+        }
+    }
+    // Fraction of the profiled run time spent in the module's own logic
+    double profileFraction(const AstNodeModule* modp) const {
+        const auto it = m_profileNames.find(modp);
+        if (it == m_profileNames.end()) return 0.0;
+        double fraction = 0.0;
+        for (const std::string& name : it->second) {
+            fraction += V3Config::getProfileCFuncFraction(name);
+        }
+        return fraction;
+    }
+
     void cantInline(const char* reason, bool hard) {
         if (hard) {
             if (m_modp->user2() != CIL_NOTHARD) {
@@ -172,9 +204,12 @@ class InlineMarkVisitor final : public VNVisitor {
     }
     void visit(AstAlways* nodep) override {
         m_modp->user4Inc();  // statement count
+        // Profiled functions are named after their first statement
+        if (nodep->stmtsp()) addProfileName(nodep->stmtsp());
         iterateChildren(nodep);
     }
     void visit(AstNodeAssign* nodep) override {
+        addProfileName(nodep);
         // Don't count assignments, as they'll likely flatten out
         // Still need to iterate though to nullify VarXRefs
         const int oldcnt = m_modp->user4();
@@ -209,18 +244,35 @@ class InlineMarkVisitor final : public VNVisitor {
             // inlineMult = 2000 by default.
             // If a mod*#refs is < this # nodes, can inline it
             // Packages aren't really "under" anything so they confuse this algorithm
+            const bool small = statements < INLINE_MODS_SMALLER
+                               && (static_cast<double>(refs) * statements
+                                   < static_cast<double>(v3Global.opt.inlineMult())
+                                         * INLINE_MODS_SMALLER_MULT);
+            // Hot modules are worth inlining into their callers to optimize across them
+            const bool hot = m_profile && profileFraction(modp) >= INLINE_MODS_HOT_FRACTION
+                             && (static_cast<double>(refs) * statements
+                                 < static_cast<double>(v3Global.opt.inlineMult())
+                                       * INLINE_MODS_HOT_MULT);
             const bool doit = !VN_IS(modp, Package)  //
                               && allowed != CIL_NOTHARD  //
                               && allowed != CIL_NOTSOFT  //
                               && (allowed == CIL_USER  //
                                   || v3Global.opt.flatten()  //
                                   || refs == 1  //
-                                  || statements < INLINE_MODS_SMALLER  //
+                                  || small  //
+                                  || hot  //
                                   || v3Global.opt.inlineMult() < 1  //
                                   || refs * statements < v3Global.opt.inlineMult());
             m_moduleState(modp).m_inlined = doit;
+            if (doit && hot) ++m_statHot;
+            // Instances of modules not inlined share the module's code
+            if (!doit && refs > 1) {
+                m_statSharedCells += refs;
+                m_statSharedCellsMax = std::max<double>(m_statSharedCellsMax, refs);
+            }
             UINFO(4, " Inline=" << doit << " Possible=" << allowed << " Refs=" << refs
-                                << " Stmts=" << statements << "  " << modp << endl);
+                                << " Stmts=" << statements << " Hot=" << hot << "  " << modp
+                                << endl);
         }
     }
     //--------------------
@@ -237,6 +289,10 @@ public:
     }
     ~InlineMarkVisitor() override {
         V3Stats::addStat("Optimizations, Inline unsupported", m_statUnsup);
+        V3Stats::addStat("Optimizations, Inline kept shared instances", m_statSharedCells);
+        V3Stats::addStat("Optimizations, Inline kept shared instances max per module",
+                         m_statSharedCellsMax);
+        V3Stats::addStat("Optimizations, Inline hot modules", m_statHot);
     }
 };
 
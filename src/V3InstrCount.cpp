@@ -19,10 +19,91 @@
 
 #include "V3InstrCount.h"
 
+#include "V3File.h"
+#include "V3Os.h"
+
+#include <array>
 #include <iomanip>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+//######################################################################
+// Calibrated per-node-type costs, from --instr-cost-table
+//
+// Each line of the table is "<node type> <scale>", e.g. "DIV 1.7", and
+// scales that type's built-in instrCount(). Two keys are special: WIDE
+// additionally scales nodes wider than a quad, and DPI scales calls to
+// DPI import wrappers. Created by verilator_instr_calibrate.
+
+class InstrCostTable final {
+    // MEMBERS
+    std::array<double, VNType::_ENUM_END> m_scale;  // Scale per node type
+    double m_wideScale = 1.0;  // Additional scale for wide nodes
+    double m_dpiScale = 1.0;  // Additional scale for DPI import calls
+    bool m_loaded = false;  // Table was read
+
+    // CONSTRUCTORS
+    InstrCostTable() {
+        m_scale.fill(1.0);
+        const string filename = v3Global.opt.instrCostTable();
+        if (!filename.empty()) load(filename);
+    }
+
+    // METHODS
+    void load(const string& filename) {
+        UINFO(1, "Reading instruction cost table " << filename << endl);
+        const std::unique_ptr<std::ifstream> ifp{V3File::new_ifstream(filename)};
+        if (ifp->fail()) v3fatal("Cannot open --instr-cost-table file: " << filename);
+        std::map<string, VNType> types;
+        for (int i = 0; i < VNType::_ENUM_END; ++i) types.emplace(VNType{i}.ascii(), VNType{i});
+        FileLine* const flp = new FileLine{filename};
+        int lineno = 0;
+        while (!ifp->eof()) {
+            const string line = V3Os::getline(*ifp);
+            flp->lineno(++lineno);
+            std::istringstream is{line.substr(0, line.find("//"))};
+            string key;
+            double scale = 0;
+            if (!(is >> key)) continue;  // Blank or comment
+            if (!(is >> scale) || scale <= 0) {
+                flp->v3error("Expected positive scale after '" << key << "' in cost table");
+                continue;
+            }
+            key = VString::upcase(key);
+            if (key == "WIDE") {
+                m_wideScale = scale;
+            } else if (key == "DPI") {
+                m_dpiScale = scale;
+            } else {
+                const auto it = types.find(key);
+                if (it == types.end()) {
+                    flp->v3error("Unknown node type '" << key << "' in cost table");
+                    continue;
+                }
+                m_scale[it->second] = scale;
+            }
+        }
+        m_loaded = true;
+    }
+
+public:
+    static const InstrCostTable& instance() {
+        static const InstrCostTable s_table;
+        return s_table;
+    }
+    uint32_t cost(const AstNode* nodep) const {
+        const int count = nodep->instrCount();
+        if (!m_loaded || count == 0) return count;
+        double scale = m_scale[nodep->type()];
+        if (nodep->isWide()) scale *= m_wideScale;
+        if (const AstNodeCCall* const callp = VN_CAST(nodep, NodeCCall)) {
+            if (callp->funcp()->dpiImportWrapper()) scale *= m_dpiScale;
+        }
+        // A calibrated cost never rounds a non-free node down to free
+        return std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(count * scale)));
+    }
+};
+
 /// Estimate the instruction cost for executing all logic within and below
 /// a given AST node. Note this estimates the number of instructions we'll
 /// execute, not the number we'll generate. That is, for conditionals,
@@ -43,6 +124,7 @@ class InstrCountVisitor final : public VNVisitorConst {
     bool m_ignoreRemaining = false;  // Ignore remaining statements in the block
     const bool m_assertNoDups;  // Check for duplicates
     const std::ostream* const m_osp;  // Dump file
+    const InstrCostTable& m_costTable = InstrCostTable::instance();  // Calibrated costs
 
     // TYPES
     // Little class to cleanly call startVisitBase/endVisitBase
@@ -107,7 +189,7 @@ private:
         // debug prints to show local cost of each subtree, so we can see a
         // hierarchical view of the cost when in debug mode.
         const uint32_t savedCount = m_instrCount;
-        m_instrCount = nodep->instrCount();
+        m_instrCount = m_costTable.cost(nodep);
         return savedCount;
     }
     void endVisitBase(uint32_t savedCount, AstNode* nodep) {
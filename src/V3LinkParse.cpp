@@ -182,6 +182,10 @@ class LinkParseVisitor final : public VNVisitor {
             if (VN_IS(m_modp, Class)) nodep->classMethod(true);
 
             V3Config::applyFTask(m_modp, nodep);
+            if (nodep->dpiThreads() == VDpiThreads::CONTEXT && !nodep->dpiContext()) {
+                nodep->v3error("dpi_threads_context requires a 'context' DPI import: "
+                               << nodep->prettyNameQ());
+            }
             cleanFileline(nodep);
             VL_RESTORER(m_ftaskp);
             VL_RESTORER(m_lifetime);
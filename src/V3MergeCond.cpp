@@ -42,6 +42,10 @@
 //
 //  Also merges consecutive AstNodeIf statements with the same condition.
 //
+//  A short list of selects between cheap values, on a condition that is a
+//  plain variable, is not merged, as the branchless form is cheaper than a
+//  potentially mispredicted branch.
+//
 //  Because this optimization has notable performance impact, we go further
 //  and perform code motion to try to move mergeable conditionals next to each
 //  other, which in turn enable us to merge more conditionals. To do this, we
@@ -77,6 +81,7 @@
 #include "V3MergeCond.h"
 
 #include "V3AstUserAllocator.h"
+#include "V3Branch.h"
 #include "V3DupFinder.h"
 #include "V3Hasher.h"
 #include "V3Stats.h"
@@ -436,8 +441,12 @@ class MergeCondVisitor final : public VNVisitor {
     //                         (Only below MergeCondVisitor::process).
     // AstNode::user4       -> See CodeMotionAnalysisVisitor/CodeMotionOptimizeVisitor
 
+    // Maximum number of selects left branchless, see preferSelects()
+    static constexpr uint32_t SELECTS_MAX = 2;
+
     // STATE
     VDouble0 m_statMerges;  // Statistic tracking
+    VDouble0 m_statSelectsKept;  // Statistic tracking
     VDouble0 m_statMergedItems;  // Statistic tracking
     VDouble0 m_statCandidateItems;  // Statistic tracking
     VDouble0 m_statLongestList;  // Statistic tracking
@@ -532,6 +541,41 @@ class MergeCondVisitor final : public VNVisitor {
         return false;
     }
 
+    // Check if this expression is a variable or a constant, which are cheap to evaluate
+    // speculatively as an operand of a branchless select.
+    static bool isCheapLeaf(AstNode* nodep) {
+        nodep = skipConstSels(nodep);
+        return VN_IS(nodep, VarRef) || VN_IS(nodep, Const);
+    }
+
+    // Cost model for the current list. Merging saves evaluating the condition once per
+    // statement, but introduces a branch, which is mispredicted when the condition is not
+    // predictable. When the condition is a plain variable and the list is a few selects
+    // between cheap values, the selects compile to conditional moves costing less than a
+    // mispredict, so keep them branchless instead of merging. With profile_data -branch
+    // records for the condition, a predictable branch is always merged, while an
+    // unpredictable one is kept branchless for longer lists.
+    bool preferSelects() const {
+        if (!VN_IS(m_mgCondp, VarRef)) return false;
+        const FileLine* const flp = m_mgCondp->fileline();
+        const bool profiled = V3Branch::profileTakenFraction(flp) >= 0.0;
+        if (profiled && !V3Branch::profilePred(flp).unknown()) return false;
+        const uint32_t selectsMax = profiled ? 2 * SELECTS_MAX : SELECTS_MAX;
+        uint32_t count = 0;
+        for (AstNode* nodep = m_mgFirstp;; nodep = nodep->nextp()) {
+            if (!VN_IS(nodep, Comment)) {
+                const AstAssign* const assignp = VN_CAST(nodep, Assign);
+                if (!assignp || assignp->isWide()) return false;
+                const AstNodeCond* const condp = VN_CAST(assignp->rhsp(), NodeCond);
+                if (!condp || !condp->condp()->sameTree(m_mgCondp)) return false;
+                if (!isCheapLeaf(condp->thenp()) || !isCheapLeaf(condp->elsep())) return false;
+                if (++count > selectsMax) return false;
+            }
+            if (nodep == m_mgLastp) break;
+        }
+        return true;
+    }
+
     // Predicate to check if an expression yields only 0 or 1 (i.e.: a 1-bit value)
     static bool yieldsOneOrZero(const AstNode* nodep) {
         UASSERT_OBJ(!nodep->isWide(), nodep, "Cannot handle wide nodes");
@@ -644,7 +688,10 @@ class MergeCondVisitor final : public VNVisitor {
         // If so, keep hold of the AstNodeIf in this variable.
         AstNodeIf* recursivep = nullptr;
         // Merge if list is longer than one node
-        if (m_mgFirstp != m_mgLastp) {
+        if (m_mgFirstp != m_mgLastp && preferSelects()) {
+            UINFO(6, "MergeCond - Keep selects: " << m_mgFirstp << endl);
+            ++m_statSelectsKept;
+        } else if (m_mgFirstp != m_mgLastp) {
             UINFO(6, "MergeCond - First: " << m_mgFirstp << " Last: " << m_mgLastp << endl);
             ++m_statMerges;
             if (m_listLenght > m_statLongestList) m_statLongestList = m_listLenght;
@@ -877,6 +924,7 @@ public:
         V3Stats::addStat("Optimizations, MergeCond candidate items", m_statCandidateItems);
         V3Stats::addStat("Optimizations, MergeCond merged items", m_statMergedItems);
         V3Stats::addStat("Optimizations, MergeCond longest merge", m_statLongestList);
+        V3Stats::addStat("Optimizations, MergeCond selects kept", m_statSelectsKept);
     }
 };
 
@@ -1233,6 +1233,12 @@ V3Number& V3Number::opRedOr(const V3Number& lhs) {
     // op i, 1 bit return
     NUM_ASSERT_OP_ARGS1(lhs);
     NUM_ASSERT_LOGIC_ARGS1(lhs);
+    if (lhs.isTwoStateLogic()) {
+        for (int word = 0; word < lhs.words(); ++word) {
+            if (lhs.valueWord(word)) return setSingleBits(1);
+        }
+        return setSingleBits(0);
+    }
     char outc = 0;
     for (int bit = 0; bit < lhs.width(); bit++) {
         if (lhs.bitIs1(bit)) {
@@ -1249,6 +1255,12 @@ V3Number& V3Number::opRedAnd(const V3Number& lhs) {
     // op i, 1 bit return
     NUM_ASSERT_OP_ARGS1(lhs);
     NUM_ASSERT_LOGIC_ARGS1(lhs);
+    if (lhs.isTwoStateLogic()) {
+        for (int word = 0; word < lhs.words() - 1; ++word) {
+            if (lhs.valueWord(word) != 0xffffffffU) return setSingleBits(0);
+        }
+        return setSingleBits(lhs.valueWord(lhs.words() - 1) == lhs.hiWordMask());
+    }
     char outc = 1;
     for (int bit = 0; bit < lhs.width(); bit++) {
         if (lhs.bitIs0(bit)) {
@@ -1265,6 +1277,16 @@ V3Number& V3Number::opRedXor(const V3Number& lhs) {
     // op i, 1 bit return
     NUM_ASSERT_OP_ARGS1(lhs);
     NUM_ASSERT_LOGIC_ARGS1(lhs);
+    if (lhs.isTwoStateLogic()) {
+        uint32_t parity = 0;
+        for (int word = 0; word < lhs.words(); ++word) parity ^= lhs.valueWord(word);
+        parity ^= parity >> 16;
+        parity ^= parity >> 8;
+        parity ^= parity >> 4;
+        parity ^= parity >> 2;
+        parity ^= parity >> 1;
+        return setSingleBits(parity & 1);
+    }
     char outc = 0;
     for (int bit = 0; bit < lhs.width(); bit++) {
         if (lhs.bitIs1(bit)) {
@@ -1333,6 +1355,12 @@ V3Number& V3Number::opLogNot(const V3Number& lhs) {
     NUM_ASSERT_OP_ARGS1(lhs);
     NUM_ASSERT_LOGIC_ARGS1(lhs);
     // op i, 1 bit return
+    if (lhs.isTwoStateLogic()) {
+        for (int word = 0; word < lhs.words(); ++word) {
+            if (lhs.valueWord(word)) return setSingleBits(0);
+        }
+        return setSingleBits(1);
+    }
     char outc = 1;
     for (int bit = 0; bit < lhs.width(); bit++) {
         if (lhs.bitIs1(bit)) {
@@ -1352,6 +1380,13 @@ V3Number& V3Number::opNot(const V3Number& lhs) {
     NUM_ASSERT_LOGIC_ARGS1(lhs);
     // op i, L(lhs) bit return
     setZero();
+    if (lhs.isTwoStateLogic()) {
+        for (int word = 0; word < words(); ++word) {
+            m_data.num()[word].m_value = ~lhs.valueWord(word);
+        }
+        opCleanThis();
+        return *this;
+    }
     for (int bit = 0; bit < width(); bit++) {
         if (lhs.bitIs0(bit)) {
             setBit(bit, 1);
@@ -1367,6 +1402,13 @@ V3Number& V3Number::opAnd(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     // i op j, max(L(lhs),L(rhs)) bit return, careful need to X/Z extend.
     setZero();
+    if (lhs.isTwoStateLogic() && rhs.isTwoStateLogic()) {
+        for (int word = 0; word < words(); ++word) {
+            m_data.num()[word].m_value = lhs.valueWord(word) & rhs.valueWord(word);
+        }
+        opCleanThis();
+        return *this;
+    }
     for (int bit = 0; bit < width(); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs1(bit)) {
             setBit(bit, 1);
@@ -1383,6 +1425,13 @@ V3Number& V3Number::opOr(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     // i op j, max(L(lhs),L(rhs)) bit return, careful need to X/Z extend.
     setZero();
+    if (lhs.isTwoStateLogic() && rhs.isTwoStateLogic()) {
+        for (int word = 0; word < words(); ++word) {
+            m_data.num()[word].m_value = lhs.valueWord(word) | rhs.valueWord(word);
+        }
+        opCleanThis();
+        return *this;
+    }
     for (int bit = 0; bit < width(); bit++) {
         if (lhs.bitIs1(bit) || rhs.bitIs1(bit)) {
             setBit(bit, 1);
@@ -1400,6 +1449,13 @@ V3Number& V3Number::opXor(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     setZero();
+    if (lhs.isTwoStateLogic() && rhs.isTwoStateLogic()) {
+        for (int word = 0; word < words(); ++word) {
+            m_data.num()[word].m_value = lhs.valueWord(word) ^ rhs.valueWord(word);
+        }
+        opCleanThis();
+        return *this;
+    }
     for (int bit = 0; bit < width(); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs0(bit)) {
             setBit(bit, 1);
@@ -1640,6 +1696,12 @@ V3Number& V3Number::opEq(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     if (lhs.isString()) return opEqN(lhs, rhs);
     if (lhs.isDouble()) return opEqD(lhs, rhs);
+    if (lhs.isTwoStateLogic() && rhs.isTwoStateLogic()) {
+        for (int word = 0; word < std::max(lhs.words(), rhs.words()); ++word) {
+            if (lhs.valueWord(word) != rhs.valueWord(word)) return setSingleBits(0);
+        }
+        return setSingleBits(1);
+    }
     char outc = 1;
     for (int bit = 0; bit < std::max(lhs.width(), rhs.width()); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs0(bit)) {
@@ -1662,6 +1724,12 @@ V3Number& V3Number::opNeq(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     if (lhs.isString()) return opNeqN(lhs, rhs);
     if (lhs.isDouble()) return opNeqD(lhs, rhs);
+    if (lhs.isTwoStateLogic() && rhs.isTwoStateLogic()) {
+        for (int word = 0; word < std::max(lhs.words(), rhs.words()); ++word) {
+            if (lhs.valueWord(word) != rhs.valueWord(word)) return setSingleBits(1);
+        }
+        return setSingleBits(0);
+    }
     char outc = 0;
     for (int bit = 0; bit < std::max(lhs.width(), rhs.width()); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs0(bit)) {
@@ -1752,6 +1820,14 @@ V3Number& V3Number::opGt(const V3Number& lhs, const V3Number& rhs) {
     // i op j, 1 bit return, max(L(lhs),L(rhs)) calculation, careful need to X/Z extend.
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
+    if (lhs.isTwoStateLogic() && rhs.isTwoStateLogic()) {
+        for (int word = std::max(lhs.words(), rhs.words()) - 1; word >= 0; --word) {
+            const uint32_t lword = lhs.valueWord(word);
+            const uint32_t rword = rhs.valueWord(word);
+            if (lword != rword) return setSingleBits(lword > rword);
+        }
+        return setSingleBits(0);
+    }
     char outc = 0;
     for (int bit = 0; bit < std::max(lhs.width(), rhs.width()); bit++) {
         if (lhs.bitIs1(bit) && rhs.bitIs0(bit)) outc = 1;
@@ -1822,6 +1898,17 @@ V3Number& V3Number::opShiftR(const V3Number& lhs, const V3Number& rhs) {
     }
     const uint32_t rhsval = rhs.toUInt();
     if (rhsval < static_cast<uint32_t>(lhs.width())) {
+        if (lhs.isTwoStateLogic()) {
+            const int wordShift = rhsval / 32;
+            const int bitShift = rhsval % 32;
+            for (int word = 0; word < words(); ++word) {
+                uint32_t value = lhs.valueWord(word + wordShift) >> bitShift;
+                if (bitShift) value |= lhs.valueWord(word + wordShift + 1) << (32 - bitShift);
+                m_data.num()[word].m_value = value;
+            }
+            opCleanThis();
+            return *this;
+        }
         for (int bit = 0; bit < width(); bit++) setBit(bit, lhs.bitIs(bit + rhsval));
     }
     return *this;
@@ -1865,6 +1952,20 @@ V3Number& V3Number::opShiftL(const V3Number& lhs, const V3Number& rhs) {
         if (rhs.bitIs1(bit)) return *this;  // shift of over 2^32 must be zero
     }
     const uint32_t rhsval = rhs.toUInt();
+    if (lhs.isTwoStateLogic()) {
+        if (rhsval >= static_cast<uint32_t>(width())) return *this;
+        const int wordShift = rhsval / 32;
+        const int bitShift = rhsval % 32;
+        for (int word = wordShift; word < words(); ++word) {
+            uint32_t value = lhs.valueWord(word - wordShift) << bitShift;
+            if (bitShift && word > wordShift) {
+                value |= lhs.valueWord(word - wordShift - 1) >> (32 - bitShift);
+            }
+            m_data.num()[word].m_value = value;
+        }
+        opCleanThis();
+        return *this;
+    }
     for (int bit = 0; bit < width(); bit++) {
         if (bit >= static_cast<int>(rhsval)) setBit(bit, lhs.bitIs(bit - rhsval));
     }
@@ -2595,4 +2696,29 @@ void V3Number::selfTestThis() {
     UASSERT_SELFTEST(int, log2b(1), 0);
     UASSERT_SELFTEST(int, log2b(0x40000000UL), 30);
     UASSERT_SELFTEST(int, log2bQuad(0x4000000000000000ULL), 62);
+
+    // Word-at-a-time two-state operations
+    {
+        const V3Number a{fileline(), "70'h3f_0000_0001_8000_0000"};
+        const V3Number b{fileline(), "70'h00_ffff_ffff_0000_0001"};
+        const V3Number four{fileline(), 32, 4};
+        const V3Number shift36{fileline(), 32, 36};
+        V3Number res{fileline(), 70, 0};
+        V3Number bit{fileline(), 1, 0};
+        res.opAnd(a, b);
+        UASSERT_SELFTEST(bool, res.isCaseEq(V3Number{fileline(), "70'h1_0000_0000"}), true);
+        res.opNot(a);
+        UASSERT_SELFTEST(bool, res.isCaseEq(V3Number{fileline(), "70'hffff_fffe_7fff_ffff"}),
+                         true);
+        res.opShiftL(a, four);
+        UASSERT_SELFTEST(bool, res.isCaseEq(V3Number{fileline(), "70'h30_0000_0018_0000_0000"}),
+                         true);
+        res.opShiftR(b, shift36);
+        UASSERT_SELFTEST(bool, res.isCaseEq(V3Number{fileline(), "70'hfff_ffff"}), true);
+        UASSERT_SELFTEST(bool, bit.opGt(a, b).isNeqZero(), true);
+        UASSERT_SELFTEST(bool, bit.opGt(b, a).isNeqZero(), false);
+        UASSERT_SELFTEST(bool, bit.opEq(a, a).isNeqZero(), true);
+        UASSERT_SELFTEST(bool, bit.opRedXor(a).isNeqZero(), false);
+        UASSERT_SELFTEST(bool, bit.opRedAnd(a).isNeqZero(), false);
+    }
 }
@@ -452,6 +452,16 @@ private:
         return v;
     }
 
+    // Value bits of a word, zero beyond the width, for word-at-a-time two-state operations
+    uint32_t valueWord(int word) const VL_MT_SAFE {
+        if (word >= words()) return 0;
+        const uint32_t value = m_data.num()[word].m_value;
+        return word == words() - 1 ? (value & hiWordMask()) : value;
+    }
+    bool isTwoStateLogic() const VL_MT_SAFE {
+        return dataType() == V3NumberDataType::LOGIC && !isFourState();
+    }
+
     int countX(int lsb, int nbits) const VL_MT_SAFE;
     int countZ(int lsb, int nbits) const VL_MT_SAFE;
 
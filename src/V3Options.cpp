@@ -26,6 +26,7 @@
 #include "V3Os.h"
 #include "V3PreShell.h"
 #include "V3String.h"
+#include "V3ThreadPool.h"
 
 // clang-format off
 #include <sys/types.h>
@@ -48,6 +49,8 @@
 #include <thread>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "config_rev.h"
 
@@ -77,6 +80,7 @@ public:
     std::list<string> m_libExtVs;  // Library extensions (ordered)
     std::set<string> m_libExtVSet;  // Library extensions (for removing duplicates)
     DirMap m_dirMap;  // Directory listing
+    std::unordered_map<string, string> m_filePathMap;  // filePath results, "" if not found
 
     // ACCESSOR METHODS
     void addIncDirUser(const string& incdir) {
@@ -87,6 +91,7 @@ public:
             m_incDirUsers.push_back(dir);
             m_incDirFallbacks.remove(dir);  // User has priority over Fallback
             m_incDirFallbackSet.erase(dir);  // User has priority over Fallback
+            m_filePathMap.clear();
         }
     }
     void addIncDirFallback(const string& incdir) {
@@ -94,7 +99,10 @@ public:
         if (m_incDirUserSet.find(dir)
             == m_incDirUserSet.end()) {  // User has priority over Fallback
             const auto itFoundPair = m_incDirFallbackSet.insert(dir);
-            if (itFoundPair.second) m_incDirFallbacks.push_back(dir);
+            if (itFoundPair.second) {
+                m_incDirFallbacks.push_back(dir);
+                m_filePathMap.clear();
+            }
         }
     }
     void addLangExt(const string& langext, const V3LangCode& lc) {
@@ -107,7 +115,10 @@ public:
 
     void addLibExtV(const string& libext) {
         const auto itFoundPair = m_libExtVSet.insert(libext);
-        if (itFoundPair.second) m_libExtVs.push_back(libext);
+        if (itFoundPair.second) {
+            m_libExtVs.push_back(libext);
+            m_filePathMap.clear();
+        }
     }
     V3OptionsImp() = default;
     ~V3OptionsImp() = default;
@@ -492,6 +503,49 @@ bool V3Options::fileStatNormal(const string& filename) {
     return true;
 }
 
+bool V3Options::readDirListing(const string& dir, std::set<string>& files) VL_MT_SAFE {
+    // Read the directory's entries into files, return false if unreadable
+#ifdef _MSC_VER
+    try {
+        for (const auto& dirEntry : std::filesystem::directory_iterator(dir.c_str()))
+            files.insert(dirEntry.path().filename().string());
+    } catch (std::filesystem::filesystem_error const& ex) {
+        (void)ex;
+        return false;
+    }
+#else
+    if (DIR* const dirp = opendir(dir.c_str())) {
+        while (struct dirent* direntp = readdir(dirp)) files.insert(direntp->d_name);
+        closedir(dirp);
+    }
+#endif
+    return true;
+}
+
+void V3Options::prefetchDirs() {
+    // Read the listings of all search directories in parallel; on network
+    // filesystems with many -y directories reading them one by one dominates
+    std::vector<string> dirs;
+    for (const string& dir : m_impp->m_incDirUsers) dirs.push_back(dir);
+    for (const string& dir : m_impp->m_incDirFallbacks) dirs.push_back(dir);
+    std::vector<std::set<string>> listings(dirs.size());
+    std::vector<uint8_t> oks(dirs.size(), 0);
+    {
+        V3ThreadScope threadScope;
+        for (size_t i = 0; i < dirs.size(); ++i) {
+            // Key as fileExists() will, e.g. "" becomes "."
+            dirs[i] = V3Os::filenameDir(V3Os::filenameJoin(dirs[i], "x"));
+            if (m_impp->m_dirMap.count(dirs[i])) continue;
+            threadScope.enqueue([&dirs, &listings, &oks, i]() {
+                oks[i] = readDirListing(dirs[i], listings[i]);
+            });
+        }
+    }
+    for (size_t i = 0; i < dirs.size(); ++i) {
+        if (oks[i]) m_impp->m_dirMap.emplace(dirs[i], std::move(listings[i]));
+    }
+}
+
 string V3Options::fileExists(const string& filename) {
     // Surprisingly, for VCS and other simulators, this process
     // is quite slow; presumably because of re-reading each directory
@@ -506,22 +560,7 @@ string V3Options::fileExists(const string& filename) {
         m_impp->m_dirMap.emplace(dir, std::set<string>());
         diriter = m_impp->m_dirMap.find(dir);
 
-        std::set<string>* const setp = &(diriter->second);
-
-#ifdef _MSC_VER
-        try {
-            for (const auto& dirEntry : std::filesystem::directory_iterator(dir.c_str()))
-                setp->insert(dirEntry.path().filename().string());
-        } catch (std::filesystem::filesystem_error const& ex) {
-            (void)ex;
-            return "";
-        }
-#else
-        if (DIR* const dirp = opendir(dir.c_str())) {
-            while (struct dirent* direntp = readdir(dirp)) setp->insert(direntp->d_name);
-            closedir(dirp);
-        }
-#endif
+        if (!readDirListing(dir, diriter->second)) return "";
     }
     // Find it
     const std::set<string>* const filesetp = &(diriter->second);
@@ -574,6 +613,22 @@ string V3Options::filePath(FileLine* fl, const string& modname, const string& la
     // using the incdir and libext's.
     // Return "" if not found.
     const string filename = V3Os::filenameCleanup(VName::dehash(modname));
+    // Memoize, as V3LinkCells probes every directory for each unresolved module
+    const string key = m_relativeIncludes ? filename + '\n' + lastpath : filename;
+    const auto pair = m_impp->m_filePathMap.emplace(key, "");
+    if (pair.second) pair.first->second = filePathSearch(filename, lastpath);
+    if (!pair.first->second.empty()) return pair.first->second;
+
+    // Warn and return not found
+    if (errmsg != "") {
+        fl->v3error(errmsg + "'"s + filename + "'"s);
+        filePathLookedMsg(fl, filename);
+    }
+    return "";
+}
+
+string V3Options::filePathSearch(const string& filename, const string& lastpath) {
+    // Search the incdirs and libexts for filename, return "" if not found
     if (!V3Os::filenameIsRel(filename)) {
         // filename is an absolute path, so can find getStdPackagePath()/getStdWaiverPath()
         const string exists = filePathCheckOneDir(filename, "");
@@ -592,12 +647,6 @@ string V3Options::filePath(FileLine* fl, const string& modname, const string& la
         const string exists = filePathCheckOneDir(filename, lastpath);
         if (exists != "") return V3Os::filenameRealPath(exists);
     }
-
-    // Warn and return not found
-    if (errmsg != "") {
-        fl->v3error(errmsg + "'"s + filename + "'"s);
-        filePathLookedMsg(fl, filename);
-    }
     return "";
 }
 
@@ -852,6 +901,18 @@ void V3Options::notify() VL_MT_DISABLED {
     if (m_build && (m_gmake || m_cmake || m_makeJson)) {
         cmdfl->v3error("--make cannot be used together with --build. Suggest see manual");
     }
+    if (!m_ccPgo.empty() && (!m_build || !m_exe)) {
+        cmdfl->v3error("--cc-pgo requires --build and --exe, or --binary");
+    }
+    if (!m_ccPgo.empty() && m_hierarchical) {
+        cmdfl->v3error("--cc-pgo cannot be used together with --hierarchical");
+    }
+    if (!m_ccPgo.empty() && m_buildNinja) {
+        cmdfl->v3error("--cc-pgo cannot be used together with --build-tool ninja");
+    }
+    if (m_buildNinja && m_hierarchical && !m_exe) {
+        cmdfl->v3error("--build-tool ninja with --hierarchical requires --exe or --binary");
+    }
 
     // m_build, m_preprocOnly, m_dpiHdrOnly, m_lintOnly, m_jsonOnly and m_xmlOnly are mutually
     // exclusive
@@ -879,9 +940,17 @@ void V3Options::notify() VL_MT_DISABLED {
     if (m_exe && !v3Global.opt.libCreate().empty()) {
         cmdfl->v3error("--exe cannot be used together with --lib-create. Suggest see manual");
     }
+    if (m_slowSharedLib && (!m_libCreate.empty() || m_hierarchical || m_hierChild)) {
+        cmdfl->v3error("--slow-shared-lib cannot be used together with --lib-create or "
+                       "--hierarchical");
+    }
 
     // Make sure at least one make system is enabled
     if (!m_gmake && !m_cmake && !m_makeJson) m_gmake = true;
+    if (m_buildNinja && !m_gmake) {
+        cmdfl->v3error("--build-tool ninja requires --make gmake, as flags come from "
+                       "verilated.mk");
+    }
 
     if (m_hierarchical && (m_hierChild || !m_hierBlocks.empty())) {
         cmdfl->v3error(
@@ -929,11 +998,6 @@ void V3Options::notify() VL_MT_DISABLED {
             && !v3Global.opt.serializeOnly());
     }
 
-    if (trace()) {
-        // With --trace-vcd, --trace-threads is ignored
-        if (traceFormat().vcd()) m_traceThreads = 1;
-    }
-
     UASSERT(!(useTraceParallel() && useTraceOffload()),
             "Cannot use both parallel and offloaded tracing");
 
@@ -952,6 +1016,12 @@ void V3Options::notify() VL_MT_DISABLED {
     if (v3Global.opt.timing().isSetTrue() && savable()) {
         cmdfl->v3error("Unsupported: --timing and --savable not supported together");
     }
+    if (cycleMode() && systemC()) {
+        cmdfl->v3error("Unsupported: --cycle-mode and --sc not supported together");
+    }
+    if (cycleMode() && v3Global.opt.timing().isSetTrue()) {
+        cmdfl->v3error("Unsupported: --cycle-mode and --timing not supported together");
+    }
 
     // --dump-tree-dot will turn on tree dumping.
     if (!m_dumpLevel.count("tree") && m_dumpLevel.count("tree-dot")) {
@@ -1177,6 +1247,9 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     // Minus options
     DECL_OPTION("-assert", OnOff, &m_assert);
     DECL_OPTION("-assert-case", OnOff, &m_assertCase);
+    DECL_OPTION("-assert-gate-past", OnOff, &m_assertGatePast);
+    DECL_OPTION("-assert-offload", OnOff, &m_assertOffload);
+    DECL_OPTION("-ast-spill-dir", Set, &m_astSpillDir);
     DECL_OPTION("-autoflush", OnOff, &m_autoflush);
 
     DECL_OPTION("-bbox-sys", OnOff, &m_bboxSys);
@@ -1204,11 +1277,22 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         }
         m_buildJobs = val;
     });
+    DECL_OPTION("-build-tool", CbVal, [this, fl](const char* valp) {
+        if (!std::strcmp(valp, "make")) {
+            m_buildNinja = false;
+        } else if (!std::strcmp(valp, "ninja")) {
+            m_buildNinja = true;
+        } else {
+            fl->v3error("Unknown --build-tool specified: '" << valp << "'");
+        }
+    });
 
     DECL_OPTION("-CFLAGS", CbVal, callStrSetter(&V3Options::addCFlags));
     DECL_OPTION("-cc", CbCall, [this]() { ccSet(); });
+    DECL_OPTION("-cc-pgo", Set, &m_ccPgo);
     DECL_OPTION("-clk", CbVal, callStrSetter(&V3Options::addClocker));
     DECL_OPTION("-no-clk", CbVal, callStrSetter(&V3Options::addNoClocker));
+    DECL_OPTION("-comb-skip-unchanged", OnOff, &m_combSkipUnchanged);
     DECL_OPTION("-comp-limit-blocks", Set, &m_compLimitBlocks).undocumented();
     DECL_OPTION("-comp-limit-members", Set,
                 &m_compLimitMembers)
@@ -1242,8 +1326,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-coverage-line", OnOff, &m_coverageLine);
     DECL_OPTION("-coverage-max-width", Set, &m_coverageMaxWidth);
     DECL_OPTION("-coverage-toggle", OnOff, &m_coverageToggle);
+    DECL_OPTION("-coverage-toggle-saturate", OnOff, &m_coverageToggleSaturate);
     DECL_OPTION("-coverage-underscore", OnOff, &m_coverageUnderscore);
     DECL_OPTION("-coverage-user", OnOff, &m_coverageUser);
+    DECL_OPTION("-cycle-mode", OnOff, &m_cycleMode);
 
     DECL_OPTION("-D", CbPartialMatch,
                 [this](const char* valp) VL_MT_DISABLED { addDefine(valp, false); });
@@ -1256,6 +1342,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
                 V3Error::vlAbort)
         .undocumented();  // See also --debug-sigsegv
     DECL_OPTION("-debug-check", OnOff, &m_debugCheck);
+    DECL_OPTION("-debug-check-full", CbVal, [this, fl](const char* valp) {
+        m_debugCheckFull = std::atoi(valp);
+        if (m_debugCheckFull < 0) fl->v3error("--debug-check-full must be >= 0: " << valp);
+    });
     DECL_OPTION("-debug-collision", OnOff, &m_debugCollision).undocumented();
     DECL_OPTION("-debug-emitv", OnOff, &m_debugEmitV).undocumented();
     DECL_OPTION("-debug-exit-parse", OnOff, &m_debugExitParse).undocumented();
@@ -1275,6 +1365,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-decoration", CbCall, [this, fl]() { decorations(fl, "medium"); });
     DECL_OPTION("-decorations", CbVal, [this, fl](const char* optp) { decorations(fl, optp); });
     DECL_OPTION("-no-decoration", CbCall, [this, fl]() { decorations(fl, "none"); });
+    DECL_OPTION("-dpi-export-handles", OnOff, &m_dpiExportHandles);
     DECL_OPTION("-dpi-hdr-only", OnOff, &m_dpiHdrOnly);
     DECL_OPTION("-dump-", CbPartialMatch, [this](const char* optp) { m_dumpLevel[optp] = 3; });
     DECL_OPTION("-no-dump-", CbPartialMatch, [this](const char* optp) { m_dumpLevel[optp] = 0; });
@@ -1309,6 +1400,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
 
     DECL_OPTION("-facyc-simp", FOnOff, &m_fAcycSimp);
     DECL_OPTION("-fassemble", FOnOff, &m_fAssemble);
+    DECL_OPTION("-fassoc-hash", FOnOff, &m_fAssocHash);
     DECL_OPTION("-fcase", FOnOff, &m_fCase);
     DECL_OPTION("-fcombine", FOnOff, &m_fCombine);
     DECL_OPTION("-fconst", FOnOff, &m_fConst);
@@ -1321,6 +1413,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_fDfgPreInline = flag;
         m_fDfgPostInline = flag;
     });
+    DECL_OPTION("-fdfg-break-cycles", FOnOff, &m_fDfgBreakCycles);
     DECL_OPTION("-fdfg-peephole", FOnOff, &m_fDfgPeephole);
     DECL_OPTION("-fdfg-peephole-", CbPartialMatch, [this](const char* optp) {  //
         m_fDfgPeepholeDisabled.erase(optp);
@@ -1331,6 +1424,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-fdfg-pre-inline", FOnOff, &m_fDfgPreInline);
     DECL_OPTION("-fdfg-post-inline", FOnOff, &m_fDfgPostInline);
     DECL_OPTION("-fexpand", FOnOff, &m_fExpand);
+    DECL_OPTION("-fexpand-vector", FOnOff, &m_fExpandVector);
     DECL_OPTION("-ffunc-opt", CbFOnOff, [this](bool flag) {  //
         m_fFuncSplitCat = flag;
         m_fFuncBalanceCat = flag;
@@ -1346,6 +1440,9 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-fmerge-cond", FOnOff, &m_fMergeCond);
     DECL_OPTION("-fmerge-cond-motion", FOnOff, &m_fMergeCondMotion);
     DECL_OPTION("-fmerge-const-pool", FOnOff, &m_fMergeConstPool);
+    DECL_OPTION("-fnba-in-place", FOnOff, &m_fNbaInPlace);
+    DECL_OPTION("-fpch-syms", FOnOff, &m_fPchSyms);
+    DECL_OPTION("-fprofile-guided", FOnOff, &m_fProfileGuided);
     DECL_OPTION("-freloop", FOnOff, &m_fReloop);
     DECL_OPTION("-freorder", FOnOff, &m_fReorder);
     DECL_OPTION("-fslice", FOnOff, &m_fSlice);
@@ -1354,6 +1451,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-fsubst-const", FOnOff, &m_fSubstConst);
     DECL_OPTION("-ftable", FOnOff, &m_fTable);
     DECL_OPTION("-ftaskify-all-forked", FOnOff, &m_fTaskifyAll).undocumented();  // Debug
+    DECL_OPTION("-fudp-logic", FOnOff, &m_fUdpLogic);
     DECL_OPTION("-fvar-split", FOnOff, &m_fVarSplit);
 
     DECL_OPTION("-G", CbPartialMatch, [this](const char* optp) { addParameter(optp, false); });
@@ -1379,6 +1477,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_hierBlocks.emplace(opt.mangledName(), opt);
     });
     DECL_OPTION("-hierarchical-child", Set, &m_hierChild);
+    DECL_OPTION("-hierarchical-process", OnOff, &m_hierProcess);
     DECL_OPTION("-hierarchical-params-file", CbVal,
                 [this](const char* optp) { m_hierParamsFile = optp; });
 
@@ -1391,6 +1490,9 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_instrCountDpi = val;
         if (m_instrCountDpi < 0) fl->v3fatal("--instr-count-dpi must be non-negative: " << val);
     });
+    DECL_OPTION("-instr-cost-table", CbVal, [this, &optdir](const char* valp) {
+        m_instrCostTable = parseFileArg(optdir, valp);
+    });
 
     DECL_OPTION("-json-edit-nums", OnOff, &m_jsonEditNums);
     DECL_OPTION("-json-ids", OnOff, &m_jsonIds);
@@ -1399,10 +1501,18 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_jsonOnlyMetaOutput = valp;
         m_jsonOnly = true;
     });
+    DECL_OPTION("-json-only-index", CbOnOff, [this](bool flag) {
+        m_jsonOnlyIndex = flag;
+        if (flag) m_jsonOnly = true;
+    });
     DECL_OPTION("-json-only-output", CbVal, [this](const char* valp) {
         m_jsonOnlyOutput = valp;
         m_jsonOnly = true;
     });
+    DECL_OPTION("-json-only-split", CbOnOff, [this](bool flag) {
+        m_jsonOnlySplit = flag;
+        if (flag) m_jsonOnly = true;
+    });
 
     DECL_OPTION("-LDFLAGS", CbVal, callStrSetter(&V3Options::addLdLibs));
     DECL_OPTION("-l2-name", Set, &m_l2Name);
@@ -1460,10 +1570,15 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-O2", CbCall, [this]() { optimize(2); });
     DECL_OPTION("-O3", CbCall, [this]() { optimize(3); });
 
+    DECL_OPTION("-numa-layout", OnOff, &m_numaLayout);
     DECL_OPTION("-o", Set, &m_exeName);
     DECL_OPTION("-order-clock-delay", CbOnOff, [fl](bool /*flag*/) {
         fl->v3warn(DEPRECATED, "Option order-clock-delay is deprecated and has no effect.");
     });
+    DECL_OPTION("-output-asm-tables", CbVal, [this, fl](const char* valp) {
+        m_outputAsmTables = std::atoi(valp);
+        if (m_outputAsmTables < 0) fl->v3error("--output-asm-tables must be >= 0: " << valp);
+    });
     DECL_OPTION("-output-groups", CbVal, [this, fl](const char* valp) {
         m_outputGroups = std::atoi(valp);
         if (m_outputGroups < -1) fl->v3error("--output-groups must be >= -1: " << valp);
@@ -1483,6 +1598,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     });
 
     DECL_OPTION("-P", Set, &m_preprocNoLine);
+    DECL_OPTION("-pack-bits", OnOff, &m_packBits);
     DECL_OPTION("-pins64", CbCall, [this]() { m_pinsBv = 65; });
     DECL_OPTION("-no-pins64", CbCall, [this]() { m_pinsBv = 33; });
     DECL_OPTION("-pins-bv", CbVal, [this, fl](const char* valp) {
@@ -1516,6 +1632,8 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-prof-cfuncs", CbCall, [this]() { m_profC = m_profCFuncs = true; });
     DECL_OPTION("-prof-exec", OnOff, &m_profExec);
     DECL_OPTION("-prof-pgo", OnOff, &m_profPgo);
+    DECL_OPTION("-prof-pgo-branches", OnOff, &m_profPgoBranches);
+    DECL_OPTION("-prof-verilation", Set, &m_profVerilation);
     DECL_OPTION("-profile-cfuncs", CbCall,
                 [this]() { m_profC = m_profCFuncs = true; });  // Renamed
     DECL_OPTION("-protect-ids", OnOff, &m_protectIds);
@@ -1563,13 +1681,28 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         addCFlags("-DVL_DEBUG=1");
     });
 
-    DECL_OPTION("-savable", OnOff, &m_savable);
+    DECL_OPTION("-savable", CbOnOff, [this](bool flag) {
+        m_savable = flag;
+        if (flag) addLdLibs("-lz");  // For VerilatedSave::openChunked
+    });
     DECL_OPTION("-sc", CbCall, [this]() {
         m_outFormatOk = true;
         m_systemC = true;
     });
+    DECL_OPTION("-sc-clocked-eval", OnOff, &m_scClockedEval);
     DECL_OPTION("-skip-identical", OnOff, &m_skipIdentical);
+    DECL_OPTION("-skip-identical-elab", OnOff, &m_skipIdenticalElab);
+    DECL_OPTION("-slow-shared-lib", OnOff, &m_slowSharedLib);
+    DECL_OPTION("-sparse-array-limit", CbVal, [this, fl](const char* valp) {
+        m_sparseArrayLimit = std::atoi(valp);
+        if (m_sparseArrayLimit < 0) fl->v3error("--sparse-array-limit must be >= 0: " << valp);
+    });
     DECL_OPTION("-stats", OnOff, &m_stats);
+    DECL_OPTION("-stats-memory", CbOnOff, [this](bool flag) {
+        m_statsMemory = flag;
+        m_stats |= flag;
+    });
+    DECL_OPTION("-stats-runtime", OnOff, &m_statsRuntime);
     DECL_OPTION("-stats-vars", CbOnOff, [this](bool flag) {
         m_statsVars = flag;
         m_stats |= flag;
@@ -1596,7 +1729,9 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
             m_threads = 1;
         }
     });
+    DECL_OPTION("-threads-adaptive", OnOff, &m_threadsAdaptive);
     DECL_OPTION("-threads-coarsen", OnOff, &m_threadsCoarsen).undocumented();  // Debug
+    DECL_OPTION("-threads-coarsen-min", Set, &m_threadsCoarsenMin).undocumented();  // Debug
     DECL_OPTION("-threads-dpi", CbVal, [this, fl](const char* valp) {
         if (!std::strcmp(valp, "all")) {
             m_threadsDpiPure = true;
@@ -1617,6 +1752,18 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_threadsMaxMTasks = std::atoi(valp);
         if (m_threadsMaxMTasks < 1) fl->v3fatal("--threads-max-mtasks must be >= 1: " << valp);
     });
+    DECL_OPTION("-threads-schedule", CbVal, [this, fl](const char* valp) {
+        if (!std::strcmp(valp, "static")) {
+            m_threadsDynamic = false;
+        } else if (!std::strcmp(valp, "dynamic")) {
+            m_threadsDynamic = true;
+        } else {
+            fl->v3error("Unknown setting for --threads-schedule: '"
+                        << valp << "'\n"
+                        << fl->warnMore() << "... Suggest 'static' or 'dynamic'");
+        }
+    });
+    DECL_OPTION("-threads-settle", OnOff, &m_threadsSettle);
     DECL_OPTION("-timescale", CbVal, [this, fl](const char* valp) {
         VTimescale unit;
         VTimescale prec;
@@ -2157,6 +2304,7 @@ void V3Options::optimize(int level) {
     const bool flag = level > 0;
     m_fAcycSimp = flag;
     m_fAssemble = flag;
+    m_fAssocHash = flag;
     m_fCase = flag;
     m_fCombine = flag;
     m_fConst = flag;
@@ -2167,12 +2315,14 @@ void V3Options::optimize(int level) {
     m_fDeadAssigns = flag;
     m_fDeadCells = flag;
     m_fExpand = flag;
+    m_fExpandVector = flag;
     m_fGate = flag;
     m_fInline = flag;
     m_fLife = flag;
     m_fLifePost = flag;
     m_fLocalize = flag;
     m_fMergeCond = flag;
+    m_fNbaInPlace = flag;
     m_fReloop = flag;
     m_fReorder = flag;
     m_fSplit = flag;
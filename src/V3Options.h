@@ -225,18 +225,24 @@ private:
     bool m_preprocNoLine = false;   // main switch: -P
     bool m_assert = false;          // main switch: --assert
     bool m_assertCase = false;      // main switch: --assert-case
+    bool m_assertGatePast = false;  // main switch: --assert-gate-past
+    bool m_assertOffload = false;   // main switch: --assert-offload
     bool m_autoflush = false;       // main switch: --autoflush
     bool m_bboxSys = false;         // main switch: --bbox-sys
     bool m_bboxUnsup = false;       // main switch: --bbox-unsup
     bool m_binary = false;          // main switch: --binary
     bool m_build = false;           // main switch: --build
+    bool m_buildNinja = false;      // main switch: --build-tool ninja
     bool m_cmake = false;           // main switch: --make cmake
+    bool m_combSkipUnchanged = false;  // main switch: --comb-skip-unchanged
     bool m_context = true;          // main switch: --Wcontext
     bool m_coverageExpr = false;    // main switch: --coverage-expr
     bool m_coverageLine = false;    // main switch: --coverage-block
     bool m_coverageToggle = false;  // main switch: --coverage-toggle
+    bool m_coverageToggleSaturate = false;  // main switch: --coverage-toggle-saturate
     bool m_coverageUnderscore = false;  // main switch: --coverage-underscore
     bool m_coverageUser = false;    // main switch: --coverage-func
+    bool m_cycleMode = false;       // main switch: --cycle-mode
     bool m_debugCheck = false;      // main switch: --debug-check
     bool m_debugCollision = false;  // main switch: --debug-collision
     bool m_debugEmitV = false;      // main switch: --debug-emitv
@@ -252,18 +258,24 @@ private:
     bool m_debugWidth = false;      // main switch: --debug-width
     bool m_decoration = true;       // main switch: --decoration
     bool m_decorationNodes = false;  // main switch: --decoration=nodes
+    bool m_dpiExportHandles = false;  // main switch: --dpi-export-handles
     bool m_dpiHdrOnly = false;      // main switch: --dpi-hdr-only
     bool m_emitAccessors = false;   // main switch: --emit-accessors
     bool m_exe = false;             // main switch: --exe
     bool m_flatten = false;         // main switch: --flatten
     bool m_hierarchical = false;    // main switch: --hierarchical
+    bool m_hierProcess = false;     // main switch: --hierarchical-process
     bool m_ignc = false;            // main switch: --ignc
     bool m_jsonOnly = false;        // main switch: --json-only
+    bool m_jsonOnlyIndex = false;   // main switch: --json-only-index
+    bool m_jsonOnlySplit = false;   // main switch: --json-only-split
     bool m_lintOnly = false;        // main switch: --lint-only
     bool m_gmake = false;           // main switch: --make gmake
     bool m_makeJson = false;        // main switch: --make json
     bool m_main = false;            // main switch: --main
+    bool m_numaLayout = false;      // main switch: --numa-layout
     bool m_outFormatOk = false;     // main switch: --cc, --sc or --sp was specified
+    bool m_packBits = false;        // main switch: --pack-bits
     bool m_pedantic = false;        // main switch: --Wpedantic
     bool m_pinsInoutEnables = false;// main switch: --pins-inout-enables
     bool m_pinsScUint = false;      // main switch: --pins-sc-uint
@@ -275,6 +287,7 @@ private:
     bool m_profCFuncs = false;      // main switch: --prof-cfuncs
     bool m_profExec = false;        // main switch: --prof-exec
     bool m_profPgo = false;         // main switch: --prof-pgo
+    bool m_profPgoBranches = false;  // main switch: --prof-pgo-branches
     bool m_protectIds = false;      // main switch: --protect-ids
     bool m_public = false;          // main switch: --public
     bool m_publicFlatRW = false;    // main switch: --public-flat-rw
@@ -285,15 +298,22 @@ private:
     bool m_relativeIncludes = false;  // main switch: --relative-includes
     bool m_reportUnoptflat = false;  // main switch: --report-unoptflat
     bool m_savable = false;         // main switch: --savable
+    bool m_scClockedEval = false;   // main switch: --sc-clocked-eval
+    bool m_slowSharedLib = false;   // main switch: --slow-shared-lib
     bool m_stdPackage = true;       // main switch: --std-package
     bool m_stdWaiver = true;        // main switch: --std-waiver
     bool m_structsPacked = false;   // main switch: --structs-packed
     bool m_systemC = false;         // main switch: --sc: System C instead of simple C++
     bool m_stats = false;           // main switch: --stats
+    bool m_statsMemory = false;     // main switch: --stats-memory
+    bool m_statsRuntime = false;    // main switch: --stats-runtime
     bool m_statsVars = false;       // main switch: --stats-vars
+    bool m_threadsAdaptive = false;  // main switch: --threads-adaptive
     bool m_threadsCoarsen = true;   // main switch: --threads-coarsen
     bool m_threadsDpiPure = true;   // main switch: --threads-dpi all/pure
     bool m_threadsDpiUnpure = false;  // main switch: --threads-dpi all
+    bool m_threadsDynamic = false;  // main switch: --threads-schedule dynamic
+    bool m_threadsSettle = false;  // main switch: --threads-settle
     VOptionBool m_timing;           // main switch: --timing
     bool m_trace = false;           // main switch: --trace
     bool m_traceCoverage = false;   // main switch: --trace-coverage
@@ -312,6 +332,7 @@ private:
     int         m_coverageExprMax = 32;    // main switch: --coverage-expr-max
     int         m_convergeLimit = 100;  // main switch: --converge-limit
     int         m_coverageMaxWidth = 256; // main switch: --coverage-max-width
+    int         m_debugCheckFull = 0;  // main switch: --debug-check-full
     int         m_expandLimit = 64;  // main switch: --expand-limit
     int         m_gateStmts = 100;    // main switch: --gate-stmts
     int         m_hierChild = 0;      // main switch: --hierarchical-child
@@ -324,6 +345,7 @@ private:
     VOptionBool m_makeDepend;  // main switch: -MMD
     int         m_maxNumWidth = 65536;  // main switch: --max-num-width
     int         m_moduleRecursion = 100;  // main switch: --module-recursion-depth
+    int         m_outputAsmTables = 0;  // main switch: --output-asm-tables
     int         m_outputGroups = -1;  // main switch: --output-groups
     int         m_outputSplit = 20000;  // main switch: --output-split
     int         m_outputSplitCFuncs = -1;  // main switch: --output-split-cfuncs
@@ -333,8 +355,11 @@ private:
     int         m_publicDepth = 0;   // main switch: --public-depth
     int         m_reloopLimit = 40; // main switch: --reloop-limit
     VOptionBool m_skipIdentical;  // main switch: --skip-identical
+    bool        m_skipIdenticalElab = false;  // main switch: --skip-identical-elab
+    int         m_sparseArrayLimit = 256 * 1024 * 1024;  // main switch: --sparse-array-limit
     bool        m_stopFail = true;  // main switch: --stop-fail
     int         m_threads = 1;      // main switch: --threads
+    int         m_threadsCoarsenMin = 20000;  // main switch: --threads-coarsen-min (debug)
     int         m_threadsMaxMTasks = 0;  // main switch: --threads-max-mtasks
     VTimescale  m_timeDefaultPrec;  // main switch: --timescale
     VTimescale  m_timeDefaultUnit;  // main switch: --timescale
@@ -353,10 +378,13 @@ private:
     int         m_compLimitMembers = 64;  // compiler selection; number of members in struct before make anon array
     int         m_compLimitParens = 240;  // compiler selection; number of nested parens
 
+    string      m_astSpillDir;  // main switch: --ast-spill-dir {dir}
     string      m_buildDepBin;  // main switch: --build-dep-bin {filename}
+    string      m_ccPgo;        // main switch: --cc-pgo {command}
     string      m_exeName;      // main switch: -o {name}
     string      m_flags;        // main switch: -f {name}
     string      m_hierParamsFile; // main switch: --hierarchical-params-file
+    string      m_instrCostTable;  // main switch: --instr-cost-table {filename}
     string      m_jsonOnlyOutput;    // main switch: --json-only-output
     string      m_jsonOnlyMetaOutput;    // main switch: --json-only-meta-output
     string      m_l2Name;       // main switch: --l2name; "" for top-module's name
@@ -366,6 +394,7 @@ private:
     string      m_modPrefix;    // main switch: --mod-prefix
     string      m_pipeFilter;   // main switch: --pipe-filter
     string      m_prefix;       // main switch: --prefix
+    string      m_profVerilation;  // main switch: --prof-verilation {filename}
     string      m_protectKey;   // main switch: --protect-key
     string      m_topModule;    // main switch: --top-module
     string      m_unusedRegexp; // main switch: --unused-regexp
@@ -381,18 +410,21 @@ private:
     // MEMBERS (optimizations)
     bool m_fAcycSimp;    // main switch: -fno-acyc-simp: acyclic pre-optimizations
     bool m_fAssemble;    // main switch: -fno-assemble: assign assemble
+    bool m_fAssocHash;   // main switch: -fno-assoc-hash: hash tables for associative arrays
     bool m_fCase;        // main switch: -fno-case: case tree conversion
     bool m_fCombine;     // main switch: -fno-combine: common icode packing
     bool m_fConst;       // main switch: -fno-const: constant folding
     bool m_fConstBeforeDfg = true;  // main switch: -fno-const-before-dfg for testing only!
     bool m_fConstBitOpTree;  // main switch: -fno-const-bit-op-tree constant bit op tree
     bool m_fDedupe;      // main switch: -fno-dedupe: logic deduplication
+    bool m_fDfgBreakCycles = true;  // main switch: -fno-dfg-break-cycles
     bool m_fDfgPeephole = true; // main switch: -fno-dfg-peephole
     bool m_fDfgPreInline;    // main switch: -fno-dfg-pre-inline and -fno-dfg
     bool m_fDfgPostInline;   // main switch: -fno-dfg-post-inline and -fno-dfg
     bool m_fDeadAssigns;     // main switch: -fno-dead-assigns: remove dead assigns
     bool m_fDeadCells;   // main switch: -fno-dead-cells: remove dead cells
     bool m_fExpand;      // main switch: -fno-expand: expansion of C macros
+    bool m_fExpandVector;  // main switch: -fno-expand-vector: keep wide bitwise calls
     bool m_fFuncBalanceCat = true;  // main switch: -fno-func-balance-cat: expansion of C macros
     bool m_fFuncSplitCat = true;  // main switch: -fno-func-split-cat: expansion of C macros
     bool m_fGate;        // main switch: -fno-gate: gate wire elimination
@@ -404,6 +436,9 @@ private:
     bool m_fMergeCond;   // main switch: -fno-merge-cond: merge conditionals
     bool m_fMergeCondMotion = true; // main switch: -fno-merge-cond-motion: perform code motion
     bool m_fMergeConstPool = true;  // main switch: -fno-merge-const-pool
+    bool m_fNbaInPlace;  // main switch: -fno-nba-in-place: NBAs without shadow variables
+    bool m_fPchSyms = true;  // main switch: -fno-pch-syms: model headers in precompiled header
+    bool m_fProfileGuided = true;  // main switch: -fno-profile-guided: use profile_data -cfunc
     bool m_fReloop;      // main switch: -fno-reloop: reform loops
     bool m_fReorder;     // main switch: -fno-reorder: reorder assignments in blocks
     bool m_fSlice = true;  // main switch: -fno-slice: array assignment slicing
@@ -412,6 +447,7 @@ private:
     bool m_fSubstConst;  // main switch: -fno-subst-const: final constant substitution
     bool m_fTable;       // main switch: -fno-table: lookup table creation
     bool m_fTaskifyAll = false;  // main switch: --ftaskify-all-forked
+    bool m_fUdpLogic = true;  // main switch: -fno-udp-logic: UDP tables as logic
     bool m_fVarSplit;    // main switch: -fno-var-split: automatic variable splitting
     // clang-format on
 
@@ -438,6 +474,8 @@ private:
     static bool suffixed(const string& sw, const char* arg);
     static string parseFileArg(const string& optdir, const string& relfilename);
     string filePathCheckOneDir(const string& modname, const string& dirname);
+    string filePathSearch(const string& filename, const string& lastpath);
+    static bool readDirListing(const string& dir, std::set<string>& files) VL_MT_SAFE;
     static int stripOptionsForChildRun(const string& opt, bool forTop);
     void validateIdentifier(FileLine* fl, const string& arg, const string& opt);
 
@@ -480,21 +518,31 @@ public:
     string flags() const { return m_flags; }
     bool systemC() const VL_MT_SAFE { return m_systemC; }
     bool savable() const VL_MT_SAFE { return m_savable; }
+    bool slowSharedLib() const { return m_slowSharedLib; }
+    bool scClockedEval() const { return m_scClockedEval; }
     bool stats() const { return m_stats; }
+    bool statsMemory() const { return m_statsMemory; }
+    bool statsRuntime() const { return m_statsRuntime; }
     bool statsVars() const { return m_statsVars; }
     bool stdPackage() const { return m_stdPackage; }
     bool stdWaiver() const { return m_stdWaiver; }
     bool structsPacked() const { return m_structsPacked; }
     bool assertOn() const { return m_assert; }  // assertOn as __FILE__ may be defined
     bool assertCaseOn() const { return m_assertCase || m_assert; }
+    bool assertGatePast() const { return m_assertGatePast; }
+    bool assertOffload() const { return m_assertOffload; }
     bool autoflush() const { return m_autoflush; }
     bool bboxSys() const { return m_bboxSys; }
     bool bboxUnsup() const { return m_bboxUnsup; }
     bool binary() const { return m_binary; }
     bool build() const { return m_build; }
+    string ccPgo() const { return m_ccPgo; }
+    string astSpillDir() const { return m_astSpillDir; }
     string buildDepBin() const { return m_buildDepBin; }
     void buildDepBin(const string& flag) { m_buildDepBin = flag; }
+    bool buildNinja() const { return m_buildNinja; }
     bool cmake() const { return m_cmake; }
+    bool combSkipUnchanged() const { return m_combSkipUnchanged; }
     bool context() const VL_MT_SAFE { return m_context; }
     bool coverage() const VL_MT_SAFE {
         return m_coverageLine || m_coverageToggle || m_coverageExpr || m_coverageUser;
@@ -502,8 +550,10 @@ public:
     bool coverageExpr() const { return m_coverageExpr; }
     bool coverageLine() const { return m_coverageLine; }
     bool coverageToggle() const { return m_coverageToggle; }
+    bool coverageToggleSaturate() const { return m_coverageToggleSaturate; }
     bool coverageUnderscore() const { return m_coverageUnderscore; }
     bool coverageUser() const { return m_coverageUser; }
+    bool cycleMode() const { return m_cycleMode; }
     bool debugCheck() const VL_MT_SAFE { return m_debugCheck; }
     bool debugCollision() const { return m_debugCollision; }
     bool debugEmitV() const VL_MT_SAFE { return m_debugEmitV; }
@@ -519,6 +569,7 @@ public:
     bool debugWidth() const VL_PURE { return m_debugWidth; }
     bool decoration() const VL_MT_SAFE { return m_decoration; }
     bool decorationNodes() const VL_MT_SAFE { return m_decorationNodes; }
+    bool dpiExportHandles() const { return m_dpiExportHandles; }
     bool dpiHdrOnly() const { return m_dpiHdrOnly; }
     bool dumpDefines() const { return m_dumpLevel.count("defines") && m_dumpLevel.at("defines"); }
     bool dumpTreeDot() const {
@@ -531,7 +582,10 @@ public:
     bool makeJson() const { return m_makeJson; }
     bool threadsDpiPure() const { return m_threadsDpiPure; }
     bool threadsDpiUnpure() const { return m_threadsDpiUnpure; }
+    bool threadsDynamic() const { return m_threadsDynamic; }
+    bool threadsAdaptive() const { return m_threadsAdaptive; }
     bool threadsCoarsen() const { return m_threadsCoarsen; }
+    bool threadsSettle() const { return m_threadsSettle; }
     VOptionBool timing() const { return m_timing; }
     bool trace() const { return m_trace; }
     bool traceCoverage() const { return m_traceCoverage; }
@@ -539,8 +593,12 @@ public:
     bool traceStructs() const { return m_traceStructs; }
     bool traceUnderscore() const { return m_traceUnderscore; }
     bool main() const { return m_main; }
+    bool numaLayout() const { return m_numaLayout; }
     bool outFormatOk() const { return m_outFormatOk; }
+    bool packBits() const { return m_packBits; }
     bool jsonOnly() const { return m_jsonOnly; }
+    bool jsonOnlyIndex() const { return m_jsonOnlyIndex; }
+    bool jsonOnlySplit() const { return m_jsonOnlySplit; }
     bool keepTempFiles() const { return (V3Error::debugDefault() != 0); }
     bool pedantic() const { return m_pedantic; }
     bool pinsInoutEnables() const { return m_pinsInoutEnables; }
@@ -553,7 +611,8 @@ public:
     bool profCFuncs() const { return m_profCFuncs; }
     bool profExec() const { return m_profExec; }
     bool profPgo() const { return m_profPgo; }
-    bool usesProfiler() const { return profExec() || profPgo(); }
+    bool profPgoBranches() const { return m_profPgoBranches; }
+    bool usesProfiler() const { return profExec() || profPgo() || profPgoBranches(); }
     bool protectIds() const VL_MT_SAFE { return m_protectIds; }
     bool allPublic() const { return m_public; }
     bool publicParams() const { return m_publicParams; }
@@ -578,6 +637,7 @@ public:
     int convergeLimit() const { return m_convergeLimit; }
     int coverageExprMax() const { return m_coverageExprMax; }
     int coverageMaxWidth() const { return m_coverageMaxWidth; }
+    int debugCheckFull() const { return m_debugCheckFull; }
     bool dumpTreeAddrids() const VL_MT_SAFE;
     int expandLimit() const { return m_expandLimit; }
     int gateStmts() const { return m_gateStmts; }
@@ -593,12 +653,15 @@ public:
     int outputSplit() const { return m_outputSplit; }
     int outputSplitCFuncs() const { return m_outputSplitCFuncs; }
     int outputSplitCTrace() const { return m_outputSplitCTrace; }
+    int outputAsmTables() const { return m_outputAsmTables; }
     int outputGroups() const { return m_outputGroups; }
     int pinsBv() const VL_MT_SAFE { return m_pinsBv; }
     int reloopLimit() const { return m_reloopLimit; }
     VOptionBool skipIdentical() const { return m_skipIdentical; }
+    bool skipIdenticalElab() const { return m_skipIdenticalElab; }
     bool stopFail() const { return m_stopFail; }
     int threads() const VL_MT_SAFE { return m_threads; }
+    int threadsCoarsenMin() const { return m_threadsCoarsenMin; }
     int threadsMaxMTasks() const { return m_threadsMaxMTasks; }
     bool mtasks() const VL_MT_SAFE { return (m_threads > 1); }
     VTimescale timeDefaultPrec() const { return m_timeDefaultPrec; }
@@ -617,12 +680,18 @@ public:
     int traceThreads() const { return m_traceThreads; }
     bool useTraceOffload() const { return trace() && traceFormat().fst() && traceThreads() > 1; }
     bool useTraceParallel() const {
-        return trace() && traceFormat().vcd() && (threads() > 1 || hierChild() > 1);
+        return trace() && traceFormat().vcd()
+               && (threads() > 1 || hierChild() > 1 || traceThreads() > 1);
     }
     bool useFstWriterThread() const { return traceThreads() && traceFormat().fst(); }
+    // Number of shards VCD trace rendering is split into
+    unsigned traceParallelism() const {
+        return useTraceParallel() ? static_cast<unsigned>(std::max(threads(), traceThreads())) : 1;
+    }
     unsigned vmTraceThreads() const {
-        return useTraceParallel() ? threads() : useTraceOffload() ? 1 : 0;
+        return useTraceParallel() ? traceParallelism() : useTraceOffload() ? 1 : 0;
     }
+    int sparseArrayLimit() const { return m_sparseArrayLimit; }
     int unrollCount() const { return m_unrollCount; }
     int unrollCountAdjusted(const VOptionBool& full, bool generate, bool simulate);
     int unrollStmts() const { return m_unrollStmts; }
@@ -634,6 +703,7 @@ public:
 
     string exeName() const { return m_exeName != "" ? m_exeName : prefix(); }
     string hierParamFile() const { return m_hierParamsFile; }
+    string instrCostTable() const { return m_instrCostTable; }
     string jsonOnlyOutput() const { return m_jsonOnlyOutput; }
     string jsonOnlyMetaOutput() const { return m_jsonOnlyMetaOutput; }
     string l2Name() const { return m_l2Name; }
@@ -652,6 +722,7 @@ public:
     string modPrefix() const VL_MT_SAFE { return m_modPrefix; }
     string pipeFilter() const { return m_pipeFilter; }
     string prefix() const VL_MT_SAFE { return m_prefix; }
+    string profVerilation() const { return m_profVerilation; }
     // Not just called protectKey() to avoid bugs of not using protectKeyDefaulted()
     bool protectKeyProvided() const { return !m_protectKey.empty(); }
     string protectKeyDefaulted() VL_MT_SAFE;  // Set default key if not set by user
@@ -688,12 +759,14 @@ public:
     // ACCESSORS (optimization options)
     bool fAcycSimp() const { return m_fAcycSimp; }
     bool fAssemble() const { return m_fAssemble; }
+    bool fAssocHash() const { return m_fAssocHash; }
     bool fCase() const { return m_fCase; }
     bool fCombine() const { return m_fCombine; }
     bool fConst() const { return m_fConst; }
     bool fConstBeforeDfg() const { return m_fConstBeforeDfg; }
     bool fConstBitOpTree() const { return m_fConstBitOpTree; }
     bool fDedupe() const { return m_fDedupe; }
+    bool fDfgBreakCycles() const { return m_fDfgBreakCycles; }
     bool fDfgPeephole() const { return m_fDfgPeephole; }
     bool fDfgPreInline() const { return m_fDfgPreInline; }
     bool fDfgPostInline() const { return m_fDfgPostInline; }
@@ -703,6 +776,7 @@ public:
     bool fDeadAssigns() const { return m_fDeadAssigns; }
     bool fDeadCells() const { return m_fDeadCells; }
     bool fExpand() const { return m_fExpand; }
+    bool fExpandVector() const { return m_fExpandVector; }
     bool fFuncBalanceCat() const { return m_fFuncBalanceCat; }
     bool fFuncSplitCat() const { return m_fFuncSplitCat; }
     bool fFunc() const { return fFuncSplitCat() || fFuncBalanceCat(); }
@@ -713,8 +787,11 @@ public:
     bool fLifePost() const { return m_fLifePost; }
     bool fLocalize() const { return m_fLocalize; }
     bool fMergeCond() const { return m_fMergeCond; }
+    bool fNbaInPlace() const { return m_fNbaInPlace; }
     bool fMergeCondMotion() const { return m_fMergeCondMotion; }
     bool fMergeConstPool() const { return m_fMergeConstPool; }
+    bool fPchSyms() const { return m_fPchSyms; }
+    bool fProfileGuided() const { return m_fProfileGuided; }
     bool fReloop() const { return m_fReloop; }
     bool fReorder() const { return m_fReorder; }
     bool fSlice() const { return m_fSlice; }
@@ -723,6 +800,7 @@ public:
     bool fSubstConst() const { return m_fSubstConst; }
     bool fTable() const { return m_fTable; }
     bool fTaskifyAll() const { return m_fTaskifyAll; }
+    bool fUdpLogic() const { return m_fUdpLogic; }
     bool fVarSplit() const { return m_fVarSplit; }
 
     string traceClassBase() const VL_MT_SAFE { return m_traceFormat.classBase(); }
@@ -733,6 +811,7 @@ public:
     }
 
     bool hierarchical() const { return m_hierarchical; }
+    bool hierProcess() const { return m_hierProcess; }
     int hierChild() const VL_MT_SAFE { return m_hierChild; }
     bool hierTop() const VL_MT_SAFE { return !m_hierChild && !m_hierBlocks.empty(); }
     const V3HierBlockOptSet& hierBlocks() const { return m_hierBlocks; }
@@ -780,6 +859,7 @@ public:
     string filePath(FileLine* fl, const string& modname, const string& lastpath,
                     const string& errmsg);
     void filePathLookedMsg(FileLine* fl, const string& modname);
+    void prefetchDirs();  // Read search directory listings in parallel
     V3LangCode fileLanguage(const string& filename);
     static bool fileStatNormal(const string& filename);
 
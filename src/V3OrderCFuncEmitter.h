@@ -25,8 +25,10 @@
 #include "verilatedos.h"
 
 #include "V3Ast.h"
+#include "V3Config.h"
 #include "V3Graph.h"
 #include "V3OrderGraph.h"
+#include "V3Stats.h"
 
 #include <limits>
 #include <map>
@@ -37,6 +39,10 @@ class V3OrderCFuncEmitter final {
     const std::string m_tag;
     // True if creating slow functions
     const bool m_slow;
+    // Logic taking at least this fraction of the profiled run time goes into hot functions
+    static constexpr double HOT_FRACTION = 0.01;
+    // Whether to separate logic into hot and cold functions using profile_data -cfunc records
+    const bool m_profCold = v3Global.opt.fProfileGuided() && V3Config::containsCFuncProfileData();
     // Whether to split functions
     const bool m_split = v3Global.opt.outputSplitCFuncs();
     // Size of code emitted so in the current function - for splitting
@@ -55,6 +61,96 @@ class V3OrderCFuncEmitter final {
     std::map<std::pair<AstNodeModule*, std::string>, unsigned> m_funcNums;
     // The result Active blocks that must be invoked to run the code in the order it was emitted
     std::vector<AstActive*> m_activeps;
+    // Whether to skip combinational logic when its variables are unchanged
+    const bool m_guardComb = v3Global.opt.combSkipUnchanged() && !m_slow;
+    // Guarded logic must have at least this many nodes for each variable it compares
+    static constexpr size_t GUARD_NODES_PER_VAR = 8;
+    // Guarded logic may compare at most this many variables
+    static constexpr size_t GUARD_MAX_VARS = 16;
+    // Number of guards created, to ensure unique names
+    size_t m_guardNum = 0;
+    // Statistic tracking
+    VDouble0 m_statColdFuncs;
+    VDouble0 m_statGuardedLogic;
+
+    // Returns the variables referenced by combinational logic, in order of first reference.
+    // Returns empty if the logic cannot be guarded.
+    static std::vector<AstVarScope*> guardVars(AstNode* headp) {
+        std::vector<AstVarScope*> vars;
+        std::map<const AstVarScope*, bool> firstRead;  // Whether first reference is a read
+        bool ok = true;
+        for (AstNode* nodep = headp; nodep && ok; nodep = nodep->nextp()) {
+            nodep->foreach([&](AstNode* np) {
+                if (!ok) return;
+                // The outcome must only depend on the variables referenced
+                if (!np->isPure() || !np->isPredictOptimizable() || VN_IS(np, NodeCCall)
+                    || VN_IS(np, CStmt) || VN_IS(np, CExpr)) {
+                    ok = false;
+                    return;
+                }
+                const AstNodeVarRef* const refp = VN_CAST(np, NodeVarRef);
+                if (!refp) return;
+                AstVarScope* const vscp = refp->varScopep();
+                const auto pair = firstRead.emplace(vscp, refp->access().isReadOrRW());
+                if (pair.second) {
+                    // Must be cheap to compare, and not updated in place
+                    const AstNodeDType* const dtypep = vscp->dtypep()->skipRefp();
+                    if (!dtypep->isIntegralOrPacked() || vscp->varp()->isForceable()
+                        || refp->access().isRW()) {
+                        ok = false;
+                        return;
+                    }
+                    vars.push_back(vscp);
+                } else if (pair.first->second && refp->access().isWriteOrRW()) {
+                    // Read before written, the result depends on the previous run
+                    ok = false;
+                }
+            });
+        }
+        if (!ok || vars.size() > GUARD_MAX_VARS) vars.clear();
+        return vars;
+    }
+
+    // Wrap combinational logic so it only runs when a variable it reads or writes differs
+    // from the value after its last run. As written variables are fully determined by the
+    // read variables, running it again with the same values would not change anything.
+    AstNode* guardLogic(AstNode* headp) {
+        const std::vector<AstVarScope*> vars = guardVars(headp);
+        if (vars.empty()) return headp;
+        size_t nodes = 0;
+        for (AstNode* nodep = headp; nodep; nodep = nodep->nextp()) nodes += nodep->nodeCount();
+        if (nodes < GUARD_NODES_PER_VAR * vars.size()) return headp;
+
+        FileLine* const flp = headp->fileline();
+        // Continuous assignments become procedural under the condition
+        if (AstAssignW* const assignp = VN_CAST(headp, AssignW)) {
+            headp = new AstAssign{flp, assignp->lhsp()->unlinkFrBack(),
+                                  assignp->rhsp()->unlinkFrBack()};
+            VL_DO_DANGLING(assignp->deleteTree(), assignp);
+        }
+        AstScope* const scopep = v3Global.rootp()->topScopep()->scopep();
+        const std::string prefix = "__V" + m_tag + "Chg" + std::to_string(m_guardNum++);
+        ++m_statGuardedLogic;
+        // Variable is zero initialized, so the first run is never skipped
+        AstVarScope* const validp = scopep->createTemp(
+            prefix + "__valid", headp->findBitDType(1, 1, VSigning::UNSIGNED));
+        AstNodeExpr* condp = new AstLogNot{flp, new AstVarRef{flp, validp, VAccess::READ}};
+        AstNode* const postp
+            = new AstAssign{flp, new AstVarRef{flp, validp, VAccess::WRITE},
+                            new AstConst{flp, AstConst::BitTrue{}}};
+        size_t i = 0;
+        for (AstVarScope* const vscp : vars) {
+            AstVarScope* const prevp
+                = scopep->createTempLike(prefix + "__prev" + std::to_string(i++), vscp);
+            condp = new AstLogOr{flp, condp,
+                                 new AstNeq{flp, new AstVarRef{flp, vscp, VAccess::READ},
+                                            new AstVarRef{flp, prevp, VAccess::READ}}};
+            postp->addNext(new AstAssign{flp, new AstVarRef{flp, prevp, VAccess::WRITE},
+                                         new AstVarRef{flp, vscp, VAccess::READ}});
+        }
+        headp->addNext(postp);
+        return new AstIf{flp, condp, headp};
+    }
 
     // Create a unique name for a new function
     std::string cfuncName(FileLine* flp, AstScope* scopep, AstNodeModule* modp,
@@ -72,6 +168,10 @@ public:
     V3OrderCFuncEmitter(const std::string& tag, bool slow)
         : m_tag{tag}
         , m_slow{slow} {}
+    ~V3OrderCFuncEmitter() {
+        V3Stats::addStatSum("Optimizations, Order cold functions", m_statColdFuncs);
+        V3Stats::addStatSum("Optimizations, Order guarded logic", m_statGuardedLogic);
+    }
     VL_UNCOPYABLE(V3OrderCFuncEmitter);
     VL_UNMOVABLE(V3OrderCFuncEmitter);
 
@@ -91,6 +191,14 @@ public:
     void emitLogic(const OrderLogicVertex* lVtxp) {
         // Sensitivity domain of logic we are emitting
         AstSenTree* const domainp = lVtxp->domainp();
+        // Whether the logic is combinational, under an AstActive with combinational sensitivity
+        const bool combo = [&]() {
+            if (lVtxp->hybridp()) return false;
+            const AstNode* nodep = lVtxp->nodep();
+            while (nodep->backp()->nextp() == nodep) nodep = nodep->backp();
+            const AstActive* const activep = VN_CAST(nodep->backp(), Active);
+            return activep && activep->sensesp()->hasCombo();
+        }();
         // We are move the logic into a CFunc, so unlink it from the input AstActive
         AstNode* const logicp = lVtxp->nodep()->unlinkFrBack();
         // If the logic is a procedure, we need to do a few special things
@@ -101,7 +209,6 @@ public:
         const bool needProcess = procp && procp->needProcess();
         // TODO: This is a bit muddy: 'initial forever @(posedge clk) begin ... end' is a fancy
         //       way of saying always @(posedge clk), so it might be quite hot...
-        //       Also, if m_funcp is slow, but this one isn't we should force a new function
         const bool slow = m_slow && !(suspendable && VN_IS(procp, Always));
 
         // Put suspendable processes into individual functions on their own
@@ -113,7 +220,7 @@ public:
 
         // Process procedures per statement, so we can split CFuncs within procedures.
         // Everything else is handled as a unit.
-        AstNode* const headp = [&]() -> AstNode* {
+        AstNode* headp = [&]() -> AstNode* {
             if (!procp) return logicp;  // Not a procedure, handle as a unit
             AstNode* const stmtsp = procp->stmtsp();
             UASSERT_OBJ(stmtsp, procp, "Empty process should have been deleted earlier");
@@ -122,6 +229,21 @@ public:
             VL_DO_DANGLING(procp->deleteTree(), procp);
             return stmtsp;
         }();
+        // Fast logic never seen running when profiled goes into a cold function. With
+        // --prof-cfuncs the function was named after the first statement, so look that up.
+        const double fraction
+            = m_profCold && !slow
+                  ? V3Config::getProfileCFuncFraction(headp->fileline()->profileFuncname())
+                  : -1.0;
+        const bool cold = fraction == 0.0;
+        const bool hot = fraction >= HOT_FRACTION;
+        // Skip combinational logic if unchanged, this makes it a single statement
+        if (m_guardComb && combo && !suspendable && !needProcess) headp = guardLogic(headp);
+        // Keep hot and cold logic in separate functions
+        if (m_funcp
+            && (m_funcp->slow() != slow || m_funcp->cold() != cold || m_funcp->hot() != hot)) {
+            forceNewFunction();
+        }
         // Process each statement in the list starting at headp
         for (AstNode *currp = headp, *nextp; currp; currp = nextp) {
             nextp = currp->nextp();
@@ -141,6 +263,9 @@ public:
                 m_funcp->isStatic(false);
                 m_funcp->isLoose(true);
                 m_funcp->slow(slow);
+                m_funcp->cold(cold);
+                m_funcp->hot(hot);
+                if (cold) ++m_statColdFuncs;
                 scopep->addBlocksp(m_funcp);
                 // Create call to the new functino
                 AstCCall* const callp = new AstCCall{flp, m_funcp};
@@ -132,6 +132,34 @@ constexpr unsigned PART_SIBLING_EDGE_LIMIT = 26;
 //  (# of threads * PART_DEFAULT_MAX_MTASKS_PER_THREAD)
 constexpr unsigned PART_DEFAULT_MAX_MTASKS_PER_THREAD = 50;
 
+//   PART_SHARED_LINE_COST (integer)
+//
+// Estimated cost, in V3InstrCount units, of each cache line of variables
+// that two sibling mtasks both access, and at least one of them writes.
+// If the siblings run on different threads these lines bounce between
+// the cores' caches, so a sibling merge is discounted by this cost per
+// shared line, making the partitioner prefer to keep such mtasks on one
+// thread. The discount is capped at a quarter of the pair's own cost, so
+// it can only tip the choice between merges of similar critical path.
+//
+// Set to 0 to partition on critical path alone.
+constexpr uint32_t PART_SHARED_LINE_COST = 20;
+
+//   PART_COARSEN_COST_DIVISOR (integer)
+//
+// On graphs with more mtasks than --threads-coarsen-min, a multilevel
+// coarsening pass first merges chains of small mtasks, so the Contraction
+// below starts on a much smaller graph. The pass never merges two mtasks
+// whose combined cost exceeds the critical path limit divided by this
+// value, so it only performs merges the Contraction would have made anyway.
+constexpr uint32_t PART_COARSEN_COST_DIVISOR = 32;
+
+//   PART_COARSEN_MIN_SHRINK (integer)
+//
+// Stop coarsening when a level merges fewer than 1/N of the mtasks, as
+// further levels would spend more time than they save.
+constexpr size_t PART_COARSEN_MIN_SHRINK = 20;
+
 //   end tunables.
 
 //######################################################################
@@ -237,6 +265,9 @@ static_assert(sizeof(MergeCandidate) == sizeof(MergeCandidateScoreboard::Node),
 class SiblingMC final : public MergeCandidate {
     LogicMTask* const m_ap;
     LogicMTask* const m_bp;
+    // Score discount for data shared by m_ap and m_bp. Constant, as merging
+    // either of them deletes this SiblingMC.
+    const uint32_t m_sharingDiscount;
 
     V3ListLinks<SiblingMC> m_aLinks;  // List links to store instances of this class
     V3ListLinks<SiblingMC> m_bLinks;  // List links to store instances of this class
@@ -259,6 +290,7 @@ public:
 
     LogicMTask* ap() const { return m_ap; }
     LogicMTask* bp() const { return m_bp; }
+    uint32_t sharingDiscount() const { return m_sharingDiscount; }
     bool mergeWouldCreateCycle() const;
 };
 
@@ -317,6 +349,12 @@ public:
             return ap->id() < bp->id();
         }
     };
+    // A variable accessed by the mtask
+    struct FootprintVar final {
+        const AstVarScope* m_vscp;  // The variable
+        uint32_t m_lines;  // Cache lines it occupies
+        bool m_written;  // Written by the mtask
+    };
 
 private:
     // MEMBERS
@@ -329,6 +367,9 @@ private:
     // In abstract time units.
     uint32_t m_cost = 0;
 
+    // Variables accessed by this LogicMTask, sorted by m_vscp
+    std::vector<FootprintVar> m_footprint;
+
     // Cost of critical paths going FORWARD from graph-start to the start
     // of this vertex, and also going REVERSE from the end of the graph to
     // the end of the vertex. Same units as m_cost.
@@ -366,10 +407,46 @@ public:
             m_mVertices.linkBack(mVtxp);
             if (const OrderLogicVertex* const olvp = mVtxp->logicp()) {
                 m_cost += V3InstrCount::count(olvp->nodep(), true);
+                if (PART_SHARED_LINE_COST) initFootprint(olvp->nodep());
             }
         }
     }
 
+private:
+    void initFootprint(AstNode* nodep) {
+        std::map<const AstVarScope*, bool> written;
+        nodep->foreach([&](const AstVarRef* refp) {
+            if (refp->varScopep()) written[refp->varScopep()] |= refp->access().isWriteOrRW();
+        });
+        m_footprint.reserve(written.size());
+        for (const auto& pair : written) {
+            const int bytes = std::max(1, pair.first->dtypep()->widthTotalBytes());
+            const uint32_t lines = (bytes + VL_CACHE_LINE_BYTES - 1) / VL_CACHE_LINE_BYTES;
+            m_footprint.push_back({pair.first, lines, pair.second});
+        }
+    }
+    void mergeFootprintFrom(const LogicMTask* otherp) {
+        if (otherp->m_footprint.empty()) return;
+        std::vector<FootprintVar> merged;
+        merged.reserve(m_footprint.size() + otherp->m_footprint.size());
+        auto ait = m_footprint.cbegin();
+        auto bit = otherp->m_footprint.cbegin();
+        while (ait != m_footprint.cend() || bit != otherp->m_footprint.cend()) {
+            if (bit == otherp->m_footprint.cend()
+                || (ait != m_footprint.cend() && ait->m_vscp < bit->m_vscp)) {
+                merged.push_back(*ait++);
+            } else if (ait == m_footprint.cend() || bit->m_vscp < ait->m_vscp) {
+                merged.push_back(*bit++);
+            } else {
+                merged.push_back(*ait++);
+                merged.back().m_written |= (bit++)->m_written;
+            }
+        }
+        m_footprint.swap(merged);
+    }
+
+public:
+
     // METHODS
     std::set<LogicMTask*>& siblings() { return m_siblings; };
     SiblingMC::AList& aSiblingMCs() { return m_aSiblingMCs; };
@@ -380,6 +457,25 @@ public:
     void moveAllVerticesFrom(LogicMTask* otherp) {
         m_mVertices.splice(m_mVertices.end(), otherp->vertexList());
         m_cost += otherp->m_cost;
+        mergeFootprintFrom(otherp);
+    }
+    // Cache lines accessed by both mtasks, and written by at least one of them
+    static uint32_t sharedLines(const LogicMTask* ap, const LogicMTask* bp) {
+        uint32_t lines = 0;
+        auto ait = ap->m_footprint.cbegin();
+        auto bit = bp->m_footprint.cbegin();
+        while (ait != ap->m_footprint.cend() && bit != bp->m_footprint.cend()) {
+            if (ait->m_vscp < bit->m_vscp) {
+                ++ait;
+            } else if (bit->m_vscp < ait->m_vscp) {
+                ++bit;
+            } else {
+                if (ait->m_written || bit->m_written) lines += ait->m_lines;
+                ++ait;
+                ++bit;
+            }
+        }
+        return lines;
     }
     static uint64_t incGeneration() {
         static uint64_t s_generation = 0;
@@ -631,7 +727,15 @@ static uint32_t siblingScore(const SiblingMC* sibsp) {
         = std::max(ap->critPathCost(GraphWay::FORWARD), bp->critPathCost(GraphWay::FORWARD));
     const uint32_t mergedCpCostRev
         = std::max(ap->critPathCost(GraphWay::REVERSE), bp->critPathCost(GraphWay::REVERSE));
-    return mergedCpCostRev + mergedCpCostFwd + LogicMTask::stepCost(ap->cost() + bp->cost());
+    return mergedCpCostRev + mergedCpCostFwd + LogicMTask::stepCost(ap->cost() + bp->cost())
+           - sibsp->sharingDiscount();
+}
+
+static uint32_t siblingSharingDiscount(const LogicMTask* ap, const LogicMTask* bp) {
+    // Less than the stepped merged cost in siblingScore, so the score stays positive
+    const uint64_t discount
+        = static_cast<uint64_t>(LogicMTask::sharedLines(ap, bp)) * PART_SHARED_LINE_COST;
+    return std::min<uint64_t>(discount, (static_cast<uint64_t>(ap->cost()) + bp->cost()) / 4);
 }
 
 static uint32_t edgeScore(const MTaskEdge* edgep) {
@@ -661,7 +765,8 @@ void MergeCandidate::rescore() {
 SiblingMC::SiblingMC(LogicMTask* ap, LogicMTask* bp)
     : MergeCandidate{/* isSiblingMC: */ true}
     , m_ap{ap}
-    , m_bp{bp} {
+    , m_bp{bp}
+    , m_sharingDiscount{siblingSharingDiscount(ap, bp)} {
     // Storage management depends on this
     UASSERT(ap->id() > bp->id(), "Should be ordered");
     UDEBUGONLY(UASSERT(ap->siblings().count(bp), "Should be in sibling map"););
@@ -1124,6 +1229,7 @@ class Contraction final {
     uint32_t m_scoreLimit;  // Sloppy score allowed when picking merges
     uint32_t m_scoreLimitBeforeRescore = 0xffffffff;  // Next score rescore at
     unsigned m_mergesSinceRescore = 0;  // Merges since last rescore
+    VDouble0 m_statSharingMerges;  // Statistic tracking sibling merges with shared data
     const bool m_slowAsserts;  // Take extra time to validate algorithm
     MergeCandidateScoreboard m_sb;  // Scoreboard
 
@@ -1277,7 +1383,10 @@ public:
                 continue;
             }
 
-            partCheckCachedScoreVsActual(cachedScore, actualScore);
+            // The check is on the critical path, so without any constant sharing discount
+            const SiblingMC* const sibp = mergeCanp->toSiblingMC();
+            const uint32_t discount = sibp ? sibp->sharingDiscount() : 0;
+            partCheckCachedScoreVsActual(cachedScore + discount, actualScore + discount);
 
             // Finally there's no cycle risk, no need to rescore, we're
             // within m_scoreLimit and m_scoreLimitBeforeRescore.
@@ -1304,6 +1413,8 @@ public:
             contract(mergeCanp);
         }
 
+        V3Stats::addStatSum("MTask graph, sibling merges sharing data", m_statSharingMerges);
+
         // Free remaining SiblingMCs
         while (MergeCandidate* const mergeCanp = m_sb.best()) {
             m_sb.remove(mergeCanp);
@@ -1425,6 +1536,7 @@ private:
             VL_DO_DANGLING(mergeEdgep->unlinkDelete(), mergeEdgep);
         } else {
             // Remove the siblingMC
+            if (mergeSibsp->sharingDiscount()) ++m_statSharingMerges;
             mergeSibsp->unlinkA();
             mergeSibsp->unlinkB();
             VL_DO_DANGLING(delete mergeSibsp, mergeSibsp);
@@ -1699,28 +1811,45 @@ public:
 // DpiImportCallVisitor
 
 // Scan node, indicate whether it contains a call to a DPI imported
-// routine.
+// routine that must be serialized, either with all other such calls, or
+// with only those from the same DPI context scope (dpi_threads_context).
 class DpiImportCallVisitor final : public VNVisitor {
     bool m_hasDpiHazard = false;  // Found a DPI import call.
     bool m_tracingCall = false;  // Iterating into a CCall to a CFunc
+    std::set<std::string> m_dpiScopes;  // DPI context scopes of dpi_threads_context calls
     // METHODS
-    void visit(AstCFunc* nodep) override {
-        if (!m_tracingCall) return;
-        m_tracingCall = false;
-        if (nodep->dpiImportWrapper()) {
-            if (nodep->dpiPure() ? !v3Global.opt.threadsDpiPure()
+    void dpiImportCall(const AstNodeCCall* callp, const AstCFunc* funcp) {
+        // If hierarchical DPI wrapper cost is found, this is a call to a
+        // hierarchical block, not a normal DPI which induces DPI hazard.
+        if (V3Config::getProfileData(funcp->cname()) != 0) return;
+        switch (funcp->dpiThreads()) {
+        case VDpiThreads::SAFE: break;
+        case VDpiThreads::SERIAL: m_hasDpiHazard = true; break;
+        case VDpiThreads::CONTEXT:
+            // First argument of a context import is its scope
+            if (const AstScopeName* const snp = VN_CAST(callp->argsp(), ScopeName)) {
+                m_dpiScopes.emplace(snp->scopeSymName());
+            } else {
+                m_hasDpiHazard = true;
+            }
+            break;
+        default:
+            if (funcp->dpiPure() ? !v3Global.opt.threadsDpiPure()
                                  : !v3Global.opt.threadsDpiUnpure()) {
-                // If hierarchical DPI wrapper cost is not found or is of a 0 cost,
-                // we have a normal DPI which induces DPI hazard by default.
-                m_hasDpiHazard = V3Config::getProfileData(nodep->cname()) == 0;
-                UINFO(9, "DPI wrapper '" << nodep->cname()
-                                         << "' has dpi hazard = " << m_hasDpiHazard << endl);
+                m_hasDpiHazard = true;
             }
         }
+        UINFO(9, "DPI wrapper '" << funcp->cname() << "' " << funcp->dpiThreads()
+                                 << " has dpi hazard = " << m_hasDpiHazard << endl);
+    }
+    void visit(AstCFunc* nodep) override {
+        if (!m_tracingCall) return;
+        m_tracingCall = false;
         iterateChildren(nodep);
     }
     void visit(AstNodeCCall* nodep) override {
         iterateChildren(nodep);
+        if (nodep->funcp()->dpiImportWrapper()) dpiImportCall(nodep, nodep->funcp());
         // Enter the function and trace it
         m_tracingCall = true;
         iterate(nodep->funcp());
@@ -1731,6 +1860,7 @@ public:
     // CONSTRUCTORS
     explicit DpiImportCallVisitor(AstNode* nodep) { iterate(nodep); }
     bool hasDpiHazard() const { return m_hasDpiHazard; }
+    const std::set<std::string>& dpiScopes() const { return m_dpiScopes; }
     ~DpiImportCallVisitor() override = default;
 
 private:
@@ -1968,15 +2098,35 @@ class FixDataHazards final {
         }
 
         // Handle nodes containing DPI calls, we want to serialize those
-        // by default unless user gave '--threads-dpi none'.
-        // Same basic strategy as above to serialize access to SC vars.
-        if (!v3Global.opt.threadsDpiPure() || !v3Global.opt.threadsDpiUnpure()) {
-            TasksByRank tasksByRank;
-            for (V3GraphVertex& vtx : m_mTaskGraph.vertices()) {
-                LogicMTask& mtask = static_cast<LogicMTask&>(vtx);
-                if (hasDpiHazard(&mtask)) tasksByRank[mtask.rank()].insert(&mtask);
+        // by default unless user gave '--threads-dpi all', or annotated the
+        // imported functions. Same basic strategy as above to serialize
+        // access to SC vars, but calls annotated dpi_threads_context are
+        // only serialized with calls from the same DPI context scope.
+        {
+            std::vector<const OrderLogicVertex*> serialLogic;
+            std::map<std::string, std::vector<const OrderLogicVertex*>> scopeLogic;
+            for (const V3GraphVertex& vtx : m_mTaskGraph.vertices()) {
+                const LogicMTask& mtask = static_cast<const LogicMTask&>(vtx);
+                for (const OrderMoveVertex& mVtx : mtask.vertexList()) {
+                    const OrderLogicVertex* const lvtxp = mVtx.logicp();
+                    if (!lvtxp) continue;
+                    // NOTE: We don't handle DPI exports. If testbench code calls a
+                    // DPI-exported function at any time during eval() we may have
+                    // a data hazard. (Likewise in non-threaded mode if an export
+                    // messes with an ordered variable we're broken.)
+
+                    // Find all calls to DPI-imported functions, we can put those
+                    // into a serial order at least. That should solve the most
+                    // likely DPI-related data hazards.
+                    const DpiImportCallVisitor visitor{lvtxp->nodep()};
+                    if (visitor.hasDpiHazard()) serialLogic.push_back(lvtxp);
+                    for (const std::string& scope : visitor.dpiScopes()) {
+                        scopeLogic[scope].push_back(lvtxp);
+                    }
+                }
             }
-            mergeSameRankTasks(tasksByRank);
+            mergeLogicTasks(serialLogic);
+            for (const auto& pair : scopeLogic) mergeLogicTasks(pair.second);
         }
     }
 
@@ -2025,21 +2175,14 @@ class FixDataHazards final {
             lastRecipientp = recipientp;
         }
     }
-    bool hasDpiHazard(LogicMTask* mtaskp) {
-        for (const OrderMoveVertex& mVtx : mtaskp->vertexList()) {
-            if (OrderLogicVertex* const lvtxp = mVtx.logicp()) {
-                // NOTE: We don't handle DPI exports. If testbench code calls a
-                // DPI-exported function at any time during eval() we may have
-                // a data hazard. (Likewise in non-threaded mode if an export
-                // messes with an ordered variable we're broken.)
-
-                // Find all calls to DPI-imported functions, we can put those
-                // into a serial order at least. That should solve the most
-                // likely DPI-related data hazards.
-                if (DpiImportCallVisitor{lvtxp->nodep()}.hasDpiHazard()) return true;
-            }
+    // Serialize the mtasks containing the given logic, as they currently are
+    void mergeLogicTasks(const std::vector<const OrderLogicVertex*>& logicps) {
+        TasksByRank tasksByRank;
+        for (const OrderLogicVertex* const lvtxp : logicps) {
+            LogicMTask* const mtaskp = static_cast<LogicMTask*>(lvtxp->userp());
+            tasksByRank[mtaskp->rank()].insert(mtaskp);
         }
-        return false;
+        mergeSameRankTasks(tasksByRank);
     }
 
     VL_UNCOPYABLE(FixDataHazards);
@@ -2050,6 +2193,117 @@ public:
     }
 };
 
+//######################################################################
+// Coarsening - Multilevel pre-pass shrinking huge graphs before Contraction
+
+class Coarsening final {
+    // NODE STATE
+    //   LogicMTask::user()  -> bool. Matched in current level
+
+    // MEMBERS
+    V3Graph& m_mTaskGraph;  // The Mtask graph
+    const LogicMTask* const m_entryMTaskp;  // Singular source vertex of the dependency graph
+    const LogicMTask* const m_exitMTaskp;  // Singular sink vertex of the dependency graph
+    const uint32_t m_costLimit;  // Maximum cost of a merged mtask
+    VDouble0 m_statMerges;  // Statistic tracking
+
+    // CONSTRUCTORS
+    Coarsening(V3Graph& mTaskGraph, const LogicMTask* entryMTaskp, const LogicMTask* exitMTaskp,
+               uint32_t costLimit)
+        : m_mTaskGraph{mTaskGraph}
+        , m_entryMTaskp{entryMTaskp}
+        , m_exitMTaskp{exitMTaskp}
+        , m_costLimit{costLimit} {
+        size_t mtaskCount = m_mTaskGraph.vertices().size();
+        while (mtaskCount > static_cast<size_t>(v3Global.opt.threadsCoarsenMin())) {
+            const size_t merges = coarsenLevel();
+            UINFO(4, "Coarsening level merged " << merges << " of " << mtaskCount << " mtasks\n");
+            mtaskCount -= merges;
+            if (merges * PART_COARSEN_MIN_SHRINK < mtaskCount) break;
+        }
+        V3Stats::addStatSum("MTask graph, coarsening merges", m_statMerges);
+    }
+    ~Coarsening() = default;
+
+    // METHODS
+    bool isCandidate(const MTaskEdge* edgep) const {
+        const LogicMTask* const fromp = edgep->fromMTaskp();
+        const LogicMTask* const top = edgep->toMTaskp();
+        if (fromp == m_entryMTaskp || top == m_exitMTaskp) return false;
+        if (fromp->user() || top->user()) return false;
+        if (static_cast<uint64_t>(fromp->cost()) + top->cost() > m_costLimit) return false;
+        // If 'fromp' has no other dependent, or 'top' has no other prerequisite,
+        // there is no other path between them, so the merge cannot create a cycle.
+        return fromp->outSize1() || top->inSize1();
+    }
+
+    // Heavy-edge matching: pick the candidate edge with the most shared data,
+    // then the lowest merged cost
+    MTaskEdge* bestEdge(LogicMTask* mtaskp) const {
+        MTaskEdge* bestp = nullptr;
+        uint32_t bestShared = 0;
+        uint32_t bestCost = 0;
+        const auto consider = [&](V3GraphEdge& edge) {
+            MTaskEdge* const edgep = edge.as<MTaskEdge>();
+            if (!isCandidate(edgep)) return;
+            const uint32_t shared
+                = LogicMTask::sharedLines(edgep->fromMTaskp(), edgep->toMTaskp());
+            const uint32_t cost = edgep->fromMTaskp()->cost() + edgep->toMTaskp()->cost();
+            if (!bestp || shared > bestShared || (shared == bestShared && cost < bestCost)) {
+                bestp = edgep;
+                bestShared = shared;
+                bestCost = cost;
+            }
+        };
+        for (V3GraphEdge& edge : mtaskp->outEdges()) consider(edge);
+        for (V3GraphEdge& edge : mtaskp->inEdges()) consider(edge);
+        return bestp;
+    }
+
+    size_t coarsenLevel() {
+        // Match pairs of mtasks, each mtask in at most one pair
+        m_mTaskGraph.userClearVertices();
+        std::vector<MTaskEdge*> matches;
+        for (V3GraphVertex& vtx : m_mTaskGraph.vertices()) {
+            if (vtx.user()) continue;
+            if (MTaskEdge* const edgep = bestEdge(vtx.as<LogicMTask>())) {
+                edgep->fromp()->user(1);
+                edgep->top()->user(1);
+                matches.push_back(edgep);
+            }
+        }
+        // Contract the matched pairs. They are disjoint, and contracting one
+        // can only remove edges from others, so they remain cycle free.
+        for (MTaskEdge* const edgep : matches) {
+            LogicMTask* const fromp = edgep->fromMTaskp();
+            LogicMTask* const top = edgep->toMTaskp();
+            UASSERT_OBJ(fromp->outSize1() || top->inSize1(), fromp, "Merge would create cycle");
+            fromp->removeRelativeMTask(top);
+            fromp->removeRelativeEdge<GraphWay::FORWARD>(edgep);
+            top->removeRelativeEdge<GraphWay::REVERSE>(edgep);
+            VL_DO_DANGLING(edgep->unlinkDelete(), edgep);
+            // As in Contraction, merge the smaller mtask into the larger
+            LogicMTask* const recipientp = fromp->cost() > top->cost() ? fromp : top;
+            LogicMTask* const donorp = recipientp == fromp ? top : fromp;
+            recipientp->moveAllVerticesFrom(donorp);
+            partRedirectEdgesFrom(m_mTaskGraph, recipientp, donorp, nullptr);
+            ++m_statMerges;
+        }
+        return matches.size();
+    }
+
+    VL_UNCOPYABLE(Coarsening);
+
+public:
+    // Returns true if any mtasks were merged
+    static bool apply(V3Graph& mTaskGraph, const LogicMTask* entryMTaskp,
+                      const LogicMTask* exitMTaskp, uint32_t cpLimit) {
+        const size_t before = mTaskGraph.vertices().size();
+        Coarsening{mTaskGraph, entryMTaskp, exitMTaskp, cpLimit / PART_COARSEN_COST_DIVISOR};
+        return mTaskGraph.vertices().size() != before;
+    }
+};
+
 //######################################################################
 // Partitioner implementation
 
@@ -2297,6 +2551,26 @@ class Partitioner final {
         debugMTaskGraphStats(*m_mTaskGraphp, "hazards");
         hashGraphDebug(*m_mTaskGraphp, "mTaskGraphpp after fixDataHazards()");
 
+        // Set cpLimit to roughly totalGraphCost / nThreads
+        //
+        // Actually set it a bit lower, by a hardcoded fudge factor. This
+        // results in more smaller mTaskGraphp, which helps reduce fragmentation
+        // when scheduling them.
+        const unsigned fudgeNumerator = 3;
+        const unsigned fudgeDenominator = 5;
+        const uint32_t cpLimit = ((totalGraphCost * fudgeNumerator)
+                                  / (std::max(v3Global.opt.threads(), 1) * fudgeDenominator));
+
+        // On huge graphs, first shrink the graph with cheap chain merges, so
+        // the critical path setup and Contraction below work on fewer mtasks.
+        if (v3Global.opt.threadsCoarsen()
+            && Coarsening::apply(*m_mTaskGraphp, m_entryMTaskp, m_exitMTaskp, cpLimit)) {
+            // Merges may have left ranks out of order
+            m_mTaskGraphp->rank();
+            debugMTaskGraphStats(*m_mTaskGraphp, "coarsening");
+            hashGraphDebug(*m_mTaskGraphp, "mTaskGraphpp after coarsening");
+        }
+
         // Setup the critical path into and out of each node.
         partInitCriticalPaths(*m_mTaskGraphp);
         hashGraphDebug(*m_mTaskGraphp, "after partInitCriticalPaths()");
@@ -2321,18 +2595,8 @@ class Partitioner final {
         // Some tests disable this, hence the test on threadsCoarsen().
         // Coarsening is always enabled in production.
         if (v3Global.opt.threadsCoarsen()) {
-            const int targetParFactor = v3Global.opt.threads();
-            UASSERT(targetParFactor >= 2, "Should not reach Partitioner when --threads <= 1");
-
-            // Set cpLimit to roughly totalGraphCost / nThreads
-            //
-            // Actually set it a bit lower, by a hardcoded fudge factor. This
-            // results in more smaller mTaskGraphp, which helps reduce fragmentation
-            // when scheduling them.
-            const unsigned fudgeNumerator = 3;
-            const unsigned fudgeDenominator = 5;
-            const uint32_t cpLimit
-                = ((totalGraphCost * fudgeNumerator) / (targetParFactor * fudgeDenominator));
+            UASSERT(v3Global.opt.threads() >= 2,
+                    "Should not reach Partitioner when --threads <= 1");
             UINFO(4, "Partitioner set cpLimit = " << cpLimit << endl);
 
             Contraction::apply(*m_mTaskGraphp, cpLimit, m_entryMTaskp, m_exitMTaskp,
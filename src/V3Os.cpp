@@ -74,6 +74,7 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 #  endif
 # endif
 #else
+# include <sys/resource.h>  // getrusage
 # include <sys/time.h>
 # include <sys/wait.h>  // Needed on FreeBSD for WIFEXITED
 # include <unistd.h>  // usleep
@@ -458,6 +459,23 @@ uint64_t V3Os::timeUsecs() {
 #endif
 }
 
+uint64_t V3Os::memPeakBytes() {
+#if defined(_WIN32) || defined(__MINGW32__)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return pmc.PeakWorkingSetSize;
+#else
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) < 0) return 0;
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);  // In bytes
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // In kilobytes
+#endif
+#endif
+}
+
 void V3Os::u_sleep(int64_t usec) {
 #if defined(_WIN32) || defined(__MINGW32__)
     std::this_thread::sleep_for(std::chrono::microseconds(usec));
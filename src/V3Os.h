@@ -79,6 +79,8 @@ public:
     static void u_sleep(int64_t usec);  ///< Sleep for a given number of microseconds.
     /// Return wall time since epoch in microseconds, or 0 if not implemented
     static uint64_t timeUsecs();
+    /// Return peak resident memory of the process in bytes, or 0 if not implemented
+    static uint64_t memPeakBytes();
 
     // METHODS (sub command)
     /// Run system command, returns the exit code of the child process.
@@ -55,6 +55,7 @@
 #include "V3Hasher.h"
 #include "V3Os.h"
 #include "V3Parse.h"
+#include "V3Simulate.h"
 #include "V3Unroll.h"
 #include "V3Width.h"
 
@@ -257,6 +258,8 @@ class ParamProcessor final {
             : m_modp{modp} {}
     };
     std::map<const std::string, ModInfo> m_modNameMap;  // Hash of created module flavors by name
+    // Last specialization inserted after each module, where to continue the insertion search
+    std::unordered_map<const AstNodeModule*, AstNodeModule*> m_lastClonep;
 
     std::map<const std::string, std::string>
         m_longMap;  // Hash of very long names to unique identity number
@@ -636,11 +639,16 @@ class ParamProcessor final {
         // know up front how recursive modules are expanded, and a later expansion might re-use an
         // earlier expansion (see t_recursive_module_bug_2).
         AstNode* insertp = srcModp;
+        // Modules up to the previous specialization are at no higher level than it, so start
+        // there, rather than walking over every earlier specialization again
+        AstNodeModule*& lastClonepr = m_lastClonep[srcModp];
+        if (lastClonepr && lastClonepr->level() <= newModp->level()) insertp = lastClonepr;
         while (VN_IS(insertp->nextp(), NodeModule)
                && VN_AS(insertp->nextp(), NodeModule)->level() <= newModp->level()) {
             insertp = insertp->nextp();
         }
         insertp->addNextHere(newModp);
+        lastClonepr = newModp;
 
         m_modNameMap.emplace(newModp->name(), ModInfo{newModp});
         const auto iter = m_modNameMap.find(newname);
@@ -1539,6 +1547,10 @@ public:
 
 void V3Param::param(AstNetlist* rootp) {
     UINFO(2, __FUNCTION__ << ": " << endl);
-    { ParamVisitor{rootp}; }  // Destruct before checking
+    {
+        // Share constant function results between specializations
+        const SimulateFuncCache funcCache;
+        ParamVisitor{rootp};
+    }  // Destruct before checking
     V3Global::dumpCheckGlobalTree("param", 0, dumpTreeEitherLevel() >= 3);
 }
@@ -264,17 +264,16 @@ size_t V3ParseImp::ppInputToLex(char* buf, size_t max_size) {
     size_t got = 0;
     while (got < max_size  // Haven't got enough
            && !m_ppBuffers.empty()) {  // And something buffered
-        string front = m_ppBuffers.front();
-        m_ppBuffers.pop_front();
-        size_t len = front.length();
-        if (len > (max_size - got)) {  // Front string too big
-            const string remainder = front.substr(max_size - got);
-            front = front.substr(0, max_size - got);
-            m_ppBuffers.push_front(remainder);  // Put back remainder for next time
-            len = (max_size - got);
-        }
-        std::memcpy(buf + got, front.c_str(), len);
+        // Copy what fits, remembering how far we got, so large buffers are not copied again
+        const string& front = m_ppBuffers.front();
+        const size_t len = std::min(front.length() - m_ppFrontOffset, max_size - got);
+        std::memcpy(buf + got, front.data() + m_ppFrontOffset, len);
         got += len;
+        m_ppFrontOffset += len;
+        if (m_ppFrontOffset >= front.length()) {
+            m_ppBuffers.pop_front();
+            m_ppFrontOffset = 0;
+        }
     }
     if (debug() >= 9) {
         const string out = std::string{buf, got};
@@ -360,6 +359,7 @@ void V3ParseImp::parseFile(FileLine* fileline, const string& modfilename, bool i
         lexFile(modfilename);
     } else {
         m_ppBuffers.clear();
+        m_ppFrontOffset = 0;
     }
 }
 
@@ -125,6 +125,7 @@ struct V3ParseBisonYYSType final {
         VAttrType::en attrtypeen;
         VAssertType::en asserttypeen;
         VAssertDirectiveType::en assertdirectivetypeen;
+        VDpiThreads::en dpithreads;
         VLifetime::en lifetime;
         VStrength::en strength;
 
@@ -163,6 +164,7 @@ class V3ParseImp final {
     std::deque<V3Number*> m_numberps;  // Created numbers for later cleanup
     std::deque<FileLine> m_lexLintState;  // Current lint state for save/restore
     std::deque<string> m_ppBuffers;  // Preprocessor->lex buffer of characters to process
+    size_t m_ppFrontOffset = 0;  // Characters of m_ppBuffers.front() already processed
     size_t m_ppBytes = 0;  // Preprocessor->lex bytes transferred
 
     AstNode* m_tagNodep = nullptr;  // Points to the node to set to m_tag or nullptr to not set.
@@ -133,6 +133,7 @@ public:
     FileLine* m_curFilelinep;  // Current processing point (see also m_tokFilelinep)
     V3PreLex* const m_lexp;  // Lexer, for resource tracking
     std::deque<string> m_buffers;  // Buffer of characters to process
+    size_t m_frontOffset = 0;  // Characters of m_buffers.front() already processed
     int m_ignNewlines = 0;  // Ignore multiline newlines
     int m_termState = 0;  // Termination fsm
     bool m_eof = false;  // "EOF" buffer
@@ -143,6 +144,14 @@ public:
         lexStreamDepthAdd(1);
     }
     ~VPreStream() { lexStreamDepthAdd(-1); }
+    // Add characters to process before the remaining characters
+    void pushFront(string&& str) {
+        if (m_frontOffset) {
+            m_buffers.front().erase(0, m_frontOffset);
+            m_frontOffset = 0;
+        }
+        m_buffers.push_front(std::move(str));
+    }
 
 private:
     inline void lexStreamDepthAdd(int delta);
@@ -221,7 +230,7 @@ public:  // Used only by V3PreLex.cpp and V3PreProc.cpp
     void pushStateIncFilename();
     void scanNewFile(FileLine* filelinep);
     void scanBytes(const string& str);
-    void scanBytesBack(const string& str);
+    void scanBytesBack(string&& str);
     size_t inputToLex(char* buf, size_t max_size);
     /// Called by V3PreProc.cpp to get data from lexer
     YY_BUFFER_STATE currentBuffer();
@@ -29,12 +29,16 @@
 #include "V3PreExpr.h"
 #include "V3PreLex.h"
 #include "V3PreShell.h"
+#include "V3Stats.h"
 #include "V3String.h"
 
 #include <algorithm>
+#include <cctype>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <stack>
+#include <unordered_map>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -120,6 +124,8 @@ public:
 
     // Defines list
     DefinesMap m_defines;  ///< Map of defines
+    // Include guards: filename -> guard define, or "" if file is not guarded
+    std::unordered_map<string, string> m_includeGuards;
 
     // STATE
     const V3PreProc* m_preprocp = nullptr;  ///< Object we're holding data for
@@ -209,6 +215,7 @@ private:
     // Internal methods
     void endOfOneFile();
     string defineSubst(VDefineRef* refp);
+    static string includeGuard(const StrList& wholefile);
 
     bool defExists(const string& name);
     bool defCmdline(const string& name);
@@ -809,6 +816,79 @@ string V3PreProcImp::defineSubst(VDefineRef* refp) {
     return out;
 }
 
+//**********************************************************************
+// Include guards
+
+string V3PreProcImp::includeGuard(const StrList& wholefile) {
+    // Return the guard define if the file is entirely wrapped in
+    // "`ifndef NAME `define NAME ... `endif", with only whitespace and comments
+    // outside, else "".  Anything unexpected gives "", which just disables the skip.
+    string text;
+    for (const string& i : wholefile) text += i;
+    const char* cp = text.c_str();
+    const char* const ep = cp + text.length();
+    const auto skipSpace = [&]() -> bool {  // Returns false on unterminated comment
+        while (cp < ep) {
+            if (std::isspace(*cp)) {
+                ++cp;
+            } else if (cp[0] == '/' && cp[1] == '/') {
+                while (cp < ep && *cp != '\n') ++cp;
+            } else if (cp[0] == '/' && cp[1] == '*') {
+                const char* const endp = std::strstr(cp + 2, "*/");
+                if (!endp) return false;
+                cp = endp + 2;
+            } else {
+                break;
+            }
+        }
+        return true;
+    };
+    const auto isIdent = [](char c) { return std::isalnum(c) || c == '_' || c == '$'; };
+    const auto readIdent = [&]() {
+        const char* const sp = cp;
+        while (cp < ep && isIdent(*cp)) ++cp;
+        return string{sp, static_cast<size_t>(cp - sp)};
+    };
+    // Header
+    if (!skipSpace() || *cp != '`') return "";
+    ++cp;
+    if (readIdent() != "ifndef") return "";
+    while (cp < ep && (*cp == ' ' || *cp == '\t')) ++cp;
+    const string guard = readIdent();
+    if (guard.empty()) return "";
+    if (!skipSpace() || *cp != '`') return "";
+    ++cp;
+    if (readIdent() != "define") return "";
+    while (cp < ep && (*cp == ' ' || *cp == '\t')) ++cp;
+    if (readIdent() != guard) return "";
+    // Body, tracking conditional depth until the guard's `endif
+    int depth = 1;
+    while (cp < ep && depth) {
+        if (cp[0] == '/' && (cp[1] == '/' || cp[1] == '*')) {
+            if (!skipSpace()) return "";
+        } else if (*cp == '"') {
+            for (++cp; cp < ep && *cp != '"'; ++cp) {
+                if (*cp == '\\' && cp + 1 < ep) ++cp;
+            }
+            if (cp < ep) ++cp;
+        } else if (*cp == '`') {
+            ++cp;
+            const string directive = readIdent();
+            if (directive == "ifdef" || directive == "ifndef") {
+                ++depth;
+            } else if (directive == "endif") {
+                --depth;
+            } else if ((directive == "else" || directive == "elsif") && depth == 1) {
+                return "";
+            }
+        } else {
+            ++cp;
+        }
+    }
+    if (depth || !skipSpace() || cp < ep) return "";
+    return guard;
+}
+
 //**********************************************************************
 // Parser routines
 
@@ -818,6 +898,17 @@ void V3PreProcImp::openFile(FileLine*, VInFilter* filterp, const string& filenam
     m_lexp->setYYDebug(debug() >= 5);
     V3File::addSrcDepend(filename);
 
+    // Skip an include whose guard is already defined, as the whole contents would be
+    // discarded anyhow.  Not done with -E, so the `line output is unchanged.
+    if (!m_preprocp->isEof() && !v3Global.opt.preprocOnly()) {
+        const auto it = m_includeGuards.find(filename);
+        if (it != m_includeGuards.end() && !it->second.empty() && defExists(it->second)) {
+            UINFO(4, "Skip guarded include " << filename << " `" << it->second << endl);
+            V3Stats::addStatSum("Preprocessor, Guarded includes skipped", 1);
+            return;
+        }
+    }
+
     // Read a list<string> with the whole file.
     StrList wholefile;
     const bool ok = filterp->readWholefile(filename, wholefile /*ref*/);
@@ -840,6 +931,10 @@ void V3PreProcImp::openFile(FileLine*, VInFilter* filterp, const string& filenam
         addLineComment(0);
     }
 
+    if (m_includeGuards.find(filename) == m_includeGuards.end()) {
+        m_includeGuards.emplace(filename, includeGuard(wholefile));
+    }
+
     // Save file contents for future error reporting
     FileLine* const flsp = new FileLine{filename};
     flsp->lineno(1);
@@ -895,10 +990,9 @@ void V3PreProcImp::openFile(FileLine*, VInFilter* filterp, const string& filenam
             *it = out;
         }
 
-        // Push the data to an internal buffer.
-        m_lexp->scanBytesBack(*it);
-        // Reclaim memory; the push saved the string contents for us
-        *it = "";
+        // Move the data to the lexer's buffers, without a copy
+        m_lexp->scanBytesBack(std::move(*it));
+        it->clear();
     }
 
     // Warning check
@@ -34,6 +34,9 @@
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 constexpr int STATIC_CONST_MIN_WIDTH = 256;  // Minimum size to extract to static constant
+// Minimum length of string constants to extract to static constant. Shorter strings fit in
+// std::string's inline buffer, so are cheap to construct.
+constexpr size_t STATIC_STRING_MIN_LENGTH = 16;
 
 //######################################################################
 // Premit state, as a visitor of each AstNode
@@ -55,12 +58,23 @@ class PremitVisitor final : public VNVisitor {
     bool m_assignLhs = false;  // Inside assignment lhs, don't breakup extracts
 
     // METHODS
+    static bool isFusedBitOp(const AstNode* nodep) {
+        // Wide bitwise operators that V3Expand will not split into words are
+        // emitted as a single fused loop (VL_ASSIGN_WE), so need no temporaries
+        if (!VN_IS(nodep, And) && !VN_IS(nodep, Or) && !VN_IS(nodep, Xor) && !VN_IS(nodep, Not)) {
+            return false;
+        }
+        if (!nodep->isWide()) return false;
+        return !v3Global.opt.fExpand() || nodep->widthWords() > v3Global.opt.expandLimit();
+    }
+
     void checkNode(AstNodeExpr* nodep) {
         // Consider adding a temp for this expression.
         if (!m_stmtp) return;  // Not under a statement
         if (nodep->user1SetOnce()) return;  // Already processed
         if (!nodep->isWide()) return;  // Not wide
         if (m_assignLhs) return;  // This is an lvalue!
+        if (isFusedBitOp(nodep) && isFusedBitOp(nodep->backp())) return;  // Fused into parent
         UASSERT_OBJ(!VN_IS(nodep->firstAbovep(), ArraySel), nodep, "Should have been ignored");
         createWideTemp(nodep);
     }
@@ -261,7 +275,21 @@ class PremitVisitor final : public VNVisitor {
     void visit(AstShiftR* nodep) override { visitShift(nodep); }
     void visit(AstShiftRS* nodep) override { visitShift(nodep); }
 
-    void visit(AstConst* nodep) override { checkNode(nodep); }
+    void visit(AstConst* nodep) override {
+        if (nodep->num().isString()) {
+            // Long strings would be constructed on the heap at every evaluation, so share a
+            // single copy in the constant pool
+            if (!m_stmtp || m_assignLhs || nodep->user1SetOnce()) return;
+            if (nodep->num().toString().length() < STATIC_STRING_MIN_LENGTH) return;
+            const bool merge = v3Global.opt.fMergeConstPool();
+            AstVarScope* const vscp = v3Global.rootp()->constPoolp()->findConst(nodep, merge);
+            nodep->replaceWith(new AstVarRef{nodep->fileline(), vscp, VAccess::READ});
+            VL_DO_DANGLING(pushDeletep(nodep), nodep);
+            ++m_extractedToConstPool;
+            return;
+        }
+        checkNode(nodep);
+    }
     // Operators
     void visit(AstNodeTermop* nodep) override { checkNode(nodep); }
     void visit(AstNodeUniop* nodep) override {
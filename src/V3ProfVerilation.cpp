@@ -0,0 +1,113 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Timeline profile of Verilation itself
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "V3PchAstMT.h"
+
+#include "V3ProfVerilation.h"
+
+#include "V3File.h"
+#include "V3Os.h"
+
+#include <vector>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+
+namespace {
+
+struct ProfEvent final {
+    const char* m_categoryp;  // Category: pass, subpass, check, job, file
+    std::string m_name;  // Name of pass, file, etc.
+    uint64_t m_startUs;  // Start time, relative to s_originUs
+    uint64_t m_durUs;  // Duration
+    int m_tid;  // Thread number, 0 for the first thread recording
+};
+
+struct ProfState final {
+    V3Mutex m_mutex;
+    std::vector<ProfEvent> m_events VL_GUARDED_BY(m_mutex);  // All events recorded
+    std::atomic<int> m_nextTid{0};  // Next thread number to assign
+};
+ProfState& profState() VL_MT_SAFE {
+    static ProfState s_state;
+    return s_state;
+}
+
+const uint64_t s_originUs = V3Os::timeUsecs();  // Time origin of all events
+uint64_t s_passStartUs = s_originUs;  // Start of the current pass
+uint64_t s_subPassStartUs = s_originUs;  // Start of the current sub-pass
+thread_local int t_tid = -1;  // Thread number of this thread, -1 if not yet assigned
+
+}  // namespace
+
+bool V3ProfVerilation::s_enabled = false;
+
+//######################################################################
+
+uint64_t V3ProfVerilation::nowUs() VL_MT_SAFE { return V3Os::timeUsecs(); }
+
+void V3ProfVerilation::event(const char* categoryp, const std::string& name,
+                             uint64_t startUs) VL_MT_SAFE {
+    if (!enabled()) return;
+    const uint64_t endUs = nowUs();
+    ProfState& state = profState();
+    if (VL_UNLIKELY(t_tid < 0)) t_tid = state.m_nextTid++;
+    const uint64_t relStartUs = startUs - std::min(startUs, s_originUs);
+    const V3LockGuard lock{state.m_mutex};
+    state.m_events.push_back(
+        {categoryp, name, relStartUs, endUs - std::min(endUs, startUs), t_tid});
+}
+
+void V3ProfVerilation::passEnd(const std::string& name) {
+    if (!enabled()) return;
+    event("pass", name, s_passStartUs);
+    s_passStartUs = s_subPassStartUs = nowUs();
+}
+
+void V3ProfVerilation::checkEnd(const std::string& name) {
+    if (!enabled()) return;
+    event("check", name, s_passStartUs);
+    s_passStartUs = s_subPassStartUs = nowUs();
+}
+
+void V3ProfVerilation::subPassEnd(const std::string& name) {
+    if (!enabled()) return;
+    event("subpass", name, s_subPassStartUs);
+    s_subPassStartUs = nowUs();
+}
+
+void V3ProfVerilation::write(const std::string& filename) {
+    if (!enabled()) return;
+    UINFO(2, __FUNCTION__ << ": " << filename << endl);
+    const std::unique_ptr<std::ofstream> ofp{V3File::new_ofstream(filename)};
+    if (ofp->fail()) v3fatal("Can't write file: " << filename);
+    std::ofstream& os = *ofp;
+    ProfState& state = profState();
+    const V3LockGuard lock{state.m_mutex};
+    // Chrome trace-event format, 'X' is a complete event with start and duration
+    os << "{\"displayTimeUnit\": \"ms\",\n";
+    os << " \"traceEvents\": [\n";
+    os << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, "
+          "\"args\": {\"name\": \"verilator\"}}";
+    for (const ProfEvent& ev : state.m_events) {
+        os << ",\n  {\"name\": \"" << V3OutFormatter::quoteNameControls(ev.m_name)
+           << "\", \"cat\": \"" << ev.m_categoryp << "\", \"ph\": \"X\", \"ts\": "
+           << ev.m_startUs << ", \"dur\": " << ev.m_durUs << ", \"pid\": 1, \"tid\": "
+           << ev.m_tid << "}";
+    }
+    os << "\n ]\n}\n";
+}
@@ -0,0 +1,81 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Timeline profile of Verilation itself
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+//
+// With --prof-verilation, records when each pass, sub-pass, V3ThreadPool
+// job and emitted file started and ended, on which thread, and writes
+// them as a Chrome trace-event JSON file, viewable in Perfetto or
+// chrome://tracing.
+//
+//*************************************************************************
+
+#ifndef VERILATOR_V3PROFVERILATION_H_
+#define VERILATOR_V3PROFVERILATION_H_
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include <string>
+
+//============================================================================
+
+class V3ProfVerilation final {
+    static bool s_enabled;  // Recording events
+
+public:
+    // METHODS
+    static void enable() { s_enabled = true; }
+    static bool enabled() VL_MT_SAFE { return s_enabled; }
+    // Return time for event start
+    static uint64_t nowUs() VL_MT_SAFE;
+    // Record an event from 'startUs' until now, on the calling thread
+    static void event(const char* categoryp, const std::string& name,
+                      uint64_t startUs) VL_MT_SAFE;
+    // Record the pass ending now, which started at the end of the previous pass or check
+    static void passEnd(const std::string& name);
+    // Record the dumps and checks after a pass, ending now
+    static void checkEnd(const std::string& name);
+    // Record a sub-pass ending now, which started at the previous pass or sub-pass
+    static void subPassEnd(const std::string& name);
+    // Write the recorded events
+    static void write(const std::string& filename);
+};
+
+//============================================================================
+// Record the lifetime of this object as an event
+
+class V3ProfVerilationScope final {
+    const bool m_enabled = V3ProfVerilation::enabled();  // Recording this event
+    const char* const m_categoryp;  // Event category
+    std::string m_name;  // Event name, only set if enabled
+    uint64_t m_startUs = 0;  // Start time
+
+public:
+    // CONSTRUCTORS
+    V3ProfVerilationScope(const char* categoryp, const std::string& name) VL_MT_SAFE
+        : m_categoryp{categoryp} {
+        if (VL_UNLIKELY(m_enabled)) {
+            m_name = name;
+            m_startUs = V3ProfVerilation::nowUs();
+        }
+    }
+    ~V3ProfVerilationScope() VL_MT_SAFE {
+        if (VL_UNLIKELY(m_enabled)) V3ProfVerilation::event(m_categoryp, m_name, m_startUs);
+    }
+    VL_UNCOPYABLE(V3ProfVerilationScope);
+    VL_UNMOVABLE(V3ProfVerilationScope);
+};
+
+#endif  // Guard
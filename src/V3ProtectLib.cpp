@@ -59,10 +59,22 @@ class ProtectVisitor final : public VNVisitor {
     AstTextBlock* m_cSeqClksp = nullptr;  // Sequential clock copy list
     AstTextBlock* m_cSeqOutsp = nullptr;  // Sequential output copy list
     AstTextBlock* m_cIgnoreParamsp = nullptr;  // Combo ignore parameter list
+    AstTextBlock* m_cPortDeclsp = nullptr;  // Port struct declaration list
+    AstTextBlock* m_cServeInsp = nullptr;  // Block process input copy list
+    AstTextBlock* m_cServeOutsp = nullptr;  // Block process output copy list
     const string m_libName;
     const string m_topName;
+    const bool m_process;  // Evaluate in a separate process, --hierarchical-process
     bool m_foundTop = false;  // Have seen the top module
     bool m_hasClk = false;  // True if the top module has sequential logic
+    // With hierarchical Verilation, ports are exchanged through one word buffer per
+    // direction, instead of a DPI argument, with its own conversion, per port
+    bool m_batch = false;
+    int m_comboInWords = 0;  // Words used in the combo input buffer
+    int m_seqInWords = 0;  // Words used in the clock input buffer
+    int m_outWords = 0;  // Words used in the output buffer
+    std::vector<string> m_comboInCat;  // SV concatenation of combo input buffer, LSB first
+    std::vector<string> m_seqInCat;  // SV concatenation of clock input buffer, LSB first
 
     // VISITORS
     void visit(AstNetlist* nodep) override {
@@ -84,10 +96,12 @@ class ProtectVisitor final : public VNVisitor {
         FileLine* const fl = nodep->fileline();
         // Need to know the existence of clk before createSvFile()
         m_hasClk = checkIfClockExists(nodep);
+        m_batch = v3Global.opt.hierChild() && checkIfBatchable(nodep);
         createSvFile(fl, nodep);
         createCppFile(fl);
 
         iterateChildren(nodep);
+        if (m_batch) finishBatch(fl);
 
         // cppcheck-has-bug-suppress unreadVariable
         const V3Hash hash = V3Hasher::uncachedHash(m_cfilep);
@@ -111,6 +125,9 @@ class ProtectVisitor final : public VNVisitor {
         modp->foreach([&cost](AstCFunc* cfuncp) {
             if (cfuncp->name() == "_eval") cost = V3InstrCount::count(cfuncp, false);
         });
+        // A zero cost would make the parent treat the update as an unknown DPI
+        // hazard, serializing it, rather than an mtask run alongside its siblings
+        cost = std::max<uint32_t>(cost, 1);
         txtp->addText(fl, "profile_data -hier-dpi \"" + m_libName
                               + "_protectlib_combo_update\" -cost 64'd" + std::to_string(cost)
                               + "\n");
@@ -327,12 +344,49 @@ class ProtectVisitor final : public VNVisitor {
     }
 
     void castPtr(FileLine* fl, AstTextBlock* txtp) {
+        if (m_process) {
+            txtp->addText(fl, m_libName + "_process* const handlep__V = static_cast<" + m_libName
+                                  + "_process*>(vhandlep__V);\n");
+            txtp->addText(fl, m_libName + "_ports* const portsp__V = &handlep__V->ports();\n");
+            return;
+        }
         txtp->addText(fl, m_topName
                               + "_container* const handlep__V = "  // LCOV_EXCL_LINE  // lcov bug
                                 "static_cast<"
                               + m_topName + "_container*>(vhandlep__V);\n");
     }
 
+    void processSection(FileLine* fl, AstTextBlock* txtp) {
+        // With --hierarchical-process the model runs in a forked process, and
+        // the wrapper functions below exchange port values through shared memory
+        addComment(txtp, fl, "Port values shared with the block process");
+        m_cPortDeclsp = new AstTextBlock{fl, "struct " + m_libName + "_ports final {\n"};
+        txtp->addNodesp(m_cPortDeclsp);
+        txtp->addText(fl, "};\n");
+        txtp->addText(fl, "using " + m_libName + "_process = VlHierProcess<" + m_libName
+                              + "_ports>;\n\n");
+
+        addComment(txtp, fl, "Evaluate requests in the block process");
+        txtp->addText(fl, "static void " + m_libName + "_protectlib_serve(" + m_libName
+                              + "_process& process__V, const char* scopep__V) {\n");
+        txtp->addText(fl, /**/ m_topName + "_container* const handlep__V = new " + m_topName
+                              + "_container{scopep__V};\n");
+        txtp->addText(fl, /**/ m_libName + "_ports* const portsp__V = &process__V.ports();\n");
+        txtp->addText(fl, /**/ "while (process__V.waitRequest() == " + m_libName
+                              + "_process::OP_EVAL) {\n");
+        m_cServeInsp = new AstTextBlock{
+            fl, "handlep__V->contextp()->time(process__V.time());\n"};
+        txtp->addNodesp(m_cServeInsp);
+        m_cServeOutsp = new AstTextBlock{fl, "handlep__V->eval();\n"};
+        txtp->addNodesp(m_cServeOutsp);
+        txtp->addText(fl, /****/ "process__V.reply(handlep__V->contextp()->gotFinish());\n");
+        txtp->addText(fl, /**/ "}\n");
+        txtp->addText(fl, /**/ "handlep__V->final();\n");
+        txtp->addText(fl, /**/ "delete handlep__V;\n");
+        txtp->addText(fl, /**/ "process__V.reply(false);\n");
+        txtp->addText(fl, "}\n\n");
+    }
+
     void createCppFile(FileLine* fl) {
         // Comments
         AstTextBlock* const txtp = new AstTextBlock{fl};
@@ -340,19 +394,26 @@ class ProtectVisitor final : public VNVisitor {
 
         // Includes
         txtp->addText(fl, "#include \"" + m_topName + ".h\"\n");
-        txtp->addText(fl, "#include \"verilated_dpi.h\"\n\n");
+        txtp->addText(fl, "#include \"verilated_dpi.h\"\n");
+        if (m_process) txtp->addText(fl, "#include \"verilated_hier_process.h\"\n");
+        txtp->addText(fl, "\n");
         txtp->addText(fl, "#include <cstdio>\n");
-        txtp->addText(fl, "#include <cstdlib>\n\n");
+        txtp->addText(fl, "#include <cstdlib>\n");
+        if (m_batch) txtp->addText(fl, "#include <cstring>\n");
+        txtp->addText(fl, "\n");
 
         // Verilated module plus sequence number
         addComment(txtp, fl, "Container class to house verilated object and sequence number");
         txtp->addText(fl, "class " + m_topName + "_container: public " + m_topName + " {\n");
         txtp->addText(fl, "public:\n");
         txtp->addText(fl, "long long m_seqnum;\n");
+        if (m_batch) txtp->addText(fl, "bool m_settled = false;\n");
         txtp->addText(fl, m_topName + "_container(const char* scopep__V):\n");
         txtp->addText(fl, m_topName + "(scopep__V) {}\n");
         txtp->addText(fl, "};\n\n");
 
+        if (m_process) processSection(fl, txtp);
+
         // Extern C
         txtp->addText(fl, "extern \"C\" {\n\n");
 
@@ -375,9 +436,14 @@ class ProtectVisitor final : public VNVisitor {
         // Initial
         initialComment(txtp, fl);
         txtp->addText(fl, "void* " + m_libName + "_protectlib_create(const char* scopep__V) {\n");
-        txtp->addText(fl, /**/ m_topName + "_container* const handlep__V = new " + m_topName
-                              + "_container{scopep__V};\n");
-        txtp->addText(fl, /**/ "return handlep__V;\n");
+        if (m_process) {
+            txtp->addText(fl, /**/ "return new " + m_libName + "_process{scopep__V, &" + m_libName
+                                  + "_protectlib_serve};\n");
+        } else {
+            txtp->addText(fl, /**/ m_topName + "_container* const handlep__V = new " + m_topName
+                                  + "_container{scopep__V};\n");
+            txtp->addText(fl, /**/ "return handlep__V;\n");
+        }
         txtp->addText(fl, "}\n\n");
 
         // Updates
@@ -385,12 +451,26 @@ class ProtectVisitor final : public VNVisitor {
         m_cComboParamsp = new AstTextBlock{
             fl, "long long " + m_libName + "_protectlib_combo_update(\n", false, true};
         m_cComboParamsp->addText(fl, "void* vhandlep__V\n");
+        if (m_batch) {
+            m_cComboParamsp->addText(fl, "const svBitVecVal* ins__V\n");
+            m_cComboParamsp->addText(fl, "svBitVecVal* outs__V\n");
+        }
         txtp->addNodesp(m_cComboParamsp);
         txtp->addText(fl, ")\n");
         m_cComboInsp = new AstTextBlock{fl, "{\n"};
         castPtr(fl, m_cComboInsp);
+        // Unchanged inputs need no evaluation, as clocks are only applied by the seq update
+        if (m_batch && !m_process) m_cComboInsp->addText(fl, "bool changed__V = false;\n");
         txtp->addNodesp(m_cComboInsp);
-        m_cComboOutsp = new AstTextBlock{fl, "handlep__V->eval();\n"};
+        if (m_batch && !m_process) {
+            m_cComboOutsp = new AstTextBlock{
+                fl, "if (changed__V || !handlep__V->m_settled) {\n"
+                    "handlep__V->eval();\n"
+                    "handlep__V->m_settled = true;\n"
+                    "}\n"};
+        } else {
+            m_cComboOutsp = new AstTextBlock{fl, "handlep__V->eval();\n"};
+        }
         txtp->addNodesp(m_cComboOutsp);
         txtp->addText(fl, "return handlep__V->m_seqnum++;\n");
         txtp->addText(fl, "}\n\n");
@@ -400,12 +480,17 @@ class ProtectVisitor final : public VNVisitor {
             m_cSeqParamsp = new AstTextBlock{
                 fl, "long long " + m_libName + "_protectlib_seq_update(\n", false, true};
             m_cSeqParamsp->addText(fl, "void* vhandlep__V\n");
+            if (m_batch) {
+                m_cSeqParamsp->addText(fl, "const svBitVecVal* clks__V\n");
+                m_cSeqParamsp->addText(fl, "svBitVecVal* outs__V\n");
+            }
             txtp->addNodesp(m_cSeqParamsp);
             txtp->addText(fl, ")\n");
             m_cSeqClksp = new AstTextBlock{fl, "{\n"};
             castPtr(fl, m_cSeqClksp);
             txtp->addNodesp(m_cSeqClksp);
             m_cSeqOutsp = new AstTextBlock{fl, "handlep__V->eval();\n"};
+            if (m_batch && !m_process) m_cSeqOutsp->addText(fl, "handlep__V->m_settled = true;\n");
             txtp->addNodesp(m_cSeqOutsp);
             txtp->addText(fl, "return handlep__V->m_seqnum++;\n");
             txtp->addText(fl, "}\n\n");
@@ -415,6 +500,7 @@ class ProtectVisitor final : public VNVisitor {
         m_cIgnoreParamsp = new AstTextBlock{
             fl, "void " + m_libName + "_protectlib_combo_ignore(\n", false, true};
         m_cIgnoreParamsp->addText(fl, "void* vhandlep__V\n");
+        if (m_batch) m_cIgnoreParamsp->addText(fl, "const svBitVecVal* ins__V\n");
         txtp->addNodesp(m_cIgnoreParamsp);
         txtp->addText(fl, ")\n");
         txtp->addText(fl, "{ }\n\n");
@@ -451,12 +537,39 @@ class ProtectVisitor final : public VNVisitor {
     void visit(AstNode*) override {}
 
     string cInputConnection(AstVar* varp) {
-        return V3Task::assignDpiToInternal("handlep__V->" + varp->name(), varp);
+        return V3Task::assignDpiToInternal(cPortPrefix() + varp->name(), varp);
+    }
+    // Where the wrapper functions find the model's port values
+    string cPortPrefix() const { return m_process ? "portsp__V->" : "handlep__V->"; }
+
+    void handleProcessPort(AstVar* varp) {
+        if (!m_process) return;
+        FileLine* const fl = varp->fileline();
+        const AstBasicDType* const basicp = varp->basicp();
+        if (basicp && (basicp->isString() || basicp->keyword() == VBasicDTypeKwd::CHANDLE)) {
+            varp->v3warn(E_UNSUPPORTED, "Unsupported: --hierarchical-process port of type "
+                                            << basicp->prettyTypeName());
+            return;
+        }
+        m_cPortDeclsp->addText(fl, varp->vlArgType(true, false, false) + ";\n");
+        if (varp->direction() == VDirection::INPUT) {
+            m_cServeInsp->addText(fl, "handlep__V->" + varp->name() + " = portsp__V->"
+                                          + varp->name() + ";\n");
+        } else {
+            m_cServeOutsp->addText(fl, "portsp__V->" + varp->name() + " = handlep__V->"
+                                           + varp->name() + ";\n");
+        }
     }
 
     void handleClock(AstVar* varp) {
         FileLine* const fl = varp->fileline();
         handleInput(varp);
+        if (m_batch) {
+            m_clkSensp->addText(fl, "posedge " + varp->name() + " or negedge " + varp->name());
+            m_cSeqClksp->addText(fl, cBatchInput(varp, "clks__V", m_seqInWords, false));
+            batchConcat(m_seqInCat, m_seqInWords, varp);
+            return;
+        }
         m_seqPortsp->addNodesp(varp->cloneTree(false));
         if (m_hasClk) {
             m_seqParamsp->addText(fl, varp->name() + "\n");
@@ -469,6 +582,11 @@ class ProtectVisitor final : public VNVisitor {
     void handleDataInput(AstVar* varp) {
         FileLine* const fl = varp->fileline();
         handleInput(varp);
+        if (m_batch) {
+            m_cComboInsp->addText(fl, cBatchInput(varp, "ins__V", m_comboInWords, !m_process));
+            batchConcat(m_comboInCat, m_comboInWords, varp);
+            return;
+        }
         m_comboPortsp->addNodesp(varp->cloneTree(false));
         m_comboParamsp->addText(fl, varp->name() + "\n");
         m_comboIgnorePortsp->addNodesp(varp->cloneTree(false));
@@ -478,7 +596,10 @@ class ProtectVisitor final : public VNVisitor {
         m_cIgnoreParamsp->addText(fl, varp->dpiArgType(true, false) + "\n");
     }
 
-    void handleInput(AstVar* varp) { m_modPortsp->addNodesp(varp->cloneTree(false)); }
+    void handleInput(AstVar* varp) {
+        m_modPortsp->addNodesp(varp->cloneTree(false));
+        handleProcessPort(varp);
+    }
 
     static void addLocalVariable(AstTextBlock* textp, AstVar* varp, const char* suffix) {
         AstVar* const newVarp
@@ -489,6 +610,20 @@ class ProtectVisitor final : public VNVisitor {
     void handleOutput(AstVar* varp) {
         FileLine* const fl = varp->fileline();
         m_modPortsp->addNodesp(varp->cloneTree(false));
+        handleProcessPort(varp);
+        if (m_batch) {
+            const string range = "[" + cvtToStr(m_outWords * VL_EDATASIZE + varp->width() - 1)
+                                 + ":" + cvtToStr(m_outWords * VL_EDATASIZE) + "]";
+            if (m_hasClk) {
+                m_seqAssignsp->addText(fl, varp->name() + " = outs_seq__V" + range + ";\n");
+            }
+            m_comboAssignsp->addText(fl, varp->name() + " = outs_combo__V" + range + ";\n");
+            const string outp = cBatchOutput(varp, "outs__V", m_outWords);
+            m_cComboOutsp->addText(fl, outp);
+            if (m_hasClk) m_cSeqOutsp->addText(fl, outp);
+            m_outWords += varp->widthWords();
+            return;
+        }
         m_comboPortsp->addNodesp(varp->cloneTree(false));
         m_comboParamsp->addText(fl, varp->name() + "_combo__V\n");
         if (m_hasClk) {
@@ -508,11 +643,95 @@ class ProtectVisitor final : public VNVisitor {
         m_comboAssignsp->addText(fl, varp->name() + " = " + varp->name() + "_combo__V;\n");
         m_cComboParamsp->addText(fl, varp->dpiArgType(true, false) + "\n");
         m_cComboOutsp->addText(fl,
-                               V3Task::assignInternalToDpi(varp, true, "", "", "handlep__V->"));
+                               V3Task::assignInternalToDpi(varp, true, "", "", cPortPrefix()));
         if (m_hasClk) {
             m_cSeqParamsp->addText(fl, varp->dpiArgType(true, false) + "\n");
             m_cSeqOutsp->addText(fl,
-                                 V3Task::assignInternalToDpi(varp, true, "", "", "handlep__V->"));
+                                 V3Task::assignInternalToDpi(varp, true, "", "", cPortPrefix()));
+        }
+    }
+
+    // Batched port exchange, see m_batch
+    static bool checkIfBatchable(AstNodeModule* modp) {
+        for (AstNode* stmtp = modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            if (const AstVar* const varp = VN_CAST(stmtp, Var)) {
+                if (!varp->isIO()) continue;
+                const AstNodeDType* const dtypep = varp->dtypep()->skipRefp();
+                const AstBasicDType* const basicp = dtypep->basicp();
+                if (!dtypep->isIntegralOrPacked() || !basicp || basicp->isOpaque()) return false;
+            }
+        }
+        return true;
+    }
+    static void batchConcat(std::vector<string>& cat, int& words, const AstVar* varp) {
+        // Each port starts on a word boundary, zero padded to the end of its last word
+        const int padding = varp->widthWords() * VL_EDATASIZE - varp->width();
+        if (padding) cat.push_back(cvtToStr(padding) + "'b0");
+        cat.push_back(varp->name());
+        words += varp->widthWords();
+    }
+    string cBatchInput(const AstVar* varp, const string& bufName, int word, bool compare) {
+        const string portName = cPortPrefix() + varp->name();
+        const string frName = bufName + (word ? " + " + cvtToStr(word) : "");
+        string value;
+        string changed;
+        string assign;
+        if (varp->isWide()) {
+            const string bytes = cvtToStr(varp->widthWords()) + " * sizeof(EData)";
+            changed = "std::memcmp(" + portName + ".data(), " + frName + ", " + bytes + ")";
+            assign = "std::memcpy(" + portName + ".data(), " + frName + ", " + bytes + ");";
+        } else {
+            value = varp->isQuad() ? "VL_SET_QW(" + frName + ")" : bufName + "[" + cvtToStr(word)
+                                                                       + "]";
+            changed = portName + " != " + value;
+            assign = portName + " = " + value + ";";
+        }
+        if (!compare) return assign + "\n";
+        return "if (" + changed + ") {\n" + assign + "\nchanged__V = true;\n}\n";
+    }
+    string cBatchOutput(const AstVar* varp, const string& bufName, int word) {
+        const string portName = cPortPrefix() + varp->name();
+        const string toName = bufName + (word ? " + " + cvtToStr(word) : "");
+        if (varp->isWide()) {
+            return "std::memcpy(" + toName + ", " + portName + ".data(), "
+                   + cvtToStr(varp->widthWords()) + " * sizeof(EData));\n";
+        } else if (varp->isQuad()) {
+            return "VL_SET_WQ(" + toName + ", " + portName + ");\n";
+        }
+        return bufName + "[" + cvtToStr(word) + "] = " + portName + ";\n";
+    }
+    static string batchBitsDecl(int words) {
+        // At least one word, so the DPI argument always exists
+        return "bit [" + cvtToStr(std::max(words, 1) * VL_EDATASIZE - 1) + ":0]";
+    }
+    static string batchConcatText(const std::vector<string>& cat) {
+        if (cat.empty()) return "32'b0";
+        string out = "{";
+        for (auto it = cat.rbegin(); it != cat.rend(); ++it) {
+            out += (it == cat.rbegin() ? "" : ", ") + *it;
+        }
+        return out + "}";
+    }
+    void finishBatch(FileLine* fl) {
+        // Buffer sizes are only known once all ports were seen
+        const string inDecl = batchBitsDecl(m_comboInWords);
+        const string outDecl = batchBitsDecl(m_outWords);
+        const string inCat = batchConcatText(m_comboInCat);
+        m_comboPortsp->addText(fl, "input " + inDecl + " ins__V\n");
+        m_comboPortsp->addText(fl, "output " + outDecl + " outs__V\n");
+        m_comboParamsp->addText(fl, inCat + "\n");
+        m_comboParamsp->addText(fl, "outs_combo__V\n");
+        m_comboIgnorePortsp->addText(fl, "input " + inDecl + " ins__V\n");
+        m_comboDeclsp->addText(fl, outDecl + " outs_combo__V;\n");
+        if (m_hasClk) {
+            m_seqPortsp->addText(fl, "input " + batchBitsDecl(m_seqInWords) + " clks__V\n");
+            m_seqPortsp->addText(fl, "output " + outDecl + " outs__V\n");
+            m_seqParamsp->addText(fl, batchConcatText(m_seqInCat) + "\n");
+            m_seqParamsp->addText(fl, "outs_tmp__V\n");
+            m_comboIgnoreParamsp->addText(fl, inCat + "\n");
+            m_seqDeclsp->addText(fl, outDecl + " outs_seq__V;\n");
+            m_tmpDeclsp->addText(fl, outDecl + " outs_tmp__V;\n");
+            m_nbAssignsp->addText(fl, "outs_seq__V <= outs_tmp__V;\n");
         }
     }
 
@@ -532,7 +751,8 @@ class ProtectVisitor final : public VNVisitor {
 public:
     explicit ProtectVisitor(AstNode* nodep)
         : m_libName{v3Global.opt.libCreate()}
-        , m_topName{v3Global.opt.prefix()} {
+        , m_topName{v3Global.opt.prefix()}
+        , m_process{v3Global.opt.hierChild() && v3Global.opt.hierProcess()} {
         iterate(nodep);
     }
 };
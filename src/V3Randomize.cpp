@@ -1571,6 +1571,28 @@ class RandomizeVisitor final : public VNVisitor {
         stmtsp = createForeachLoop(tempElementp, randLoopIndxp);
         return stmtsp;
     }
+    AstNodeStmt* newRandArrayBulkp(FileLine* fl, AstUnpackArrayDType* dtypep,
+                                   AstNodeExpr* exprp) {
+        // Unpacked arrays of plain numbers are filled with one call, instead of a loop
+        // with a generator call per element
+        const AstVarRef* const refp = VN_CAST(exprp, VarRef);
+        if (!refp || dtypep->isSparse()) return nullptr;
+        const AstNodeDType* elemDtypep = dtypep->subDTypep()->skipRefp();
+        while (const AstUnpackArrayDType* const subp = VN_CAST(elemDtypep, UnpackArrayDType)) {
+            if (subp->isSparse()) return nullptr;
+            elemDtypep = subp->subDTypep()->skipRefp();
+        }
+        // Enums need their value table, structs their members
+        const AstBasicDType* const basicp = VN_CAST(elemDtypep, BasicDType);
+        if (!basicp || !basicp->isIntegralOrPacked() || basicp->isOpaque()) return nullptr;
+        AstNode* const argsp = new AstText{
+            fl, "VL_RANDOM_RNG_ARRAY(__Vm_rng, " + cvtToStr(basicp->widthMin()) + ", &"};
+        argsp->addNext(exprp->cloneTree(false));
+        argsp->addNext(new AstText{fl, ", sizeof("});
+        argsp->addNext(exprp);
+        argsp->addNext(new AstText{fl, "));\n"});
+        return wrapIfRandMode(VN_AS(m_modp, Class), refp->varp(), new AstCStmt{fl, argsp});
+    }
     AstNodeStmt* newRandStmtsp(FileLine* fl, AstNodeExpr* exprp, AstVar* randcVarp,
                                AstVar* const outputVarp, int offset = 0,
                                AstMemberDType* memberp = nullptr) {
@@ -1621,6 +1643,9 @@ class RandomizeVisitor final : public VNVisitor {
             return createArrayForeachLoop(fl, queueDtp, exprp, outputVarp);
         } else if (AstUnpackArrayDType* const unpackarrayDtp
                    = VN_CAST(memberDtp, UnpackArrayDType)) {
+            if (AstNodeStmt* const stmtp = newRandArrayBulkp(fl, unpackarrayDtp, exprp)) {
+                return stmtp;
+            }
             return createArrayForeachLoop(fl, unpackarrayDtp, exprp, outputVarp);
         } else if (AstAssocArrayDType* const assocarrayDtp = VN_CAST(memberDtp, AssocArrayDType)) {
             return createArrayForeachLoop(fl, assocarrayDtp, exprp, outputVarp);
@@ -27,6 +27,17 @@
 //
 //   Likewise vector assign to the same constant converted to a loop.
 //
+//   Likewise element-wise operations between arrays (including the words of
+//   wide variables after V3Expand), with each array at its own constant offset:
+//
+//      ASSIGN(ARRAYREF(a, #), AND(ARRAYREF(b, #+C1), ARRAYREF(c, #+C2)))
+//      ->
+//      FOR(__Vilp = low; __Vilp <= high; ++__Vlip)
+//         ASSIGN(ARRAYREF(a, __Vilp), AND(ARRAYREF(b, __Vilp+C1), ARRAYREF(c, __Vilp+C2)))
+//
+//   The resulting loops have no dependencies between iterations, so C++
+//   compilers can vectorize them.
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
@@ -53,11 +64,10 @@ class ReloopVisitor final : public VNVisitor {
     AstCFunc* m_mgCfuncp = nullptr;  // Parent C function
     const AstNode* m_mgNextp = nullptr;  // Next node
     const AstNodeSel* m_mgSelLp = nullptr;  // Parent select, nullptr = idle
-    const AstNodeSel* m_mgSelRp = nullptr;  // Parent select, nullptr = constant
     const AstNodeVarRef* m_mgVarrefLp = nullptr;  // Parent varref
-    const AstNodeVarRef* m_mgVarrefRp = nullptr;  // Parent varref, nullptr = constant
-    int64_t m_mgOffset = 0;  // Index offset
-    const AstConst* m_mgConstRp = nullptr;  // Parent RHS constant, nullptr = sel
+    const AstNodeExpr* m_mgRhsp = nullptr;  // Right hand side of first assignment
+    // For each select on the right hand side, left index minus the select's index
+    std::vector<int64_t> m_mgOffsets;
     uint32_t m_mgIndexLo = 0;  // Merge range
     uint32_t m_mgIndexHi = 0;  // Merge range
 
@@ -74,11 +84,11 @@ class ReloopVisitor final : public VNVisitor {
         if (!m_mgAssignps.empty()) {
             const uint32_t items = m_mgIndexHi - m_mgIndexLo + 1;
             UINFO(9, "End merge iter=" << items << " " << m_mgIndexHi << ":" << m_mgIndexLo << " "
-                                       << m_mgOffset << " " << m_mgAssignps[0] << endl);
+                                       << m_mgAssignps[0] << endl);
             if (items >= static_cast<uint32_t>(v3Global.opt.reloopLimit())) {
                 UINFO(6, "Reloop merging items=" << items << " " << m_mgIndexHi << ":"
-                                                 << m_mgIndexLo << " " << m_mgOffset << " "
-                                                 << m_mgAssignps[0] << endl);
+                                                 << m_mgIndexLo << " " << m_mgAssignps[0]
+                                                 << endl);
                 ++m_statReloops;
                 m_statReItems += items;
 
@@ -88,13 +98,6 @@ class ReloopVisitor final : public VNVisitor {
                 FileLine* const fl = bodyp->fileline();
                 AstVar* const itp = createVarTemp(fl, m_mgCfuncp);
 
-                if (m_mgOffset > 0) {
-                    UASSERT_OBJ(m_mgIndexLo >= m_mgOffset, bodyp,
-                                "Reloop iteration starts at negative index");
-                    m_mgIndexLo -= m_mgOffset;
-                    m_mgIndexHi -= m_mgOffset;
-                }
-
                 AstNode* const initp = new AstAssign{fl, new AstVarRef{fl, itp, VAccess::WRITE},
                                                      new AstConst{fl, m_mgIndexLo}};
                 AstNodeExpr* const condp = new AstLte{fl, new AstVarRef{fl, itp, VAccess::READ},
@@ -108,19 +111,25 @@ class ReloopVisitor final : public VNVisitor {
                 bodyp->replaceWith(itp);
                 whilep->addStmtsp(bodyp);
 
-                // Replace constant index with new loop index
-                AstNodeExpr* const offsetp
-                    = m_mgOffset == 0 ? nullptr : new AstConst(fl, std::abs(m_mgOffset));
+                // Replace constant indices with the loop index, plus the offset of each select
                 AstNodeExpr* const lbitp = m_mgSelLp->bitp();
-                AstNodeExpr* const lvrefp = new AstVarRef{fl, itp, VAccess::READ};
-                lbitp->replaceWith(m_mgOffset > 0 ? new AstAdd{fl, lvrefp, offsetp} : lvrefp);
+                lbitp->replaceWith(new AstVarRef{fl, itp, VAccess::READ});
                 VL_DO_DANGLING(lbitp->deleteTree(), lbitp);
-                if (m_mgSelRp) {  // else constant and no replace
-                    AstNodeExpr* const rbitp = m_mgSelRp->bitp();
+                size_t i = 0;
+                bodyp->rhsp()->foreach([&](AstNodeSel* rselp) {
+                    const int64_t offset = m_mgOffsets.at(i++);
+                    AstNodeExpr* const rbitp = rselp->bitp();
                     AstNodeExpr* const rvrefp = new AstVarRef{fl, itp, VAccess::READ};
-                    rbitp->replaceWith(m_mgOffset < 0 ? new AstAdd{fl, rvrefp, offsetp} : rvrefp);
-                    VL_DO_DANGLING(rbitp->deleteTree(), lbitp);
-                }
+                    const uint32_t absOffset = static_cast<uint32_t>(std::abs(offset));
+                    AstNodeExpr* newp = rvrefp;
+                    if (offset > 0) {
+                        newp = new AstSub{fl, rvrefp, new AstConst{fl, absOffset}};
+                    } else if (offset < 0) {
+                        newp = new AstAdd{fl, rvrefp, new AstConst{fl, absOffset}};
+                    }
+                    rbitp->replaceWith(newp);
+                    VL_DO_DANGLING(rbitp->deleteTree(), rbitp);
+                });
                 if (debug() >= 9) initp->dumpTree("-  new: ");
                 if (debug() >= 9) whilep->dumpTree("-  new: ");
 
@@ -134,12 +143,27 @@ class ReloopVisitor final : public VNVisitor {
             // Setup for next merge
             m_mgAssignps.clear();
             m_mgSelLp = nullptr;
-            m_mgSelRp = nullptr;
             m_mgVarrefLp = nullptr;
-            m_mgVarrefRp = nullptr;
-            m_mgOffset = 0;
-            m_mgConstRp = nullptr;
+            m_mgRhsp = nullptr;
+            m_mgOffsets.clear();
+        }
+    }
+
+    // Whether the two expressions are the same, except for the indices of selects
+    static bool sameExceptIndex(const AstNode* ap, const AstNode* bp) {
+        if (!ap && !bp) return true;
+        if (!ap || !bp) return false;
+        if (!ap->isSame(bp)) return false;
+        if (ap->dtypep() && (!bp->dtypep() || !ap->dtypep()->similarDType(bp->dtypep()))) {
+            return false;
+        }
+        if (const AstNodeSel* const aSelp = VN_CAST(ap, NodeSel)) {
+            return sameExceptIndex(aSelp->fromp(), VN_AS(bp, NodeSel)->fromp());
         }
+        return sameExceptIndex(ap->op1p(), bp->op1p())  //
+               && sameExceptIndex(ap->op2p(), bp->op2p())  //
+               && sameExceptIndex(ap->op3p(), bp->op3p())  //
+               && sameExceptIndex(ap->op4p(), bp->op4p());
     }
 
     // VISITORS
@@ -176,21 +200,26 @@ class ReloopVisitor final : public VNVisitor {
             return;
         }
 
-        // RHS is a constant or a select
-        const AstConst* const rconstp = VN_CAST(nodep->rhsp(), Const);
-        const AstNodeSel* const rselp = VN_CAST(nodep->rhsp(), NodeSel);
-        const AstNodeVarRef* rvarrefp = nullptr;
-        uint32_t rindex = lindex;
-        if (rconstp) {  // Ok
-        } else if (rselp) {
-            const AstConst* const rbitp = VN_CAST(rselp->bitp(), Const);
-            rvarrefp = VN_CAST(rselp->fromp(), NodeVarRef);
-            if (!rbitp || !rvarrefp || lvarrefp->varp() == rvarrefp->varp()) {
-                mergeEnd();
-                return;
+        // RHS is a pure expression, with selects of other variables at a constant index
+        AstNodeExpr* const rhsp = nodep->rhsp();
+        if (!rhsp->isPure()) {
+            mergeEnd();
+            return;
+        }
+        std::vector<int64_t> offsets;
+        const bool rhsOk = rhsp->forall([&](const AstNode* np) {
+            if (const AstNodeVarRef* const refp = VN_CAST(np, NodeVarRef)) {
+                // Iterations must be independent
+                return refp->varp() != lvarrefp->varp();
             }
-            rindex = rbitp->toUInt();
-        } else {
+            const AstNodeSel* const rselp = VN_CAST(np, NodeSel);
+            if (!rselp) return true;
+            const AstConst* const rbitp = VN_CAST(rselp->bitp(), Const);
+            if (!rbitp || rbitp->width() > 32 || !VN_IS(rselp->fromp(), NodeVarRef)) return false;
+            offsets.push_back(static_cast<int64_t>(lindex) - rbitp->toUInt());
+            return true;
+        });
+        if (!rhsOk) {
             mergeEnd();
             return;
         }
@@ -199,11 +228,9 @@ class ReloopVisitor final : public VNVisitor {
             if (m_mgCfuncp == m_cfuncp  // In same function
                 && m_mgNextp == nodep  // Consecutive node
                 && m_mgVarrefLp->isSame(lvarrefp)  // Same array on left hand side
-                && (m_mgConstRp  // On the right hand side either ...
-                        ? (rconstp && m_mgConstRp->isSame(rconstp))  // ... same constant
-                        : (rselp && m_mgVarrefRp->isSame(rvarrefp)))  // ... or same array
                 && (lindex == m_mgIndexLo - 1 || lindex == m_mgIndexHi + 1)  // Left index +/- 1
-                && (m_mgConstRp || lindex == rindex + m_mgOffset)  // Same right index offset
+                && offsets == m_mgOffsets  // Same right index offsets
+                && sameExceptIndex(m_mgRhsp, rhsp)  // Same right hand side operations
             ) {
                 // Sequentially next to last assign; continue merge
                 if (lindex == m_mgIndexLo - 1) {
@@ -230,14 +257,12 @@ class ReloopVisitor final : public VNVisitor {
         m_mgCfuncp = m_cfuncp;
         m_mgNextp = nodep->nextp();
         m_mgSelLp = lselp;
-        m_mgSelRp = rselp;
         m_mgVarrefLp = lvarrefp;
-        m_mgVarrefRp = rvarrefp;
-        m_mgOffset = static_cast<int64_t>(lindex) - static_cast<int64_t>(rindex);
-        m_mgConstRp = rconstp;
+        m_mgRhsp = rhsp;
+        m_mgOffsets = std::move(offsets);
         m_mgIndexLo = lindex;
         m_mgIndexHi = lindex;
-        UINFO(9, "Start merge i=" << lindex << " o=" << m_mgOffset << nodep << endl);
+        UINFO(9, "Start merge i=" << lindex << " " << nodep << endl);
     }
     void visit(AstExprStmt* nodep) override { iterateChildren(nodep); }
     //--------------------
@@ -42,6 +42,7 @@
 #include "V3EmitCBase.h"
 #include "V3EmitV.h"
 #include "V3Order.h"
+#include "V3ProfVerilation.h"
 #include "V3SenExprBuilder.h"
 #include "V3Stats.h"
 
@@ -88,6 +89,12 @@ std::vector<const AstSenTree*> getSenTreesUsedBy(const std::vector<const LogicBy
     return result;
 }
 
+// Whether to partition the settling 'ico' and 'act' regions into mtasks
+bool settleParallel() {
+    // Timing resumptions in the 'act' region must stay on the evaluating thread
+    return v3Global.opt.mtasks() && v3Global.opt.threadsSettle() && !v3Global.usesTiming();
+}
+
 void remapSensitivities(const LogicByScope& lbs,
                         std::unordered_map<const AstSenTree*, AstSenTree*> senTreeMap) {
     for (const auto& pair : lbs) {
@@ -167,6 +174,11 @@ AstNodeStmt* profExecSectionPop(FileLine* flp) {
     return new AstCStmt{flp, "VL_EXEC_TRACE_ADD_RECORD(vlSymsp).sectionPop();\n"};
 }
 
+AstNodeStmt* statsRuntimeAdd(FileLine* flp, const string& counter) {
+    return new AstCStmt{flp, "vlSymsp->_vm_contextp__->statsRuntime().add(VerilatedStatsRuntime::"
+                                 + counter + ");\n"};
+}
+
 struct EvalLoop final {
     // Flag set to true during the first iteration of the loop
     AstVarScope* firstIterp;
@@ -196,6 +208,7 @@ EvalLoop createEvalLoop(
 
     // We wrap the prep/cond/work in a function for readability
     AstCFunc* const phaseFuncp = makeTopFunction(netlistp, "_eval_phase__" + tag, slow);
+    phaseFuncp->hot(!slow);
     {
         // The execute flag
         AstVarScope* const executeFlagp = scopeTopp->createTemp(varPrefix + "Execute", 1);
@@ -225,6 +238,10 @@ EvalLoop createEvalLoop(
             new AstCReturn{flp, new AstVarRef{flp, executeFlagp, VAccess::READ}});
     }
 
+    // --stats-runtime counters of this loop, the settle loop is not counted
+    const bool statsRuntime = v3Global.opt.statsRuntime() && !slow;
+    const string statsPrefix = VString::upcase(tag);
+
     // The result statements
     AstNodeStmt* stmtps = nullptr;
 
@@ -254,6 +271,9 @@ EvalLoop createEvalLoop(
         loopp->addStmtsp(checkIterationLimit(netlistp, name, counterp, dumpFuncp));
         // Increment the iteration counter
         loopp->addStmtsp(incrementVar(counterp));
+        if (statsRuntime) loopp->addStmtsp(statsRuntimeAdd(flp, statsPrefix + "_ITERATIONS"));
+        // Prof-exec section push, so the profile shows the iterations per loop
+        if (v3Global.opt.profExec()) loopp->addStmtsp(profExecSectionPush(flp, "iter " + tag));
 
         // Reset continuation flag
         loopp->addStmtsp(setVar(continueFlagp, 0));
@@ -267,10 +287,13 @@ EvalLoop createEvalLoop(
         callp->dtypeSetBit();
         AstIf* const ifp = new AstIf{flp, callp};
         ifp->addThensp(setVar(continueFlagp, 1));
+        if (statsRuntime) ifp->addThensp(statsRuntimeAdd(flp, statsPrefix + "_TRIGGERED"));
         loopp->addStmtsp(ifp);
 
         // Clear the first iteration flag
         loopp->addStmtsp(setVar(firstIterFlagp, 0));
+        // Prof-exec section pop
+        if (v3Global.opt.profExec()) loopp->addStmtsp(profExecSectionPop(flp));
 
         stmtps->addNext(loopp);
     }
@@ -497,15 +520,27 @@ struct TriggerKit final {
 
     // No VL_UNCOPYABLE(TriggerKit) as causes C++20 errors on MSVC
 
-    // Utility that assigns the given index trigger to fire when the given variable is zero
-    void addFirstIterationTriggerAssignment(AstVarScope* flagp, uint32_t index) const {
+    // Utility that assigns the given index trigger to fire when the given variable is zero.
+    // If 'skipp' is given, the trigger does not fire when it is set, and it is then cleared.
+    void addFirstIterationTriggerAssignment(AstVarScope* flagp, uint32_t index,
+                                            AstVarScope* skipp = nullptr) const {
         FileLine* const flp = flagp->fileline();
         AstVarRef* const vrefp = new AstVarRef{flp, m_vscp, VAccess::WRITE};
         AstCMethodHard* const callp = new AstCMethodHard{flp, vrefp, "setBit"};
         callp->addPinsp(new AstConst{flp, index});
-        callp->addPinsp(new AstVarRef{flp, flagp, VAccess::READ});
+        AstNodeExpr* condp = new AstVarRef{flp, flagp, VAccess::READ};
+        if (skipp) {
+            condp = new AstLogAnd{flp, condp,
+                                  new AstLogNot{flp, new AstVarRef{flp, skipp, VAccess::READ}}};
+        }
+        callp->addPinsp(condp);
         callp->dtypeSetVoid();
-        m_funcp->stmtsp()->addHereThisAsNext(callp->makeStmt());
+        AstNode* const stmtp = callp->makeStmt();
+        if (skipp) {
+            stmtp->addNext(new AstAssign{flp, new AstVarRef{flp, skipp, VAccess::WRITE},
+                                         new AstConst{flp, AstConst::BitFalse{}}});
+        }
+        m_funcp->stmtsp()->addHereThisAsNext(stmtp);
     }
 
     // Utility to set then clear an extra trigger
@@ -702,12 +737,20 @@ const TriggerKit createTriggers(AstNetlist* netlistp, AstCFunc* const initFuncp,
     constexpr uint32_t TRIG_VEC_WORD_SIZE = 1 << TRIG_VEC_WORD_SIZE_LOG2;
     std::vector<AstNodeExpr*> trigExprps;
     trigExprps.reserve(TRIG_VEC_WORD_SIZE);
+    // Triggers of variables cutting combinational loops, and the variable's name
+    std::vector<std::pair<uint32_t, std::string>> cutTriggers;
     for (const AstSenItem* const senItemp : senItemps) {
         UASSERT_OBJ(senItemp->isClocked() || senItemp->isHybrid(), senItemp,
                     "Cannot create trigger expression for non-clocked sensitivity");
 
         // Store the trigger number
         senItemIndex2TriggerIndex.push_back(triggerNumber);
+        if (senItemp->isHybrid()) {
+            const AstVarRef* const refp = VN_AS(senItemp->sensp(), VarRef);
+            cutTriggers.emplace_back(triggerNumber, v3Global.opt.protectIds()
+                                                        ? cvtToStr(triggerNumber)
+                                                        : refp->varScopep()->prettyName());
+        }
 
         // Add the trigger computation
         const auto& pair = senExprBuilder.build(senItemp);
@@ -770,6 +813,19 @@ const TriggerKit createTriggers(AstNetlist* netlistp, AstCFunc* const initFuncp,
     }
     trigExprps.clear();
 
+    // Prof-exec empty section for each fired loop cut trigger, so the profile shows how many
+    // iterations each combinational loop needed
+    if (v3Global.opt.profExec()) {
+        for (const auto& pair : cutTriggers) {
+            const std::string name = VString::quoteAny(VString::quoteBackslash(pair.second), '"',
+                                                       '\\');
+            AstIf* const ifp = new AstIf{flp, getTrig(pair.first)};
+            ifp->addThensp(profExecSectionPush(flp, "changed " + name));
+            ifp->addThensp(profExecSectionPop(flp));
+            funcp->addStmtsp(ifp);
+        }
+    }
+
     // Construct the map from old SenTrees to new SenTrees
     for (const AstSenTree* const senTreep : senTreeps) {
         AstSenTree* const trigpSenp = new AstSenTree{flp, nullptr};
@@ -897,18 +953,31 @@ AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
     // Nothing to do if no combinational logic is sensitive to top level inputs
     if (logic.empty()) return nullptr;
 
-    // SystemC only: Any top level inputs feeding a combinational logic must be marked,
-    // so we can make them sc_sensitive
-    if (v3Global.opt.systemC()) {
-        logic.foreachLogic([](AstNode* logicp) {
-            logicp->foreach([](AstVarRef* refp) {
-                if (refp->access().isWriteOnly()) return;
-                AstVarScope* const vscp = refp->varScopep();
-                if (vscp->scopep()->isTop() && vscp->varp()->isNonOutput()) {
-                    vscp->varp()->scSensitive(true);
-                }
-            });
+    // Any top level inputs feeding a combinational logic must be marked, so with SystemC we
+    // can make them sc_sensitive, and with C++ evalClock knows the other clocks need no 'ico'
+    logic.foreachLogic([](AstNode* logicp) {
+        logicp->foreach([](AstVarRef* refp) {
+            if (refp->access().isWriteOnly()) return;
+            AstVarScope* const vscp = refp->varScopep();
+            if (vscp->scopep()->isTop() && vscp->varp()->isNonOutput()) {
+                vscp->varp()->scSensitive(true);
+            }
         });
+    });
+
+    // C++ only: If some clock inputs do not feed the 'ico' logic, make the flag evalClock sets
+    // for those clocks, to not trigger the 'ico' logic on the first iteration
+    AstVarScope* icoSkipVscp = nullptr;
+    if (!v3Global.opt.systemC()) {
+        for (AstVarScope* vscp = netlistp->topScopep()->scopep()->varsp(); vscp;
+             vscp = VN_AS(vscp->nextp(), VarScope)) {
+            const AstVar* const varp = vscp->varp();
+            if (varp->isPrimaryInish() && varp->isUsedClock() && !varp->isScSensitive()) {
+                icoSkipVscp = netlistp->topScopep()->scopep()->createTemp("__VicoSkip", 1);
+                netlistp->icoSkipp(icoSkipVscp->varp());
+                break;
+            }
+        }
     }
 
     // We have some extra trigger denoting external conditions
@@ -921,7 +990,8 @@ AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
                                              : std::numeric_limits<unsigned>::max();
     const size_t firstVifTriggerIndex = extraTriggers.size();
     for (const auto& p : virtIfaceTriggers) {
-        extraTriggers.allocate("virtual interface: " + p.first->name());
+        extraTriggers.allocate("virtual interface: " + p.first.first->name() + "."
+                               + p.first.second);
     }
 
     // Gather the relevant sensitivity expressions and create the trigger kit
@@ -954,7 +1024,7 @@ AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
 
     // Create and Order the body function
     AstCFunc* const icoFuncp
-        = V3Order::order(netlistp, {&logic}, trigToSen, "ico", false, false,
+        = V3Order::order(netlistp, {&logic}, trigToSen, "ico", settleParallel(), false,
                          [=](const AstVarScope* vscp, std::vector<AstSenTree*>& out) {
                              AstVar* const varp = vscp->varp();
                              if (varp->isPrimaryInish() || varp->isSigUserRWPublic()) {
@@ -962,7 +1032,8 @@ AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
                              }
                              if (varp->isWrittenByDpi()) out.push_back(dpiExportTriggered);
                              if (vscp->varp()->sensIfacep()) {
-                                 const auto it = vifTriggered.find(vscp->varp()->sensIfacep());
+                                 const auto it
+                                     = vifTriggered.find(VirtIfaceTriggers::ifaceMember(vscp));
                                  if (it != vifTriggered.end()) out.push_back(it->second);
                              }
                          });
@@ -979,7 +1050,8 @@ AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
         callVoidFunc(icoFuncp));
 
     // Add the first iteration trigger to the trigger computation function
-    trig.addFirstIterationTriggerAssignment(icoLoop.firstIterp, firstIterationTrigger);
+    trig.addFirstIterationTriggerAssignment(icoLoop.firstIterp, firstIterationTrigger,
+                                            icoSkipVscp);
 
     return icoLoop.stmtsp;
 }
@@ -1055,6 +1127,9 @@ void createEval(AstNetlist* netlistp,  //
             // Resume triggered timing schedulers
             if (AstCCall* const resumep = timingKit.createResume(netlistp)) {
                 workp->addNext(resumep->makeStmt());
+                if (v3Global.opt.statsRuntime()) {
+                    workp->addNext(statsRuntimeAdd(flp, "TIMING_RESUMES"));
+                }
             }
             // Invoke the 'act' function
             workp->addNext(callVoidFunc(actKit.m_funcp));
@@ -1103,6 +1178,9 @@ void createEval(AstNetlist* netlistp,  //
                 = new AstCMethodHard{flp, new AstVarRef{flp, nbaEventp, VAccess::WRITE}, "fire"};
             firep->dtypeSetVoid();
             ifp->addThensp(firep->makeStmt());
+            if (v3Global.opt.statsRuntime()) {
+                ifp->addThensp(statsRuntimeAdd(flp, "NBA_COMMITS"));
+            }
             return ifp;
         });
 
@@ -1150,9 +1228,11 @@ void createEval(AstNetlist* netlistp,  //
 
     // Now that we have build the loops, create the main 'eval' function
     AstCFunc* const funcp = makeTopFunction(netlistp, "_eval", false);
+    funcp->hot(true);
     netlistp->evalp(funcp);
 
     if (v3Global.opt.profExec()) funcp->addStmtsp(profExecSectionPush(flp, "eval"));
+    if (v3Global.opt.statsRuntime()) funcp->addStmtsp(statsRuntimeAdd(flp, "EVALS"));
 
     // Start with the ico loop, if any
     if (icoLoop) funcp->addStmtsp(icoLoop);
@@ -1166,6 +1246,90 @@ void createEval(AstNetlist* netlistp,  //
     if (v3Global.opt.profExec()) funcp->addStmtsp(profExecSectionPop(flp));
 }
 
+//============================================================================
+// Cycle-based evaluation for --cycle-mode
+
+// Check the design only has logic clocked by a single edge of a single clock input, and no
+// logic needing the convergence loops, so 'act' has that edge as its only trigger.
+// Reports an error and returns false otherwise.
+bool checkCycleMode(AstNetlist* netlistp, const LogicClasses& logicClasses,
+                    const LogicReplicas& logicReplicas, const TimingKit& timingKit,
+                    const std::vector<const AstSenTree*>& senTreeps, bool hasExtraTriggers) {
+    const auto error = [](AstNode* nodep, const string& reason) {
+        nodep->v3error("Design not supported by --cycle-mode: " << reason);
+        return false;
+    };
+    if (!logicClasses.m_hybrid.empty()) {
+        return error(logicClasses.m_hybrid.front().second, "Combinational loop");
+    }
+    if (!logicReplicas.m_ico.empty()) {
+        return error(logicReplicas.m_ico.front().second,
+                     "Input feeds combinational logic, so must be evaluated when it changes");
+    }
+    if (!logicClasses.m_observed.empty()) {
+        return error(logicClasses.m_observed.front().second, "Logic in the Observed region");
+    }
+    if (!logicClasses.m_reactive.empty()) {
+        return error(logicClasses.m_reactive.front().second, "Logic in the Reactive region");
+    }
+    if (!timingKit.m_lbs.empty() || netlistp->nbaEventp()) {
+        return error(netlistp, "Timing controls or dynamic non-blocking assignments");
+    }
+    if (hasExtraTriggers) {
+        return error(netlistp, "Variables written by DPI exports or via virtual interfaces");
+    }
+    const AstSenItem* clockp = nullptr;
+    for (const AstSenTree* const senTreep : senTreeps) {
+        for (AstSenItem* itemp = senTreep->sensesp(); itemp;
+             itemp = VN_AS(itemp->nextp(), SenItem)) {
+            const AstNodeVarRef* const refp = itemp->varrefp();
+            if (!refp || !refp->varp()->isPrimaryInish()
+                || (itemp->edgeType() != VEdgeType::ET_POSEDGE
+                    && itemp->edgeType() != VEdgeType::ET_NEGEDGE)) {
+                return error(itemp, "Sensitivity other than an edge of a clock input");
+            }
+            if (!clockp) {
+                clockp = itemp;
+            } else if (!clockp->sameTree(itemp)) {
+                return error(itemp, "Sensitivity to more than one edge or clock input");
+            }
+        }
+    }
+    if (!clockp) return error(netlistp, "No clocked logic");
+    return true;
+}
+
+// Create the '_eval_tick' function, evaluating the single 'act' trigger of --cycle-mode as
+// one pass of what '_eval' would do on that clock edge, without computing the triggers
+void createTick(AstNetlist* netlistp, const EvalKit& actKit, AstVarScope* preTrigsp,
+                const EvalKit& nbaKit, AstCFunc* postponedFuncp) {
+    FileLine* const flp = netlistp->fileline();
+    AstCFunc* const funcp = makeTopFunction(netlistp, "_eval_tick", false);
+    funcp->hot(true);
+
+    if (v3Global.opt.profExec()) funcp->addStmtsp(profExecSectionPush(flp, "tick"));
+    if (v3Global.opt.statsRuntime()) funcp->addStmtsp(statsRuntimeAdd(flp, "EVALS"));
+
+    // Fire the clock edge trigger
+    AstCMethodHard* const setp
+        = new AstCMethodHard{flp, new AstVarRef{flp, actKit.m_vscp, VAccess::WRITE}, "setBit"};
+    setp->addPinsp(new AstConst{flp, 0});
+    setp->addPinsp(new AstConst{flp, AstConst::BitTrue{}});
+    setp->dtypeSetVoid();
+    funcp->addStmtsp(setp->makeStmt());
+    // As in the 'act' loop's work, then the 'nba' loop's work, each once
+    funcp->addStmtsp(createTriggerAndNotCall(flp, preTrigsp, actKit.m_vscp, nbaKit.m_vscp));
+    funcp->addStmtsp(createTriggerSetCall(flp, nbaKit.m_vscp, actKit.m_vscp));
+    funcp->addStmtsp(callVoidFunc(actKit.m_funcp));
+    funcp->addStmtsp(createTriggerClearCall(flp, actKit.m_vscp));
+    funcp->addStmtsp(callVoidFunc(nbaKit.m_funcp));
+    funcp->addStmtsp(createTriggerClearCall(flp, nbaKit.m_vscp));
+
+    if (postponedFuncp) funcp->addStmtsp(callVoidFunc(postponedFuncp));
+
+    if (v3Global.opt.profExec()) funcp->addStmtsp(profExecSectionPop(flp));
+}
+
 }  // namespace
 
 //============================================================================
@@ -1174,7 +1338,7 @@ void createEval(AstNetlist* netlistp,  //
 VirtIfaceTriggers::IfaceSensMap
 VirtIfaceTriggers::makeIfaceToSensMap(AstNetlist* const netlistp, size_t vifTriggerIndex,
                                       AstVarScope* trigVscp) const {
-    std::map<const AstIface*, AstSenTree*> ifaceToSensMap;
+    IfaceSensMap ifaceToSensMap;
     for (const auto& p : *this) {
         ifaceToSensMap.emplace(
             std::make_pair(p.first, createTriggerSenTree(netlistp, trigVscp, vifTriggerIndex)));
@@ -1202,6 +1366,7 @@ void schedule(AstNetlist* netlistp) {
     // Step 1. Gather and classify all logic in the design
     LogicClasses logicClasses = gatherLogicClasses(netlistp);
 
+    V3ProfVerilation::subPassEnd("sched-gather");
     if (v3Global.opt.stats()) {
         V3Stats::statsStage("sched-gather");
         addSizeStat("size of class: static", logicClasses.m_static);
@@ -1211,17 +1376,21 @@ void schedule(AstNetlist* netlistp) {
 
     // Step 2. Schedule static, initial and final logic classes in source order
     AstCFunc* const staticp = createStatic(netlistp, logicClasses);
+    V3ProfVerilation::subPassEnd("sched-static");
     if (v3Global.opt.stats()) V3Stats::statsStage("sched-static");
 
     createInitial(netlistp, logicClasses);
+    V3ProfVerilation::subPassEnd("sched-initial");
     if (v3Global.opt.stats()) V3Stats::statsStage("sched-initial");
 
     createFinal(netlistp, logicClasses);
+    V3ProfVerilation::subPassEnd("sched-final");
     if (v3Global.opt.stats()) V3Stats::statsStage("sched-final");
 
     // Step 3: Break combinational cycles by introducing hybrid logic
     // Note: breakCycles also removes corresponding logic from logicClasses.m_comb;
     logicClasses.m_hybrid = breakCycles(netlistp, logicClasses.m_comb);
+    V3ProfVerilation::subPassEnd("sched-break-cycles");
     if (v3Global.opt.stats()) {
         addSizeStat("size of class: clocked", logicClasses.m_clocked);
         addSizeStat("size of class: combinational", logicClasses.m_comb);
@@ -1237,6 +1406,7 @@ void schedule(AstNetlist* netlistp) {
 
     // Step 4: Create 'settle' region that restores the combinational invariant
     createSettle(netlistp, staticp, senExprBuilder, logicClasses);
+    V3ProfVerilation::subPassEnd("sched-settle");
     if (v3Global.opt.stats()) V3Stats::statsStage("sched-settle");
 
     // Step 5: Partition the clocked and combinational (including hybrid) logic into pre/act/nba.
@@ -1246,6 +1416,7 @@ void schedule(AstNetlist* netlistp) {
         = partition(logicClasses.m_clocked, logicClasses.m_comb, logicClasses.m_hybrid);
     logicRegions.m_obs = logicClasses.m_observed;
     logicRegions.m_react = logicClasses.m_reactive;
+    V3ProfVerilation::subPassEnd("sched-partition");
     if (v3Global.opt.stats()) {
         addSizeStat("size of region: Active Pre", logicRegions.m_pre);
         addSizeStat("size of region: Active", logicRegions.m_act);
@@ -1257,6 +1428,7 @@ void schedule(AstNetlist* netlistp) {
 
     // Step 6: Replicate combinational logic
     LogicReplicas logicReplicas = replicateLogic(logicRegions);
+    V3ProfVerilation::subPassEnd("sched-replicate");
     if (v3Global.opt.stats()) {
         addSizeStat("size of replicated logic: Input", logicReplicas.m_ico);
         addSizeStat("size of replicated logic: Active", logicReplicas.m_act);
@@ -1269,6 +1441,7 @@ void schedule(AstNetlist* netlistp) {
     // Step 7: Create input combinational logic loop
     AstNode* const icoLoopp = createInputCombLoop(netlistp, staticp, senExprBuilder,
                                                   logicReplicas.m_ico, virtIfaceTriggers);
+    V3ProfVerilation::subPassEnd("sched-create-ico");
     if (v3Global.opt.stats()) V3Stats::statsStage("sched-create-ico");
 
     // Step 8: Create the pre/act/nba triggers
@@ -1281,7 +1454,8 @@ void schedule(AstNetlist* netlistp) {
                                              : std::numeric_limits<unsigned>::max();
     const size_t firstVifTriggerIndex = extraTriggers.size();
     for (const auto& p : virtIfaceTriggers) {
-        extraTriggers.allocate("virtual interface: " + p.first->name());
+        extraTriggers.allocate("virtual interface: " + p.first.first->name() + "."
+                               + p.first.second);
     }
 
     const auto& senTreeps = getSenTreesUsedBy({&logicRegions.m_pre,  //
@@ -1290,6 +1464,12 @@ void schedule(AstNetlist* netlistp) {
                                                &logicRegions.m_obs,  //
                                                &logicRegions.m_react,  //
                                                &timingKit.m_lbs});
+    // With --cycle-mode, check the design fits the cycle-based subset
+    const bool cycleMode
+        = v3Global.opt.cycleMode()
+          && checkCycleMode(netlistp, logicClasses, logicReplicas, timingKit, senTreeps,
+                            extraTriggers.size() != 0);
+
     const TriggerKit& actTrig
         = createTriggers(netlistp, staticp, senExprBuilder, senTreeps, "act", extraTriggers);
 
@@ -1324,6 +1504,7 @@ void schedule(AstNetlist* netlistp) {
 
     const auto& actTrigMap = actTrig.m_map;
     const auto preTrigMap = cloneMapWithNewTriggerReferences(actTrigMap, preTrigVscp);
+    V3ProfVerilation::subPassEnd("sched-create-triggers");
     if (v3Global.opt.stats()) V3Stats::statsStage("sched-create-triggers");
 
     // Note: Experiments so far show that running the Act (or Ico) regions on
@@ -1356,16 +1537,18 @@ void schedule(AstNetlist* netlistp) {
 
     AstCFunc* const actFuncp = V3Order::order(
         netlistp, {&logicRegions.m_pre, &logicRegions.m_act, &logicReplicas.m_act}, trigToSenAct,
-        "act", false, false, [&](const AstVarScope* vscp, std::vector<AstSenTree*>& out) {
+        "act", settleParallel(), false,
+        [&](const AstVarScope* vscp, std::vector<AstSenTree*>& out) {
             auto it = actTimingDomains.find(vscp);
             if (it != actTimingDomains.end()) out = it->second;
             if (vscp->varp()->isWrittenByDpi()) out.push_back(dpiExportTriggeredAct);
             if (vscp->varp()->sensIfacep()) {
-                const auto sit = vifTriggeredAct.find(vscp->varp()->sensIfacep());
+                const auto sit = vifTriggeredAct.find(VirtIfaceTriggers::ifaceMember(vscp));
                 if (sit != vifTriggeredAct.end()) out.push_back(sit->second);
             }
         });
     splitCheck(actFuncp);
+    V3ProfVerilation::subPassEnd("sched-create-act");
     if (v3Global.opt.stats()) V3Stats::statsStage("sched-create-act");
 
     const EvalKit& actKit = {actTrig.m_vscp, actTrig.m_funcp, actTrig.m_dumpp, actFuncp};
@@ -1399,7 +1582,7 @@ void schedule(AstNetlist* netlistp) {
                 if (it != timingDomains.end()) out = it->second;
                 if (vscp->varp()->isWrittenByDpi()) out.push_back(dpiExportTriggered);
                 if (vscp->varp()->sensIfacep()) {
-                    const auto sit = vifTriggered.find(vscp->varp()->sensIfacep());
+                    const auto sit = vifTriggered.find(VirtIfaceTriggers::ifaceMember(vscp));
                     if (sit != vifTriggered.end()) out.push_back(sit->second);
                 }
             });
@@ -1427,6 +1610,7 @@ void schedule(AstNetlist* netlistp) {
     const EvalKit& nbaKit = order("nba", {&logicRegions.m_nba, &logicReplicas.m_nba});
     splitCheck(nbaKit.m_funcp);
     netlistp->evalNbap(nbaKit.m_funcp);  // Remember for V3LifePost
+    V3ProfVerilation::subPassEnd("sched-create-nba");
     if (v3Global.opt.stats()) V3Stats::statsStage("sched-create-nba");
 
     // Orders a region's logic and creates the region eval function (only if there is any logic in
@@ -1454,6 +1638,9 @@ void schedule(AstNetlist* netlistp) {
     createEval(netlistp, icoLoopp, actKit, preTrigVscp, nbaKit, obsKit, reactKit, postponedFuncp,
                timingKit);
 
+    // Step 15: With --cycle-mode, create the '_eval_tick' function
+    if (cycleMode) createTick(netlistp, actKit, preTrigVscp, nbaKit, postponedFuncp);
+
     transformForks(netlistp);
 
     splitCheck(staticp);
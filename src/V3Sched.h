@@ -153,12 +153,21 @@ public:
 };
 
 class VirtIfaceTriggers final {
-    using IfaceTrigger = std::pair<const AstIface*, AstVarScope*>;
+public:
+    // Interface type and name of its member written via virtual interface
+    using IfaceMember = std::pair<const AstIface*, std::string>;
+
+private:
+    using IfaceTrigger = std::pair<IfaceMember, AstVarScope*>;
     using IfaceTriggerVec = std::vector<IfaceTrigger>;
-    using IfaceSensMap = std::map<const AstIface*, AstSenTree*>;
+    using IfaceSensMap = std::map<IfaceMember, AstSenTree*>;
     IfaceTriggerVec m_triggers;
 
 public:
+    // Returns the interface member whose trigger 'vscp' is sensitive to
+    static IfaceMember ifaceMember(const AstVarScope* vscp) {
+        return {vscp->varp()->sensIfacep(), vscp->varp()->name()};
+    }
     void emplace_back(IfaceTrigger&& p) { m_triggers.emplace_back(std::move(p)); }
     IfaceTriggerVec::const_iterator begin() const { return m_triggers.begin(); }
     IfaceTriggerVec::const_iterator end() const { return m_triggers.end(); }
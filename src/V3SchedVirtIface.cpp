@@ -16,9 +16,9 @@
 //*************************************************************************
 // V3SchedVirtIface's Transformations:
 //
-// Each interface type written to via virtual interface, or written to normally but read via
+// Each interface member written to via virtual interface, or written to normally but read via
 // virtual interface:
-//     Create a trigger var for it
+//     Create a trigger var for it, so only logic reading that member is triggered
 // Each AssignW, AssignPost:
 //     If it writes to a virtual interface, or to a variable read via virtual interface:
 //         Convert to an always
@@ -43,21 +43,19 @@ namespace {
 
 class VirtIfaceVisitor final : public VNVisitor {
 private:
-    // NODE STATE
-    // AstIface::user1() -> AstVarScope*. Trigger var for this interface
-    const VNUser1InUse m_user1InUse;
-
     // TYPES
-    using OnWriteToVirtIface = std::function<void(AstVarRef*, AstIface*)>;
+    using IfaceMember = VirtIfaceTriggers::IfaceMember;
+    using OnWriteToVirtIface = std::function<void(AstVarRef*, const IfaceMember&)>;
 
     // STATE
     AstNetlist* const m_netlistp;  // Root node
     AstAssign* m_trigAssignp = nullptr;  // Previous/current trigger assignment
-    AstIface* m_trigAssignIfacep = nullptr;  // Interface type whose trigger is assigned
-                                             // by m_trigAssignp
+    IfaceMember m_trigAssignMember;  // Interface member whose trigger is assigned
+                                     // by m_trigAssignp
     V3UniqueNames m_vifTriggerNames{"__VvifTrigger"};  // Unique names for virt iface
                                                        // triggers
-    VirtIfaceTriggers m_triggers;  // Interfaces and corresponding trigger vars
+    std::map<IfaceMember, AstVarScope*> m_memberTriggers;  // Trigger var for each member
+    VirtIfaceTriggers m_triggers;  // Interface members and corresponding trigger vars
 
     // METHODS
     // For each write across a virtual interface boundary
@@ -65,11 +63,12 @@ private:
         nodep->foreach([&](AstVarRef* const refp) {
             if (refp->access().isReadOnly()) return;
             if (AstIfaceRefDType* const dtypep = VN_CAST(refp->varp()->dtypep(), IfaceRefDType)) {
-                if (dtypep->isVirtual() && VN_IS(refp->firstAbovep(), MemberSel)) {
-                    onWrite(refp, dtypep->ifacep());
+                if (!dtypep->isVirtual()) return;
+                if (const AstMemberSel* const selp = VN_CAST(refp->firstAbovep(), MemberSel)) {
+                    onWrite(refp, {dtypep->ifacep(), selp->varp()->name()});
                 }
             } else if (AstIface* const ifacep = refp->varp()->sensIfacep()) {
-                onWrite(refp, ifacep);
+                onWrite(refp, {ifacep, refp->varp()->name()});
             }
         });
     }
@@ -87,35 +86,37 @@ private:
     // Error on write across a virtual interface boundary
     static void unsupportedWriteToVirtIface(AstNode* nodep, const char* locationp) {
         if (!nodep) return;
-        foreachWrittenVirtIface(nodep, [locationp](AstVarRef* const selp, AstIface*) {
+        foreachWrittenVirtIface(nodep, [locationp](AstVarRef* const selp, const IfaceMember&) {
             selp->v3warn(E_UNSUPPORTED,
                          "Unsupported: write to virtual interface in " << locationp);
         });
     }
-    // Create trigger var for the given interface if it doesn't exist; return a write ref to it
-    AstVarRef* createVirtIfaceTriggerRefp(FileLine* const flp, AstIface* ifacep) {
-        if (!ifacep->user1()) {
+    // Create trigger var for the given interface member if it doesn't exist; return a write ref
+    // to it
+    AstVarRef* createVirtIfaceTriggerRefp(FileLine* const flp, const IfaceMember& member) {
+        AstVarScope*& vscpr = m_memberTriggers[member];
+        if (!vscpr) {
             AstScope* const scopeTopp = m_netlistp->topScopep()->scopep();
-            AstVarScope* const vscp = scopeTopp->createTemp(m_vifTriggerNames.get(ifacep), 1);
-            ifacep->user1p(vscp);
-            m_triggers.emplace_back(std::make_pair(ifacep, vscp));
+            vscpr = scopeTopp->createTemp(
+                m_vifTriggerNames.get(member.first->name() + "__" + member.second), 1);
+            m_triggers.emplace_back(std::make_pair(member, vscpr));
         }
-        return new AstVarRef{flp, VN_AS(ifacep->user1p(), VarScope), VAccess::WRITE};
+        return new AstVarRef{flp, vscpr, VAccess::WRITE};
     }
 
     // VISITORS
     void visit(AstNodeProcedure* nodep) override {
         VL_RESTORER(m_trigAssignp);
         m_trigAssignp = nullptr;
-        VL_RESTORER(m_trigAssignIfacep);
-        m_trigAssignIfacep = nullptr;
+        VL_RESTORER(m_trigAssignMember);
+        m_trigAssignMember = {};
         iterateChildren(nodep);
     }
     void visit(AstCFunc* nodep) override {
         VL_RESTORER(m_trigAssignp);
         m_trigAssignp = nullptr;
-        VL_RESTORER(m_trigAssignIfacep);
-        m_trigAssignIfacep = nullptr;
+        VL_RESTORER(m_trigAssignMember);
+        m_trigAssignMember = {};
         iterateChildren(nodep);
     }
     void visit(AstAssignW* nodep) override {
@@ -139,19 +140,19 @@ private:
         unsupportedWriteToVirtIface(nodep->condp(), "if condition");
         {
             VL_RESTORER(m_trigAssignp);
-            VL_RESTORER(m_trigAssignIfacep);
+            VL_RESTORER(m_trigAssignMember);
             iterateAndNextNull(nodep->thensp());
         }
         {
             VL_RESTORER(m_trigAssignp);
-            VL_RESTORER(m_trigAssignIfacep);
+            VL_RESTORER(m_trigAssignMember);
             iterateAndNextNull(nodep->elsesp());
         }
         if (v3Global.usesTiming()) {
             // Clear the trigger assignment, as there could have been timing controls in either
             // branch
             m_trigAssignp = nullptr;
-            m_trigAssignIfacep = nullptr;
+            m_trigAssignMember = {};
         }
     }
     void visit(AstWhile* nodep) override {
@@ -160,45 +161,45 @@ private:
         unsupportedWriteToVirtIface(nodep->incsp(), "loop increment statement");
         {
             VL_RESTORER(m_trigAssignp);
-            VL_RESTORER(m_trigAssignIfacep);
+            VL_RESTORER(m_trigAssignMember);
             iterateAndNextNull(nodep->stmtsp());
         }
         if (v3Global.usesTiming()) {
             // Clear the trigger assignment, as there could have been timing controls in the loop
             m_trigAssignp = nullptr;
-            m_trigAssignIfacep = nullptr;
+            m_trigAssignMember = {};
         }
     }
     void visit(AstJumpBlock* nodep) override {
         {
             VL_RESTORER(m_trigAssignp);
-            VL_RESTORER(m_trigAssignIfacep);
+            VL_RESTORER(m_trigAssignMember);
             iterateChildren(nodep);
         }
         if (v3Global.usesTiming()) {
             // Clear the trigger assignment, as there could have been timing controls in the jump
             // block
             m_trigAssignp = nullptr;
-            m_trigAssignIfacep = nullptr;
+            m_trigAssignMember = {};
         }
     }
     void visit(AstNodeStmt* nodep) override {
         if (v3Global.usesTiming()
             && nodep->exists([](AstNode* nodep) { return nodep->isTimingControl(); })) {
             m_trigAssignp = nullptr;  // Could be after a delay - need new trigger assignment
-            m_trigAssignIfacep = nullptr;
+            m_trigAssignMember = {};
             // No restorer, as following statements should not reuse the old assignment
         }
         FileLine* const flp = nodep->fileline();
-        foreachWrittenVirtIface(nodep, [&](AstVarRef*, AstIface* ifacep) {
-            if (ifacep != m_trigAssignIfacep) {
-                // Write to different interface type than before - need new trigger assignment
+        foreachWrittenVirtIface(nodep, [&](AstVarRef*, const IfaceMember& member) {
+            if (member != m_trigAssignMember) {
+                // Write to different interface member than before - need new trigger assignment
                 // No restorer, as following statements should not reuse the old assignment
-                m_trigAssignIfacep = ifacep;
+                m_trigAssignMember = member;
                 m_trigAssignp = nullptr;
             }
             if (!m_trigAssignp) {
-                m_trigAssignp = new AstAssign{flp, createVirtIfaceTriggerRefp(flp, ifacep),
+                m_trigAssignp = new AstAssign{flp, createVirtIfaceTriggerRefp(flp, member),
                                               new AstConst{flp, AstConst::BitTrue{}}};
                 nodep->addNextHere(m_trigAssignp);
             }
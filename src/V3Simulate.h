@@ -38,6 +38,7 @@
 #include "V3Ast.h"
 #include "V3AstUserAllocator.h"
 #include "V3Error.h"
+#include "V3Hasher.h"
 #include "V3Task.h"
 #include "V3Width.h"
 
@@ -46,6 +47,7 @@
 #include <stack>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 //============================================================================
@@ -65,6 +67,66 @@ public:
     ~SimStackNode() = default;
 };
 
+//============================================================================
+// Results of constant functions shared between SimulateVisitors, so the same
+// function in every specialization of a parameterized module is only evaluated
+// once per argument values. Only functions referring to nothing but their own
+// variables are shared. Functions are matched by hash and compared with
+// sameTree against a private clone, so deleted or edited functions never match.
+// Active while an instance exists, see V3Param.
+
+class SimulateFuncCache final {
+public:
+    using Results = std::unordered_map<string, V3Number>;  // Result by argument values
+
+private:
+    struct Entry final {
+        AstNodeFTask* const m_funcp;  // Clone of the function
+        Results m_results;  // Results of calls
+        explicit Entry(AstNodeFTask* funcp)
+            : m_funcp{funcp} {}
+    };
+    std::unordered_multimap<uint32_t, Entry> m_entries;  // Entries by function hash
+
+    static SimulateFuncCache*& currentp() {
+        static SimulateFuncCache* s_cachep = nullptr;
+        return s_cachep;
+    }
+    static bool shareable(const AstNodeFTask* funcp) {
+        std::unordered_set<const AstVar*> localps;
+        funcp->foreach([&](const AstVar* varp) { localps.emplace(varp); });
+        return !funcp->exists([&](const AstNode* nodep) {
+            if (VN_IS(nodep, NodeFTaskRef) || VN_IS(nodep, VarXRef)) return true;
+            const AstNodeVarRef* const refp = VN_CAST(nodep, NodeVarRef);
+            return refp && !localps.count(refp->varp());
+        });
+    }
+
+public:
+    SimulateFuncCache() {
+        UASSERT(!currentp(), "Only one SimulateFuncCache may be active");
+        currentp() = this;
+    }
+    ~SimulateFuncCache() {
+        for (auto& pair : m_entries) VL_DO_DANGLING(pair.second.m_funcp->deleteTree(), pair);
+        currentp() = nullptr;
+    }
+    VL_UNCOPYABLE(SimulateFuncCache);
+
+    // Results of calls to the given function, or nullptr if none active or not shareable
+    static Results* resultsp(AstNodeFTask* funcp) {
+        SimulateFuncCache* const cachep = currentp();
+        if (!cachep || !shareable(funcp)) return nullptr;
+        const uint32_t hash = V3Hasher::uncachedHash(funcp).value();
+        const auto range = cachep->m_entries.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.m_funcp->sameTree(funcp)) return &it->second.m_results;
+        }
+        AstNodeFTask* const clonep = funcp->cloneTree(false);
+        return &cachep->m_entries.emplace(hash, Entry{clonep})->second.m_results;
+    }
+};
+
 class SimulateVisitor VL_NOT_FINAL : public VNVisitorConst {
     // Simulate a node tree, returning value of variables
     // Two major operating modes:
@@ -142,6 +204,13 @@ private:
     std::unordered_map<const AstNodeDType*, ConstAllocator> m_constps;
     size_t m_constGeneration = 0;
     std::vector<SimStackNode*> m_callStack;  ///< Call stack for verbose error messages
+    // Results of earlier constant function calls, by function and argument values
+    std::unordered_map<const AstNodeFTask*, SimulateFuncCache::Results> m_funcResults;
+    // Shared results of functions, from SimulateFuncCache
+    std::unordered_map<const AstNodeFTask*, SimulateFuncCache::Results*> m_funcSharedps;
+    // Whether a function's result depends only on its arguments, so may be memoized
+    std::unordered_map<const AstNodeFTask*, bool> m_funcMemoizable;
+    size_t m_displayCount = 0;  ///< Number of $displays executed, these prevent memoizing
 
     // Cleanup
     // V3Numbers that represents strings are a bit special and the API for
@@ -398,6 +467,25 @@ private:
         UASSERT_OBJ(vscp, nodep, "Not linked");
         return vscp;
     }
+    bool funcMemoizable(const AstNodeFTask* funcp) {
+        // True if the function only reads its own variables and parameters
+        const auto pair = m_funcMemoizable.emplace(funcp, false);
+        if (!pair.second) return pair.first->second;
+        std::unordered_set<const AstVar*> localps;
+        funcp->foreach([&](const AstVar* varp) { localps.emplace(varp); });
+        bool memoizable = !funcp->exists([](const AstVarXRef*) { return true; });
+        funcp->foreach([&](const AstNodeVarRef* refp) {
+            if (!refp->varp() || (!localps.count(refp->varp()) && !refp->varp()->isParam())) {
+                memoizable = false;
+            }
+        });
+        funcp->foreach([&](const AstFuncRef* refp) {
+            if (memoizable && refp->taskp() != funcp) memoizable = funcMemoizable(refp->taskp());
+        });
+        // Look up again, as the recursion may have rehashed the map
+        m_funcMemoizable[funcp] = memoizable;
+        return memoizable;
+    }
     bool jumpingOver(const AstNode* nodep) const {
         // True to jump over this node - all visitors must call this up front
         return (m_jumpp && m_jumpp->labelp() != nodep);
@@ -1070,6 +1158,32 @@ private:
                 iterateConst(pinp);
             }
         }
+        // Reuse the result of an earlier call with the same argument values
+        string argsKey;
+        bool memoize = !m_checkOnly && optimizable() && funcMemoizable(funcp);
+        for (V3TaskConnects::iterator it = tconnects.begin(); memoize && it != tconnects.end();
+             ++it) {
+            AstNode* const pinp = it->second->exprp();
+            const AstConst* const constp = pinp ? fetchConstNull(pinp) : nullptr;
+            if (!constp) {
+                memoize = false;
+            } else {
+                argsKey += constp->num().ascii() + ",";
+            }
+        }
+        SimulateFuncCache::Results* resultsp = nullptr;
+        if (memoize) {
+            const auto pair = m_funcSharedps.emplace(funcp, nullptr);
+            if (pair.second) pair.first->second = SimulateFuncCache::resultsp(funcp);
+            resultsp = pair.first->second ? pair.first->second : &m_funcResults[funcp];
+            const auto it = resultsp->find(argsKey);
+            if (it != resultsp->end()) {
+                UINFO(9, "     memoized result of " << funcp << endl);
+                newConst(nodep)->num().opAssign(it->second);
+                return;
+            }
+        }
+        const size_t displayCount = m_displayCount;
         for (V3TaskConnects::iterator it = tconnects.begin(); it != tconnects.end(); ++it) {
             AstVar* const portp = it->first;
             AstNode* const pinp = it->second->exprp();
@@ -1099,6 +1213,11 @@ private:
             // Grab return value from output variable (if it's a function)
             UASSERT_OBJ(funcp->fvarp(), nodep, "Function reference points at non-function");
             newValue(nodep, fetchValue(funcp->fvarp()));
+            if (memoize && m_displayCount == displayCount) {
+                if (const AstConst* const constp = fetchConstNull(nodep)) {
+                    resultsp->emplace(argsKey, constp->num());
+                }
+            }
         }
     }
 
@@ -1184,6 +1303,7 @@ private:
         checkNodeInfo(nodep, /*display:*/ true);
         iterateChildrenConst(nodep);
         if (m_params) {
+            ++m_displayCount;
             AstConst* const textp = fetchConst(nodep->fmtp());
             switch (nodep->displayType()) {
             case VDisplayType::DT_DISPLAY:  // FALLTHRU
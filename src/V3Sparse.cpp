@@ -0,0 +1,125 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Paged storage for huge unpacked arrays
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2003-2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// V3Sparse's Transformations:
+//
+// For each unpacked array variable of packed elements, of at least
+// --sparse-array-limit bytes:
+//    If every reference selects an element, is a $readmem/$writemem or
+//    resets the variable, the array is never used as a whole, so change
+//    the variable to a sparse dtype, which is emitted as a
+//    VlSparseUnpacked allocating pages only when they are accessed.
+//
+//*************************************************************************
+
+#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+
+#include "V3Sparse.h"
+
+#include "V3Stats.h"
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+
+class SparseVisitor final : public VNVisitor {
+    // NODE STATE
+    //  AstVar::user1()                 -> bool. Used as a whole array
+    //  AstUnpackArrayDType::user2p()   -> AstUnpackArrayDType*. Sparse copy of this dtype
+    const VNUser1InUse m_inuser1;
+    const VNUser2InUse m_inuser2;
+
+    // STATE
+    const uint64_t m_limit = v3Global.opt.sparseArrayLimit();  // Minimum bytes
+    std::vector<AstVar*> m_varps;  // Candidate variables
+    std::vector<AstNodeVarRef*> m_refps;  // References to candidate variables
+    VDouble0 m_statSparse;  // Statistic tracking
+
+    // METHODS
+    AstUnpackArrayDType* candidateDTypep(const AstVar* varp) const {
+        AstUnpackArrayDType* const adtypep = VN_CAST(varp->dtypeSkipRefp(), UnpackArrayDType);
+        if (!adtypep || adtypep->isSparse() || adtypep->isCompound()) return nullptr;
+        if (varp->isIO() || varp->isSigPublic() || varp->isDpiOpenArray()) return nullptr;
+        if (varp->isParam() || varp->isConst()) return nullptr;
+        const AstNodeDType* const subp = adtypep->subDTypep()->skipRefp();
+        if (!subp->isIntegralOrPacked()) return nullptr;
+        const uint64_t bytes = static_cast<uint64_t>(adtypep->elementsConst())
+                               * static_cast<uint64_t>(subp->widthTotalBytes());
+        if (bytes < m_limit) return nullptr;
+        return adtypep;
+    }
+    static bool isElementUse(const AstNodeVarRef* refp) {
+        if (const AstArraySel* const selp = VN_CAST(refp->backp(), ArraySel)) {
+            return selp->fromp() == refp;
+        }
+        // $readmem/$writemem have an overload for sparse arrays
+        if (const AstNodeReadWriteMem* const memp = VN_CAST(refp->backp(), NodeReadWriteMem)) {
+            return memp->memp() == refp;
+        }
+        return VN_IS(refp->backp(), CReset);
+    }
+    AstUnpackArrayDType* sparseDTypep(AstUnpackArrayDType* dtypep) {
+        if (!dtypep->user2p()) {
+            AstUnpackArrayDType* const newp = new AstUnpackArrayDType{
+                dtypep->fileline(), dtypep->subDTypep(), dtypep->rangep()->cloneTree(false)};
+            newp->isSparse(true);
+            v3Global.rootp()->typeTablep()->addTypesp(newp);
+            dtypep->user2p(newp);
+        }
+        return VN_AS(dtypep->user2p(), UnpackArrayDType);
+    }
+
+    // VISITORS
+    void visit(AstVar* nodep) override {
+        if (candidateDTypep(nodep)) m_varps.push_back(nodep);
+        iterateChildren(nodep);
+    }
+    void visit(AstNodeVarRef* nodep) override {
+        if (!candidateDTypep(nodep->varp())) return;
+        if (isElementUse(nodep)) {
+            m_refps.push_back(nodep);
+        } else {
+            nodep->varp()->user1(true);
+        }
+    }
+    void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit SparseVisitor(AstNetlist* nodep) {
+        iterate(nodep);
+        for (AstVar* const varp : m_varps) {
+            if (varp->user1()) continue;
+            UINFO(4, "  Sparse " << varp << endl);
+            varp->dtypep(sparseDTypep(candidateDTypep(varp)));
+            ++m_statSparse;
+        }
+        for (AstNodeVarRef* const refp : m_refps) {
+            if (!refp->varp()->user1()) refp->dtypeFrom(refp->varp());
+        }
+    }
+    ~SparseVisitor() override {
+        V3Stats::addStat("Optimizations, Sparse arrays", m_statSparse);
+    }
+};
+
+//######################################################################
+// Sparse class functions
+
+void V3Sparse::sparseAll(AstNetlist* nodep) {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    { SparseVisitor{nodep}; }  // Destruct before checking
+    V3Global::dumpCheckGlobalTree("sparse", 0, dumpTreeEitherLevel() >= 3);
+}
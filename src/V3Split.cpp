@@ -75,6 +75,14 @@
 //
 //  Also vars must not be "public" and we also scoreboard nodep->isPure()
 //
+// With --threads, an always block that has no independent groups, yet
+// costs more than SPLIT_COST_TARGET, is instead cut into a chain of
+// always blocks between its top-level statements, at points where no
+// variable written before the cut is written after it, and no variable
+// read before the cut is written by a blocking assignment after it.
+// V3Order then orders the pieces along their remaining data dependencies,
+// and the partitioner can place them in different mtasks.
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
@@ -82,6 +90,7 @@
 #include "V3Split.h"
 
 #include "V3Graph.h"
+#include "V3InstrCount.h"
 #include "V3Stats.h"
 
 #include <unordered_map>
@@ -90,6 +99,9 @@
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+// Instruction count above which a block is worth spreading over several mtasks
+constexpr uint32_t SPLIT_COST_TARGET = 5000;
+
 //######################################################################
 // Support classes
 
@@ -848,6 +860,16 @@ class SplitVisitor final : public SplitReorderBaseVisitor {
     // AstNodeIf* whose condition we're currently visiting
     const AstNode* m_curIfConditional = nullptr;
     VDouble0 m_statSplits;  // Statistic tracking
+    VDouble0 m_statCostSplits;  // Statistic tracking
+
+    // Variables referenced by one top-level statement, for cutting by cost
+    struct CutStmt final {
+        AstNode* m_stmtp = nullptr;
+        uint32_t m_cost = 0;
+        std::unordered_set<const AstVarScope*> m_reads;  // Variables read
+        std::unordered_set<const AstVarScope*> m_writes;  // Variables written by any assignment
+        std::unordered_set<const AstVarScope*> m_blkWrites;  // Variables written, not delayed
+    };
 
     // CONSTRUCTORS
 public:
@@ -870,7 +892,10 @@ public:
         }
     }
 
-    ~SplitVisitor() override { V3Stats::addStat("Optimizations, Split always", m_statSplits); }
+    ~SplitVisitor() override {
+        V3Stats::addStat("Optimizations, Split always", m_statSplits);
+        V3Stats::addStat("Optimizations, Split always by cost", m_statCostSplits);
+    }
 
     // METHODS
 protected:
@@ -979,6 +1004,93 @@ protected:
             // and emit the split always blocks into m_replaceBlocks:
             EmitSplitVisitor emitSplit{nodep, &ifColor, &(m_replaceBlocks[nodep])};
             emitSplit.go();
+        } else if (v3Global.opt.mtasks()) {
+            splitByCost(nodep);
+        }
+    }
+
+    static CutStmt cutStmt(AstNode* stmtp) {
+        CutStmt info;
+        info.m_stmtp = stmtp;
+        info.m_cost = V3InstrCount::count(stmtp, false);
+        std::unordered_set<const AstVarRef*> dlyRefs;
+        stmtp->foreach([&](const AstAssignDly* dlyp) {
+            dlyp->lhsp()->foreach([&](const AstVarRef* refp) { dlyRefs.emplace(refp); });
+        });
+        stmtp->foreach([&](const AstVarRef* refp) {
+            if (refp->varp()->isConst()) return;
+            const AstVarScope* const vscp = refp->varScopep();
+            if (refp->access().isReadOrRW()) info.m_reads.emplace(vscp);
+            if (refp->access().isWriteOrRW()) {
+                info.m_writes.emplace(vscp);
+                if (!dlyRefs.count(refp)) info.m_blkWrites.emplace(vscp);
+            }
+        });
+        return info;
+    }
+
+    void splitByCost(AstAlways* nodep) {
+        if (!nodep->stmtsp() || !nodep->stmtsp()->nextp()) return;
+        // Statements that are not pure, e.g. $display, must stay in order
+        if (nodep->exists([](AstNode* np) { return !np->isPure(); })) return;
+        std::vector<CutStmt> stmts;
+        uint32_t totalCost = 0;
+        for (AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            stmts.emplace_back(cutStmt(stmtp));
+            totalCost += stmts.back().m_cost;
+        }
+        if (totalCost < 2 * SPLIT_COST_TARGET) return;
+
+        // Count references after the candidate cut, then move statements before it one at
+        // a time, tracking the number of variables that prevent a cut there
+        std::unordered_map<const AstVarScope*, int> laterWrites;
+        std::unordered_map<const AstVarScope*, int> laterBlkWrites;
+        for (const CutStmt& info : stmts) {
+            for (const AstVarScope* const vscp : info.m_writes) ++laterWrites[vscp];
+            for (const AstVarScope* const vscp : info.m_blkWrites) ++laterBlkWrites[vscp];
+        }
+        std::unordered_set<const AstVarScope*> earlierReads;
+        std::unordered_set<const AstVarScope*> earlierWrites;
+        size_t conflicts = 0;
+        std::vector<size_t> cuts;  // Index of first statement of each later piece
+        uint32_t pieceCost = 0;
+        uint32_t doneCost = 0;
+        for (size_t i = 0; i < stmts.size() - 1; ++i) {
+            const CutStmt& info = stmts[i];
+            for (const AstVarScope* const vscp : info.m_writes) {
+                if (--laterWrites[vscp] == 0 && earlierWrites.count(vscp)) --conflicts;
+            }
+            for (const AstVarScope* const vscp : info.m_blkWrites) {
+                if (--laterBlkWrites[vscp] == 0 && earlierReads.count(vscp)) --conflicts;
+            }
+            for (const AstVarScope* const vscp : info.m_writes) {
+                if (earlierWrites.emplace(vscp).second && laterWrites[vscp]) ++conflicts;
+            }
+            for (const AstVarScope* const vscp : info.m_reads) {
+                if (earlierReads.emplace(vscp).second && laterBlkWrites[vscp]) ++conflicts;
+            }
+            pieceCost += info.m_cost;
+            doneCost += info.m_cost;
+            if (!conflicts && pieceCost >= SPLIT_COST_TARGET
+                && totalCost - doneCost >= SPLIT_COST_TARGET) {
+                cuts.push_back(i + 1);
+                pieceCost = 0;
+            }
+        }
+        if (cuts.empty()) return;
+        UINFO(5, "  Split by cost into " << cuts.size() + 1 << " pieces: " << nodep << endl);
+        m_statCostSplits += cuts.size();
+        cuts.push_back(stmts.size());
+        AlwaysVec& newBlocks = m_replaceBlocks[nodep];
+        size_t first = 0;
+        for (const size_t end : cuts) {
+            AstAlways* const alwaysp
+                = new AstAlways{nodep->fileline(), VAlwaysKwd::ALWAYS, nullptr, nullptr};
+            for (size_t i = first; i < end; ++i) {
+                alwaysp->addStmtsp(stmts[i].m_stmtp->cloneTree(false));
+            }
+            newBlocks.push_back(alwaysp);
+            first = end;
         }
     }
     void visit(AstNodeIf* nodep) override {
@@ -133,13 +133,28 @@ public:
         const auto typeName = [](int type) { return std::string{VNType{type}.ascii()}; };
         const auto typeSize = [](int type) { return VNType{type}.typeInfo()->m_sizeof; };
         size_t totalNodeMemoryUsage = 0;
+        uint64_t totalNodeCount = 0;
         for (int t = 0; t < VNType::_ENUM_END; ++t) {
             if (const uint64_t count = m_counters.m_statTypeCount[t]) {
                 totalNodeMemoryUsage += count * typeSize(t);
+                totalNodeCount += count;
                 addStat("Node count, " + typeName(t), count);
             }
         }
         addStat("Node memory TOTAL (MiB)", totalNodeMemoryUsage >> 20);
+        // Pointer members of every AstNode: m_nextp, m_backp, m_op1p..m_op4p, m_iterpp,
+        // m_dtypep, m_headtailp and m_clonep.  Estimate the layout if these were
+        // 32-bit indices into the node arena instead.
+        constexpr size_t nodeLinks = 10;
+        const size_t linkMemoryUsage = totalNodeCount * nodeLinks * sizeof(AstNode*);
+        const size_t linkSaving = totalNodeCount * nodeLinks * (sizeof(AstNode*) - 4);
+        addStat("Node memory links (MiB)", linkMemoryUsage >> 20);
+        addStat("Node memory with 32-bit links, estimate (MiB)",
+                (totalNodeMemoryUsage - linkSaving) >> 20);
+        addStat("Node arena reserved (MiB)", V3Arena::reservedBytes() >> 20);
+        if (!v3Global.opt.astSpillDir().empty()) {
+            addStat("Node arena spill file (MiB)", V3Arena::spilledBytes() >> 20);
+        }
 
         // Node Memory usage
         for (int t = 0; t < VNType::_ENUM_END; ++t) {
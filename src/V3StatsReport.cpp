@@ -18,9 +18,11 @@
 
 #include "V3File.h"
 #include "V3Global.h"
+#include "V3Graph.h"
 #include "V3Os.h"
 #include "V3Stats.h"
 
+#include <array>
 #include <iomanip>
 #include <unordered_map>
 
@@ -187,6 +189,89 @@ public:
 
 StatsReport::StatColl StatsReport::s_allStats;
 
+//######################################################################
+// Memory usage by stage, for --stats-memory
+
+class StatsMemory final {
+    // TYPES
+    struct Stage final {
+        string m_name;  // Stage name, with number
+        uint64_t m_memory = 0;  // Process memory usage, as VlOs::memUsageBytes
+        uint64_t m_peakRss = 0;  // Peak resident memory of the process
+        uint64_t m_peakRssDelta = 0;  // Increase of m_peakRss during the stage
+        std::array<uint64_t, VNType::_ENUM_END> m_nodeBytes{};  // AstNode bytes in tree by type
+        size_t m_vertexBytes = 0;  // V3GraphVertex bytes at end of stage
+        size_t m_vertexPeakBytes = 0;  // V3GraphVertex bytes at peak during stage
+        size_t m_edgeBytes = 0;  // V3GraphEdge bytes at end of stage
+        size_t m_edgePeakBytes = 0;  // V3GraphEdge bytes at peak during stage
+    };
+
+    // STATE
+    static std::vector<Stage> s_stages;  // All stages so far
+    static uint64_t s_lastPeakRss;  // Peak resident memory at end of previous stage
+
+public:
+    // METHODS
+    static void stage(const string& name) {
+        s_stages.emplace_back();
+        Stage& stage = s_stages.back();
+        stage.m_name = name;
+        stage.m_memory = VlOs::memUsageBytes();
+        stage.m_peakRss = V3Os::memPeakBytes();
+        stage.m_peakRssDelta = stage.m_peakRss - std::min(s_lastPeakRss, stage.m_peakRss);
+        s_lastPeakRss = stage.m_peakRss;
+        if (AstNetlist* const rootp = v3Global.rootp()) {
+            rootp->foreach([&stage](AstNode* nodep) {
+                stage.m_nodeBytes[nodep->type()] += nodep->type().typeInfo()->m_sizeof;
+            });
+        }
+        V3GraphMemory& vertices = V3GraphMemory::s_vertices;
+        V3GraphMemory& edges = V3GraphMemory::s_edges;
+        stage.m_vertexBytes = vertices.bytes();
+        stage.m_vertexPeakBytes = vertices.peakBytes();
+        stage.m_edgeBytes = edges.bytes();
+        stage.m_edgePeakBytes = edges.peakBytes();
+        vertices.resetPeak();
+        edges.resetPeak();
+    }
+
+    static void report(const string& filename) {
+        const std::unique_ptr<std::ofstream> ofp{V3File::new_ofstream(filename)};
+        if (ofp->fail()) v3fatal("Can't write file: " << filename);
+        std::ofstream& os = *ofp;
+        os << "{\n  \"stages\": [";
+        string stageSep = "\n";
+        for (const Stage& stage : s_stages) {
+            uint64_t nodeBytes = 0;
+            for (const uint64_t bytes : stage.m_nodeBytes) nodeBytes += bytes;
+            os << stageSep << "    {\n";
+            os << "      \"stage\": \"" << stage.m_name << "\",\n";
+            os << "      \"memoryBytes\": " << stage.m_memory << ",\n";
+            os << "      \"peakRssBytes\": " << stage.m_peakRss << ",\n";
+            os << "      \"peakRssDeltaBytes\": " << stage.m_peakRssDelta << ",\n";
+            os << "      \"graphVertexBytes\": " << stage.m_vertexBytes << ",\n";
+            os << "      \"graphVertexPeakBytes\": " << stage.m_vertexPeakBytes << ",\n";
+            os << "      \"graphEdgeBytes\": " << stage.m_edgeBytes << ",\n";
+            os << "      \"graphEdgePeakBytes\": " << stage.m_edgePeakBytes << ",\n";
+            os << "      \"astNodeBytes\": " << nodeBytes << ",\n";
+            os << "      \"astNodeBytesByType\": {";
+            string typeSep = "\n";
+            for (int t = 0; t < VNType::_ENUM_END; ++t) {
+                if (!stage.m_nodeBytes[t]) continue;
+                os << typeSep << "        \"" << VNType{t}.ascii()
+                   << "\": " << stage.m_nodeBytes[t];
+                typeSep = ",\n";
+            }
+            os << "\n      }\n    }";
+            stageSep = ",\n";
+        }
+        os << "\n  ]\n}\n";
+    }
+};
+
+std::vector<StatsMemory::Stage> StatsMemory::s_stages;
+uint64_t StatsMemory::s_lastPeakRss = 0;
+
 //######################################################################
 // V3Statstic class
 
@@ -217,6 +302,8 @@ void V3Stats::statsStage(const string& name) {
 
     const double memory = VlOs::memUsageBytes() / 1024.0 / 1024.0;
     V3Stats::addStatPerf("Stage, Memory (MB), " + digitName, memory);
+
+    if (v3Global.opt.statsMemory()) StatsMemory::stage(digitName);
 }
 
 void V3Stats::infoHeader(std::ofstream& os, const string& prefix) {
@@ -241,6 +328,11 @@ void V3Stats::statsReport() {
     // Cleanup
     ofp->close();
     VL_DO_DANGLING(delete ofp, ofp);
+
+    if (v3Global.opt.statsMemory()) {
+        StatsMemory::report(v3Global.opt.hierTopDataDir() + "/" + v3Global.opt.prefix()
+                            + "__stats_memory.json");
+    }
 }
 
 void V3Stats::summaryReport() {
@@ -29,6 +29,9 @@
 #include "V3Stats.h"
 
 #include <algorithm>
+#include <limits>
+#include <map>
+#include <unordered_map>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -380,11 +383,135 @@ public:
     }
 };
 
+//######################################################################
+// Reuse wide temporaries whose lifetimes do not overlap, so large functions
+// need fewer stack slots
+
+class SubstReuseVisitor final : public VNVisitor {
+    // TYPES
+    struct Range final {
+        int m_first = std::numeric_limits<int>::max();  // Position of first reference
+        int m_last = 0;  // Position of last reference
+        size_t m_loop = 0;  // 1 + index in m_loopEnds of last loop referencing it, or 0
+    };
+    struct Slot final {
+        AstVar* m_varp;  // Variable kept for this slot
+        int m_end;  // Position of last reference to the slot so far
+    };
+
+    // STATE
+    std::unordered_map<AstVar*, Range> m_ranges;  // Candidate temporaries in current function
+    std::vector<int> m_loopEnds;  // End position of each outermost loop in current function
+    int m_pos = 0;  // Position of current node in iteration order
+    int m_loopStart = -1;  // Position of current outermost loop, or -1 if not in a loop
+    VDouble0 m_statReused;  // Statistic tracking
+
+    // METHODS
+    void reuse(AstCFunc* funcp) {
+        // Order candidates by start of lifetime. Statements only execute forward, except in
+        // loops, where a reference extends the lifetime to the whole outermost loop.
+        std::vector<std::pair<AstVar*, Range>> ordered;
+        for (const auto& pair : m_ranges) {
+            if (!pair.second.m_last) continue;  // Unreferenced
+            ordered.push_back(pair);
+            if (const size_t loop = pair.second.m_loop) {
+                ordered.back().second.m_last
+                    = std::max(pair.second.m_last, m_loopEnds[loop - 1]);
+            }
+        }
+        std::sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+            if (a.second.m_first != b.second.m_first) return a.second.m_first < b.second.m_first;
+            return a.first->name() < b.first->name();
+        });
+        // Greedily assign each to a free slot of the same type
+        std::map<const AstNodeDType*, std::vector<Slot>> slots;
+        std::unordered_map<AstVar*, AstVar*> replacements;
+        for (const auto& pair : ordered) {
+            std::vector<Slot>& typeSlots = slots[pair.first->dtypep()->skipRefp()];
+            Slot* freep = nullptr;
+            for (Slot& slot : typeSlots) {
+                if (slot.m_end < pair.second.m_first) {
+                    freep = &slot;
+                    break;
+                }
+            }
+            if (freep) {
+                replacements.emplace(pair.first, freep->m_varp);
+                freep->m_end = pair.second.m_last;
+            } else {
+                typeSlots.push_back(Slot{pair.first, pair.second.m_last});
+            }
+        }
+        if (replacements.empty()) return;
+        funcp->foreach([&](AstNodeVarRef* refp) {
+            const auto it = replacements.find(refp->varp());
+            if (it != replacements.end()) refp->varp(it->second);
+        });
+        for (const auto& pair : replacements) {
+            AstVar* varp = pair.first;
+            VL_DO_DANGLING(pushDeletep(varp->unlinkFrBack()), varp);
+            ++m_statReused;
+        }
+    }
+
+    // VISITORS
+    void visit(AstCFunc* nodep) override {
+        // Coroutine locals live across suspensions, so leave them alone
+        if (nodep->isCoroutine()) return;
+        for (AstNode* stmtp = nodep->initsp(); stmtp; stmtp = stmtp->nextp()) {
+            AstVar* const varp = VN_CAST(stmtp, Var);
+            if (varp && varp->isStatementTemp() && varp->isWide() && !varp->noSubst()) {
+                m_ranges.emplace(varp, Range{});
+            }
+        }
+        if (m_ranges.size() > 1) {
+            m_pos = 0;
+            m_loopEnds.clear();
+            iterateChildren(nodep);
+            reuse(nodep);
+        }
+        m_ranges.clear();
+    }
+    void visit(AstWhile* nodep) override {
+        if (m_loopStart >= 0) {  // Nested, already covered by the outermost loop
+            ++m_pos;
+            iterateChildren(nodep);
+            return;
+        }
+        VL_RESTORER(m_loopStart);
+        m_loopStart = m_pos++;
+        iterateChildren(nodep);
+        m_loopEnds.push_back(m_pos);
+    }
+    void visit(AstNodeVarRef* nodep) override {
+        ++m_pos;
+        const auto it = m_ranges.find(nodep->varp());
+        if (it == m_ranges.end()) return;
+        Range& range = it->second;
+        // In a loop the value might be carried to the next iteration
+        range.m_first = std::min(range.m_first, m_loopStart >= 0 ? m_loopStart : m_pos);
+        range.m_last = m_pos;
+        if (m_loopStart >= 0) range.m_loop = m_loopEnds.size() + 1;
+    }
+    void visit(AstNode* nodep) override {
+        ++m_pos;
+        iterateChildren(nodep);
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit SubstReuseVisitor(AstNetlist* nodep) { iterate(nodep); }
+    ~SubstReuseVisitor() override {
+        V3Stats::addStat("Optimizations, Reused temps", m_statReused);
+    }
+};
+
 //######################################################################
 // Subst class functions
 
 void V3Subst::substituteAll(AstNetlist* nodep) {
     UINFO(2, __FUNCTION__ << ": " << endl);
     { SubstVisitor{nodep}; }  // Destruct before checking
+    { SubstReuseVisitor{nodep}; }  // Destruct before checking
     V3Global::dumpCheckGlobalTree("subst", 0, dumpTreeEitherLevel() >= 3);
 }
@@ -26,9 +26,11 @@
 #include "V3String.h"
 
 #include <cstdarg>
+#include <functional>
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -44,7 +46,13 @@ class VSymEnt final {
     // Symbol table that can have a "superior" table for resolving upper references
     // MEMBERS
     using IdNameMap = std::multimap<std::string, VSymEnt*>;
+    // Hashed index of m_idNameMap, keyed by the map's own key strings. Lookups use this, while
+    // the ordered map gives a deterministic iteration order.
+    using IdNameIndex
+        = std::unordered_map<std::reference_wrapper<const std::string>, IdNameMap::iterator,
+                             std::hash<std::string>, std::equal_to<std::string>>;
     IdNameMap m_idNameMap;  // Hash of variables by name
+    IdNameIndex m_idNameIndex;  // Index of first entry with each name in m_idNameMap
     AstNode* m_nodep;  // Node that entry belongs to
     VSymEnt* m_fallbackp;  // Table "above" this one in name scope, for fallback resolution
     VSymEnt* m_parentp;  // Table that created this table, dot notation needed to resolve into it
@@ -62,6 +70,15 @@ public:
     const_iterator begin() const { return m_idNameMap.begin(); }
     const_iterator end() const { return m_idNameMap.end(); }
 
+private:
+    const_iterator findName(const string& name) const {
+        const auto it = m_idNameIndex.find(std::cref(name));
+        if (it == m_idNameIndex.end()) return m_idNameMap.end();
+        return it->second;
+    }
+
+public:
+
     void dumpIterate(std::ostream& os, VSymConstMap& doneSymsr, const string& indent,
                      int numLevels, const string& searchName) const {
         os << indent << "+ " << std::left << std::setw(30) << ("'"s + searchName + "'"s)
@@ -120,7 +137,7 @@ public:
     void insert(const string& name, VSymEnt* entp) {
         UINFO(9, "     SymInsert se" << cvtToHex(this) << " '" << name << "' se" << cvtToHex(entp)
                                      << "  " << entp->nodep() << endl);
-        if (name != "" && m_idNameMap.find(name) != m_idNameMap.end()) {
+        if (name != "" && findName(name) != m_idNameMap.end()) {
             // If didn't already report warning
             if (!V3Error::errorCount()) {  // LCOV_EXCL_START
                 if (debug() >= 9 || V3Error::debugDefault())
@@ -128,15 +145,16 @@ public:
                 entp->nodep()->v3fatalSrc("Inserting two symbols with same name: " << name);
             }  // LCOV_EXCL_STOP
         } else {
-            m_idNameMap.emplace(name, entp);
+            const auto it = m_idNameMap.emplace(name, entp);
+            m_idNameIndex.emplace(std::cref(it->first), it);
         }
     }
     void reinsert(const string& name, VSymEnt* entp) {
-        const auto it = m_idNameMap.find(name);
-        if (name != "" && it != m_idNameMap.end()) {
+        const auto it = m_idNameIndex.find(std::cref(name));
+        if (name != "" && it != m_idNameIndex.end()) {
             UINFO(9, "     SymReinsert se" << cvtToHex(this) << " '" << name << "' se"
                                            << cvtToHex(entp) << "  " << entp->nodep() << endl);
-            it->second = entp;  // Replace
+            it->second->second = entp;  // Replace
         } else {
             insert(name, entp);
         }
@@ -144,7 +162,7 @@ public:
     VSymEnt* findIdFlat(const string& name) const {
         // Find identifier without looking upward through symbol hierarchy
         // First, scan this begin/end block or module for the name
-        const auto it = m_idNameMap.find(name);
+        const auto it = findName(name);
         UINFO(9, "     SymFind   se"
                      << cvtToHex(this) << " '" << name << "' -> "
                      << (it == m_idNameMap.end()
@@ -210,7 +228,7 @@ public:
     void importFromPackage(VSymGraph* graphp, const VSymEnt* srcp, const string& id_or_star) {
         // Import tokens from source symbol table into this symbol table
         if (id_or_star != "*") {
-            const auto it = srcp->m_idNameMap.find(id_or_star);
+            const auto it = srcp->findName(id_or_star);
             if (it != srcp->m_idNameMap.end()) {
                 importOneSymbol(graphp, it->first, it->second, true);
             }
@@ -224,7 +242,7 @@ public:
     void exportFromPackage(VSymGraph* graphp, const VSymEnt* srcp, const string& id_or_star) {
         // Export tokens from source symbol table into this symbol table
         if (id_or_star != "*") {
-            const auto it = vlstd::as_const(srcp->m_idNameMap).find(id_or_star);
+            const auto it = srcp->findName(id_or_star);
             if (it != srcp->m_idNameMap.end()) exportOneSymbol(graphp, it->first, it->second);
         } else {
             for (IdNameMap::const_iterator it = srcp->m_idNameMap.begin();
@@ -7,6 +7,9 @@
 //         in perfectMatching(). True minimum-weight perfect matching
 //         would produce a better result. How much better is TBD.
 //
+//         Large state sets instead use 2-opt and Or-opt local search
+//         over nearest neighbor lists; see TspLocalSearch.
+//
 // Code available from: https://verilator.org
 //
 //*************************************************************************
@@ -26,6 +29,7 @@
 #include "V3File.h"
 #include "V3Graph.h"
 
+#include <algorithm>
 #include <cmath>
 #include <list>
 #include <memory>
@@ -431,22 +435,234 @@ private:
 };
 
 //######################################################################
-// Main algorithm
+// Local search for large state sets. Christofides builds a complete
+// graph, which is quadratic in memory and too slow past a few hundred
+// states. Instead start from a nearest neighbor tour and improve it with
+// 2-opt and Or-opt moves, only considering the nearest few states to each.
 
-void V3TSP::tspSort(const V3TSP::StateVec& states, V3TSP::StateVec* resultp) VL_MT_SAFE {
-    UASSERT(resultp->empty(), "Output graph must start empty");
+// Above this many states, use TspLocalSearch instead of Christofides
+constexpr size_t CHRISTOFIDES_MAX_STATES = 256;
 
-    // Make this TSP implementation work for graphs of size 0 or 1
-    // which, unfortunately, is a special case as the following
-    // code assumes >= 2 nodes.
-    if (states.empty()) return;
-    if (states.size() == 1) {
-        resultp->push_back(*(states.begin()));
-        return;
+class TspLocalSearch final {
+    // TYPES
+    using Index = uint32_t;
+    // CONSTANTS
+    static constexpr size_t NEIGHBORS = 10;  // Neighbor list length
+    static constexpr int MAX_PASSES = 50;  // Bound on improvement passes
+    static constexpr Index MAX_SEGMENT = 3;  // Longest segment moved by Or-opt
+
+    // MEMBERS
+    const V3TSP::StateVec& m_states;
+    const Index m_n;  // Number of states
+    std::vector<std::vector<Index>> m_neighbors;  // Nearest states to each, closest first
+    std::vector<Index> m_tour;  // State at each tour position
+    std::vector<Index> m_pos;  // Tour position of each state
+    std::vector<Index> m_next;  // Successor of each state, for Or-opt
+    std::vector<Index> m_prev;  // Predecessor of each state, for Or-opt
+
+    // METHODS
+    int cost(Index a, Index b) const { return m_states[a]->cost(m_states[b]); }
+    Index succ(Index a) const { return m_tour[m_pos[a] + 1 == m_n ? 0 : m_pos[a] + 1]; }
+    Index pred(Index a) const { return m_tour[m_pos[a] == 0 ? m_n - 1 : m_pos[a] - 1]; }
+
+    void buildNeighbors() {
+        m_neighbors.resize(m_n);
+        std::vector<std::pair<int, Index>> row;
+        row.reserve(m_n - 1);
+        const size_t k = m_n - 1 < NEIGHBORS ? m_n - 1 : NEIGHBORS;
+        for (Index a = 0; a < m_n; ++a) {
+            row.clear();
+            for (Index b = 0; b < m_n; ++b) {
+                if (a != b) row.emplace_back(cost(a, b), b);
+            }
+            std::partial_sort(row.begin(), row.begin() + k, row.end());
+            m_neighbors[a].reserve(k);
+            for (size_t i = 0; i < k; ++i) m_neighbors[a].push_back(row[i].second);
+        }
     }
 
+    void buildNearestNeighborTour() {
+        std::vector<bool> visited(m_n, false);
+        m_tour.reserve(m_n);
+        Index cur = 0;
+        Index unvisitedNext = 0;  // Lowest index that might still be unvisited
+        while (true) {
+            m_tour.push_back(cur);
+            visited[cur] = true;
+            if (m_tour.size() == m_n) break;
+            Index best = m_n;
+            for (const Index b : m_neighbors[cur]) {
+                if (!visited[b]) {
+                    best = b;
+                    break;
+                }
+            }
+            if (best == m_n) {
+                // All neighbors visited; take the closest remaining state
+                while (visited[unvisitedNext]) ++unvisitedNext;
+                best = unvisitedNext;
+                int bestCost = cost(cur, best);
+                for (Index b = unvisitedNext + 1; b < m_n; ++b) {
+                    if (visited[b]) continue;
+                    const int c = cost(cur, b);
+                    if (c < bestCost) {
+                        best = b;
+                        bestCost = c;
+                    }
+                }
+            }
+            cur = best;
+        }
+        m_pos.resize(m_n);
+        for (Index i = 0; i < m_n; ++i) m_pos[m_tour[i]] = i;
+    }
+
+    // Reverse the tour from position 'from' forwards to position 'to',
+    // or equivalently the rest of the cycle, whichever is shorter
+    void reverse(Index from, Index to) {
+        Index len = (to + m_n - from) % m_n + 1;
+        if (2 * len > m_n) {
+            const Index newFrom = to + 1 == m_n ? 0 : to + 1;
+            to = from == 0 ? m_n - 1 : from - 1;
+            from = newFrom;
+            len = m_n - len;
+        }
+        for (Index k = 0; k < len / 2; ++k) {
+            const Index i = (from + k) % m_n;
+            const Index j = (to + m_n - k) % m_n;
+            std::swap(m_tour[i], m_tour[j]);
+            m_pos[m_tour[i]] = i;
+            m_pos[m_tour[j]] = j;
+        }
+    }
+
+    // Try 2-opt moves replacing an edge at 'a' with one to a neighbor
+    bool improve2Opt(Index a) {
+        for (const bool forward : {true, false}) {
+            const Index b = forward ? succ(a) : pred(a);
+            const int costAb = cost(a, b);
+            for (const Index c : m_neighbors[a]) {
+                const int costAc = cost(a, c);
+                if (costAc >= costAb) break;
+                const Index d = forward ? succ(c) : pred(c);
+                if (c == b || d == a) continue;
+                if (costAc + cost(b, d) >= costAb + cost(c, d)) continue;
+                if (forward) {  // a b ... c d  ->  a c ... b d
+                    reverse(m_pos[b], m_pos[c]);
+                } else {  // d c ... b a  ->  d b ... c a
+                    reverse(m_pos[c], m_pos[b]);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+    bool pass2Opt() {
+        bool improved = false;
+        for (Index a = 0; a < m_n; ++a) {
+            while (improve2Opt(a)) improved = true;
+        }
+        return improved;
+    }
+
+    // Try moving the segment s1..s2 (following m_next) between a neighbor
+    // and that neighbor's predecessor or successor, possibly reversed
+    bool improveOrOpt(Index s1, Index len) {
+        Index s2 = s1;
+        for (Index i = 1; i < len; ++i) s2 = m_next[s2];
+        const Index p = m_prev[s1];
+        const Index q = m_next[s2];
+        const auto inSegment = [&](Index x) {
+            for (Index y = s1;; y = m_next[y]) {
+                if (x == y) return true;
+                if (y == s2) return false;
+            }
+        };
+        const int gain = cost(p, s1) + cost(s2, q) - cost(p, q);
+        if (gain <= 0) return false;
+        for (const Index end : {s1, s2}) {
+            for (const Index x : m_neighbors[end]) {
+                if (inSegment(x)) continue;
+                for (const bool after : {true, false}) {
+                    const Index c = after ? x : m_prev[x];
+                    const Index e = after ? m_next[x] : x;
+                    if (inSegment(c) || inSegment(e)) continue;
+                    const int costCe = cost(c, e);
+                    const int addFwd = cost(c, s1) + cost(s2, e) - costCe;
+                    const int addRev = cost(c, s2) + cost(s1, e) - costCe;
+                    if (std::min(addFwd, addRev) >= gain) continue;
+                    // Unlink, then relink the segment between c and e
+                    m_next[p] = q;
+                    m_prev[q] = p;
+                    Index first = s1;
+                    Index last = s2;
+                    if (addRev < addFwd) {
+                        for (Index y = s1;; y = m_prev[y]) {
+                            std::swap(m_next[y], m_prev[y]);
+                            if (y == s2) break;
+                        }
+                        std::swap(first, last);
+                    }
+                    m_next[c] = first;
+                    m_prev[first] = c;
+                    m_next[last] = e;
+                    m_prev[e] = last;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+    bool passOrOpt() {
+        m_next.resize(m_n);
+        m_prev.resize(m_n);
+        for (Index i = 0; i < m_n; ++i) {
+            m_next[m_tour[i]] = m_tour[i + 1 == m_n ? 0 : i + 1];
+            m_prev[m_tour[i]] = m_tour[i == 0 ? m_n - 1 : i - 1];
+        }
+        bool improved = false;
+        if (m_n > MAX_SEGMENT + 2) {
+            for (Index a = 0; a < m_n; ++a) {
+                for (Index len = 1; len <= MAX_SEGMENT; ++len) {
+                    if (improveOrOpt(a, len)) improved = true;
+                }
+            }
+        }
+        // Back to the array form
+        Index a = m_tour[0];
+        for (Index i = 0; i < m_n; ++i, a = m_next[a]) {
+            m_tour[i] = a;
+            m_pos[a] = i;
+        }
+        return improved;
+    }
+
+public:
+    // CONSTRUCTORS
+    TspLocalSearch(const V3TSP::StateVec& states, V3TSP::StateVec* resultp)
+        : m_states{states}
+        , m_n{static_cast<Index>(states.size())} {
+        UASSERT(m_n >= 3, "Too few states for local search");
+        buildNeighbors();
+        buildNearestNeighborTour();
+        for (int pass = 0; pass < MAX_PASSES; ++pass) {
+            const bool improved2Opt = pass2Opt();
+            const bool improvedOrOpt = passOrOpt();
+            if (!improved2Opt && !improvedOrOpt) break;
+            UINFO(6, "TSP local search pass " << pass << " improved" << endl);
+        }
+        for (const Index i : m_tour) resultp->push_back(m_states[i]);
+    }
+    ~TspLocalSearch() = default;
+    VL_UNCOPYABLE(TspLocalSearch);
+};
+
+//######################################################################
+// Main algorithm
+
+static void tspSortChristofides(const V3TSP::StateVec& states, V3TSP::StateVec* resultp) {
     // Build the initial graph from the starting state set.
-    using Graph = TspGraphTmpl<const TspStateBase*>;
+    using Graph = TspGraphTmpl<const V3TSP::TspStateBase*>;
     Graph graph;
     for (const auto& state : states) graph.addVertex(state);
     for (V3TSP::StateVec::const_iterator it = states.begin(); it != states.end(); ++it) {
@@ -461,7 +677,7 @@ void V3TSP::tspSort(const V3TSP::StateVec& states, V3TSP::StateVec* resultp) VL_
     graph.makeMinSpanningTree(&minGraph);
     if (dumpGraphLevel() >= 6) minGraph.dumpGraphFilePrefixed("minGraph");
 
-    const std::vector<const TspStateBase*> oddDegree = minGraph.getOddDegreeKeys();
+    const std::vector<const V3TSP::TspStateBase*> oddDegree = minGraph.getOddDegreeKeys();
     Graph matching;
     graph.perfectMatching(oddDegree, &matching);
     if (dumpGraphLevel() >= 6) matching.dumpGraphFilePrefixed("matching");
@@ -477,16 +693,36 @@ void V3TSP::tspSort(const V3TSP::StateVec& states, V3TSP::StateVec* resultp) VL_
 
     // Discard duplicate nodes that the Euler tour might contain.
     {
-        std::unordered_set<const TspStateBase*> seen;
+        std::unordered_set<const V3TSP::TspStateBase*> seen;
         for (V3TSP::StateVec::iterator it = prelim_result.begin(); it != prelim_result.end();
              ++it) {
-            const TspStateBase* const elemp = *it;
+            const V3TSP::TspStateBase* const elemp = *it;
             const auto itFoundPair = seen.insert(elemp);
             if (itFoundPair.second) resultp->push_back(elemp);
         }
     }
 
     UASSERT(resultp->size() == states.size(), "Algorithm size error");
+}
+
+void V3TSP::tspSort(const V3TSP::StateVec& states, V3TSP::StateVec* resultp) VL_MT_SAFE {
+    UASSERT(resultp->empty(), "Output graph must start empty");
+
+    // Make this TSP implementation work for graphs of size 0 or 1
+    // which, unfortunately, is a special case as the following
+    // code assumes >= 2 nodes.
+    if (states.empty()) return;
+    if (states.size() == 1) {
+        resultp->push_back(*(states.begin()));
+        return;
+    }
+
+    if (states.size() > CHRISTOFIDES_MAX_STATES) {
+        TspLocalSearch{states, resultp};
+    } else {
+        tspSortChristofides(states, resultp);
+    }
+    UASSERT(resultp->size() == states.size(), "Algorithm size error");
 
     // Find the most expensive arc and rotate the list so that the most
     // expensive arc connects the last and first elements. (Since we're not
@@ -646,6 +882,36 @@ void V3TSP::selfTestStates() {
                 "TSP 2d cycle=false self-test fail. Result (above) did not match expectation.");
         }
     }
+
+    // Large linear test, using local search rather than Christofides.
+    // Coords are scrambled along the x-axis, result should be monotonic.
+    {
+        const unsigned n = CHRISTOFIDES_MAX_STATES + 44;
+        std::vector<std::unique_ptr<TspTestState>> points;
+        V3TSP::StateVec states;
+        for (unsigned i = 0; i < n; ++i) {
+            points.emplace_back(new TspTestState{(i * 37) % n * 10, 0});
+            states.push_back(points.back().get());
+        }
+
+        V3TSP::StateVec result;
+        tspSort(states, &result);
+
+        bool ok = result.size() == n;
+        for (unsigned i = 1; ok && i + 1 < result.size(); ++i) {
+            const unsigned x0 = dynamic_cast<const TspTestState*>(result[i - 1])->xpos();
+            const unsigned x1 = dynamic_cast<const TspTestState*>(result[i])->xpos();
+            const unsigned x2 = dynamic_cast<const TspTestState*>(result[i + 1])->xpos();
+            ok = (x0 < x1) == (x1 < x2);
+        }
+        if (VL_UNCOVERABLE(!ok)) {
+            for (const V3TSP::TspStateBase* const statep : result) {
+                cout << dynamic_cast<const TspTestState*>(statep)->xpos() << " ";
+            }
+            cout << endl;
+            v3fatalSrc("TSP large linear self-test fail. Result (above) was not monotonic.");
+        }
+    }
 }
 
 void V3TSP::selfTestString() {
@@ -18,6 +18,8 @@
 //      Count # of input bits and # of output bits, and # of statements
 //      If high # of statements relative to inpbits*outbits,
 //      replace with lookup table
+//      Narrow outputs are packed together into a single table, so one
+//      lookup produces all of them
 //
 //*************************************************************************
 
@@ -29,6 +31,7 @@
 #include "V3Stats.h"
 
 #include <cmath>
+#include <unordered_set>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -37,11 +40,14 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 // Table class functions
 
 // CONFIG
-// 1MB is max table size (better be lots of instructs to be worth it!)
-static constexpr int TABLE_MAX_BYTES = 1 * 1024 * 1024;
+// 4MB is max table size (better be lots of instructs to be worth it!)
+static constexpr int TABLE_MAX_BYTES = 4 * 1024 * 1024;
 // 64MB is close to max memory of some systems (256MB or so), so don't get out of control
 static constexpr int TABLE_TOTAL_BYTES = 64 * 1024 * 1024;
-// Worth no more than 8 bytes of data to replace an instruction
+// Tables up to this size are likely to stay in the (L2) cache of the host
+static constexpr int TABLE_CACHE_BYTES = 1 * 1024 * 1024;
+// Worth no more than 8 bytes of data to replace an instruction, while the table fits in the
+// cache. Larger tables will miss the cache and are worth proportionally less.
 static constexpr int TABLE_SPACE_TIME_MULT = 8;
 // If < 32 instructions, not worth the effort
 static constexpr int TABLE_MIN_NODE_COUNT = 32;
@@ -122,6 +128,7 @@ public:
 class TableOutputVar final {
     AstVarScope* const m_varScopep;  // The output variable
     const unsigned m_ord;  // Output ordinal number in this block
+    int m_packedLsb = -1;  // LSB of this output in the packed table, or -1 if not packed
     bool m_mayBeUnassigned = false;  // If true, then this variable may be unassigned through
                                      // some path through the block being table converted
     TableBuilder m_tableBuilder;
@@ -137,6 +144,8 @@ public:
     unsigned ord() const { return m_ord; }
     void setMayBeUnassigned() { m_mayBeUnassigned = true; }
     bool mayBeUnassigned() const { return m_mayBeUnassigned; }
+    void packedLsb(int lsb) { m_packedLsb = lsb; }
+    int packedLsb() const { return m_packedLsb; }
     void setTableSize(unsigned size) { m_tableBuilder.setTableSize(varScopep()->dtypep(), size); }
     void addValue(unsigned index, const V3Number& value) { m_tableBuilder.addValue(index, value); }
     AstVarScope* tabeVarScopep() { return m_tableBuilder.varScopep(); }
@@ -151,7 +160,10 @@ class TableVisitor final : public VNVisitor {
 
     // STATE
     double m_totalBytes = 0;  // Total bytes in tables created
+    std::unordered_set<const AstVarScope*> m_tables;  // Tables in the constant pool used so far
     VDouble0 m_statTablesCre;  // Statistic tracking
+    VDouble0 m_statTablesPacked;  // Statistic tracking
+    VDouble0 m_statTablesShared;  // Statistic tracking
 
     //  State cleared on each module
     AstNodeModule* m_modp = nullptr;  // Current MODULE
@@ -164,6 +176,8 @@ class TableVisitor final : public VNVisitor {
     bool m_assignDly = false;  // Consists of delayed assignments instead of normal assignments
     unsigned m_inWidthBits = 0;  // Input table width - in bits
     unsigned m_outWidthBytes = 0;  // Output table width - in bytes
+    unsigned m_outWidthBits = 0;  // Output table width - in bits, if packed
+    bool m_outPackable = true;  // Outputs can be packed into a single table
     std::vector<AstVarScope*> m_inVarps;  // Input variable list
     std::vector<TableOutputVar> m_outVarps;  // Output variable list
 
@@ -177,7 +191,10 @@ public:
         if (nodep->access().isWriteOrRW()) {
             // We'll make the table with a separate natural alignment for each output var, so
             // always have 8, 16 or 32 bit widths, so use widthTotalBytes
-            m_outWidthBytes += nodep->varp()->dtypeSkipRefp()->widthTotalBytes();
+            const AstNodeDType* const dtypep = nodep->varp()->dtypeSkipRefp();
+            m_outWidthBytes += dtypep->widthTotalBytes();
+            m_outWidthBits += dtypep->width();
+            if (dtypep->isString() || dtypep->isDouble()) m_outPackable = false;
             m_outVarps.emplace_back(vscp, static_cast<unsigned>(m_outVarps.size()));
         }
         if (nodep->access().isReadOrRW()) {
@@ -187,10 +204,27 @@ public:
     }
 
 private:
+    // Whether to pack all outputs into one table. Each lookup then loads a single word.
+    bool packOutputs() const {
+        return m_outPackable && m_outVarps.size() > 1 && m_outWidthBits <= VL_QUADSIZE;
+    }
+
+    // Bytes in each entry of the packed table, with natural alignment
+    unsigned packedBytes() const {
+        return m_outWidthBits <= 8 ? 1 : m_outWidthBits <= 16 ? 2 : m_outWidthBits <= 32 ? 4 : 8;
+    }
+
+    // Bytes of data worth replacing an instruction, for a table of the given size
+    static double spaceTimeMult(double space) {
+        return TABLE_SPACE_TIME_MULT * std::min<double>(TABLE_CACHE_BYTES / space, 1.0);
+    }
+
     bool treeTest(AstAlways* nodep) {
         // Process alw/assign tree
         m_inWidthBits = 0;
         m_outWidthBytes = 0;
+        m_outWidthBits = 0;
+        m_outPackable = true;
         m_inVarps.clear();
         m_outVarps.clear();
 
@@ -205,7 +239,8 @@ private:
 
         // Calc data storage in bytes
         const size_t chgWidth = m_outVarps.size();
-        const double space = std::pow<double>(2.0, m_inWidthBits) * (m_outWidthBytes + chgWidth);
+        const unsigned entryBytes = packOutputs() ? packedBytes() : m_outWidthBytes;
+        const double space = std::pow<double>(2.0, m_inWidthBits) * (entryBytes + chgWidth);
         // Instruction count bytes (ok, it's space also not time :)
         const double time  // max(_, 1), so we won't divide by zero
             = std::max<double>(chkvis.instrCount() * TABLE_BYTES_PER_INST + chkvis.dataCount(), 1);
@@ -222,7 +257,7 @@ private:
         if (space > TABLE_MAX_BYTES) {
             chkvis.clearOptimizable(nodep, "Table takes too much space");
         }
-        if (space > time * TABLE_SPACE_TIME_MULT) {
+        if (space > time * spaceTimeMult(space)) {
             chkvis.clearOptimizable(nodep, "Table has bad tradeoff");
         }
         if (m_totalBytes > TABLE_TOTAL_BYTES) {
@@ -263,13 +298,27 @@ private:
             VL_MASK_I(m_inWidthBits));
 
         // Set sizes of output tables
-        for (TableOutputVar& tov : m_outVarps) tov.setTableSize(VL_MASK_I(m_inWidthBits));
+        TableBuilder packedTableBuilder{fl};
+        if (packOutputs()) {
+            ++m_statTablesPacked;
+            packedTableBuilder.setTableSize(
+                nodep->findBitDType(m_outWidthBits, m_outWidthBits, VSigning::UNSIGNED),
+                VL_MASK_I(m_inWidthBits));
+            int lsb = 0;
+            for (TableOutputVar& tov : m_outVarps) {
+                tov.packedLsb(lsb);
+                lsb += tov.varScopep()->width();
+            }
+        } else {
+            for (TableOutputVar& tov : m_outVarps) tov.setTableSize(VL_MASK_I(m_inWidthBits));
+        }
 
         // Populate the tables
-        createTables(nodep, outputAssignedTableBuilder);
+        createTables(nodep, outputAssignedTableBuilder, packedTableBuilder);
 
         AstNode* const stmtsp = createLookupInput(fl, indexVscp);
-        createOutputAssigns(nodep, stmtsp, indexVscp, outputAssignedTableBuilder.varScopep());
+        createOutputAssigns(nodep, stmtsp, indexVscp, outputAssignedTableBuilder,
+                            packedTableBuilder);
 
         // Link it in.
         // Keep sensitivity list, but delete all else
@@ -278,7 +327,8 @@ private:
         if (debug() >= 6) nodep->dumpTree("-  table_new: ");
     }
 
-    void createTables(AstAlways* nodep, TableBuilder& outputAssignedTableBuilder) {
+    void createTables(AstAlways* nodep, TableBuilder& outputAssignedTableBuilder,
+                      TableBuilder& packedTableBuilder) {
         // Create table
         // There may be a simulation path by which the output doesn't change value.
         // We could bail on these cases, or we can have a "change it" boolean.
@@ -315,12 +365,17 @@ private:
 
             // Build output value tables and the assigned flags table
             V3Number outputAssignedMask{nodep, static_cast<int>(m_outVarps.size()), 0};
+            V3Number packedValue{nodep, static_cast<int>(m_outWidthBits), 0};
             for (TableOutputVar& tov : m_outVarps) {
                 if (V3Number* const outnump = simvis.fetchOutNumberNull(tov.varScopep())) {
                     UINFO(8, "   Output " << tov.name() << " = " << *outnump << endl);
                     UASSERT_OBJ(!outnump->isAnyXZ(), outnump, "Table should not contain X/Z");
                     outputAssignedMask.setBit(tov.ord(), 1);  // Mark output as assigned
-                    tov.addValue(inValue, *outnump);
+                    if (tov.packedLsb() >= 0) {
+                        packedValue.opSelInto(*outnump, tov.packedLsb(), outnump->width());
+                    } else {
+                        tov.addValue(inValue, *outnump);
+                    }
                 } else {
                     UINFO(8, "   Output " << tov.name() << " not set for this input\n");
                     tov.setMayBeUnassigned();
@@ -329,6 +384,7 @@ private:
 
             // Set changed table
             outputAssignedTableBuilder.addValue(inValue, outputAssignedMask);
+            if (packOutputs()) packedTableBuilder.addValue(inValue, packedValue);
         }  // each value
     }
 
@@ -354,18 +410,41 @@ private:
         return new AstArraySel{fl, fromRefp, indexRefp};
     }
 
+    // Record use of a table from the constant pool, return it
+    AstVarScope* useTable(AstVarScope* tableVscp) {
+        if (!m_tables.emplace(tableVscp).second) {
+            // Identical to an earlier table, which already took the space
+            ++m_statTablesShared;
+            m_totalBytes -= tableVscp->varp()->dtypep()->widthTotalBytes();
+        }
+        return tableVscp;
+    }
+
     void createOutputAssigns(AstNode* nodep, AstNode* stmtsp, AstVarScope* indexVscp,
-                             AstVarScope* outputAssignedTableVscp) {
+                             TableBuilder& outputAssignedTableBuilder,
+                             TableBuilder& packedTableBuilder) {
         FileLine* const fl = nodep->fileline();
+        AstVarScope* const packedTableVscp
+            = packOutputs() ? useTable(packedTableBuilder.varScopep()) : nullptr;
+        AstVarScope* outputAssignedTableVscp = nullptr;
         for (TableOutputVar& tov : m_outVarps) {
             AstNodeExpr* const alhsp = new AstVarRef{fl, tov.varScopep(), VAccess::WRITE};
-            AstNodeExpr* const arhsp = select(fl, tov.tabeVarScopep(), indexVscp);
+            AstNodeExpr* arhsp = nullptr;
+            if (packedTableVscp) {
+                arhsp = new AstSel{fl, select(fl, packedTableVscp, indexVscp), tov.packedLsb(),
+                                   tov.varScopep()->width()};
+            } else {
+                arhsp = select(fl, useTable(tov.tabeVarScopep()), indexVscp);
+            }
             AstNode* outsetp = m_assignDly
                                    ? static_cast<AstNode*>(new AstAssignDly{fl, alhsp, arhsp})
                                    : static_cast<AstNode*>(new AstAssign{fl, alhsp, arhsp});
 
             // If this output is unassigned on some code paths, wrap the assignment in an If
             if (tov.mayBeUnassigned()) {
+                if (!outputAssignedTableVscp) {
+                    outputAssignedTableVscp = useTable(outputAssignedTableBuilder.varScopep());
+                }
                 V3Number outputChgMask{nodep, static_cast<int>(m_outVarps.size()), 0};
                 outputChgMask.setBit(tov.ord(), 1);
                 AstNodeExpr* const condp
@@ -411,6 +490,8 @@ public:
     explicit TableVisitor(AstNetlist* nodep) { iterate(nodep); }
     ~TableVisitor() override {  //
         V3Stats::addStat("Optimizations, Tables created", m_statTablesCre);
+        V3Stats::addStat("Optimizations, Tables packed", m_statTablesPacked);
+        V3Stats::addStat("Optimizations, Tables shared", m_statTablesShared);
     }
 };
 
@@ -375,6 +375,8 @@ class TaskVisitor final : public VNVisitor {
     DpiCFuncs m_dpiNames;  // Map of all created DPI functions
     VDouble0 m_statInlines;  // Statistic tracking
     VDouble0 m_statHierDpisWithCosts;  // Statistic tracking
+    VDouble0 m_statDpiZeroCopy;  // Statistic tracking
+    VDouble0 m_statDirectResults;  // Statistic tracking
 
     // METHODS
 
@@ -647,6 +649,7 @@ class TaskVisitor final : public VNVisitor {
         if (VN_IS(refp, New)) {
             AstCNew* const cnewp = new AstCNew{refp->fileline(), cfuncp};
             cnewp->dtypep(refp->dtypep());
+            cnewp->noEscape(VN_AS(refp, New)->noEscape());
             ccallp = cnewp;
             // Parent AstNew will replace with this CNew
             cnewpr = cnewp;
@@ -747,6 +750,38 @@ class TaskVisitor final : public VNVisitor {
         }
     }
 
+    // If the internal storage of the DPI import argument has the DPI C layout,
+    // return a C expression pointing at it, so it can be passed without a copy
+    static string dpiZeroCopyPtr(const AstVar* portp) {
+        if (portp->isFuncReturn() || portp->isDpiOpenArray()) return "";
+        const AstBasicDType* const basicp = portp->basicp();
+        if (!basicp) return "";
+        AstUnpackArrayDType* const unpackp
+            = VN_CAST(portp->dtypep()->skipRefp(), UnpackArrayDType);
+        const int width = portp->width();
+        if (basicp->isDpiBitVec()) {
+            // svBitVecVal words, as wide and 32-bit elements are stored
+            if (!unpackp && width <= VL_QUADSIZE) return "";  // Copy is cheap
+            if (width <= 16 || (width > VL_IDATASIZE && width <= VL_QUADSIZE)) return "";
+            // Unused top bits written by the callee would need masking
+            if (portp->isWritable() && width % VL_EDATASIZE) return "";
+        } else {
+            // Unpacked arrays of C types stored as the same C type
+            if (!unpackp) return "";
+            const VBasicDTypeKwd keyword = basicp->keyword();
+            if (keyword != VBasicDTypeKwd::BYTE && keyword != VBasicDTypeKwd::SHORTINT
+                && keyword != VBasicDTypeKwd::INT && keyword != VBasicDTypeKwd::LONGINT
+                && keyword != VBasicDTypeKwd::DOUBLE) {
+                return "";
+            }
+        }
+        string ptr = portp->name();
+        if (unpackp) {
+            for (int i = 0; i < unpackp->dimensions(false).second; ++i) ptr += "[0]";
+        }
+        return width > VL_QUADSIZE ? ptr + ".data()" : "&" + ptr;
+    }
+
     static AstNode* createDpiTemp(AstVar* portp, const string& suffix) {
         const string stmt = portp->dpiTmpVarType(portp->name() + suffix) + ";\n";
         return new AstCStmt{portp->fileline(), stmt};
@@ -845,24 +880,36 @@ class TaskVisitor final : public VNVisitor {
         return newp;
     }
 
-    AstCFunc* makeDpiExportDispatcher(AstNodeFTask* nodep, AstVar* rtnvarp) {
+    // With 'viaHandle', make the --dpi-export-handles variant, calling the export resolved
+    // in a VlDpiExportHandle instead of looking it up in the current DPI scope
+    AstCFunc* makeDpiExportDispatcher(AstNodeFTask* nodep, AstVar* rtnvarp, bool viaHandle) {
         // Verilog name has __ conversion and other tricks, to match DPI C code, back that out
         const string name = AstNode::prettyName(nodep->cname());
-        checkLegalCIdentifier(nodep, name);
+        if (!viaHandle) checkLegalCIdentifier(nodep, name);
         const char* const tmpSuffixp = V3Task::dpiTemporaryVarSuffix();
-        AstCFunc* const funcp = new AstCFunc{nodep->fileline(), name, m_scopep,
-                                             (rtnvarp ? rtnvarp->dpiArgType(true, true) : "")};
+        AstCFunc* const funcp
+            = new AstCFunc{nodep->fileline(), viaHandle ? name + "__Vcall" : name, m_scopep,
+                           (rtnvarp ? rtnvarp->dpiArgType(true, true) : "")};
+        if (viaHandle) funcp->argTypes("const VlDpiExportHandle* __Vhandlep");
         funcp->dpiExportDispatcher(true);
         funcp->dpiContext(nodep->dpiContext());
         funcp->dontCombine(true);
         funcp->entryPoint(true);
         funcp->isStatic(true);
         funcp->protect(false);
-        funcp->cname(name);
+        funcp->cname(funcp->name());
         // Add DPI Export to top, since it's a global function
         m_topScopep->scopep()->addBlocksp(funcp);
 
-        {  // Create dispatch wrapper
+        const string cbtype
+            = VIdProtect::protect(v3Global.opt.prefix() + "__Vcb_" + nodep->cname() + "_t");
+        if (viaHandle) {
+            // Resolved by the <name>__Vresolve function
+            const string stmt = "const VerilatedScope* __Vscopep"
+                                " = static_cast<const VerilatedScope*>(__Vhandlep->scopep);\n"
+                                + cbtype + " __Vcb = (" + cbtype + ")(__Vhandlep->cbp);\n";
+            funcp->addStmtsp(new AstCStmt{nodep->fileline(), stmt});
+        } else {  // Create dispatch wrapper
             // Note this function may dispatch to myfunc on a different class.
             // Thus we need to be careful not to assume a particular function layout.
             //
@@ -881,8 +928,6 @@ class TaskVisitor final : public VNVisitor {
             // If the find fails, it will throw an error
             stmt += "const VerilatedScope* __Vscopep = Verilated::dpiScope();\n";
             // If dpiScope is fails and is null; the exportFind function throws and error
-            const string cbtype
-                = VIdProtect::protect(v3Global.opt.prefix() + "__Vcb_" + nodep->cname() + "_t");
             stmt += cbtype + " __Vcb = (" + cbtype
                     + ")(VerilatedScope::exportFind(__Vscopep, __Vfuncnum));\n";  // Can't use
                                                                                   // static_cast
@@ -975,6 +1020,27 @@ class TaskVisitor final : public VNVisitor {
         return funcp;
     }
 
+    // Make the --dpi-export-handles function resolving the export in a scope into a handle
+    void makeDpiExportResolve(AstNodeFTask* nodep) {
+        const string name = AstNode::prettyName(nodep->cname()) + "__Vresolve";
+        AstCFunc* const funcp = new AstCFunc{nodep->fileline(), name, m_scopep, "int"};
+        funcp->argTypes("svScope __Vscope, VlDpiExportHandle* __Vhandlep");
+        funcp->dpiExportDispatcher(true);
+        funcp->dontCombine(true);
+        funcp->entryPoint(true);
+        funcp->isStatic(true);
+        funcp->protect(false);
+        funcp->cname(name);
+        m_topScopep->scopep()->addBlocksp(funcp);
+        // As in the dispatcher, the function number is only known at run time
+        string stmt = "static int __Vfuncnum = -1;\n";
+        stmt += "if (VL_UNLIKELY(__Vfuncnum == -1)) __Vfuncnum = Verilated::exportFuncNum(\""
+                + nodep->cname() + "\");\n";
+        stmt += "return VerilatedScope::exportResolve(static_cast<const "
+                "VerilatedScope*>(__Vscope), __Vfuncnum, __Vhandlep);\n";
+        funcp->addStmtsp(new AstCStmt{nodep->fileline(), stmt});
+    }
+
     AstCFunc* makeDpiImportPrototype(AstNodeFTask* nodep, AstVar* rtnvarp) {
         // Verilog name has __ conversion and other tricks, to match DPI C code, back that out
         const string name = AstNode::prettyName(nodep->cname());
@@ -1014,8 +1080,13 @@ class TaskVisitor final : public VNVisitor {
                                              std::forward_as_tuple(nodep, signature, nullptr));
         if (pair.second) {
             // First time encountering this cname. Create Import prototype / Export entry point
-            AstCFunc* const funcp = nodep->dpiExport() ? makeDpiExportDispatcher(nodep, rtnvarp)
-                                                       : makeDpiImportPrototype(nodep, rtnvarp);
+            AstCFunc* const funcp = nodep->dpiExport()
+                                        ? makeDpiExportDispatcher(nodep, rtnvarp, false)
+                                        : makeDpiImportPrototype(nodep, rtnvarp);
+            if (nodep->dpiExport() && v3Global.opt.dpiExportHandles()) {
+                makeDpiExportDispatcher(nodep, rtnvarp, true);
+                makeDpiExportResolve(nodep);
+            }
             std::get<2>(pair.first->second) = funcp;
             return funcp;
         } else {
@@ -1111,10 +1182,21 @@ class TaskVisitor final : public VNVisitor {
 
                         args += portp->name() + tmpSuffixp;
 
-                        cfuncp->addStmtsp(createDpiTemp(portp, tmpSuffixp));
-                        if (portp->isNonOutput()) {
-                            cfuncp->addStmtsp(
-                                createAssignInternalToDpi(portp, false, "", tmpSuffixp));
+                        const string zeroCopyPtr = dpiZeroCopyPtr(portp);
+                        if (!zeroCopyPtr.empty()) {
+                            // Point the DPI temporary at the internal storage
+                            const string type = portp->dpiArgType(false, false);
+                            const string stmt = type + " const " + portp->name() + tmpSuffixp
+                                                + " = reinterpret_cast<" + type + ">("
+                                                + zeroCopyPtr + ");\n";
+                            cfuncp->addStmtsp(new AstCStmt{portp->fileline(), stmt});
+                            ++m_statDpiZeroCopy;
+                        } else {
+                            cfuncp->addStmtsp(createDpiTemp(portp, tmpSuffixp));
+                            if (portp->isNonOutput()) {
+                                cfuncp->addStmtsp(
+                                    createAssignInternalToDpi(portp, false, "", tmpSuffixp));
+                            }
                         }
                     }
                 }
@@ -1149,6 +1231,8 @@ class TaskVisitor final : public VNVisitor {
                     && !portp->isDpiOpenArray()) {
                     AstVarScope* const portvscp = VN_AS(
                         portp->user2p(), VarScope);  // Remembered when we created it earlier
+                    // Zero-copy arguments were written in place
+                    if (portvscp != rtnvscp && !dpiZeroCopyPtr(portp).empty()) continue;
                     cfuncp->addStmtsp(
                         createAssignDpiToInternal(portvscp, portp->name() + tmpSuffixp));
                 }
@@ -1272,6 +1356,7 @@ class TaskVisitor final : public VNVisitor {
         }
         cfuncp->isVirtual(nodep->isVirtual());
         cfuncp->dpiPure(nodep->dpiPure());
+        cfuncp->dpiThreads(nodep->dpiThreads());
         if (nodep->name() == "new") cfuncp->isConstructor(true);
         if (cfuncp->dpiExportImpl()) cfuncp->cname(nodep->cname());
 
@@ -1418,6 +1503,47 @@ class TaskVisitor final : public VNVisitor {
         m_scopep = m_statep->getScope(nodep);
         iterate(nodep);
     }
+    // If the value of the given function call is assigned straight into a variable the callee
+    // cannot observe, return that variable, so the result can be written in place instead of
+    // being copied through a temporary. Only done for values that are costly to copy.
+    static AstVarScope* directOutVscp(AstNodeFTaskRef* refp) {
+        if (VN_IS(refp, New)) return nullptr;
+        const AstAssign* const assignp = VN_CAST(refp->backp(), Assign);
+        if (!assignp || assignp->rhsp() != refp || assignp->timingControlp()) return nullptr;
+        const AstVarRef* const lhsp = VN_CAST(assignp->lhsp(), VarRef);
+        if (!lhsp) return nullptr;
+        const AstVar* const varp = lhsp->varp();
+        // Function locals (other than ports, which alias the caller's storage) and
+        // compiler temporaries are not visible to the callee
+        if (!(varp->isFuncLocal() && !varp->isIO())
+            && varp->varType() != VVarType::BLOCKTEMP) {
+            return nullptr;
+        }
+        const AstNodeDType* const dtypep = varp->dtypep()->skipRefp();
+        if (dtypep->isIntegralOrPacked() && !dtypep->isWide()) return nullptr;
+        const AstNodeDType* const fdtypep = refp->taskp()->fvarp()->dtypep()->skipRefp();
+        const bool samePacked = dtypep->isIntegralOrPacked() && fdtypep->isIntegralOrPacked()
+                                && dtypep->width() == fdtypep->width();
+        if (!samePacked && !dtypep->similarDType(fdtypep)) return nullptr;
+        // The callee may read the arguments (or the object) after writing the result
+        if (refp->exists([varp](const AstVarRef* vrefp) { return vrefp->varp() == varp; })) {
+            return nullptr;
+        }
+        return lhsp->varScopep();
+    }
+    // Wrap a read of a function result temporary so that it is moved out, not copied
+    static AstNodeExpr* moveIfOwning(AstVarRef* refp) {
+        const AstNodeDType* const dtypep = refp->dtypep()->skipRefp();
+        if (!dtypep->isString() && !VN_IS(dtypep, QueueDType)) return refp;
+        FileLine* const flp = refp->fileline();
+        AstCExpr* const newp = new AstCExpr{flp, nullptr};
+        newp->addExprsp(new AstText{flp, "std::move(", true});
+        newp->addExprsp(refp);
+        newp->addExprsp(new AstText{flp, ")", true});
+        newp->dtypeFrom(refp);
+        return newp;
+    }
+
     void insertBeforeStmt(AstNode* nodep, AstNode* newp) {
         if (debug() >= 9) nodep->dumpTree("-  newstmt: ");
         UASSERT_OBJ(m_insStmtp, nodep, "Function call not underneath a statement");
@@ -1465,10 +1591,15 @@ class TaskVisitor final : public VNVisitor {
                                    + nodep->taskp()->shortName() + "__" + cvtToStr(m_modNCalls++));
         // Create output variable
         AstVarScope* outvscp = nullptr;
+        bool direct = false;  // Result is written directly into the assigned variable
         if (nodep->taskp()->isFunction()) {
             // Not that it's a FUNCREF, but that we're calling a function (perhaps as a task)
-            outvscp
-                = createVarScope(VN_AS(nodep->taskp()->fvarp(), Var), namePrefix + "__Vfuncout");
+            outvscp = directOutVscp(nodep);
+            direct = outvscp != nullptr;
+            if (!direct) {
+                outvscp = createVarScope(VN_AS(nodep->taskp()->fvarp(), Var),
+                                         namePrefix + "__Vfuncout");
+            }
         }
         // Create cloned statements
         AstNode* beginp;
@@ -1489,10 +1620,27 @@ class TaskVisitor final : public VNVisitor {
         } else if (VN_IS(nodep->backp(), NodeAssign)) {
             UASSERT_OBJ(nodep->taskp()->isFunction(), nodep,
                         "funcref-like assign to non-function");
+            if (direct) {
+                // The function may update its result piecewise, so start from the same default
+                // value a fresh temporary would have
+                FileLine* const flp = nodep->fileline();
+                insertBeforeStmt(
+                    nodep, new AstCReset{flp, new AstVarRef{flp, outvscp, VAccess::WRITE}, false});
+            }
             insertBeforeStmt(nodep, beginp);
-            AstVarRef* const outrefp = new AstVarRef{nodep->fileline(), outvscp, VAccess::READ};
-            nodep->replaceWith(outrefp);
-            VL_DO_DANGLING(nodep->deleteTree(), nodep);
+            if (direct) {
+                // Already written by the call, the assignment is redundant
+                ++m_statDirectResults;
+                AstNode* const assignp = nodep->backp()->unlinkFrBack();
+                VL_DO_DANGLING(pushDeletep(assignp), assignp);
+                VL_DANGLING(nodep);
+            } else {
+                AstVarRef* const outrefp
+                    = new AstVarRef{nodep->fileline(), outvscp, VAccess::READ};
+                nodep->replaceWith(VN_IS(nodep->backp(), Assign) ? moveIfOwning(outrefp)
+                                                                 : outrefp);
+                VL_DO_DANGLING(nodep->deleteTree(), nodep);
+            }
         } else if (!VN_IS(nodep->backp(), StmtExpr)) {
             UASSERT_OBJ(nodep->taskp()->isFunction(), nodep,
                         "funcref-like expression to non-function");
@@ -1635,6 +1783,9 @@ public:
         V3Stats::addStat("Optimizations, Functions inlined", m_statInlines);
         V3Stats::addStat("Optimizations, Hierarchical DPI wrappers with costs",
                          m_statHierDpisWithCosts);
+        V3Stats::addStat("Optimizations, DPI arguments passed without copy", m_statDpiZeroCopy);
+        V3Stats::addStat("Optimizations, Function results written in place",
+                         m_statDirectResults);
     }
 };
 
@@ -16,9 +16,11 @@
 
 #include "V3ThreadPool.h"
 
+#include "V3Ast.h"
 #include "V3Error.h"
 #include "V3Global.h"
 #include "V3Mutex.h"
+#include "V3ProfVerilation.h"
 
 V3ThreadPool::V3ThreadPool(int numThreads) {
     numThreads = std::max(numThreads, 1);
@@ -163,6 +165,14 @@ V3ThreadScope::V3ThreadScope() {
     wait();
 }
 
-void V3ThreadScope::enqueue(std::function<void()>&& f) { m_pool->enqueue(std::move(f)); }
+void V3ThreadScope::enqueue(std::function<void()>&& f) {
+    // Job uses the AstNode user#() in use by this thread, see VNUserInUseBase
+    const VNUserInUseBase::ThreadState state = VNUserInUseBase::threadState();
+    m_pool->enqueue([state, f = std::move(f)]() {
+        VNUserInUseBase::threadState(state);
+        const V3ProfVerilationScope profScope{"job", "V3ThreadPool job"};
+        f();
+    });
+}
 
 void V3ThreadScope::wait() { m_pool->wait(); }
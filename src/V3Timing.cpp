@@ -468,6 +468,7 @@ class TimingControlVisitor final : public VNVisitor {
     AstActive* m_activep = nullptr;  // Current active
     AstNode* m_procp = nullptr;  // NodeProcedure/CFunc/Begin we're under
     int m_forkCnt = 0;  // Number of forks inside a module
+    uint32_t m_periodicCnt = 0;  // Number of periodic processes, for their ids
     bool m_underJumpBlock = false;  // True if we are inside of a jump-block
     bool m_underProcedure = false;  // True if we are under an always or initial
 
@@ -575,6 +576,106 @@ class TimingControlVisitor final : public VNVisitor {
         m_netlistp->topScopep()->addSenTreesp(m_dynamicSensesp);
         return m_dynamicSensesp;
     }
+    // Returns true if the statements can run without a coroutine: no timing controls, calls,
+    // or methods, which might suspend, need the process, or fire events
+    static bool isPeriodicStmt(AstNode* stmtp) {
+        return stmtp->forall([](const AstNode* nodep) {
+            if (const AstNodeAssign* const assignp = VN_CAST(nodep, NodeAssign)) {
+                return !assignp->timingControlp();
+            }
+            if (VN_IS(nodep, NodeExpr)) {
+                return !VN_IS(nodep, NodeCCall) && !VN_IS(nodep, CMethodHard)
+                       && !VN_IS(nodep, NodeFTaskRef);
+            }
+            return VN_IS(nodep, If) || VN_IS(nodep, Display) || VN_IS(nodep, Finish)
+                   || VN_IS(nodep, Stop);
+        });
+    }
+    static bool isPeriodicBody(AstNode* stmtsp) {
+        for (AstNode* stmtp = stmtsp; stmtp; stmtp = stmtp->nextp()) {
+            if (!isPeriodicStmt(stmtp)) return false;
+        }
+        return true;
+    }
+    // If the statements are '#<constant> <body>', with a body suitable for isPeriodicBody,
+    // return the scaled delay, else return 0
+    uint64_t periodicDelay(AstNode* stmtsp) const {
+        AstDelay* const delayp = VN_CAST(stmtsp, Delay);
+        if (!delayp || delayp->isCycleDelay()) return 0;
+        if (!delayp->stmtsp() && !delayp->nextp()) return 0;
+        if (!isPeriodicBody(delayp->stmtsp()) || !isPeriodicBody(delayp->nextp())) return 0;
+        const AstConst* const constp = VN_CAST(delayp->lhsp(), Const);
+        if (!constp || constp->dtypep()->skipRefp()->isDouble() || constp->width() > 64
+            || constp->num().isFourState()) {
+            return 0;
+        }
+        const double timescaleFactor = calculateTimescaleFactor(delayp, delayp->timeunit());
+        return constp->toUQuad() * static_cast<uint64_t>(timescaleFactor);
+    }
+    // Replace the loop statements '#<delay> <body>' accepted by periodicDelay with a plain
+    // always block triggered by a periodic process of the delay scheduler.
+    // Returns the statement starting the periodic process, to run once when the loop is entered.
+    AstNodeStmt* createPeriodic(AstNode* stmtsp, uint64_t period) {
+        AstDelay* const delayp = VN_AS(stmtsp, Delay);
+        FileLine* const flp = delayp->fileline();
+        const uint32_t id = m_periodicCnt++;
+        AstNode* bodysp = nullptr;
+        if (delayp->stmtsp()) bodysp = delayp->stmtsp()->unlinkFrBackWithNext();
+        if (delayp->nextp()) {
+            bodysp = AstNode::addNext(bodysp, delayp->nextp()->unlinkFrBackWithNext());
+        }
+        // The trigger is true, once, in each time slot the process is due
+        auto* const triggeredp = new AstCMethodHard{
+            flp, new AstVarRef{flp, getCreateDelayScheduler(), VAccess::READ},
+            "periodicTriggered", new AstConst{flp, id}};
+        triggeredp->dtypeSetBit();
+        AstSenTree* const sensesp
+            = new AstSenTree{flp, new AstSenItem{flp, VEdgeType::ET_TRUE, triggeredp}};
+        m_netlistp->topScopep()->addSenTreesp(sensesp);
+        auto* const activep = new AstActive{flp, "periodic", sensesp};
+        activep->addStmtsp(new AstAlways{flp, VAlwaysKwd::ALWAYS, nullptr, bodysp});
+        m_activep->addNextHere(activep);
+        // Start the process
+        auto* const startp = new AstCMethodHard{
+            flp, new AstVarRef{flp, getCreateDelayScheduler(), VAccess::WRITE}, "periodic",
+            new AstConst{flp, id}};
+        startp->addPinsp(new AstConst{flp, AstConst::Unsized64{}, period});
+        startp->dtypeSetVoid();
+        return startp->makeStmt();
+    }
+    // Lower 'always #<constant> <body>' to a periodic process, returns true if done
+    bool makePeriodicAlways(AstAlways* nodep) {
+        if (m_classp || hasFlags(nodep, T_HAS_PROC)) return false;
+        if (!m_activep->sensesp()->hasInitial()) return false;
+        const uint64_t period = periodicDelay(nodep->stmtsp());
+        if (!period) return false;
+        UINFO(4, "Periodic always: " << nodep << "\n");
+        AstNodeStmt* const startp = createPeriodic(nodep->stmtsp(), period);
+        nodep->replaceWith(new AstInitial{nodep->fileline(), startp});
+        VL_DO_DANGLING(pushDeletep(nodep), nodep);
+        return true;
+    }
+    // Lower an initial ending with 'forever #<constant> <body>', and otherwise without timing
+    // controls, to a periodic process
+    void makePeriodicInitial(AstInitial* nodep) {
+        if (m_classp || hasFlags(nodep, T_HAS_PROC) || !hasFlags(nodep, T_SUSPENDEE)) return;
+        AstNode* lastp = nodep->stmtsp();
+        if (!lastp) return;
+        for (; lastp->nextp(); lastp = lastp->nextp()) {
+            if (!isPeriodicStmt(lastp)) return;
+        }
+        AstWhile* const loopp = VN_CAST(lastp, While);
+        if (!loopp || loopp->precondsp() || loopp->incsp()) return;
+        const AstConst* const condp = VN_CAST(loopp->condp(), Const);
+        if (!condp || !condp->num().isNeqZero()) return;
+        const uint64_t period = periodicDelay(loopp->stmtsp());
+        if (!period) return;
+        UINFO(4, "Periodic initial: " << nodep << "\n");
+        loopp->replaceWith(createPeriodic(loopp->stmtsp(), period));
+        VL_DO_DANGLING(pushDeletep(loopp), loopp);
+        // Nothing is left to suspend
+        nodep->user2(nodep->user2() & ~(T_SUSPENDEE | T_SUSPENDER));
+    }
     // Creates the event variable to trigger in NBA region
     AstEventControl* createNbaEventControl(FileLine* flp) {
         if (!m_netlistp->nbaEventp()) {
@@ -610,6 +711,23 @@ class TimingControlVisitor final : public VNVisitor {
             return !nodep->isPure();
         });
     }
+    // Returns the event expression if the given sentree is a single named event that needs a
+    // dynamic trigger, and can be waited on directly instead. Otherwise returns nullptr.
+    AstNodeExpr* directEventp(AstSenTree* const sensesp) const {
+        if (v3Global.assignsEvents()) return nullptr;  // VlAssignableEvent keeps no waiters
+        if (!needDynamicTrigger(sensesp)) return nullptr;
+        const AstSenItem* const itemp = sensesp->sensesp();
+        if (!itemp || itemp->nextp() || itemp->edgeType() != VEdgeType::ET_EVENT) return nullptr;
+        AstNodeExpr* const exprp = itemp->sensp();
+        const AstBasicDType* const dtypep = exprp->dtypep()->basicp();
+        if (!dtypep || !dtypep->isEvent()) return nullptr;
+        // Locals would take their waiters with them when going out of scope
+        const bool hasLocal = exprp->exists([](const AstNodeVarRef* const refp) {
+            return refp->varp()->isFuncLocal();
+        });
+        if (hasLocal || !exprp->isPure()) return nullptr;
+        return exprp;
+    }
     // Returns true if the given trigger expression needs a destructive post update after trigger
     // evaluation. Currently this only applies to named events.
     bool destructivePostUpdate(AstNode* const exprp) const {
@@ -786,6 +904,7 @@ class TimingControlVisitor final : public VNVisitor {
         if (hasFlags(nodep, T_HAS_PROC)) nodep->setNeedProcess();
     }
     void visit(AstInitial* nodep) override {
+        makePeriodicInitial(nodep);
         visit(static_cast<AstNodeProcedure*>(nodep));
         if (nodep->needProcess() && !nodep->user1SetOnce()) {
             nodep->addStmtsp(
@@ -799,6 +918,7 @@ class TimingControlVisitor final : public VNVisitor {
     }
     void visit(AstAlways* nodep) override {
         if (nodep->user1SetOnce()) return;
+        if (makePeriodicAlways(nodep)) return;
         VL_RESTORER(m_procp);
         m_procp = nodep;
         VL_RESTORER(m_underProcedure);
@@ -909,7 +1029,20 @@ class TimingControlVisitor final : public VNVisitor {
         FileLine* const flp = nodep->fileline();
         // Relink child statements after the event control
         if (nodep->stmtsp()) nodep->addNextHere(nodep->stmtsp()->unlinkFrBackWithNext());
-        if (needDynamicTrigger(nodep->sensesp())) {
+        if (AstNodeExpr* const eventp = directEventp(nodep->sensesp())) {
+            // Await the event firing with the dynamic trigger scheduler, without re-evaluating a
+            // trigger on every scheduling iteration
+            auto* const firedMethodp = new AstCMethodHard{
+                flp, new AstVarRef{flp, getCreateDynamicTriggerScheduler(), VAccess::WRITE},
+                "eventFired", eventp->cloneTree(false)};
+            firedMethodp->dtypeSetVoid();
+            addProcessInfo(firedMethodp);
+            addEventDebugInfo(firedMethodp, nodep->sensesp());
+            AstCAwait* const awaitp
+                = new AstCAwait{flp, firedMethodp, getCreateDynamicTriggerSenTree()};
+            awaitp->dtypeSetVoid();
+            nodep->replaceWith(awaitp->makeStmt());
+        } else if (needDynamicTrigger(nodep->sensesp())) {
             // Create the trigger variable and init it with 0
             AstVarScope* const trigvscp
                 = createTemp(flp, m_dynTrigNames.get(nodep), nodep->findBitDType(), nodep);
@@ -179,17 +179,28 @@ class TraceVisitor final : public VNVisitor {
     AstTraceDecl* m_tracep = nullptr;  // Trace function adding to graph
     AstVarScope* m_activityVscp = nullptr;  // Activity variable
     uint32_t m_activityNumber = 0;  // Count of fields in activity variable
+    AstVarScope* m_actGroupVscp = nullptr;  // Activity group variable
+    // Activity groups, each gating a run of activity checks in a trace_chg sub function
+    struct ActivityGroup final {
+        AstIf* m_ifp;  // Gate of the group
+        std::set<uint32_t> m_codes;  // Activity codes of the checks inside
+    };
+    std::vector<ActivityGroup> m_actGroups;
+    std::vector<std::vector<uint32_t>> m_codeGroups;  // Activity code -> groups containing it
     uint32_t m_code = 0;  // Trace ident code# being assigned
     V3Graph m_graph;  // Var/CFunc tracking
     TraceActivityVertex* const m_alwaysVtxp;  // "Always trace" vertex
     bool m_finding = false;  // Pass one of algorithm?
 
+    // Maximum number of activity checks gated by one activity group
+    static constexpr int ACTIVITY_GROUP_CHECKS = 16;
+
     // Trace parallelism. Only VCD tracing can be parallelized at this time.
-    const uint32_t m_parallelism
-        = v3Global.opt.useTraceParallel() ? static_cast<uint32_t>(v3Global.opt.threads()) : 1;
+    const uint32_t m_parallelism = v3Global.opt.traceParallelism();
 
     VDouble0 m_statSetters;  // Statistic tracking
     VDouble0 m_statSettersSlow;  // Statistic tracking
+    VDouble0 m_statActGroups;  // Statistic tracking
     VDouble0 m_statUniqCodes;  // Statistic tracking
     VDouble0 m_statUniqSigs;  // Statistic tracking
 
@@ -398,11 +409,20 @@ class TraceVisitor final : public VNVisitor {
         return new AstArraySel(flp, new AstVarRef{flp, m_activityVscp, access}, acode);
     }
 
+    AstNodeExpr* selectActGroup(FileLine* flp, uint32_t group, const VAccess& access) {
+        return new AstArraySel(flp, new AstVarRef{flp, m_actGroupVscp, access}, group);
+    }
+
     AstNode* newActivitySetter(AstNode* insertp, uint32_t code) {
         ++m_statSetters;
         FileLine* const fl = insertp->fileline();
-        AstAssign* const setterp = new AstAssign{fl, selectActivity(fl, code, VAccess::WRITE),
-                                                 new AstConst{fl, AstConst::BitTrue{}}};
+        AstNode* const setterp = new AstAssign{fl, selectActivity(fl, code, VAccess::WRITE),
+                                               new AstConst{fl, AstConst::BitTrue{}}};
+        // Also set the activity groups checking this code
+        for (const uint32_t group : m_codeGroups[code]) {
+            setterp->addNext(new AstAssign{fl, selectActGroup(fl, group, VAccess::WRITE),
+                                           new AstConst{fl, AstConst::BitTrue{}}});
+        }
         return setterp;
     }
 
@@ -426,10 +446,7 @@ class TraceVisitor final : public VNVisitor {
         return callp->makeStmt();
     }
 
-    void createActivityFlags() {
-        // Assign final activity numbers
-        m_activityNumber = assignactivityNumbers();
-
+    AstVarScope* newActivityVar(const string& name, uint32_t size) {
         // Create an array of bytes, not a bit vector, as they can be set
         // atomically by mtasks, and are cheaper to set (no need for
         // read-modify-write on the C type), and the speed of the tracing code
@@ -438,17 +455,50 @@ class TraceVisitor final : public VNVisitor {
         AstNodeDType* const newScalarDtp = new AstBasicDType{flp, VFlagBitPacked{}, 1};
         v3Global.rootp()->typeTablep()->addTypesp(newScalarDtp);
         AstRange* const newArange
-            = new AstRange{flp, VNumRange{static_cast<int>(m_activityNumber) - 1, 0}};
+            = new AstRange{flp, VNumRange{static_cast<int>(size) - 1, 0}};
         AstNodeDType* const newArrDtp = new AstUnpackArrayDType{flp, newScalarDtp, newArange};
         v3Global.rootp()->typeTablep()->addTypesp(newArrDtp);
-        AstVar* const newvarp
-            = new AstVar{flp, VVarType::MODULETEMP, "__Vm_traceActivity", newArrDtp};
+        AstVar* const newvarp = new AstVar{flp, VVarType::MODULETEMP, name, newArrDtp};
         m_topModp->addStmtsp(newvarp);
         AstVarScope* const newvscp = new AstVarScope{flp, m_topScopep, newvarp};
         m_topScopep->addVarsp(newvscp);
-        m_activityVscp = newvscp;
+        return newvscp;
+    }
+
+    void createActivityFlags() {
+        // Assign final activity numbers
+        m_activityNumber = assignactivityNumbers();
+        m_activityVscp = newActivityVar("__Vm_traceActivity", m_activityNumber);
+        m_codeGroups.resize(m_activityNumber);
+    }
+
+    void createActivityGroups() {
+        // Gate each group of activity checks on one flag, set whenever any of
+        // the group's activity flags are set, forming a two level activity tree.
+        // Groups with a single check gain nothing, so remove them.
+        std::vector<ActivityGroup> groups;
+        for (ActivityGroup& group : m_actGroups) {
+            if (group.m_ifp->thensp()->nextp()) {
+                groups.push_back(group);
+            } else {
+                group.m_ifp->replaceWith(group.m_ifp->thensp()->unlinkFrBack());
+                VL_DO_DANGLING(group.m_ifp->deleteTree(), group.m_ifp);
+            }
+        }
+        m_actGroups = std::move(groups);
+        if (m_actGroups.empty()) return;
+        m_actGroupVscp = newActivityVar("__Vm_traceActivityGroup", m_actGroups.size());
+        for (uint32_t i = 0; i < m_actGroups.size(); ++i) {
+            const ActivityGroup& group = m_actGroups[i];
+            FileLine* const flp = group.m_ifp->fileline();
+            group.m_ifp->condp()->unlinkFrBack()->deleteTree();
+            group.m_ifp->condp(selectActGroup(flp, i, VAccess::READ));
+            for (const uint32_t code : group.m_codes) m_codeGroups[code].push_back(i);
+            ++m_statActGroups;
+        }
+    }
 
-        // Insert activity setters
+    void insertActivitySetters() {
         for (const V3GraphVertex& vtx : m_graph.vertices()) {
             if (const TraceActivityVertex* const vtxp = vtx.cast<const TraceActivityVertex>()) {
                 AstNode* setterp = nullptr;
@@ -469,7 +519,7 @@ class TraceVisitor final : public VNVisitor {
                             funcp->stmtsp()->foreachAndNext([&](AstCAwait* awaitp) {
                                 AstNode* stmtp = awaitp->backp();
                                 while (VN_IS(stmtp, NodeExpr)) stmtp = stmtp->backp();
-                                stmtp->addNextHere(setterp->cloneTree(false));
+                                stmtp->addNextHere(setterp->cloneTree(true));
                             });
                         }
                         funcp->addStmtsp(setterp);
@@ -572,11 +622,24 @@ class TraceVisitor final : public VNVisitor {
         return funcp;
     }
 
-    void createConstTraceFunctions(const TraceVec& traces) {
+    void createConstTraceFunctions(const TraceVec& traces, uint32_t parallelism) {
         const int splitLimit = v3Global.opt.outputSplitCTrace() ? v3Global.opt.outputSplitCTrace()
                                                                 : std::numeric_limits<int>::max();
 
-        AstCFunc* const topFuncp = newCFunc(VTraceType::CONSTANT, nullptr, 0);
+        // Partition the constant signals between top functions as with the full dump,
+        // so the first dump can render them in parallel
+        uint32_t nConstCodes = 0;
+        for (const auto& pair : traces) {
+            if (pair.first.count(TraceActivityVertex::ACTIVITY_NEVER)
+                && !pair.second->duplicatep()) {
+                nConstCodes += pair.second->nodep()->codeInc();
+            }
+        }
+        const uint32_t maxCodes = std::max((nConstCodes + parallelism - 1) / parallelism, 1U);
+        uint32_t nCodes = 0;
+
+        uint32_t topFuncNum = 0;
+        AstCFunc* topFuncp = newCFunc(VTraceType::CONSTANT, nullptr, topFuncNum);
         uint32_t subFuncNum = 0;
         AstCFunc* subFuncp = nullptr;
         int subStmts = 0;
@@ -592,6 +655,7 @@ class TraceVisitor final : public VNVisitor {
                 UASSERT_OBJ(canonDeclp->code() != 0, canonDeclp,
                             "Canonical node should have code assigned already");
                 declp->code(canonDeclp->code());
+                declp->fidx(canonDeclp->fidx());  // Set again for non-constants
                 continue;
             }
 
@@ -607,6 +671,14 @@ class TraceVisitor final : public VNVisitor {
             // If this is a const signal, add the AstTraceInc
             const ActCodeSet& actSet = it->first;
             if (actSet.count(TraceActivityVertex::ACTIVITY_NEVER)) {
+                // Create new top function if required
+                if (nCodes >= maxCodes) {
+                    ++topFuncNum;
+                    topFuncp = newCFunc(VTraceType::CONSTANT, nullptr, topFuncNum);
+                    subFuncNum = 0;
+                    subFuncp = nullptr;
+                    nCodes = 0;
+                }
                 // Crate new sub function if required
                 if (!subFuncp || subStmts > splitLimit) {
                     subStmts = 0;
@@ -617,6 +689,8 @@ class TraceVisitor final : public VNVisitor {
                 AstTraceInc* const incp = new AstTraceInc{flp, declp, VTraceType::CONSTANT};
                 subFuncp->addStmtsp(incp);
                 subStmts += incp->nodeCount();
+                declp->fidx(topFuncNum);
+                nCodes += codeInc;
             }
         }
     }
@@ -640,6 +714,8 @@ class TraceVisitor final : public VNVisitor {
             uint32_t nCodes = 0;
             const ActCodeSet* prevActSet = nullptr;
             AstIf* ifp = nullptr;
+            AstIf* groupIfp = nullptr;  // Current activity group
+            int groupChecks = 0;  // Activity checks in current group
             uint32_t baseCode = 0;
             for (; nCodes < maxCodes && it != traces.end(); ++it) {
                 const ActCodeSet& actSet = it->first;
@@ -672,6 +748,7 @@ class TraceVisitor final : public VNVisitor {
                     ++subFuncNum;
                     prevActSet = nullptr;
                     ifp = nullptr;
+                    groupIfp = nullptr;
                 }
 
                 // If required, create the conditional node checking the activity flags
@@ -688,8 +765,23 @@ class TraceVisitor final : public VNVisitor {
                         }
                     }
                     ifp = new AstIf{flp, condp};
-                    if (!always) ifp->branchPred(VBranchPred::BP_UNLIKELY);
-                    subChgFuncp->addStmtsp(ifp);
+                    if (always) {
+                        subChgFuncp->addStmtsp(ifp);
+                        groupIfp = nullptr;
+                    } else {
+                        ifp->branchPred(VBranchPred::BP_UNLIKELY);
+                        // Add to an activity group, the condition is set by createActivityGroups
+                        if (!groupIfp || groupChecks >= ACTIVITY_GROUP_CHECKS) {
+                            groupIfp = new AstIf{flp, new AstConst{flp, AstConst::BitTrue{}}};
+                            groupIfp->branchPred(VBranchPred::BP_UNLIKELY);
+                            subChgFuncp->addStmtsp(groupIfp);
+                            m_actGroups.push_back(ActivityGroup{groupIfp, {}});
+                            groupChecks = 0;
+                        }
+                        groupIfp->addThensp(ifp);
+                        m_actGroups.back().m_codes.insert(actSet.begin(), actSet.end());
+                        ++groupChecks;
+                    }
                     subStmts += ifp->nodeCount();
                     prevActSet = &actSet;
                 }
@@ -739,6 +831,9 @@ class TraceVisitor final : public VNVisitor {
         m_regFuncp->addStmtsp(new AstText{fl, "tracep->addCleanupCb(", true});
         m_regFuncp->addStmtsp(new AstAddrOfCFunc{fl, cleanupFuncp});
         m_regFuncp->addStmtsp(new AstText{fl, ", vlSelf);\n", true});
+        // Register global activity flag, so dumps may be skipped if not evaluated
+        m_regFuncp->addStmtsp(
+            new AstText{fl, "tracep->addActivityFlag(&vlSelf->vlSymsp->__Vm_activity);\n", true});
 
         // Clear global activity flag
         cleanupFuncp->addStmtsp(
@@ -750,6 +845,11 @@ class TraceVisitor final : public VNVisitor {
                                                 new AstConst{fl, AstConst::BitFalse{}}};
             cleanupFuncp->addStmtsp(clrp);
         }
+        for (uint32_t i = 0; i < m_actGroups.size(); ++i) {
+            AstNode* const clrp = new AstAssign{fl, selectActGroup(fl, i, VAccess::WRITE),
+                                                new AstConst{fl, AstConst::BitFalse{}}};
+            cleanupFuncp->addStmtsp(clrp);
+        }
     }
 
     void createTraceFunctions() {
@@ -789,11 +889,15 @@ class TraceVisitor final : public VNVisitor {
         m_topScopep->addBlocksp(m_regFuncp);
 
         // Create the const dump functions. Also allocates trace codes.
-        createConstTraceFunctions(traces);
+        createConstTraceFunctions(traces, m_parallelism);
 
         // Create the full and incremental dump functions
         createNonConstTraceFunctions(traces, nNonConstCodes, m_parallelism);
 
+        // Gate groups of activity checks, then set the flags where activity happens
+        createActivityGroups();
+        insertActivitySetters();
+
         // Remove refs to traced values from TraceDecl nodes, these have now moved under
         // TraceInc
         for (const auto& i : traces) {
@@ -935,6 +1039,7 @@ public:
     ~TraceVisitor() override {
         V3Stats::addStat("Tracing, Activity setters", m_statSetters);
         V3Stats::addStat("Tracing, Activity slow blocks", m_statSettersSlow);
+        V3Stats::addStat("Tracing, Activity groups", m_statActGroups);
         V3Stats::addStat("Tracing, Unique trace codes", m_statUniqCodes);
         V3Stats::addStat("Tracing, Unique traced signals", m_statUniqSigs);
     }
@@ -466,6 +466,18 @@ class TristateVisitor final : public TristateBaseVisitor {
         AstConst* const newp = new AstConst{nodep->fileline(), num};
         return newp;
     }
+    static AstNodeExpr* newOrTree(const std::vector<AstNodeExpr*>& termps, size_t begin,
+                                  size_t end) {
+        // Or of termps[begin..end), as a balanced tree, so nets with many
+        // drivers are not resolved by an expression as deep as the drivers
+        if (end - begin == 1) return termps[begin];
+        const size_t mid = begin + (end - begin) / 2;
+        AstNodeExpr* const lhsp = newOrTree(termps, begin, mid);
+        return new AstOr{lhsp->fileline(), lhsp, newOrTree(termps, mid, end)};
+    }
+    static AstNodeExpr* newOrTree(const std::vector<AstNodeExpr*>& termps) {
+        return newOrTree(termps, 0, termps.size());
+    }
     AstNodeExpr* getEnp(AstNode* nodep) {
         if (nodep->user1p()) {
             if (AstVarRef* const refp = VN_CAST(nodep, VarRef)) {
@@ -659,8 +671,8 @@ class TristateVisitor final : public TristateBaseVisitor {
         // For each driver separate variables (normal and __en) are created and initialized with
         // values. In case of normal variable, the original expression is reused. Their values are
         // aggregated using | to form one expression, which are assigned to varp end envarp.
-        AstNodeExpr* orp = nullptr;
-        AstNodeExpr* enp = nullptr;
+        std::vector<AstNodeExpr*> orps;
+        std::vector<AstNodeExpr*> enps;
 
         for (auto it = beginStrength; it != endStrength; it++) {
             AstVarRef* refp = it->m_varrefp;
@@ -692,18 +704,18 @@ class TristateVisitor final : public TristateBaseVisitor {
             AstNodeExpr* const andp = new AstAnd{refp->fileline(), ref1p, ref2p};
 
             // or this to the others
-            orp = (!orp) ? andp : new AstOr{refp->fileline(), orp, andp};
-
-            AstNodeExpr* const ref3p = new AstVarRef{refp->fileline(), newEnLhsp, VAccess::READ};
-            enp = (!enp) ? ref3p : new AstOr{ref3p->fileline(), enp, ref3p};
+            orps.push_back(andp);
+            enps.push_back(new AstVarRef{refp->fileline(), newEnLhsp, VAccess::READ});
         }
-        AstNode* const assp = new AstAssignW{
-            varp->fileline(), new AstVarRef{varp->fileline(), varp, VAccess::WRITE}, orp};
+        AstNode* const assp = new AstAssignW{varp->fileline(),
+                                             new AstVarRef{varp->fileline(), varp, VAccess::WRITE},
+                                             newOrTree(orps)};
         UINFO(9, "       newassp " << assp << endl);
         nodep->addStmtsp(assp);
 
         AstNode* const enAssp = new AstAssignW{
-            envarp->fileline(), new AstVarRef{envarp->fileline(), envarp, VAccess::WRITE}, enp};
+            envarp->fileline(), new AstVarRef{envarp->fileline(), envarp, VAccess::WRITE},
+            newOrTree(enps)};
         UINFO(9, "       newenassp " << enAssp << endl);
         nodep->addStmtsp(enAssp);
     }
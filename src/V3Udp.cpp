@@ -20,6 +20,11 @@
 //
 // 0 1 0 on a, b, c turns into !a&b&~c
 //
+// Combinational tables that fully specify the output, e.g. those of standard
+// cell libraries, instead become a single continuous assignment of the OR of
+// the lines with a '1' output, which is much cheaper than an always block of
+// if statements once the primitive is inlined into each cell instance.
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
@@ -27,12 +32,16 @@
 #include "V3Udp.h"
 
 #include "V3Error.h"
+#include "V3Stats.h"
 
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 class UdpVisitor final : public VNVisitor {
+    // Maximum inputs of a table converted to logic, as all input combinations are checked
+    static constexpr size_t MAX_LOGIC_INPUTS = 12;
+
     bool m_inInitial = false;  // Is inside of an initial block
     AstVar* m_oFieldVarp = nullptr;  // Output filed var of table line
     std::vector<AstVar*> m_inputVars;  // All the input vars in the AstPrimitive
@@ -41,6 +50,10 @@ class UdpVisitor final : public VNVisitor {
     bool m_isFirstOutput = false;  // Whether the first IO port is output
     AstVarRef* m_outputInitVerfp = nullptr;  // Initial output value for sequential UDP
     AstAlways* m_alwaysBlockp = nullptr;  // Main Always block in UDP transform
+    // Input values ('0', '1' or '?') and output value of each table line
+    std::vector<std::pair<std::string, char>> m_lines;
+    bool m_toLogic = false;  // Table might be converted to logic
+    VDouble0 m_statLogic;  // Statistic tracking
 
     void visit(AstInitial* nodep) override {
         VL_RESTORER(m_inInitial);
@@ -95,9 +108,18 @@ class UdpVisitor final : public VNVisitor {
 
         m_alwaysBlockp = new AstAlways{fl, VAlwaysKwd::ALWAYS, nullptr, nullptr};
         fl->warnOff(V3ErrorCode::LATCH, true);
+        m_lines.clear();
+        m_toLogic = v3Global.opt.fUdpLogic() && m_inputVars.size() <= MAX_LOGIC_INPUTS;
         iterateChildren(nodep);
 
-        nodep->replaceWith(m_alwaysBlockp);
+        if (AstNodeExpr* const logicp = m_toLogic ? tableLogic(fl) : nullptr) {
+            ++m_statLogic;
+            nodep->replaceWith(new AstAssignW{
+                fl, new AstVarRef{fl, m_oFieldVarp, VAccess::WRITE}, logicp});
+            VL_DO_DANGLING(m_alwaysBlockp->deleteTree(), m_alwaysBlockp);
+        } else {
+            nodep->replaceWith(m_alwaysBlockp);
+        }
     }
     void visit(AstUdpTableLine* nodep) override {
         FileLine* const fl = nodep->fileline();
@@ -112,6 +134,7 @@ class UdpVisitor final : public VNVisitor {
         AstNode* oNodep = nodep->oFieldsp();
         uint32_t inputvars = 0;
         AstSenTree* edgetrigp = nullptr;
+        std::string pattern;
 
         AstLogAnd* logandp = new AstLogAnd{fl, new AstConst{fl, AstConst::BitTrue{}},
                                            new AstConst{fl, AstConst::BitTrue{}}};
@@ -138,6 +161,7 @@ class UdpVisitor final : public VNVisitor {
                     logandp = new AstLogAnd{fl, logandp, new AstLogNot{fl, referencep}};
                 else if (valName == "1" || valName == "r")
                     logandp = new AstLogAnd{fl, logandp, referencep};
+                pattern += (valName == "0" || valName == "1") ? valName[0] : '?';
             }
             iNodep = iNodep->nextp();
         }
@@ -147,6 +171,12 @@ class UdpVisitor final : public VNVisitor {
         }
 
         string const oValName = nodep->udpIsCombo() ? oNodep->name() : oNodep->nextp()->name();
+        if (!nodep->udpIsCombo() || edgetrigp || inputvars != m_inputVars.size()
+            || pattern.size() != inputvars || (oValName != "0" && oValName != "1")) {
+            m_toLogic = false;
+        } else {
+            m_lines.emplace_back(pattern, oValName[0]);
+        }
         if (oValName == "-") {
             if (edgetrigp) pushDeletep(edgetrigp);
             if (logandp) pushDeletep(logandp);
@@ -182,6 +212,49 @@ class UdpVisitor final : public VNVisitor {
     void visit(AstNode* nodep) override { iterateChildren(nodep); }
     void visit(AstLogAnd* nodep) override { iterateChildren(nodep); }
     void visit(AstLogNot* nodep) override { iterateChildren(nodep); }
+    // Return logic computing the output of the current combinational table, or nullptr if
+    // the table does not specify every input combination, so the output would hold its value,
+    // or a '1' line is overridden by a later '0' line
+    AstNodeExpr* tableLogic(FileLine* fl) {
+        const size_t inputs = m_inputVars.size();
+        for (uint32_t combo = 0; combo < (1U << inputs); ++combo) {
+            // As the always block, the last matching line wins
+            char out = '\0';
+            bool oneMatched = false;
+            for (const auto& line : m_lines) {
+                bool matches = true;
+                for (size_t i = 0; i < inputs; ++i) {
+                    const char val = line.first[i];
+                    if (val != '?' && (val == '1') != ((combo >> i) & 1U)) {
+                        matches = false;
+                        break;
+                    }
+                }
+                if (!matches) continue;
+                out = line.second;
+                if (out == '1') oneMatched = true;
+            }
+            if (out == '\0' || (out == '1') != oneMatched) return nullptr;
+        }
+        // OR of the lines with a '1' output
+        AstNodeExpr* resultp = nullptr;
+        for (const auto& line : m_lines) {
+            if (line.second != '1') continue;
+            AstNodeExpr* termp = nullptr;
+            for (size_t i = 0; i < inputs; ++i) {
+                const char val = line.first[i];
+                if (val == '?') continue;
+                AstNodeExpr* refp = new AstVarRef{fl, m_inputVars[i], VAccess::READ};
+                if (val == '0') refp = new AstNot{fl, refp};
+                termp = termp ? new AstAnd{fl, termp, refp} : refp;
+            }
+            if (!termp) termp = new AstConst{fl, AstConst::BitTrue{}};
+            resultp = resultp ? new AstOr{fl, resultp, termp} : termp;
+        }
+        if (!resultp) resultp = new AstConst{fl, AstConst::BitFalse{}};
+        return resultp;
+    }
+
     // For logic processing.
     bool isEdgeTrig(std::string& valName) {
         if (valName == "*") return true;
@@ -227,7 +300,7 @@ class UdpVisitor final : public VNVisitor {
 public:
     // CONSTRUCTORS
     explicit UdpVisitor(AstNetlist* nodep) { iterate(nodep); }
-    ~UdpVisitor() override = default;
+    ~UdpVisitor() override { V3Stats::addStat("Udp, tables converted to logic", m_statLogic); }
 };
 
 void V3Udp::udpResolve(AstNetlist* rootp) {
@@ -27,6 +27,7 @@
 
 #include "V3Undriven.h"
 
+#include "V3ProfVerilation.h"
 #include "V3Stats.h"
 
 #include <vector>
@@ -540,5 +541,6 @@ public:
 void V3Undriven::undrivenAll(AstNetlist* nodep) {
     UINFO(2, __FUNCTION__ << ": " << endl);
     { UndrivenVisitor{nodep}; }
+    V3ProfVerilation::subPassEnd("undriven");
     if (v3Global.opt.stats()) V3Stats::statsStage("undriven");
 }
@@ -18,6 +18,20 @@
 // Each module:
 //   Order module variables
 //
+// With threads, variables are grouped by the set of MTasks referencing
+// them, and the groups are ordered so that groups referenced by similar
+// MTasks are adjacent. With --prof-pgo data, MTasks are weighted by their
+// measured cost, and groups private to an expensive MTask are placed on
+// their own cache lines, to avoid false sharing between threads.
+//
+// With --pack-bits, single bit variables are first packed into 64-bit
+// words, grouping variables with the same MTask affinity, and only those
+// referenced by at most one MTask, so words are never shared by threads.
+//
+// With --numa-layout, the top module variables referenced only by MTasks
+// run on one thread are placed together, starting on a new page, so the
+// thread can move them to its NUMA node (see VlThreadPool::numaBind).
+//
 //*************************************************************************
 
 #include "V3PchAstMT.h"
@@ -25,8 +39,12 @@
 #include "V3VariableOrder.h"
 
 #include "V3AstUserAllocator.h"
+#include "V3Config.h"
 #include "V3EmitCBase.h"
+#include "V3EmitCFunc.h"
 #include "V3ExecGraph.h"
+#include "V3ProfVerilation.h"
+#include "V3Stats.h"
 #include "V3TSP.h"
 #include "V3ThreadPool.h"
 
@@ -36,6 +54,13 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 
 using MTaskIdVec = std::vector<bool>;  // Used as a bit-set indexed by MTask ID
 using MTaskAffinityMap = std::unordered_map<const AstVar*, MTaskIdVec>;
+using MTaskWeights = std::vector<int>;  // Weight of each MTask ID in layout decisions
+using MTaskThreads = std::vector<int>;  // Thread running each MTask ID, -1 if unknown
+
+// Weight of MTasks with the highest profiled cost, others are scaled down to 1
+constexpr int MTASK_WEIGHT_MAX = 16;
+// Variables private to an MTask at least this weight are put on separate cache lines
+constexpr int MTASK_WEIGHT_HOT = 4;
 
 // Trace through code reachable form an MTask and annotate referenced variabels
 class GatherMTaskAffinity final : VNVisitorConst {
@@ -99,12 +124,14 @@ public:
 class VarTspSorter final : public V3TSP::TspStateBase {
     // MEMBERS
     const MTaskIdVec& m_mTaskIds;  // Mtask we're ordering
+    const MTaskWeights& m_weights;  // Weight of each MTask
     static uint32_t s_serialNext;  // Unique ID to establish serial order
     const uint32_t m_serial = ++s_serialNext;  // Serial ordering
 public:
     // CONSTRUCTORS
-    explicit VarTspSorter(const MTaskIdVec& mTaskIds)
-        : m_mTaskIds{mTaskIds} {
+    VarTspSorter(const MTaskIdVec& mTaskIds, const MTaskWeights& weights)
+        : m_mTaskIds{mTaskIds}
+        , m_weights{weights} {
         UASSERT(mTaskIds.size() == ExecMTask::numUsedIds(), "Wrong size for MTask ID vector");
     }
     ~VarTspSorter() override = default;
@@ -118,10 +145,12 @@ public:
         return cost(static_cast<const VarTspSorter*>(otherp));
     }
     int cost(const VarTspSorter* otherp) const VL_MT_SAFE {
-        // Compute the number of MTasks not shared (Hamming distance)
+        // Compute the weight of MTasks not shared (weighted Hamming distance)
         int cost = 0;
         const size_t size = ExecMTask::numUsedIds();
-        for (size_t i = 0; i < size; ++i) cost += m_mTaskIds.at(i) ^ otherp->m_mTaskIds.at(i);
+        for (size_t i = 0; i < size; ++i) {
+            if (m_mTaskIds.at(i) != otherp->m_mTaskIds.at(i)) cost += m_weights.at(i);
+        }
         return cost;
     }
 };
@@ -136,11 +165,18 @@ class VariableOrder final {
     std::unordered_map<const AstVar*, VarAttributes> m_attributes;
 
     const MTaskAffinityMap& m_mTaskAffinity;
+    const MTaskWeights& m_mTaskWeights;
+    const MTaskThreads& m_mTaskThreads;
+    const std::vector<AstVar*>& m_numaMarkerps;  // Page markers of each thread, if NUMA layout
     std::vector<AstVar*>& m_varps;
 
     VariableOrder(AstNodeModule* modp, const MTaskAffinityMap& mTaskAffinity,
-                  std::vector<AstVar*>& varps)
+                  const MTaskWeights& mTaskWeights, const MTaskThreads& mTaskThreads,
+                  const std::vector<AstVar*>& numaMarkerps, std::vector<AstVar*>& varps)
         : m_mTaskAffinity{mTaskAffinity}
+        , m_mTaskWeights{mTaskWeights}
+        , m_mTaskThreads{mTaskThreads}
+        , m_numaMarkerps{numaMarkerps}
         , m_varps{varps} {
         orderModuleVars(modp);
     }
@@ -184,7 +220,7 @@ class VariableOrder final {
         for (const auto& pair : m2v) {
             const MTaskIdVec& vec = pair.first;
             const bool empty = std::find(vec.begin(), vec.end(), true) == vec.end();
-            if (!empty) states.push_back(new VarTspSorter{vec});
+            if (!empty) states.push_back(new VarTspSorter{vec, m_mTaskWeights});
         }
 
         // Do the TSP sort
@@ -199,15 +235,68 @@ class VariableOrder final {
             for (AstVar* const varp : subVarps) varps.push_back(varp);
         };
 
+        // Start the group on a new cache line, if it or the previous group is hot and private
+        bool prevHot = false;
+        const auto alignGroup = [this, &prevHot](const MTaskIdVec& vec,
+                                                 const std::vector<AstVar*>& subVarps) {
+            const bool hot = isHotPrivate(vec);
+            if ((hot || prevHot) && !subVarps.empty()) {
+                AstVar* const firstp = subVarps.front();
+                if (!firstp->isStatic() && !firstp->isIO()) firstp->setAlignCacheLine();
+            }
+            prevHot = hot;
+        };
+
         // Enumerate by sorted MTaskIdSet, sort within the set separately
         for (const V3TSP::TspStateBase* const stateBasep : sortedStates) {
             const VarTspSorter* const statep = dynamic_cast<const VarTspSorter*>(stateBasep);
-            sortAndAppend(m2v[statep->mTaskIds()]);
+            std::vector<AstVar*>& subVarps = m2v[statep->mTaskIds()];
+            sortAndAppend(subVarps);
+            alignGroup(statep->mTaskIds(), subVarps);
             VL_DO_DANGLING(delete statep, statep);
         }
 
         // Finally add the variables with no known MTask affinity
         sortAndAppend(m2v[emptyVec]);
+        alignGroup(emptyVec, m2v[emptyVec]);
+    }
+
+    // Thread running all MTasks referencing the variable, or threads() if several/none
+    int numaThread(const AstVar* varp) const {
+        const int shared = v3Global.opt.threads();
+        const auto it = m_mTaskAffinity.find(varp);
+        if (it == m_mTaskAffinity.end() || varp->isStatic() || varp->isIO()) return shared;
+        int thread = -1;
+        for (size_t id = 0; id < it->second.size(); ++id) {
+            if (!it->second[id]) continue;
+            const int mtaskThread = m_mTaskThreads.at(id);
+            if (mtaskThread < 0 || (thread >= 0 && thread != mtaskThread)) return shared;
+            thread = mtaskThread;
+        }
+        return thread >= 0 ? thread : shared;
+    }
+
+    // Regroup sorted variables by thread, each group starting with its page marker
+    void numaSortVars(std::vector<AstVar*>& varps) {
+        std::vector<std::vector<AstVar*>> groups(m_numaMarkerps.size());
+        const std::unordered_set<const AstVar*> markers{m_numaMarkerps.begin(),
+                                                        m_numaMarkerps.end()};
+        for (AstVar* const varp : varps) {
+            if (!markers.count(varp)) groups.at(numaThread(varp)).push_back(varp);
+        }
+        varps.clear();
+        for (size_t thread = 0; thread < groups.size(); ++thread) {
+            varps.push_back(m_numaMarkerps[thread]);
+            for (AstVar* const varp : groups[thread]) varps.push_back(varp);
+        }
+    }
+
+    // Referenced by a single MTask with high profiled cost
+    bool isHotPrivate(const MTaskIdVec& vec) const {
+        if (!V3Config::containsMTaskProfileData()) return false;
+        if (std::count(vec.begin(), vec.end(), true) != 1) return false;
+        const size_t id = std::find(vec.begin(), vec.end(), true) - vec.begin();
+        return m_mTaskWeights.at(id) >= MTASK_WEIGHT_HOT;
     }
 
     void orderModuleVars(AstNodeModule* modp) {
@@ -239,24 +328,202 @@ class VariableOrder final {
                 simpleSortVars(m_varps);
             } else {
                 tspSortVars(m_varps);
+                if (!m_numaMarkerps.empty()) numaSortVars(m_varps);
             }
         }
     }
 
 public:
     static void processModule(AstNodeModule* modp, const MTaskAffinityMap& mTaskAffinity,
+                              const MTaskWeights& mTaskWeights, const MTaskThreads& mTaskThreads,
+                              const std::vector<AstVar*>& numaMarkerps,
                               std::vector<AstVar*>& varps) VL_MT_STABLE {
-        VariableOrder{modp, mTaskAffinity, varps};
+        VariableOrder{modp, mTaskAffinity, mTaskWeights, mTaskThreads, numaMarkerps, varps};
+    }
+};
+
+//######################################################################
+// Pack single bit variables into 64-bit words
+
+class BitPacker final {
+    // NODE STATE
+    //  AstVar::user2()  // bool: Variable has a reference that cannot be a bit select
+    const VNUser2InUse m_user2InUse;
+
+    // TYPES
+    struct Slot final {
+        AstVar* wordp;  // Word holding the variable
+        int lsb;  // Bit of the variable in the word
+    };
+    // Variables are only packed together if referenced by the same MTask, so words are
+    // never written concurrently, and if reset the same way
+    using GroupKey = std::pair<MTaskIdVec, bool>;
+
+    // STATE
+    MTaskAffinityMap& m_mTaskAffinity;  // MTask affinities, updated to the packed words
+    std::unordered_map<const AstVar*, Slot> m_slots;  // Location of packed variables
+    std::vector<AstVar*> m_packedVarps;  // Packed variables, to be deleted
+    std::unordered_set<const AstVar*> m_resetWords;  // Words already given an AstCReset
+    VDouble0 m_statPackedVars;  // Statistic tracking
+    VDouble0 m_statPackedWords;  // Statistic tracking
+
+    // METHODS
+    static bool isCandidate(const AstVar* varp) {
+        const AstBasicDType* const basicp = VN_CAST(varp->dtypeSkipRefp(), BasicDType);
+        if (!basicp || !basicp->isBitLogic() || basicp->isOpaque()) return false;
+        if (varp->width() != 1) return false;
+        // Only variables fully owned by the generated code; unprotected names are referenced
+        // from text, and clocks are reset specially with --x-initial-edge
+        return !varp->isIO() && !varp->isSc() && !varp->isSigPublic() && !varp->isForceable()
+               && !varp->isWrittenByDpi() && !varp->isUsedClock() && !varp->isStatic()
+               && !varp->isFuncLocal() && !varp->isClassMember() && !varp->valuep()
+               && varp->needsCReset() && varp->protect();
+    }
+
+    static const AstNode* parentOf(const AstNode* nodep) {
+        while (nodep->backp()->nextp() == nodep) nodep = nodep->backp();
+        return nodep->backp();
+    }
+
+    // Whole variable writes by assignment, or reads by value, can use the packed word
+    static bool isPackableRef(const AstNodeVarRef* refp) {
+        if (!VN_IS(refp, VarRef)) return false;
+        const AstNode* const parentp = parentOf(refp);
+        if (VN_IS(parentp, CReset)) return true;
+        if (refp->access().isWriteOnly()) {
+            const AstNodeAssign* const assignp = VN_CAST(parentp, NodeAssign);
+            return assignp && assignp->lhsp() == refp;
+        }
+        return refp->access().isReadOnly() && !VN_IS(parentp, NodeCCall)
+               && !VN_IS(parentp, CMethodHard) && !VN_IS(parentp, CExpr)
+               && !VN_IS(parentp, CStmt) && !VN_IS(parentp, CAwait);
+    }
+
+    void packModule(AstNodeModule* modp) {
+        // Group the candidates, in declaration order
+        const MTaskIdVec emptyVec(ExecMTask::numUsedIds(), false);
+        std::map<GroupKey, std::vector<AstVar*>> groups;
+        for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+            AstVar* const varp = VN_CAST(nodep, Var);
+            if (!varp || varp->user2() || !isCandidate(varp)) continue;
+            const auto it = m_mTaskAffinity.find(varp);
+            const MTaskIdVec& affinity = it == m_mTaskAffinity.end() ? emptyVec : it->second;
+            if (std::count(affinity.begin(), affinity.end(), true) > 1) continue;
+            const bool zero = EmitCFunc::resetToZero(varp, varp->basicp());
+            // With --underline-zero, the word's name would make it zero initialized
+            if (!zero && v3Global.opt.underlineZero()) continue;
+            groups[GroupKey{affinity, zero}].push_back(varp);
+        }
+
+        // Allocate words, a lone leftover variable is not worth packing
+        int wordNum = 0;
+        for (const auto& pair : groups) {
+            const std::vector<AstVar*>& varps = pair.second;
+            for (size_t start = 0; start + 1 < varps.size(); start += 64) {
+                FileLine* const flp = varps[start]->fileline();
+                AstNodeDType* const dtypep
+                    = pair.first.second ? modp->findBitDType(64, 64, VSigning::UNSIGNED)
+                                        : modp->findLogicDType(64, 64, VSigning::UNSIGNED);
+                AstVar* const wordp = new AstVar{flp, VVarType::MODULETEMP,
+                                                 "__Vpacked" + cvtToStr(wordNum++), dtypep};
+                modp->addStmtsp(wordp);
+                if (pair.first.first != emptyVec) m_mTaskAffinity.emplace(wordp, pair.first.first);
+                ++m_statPackedWords;
+                const size_t end = std::min(varps.size(), start + 64);
+                for (size_t i = start; i < end; ++i) {
+                    m_slots.emplace(varps[i], Slot{wordp, static_cast<int>(i - start)});
+                    m_packedVarps.push_back(varps[i]);
+                    ++m_statPackedVars;
+                }
+            }
+        }
+    }
+
+    void rewrite(AstVarRef* refp) {
+        const Slot& slot = m_slots.at(refp->varp());
+        FileLine* const flp = refp->fileline();
+        AstVarRef* const wordRefp = new AstVarRef{flp, slot.wordp, refp->access()};
+        wordRefp->classOrPackagep(refp->classOrPackagep());
+        wordRefp->selfPointer(refp->selfPointer());
+        if (AstCReset* const resetp = VN_CAST(refp->backp(), CReset)) {
+            // The whole word is reset in place of its first variable
+            if (m_resetWords.insert(slot.wordp).second) {
+                resetp->addHereThisAsNext(new AstCReset{flp, wordRefp, resetp->constructing()});
+            } else {
+                VL_DO_DANGLING(wordRefp->deleteTree(), wordRefp);
+            }
+            VL_DO_DANGLING(resetp->unlinkFrBack()->deleteTree(), resetp);
+            return;
+        }
+        AstNodeExpr* newp = new AstSel{flp, wordRefp, slot.lsb, 1};
+        if (refp->access().isReadOnly()) {
+            // Code is already cleaned, so mask the bit select
+            newp = new AstAnd{flp, new AstConst{flp, AstConst::BitTrue{}}, newp};
+        }
+        newp->dtypeFrom(refp);
+        refp->replaceWith(newp);
+        VL_DO_DANGLING(refp->deleteTree(), refp);
+    }
+
+    // CONSTRUCTORS
+    BitPacker(AstNetlist* netlistp, MTaskAffinityMap& mTaskAffinity)
+        : m_mTaskAffinity{mTaskAffinity} {
+        // Find variables with references that need the variable itself
+        netlistp->foreach([](AstNodeVarRef* refp) {
+            if (refp->varp() && !isPackableRef(refp)) refp->varp()->user2(true);
+        });
+        for (AstNodeModule* modp = netlistp->modulesp(); modp;
+             modp = VN_AS(modp->nextp(), NodeModule)) {
+            if (VN_IS(modp, Class) || VN_IS(modp, Iface)) continue;
+            packModule(modp);
+        }
+        if (m_packedVarps.empty()) return;
+
+        // Replace references with bit selects of the words
+        std::vector<AstVarRef*> refps;
+        netlistp->foreach([&](AstVarRef* refp) {
+            if (m_slots.count(refp->varp())) refps.push_back(refp);
+        });
+        for (AstVarRef* const refp : refps) rewrite(refp);
+
+        // Remove the packed variables
+        for (AstVar* varp : m_packedVarps) {
+            m_mTaskAffinity.erase(varp);
+            VL_DO_DANGLING(varp->unlinkFrBack()->deleteTree(), varp);
+        }
+    }
+    ~BitPacker() {
+        V3Stats::addStat("Optimizations, Packed bit variables", m_statPackedVars);
+        V3Stats::addStat("Optimizations, Packed bit words", m_statPackedWords);
+    }
+    VL_UNCOPYABLE(BitPacker);
+
+public:
+    static void apply(AstNetlist* netlistp, MTaskAffinityMap& mTaskAffinity) {
+        BitPacker{netlistp, mTaskAffinity};
     }
 };
 
 //######################################################################
 // V3VariableOrder static functions
 
+bool V3VariableOrder::numaLayout() {
+    // Dynamic scheduling and hierarchical blocks pick threads at run time, so thread is unknown
+    return v3Global.opt.numaLayout() && v3Global.opt.mtasks() && !v3Global.opt.threadsDynamic()
+           && !v3Global.opt.hierChild() && v3Global.opt.hierBlocks().empty();
+}
+
+std::string V3VariableOrder::numaMarkerName(int thread) {
+    return "__Vm_numaPage__" + std::to_string(thread);
+}
+
 void V3VariableOrder::orderAll(AstNetlist* netlistp) {
     UINFO(2, __FUNCTION__ << ": " << endl);
 
     MTaskAffinityMap mTaskAffinity;
+    MTaskWeights mTaskWeights(ExecMTask::numUsedIds(), 1);
+    MTaskThreads mTaskThreads(ExecMTask::numUsedIds(), -1);
+    std::vector<AstVar*> numaMarkerps;
 
     // Gather MTask affinities
     if (v3Global.opt.mtasks()) {
@@ -265,22 +532,71 @@ void V3VariableOrder::orderAll(AstNetlist* netlistp) {
                 GatherMTaskAffinity::apply(vtx.as<const ExecMTask>(), mTaskAffinity);
             }
         });
+        netlistp->topModulep()->foreach([&](const AstExecGraph* execGraphp) {
+            for (const V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
+                const ExecMTask* const mtaskp = vtx.as<const ExecMTask>();
+                mTaskThreads.at(mtaskp->id()) = mtaskp->runThread();
+            }
+        });
+        // Weight by profiled costs, if available, else all MTasks are equal
+        if (V3Config::containsMTaskProfileData()) {
+            uint64_t maxCost = 1;
+            netlistp->topModulep()->foreach([&](const AstExecGraph* execGraphp) {
+                for (const V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
+                    maxCost = std::max<uint64_t>(maxCost, vtx.as<const ExecMTask>()->cost());
+                }
+            });
+            netlistp->topModulep()->foreach([&](const AstExecGraph* execGraphp) {
+                for (const V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
+                    const ExecMTask* const mtaskp = vtx.as<const ExecMTask>();
+                    const uint64_t scaled = (MTASK_WEIGHT_MAX - 1) * uint64_t{mtaskp->cost()};
+                    mTaskWeights.at(mtaskp->id()) = 1 + static_cast<int>(scaled / maxCost);
+                }
+            });
+        }
     }
+    V3ProfVerilation::subPassEnd("variableorder-gather");
     if (v3Global.opt.stats()) V3Stats::statsStage("variableorder-gather");
 
+    // Pack single bit variables, using the affinities so words are not shared between threads
+    if (v3Global.opt.packBits()) {
+        BitPacker::apply(netlistp, mTaskAffinity);
+        V3Global::dumpCheckGlobalTree("variableorder-pack", 0, dumpTreeEitherLevel() >= 6);
+    }
+
+    // Create the page markers, which are also the 'moved to NUMA node' flags
+    if (numaLayout()) {
+        AstNodeModule* const topModp = netlistp->topModulep();
+        for (int thread = 0; thread <= v3Global.opt.threads(); ++thread) {
+            AstVar* const varp = new AstVar{topModp->fileline(), VVarType::MODULETEMP,
+                                            numaMarkerName(thread), netlistp->findBitDType()};
+            varp->protect(false);  // Do not protect as we still have references in AstCStmt
+            varp->setAlignPage();
+            varp->valuep(new AstConst{topModp->fileline(), AstConst::BitFalse{}});
+            topModp->addStmtsp(varp);
+            numaMarkerps.push_back(varp);
+        }
+    }
+
     // Sort variables for each module
     std::unordered_map<AstNodeModule*, std::vector<AstVar*>> sortedVars;
+    const std::vector<AstVar*> noMarkerps;
     {
         V3ThreadScope threadScope;
 
         for (AstNodeModule* modp = v3Global.rootp()->modulesp(); modp;
              modp = VN_AS(modp->nextp(), NodeModule)) {
             std::vector<AstVar*>& varps = sortedVars[modp];
-            threadScope.enqueue([modp, mTaskAffinity, &varps]() {
-                VariableOrder::processModule(modp, mTaskAffinity, varps);
+            const std::vector<AstVar*>& markerps
+                = modp == netlistp->topModulep() ? numaMarkerps : noMarkerps;
+            threadScope.enqueue([modp, mTaskAffinity, &mTaskWeights, &mTaskThreads, &markerps,
+                                 &varps]() {
+                VariableOrder::processModule(modp, mTaskAffinity, mTaskWeights, mTaskThreads,
+                                             markerps, varps);
             });
         }
     }
+    V3ProfVerilation::subPassEnd("variableorder-sort");
     if (v3Global.opt.stats()) V3Stats::statsStage("variableorder-sort");
 
     // Insert them back under the module, in the new order, but at
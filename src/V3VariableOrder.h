@@ -20,6 +20,8 @@
 #include "config_build.h"
 #include "verilatedos.h"
 
+#include <string>
+
 class AstNetlist;
 
 //============================================================================
@@ -27,6 +29,10 @@ class AstNetlist;
 class V3VariableOrder final {
 public:
     static void orderAll(AstNetlist*);
+    // --numa-layout applies: top module variables are placed in pages by thread
+    static bool numaLayout();
+    // Name of variable starting the pages of given thread, threads() for the shared rest
+    static std::string numaMarkerName(int thread);
 };
 
 #endif  // Guard
@@ -18,8 +18,10 @@
 
 #include "V3Active.h"
 #include "V3ActiveTop.h"
+#include "V3Arena.h"
 #include "V3Assert.h"
 #include "V3AssertPre.h"
+#include "V3Assoc.h"
 #include "V3Ast.h"
 #include "V3Begin.h"
 #include "V3Branch.h"
@@ -48,6 +50,7 @@
 #include "V3EmitMk.h"
 #include "V3EmitMkJson.h"
 #include "V3EmitV.h"
+#include "V3EmitJson.h"
 #include "V3EmitXml.h"
 #include "V3ExecGraph.h"
 #include "V3Expand.h"
@@ -58,6 +61,7 @@
 #include "V3Gate.h"
 #include "V3Global.h"
 #include "V3Graph.h"
+#include "V3Hasher.h"
 #include "V3HierBlock.h"
 #include "V3Inline.h"
 #include "V3Inst.h"
@@ -80,6 +84,7 @@
 #include "V3ParseSym.h"
 #include "V3PreShell.h"
 #include "V3Premit.h"
+#include "V3ProfVerilation.h"
 #include "V3ProtectLib.h"
 #include "V3Randomize.h"
 #include "V3Reloop.h"
@@ -88,6 +93,7 @@
 #include "V3Scope.h"
 #include "V3Scoreboard.h"
 #include "V3Slice.h"
+#include "V3Sparse.h"
 #include "V3Split.h"
 #include "V3SplitAs.h"
 #include "V3SplitVar.h"
@@ -124,20 +130,16 @@ static void reportStatsIfEnabled() {
     }
 }
 
-static void emitJson() VL_MT_DISABLED {
-    const string filename
-        = (v3Global.opt.jsonOnlyOutput().empty()
-               ? v3Global.opt.makeDir() + "/" + v3Global.opt.prefix() + ".tree.json"
-               : v3Global.opt.jsonOnlyOutput());
-    v3Global.rootp()->dumpTreeJsonFile(filename);
-}
-
 static void emitXmlOrJson() VL_MT_DISABLED {
     if (v3Global.opt.xmlOnly()) V3EmitXml::emitxml();
-    if (v3Global.opt.jsonOnly()) emitJson();
+    if (v3Global.opt.jsonOnly()) V3EmitJson::emitJson();
 }
 
-static void process() {
+static string elabTimesFilename() {
+    return v3Global.opt.hierTopDataDir() + "/" + v3Global.opt.prefix() + "__verElab.dat";
+}
+
+static void process(const string& argString, string& elabCmdline) {
     {
         VlOs::DeltaWallTime elabWallTime{true};
 
@@ -206,6 +208,18 @@ static void process() {
             std::exit(0);
         }
 
+        // Can we reuse the previous output, as the elaborated design is unchanged?
+        if (v3Global.opt.skipIdenticalElab() && !v3Global.opt.lintOnly()
+            && !v3Global.opt.serializeOnly() && !v3Global.opt.dpiHdrOnly()) {
+            elabCmdline = argString + " elab-hash="
+                          + V3Hasher::elabHash(v3Global.rootp()).toString();
+            if (V3File::checkTimes(elabTimesFilename(), elabCmdline, true)) {
+                UINFO(1, "--skip-identical-elab: No change to elaborated design, exiting\n");
+                reportStatsIfEnabled();
+                return;
+            }
+        }
+
         // Calculate and check widths, edit tree to TRUNC/EXTRACT any width mismatches
         V3Width::width(v3Global.rootp());
 
@@ -509,6 +523,13 @@ static void process() {
             V3Const::constifyAll(v3Global.rootp());
             V3Dead::deadifyAll(v3Global.rootp());
 
+            // Use hash tables for associative arrays whose order is never observed
+            if (v3Global.opt.fAssocHash() && !v3Global.opt.savable()) {
+                V3Assoc::assocAll(v3Global.rootp());
+            }
+            // Allocate huge memories in pages as they are used
+            if (v3Global.opt.sparseArrayLimit()) V3Sparse::sparseAll(v3Global.rootp());
+
             // Here down, widthMin() is the Verilog width, and width() is the C++ width
             // Bits between widthMin() and width() are irrelevant, but may be non zero.
             v3Global.widthMinUsage(VWidthMinUsage::VERILOG_WIDTH);
@@ -613,7 +634,7 @@ static void process() {
                && !v3Global.opt.dpiHdrOnly()) {
         // Check XML/JSON when debugging to make sure no missing node types
         V3EmitXml::emitxml();
-        emitJson();
+        V3EmitJson::emitJson();
     }
 
     // Output DPI protected library files
@@ -643,6 +664,7 @@ static void process() {
     }
 
     // Final statistics
+    V3ProfVerilation::passEnd("emit");
     if (v3Global.opt.stats()) V3Stats::statsStage("emit");
     reportStatsIfEnabled();
 }
@@ -704,8 +726,9 @@ static void verilate(const string& argString) {
     v3Global.removeStd();
 
     // Link, etc, if needed
+    string elabCmdline;  // With --skip-identical-elab, command line and design hash
     if (!v3Global.opt.preprocOnly()) {  //
-        process();
+        process(argString, elabCmdline);
     }
 
     // Final steps
@@ -760,6 +783,7 @@ static void verilate(const string& argString) {
                                + "__verFiles.dat",
                            argString);
     }
+    if (!elabCmdline.empty()) V3File::writeTimes(elabTimesFilename(), elabCmdline);
 
     V3Os::filesystemFlushBuildDir(v3Global.opt.makeDir());
     if (v3Global.opt.hierTop()) V3Os::filesystemFlushBuildDir(v3Global.opt.hierTopDataDir());
@@ -787,35 +811,57 @@ static string buildMakeCmd(const string& makefile, const string& target) {
     return cmd.str();
 }
 
+static string buildNinjaCmd() {
+    const int jobs = v3Global.opt.buildJobs();
+    std::ostringstream cmd;
+    cmd << "ninja -C " << v3Global.opt.makeDir();
+    if (jobs > 0) cmd << " -j " << jobs;
+    return cmd.str();
+}
+
+static void execBuildCmd(const string& cmdStr) {
+    const int exit_code = V3Os::system(cmdStr);
+    if (exit_code != 0) {
+        v3error(cmdStr << " exited with " << exit_code << std::endl);
+        std::exit(exit_code);
+    }
+}
+
 static void execBuildJob() {
     UASSERT(v3Global.opt.build(), "--build is not specified.");
     UASSERT(v3Global.opt.gmake(), "--build requires GNU Make.");
     UASSERT(!v3Global.opt.cmake(), "--build cannot use CMake.");
     VlOs::DeltaWallTime buildWallTime{true};
+    const V3ProfVerilationScope profScope{"build", "build"};
     UINFO(1, "Start Build\n");
 
-    const string cmdStr = buildMakeCmd(v3Global.opt.prefix() + ".mk", "");
+    const string makefile = v3Global.opt.prefix() + ".mk";
     V3Os::filesystemFlushBuildDir(v3Global.opt.hierTopDataDir());
-    const int exit_code = V3Os::system(cmdStr);
-    V3Stats::addStatPerf(V3Stats::STAT_WALLTIME_BUILD, buildWallTime.deltaTime());
-
-    if (exit_code != 0) {
-        v3error(cmdStr << " exited with " << exit_code << std::endl);
-        std::exit(exit_code);
+    if (v3Global.opt.buildNinja()) {
+        // Make only resolves the compiler flags, ninja then does all compiling
+        execBuildCmd(buildMakeCmd(makefile, "ninja-vars"));
+        execBuildCmd(buildNinjaCmd());
+    } else if (v3Global.opt.ccPgo().empty()) {
+        execBuildCmd(buildMakeCmd(makefile, ""));
+    } else {
+        // Instrumented build, training run, then rebuild using the profile
+        execBuildCmd(buildMakeCmd(makefile, "VM_PGO=generate pgo-clean"));
+        execBuildCmd(buildMakeCmd(makefile, "VM_PGO=generate"));
+        UINFO(1, "Start PGO training run\n");
+        execBuildCmd(v3Global.opt.ccPgo());
+        execBuildCmd(buildMakeCmd(makefile, "VM_PGO=use pgo-merge pgo-clean"));
+        execBuildCmd(buildMakeCmd(makefile, "VM_PGO=use"));
     }
+    V3Stats::addStatPerf(V3Stats::STAT_WALLTIME_BUILD, buildWallTime.deltaTime());
 }
 
 static void execHierVerilation() {
     UASSERT(v3Global.hierPlanp(), "must be called only when plan exists");
     const string makefile = v3Global.opt.prefix() + "_hier.mk ";
-    const string target = v3Global.opt.build() ? " hier_build" : " hier_verilation";
-    const string cmdStr = buildMakeCmd(makefile, target);
+    const bool build = v3Global.opt.build() && !v3Global.opt.buildNinja();
+    const string target = build ? " hier_build" : " hier_verilation";
     V3Os::filesystemFlushBuildDir(v3Global.opt.hierTopDataDir());
-    const int exit_code = V3Os::system(cmdStr);
-    if (exit_code != 0) {
-        v3error(cmdStr << " exited with " << exit_code << std::endl);
-        std::exit(exit_code);
-    }
+    execBuildCmd(buildMakeCmd(makefile, target));
 }
 
 //######################################################################
@@ -846,6 +892,10 @@ int main(int argc, char** argv) {
     // Validate settings (aka Boost.Program_options)
     v3Global.opt.notify();
     v3Global.rootp()->timeInit();
+    if (!v3Global.opt.profVerilation().empty()) V3ProfVerilation::enable();
+    if (!v3Global.opt.astSpillDir().empty() && !V3Arena::spillTo(v3Global.opt.astSpillDir())) {
+        v3fatal("--ast-spill-dir: Cannot create spill file in: " << v3Global.opt.astSpillDir());
+    }
 
     V3Error::abortIfErrors();
 
@@ -857,9 +907,12 @@ int main(int argc, char** argv) {
 
     if (v3Global.hierPlanp() && v3Global.opt.gmake()) {
         execHierVerilation();  // execHierVerilation() takes care of --build too
+        // Except with ninja, where the top's build.ninja builds all blocks
+        if (v3Global.opt.build() && v3Global.opt.buildNinja()) execBuildJob();
     } else if (v3Global.opt.build()) {
         execBuildJob();
     }
+    V3ProfVerilation::write(v3Global.opt.profVerilation());
 
     // Explicitly release resources
     V3PreShell::shutdown();
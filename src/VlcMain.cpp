@@ -68,6 +68,7 @@ void VlcOptions::parseOptsList(int argc, char** argv) {
     DECL_OPTION("-annotate-points", OnOff, &m_annotatePoints);
     DECL_OPTION("-debug", CbCall, []() { V3Error::debugDefault(3); });
     DECL_OPTION("-debugi", CbVal, [](int v) { V3Error::debugDefault(v); });
+    DECL_OPTION("-j", Set, &m_jobs);
     DECL_OPTION("-rank", OnOff, &m_rank);
     DECL_OPTION("-unlink", OnOff, &m_unlink);
     DECL_OPTION("-V", CbCall, []() {
@@ -129,10 +130,7 @@ int main(int argc, char** argv) {
 
     if (top.opt.readFiles().empty()) top.opt.addReadFile("vlt_coverage.dat");
 
-    {
-        const VlStringSet& readFiles = top.opt.readFiles();
-        for (const auto& filename : readFiles) top.readCoverage(filename);
-    }
+    top.readCoverageFiles(top.opt.readFiles());
 
     if (debug() >= 9) {
         top.tests().dump(true);
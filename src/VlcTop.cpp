@@ -24,23 +24,65 @@
 #include "VlcOptions.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 //######################################################################
-
-void VlcTop::readCoverage(const string& filename, bool nonfatal) {
-    UINFO(2, "readCoverage " << filename << endl);
-
-    std::ifstream is{filename.c_str()};
-    if (!is) {
-        if (!nonfatal) v3fatal("Can't read coverage file: " << filename);
-        return;
+// Parsing, independent of VlcTop state so may run on any thread
+
+// Read binary format contents after the magic, calling addFn(point, hits) for each point.
+// See VerilatedCovImp::writeBinary; after the magic:
+// uint64 points, uint64 name bytes, NUL terminated names, uint64 counts[points]
+// Returns error message, or empty if ok
+template <typename T_AddFn>
+static string parseCoverageBinary(const string& filename, const string& contents,
+                                  T_AddFn addFn) {
+    uint64_t sizes[2];
+    if (contents.size() < sizeof(sizes)) return "Truncated binary coverage file: " + filename;
+    std::memcpy(sizes, contents.data(), sizeof(sizes));
+    const uint64_t npoints = sizes[0];
+    const uint64_t nameBytes = sizes[1];
+    const char* namep = contents.data() + sizeof(sizes);
+    const char* const namesEndp = namep + nameBytes;
+    const char* countp = namesEndp;
+    if (nameBytes > contents.size() - sizeof(sizes)
+        || npoints > (contents.size() - sizeof(sizes) - nameBytes) / sizeof(uint64_t)) {
+        return "Truncated binary coverage file: " + filename;
     }
+    for (uint64_t i = 0; i < npoints; ++i) {
+        const char* const endp
+            = static_cast<const char*>(std::memchr(namep, '\0', namesEndp - namep));
+        if (!endp) return "Corrupt binary coverage file: " + filename;
+        uint64_t hits;
+        std::memcpy(&hits, countp, sizeof(hits));
+        countp += sizeof(hits);
+        addFn(string{namep, static_cast<size_t>(endp - namep)}, hits);
+        namep = endp + 1;
+    }
+    return "";
+}
 
-    // Testrun and computrons argument unsupported as yet
-    VlcTest* const testp = tests().newTest(filename, 0, 0);
+// Read text or binary format file, calling addFn(point, hits) for each point
+// Returns error message, or empty if ok
+template <typename T_AddFn>
+static string parseCoverage(std::istream& is, const string& filename, T_AddFn addFn) {
+    // Binary format is read whole
+    const size_t magicLen = std::strlen(VL_COVERAGE_BINARY_MAGIC);
+    string magic(magicLen, '\0');
+    is.read(&magic[0], magicLen);
+    if (is && magic == VL_COVERAGE_BINARY_MAGIC) {
+        const string contents{std::istreambuf_iterator<char>{is},
+                              std::istreambuf_iterator<char>{}};
+        return parseCoverageBinary(filename, contents, addFn);
+    }
+    is.clear();
+    is.seekg(0);
 
     while (!is.eof()) {
         const string line = V3Os::getline(is);
@@ -53,16 +95,138 @@ void VlcTop::readCoverage(const string& filename, bool nonfatal) {
             const string point = line.substr(3, secspace - 3);
             const uint64_t hits = std::atoll(line.c_str() + secspace + 1);
             // UINFO(9,"   point '"<<point<<"'"<<" "<<hits<<endl);
+            addFn(point, hits);
+        }
+    }
+    return "";
+}
 
-            const uint64_t pointnum = points().findAddPoint(point, hits);
-            if (opt.rank()) {  // Only if ranking - uses a lot of memory
-                if (hits >= VlcBuckets::sufficient()) {
-                    points().pointNumber(pointnum).testsCoveringInc();
-                    testp->buckets().addData(pointnum, hits);
-                }
+//######################################################################
+// VlcPartial - Points read from a range of input files by one thread
+
+class VlcPartial final {
+    // Each name is stored once, then later hits of the point only add counts
+    using Counts = std::unordered_map<string, uint64_t>;
+    Counts m_counts;  // Point name to hits
+    std::vector<Counts::value_type*> m_order;  // Points in order first read
+
+public:
+    string m_error;  // First error reading files, empty if none
+
+    // METHODS
+    void add(const string& name, uint64_t hits) {
+        const auto pair = m_counts.emplace(name, hits);
+        if (pair.second) {
+            m_order.push_back(&*pair.first);
+        } else {
+            pair.first->second += hits;
+        }
+    }
+    // Merge points from files read after this partial's files
+    void merge(VlcPartial& other) {
+        if (m_counts.empty()) {
+            std::swap(m_counts, other.m_counts);
+            std::swap(m_order, other.m_order);
+        } else {
+            for (const Counts::value_type* const itemp : other.m_order) {
+                add(itemp->first, itemp->second);
             }
         }
+        if (m_error.empty()) m_error = other.m_error;
+        other = VlcPartial{};
+    }
+    template <typename T_Func>
+    void foreach(T_Func func) const {
+        for (const Counts::value_type* const itemp : m_order) func(itemp->first, itemp->second);
+    }
+};
+
+// Call func(i) for i in [0, count) using up to 'jobs' threads, including this one
+template <typename T_Func>
+static void vlcParallelFor(size_t count, unsigned jobs, T_Func func) {
+    std::atomic<size_t> next{0};
+    const auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) func(i);
+    };
+    std::vector<std::thread> threads;
+    const size_t nThreads = std::min<size_t>(jobs, count);
+    for (size_t i = 1; i < nThreads; ++i) threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads) thread.join();
+}
+
+//######################################################################
+
+void VlcTop::addPoint(VlcTest* testp, const string& point, uint64_t hits) {
+    const uint64_t pointnum = points().findAddPoint(point, hits);
+    if (opt.rank()) {  // Only if ranking - uses a lot of memory
+        if (hits >= VlcBuckets::sufficient()) {
+            points().pointNumber(pointnum).testsCoveringInc();
+            testp->buckets().addData(pointnum, hits);
+        }
+    }
+}
+
+void VlcTop::readCoverage(const string& filename, bool nonfatal) {
+    UINFO(2, "readCoverage " << filename << endl);
+
+    std::ifstream is{filename.c_str(), std::ios::in | std::ios::binary};
+    if (!is) {
+        if (!nonfatal) v3fatal("Can't read coverage file: " << filename);
+        return;
+    }
+
+    // Testrun and computrons argument unsupported as yet
+    VlcTest* const testp = tests().newTest(filename, 0, 0);
+
+    const string error = parseCoverage(is, filename, [&](const string& point, uint64_t hits) {
+        addPoint(testp, point, hits);
+    });
+    if (!error.empty()) v3fatal(error);
+}
+
+void VlcTop::readCoverageFiles(const VlStringSet& filenames) {
+    const unsigned jobs
+        = opt.jobs() ? opt.jobs() : std::max(1U, std::thread::hardware_concurrency());
+    // Ranking needs each test's own buckets, so reads point by point
+    if (jobs <= 1 || filenames.size() <= 1 || opt.rank()) {
+        for (const auto& filename : filenames) readCoverage(filename);
+        return;
+    }
+    UINFO(2, "readCoverageFiles " << filenames.size() << " files, " << jobs << " jobs"
+                                  << endl);
+
+    // Parse each file into its own partial
+    const std::vector<string> files{filenames.begin(), filenames.end()};
+    std::vector<VlcPartial> partials(files.size());
+    vlcParallelFor(files.size(), jobs, [&](size_t i) {
+        VlcPartial& partial = partials[i];
+        std::ifstream is{files[i].c_str(), std::ios::in | std::ios::binary};
+        if (!is) {
+            partial.m_error = "Can't read coverage file: " + files[i];
+            return;
+        }
+        partial.m_error = parseCoverage(
+            is, files[i], [&](const string& point, uint64_t hits) { partial.add(point, hits); });
+    });
+
+    // Tree merge, each level merging pairs of neighbors, so first read order is kept
+    for (size_t step = 1; step < partials.size(); step *= 2) {
+        const size_t pairs = (partials.size() + 2 * step - 1) / (2 * step);
+        vlcParallelFor(pairs, jobs, [&](size_t pair) {
+            const size_t i = pair * 2 * step;
+            if (i + step < partials.size()) partials[i].merge(partials[i + step]);
+        });
+    }
+
+    for (const string& filename : files) tests().newTest(filename, 0, 0);
+    const VlcPartial& merged = partials.front();
+    if (!merged.m_error.empty()) {
+        v3fatal(merged.m_error);
+        return;
     }
+    merged.foreach(
+        [&](const string& point, uint64_t hits) { points().findAddPoint(point, hits); });
 }
 
 void VlcTop::writeCoverage(const string& filename) {
@@ -42,6 +42,7 @@ private:
     void annotateCalc();
     void annotateCalcNeeded();
     void annotateOutputFiles(const string& dirname);
+    void addPoint(VlcTest* testp, const string& point, uint64_t hits);
 
 public:
     // CONSTRUCTORS
@@ -56,6 +57,7 @@ public:
     // METHODS
     void annotate(const string& dirname);
     void readCoverage(const string& filename, bool nonfatal = false);
+    void readCoverageFiles(const VlStringSet& filenames);
     void writeCoverage(const string& filename);
     void writeInfo(const string& filename);
 
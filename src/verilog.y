@@ -467,6 +467,9 @@ BISONPRE_VERSION(3.7,%define api.header.include {"V3ParseBison.h"})
 %token<fl>              yVLT_COVERAGE_BLOCK_OFF     "coverage_block_off"
 %token<fl>              yVLT_COVERAGE_OFF           "coverage_off"
 %token<fl>              yVLT_COVERAGE_ON            "coverage_on"
+%token<fl>              yVLT_DPI_THREADS_CONTEXT    "dpi_threads_context"
+%token<fl>              yVLT_DPI_THREADS_SAFE       "dpi_threads_safe"
+%token<fl>              yVLT_DPI_THREADS_SERIAL     "dpi_threads_serial"
 %token<fl>              yVLT_FORCEABLE              "forceable"
 %token<fl>              yVLT_FULL_CASE              "full_case"
 %token<fl>              yVLT_HIER_BLOCK             "hier_block"
@@ -494,6 +497,8 @@ BISONPRE_VERSION(3.7,%define api.header.include {"V3ParseBison.h"})
 %token<fl>              yVLT_TRACING_ON             "tracing_on"
 
 %token<fl>              yVLT_D_BLOCK    "--block"
+%token<fl>              yVLT_D_BRANCH   "--branch"
+%token<fl>              yVLT_D_CFUNC    "--cfunc"
 %token<fl>              yVLT_D_CONTENTS "--contents"
 %token<fl>              yVLT_D_COST     "--cost"
 %token<fl>              yVLT_D_FILE     "--file"
@@ -505,8 +510,10 @@ BISONPRE_VERSION(3.7,%define api.header.include {"V3ParseBison.h"})
 %token<fl>              yVLT_D_MODEL    "--model"
 %token<fl>              yVLT_D_MODULE   "--module"
 %token<fl>              yVLT_D_MTASK    "--mtask"
+%token<fl>              yVLT_D_NOT_TAKEN "--not-taken"
 %token<fl>              yVLT_D_RULE     "--rule"
 %token<fl>              yVLT_D_SCOPE    "--scope"
+%token<fl>              yVLT_D_TAKEN    "--taken"
 %token<fl>              yVLT_D_TASK     "--task"
 %token<fl>              yVLT_D_VAR      "--var"
 %token<fl>              yVLT_D_WORKERS  "--workers"
@@ -971,6 +978,9 @@ BISONPRE_VERSION(3.7,%define api.header.include {"V3ParseBison.h"})
 %token<fl>              yVL_CLOCKER               "/*verilator clocker*/"
 %token<fl>              yVL_CLOCK_ENABLE          "/*verilator clock_enable*/"
 %token<fl>              yVL_COVERAGE_BLOCK_OFF    "/*verilator coverage_block_off*/"
+%token<fl>              yVL_DPI_THREADS_CONTEXT   "/*verilator dpi_threads_context*/"
+%token<fl>              yVL_DPI_THREADS_SAFE      "/*verilator dpi_threads_safe*/"
+%token<fl>              yVL_DPI_THREADS_SERIAL    "/*verilator dpi_threads_serial*/"
 %token<fl>              yVL_FORCEABLE             "/*verilator forceable*/"
 %token<fl>              yVL_FULL_CASE             "/*verilator full_case*/"
 %token<fl>              yVL_HIER_BLOCK            "/*verilator hier_block*/"
@@ -4900,20 +4910,22 @@ array_methodWith<nodeExprp>:
         ;
 
 dpi_import_export<nodep>:       // ==IEEE: dpi_import_export
-                yIMPORT yaSTRING dpi_tf_import_propertyE dpi_importLabelE function_prototype ';'
+                yIMPORT yaSTRING dpi_tf_import_propertyE dpi_importLabelE function_prototype dpi_threadsE ';'
                         { $$ = $5;
                           if (*$4 != "") $5->cname(*$4);
                           $5->dpiContext($3 == iprop_CONTEXT);
                           $5->dpiPure($3 == iprop_PURE);
+                          $5->dpiThreads($6);
                           $5->dpiImport(true);
                           GRAMMARP->checkDpiVer($1, *$2); v3Global.dpi(true);
                           if ($$->prettyName()[0]=='$') SYMP->reinsert($$, nullptr, $$->prettyName());  // For $SysTF overriding
                           SYMP->reinsert($$); }
-        |       yIMPORT yaSTRING dpi_tf_import_propertyE dpi_importLabelE task_prototype ';'
+        |       yIMPORT yaSTRING dpi_tf_import_propertyE dpi_importLabelE task_prototype dpi_threadsE ';'
                         { $$ = $5;
                           if (*$4 != "") $5->cname(*$4);
                           $5->dpiContext($3 == iprop_CONTEXT);
                           $5->dpiPure($3 == iprop_PURE);
+                          $5->dpiThreads($6);
                           $5->dpiImport(true);
                           $5->dpiTask(true);
                           GRAMMARP->checkDpiVer($1, *$2); v3Global.dpi(true);
@@ -4938,6 +4950,13 @@ dpi_tf_import_propertyE<iprop>: // IEEE: [ dpi_function_import_property + dpi_ta
         |       yPURE                                   { $$ = iprop_PURE; }
         ;
 
+dpi_threadsE<dpithreads>:       // Verilator extension: parallel calls of DPI import
+                /* empty */                             { $$ = VDpiThreads::DEFAULT; }
+        |       yVL_DPI_THREADS_CONTEXT                 { $$ = VDpiThreads::CONTEXT; }
+        |       yVL_DPI_THREADS_SAFE                    { $$ = VDpiThreads::SAFE; }
+        |       yVL_DPI_THREADS_SERIAL                  { $$ = VDpiThreads::SERIAL; }
+        ;
+
 
 //************************************************
 // Expressions
@@ -7798,6 +7817,8 @@ vltItem:
                         { V3Config::addVarAttr($<fl>1, *$2, *$3, *$4, $1, $5); }
         |       vltInlineFront vltDModuleE vltDFTaskE
                         { V3Config::addInline($<fl>1, *$2, *$3, $1); }
+        |       vltDpiThreadsFront vltDModuleE vltDFTaskE
+                        { V3Config::addDpiThreads($<fl>1, *$2, *$3, $1); }
         |       yVLT_COVERAGE_BLOCK_OFF vltDFile
                         { V3Config::addCoverageBlockOff(*$2, 0); }
         |       yVLT_COVERAGE_BLOCK_OFF vltDFile yVLT_D_LINES yaINTNUM
@@ -7824,6 +7845,10 @@ vltItem:
                         { V3Config::addProfileData($<fl>1, *$2, $3->toUQuad()); }
         |       yVLT_PROFILE_DATA vltDModel vltDMtask vltDCost
                         { V3Config::addProfileData($<fl>1, *$2, *$3, $4->toUQuad()); }
+        |       yVLT_PROFILE_DATA vltDCFunc vltDCost
+                        { V3Config::addProfileCFunc($<fl>1, *$2, $3->toUQuad()); }
+        |       yVLT_PROFILE_DATA vltDBranch vltDTaken vltDNotTaken
+                        { V3Config::addProfileBranch($<fl>1, *$2, $3->toUQuad(), $4->toUQuad()); }
         ;
 
 vltOffFront<errcodeen>:
@@ -7854,6 +7879,14 @@ vltDBlock<strp>:  // --block <arg>
                 yVLT_D_BLOCK str                        { $$ = $2; }
         ;
 
+vltDBranch<strp>:  // --branch <arg>
+                yVLT_D_BRANCH str                       { $$ = $2; }
+        ;
+
+vltDCFunc<strp>:  // --cfunc <arg>
+                yVLT_D_CFUNC str                        { $$ = $2; }
+        ;
+
 vltDContents<strp>:
                 yVLT_D_CONTENTS str                     { $$ = $2; }
         ;
@@ -7886,6 +7919,10 @@ vltDMtask<strp>:  // --mtask <arg>
                 yVLT_D_MTASK str                        { $$ = $2; }
         ;
 
+vltDNotTaken<nump>:  // --not-taken <arg>
+                yVLT_D_NOT_TAKEN yaINTNUM               { $$ = $2; }
+        ;
+
 vltDModule<strp>:  // --module <arg>
                 yVLT_D_MODULE str                       { $$ = $2; }
         ;
@@ -7899,6 +7936,10 @@ vltDScope<strp>:  // --scope <arg>
                 yVLT_D_SCOPE str                        { $$ = $2; }
         ;
 
+vltDTaken<nump>:  // --taken <arg>
+                yVLT_D_TAKEN yaINTNUM                   { $$ = $2; }
+        ;
+
 vltDFTaskE<strp>:
                 /* empty */                             { static string empty; $$ = &empty; }
         |       yVLT_D_FUNCTION str                     { $$ = $2; }
@@ -7909,6 +7950,12 @@ vltDWorkers<nump>:  // --workers <arg>
                 yVLT_D_WORKERS yaINTNUM                  { $$ = $2; }
         ;
 
+vltDpiThreadsFront<dpithreads>:
+                yVLT_DPI_THREADS_CONTEXT                { $$ = VDpiThreads::CONTEXT; }
+        |       yVLT_DPI_THREADS_SAFE                   { $$ = VDpiThreads::SAFE; }
+        |       yVLT_DPI_THREADS_SERIAL                 { $$ = VDpiThreads::SERIAL; }
+        ;
+
 vltInlineFront<cbool>:
                 yVLT_INLINE                             { $$ = true; }
         |       yVLT_NO_INLINE                          { $$ = false; }
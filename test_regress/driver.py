@@ -367,6 +367,7 @@ class Runner:
         self._last_summary_left = 0
         self._running_ids = {}
         self._msg_fail_max_skip = False
+        self.benchmarks = {}  # --benchmark results, by test name and scenario
         Runner.runner = self
 
     def one_test(self, py_filename: str, scenario: str, rerun_skipping=False) -> None:
@@ -443,6 +444,8 @@ class Runner:
         test._read_status()
         if test.ok:
             self.ok_cnt += 1
+            if Args.benchmark and test._benchmark:
+                self.benchmarks[test.name + " " + test.scenario] = test._benchmark
             if Args.driver_clean:
                 test.clean()
         elif test._quit:
@@ -487,6 +490,8 @@ class Runner:
                 time.sleep(0.1)
         self.report(None)
         self.report(self.driver_log_filename)
+        if Args.benchmark:
+            self.benchmark_report(re.sub(r'\.log$', '_benchmark.json', self.driver_log_filename))
 
     def report(self, filename: str) -> None:
         if filename:
@@ -510,6 +515,45 @@ class Runner:
             sumtxt = 'PASSED'
         fh.write("==TESTS DONE, " + sumtxt + ": " + self.sprint_summary() + "\n")
 
+    def benchmark_report(self, filename: str) -> None:
+        if not self.benchmarks:
+            return
+        with open(filename, "w", encoding="utf8") as fh:
+            json.dump(self.benchmarks, fh, indent=2, sort_keys=True)
+        baseline = {}
+        if Args.benchmark_baseline:
+            with open(Args.benchmark_baseline, "r", encoding="utf8") as fh:
+                baseline = json.load(fh)
+        # Larger is better for cycles/s, smaller for the others
+        columns = (('cycles_per_s', 'Cycles/s', True), ('verilate_s', 'Verilate s', False),
+                   ('compile_s', 'Compile s', False), ('simulate_s', 'Simulate s', False),
+                   ('peak_rss_mb', 'Peak RSS MB', False))
+        print('=' * 70)
+        print("==BENCHMARKS: written to " + filename +
+              ((", compared to " + Args.benchmark_baseline) if baseline else ""))
+        print("  %-36s" % "Test" + ''.join(" %13s" % title for (_, title, _) in columns))
+        regressed = 0
+        for name in sorted(self.benchmarks):
+            result = self.benchmarks[name]
+            base = baseline.get(name, {})
+            line = "  %-36s" % name
+            notes = []
+            for (key, title, higher_better) in columns:
+                value = result.get(key)
+                line += (" %13.3f" % value) if value is not None else (" %13s" % "-")
+                if value is None or not base.get(key):
+                    continue
+                change = (value - base[key]) / base[key] * 100.0
+                if (-change if higher_better else change) > Args.benchmark_tolerance:
+                    notes.append("%s %+.0f%%" % (title, change))
+            print(line)
+            if notes:
+                regressed += 1
+                print("  %-36s REGRESSED: %s" % ("", ', '.join(notes)))
+        if baseline:
+            print("==BENCHMARKS: %d of %d regressed more than %g%% from baseline" %
+                  (regressed, len(self.benchmarks), Args.benchmark_tolerance))
+
     def print_summary(self, force=False):
         change = self._last_summary_left != self.left_cnt
         if (force or ((time.time() - self._last_summary_time) >= 15)
@@ -622,6 +666,7 @@ class VlTest:
 
         self.benchmark = Args.benchmark
         self.benchmarksim = False
+        self._benchmark = {}  # --benchmark results of this test, passed to the driver
         self.clean_command = None
         self.context_threads = 0  # Number of threads to allocate in the context
         self.errors = None
@@ -682,8 +727,8 @@ class VlTest:
         self.v_flags += [define_opt + "TEST_OBJ_DIR=" + self.obj_dir]
         if Args.verbose:
             self.v_flags += [define_opt + "TEST_VERBOSE=1"]
-        if Args.benchmark:
-            self.v_flags += [define_opt + "TEST_BENCHMARK=Args.benchmark"]
+        if Args.benchmark and Args.benchmark is not True:
+            self.v_flags += [define_opt + "TEST_BENCHMARK=" + Args.benchmark]
         if Args.trace:
             self.v_flags += [define_opt + "WAVES=1"]
 
@@ -935,6 +980,7 @@ class VlTest:
                 '_ok': self._ok,
                 '_scenario_off': self._scenario_off,
                 '_skips': self._skips,
+                '_benchmark': self._benchmark,
                 'errors': self.errors,
             }
             pickle.dump(pass_to_driver, fh)
@@ -1278,6 +1324,7 @@ class VlTest:
                              tee=param['tee'],
                              expect_filename=param['expect_filename'],
                              verilator_run=True,
+                             benchmark_stage='verilate',
                              cmd=vlt_cmd)
 
             if param['verilator_make_cmake']:
@@ -1294,6 +1341,7 @@ class VlTest:
                     tee=param['tee'],
                     expect_filename=param['expect_filename'],
                     verilator_run=True,
+                    benchmark_stage='verilate',
                     cmd=[
                         "cd \"" + self.obj_dir + "\" && cmake",
                         "\"" + self.t_dir + "/..\"",
@@ -1319,6 +1367,7 @@ class VlTest:
                 self.run(
                     logfile=self.obj_dir + "/vlt_gcc.log",
                     entering=self.obj_dir,
+                    benchmark_stage='compile',
                     cmd=[
                         os.environ['MAKE'],
                         "-C " + self.obj_dir,
@@ -1338,6 +1387,7 @@ class VlTest:
                 if self.verbose:
                     self.oprint("Running cmake --build")
                 self.run(logfile=self.obj_dir + "/vlt_cmake_build.log",
+                         benchmark_stage='compile',
                          cmd=[
                              "cmake",
                              "--build",
@@ -1528,6 +1578,7 @@ class VlTest:
                 logfile=param.get('logfile', self.obj_dir + "/vlt_sim.log"),
                 tee=param['tee'],
                 verilator_run=True,
+                benchmark_stage='simulate',
             )
         else:
             self.error("No execute step for this simulator")
@@ -1678,7 +1729,8 @@ class VlTest:
             fails=False,  # Command should fail
             logfile=None,  # Filename to write putput to
             tee=True,
-            verilator_run=False) -> str:  # Move gcov data to parallel area
+            verilator_run=False,  # Move gcov data to parallel area
+            benchmark_stage=None) -> str:  # With --benchmark, record under this stage
 
         try:
             command = ' '.join(cmd)
@@ -1721,6 +1773,8 @@ class VlTest:
         if logfile:
             logfh = open(logfile, 'wb')  # pylint: disable=consider-using-with
 
+        start_time = time.time()
+        rusage = None
         if not Args.interactive_debugger:
             # Become TTY controlling termal so GDB will not capture main driver.py's terminal
             pid, fd = pty.fork()
@@ -1736,7 +1790,7 @@ class VlTest:
                     except OSError:
                         break
 
-                (pid, rc) = os.waitpid(pid, 0)
+                (pid, rc, rusage) = os.wait4(pid, 0)
 
         else:
             with subprocess.Popen(command,
@@ -1761,6 +1815,9 @@ class VlTest:
         if logfh:
             logfh.close()
 
+        if Args.benchmark and benchmark_stage:
+            self._benchmark_record(benchmark_stage, time.time() - start_time, rusage, logfile)
+
         if (rc in (
                 -4,  # SIGILL
                 -8,  # SIGFPA
@@ -1804,6 +1861,24 @@ class VlTest:
 
         return True
 
+    def _benchmark_record(self, stage: str, seconds: float, rusage, logfile) -> None:
+        # Times and peak RSS of each stage sum or max over the test's runs
+        self._benchmark[stage + "_s"] = self._benchmark.get(stage + "_s", 0) + seconds
+        if rusage:
+            # ru_maxrss is in KiB, except bytes on macOS
+            rss_mb = rusage.ru_maxrss / (1024 * 1024 if platform.system() == "Darwin" else 1024)
+            self._benchmark['peak_rss_mb'] = max(self._benchmark.get('peak_rss_mb', 0), rss_mb)
+        if stage == 'simulate' and logfile and os.path.exists(logfile):
+            with open(logfile, 'r', encoding="latin-1") as fh:
+                for line in fh:
+                    match = re.search(r'\*-\* Benchmark cycles (\d+) \*-\*', line)
+                    if match:
+                        self._benchmark['cycles'] = (self._benchmark.get('cycles', 0) +
+                                                     int(match.group(1)))
+            if self._benchmark.get('cycles'):
+                self._benchmark['cycles_per_s'] = (self._benchmark['cycles'] /
+                                                   max(self._benchmark['simulate_s'], 1e-6))
+
     def _run_output(self, data, logfh, tee):
         if re.search(r'--debug-exit-uvm23: Exiting', str(data)):
             self._force_pass = True
@@ -2801,7 +2876,19 @@ if __name__ == '__main__':
 
     SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0""")
 
-    parser.add_argument('--benchmark', action='store', help='enable benchmarking')
+    parser.add_argument('--benchmark',
+                        action='store',
+                        nargs='?',
+                        const=True,
+                        help='enable benchmarking, optionally with number of cycles')
+    parser.add_argument('--benchmark-baseline',
+                        action='store',
+                        help='compare --benchmark results to those in an earlier run\'s json')
+    parser.add_argument('--benchmark-tolerance',
+                        action='store',
+                        default=10.0,
+                        type=float,
+                        help='percentage change reported as a --benchmark regression')
     parser.add_argument('--debug', action='store_const', const=9, help='enable debug')
     # --debugi: see _parameter()
     parser.add_argument('--driver-clean', action='store_true', help='clean after test passes')
@@ -2873,6 +2960,11 @@ if __name__ == '__main__':
     if Args.jobs > 1 and Args.interactive_debugger:
         sys.exit("%Error: Unable to use -j > 1 with --gdb* and --rr* options")
 
+    if Args.benchmark and Args.benchmark is not True and re.search(r'\.py$', Args.benchmark):
+        Arg_Tests.append(Args.benchmark)  # Was a test, not the optional number of cycles
+        Args.benchmark = True
+    if Args.benchmark and Args.benchmark is not True and not re.match(r'^\d+$', Args.benchmark):
+        sys.exit("%Error: Expected number of cycles following --benchmark: " + Args.benchmark)
     if Args.golden:
         os.environ['HARNESS_UPDATE_GOLDEN'] = '1'
     if Args.jobs == 0:
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = test.obj_dir + "/t_alw_split_cost.v"
+
+N = 2000
+
+
+def gen(filename):
+    with open(filename, 'w', encoding="utf8") as fh:
+        fh.write("// Generated by t_alw_split_cost.py\n")
+        fh.write("module t (clk);\n")
+        fh.write("  input clk;\n")
+        fh.write("  integer cyc = 0;\n")
+        fh.write("  reg [63:0] in = 64'h1234;\n")
+        fh.write("  reg [63:0] o;\n")
+        for i in range(1, N + 1):
+            fh.write("  reg [63:0] t%04d;\n" % i)
+        fh.write("\n")
+        fh.write("  function automatic [63:0] f(input [63:0] x);\n")
+        fh.write("    for (int k = 1; k <= %d; ++k) x = (x * 64'h9e3779b97f4a7c15) ^ (x >> 3)"
+                 " ^ 64'(k);\n" % N)
+        fh.write("    return x;\n")
+        fh.write("  endfunction\n")
+        fh.write("\n")
+        # One chain of dependencies, so no independent groups, but cheap to cut
+        fh.write("  always @(posedge clk) begin\n")
+        prev = "in"
+        for i in range(1, N + 1):
+            fh.write("    t%04d = (%s * 64'h9e3779b97f4a7c15) ^ (%s >> 3) ^ 64'd%d;\n" %
+                     (i, prev, prev, i))
+            prev = "t%04d" % i
+        fh.write("    o <= " + prev + ";\n")
+        fh.write("  end\n")
+        fh.write("\n")
+        fh.write("  always @(posedge clk) begin\n")
+        fh.write("    cyc <= cyc + 1;\n")
+        fh.write("    in <= in + 64'h1;\n")
+        fh.write("    if (cyc > 0 && o != f(in - 64'h1)) $stop;\n")
+        fh.write("    if (cyc == 10) begin\n")
+        fh.write('      $write("*-* All Finished *-*\\n");' + "\n")
+        fh.write("      $finish;\n")
+        fh.write("    end\n")
+        fh.write("  end\n")
+        fh.write("endmodule\n")
+
+
+gen(test.top_filename)
+
+test.compile(verilator_flags2=["--stats", "-fno-dfg", "-Wno-BLKSEQ"])
+
+test.execute()
+
+test.file_grep(test.stats, r'Optimizations, Split always by cost\s+[1-9]')
+
+test.passes()
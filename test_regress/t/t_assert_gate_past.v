@@ -0,0 +1,34 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+   integer cyc = 0;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      // $past outside of assertions is never gated
+      if (cyc > 1 && $past(cyc) != cyc - 1) $stop;
+      if (cyc > 2 && $past(cyc, 2) != cyc - 2) $stop;
+      if (cyc == 10) begin
+         // History of the assertions below is no longer updated
+         $assertoff;
+      end
+      else if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   assert property (@(posedge clk) cyc > 1 |-> $past(cyc) == cyc - 1);
+   assert property (@(posedge clk) cyc > 2 |-> $past(cyc, 2) == cyc - 2);
+   assert property (@(posedge clk) cyc > 1 |-> $rose(cyc[0]) == cyc[0]);
+
+endmodule
@@ -0,0 +1,31 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+   integer cyc = 0;
+   integer fails = 0;
+   wire [31:0] cyc_next = cyc + 1;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 20) begin
+         if (fails != 0) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // Properties see the values from before the clock edge
+   assert property (@(posedge clk) cyc_next == cyc + 1) else fails <= fails + 1;
+   assert property (@(posedge clk) cyc > 0 |-> $past(cyc_next) == cyc) else fails <= fails + 1;
+   assert property (@(posedge clk) cyc > 0 |-> $changed(cyc)) else fails <= fails + 1;
+
+endmodule
@@ -0,0 +1,58 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); $stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   // Only indexed, so may be a hash table
+   int      sparse[int];
+   logic [63:0] mem[bit [39:0]];
+   // Iterated, so must keep element order
+   int      ordered[int];
+
+   integer cyc = 0;
+   int     i;
+   int     k;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc < 10) begin
+         sparse[cyc * 1000] = cyc;
+         mem[40'h1_0000_0000 * cyc] = 64'h1234_5678_9abc_0000 + 64'(cyc);
+         ordered[10 - cyc] = cyc;
+      end
+      else if (cyc == 10) begin
+         `checkh(sparse.num(), 10);
+         `checkh(sparse.exists(3000), 1);
+         `checkh(sparse.exists(3001), 0);
+         `checkh(sparse[9000], 9);
+         `checkh(sparse[12345], 0);
+         sparse.delete(3000);
+         `checkh(sparse.size(), 9);
+         `checkh(sparse.exists(3000), 0);
+         `checkh(mem[40'h5_0000_0000], 64'h1234_5678_9abc_0005);
+         `checkh(mem.exists(40'h5_0000_0001), 0);
+         i = 0;
+         foreach (ordered[idx]) begin
+            `checkh(idx, i + 1);
+            i = i + 1;
+         end
+         `checkh(ordered.first(k), 1);
+         `checkh(k, 1);
+         sparse.delete();
+         `checkh(sparse.num(), 0);
+      end
+      else if (cyc == 11) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.top_filename = "t/t_threads_counter.v"
+
+test.compile(verilator_flags2=['--stats', '--ast-spill-dir', test.obj_dir])
+
+test.execute()
+
+test.file_grep(test.stats, r'Node arena spill file \(MiB\)\s+\d+')
+
+test.passes()
@@ -0,0 +1,104 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Benchmark: small processor cores running a pseudo-random program.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   localparam CYCLES =
+`ifdef TEST_BENCHMARK
+                       `TEST_BENCHMARK;
+`else
+                       2000;
+`endif
+   localparam NCORES = 4;
+
+   integer cyc = 0;
+   wire    rst = (cyc < 2);
+
+   wire [31:0] sums [0:NCORES-1];
+
+   for (genvar g = 0; g < NCORES; ++g) begin : cores
+      t_bench_cpu_core #(.ID(g))
+      core (.clk(clk), .rst(rst), .sum(sums[g]));
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == CYCLES) begin
+         $write("sums %x %x %x %x\n", sums[0], sums[1], sums[2], sums[3]);
+         $write("*-* Benchmark cycles %0d *-*\n", cyc);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+// Single cycle core with a register file, ALU, loads, stores and branches
+module t_bench_cpu_core #(parameter ID = 0)
+   (input clk,
+    input rst,
+    output reg [31:0] sum);
+
+   reg [31:0] imem [0:255];
+   reg [31:0] dmem [0:255];
+   reg [31:0] regs [0:31];
+   reg [7:0]  pc;
+
+   wire [31:0] ins = imem[pc];
+   wire [3:0]  op = ins[31:28];
+   wire [4:0]  rd = ins[27:23];
+   wire [4:0]  rs1 = ins[22:18];
+   wire [4:0]  rs2 = ins[17:13];
+   wire [12:0] imm = ins[12:0];
+   wire [31:0] a = regs[rs1];
+   wire [31:0] b = regs[rs2];
+   wire [7:0]  addr = a[7:0] + imm[7:0];
+
+   reg [31:0]  res;
+   always @* begin
+      case (op)
+        4'h0: res = a + b;
+        4'h1: res = a - b;
+        4'h2: res = a ^ b;
+        4'h3: res = a & b;
+        4'h4: res = a | b;
+        4'h5: res = a << b[4:0];
+        4'h6: res = a >> b[4:0];
+        4'h7: res = a * b;
+        4'h8: res = a + {{19{imm[12]}}, imm};
+        4'h9: res = dmem[addr];
+        4'ha: res = {31'b0, $signed(a) < $signed(b)};
+        default: res = a;
+      endcase
+   end
+
+   always @(posedge clk) begin
+      if (rst) begin
+         pc <= 8'd0;
+         sum <= 32'd0;
+      end
+      else begin
+         if (op == 4'hb) dmem[addr] <= b;
+         else if (op < 4'hb && rd != 5'd0) regs[rd] <= res;
+         if (op == 4'hc && a != b) pc <= pc + imm[7:0];
+         else pc <= pc + 8'd1;
+         sum <= sum + res;
+      end
+   end
+
+   initial begin
+      for (int i = 0; i < 256; ++i) begin
+         imem[i] = (i * 32'h9e3779b1) ^ (ID * 32'h7f4a7c15) ^ ((i * i) << 7);
+         dmem[i] = i;
+      end
+      for (int i = 0; i < 32; ++i) regs[i] = i * 3 + ID;
+   end
+endmodule
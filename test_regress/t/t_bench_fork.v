@@ -0,0 +1,64 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Benchmark: fork..join, fork..join_any and fork..join_none throughput.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   localparam CYCLES =
+`ifdef TEST_BENCHMARK
+                       `TEST_BENCHMARK;
+`else
+                       2000;
+`endif
+   localparam NFORKS = 16;
+
+   logic clk = 0;
+   always #5 clk = ~clk;
+
+   int cyc = 0;
+   int joined = 0;
+   int joined_any = 0;
+   int spawned = 0;
+
+   always @(posedge clk) cyc <= cyc + 1;
+
+   // Many forks per cycle, each joined before the next
+   initial forever begin
+      @(posedge clk);
+      for (int i = 0; i < NFORKS; ++i) begin
+         fork
+            ++joined;
+            begin
+               #1;
+               ++joined;
+            end
+         join
+         fork
+            #1;
+            #2;
+         join_any
+         ++joined_any;
+      end
+   end
+
+   // Fire and forget processes
+   always @(posedge clk) begin
+      for (int i = 0; i < NFORKS; ++i) begin
+         fork
+            ++spawned;
+         join_none
+      end
+   end
+
+   always @(posedge clk) begin
+      if (cyc == CYCLES) begin
+         $write("joined %0d joined_any %0d spawned %0d\n", joined, joined_any, spawned);
+         $write("*-* Benchmark cycles %0d *-*\n", cyc);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
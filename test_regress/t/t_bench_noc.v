@@ -0,0 +1,159 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Benchmark: mesh network-on-chip with XY routing and random traffic.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   localparam CYCLES =
+`ifdef TEST_BENCHMARK
+                       `TEST_BENCHMARK;
+`else
+                       2000;
+`endif
+   localparam DIM = 4;  // Routers in each dimension
+
+   integer cyc = 0;
+   wire    rst = (cyc < 2);
+
+   // Router outputs, by router; ports 0-3 are north, east, south, west
+   wire [3:0]   out_valid [0:DIM*DIM-1];
+   wire [127:0] out_data [0:DIM*DIM-1];
+   wire [3:0]   in_ready [0:DIM*DIM-1];
+   wire [31:0]  received [0:DIM*DIM-1];
+
+   for (genvar y = 0; y < DIM; ++y) begin : row
+      for (genvar x = 0; x < DIM; ++x) begin : col
+         wire [3:0]   nb_valid;
+         wire [127:0] nb_data;
+         wire [3:0]   nb_ready;
+         // Connect each port to the opposite port of the neighbour
+         for (genvar p = 0; p < 4; ++p) begin : port
+            localparam NX = x + (p == 1 ? 1 : p == 3 ? -1 : 0);
+            localparam NY = y + (p == 2 ? 1 : p == 0 ? -1 : 0);
+            if (NX >= 0 && NX < DIM && NY >= 0 && NY < DIM) begin : link
+               assign nb_valid[p] = out_valid[NY * DIM + NX][(p + 2) % 4];
+               assign nb_data[p * 32 +: 32] = out_data[NY * DIM + NX][((p + 2) % 4) * 32 +: 32];
+               assign nb_ready[p] = in_ready[NY * DIM + NX][(p + 2) % 4];
+            end
+            else begin : border
+               assign nb_valid[p] = 1'b0;
+               assign nb_data[p * 32 +: 32] = 32'b0;
+               assign nb_ready[p] = 1'b0;
+            end
+         end
+         t_bench_noc_router #(.X(x), .Y(y), .SEED(y * DIM + x + 1))
+         router (.clk(clk), .rst(rst),
+                 .in_valid(nb_valid), .in_data(nb_data), .out_ready(nb_ready),
+                 .out_valid(out_valid[y * DIM + x]), .out_data(out_data[y * DIM + x]),
+                 .in_ready(in_ready[y * DIM + x]), .received(received[y * DIM + x]));
+      end
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == CYCLES) begin
+         for (int i = 0; i < DIM * DIM; ++i) $write(" %0d", received[i]);
+         $write("\n");
+         $write("*-* Benchmark cycles %0d *-*\n", cyc);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+// Router with a one flit buffer per input, and local injection from an LFSR.
+// A flit's top bits are its destination X and Y. Neighbours only send into
+// empty buffers, so there is no combinational path between routers.
+module t_bench_noc_router #(parameter X = 0, parameter Y = 0, parameter SEED = 1)
+   (input clk,
+    input rst,
+    input [3:0] in_valid,
+    input [127:0] in_data,
+    input [3:0] out_ready,
+    output [3:0] out_valid,
+    output [127:0] out_data,
+    output [3:0] in_ready,
+    output reg [31:0] received);
+
+   localparam logic [1:0] XB = X[1:0];
+   localparam logic [1:0] YB = Y[1:0];
+
+   reg [4:0]  buf_valid;  // Ports 0-3 from neighbours, 4 local injection
+   reg [31:0] buf_data [0:4];
+   reg [31:0] lfsr;
+   integer    prio;  // Input with the highest priority this cycle
+
+   // Output port of each buffered flit
+   reg [2:0]  route [0:4];
+   always @* begin
+      for (int i = 0; i < 5; ++i) begin
+         if (buf_data[i][31:30] > XB) route[i] = 3'd1;
+         else if (buf_data[i][31:30] < XB) route[i] = 3'd3;
+         else if (buf_data[i][29:28] > YB) route[i] = 3'd2;
+         else if (buf_data[i][29:28] < YB) route[i] = 3'd0;
+         else route[i] = 3'd4;
+      end
+   end
+
+   // Grant each output port to one input, rotating priority
+   reg [4:0]  grant;
+   reg [4:0]  busy;
+   reg [2:0]  sel [0:4];
+   integer    src;
+   always @* begin
+      grant = 5'b0;
+      busy = 5'b0;
+      for (int o = 0; o < 5; ++o) sel[o] = 3'd0;
+      for (int k = 0; k < 5; ++k) begin
+         src = (k + prio) % 5;
+         if (buf_valid[src] && !busy[route[src]]
+             && (route[src] == 3'd4 || out_ready[route[src][1:0]])) begin
+            grant[src] = 1'b1;
+            busy[route[src]] = 1'b1;
+            sel[route[src]] = src[2:0];
+         end
+      end
+   end
+
+   assign in_ready = ~buf_valid[3:0];
+   for (genvar o = 0; o < 4; ++o) begin : outs
+      assign out_valid[o] = busy[o];
+      assign out_data[o * 32 +: 32] = buf_data[sel[o]];
+   end
+
+   always @(posedge clk) begin
+      if (rst) begin
+         buf_valid <= 5'b0;
+         lfsr <= SEED;
+         prio <= 0;
+         received <= 32'd0;
+      end
+      else begin
+         prio <= (prio == 4) ? 0 : prio + 1;
+         lfsr <= {lfsr[30:0], lfsr[31] ^ lfsr[21] ^ lfsr[1] ^ lfsr[0]};
+         if (busy[4]) received <= received + 32'd1;
+         for (int p = 0; p < 4; ++p) begin
+            if (grant[p]) buf_valid[p] <= 1'b0;
+            if (in_valid[p]) begin
+               buf_valid[p] <= 1'b1;
+               buf_data[p] <= in_data[p * 32 +: 32];
+            end
+         end
+         if (grant[4]) begin
+            buf_valid[4] <= 1'b0;
+         end
+         else if (!buf_valid[4]) begin
+            buf_valid[4] <= 1'b1;
+            buf_data[4] <= lfsr;
+         end
+      end
+   end
+endmodule
@@ -0,0 +1,71 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Benchmark: testbench style code with delays, events and forked processes.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   localparam CYCLES =
+`ifdef TEST_BENCHMARK
+                       `TEST_BENCHMARK;
+`else
+                       2000;
+`endif
+   localparam NPAIRS = 8;
+
+   logic clk = 0;
+   always #5 clk = ~clk;
+
+   int cyc = 0;
+   int spawned = 0;
+   int handshakes = 0;
+
+   always @(posedge clk) cyc <= cyc + 1;
+
+   // Producer and consumer pairs, handshaking with events every cycle
+   for (genvar g = 0; g < NPAIRS; ++g) begin : pairs
+      event req;
+      event ack;
+      initial forever begin
+         @(posedge clk);
+         #(g + 1);
+         ->req;
+         @(ack);
+      end
+      initial forever begin
+         @(req);
+         #1;
+         ++handshakes;
+         ->ack;
+      end
+   end
+
+   // Short lived processes forked every cycle
+   always @(posedge clk) begin
+      fork
+         begin
+            #3;
+            ++spawned;
+         end
+      join_none
+   end
+
+   // Processes waiting on conditions
+   for (genvar g = 0; g < NPAIRS; ++g) begin : waiters
+      initial forever begin
+         wait (cyc % NPAIRS == g);
+         @(negedge clk);
+      end
+   end
+
+   always @(posedge clk) begin
+      if (cyc == CYCLES) begin
+         $write("handshakes %0d spawned %0d\n", handshakes, spawned);
+         $write("*-* Benchmark cycles %0d *-*\n", cyc);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
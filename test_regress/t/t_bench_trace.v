@@ -0,0 +1,66 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Benchmark: many signals changing every cycle, dumped to a VCD trace.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define STRINGIFY(x) `"x`"
+
+module t;
+   localparam CYCLES =
+`ifdef TEST_BENCHMARK
+                       `TEST_BENCHMARK;
+`else
+                       1000;
+`endif
+   localparam NUNITS = 32;
+
+   logic clk = 0;
+   always #5 clk = ~clk;
+
+   int cyc = 0;
+   always @(posedge clk) cyc <= cyc + 1;
+
+   wire [31:0] outs [0:NUNITS-1];
+
+   for (genvar g = 0; g < NUNITS; ++g) begin : units
+      t_bench_trace_unit #(.SEED(g + 1))
+      unit (.clk(clk), .out(outs[g]));
+   end
+
+   initial begin
+      $dumpfile(`STRINGIFY(`TEST_DUMPFILE));
+      $dumpvars;
+   end
+
+   always @(posedge clk) begin
+      if (cyc == CYCLES) begin
+         $write("out %x\n", outs[0]);
+         $write("*-* Benchmark cycles %0d *-*\n", cyc);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module t_bench_trace_unit #(parameter SEED = 1)
+   (input clk,
+    output [31:0] out);
+
+   reg [31:0]  count = 0;
+   reg [31:0]  lfsr = SEED;
+   reg [127:0] wide = {4{SEED[31:0]}};
+   reg [7:0]   bytes [0:7];
+   wire        parity = ^lfsr;
+
+   always @(posedge clk) begin
+      count <= count + 32'd1;
+      lfsr <= {lfsr[30:0], lfsr[31] ^ lfsr[21] ^ lfsr[1] ^ lfsr[0]};
+      wide <= {wide[95:0], wide[127:96] ^ lfsr};
+      bytes[count[2:0]] <= lfsr[7:0];
+   end
+
+   assign out = count ^ lfsr ^ wide[31:0] ^ {31'd0, parity};
+endmodule
@@ -0,0 +1,75 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Benchmark: wide datapath arithmetic, shifts and reductions.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   localparam CYCLES =
+`ifdef TEST_BENCHMARK
+                       `TEST_BENCHMARK;
+`else
+                       2000;
+`endif
+   localparam NLANES = 4;
+
+   integer cyc = 0;
+   wire    rst = (cyc < 2);
+
+   wire [63:0] sigs [0:NLANES-1];
+
+   for (genvar g = 0; g < NLANES; ++g) begin : lanes
+      t_bench_wide_lane #(.SEED(g + 1))
+      lane (.clk(clk), .rst(rst), .sig(sigs[g]));
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == CYCLES) begin
+         $write("sigs %x %x %x %x\n", sigs[0], sigs[1], sigs[2], sigs[3]);
+         $write("*-* Benchmark cycles %0d *-*\n", cyc);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module t_bench_wide_lane #(parameter SEED = 1)
+   (input clk,
+    input rst,
+    output [63:0] sig);
+
+   reg [1023:0] a;
+   reg [1023:0] b;
+   reg [1023:0] acc;
+   reg [31:0]   ones;
+
+   wire [255:0]  prod = a[255:0] * b[767:512];
+   wire [1023:0] sum = a + b;
+   wire [1023:0] shifted = (a >> b[9:0]) | (b << a[9:0]);
+   wire [1023:0] mixed = {sum[511:0], sum[1023:512]} ^ shifted ^ {4{prod}};
+
+   always @(posedge clk) begin
+      if (rst) begin
+         a <= {32{SEED[31:0]}};
+         b <= ~{32{SEED[31:0]}};
+         acc <= '0;
+         ones <= 32'd0;
+      end
+      else begin
+         a <= {a[1022:0], a[1023] ^ a[1018] ^ a[1017] ^ a[1003]} ^ (b >> 7);
+         b <= mixed;
+         acc <= acc + (mixed & ~acc);
+         ones <= ones + $countones(acc);
+      end
+   end
+
+   assign sig = acc[63:0] ^ acc[1023:960] ^ {32'd0, ones};
+endmodule
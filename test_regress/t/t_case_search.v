@@ -0,0 +1,55 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+   reg [63:0] sum = 64'h0;
+
+   // State machine with a wide, sparse state encoding
+   reg [39:0] state = 40'h0;
+   reg [39:0] state_n;
+   reg [7:0]  out;
+
+   always @* begin
+      out = 8'h0;
+      case (state)
+        40'h00_0000_0000: begin state_n = 40'h00_0000_0010; out = 8'h01; end
+        40'h00_0000_0010: begin state_n = crc[0] ? 40'h00_0000_3000 : 40'h10_0000_0000; out = 8'h02; end
+        40'h00_0000_3000: begin state_n = 40'h00_0050_0000; out = 8'h03; end
+        40'h00_0050_0000: begin state_n = crc[1] ? 40'h00_7000_0000 : 40'h00_0000_0010; out = 8'h04; end
+        40'h00_7000_0000: begin state_n = 40'h09_0000_0000; out = 8'h05; end
+        40'h09_0000_0000: begin state_n = 40'h10_0000_0000; out = 8'h06; end
+        40'h10_0000_0000: begin state_n = crc[2] ? 40'h00_0000_0000 : 40'h11_0000_0001; out = 8'h07; end
+        40'h11_0000_0001: begin state_n = 40'h12_0000_0002; out = 8'h08; end
+        40'h12_0000_0002,
+        40'h12_0000_0003: begin state_n = 40'h00_0000_3000; out = 8'h09; end
+        40'hff_ffff_ffff: begin state_n = 40'h00_0000_0000; out = 8'h0a; end
+        default: begin state_n = 40'hff_ffff_ffff; out = 8'hee; end
+      endcase
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      sum <= {sum[62:0], sum[63] ^ sum[2] ^ sum[0]} ^ {state[31:0], out, state_n[23:0]};
+      state <= state_n;
+      if (cyc == 5) state <= 40'h12_0000_0003;
+      if (cyc == 9) state <= 40'h55_0000_0000;
+      if (cyc == 99) begin
+         $write("[%0t] cyc==%0d crc=%x sum=%x\n", $time, cyc, crc, sum);
+         if (crc !== 64'h8ef77366f09d4122) $stop;
+         if (sum !== 64'hd1af53c88153beb9) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
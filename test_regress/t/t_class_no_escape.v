@@ -0,0 +1,73 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+class Tr;
+   int value;
+   int data[4];
+   function new(int v);
+      value = v;
+      foreach (data[i]) data[i] = v * i;
+   endfunction
+   function int get();
+      return value;
+   endfunction
+endclass
+
+class Leaky;
+   static Leaky last;
+   int value;
+   function new(int v);
+      value = v;
+      last = this;  // 'this' outlives the constructor
+   endfunction
+endclass
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+   integer cyc = 0;
+   Tr kept;
+
+   function automatic int sum_local(int n);
+      Tr t;
+      int sum = 0;
+      for (int i = 0; i < n; ++i) begin
+         t = new(i);  // Non-escaping
+         sum += t.value + t.data[3];
+      end
+      t = null;
+      return sum;
+   endfunction
+
+   function automatic int use_get(Tr t);
+      return t.get();
+   endfunction
+
+   always @(posedge clk) begin
+      Tr s;
+      Tr e;
+      Leaky l;
+      cyc <= cyc + 1;
+      s = new(cyc);  // Non-escaping
+      if (s.value != cyc) $stop;
+      if (s == null) $stop;
+      e = new(cyc);  // Escapes through the function argument
+      if (use_get(e) != cyc) $stop;
+      if (cyc == 1) kept = e;
+      l = new(cyc);  // Constructor leaks 'this'
+      if (Leaky::last.value != cyc) $stop;
+      if (sum_local(4) != 4 * 3 / 2 * 4) $stop;
+      if (cyc == 10) begin
+         if (kept.value != 1) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
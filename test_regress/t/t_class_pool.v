@@ -0,0 +1,74 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+class Small;
+   int value;
+   function new(int v);
+      value = v;
+   endfunction
+endclass
+
+class Big;
+   int values[300];
+   Small small;
+   Big self;
+   function new(int v);
+      foreach (values[i]) values[i] = v + i;
+      small = new(v);
+      self = this;  // Reference cycle, never freed
+   endfunction
+endclass
+
+class Node;
+   int value;
+   Node next;
+   function new(int v, Node n);
+      value = v;
+      next = n;
+   endfunction
+endclass
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+   integer cyc = 0;
+   Node list;
+
+   always @(posedge clk) begin
+      Small s;
+      Big b;
+      Node n;
+      int sum;
+      cyc <= cyc + 1;
+      // Discarded objects are freed after each evaluation, and their memory reused
+      for (int i = 0; i < 100; ++i) begin
+         s = new(i);
+         if (s.value != i) $stop;
+      end
+      b = new(cyc);
+      if (b.values[299] != cyc + 299) $stop;
+      if (b.small.value != cyc) $stop;
+      // Keep a list alive across evaluations, dropping its tail
+      list = new(cyc, list);
+      n = list;
+      for (int i = 0; i < 5 && n != null; ++i) begin
+         if (n.value != cyc - i) $stop;
+         if (i == 4) n.next = null;
+         n = n.next;
+      end
+      if (cyc == 20) begin
+         sum = 0;
+         for (n = list; n != null; n = n.next) sum += n.value;
+         if (sum != 20 + 19 + 18 + 17 + 16) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
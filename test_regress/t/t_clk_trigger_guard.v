@@ -0,0 +1,43 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   int       cyc = 0;
+   reg [7:0] div = 0;
+   int       exp[8];
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      div <= div + 8'd1;
+      for (int i = 0; i < 8; ++i) begin
+         if (!div[i] && (div + 8'd1) >> i & 8'd1) exp[i] <= exp[i] + 1;
+      end
+      if (cyc == 301) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // Each derived clock is a separate trigger, tested under a guard of the trigger word
+   for (genvar i = 0; i < 8; ++i) begin : gen
+      int cnt = 0;
+      always @(posedge div[i]) cnt <= cnt + 1;
+      always @(posedge clk) begin
+         if (cyc == 300) begin
+`ifdef TEST_VERBOSE
+            $write("[%0t] div[%0d] cnt=%0d exp=%0d\n", $time, i, cnt, exp[i]);
+`endif
+            if (cnt != exp[i]) $stop;
+         end
+      end
+   end
+endmodule
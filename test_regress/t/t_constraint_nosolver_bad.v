@@ -0,0 +1,32 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+class Packet;
+   rand int one;
+   rand int two;
+
+   // Relates two variables, so needs the SMT solver
+   constraint a { one > 0 && one < two && two < 3; }
+
+endclass
+
+module t (/*AUTOARG*/);
+
+   Packet p;
+
+   int v;
+
+   initial begin
+      p = new;
+      v = p.randomize();
+      if (v != 1) $stop;
+      if (p.one != 1) $stop;
+      if (p.two != 2) $stop;
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
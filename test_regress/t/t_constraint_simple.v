@@ -0,0 +1,48 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+class Packet;
+   rand int          sgn;
+   rand bit [7:0]    uns;
+   rand bit [15:0]   set;
+   rand bit [63:0]   wide;
+   rand bit [3:0]    weighted;
+   rand bit          free;
+
+   constraint c_sgn { sgn > -5; sgn <= 3; sgn != 0; }
+   constraint c_uns { uns inside {[10:20], 200}; }
+   constraint c_set { !(set inside {[0:99]}); set < 16'h200; }
+   constraint c_wide { wide >= 64'hffff_ffff_0000_0000; }
+   constraint c_weighted { weighted dist { 3 := 1, [8:9] :/ 2 }; }
+
+endclass
+
+module t (/*AUTOARG*/);
+
+   Packet p;
+   int    v;
+   bit    seen_neg;
+   bit    seen_200;
+
+   initial begin
+      p = new;
+      repeat (200) begin
+         v = p.randomize();
+         if (v != 1) $stop;
+         if (p.sgn <= -5 || p.sgn > 3 || p.sgn == 0) $stop;
+         if (!((p.uns >= 10 && p.uns <= 20) || p.uns == 200)) $stop;
+         if (p.set < 100 || p.set >= 16'h200) $stop;
+         if (p.wide < 64'hffff_ffff_0000_0000) $stop;
+         if (!(p.weighted inside {3, 8, 9})) $stop;
+         if (p.sgn < 0) seen_neg = 1;
+         if (p.uns == 200) seen_200 = 1;
+      end
+      if (!seen_neg || !seen_200) $stop;
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -14,6 +14,10 @@ test.scenarios('simulator')
 
 test.compile(verilator_flags2=['--cc', '--coverage-expr'])
 
+# The branches of each expression are counted with a single increment
+test.file_grep_any(test.glob_some(test.obj_dir + "/" + test.vm_prefix + "*.cpp"),
+                   r'VL_COVER_TOGGLE\(')
+
 test.execute()
 
 # Read the input .v file and do any CHECK_COVER requests
@@ -88,6 +88,10 @@ int main() {
     Verilated::defaultContextp()->coverageFilename(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage4.dat");
     TEST_CHECK_EQ(VerilatedCov::defaultFilename(), VL_STRINGIFY(TEST_OBJ_DIR) "/coverage4.dat");
     VerilatedCov::write();  // Uses defaultFilename()
+#elif defined(T_COVER_LIB_BINARY)
+    covContextp->writeBinary(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage1.bin");
+    covContextp->clearNonMatch("kept_");
+    covContextp->writeBinary(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage2.bin");
 #else
 #error
 #endif
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.top_filename = "t/t_cover_toggle.v"
+
+test.compile(verilator_flags2=['--cc --coverage-toggle --coverage-toggle-saturate'])
+
+test.execute()
+
+# Toggled points are counted once
+test.file_grep(test.obj_dir + "/coverage.dat", r"v_toggle/alpha.*cyc_copy\[0\].*' 1$")
+test.file_grep_not(test.obj_dir + "/coverage.dat", r"v_toggle/.*' ([2-9]|[1-9][0-9]+)$")
+
+test.passes()
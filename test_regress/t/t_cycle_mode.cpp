@@ -0,0 +1,39 @@
+// DESCRIPTION: Verilator: Verilog Test module, C driver code
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include "verilated.h"
+
+#include "TestCheck.h"
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+int main(int argc, char** argv, char**) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+
+    topp->clk = 0;
+    topp->in = 0;
+    topp->eval();
+    TEST_CHECK_EQ(topp->acc, 0);
+
+    // in_q is one cycle behind in
+    int expected = 0;
+    int inPrev = 0;
+    for (int i = 1; i <= 10; ++i) {
+        topp->in = i;
+        topp->tick();
+        expected += inPrev;
+        inPrev = i;
+        TEST_CHECK_EQ(topp->acc, expected);
+        TEST_CHECK_EQ(topp->acc_x2, 2 * expected);
+    }
+
+    topp->final();
+    if (!errors) VL_PRINTF("*-* All Finished *-*\n");
+    return errors;
+}
@@ -0,0 +1,26 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (
+   input clk,
+   input [7:0] in,
+   output logic [15:0] acc,
+   output [15:0] acc_x2
+   );
+
+   logic [7:0] in_q;
+
+   // Combinational logic downstream of the registers only
+   assign acc_x2 = acc << 1;
+
+   initial acc = 0;
+   initial in_q = 0;
+   always_ff @(posedge clk) begin
+      in_q <= in;
+      acc <= acc + 16'(in_q);
+   end
+
+endmodule
@@ -0,0 +1,18 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (
+   input clk,
+   input [7:0] in,
+   output logic [7:0] q,
+   output [7:0] comb
+   );
+
+   assign comb = ~in;
+
+   always_ff @(posedge clk) q <= in;
+
+endmodule
@@ -0,0 +1,44 @@
+// DESCRIPTION: Verilator: Verilog Test module, C driver code
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include "verilated.h"
+
+#include "TestCheck.h"
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+static int s_calls = 0;
+
+static void stepCb(void* datap) {
+    VM_PREFIX* const topp = static_cast<VM_PREFIX*>(datap);
+    ++s_calls;
+    topp->in = 0;
+}
+
+int main(int argc, char** argv, char**) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+
+    topp->clk = 0;
+    topp->in = 0;
+    topp->eval();
+
+    // Accumulates 'in' from the second cycle
+    topp->in = 2;
+    TEST_CHECK_EQ(topp->step(10), 10);
+    TEST_CHECK_EQ(topp->acc, 18);
+
+    // Callback clears 'in' after 4 cycles
+    TEST_CHECK_EQ(topp->step(10, stepCb, topp.get(), 4), 10);
+    TEST_CHECK_EQ(s_calls, 2);
+    TEST_CHECK_EQ(topp->acc, 18 + 4 * 2 + 2);
+
+    topp->final();
+    if (!errors) VL_PRINTF("*-* All Finished *-*\n");
+    return errors;
+}
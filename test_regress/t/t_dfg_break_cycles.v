@@ -0,0 +1,45 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   // Ripple through the bits of the same variable
+   wire [3:0] ripple;
+   assign ripple[0] = crc[0];
+   assign ripple[1] = ripple[0] & crc[1];
+   assign ripple[2] = ripple[1] | crc[2];
+   assign ripple[3] = ~ripple[2] ^ crc[3];
+
+   // Halves of a vector feeding each other
+   wire [15:0] halves;
+   assign halves[7:0] = crc[15:8] ^ 8'h5a;
+   assign halves[15:8] = {halves[3:0], halves[7:4]} & crc[23:16];
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      `checkh(ripple[0], crc[0]);
+      `checkh(ripple[1], crc[0] & crc[1]);
+      `checkh(ripple[2], (crc[0] & crc[1]) | crc[2]);
+      `checkh(ripple[3], ~((crc[0] & crc[1]) | crc[2]) ^ crc[3]);
+      `checkh(halves[7:0], crc[15:8] ^ 8'h5a);
+      `checkh(halves[15:8], {halves[3:0], halves[7:4]} & crc[23:16]);
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_dfg_stats_patterns.v"
+test.golden_filename = "t/t_dfg_stats_patterns_pre_inline.out"
+
+# Same as t_dfg_stats_patterns_pre_inline.py, with modules optimized in parallel
+test.compile(verilator_flags2=[
+    "--stats --no-skip-identical -fno-dfg-post-inline", "--verilate-jobs 4"
+])
+
+fn = test.glob_one(test.obj_dir + "/" + test.vm_prefix + "__stats_dfg_patterns*")
+test.files_identical(fn, test.golden_filename)
+test.file_grep(test.stats, r'Optimizations, DFG pre inline General, modules\s+(\d+)', 1)
+
+test.passes()
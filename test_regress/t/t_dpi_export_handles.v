@@ -0,0 +1,39 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// DPI exports called through resolved handles.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+
+   import "DPI-C" context function int dpii_run();
+
+   int count = 0;
+
+   export "DPI-C" function dpix_add;
+   function int dpix_add(input int a, input int b);
+      count = count + 1;
+      return a + b;
+   endfunction
+
+   export "DPI-C" function dpix_wide;
+   function void dpix_wide(input bit [95:0] i, output bit [95:0] o);
+      o = ~i;
+   endfunction
+
+   // Has no batched variant
+   export "DPI-C" function dpix_arr;
+   function int dpix_arr(input int i[2]);
+      return i[0] + i[1];
+   endfunction
+
+   initial begin
+      if (dpii_run() != 0) $stop;
+      if (count != 11) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
@@ -0,0 +1,66 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "svdpi.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Vt_dpi_export_handles__Dpi.h"
+
+//======================================================================
+
+#define CHECK(got, exp) \
+    do { \
+        if ((got) != (exp)) { \
+            printf("%%Error: %s:%d: GOT = %lld EXP = %lld\n", __FILE__, __LINE__, \
+                   static_cast<long long>(got), static_cast<long long>(exp)); \
+            std::abort(); \
+        } \
+    } while (0)
+
+int dpii_run() {
+    const svScope scope = svGetScope();
+    VlDpiExportHandle add;
+    VlDpiExportHandle wide;
+    VlDpiExportHandle arr;
+    CHECK(dpix_add__Vresolve(scope, &add), 1);
+    CHECK(dpix_wide__Vresolve(scope, &wide), 1);
+    CHECK(dpix_arr__Vresolve(scope, &arr), 1);
+    CHECK(dpix_add__Vresolve(nullptr, &add), 0);
+    CHECK(dpix_add__Vresolve(scope, &add), 1);
+
+    // Called through handle, with no DPI scope set
+    svSetScope(nullptr);
+    CHECK(dpix_add__Vcall(&add, 1, 2), 3);
+
+    int as[10];
+    int bs[10];
+    int sums[10];
+    for (int i = 0; i < 10; ++i) {
+        as[i] = i;
+        bs[i] = 100 * i;
+    }
+    dpix_add__Vbatch(&add, 10, sums, as, bs);
+    for (int i = 0; i < 10; ++i) CHECK(sums[i], 101 * i);
+
+    svBitVecVal wis[2 * 3];
+    svBitVecVal wos[2 * 3];
+    for (int i = 0; i < 2 * 3; ++i) wis[i] = i;
+    dpix_wide__Vbatch(&wide, 2, wos, wis);
+    for (int i = 0; i < 2 * 3; ++i) CHECK(wos[i], ~static_cast<svBitVecVal>(i));
+
+    const int elems[2] = {5, 6};
+    CHECK(dpix_arr__Vcall(&arr, elems), 11);
+
+    svSetScope(scope);
+    return 0;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+
+# With --threads-dpi all nothing would be serialized, so any collision
+# detected is from the per-import annotations not being honored
+test.compile(v_flags2=[
+    "t/t_dpi_threads_annot_c.cpp t/t_dpi_threads_annot.vlt --threads-dpi all --no-threads-coarsen"
+])
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,41 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+// Serialized by t_dpi_threads_annot.vlt
+import "DPI-C" function void dpii_serial();
+// Serialized only with calls from the same scope
+import "DPI-C" context function void dpii_scoped() /*verilator dpi_threads_context*/;
+// Never serialized
+import "DPI-C" function void dpii_safe() /*verilator dpi_threads_safe*/;
+import "DPI-C" function int dpii_failure();
+
+module t (clk);
+   input clk;
+   integer cyc = 0;
+
+   sub u0 (.clk(clk));
+   sub u1 (.clk(clk));
+
+   always @(posedge clk) dpii_serial();
+   always @(posedge clk) dpii_serial();
+
+   always @(posedge clk) dpii_safe();
+   always @(posedge clk) dpii_safe();
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 2) begin
+         if (dpii_failure() != 0) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module sub (input clk);
+   always @(posedge clk) dpii_scoped();
+   always @(posedge clk) dpii_scoped();
+endmodule
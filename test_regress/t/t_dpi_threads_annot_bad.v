@@ -0,0 +1,11 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+import "DPI-C" function int dpii_f() /*verilator dpi_threads_context*/;
+
+module t;
+   initial $display("%0d", dpii_f());
+endmodule
@@ -0,0 +1,58 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "svdpi.h"
+
+#include <atomic>
+#include <cstdio>
+#include <unistd.h>
+
+#include "Vt_dpi_threads_annot__Dpi.h"
+
+//======================================================================
+
+static std::atomic<int> s_failure{0};
+static std::atomic<bool> s_serialRunning{false};
+// One running flag per DPI context scope, found through svGetUserData
+static std::atomic<bool> s_scopeRunning[8];
+static std::atomic<int> s_scopeNext{0};
+static int s_userKey;  // Address is the svPutUserData key
+
+// Fail if another call with the same flag is running
+static void enter(std::atomic<bool>* runningp, const char* what) {
+    if (runningp->exchange(true)) {
+        s_failure = 1;
+        fprintf(stderr, "t_dpi_threads_annot_c.cpp %s() saw threads collide\n", what);
+    }
+    // Spend some time in the call, so a collision is likely to be seen
+    usleep(100000);
+    runningp->store(false);
+}
+
+void dpii_serial() { enter(&s_serialRunning, "dpii_serial"); }
+
+void dpii_scoped() {
+    const svScope scope = svGetScope();
+    auto* runningp = static_cast<std::atomic<bool>*>(svGetUserData(scope, &s_userKey));
+    if (!runningp) {
+        runningp = &s_scopeRunning[s_scopeNext++];
+        svPutUserData(scope, &s_userKey, runningp);
+    }
+    if (svGetUserData(scope, &s_userKey) != runningp) {
+        s_failure = 1;
+        fprintf(stderr, "t_dpi_threads_annot_c.cpp svGetUserData mismatch\n");
+    }
+    enter(runningp, "dpii_scoped");
+}
+
+void dpii_safe() {}
+
+int dpii_failure() { return s_failure; }
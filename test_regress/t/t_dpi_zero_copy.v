@@ -0,0 +1,53 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// DPI import arguments passed without a temporary copy.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+
+   // Passed without copy
+   import "DPI-C" function void dpii_int_arr(input int i[4], output int o[4]);
+   import "DPI-C" function void dpii_wide(input bit [127:0] i, inout bit [127:0] io);
+   import "DPI-C" function void dpii_bit_arr(input bit [31:0] i[2][3]);
+   import "DPI-C" function void dpii_real_arr(inout real io[3]);
+   // Input passed without copy, output copied as it needs masking
+   import "DPI-C" function void dpii_odd_wide(input bit [99:0] i, output bit [99:0] o);
+
+   int i_arr[4];
+   int o_arr[4];
+   bit [127:0] i_wide;
+   bit [127:0] io_wide;
+   bit [31:0] b_arr[2][3];
+   real r_arr[3];
+   bit [99:0] i_odd;
+   bit [99:0] o_odd;
+
+   initial begin
+      for (int i = 0; i < 4; ++i) i_arr[i] = i * 10 + 1;
+      dpii_int_arr(i_arr, o_arr);
+      for (int i = 0; i < 4; ++i) if (o_arr[i] != i_arr[i] * 2) $stop;
+
+      i_wide = 128'h01234567_89abcdef_fedcba98_76543210;
+      io_wide = 128'h1;
+      dpii_wide(i_wide, io_wide);
+      if (io_wide != (i_wide ^ 128'h1)) $stop;
+
+      for (int i = 0; i < 2; ++i)
+         for (int j = 0; j < 3; ++j) b_arr[i][j] = 32'(i * 3 + j);
+      dpii_bit_arr(b_arr);
+
+      r_arr = '{1.5, 2.5, 3.5};
+      dpii_real_arr(r_arr);
+      if (r_arr[0] != 3.0 || r_arr[1] != 5.0 || r_arr[2] != 7.0) $stop;
+
+      i_odd = {4'h5, 96'h0};
+      dpii_odd_wide(i_odd, o_odd);
+      if (o_odd != ~i_odd) $stop;
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
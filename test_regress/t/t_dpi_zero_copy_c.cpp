@@ -0,0 +1,51 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "svdpi.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "Vt_dpi_zero_copy__Dpi.h"
+
+//======================================================================
+
+#define CHECK(got, exp) \
+    do { \
+        if ((got) != (exp)) { \
+            printf("%%Error: %s:%d: GOT = %lld EXP = %lld\n", __FILE__, __LINE__, \
+                   static_cast<long long>(got), static_cast<long long>(exp)); \
+            std::abort(); \
+        } \
+    } while (0)
+
+void dpii_int_arr(const int* i, int* o) {
+    for (int n = 0; n < 4; ++n) o[n] = i[n] * 2;
+}
+
+void dpii_wide(const svBitVecVal* i, svBitVecVal* io) {
+    CHECK(i[0], 0x76543210U);
+    CHECK(i[3], 0x01234567U);
+    for (int n = 0; n < 4; ++n) io[n] ^= i[n];
+}
+
+void dpii_bit_arr(const svBitVecVal* i) {
+    for (int n = 0; n < 6; ++n) CHECK(i[n], static_cast<svBitVecVal>(n));
+}
+
+void dpii_real_arr(double* io) {
+    for (int n = 0; n < 3; ++n) io[n] = io[n] * 2.0;
+}
+
+void dpii_odd_wide(const svBitVecVal* i, svBitVecVal* o) {
+    // Set the unused top bits, which the caller must mask off
+    for (int n = 0; n < 4; ++n) o[n] = ~i[n];
+}
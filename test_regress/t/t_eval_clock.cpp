@@ -0,0 +1,45 @@
+// DESCRIPTION: Verilator: Verilog Test module, C driver code
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include "verilated.h"
+
+#include "TestCheck.h"
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+int main(int argc, char** argv, char**) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+
+    topp->clk_a = 0;
+    topp->clk_b = 0;
+    topp->in = 3;
+    topp->eval();
+    TEST_CHECK_EQ(topp->sum, 3);
+
+    for (int i = 0; i < 10; ++i) {
+        topp->clk_a = !topp->clk_a;
+        topp->evalClock(VM_PREFIX::CLK_clk_a);
+    }
+    TEST_CHECK_EQ(topp->count_a, 15);
+    TEST_CHECK_EQ(topp->count_b, 0);
+
+    topp->clk_b = 1;
+    topp->evalClock(VM_PREFIX::CLK_clk_b);
+    TEST_CHECK_EQ(topp->count_b, 1);
+    TEST_CHECK_EQ(topp->sum, 4);
+
+    // Other input changed, so plain eval
+    topp->in = 5;
+    topp->eval();
+    TEST_CHECK_EQ(topp->sum, 6);
+
+    topp->final();
+    if (!errors) VL_PRINTF("*-* All Finished *-*\n");
+    return errors;
+}
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+
+test.compile(make_top_shell=False, make_main=False, verilator_flags2=["--exe", test.pli_filename])
+
+# Only clk_a can skip the input combinational logic, clk_b feeds it
+test.file_grep_count(test.obj_dir + "/" + test.vm_prefix + ".cpp", r'case CLK_\w+:', 1)
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + ".cpp", r'case CLK_clk_a:')
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,24 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (
+   input clk_a,
+   input clk_b,
+   input [7:0] in,
+   output logic [7:0] count_a,
+   output logic [7:0] count_b,
+   output [7:0] sum
+   );
+
+   // Input combinational logic, also reading clk_b
+   assign sum = in + {7'd0, clk_b};
+
+   initial count_a = 0;
+   initial count_b = 0;
+   always @(posedge clk_a) count_a <= count_a + in;
+   always @(posedge clk_b) count_b <= count_b + 1;
+
+endmodule
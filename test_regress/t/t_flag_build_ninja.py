@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import shutil
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_flag_make_cmake.v"
+
+if not shutil.which('ninja'):
+    test.skip("ninja not installed")
+
+test.compile(  # Don't call gmake from driver.py
+    verilator_flags2=[
+        '--exe --cc --build --build-tool ninja -j 2', '../' + test.main_filename, '--stats'
+    ])
+
+test.file_grep(test.obj_dir + "/build.ninja", r'^pool vm_heavy')
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "__vars.ninja", r'^cppflags = ')
+test.file_grep(test.stats, r'Ninja targets, heavy pool\s+(\d+)', 0)
+
+test.execute()
+
+test.passes()
@@ -31,6 +31,8 @@ check(os.environ["VERILATOR_ROOT"] + "/bin/verilator_coverage")
 
 check(os.environ["VERILATOR_ROOT"] + "/bin/verilator_ccache_report")
 check(os.environ["VERILATOR_ROOT"] + "/bin/verilator_gantt")
+check(os.environ["VERILATOR_ROOT"] + "/bin/verilator_instr_calibrate")
+check(os.environ["VERILATOR_ROOT"] + "/bin/verilator_pgo_merge")
 check(os.environ["VERILATOR_ROOT"] + "/bin/verilator_profcfunc")
 
 if os.path.exists(os.environ["VERILATOR_ROOT"] + "/bin/verilator_difftree"):
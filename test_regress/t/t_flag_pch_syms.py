@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_inst_tree.v"
+
+test.compile(v_flags2=["-fno-pch-syms", test.t_dir + "/t_inst_tree_inl0_pub0.vlt"])
+
+# Symbol table only included by files that use it
+test.file_grep_not(test.obj_dir + "/" + test.vm_prefix + "__pch.h", r'__Syms\.h')
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "__Syms.cpp", r'#include "\w+__Syms\.h"')
+
+test.execute()
+test.file_grep(test.run_log_filename, r"\] (%m|.*t\.ps): Clocked")
+
+test.passes()
@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+import time
+
+test.scenarios('vlt')
+test.top_filename = test.obj_dir + "/t_flag_skip_identical_elab.v"
+
+source = test.t_dir + "/t_flag_skip_identical_elab.v"
+outfile = test.obj_dir + "/V" + test.name + ".cpp"
+
+test.file_sed(source, test.top_filename, lambda contents: contents)
+test.compile(verilator_flags2=["--skip-identical-elab"])
+
+oldstats = os.path.getmtime(outfile)
+print("Old mtime=", oldstats)
+
+time.sleep(2)  # Or else it might take < 1 second to compile and see no diff.
+
+# Comment only change, so same elaborated design, output reused
+test.file_sed(source, test.top_filename, lambda contents: contents + "// Comment\n")
+test.compile(verilator_flags2=["--skip-identical-elab"])
+
+newstats = os.path.getmtime(outfile)
+print("New mtime=", newstats)
+if oldstats != newstats:
+    test.error("--skip-identical-elab was ignored -- recompiled")
+
+# Real change, so must rerun
+test.file_sed(source, test.top_filename, lambda contents: contents.replace("8'h12", "8'h34"))
+test.compile(verilator_flags2=["--skip-identical-elab"])
+
+newstats = os.path.getmtime(outfile)
+print("Changed mtime=", newstats)
+if oldstats == newstats:
+    test.error("--skip-identical-elab did not rerun on a design change")
+
+test.passes()
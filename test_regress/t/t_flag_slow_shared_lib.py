@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import os
+import sys
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_final.v"
+
+if sys.platform != "linux":
+    test.skip("Test relies on nm of ELF shared libraries")
+
+test.compile(verilator_flags2=['--slow-shared-lib'])
+
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "_classes.mk", r'^VM_SLOW_SHARED = 1')
+
+slow_lib = test.obj_dir + "/lib" + test.vm_prefix + "__Slow.so"
+if not os.path.exists(slow_lib):
+    test.error("Missing " + slow_lib)
+
+# The initial and final blocks are only in the library
+test.run(cmd=["nm -D --defined-only " + slow_lib],
+         logfile=test.obj_dir + "/nm_lib.log",
+         verilator_run=False)
+test.file_grep(test.obj_dir + "/nm_lib.log", r'_eval_initial')
+test.run(cmd=["nm --defined-only " + test.obj_dir + "/" + test.vm_prefix],
+         logfile=test.obj_dir + "/nm_exe.log",
+         verilator_run=False)
+test.file_grep_not(test.obj_dir + "/nm_exe.log", r'_eval_initial')
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import shutil
+import sys
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_final.v"
+
+if sys.platform != "linux":
+    test.skip("Test relies on ELF shared libraries")
+if not shutil.which('ninja'):
+    test.skip("ninja not installed")
+
+test.compile(  # Don't call gmake from driver.py
+    verilator_flags2=[
+        '--exe --cc --build --build-tool ninja -j 2 --slow-shared-lib',
+        '../' + test.main_filename
+    ])
+
+test.file_grep(test.obj_dir + "/build.ninja", r'^build \S+__Slow\.so: shared_slow ')
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "__vars.ninja", r'^ldflags = .*-rdynamic')
+
+test.execute()
+
+test.passes()
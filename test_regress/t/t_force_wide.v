@@ -0,0 +1,58 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0)
+
+module t(/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   logic [127:0] wvar;
+   wire [127:0] wnet = {4{cyc}};
+
+   // Test loop
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 10) begin
+         wvar = {4{32'h1111_1111}};
+         `checkh(wnet, {4{32'd10}});
+      end
+      else if (cyc == 11) begin
+         `checkh(wvar, {4{32'h1111_1111}});
+         force wvar[71:64] = 8'hab;
+         force wnet[127:96] = 32'hdead_beef;
+      end
+      else if (cyc == 12) begin
+         `checkh(wvar, 128'h11111111_111111ab_11111111_11111111);
+         `checkh(wnet, {32'hdead_beef, {3{32'd12}}});
+         wvar = '0;  // Forced bits retained
+      end
+      else if (cyc == 13) begin
+         `checkh(wvar, 128'h00000000_000000ab_00000000_00000000);
+         release wvar[71:64];
+         release wnet[127:96];
+      end
+      else if (cyc == 14) begin
+         `checkh(wvar, 128'h00000000_000000ab_00000000_00000000);
+         `checkh(wnet, {4{32'd14}});
+         wvar = {4{32'h2222_2222}};
+      end
+      else if (cyc == 15) begin
+         `checkh(wvar, {4{32'h2222_2222}});
+      end
+      //
+      else if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
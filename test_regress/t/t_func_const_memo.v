@@ -0,0 +1,53 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+
+   localparam K = 5;
+
+   function automatic integer f_sq(input integer n);
+      return n * n;
+   endfunction
+
+   // Calls f_sq repeatedly with the same arguments
+   function automatic integer f_sum(input integer n);
+      integer s = 0;
+      for (integer i = 0; i < n; ++i) s += f_sq(i % 4);
+      return s;
+   endfunction
+
+   // Reads a parameter of the module
+   function automatic integer f_k(input integer n);
+      return n + K;
+   endfunction
+
+   function automatic integer f_sum_k(input integer n);
+      integer s = 0;
+      for (integer i = 0; i < n; ++i) s += f_k(i % 2) + f_k(1);
+      return s;
+   endfunction
+
+   // Wide arguments
+   function automatic logic [99:0] f_wide(input logic [99:0] a);
+      return {a[49:0], a[99:50]};
+   endfunction
+
+   function automatic logic [99:0] f_wide_twice(input logic [99:0] a);
+      return f_wide(a) ^ f_wide(~a) ^ f_wide(a);
+   endfunction
+
+   localparam SUM = f_sum(100);
+   localparam SUM_K = f_sum_k(10);
+   localparam logic [99:0] WIDE = f_wide_twice(100'h1_0000_0000_0000_0000_0000_0003);
+
+   initial begin
+      if (SUM != 350) $stop;
+      if (SUM_K != 115) $stop;
+      if (WIDE != 100'hf_ffff_ffff_fff3_bfff_ffff_ffff) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,63 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   wire ok4, ok8, ok16, ok8b;
+
+   sub #(.W(4), .EXP_ONES(4'hf)) sub4 (.ok(ok4));
+   sub #(.W(8), .EXP_ONES(8'h3f)) sub8 (.ok(ok8));
+   sub #(.W(16), .EXP_ONES(16'h3f)) sub16 (.ok(ok16));
+   sub #(.W(8), .EXP_ONES(8'h3f), .N(2000)) sub8b (.ok(ok8b));
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 1) begin
+         if (!ok4 || !ok8 || !ok16 || !ok8b) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module sub #(
+   parameter W = 8,
+   parameter logic [W-1:0] EXP_ONES = '0,
+   parameter N = 1000
+) (
+   output ok
+);
+
+   // Same in every specialization
+   function automatic integer f_log(input integer n);
+      integer r = 0;
+      while ((1 << r) < n) ++r;
+      return r;
+   endfunction
+
+   // Return width differs between specializations
+   function automatic logic [W-1:0] f_ones(input integer n);
+      logic [W-1:0] r = '0;
+      for (integer i = 0; i < n && i < W; ++i) r[i] = 1'b1;
+      return r;
+   endfunction
+
+   // Reads a parameter
+   function automatic integer f_plus_n(input integer n);
+      return n + N;
+   endfunction
+
+   localparam LOG = f_log(N);
+   localparam logic [W-1:0] ONES = f_ones(6);
+   localparam PLUS = f_plus_n(1);
+
+   assign ok = (LOG == ((N == 1000) ? 10 : 11)) && (ONES == EXP_ONES) && (PLUS == N + 1);
+endmodule
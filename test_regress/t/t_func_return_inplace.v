@@ -0,0 +1,78 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0);
+`define checks(gotv,expv) do if ((gotv) != (expv)) begin $write("%%Error: %s:%0d:  got='%s' exp='%s'\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0);
+
+typedef struct packed {
+   logic [63:0] a;
+   logic [63:0] b;
+   logic [31:0] c;
+} wide_t;
+
+typedef int q_t[$];
+
+class Cls;
+   function wide_t swap(wide_t w);
+      swap.a = w.b;
+      swap.b = w.a;
+      swap.c = ~w.c;
+   endfunction
+   function string name(int i);
+      return $sformatf("name%0d", i);
+   endfunction
+   function q_t fill(int n);
+      for (int i = 0; i < n; ++i) fill.push_back(i * 10);
+   endfunction
+endclass
+
+module t;
+   Cls c = new;
+   wide_t w;
+   string s;
+   q_t q;
+
+   task automatic run();
+      wide_t r;
+      string n;
+      q_t lq;
+      r = c.swap(w);
+      `checkh(r.a, 64'h2222);
+      `checkh(r.b, 64'h1111);
+      `checkh(r.c, 32'hffffffff);
+      // Destination also used as an argument, must not be written in place
+      r = c.swap(r);
+      `checkh(r.a, 64'h1111);
+      `checkh(r.b, 64'h2222);
+      `checkh(r.c, 32'h0);
+      n = c.name(3);
+      `checks(n, "name3");
+      n = c.name(4);
+      `checks(n, "name4");
+      lq = c.fill(3);
+      `checkh(lq.size(), 3);
+      `checkh(lq[2], 20);
+      // The function appends to its result, which must start out empty
+      lq = c.fill(2);
+      `checkh(lq.size(), 2);
+   endtask
+
+   initial begin
+      w = '{a: 64'h1111, b: 64'h2222, c: 32'h0};
+      run();
+      // Module level destination, result is moved from a temporary
+      s = c.name(5);
+      `checks(s, "name5");
+      s = c.name(6);
+      `checks(s, "name6");
+      q = c.fill(2);
+      `checkh(q.size(), 2);
+      `checkh(q[1], 10);
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
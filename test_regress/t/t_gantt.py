@@ -44,6 +44,9 @@ else:
     test.file_grep(gantt_log, r'Total mtasks += 0')
 
 test.file_grep(gantt_log, r'\|\s+2\s+\|\s+2\.0+\s+\|\s+eval')
+# Iterations of the scheduling loops
+test.file_grep(gantt_log, r'\|\s+iter nba')
+test.file_grep(gantt_log, r'\|\s+iter act')
 
 # Diff to itself, just to check parsing
 test.vcd_identical(test.obj_dir + "/profile_exec.vcd", test.obj_dir + "/profile_exec.vcd")
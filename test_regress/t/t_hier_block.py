@@ -31,7 +31,11 @@ test.file_grep(test.obj_dir + "/Vsub0/sub0.sv", r'^\s+\/\/\s+timeprecision\s+(\d
 test.file_grep(test.obj_dir + "/Vsub0/sub0.sv", r'^module\s+(\S+)\s+', "sub0")
 test.file_grep(test.obj_dir + "/Vsub1/sub1.sv", r'^module\s+(\S+)\s+', "sub1")
 test.file_grep(test.obj_dir + "/Vsub2/sub2.sv", r'^module\s+(\S+)\s+', "sub2")
+# Ports are exchanged through one buffer per direction
+test.file_grep(test.obj_dir + "/Vsub0/sub0.sv", r'outs_combo__V')
+test.file_grep(test.obj_dir + "/Vsub0/sub0.cpp", r'svBitVecVal\* outs__V')
 test.file_grep(test.stats, r'HierBlock,\s+Hierarchical blocks\s+(\d+)', 14)
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "_hier.mk", r'(Vsub0__objs\.stamp):')
 test.file_grep(test.run_log_filename, r'MACRO:(\S+) is defined', "cplusplus")
 
 test.passes()
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('simulator')
+
+# The small module is not inlined into each of its many instances
+test.compile(verilator_flags2=["--stats", "--inline-mult 100"])
+
+if test.vlt_all:
+    test.file_grep(test.stats, r'Optimizations, Inlined instances\s+(\d+)', 0)
+    test.file_grep(test.stats, r'Optimizations, Inline kept shared instances\s+(\d+)', 256)
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,41 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   // Many instances of a very small module
+   wire [7:0] q[255:0];
+   for (genvar i = 0; i < 256; ++i) begin : gen_bank
+      sub bank(.clk(clk), .d(cyc[7:0] ^ 8'(i)), .q(q[i]));
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc > 1) begin
+         if (q[0] !== (cyc[7:0] - 8'd1) + 8'd1) $stop;
+         if (q[37] !== ((cyc[7:0] - 8'd1) ^ 8'd37) + 8'd1) $stop;
+         if (q[255] !== ((cyc[7:0] - 8'd1) ^ 8'd255) + 8'd1) $stop;
+      end
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module sub (
+   input clk,
+   input [7:0] d,
+   output reg [7:0] q
+   );
+   always @(posedge clk) q <= d + 8'd1;
+endmodule
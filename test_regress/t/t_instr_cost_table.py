@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = "t/t_gen_alw.v"  # It doesn't really matter what test
+
+table = test.obj_dir + "/instr_cost.tbl"
+
+test.run(cmd=[
+    os.environ["VERILATOR_ROOT"] + "/bin/verilator_instr_calibrate", "--iterations 1000",
+    "-o", table
+],
+         logfile=test.obj_dir + "/calibrate.log")
+
+test.file_grep(test.obj_dir + "/calibrate.log", r'Verilator instruction cost calibration')
+for name in ["ADD", "WIDE", "ARRAYSEL", "DPI"]:
+    test.file_grep(table, r'^' + name + r' +\d+\.\d+$')
+
+test.compile(v_flags2=["--instr-cost-table", table], threads=2)
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,20 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = "t/t_gen_alw.v"  # It doesn't really matter what test
+
+test.compile(v_flags2=["--instr-cost-table t/t_instr_cost_table_bad.tbl"], threads=2, fails=True)
+
+test.file_grep(test.compile_log_filename, r"Unknown node type 'NOT_A_NODE' in cost table")
+test.file_grep(test.compile_log_filename, r"Expected positive scale after 'MUL' in cost table")
+
+test.passes()
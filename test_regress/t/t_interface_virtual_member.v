@@ -0,0 +1,41 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+interface Bus;
+  logic [15:0] a;
+  logic [15:0] b;
+endinterface
+
+module t (
+    clk
+);
+  input clk;
+  integer cyc = 0;
+  Bus intf ();
+  virtual Bus vif = intf;
+  logic [15:0] a_q;
+  logic [15:0] b_q;
+
+  always @(posedge clk) begin
+    cyc <= cyc + 1;
+    vif.a <= cyc[15:0];
+    if (cyc % 2 == 0) vif.b <= cyc[15:0] + 16'h100;
+  end
+
+  assign a_q = vif.a;
+  assign b_q = vif.b;
+
+  always @(negedge clk) begin
+    if (cyc > 1) begin
+      if (a_q != 16'(cyc - 1)) $stop;
+      if (b_q != 16'(((cyc - 1) & ~1) + 'h100)) $stop;
+    end
+    if (cyc >= 10) begin
+      $write("*-* All Finished *-*\n");
+      $finish;
+    end
+  end
+endmodule
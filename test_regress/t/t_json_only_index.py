@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+import json
+
+test.scenarios('vlt')
+test.top_filename = "t/t_json_only_first.v"
+
+out_filename = test.obj_dir + "/V" + test.name + ".tree.json"
+index_filename = test.obj_dir + "/V" + test.name + ".tree.index.json"
+
+test.compile(verilator_flags2=['--no-std', '--json-only-index', '--no-json-edit-nums'],
+             verilator_make_gmake=False,
+             make_top_shell=False,
+             make_main=False)
+
+# Output is as without the index
+test.files_identical(out_filename, "t/t_json_only_first.out")
+
+with open(index_filename, 'r', encoding="utf8") as fh:
+    index = json.load(fh)
+with open(out_filename, 'rb') as fh:
+    data = fh.read()
+
+names = []
+for mod in index['modules']:
+    if mod['file'] != "V" + test.name + ".tree.json":
+        test.error("Unexpected file " + mod['file'])
+    # Each offset and length must give the module's object
+    obj = json.loads(data[mod['offset']:mod['offset'] + mod['length']])
+    if obj['name'] != mod['name'] or obj['addr'] != mod['addr']:
+        test.error("Index entry does not match object for " + mod['name'])
+    names.append(mod['name'])
+
+if sorted(names) != ['mod1', 'mod2', 't']:
+    test.error("Unexpected modules " + str(names))
+
+test.passes()
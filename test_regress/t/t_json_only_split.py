@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+import json
+
+test.scenarios('vlt')
+test.top_filename = "t/t_json_only_first.v"
+
+out_filename = test.obj_dir + "/V" + test.name + ".tree.json"
+index_filename = test.obj_dir + "/V" + test.name + ".tree.index.json"
+
+test.compile(verilator_flags2=[
+    '--no-std', '--json-only-split', '--json-only-index', '--no-json-ids', '--verilate-jobs',
+    '2'
+],
+             verilator_make_gmake=False,
+             make_top_shell=False,
+             make_main=False)
+
+with open(out_filename, 'r', encoding="utf8") as fh:
+    netlist = json.load(fh)
+with open(index_filename, 'r', encoding="utf8") as fh:
+    index = json.load(fh)
+
+if len(netlist['modulesp']) != len(index['modules']):
+    test.error("Index does not list every module")
+
+for stub, mod in zip(netlist['modulesp'], index['modules']):
+    # Main file has a stub naming the module's file, without children
+    if stub['file'] != mod['file'] or stub['addr'] != mod['addr']:
+        test.error("Stub does not match index for " + mod['name'])
+    if 'stmtsp' in stub:
+        test.error("Stub has children for " + mod['name'])
+    with open(test.obj_dir + "/" + mod['file'], 'rb') as fh:
+        data = fh.read()
+    if mod['offset'] != 0 or mod['length'] != len(data) - 1:
+        test.error("Unexpected offset or length for " + mod['name'])
+    obj = json.loads(data)
+    if obj['name'] != mod['name'] or 'stmtsp' not in obj:
+        test.error("Module file does not hold module " + mod['name'])
+
+test.passes()
@@ -0,0 +1,42 @@
+//
+// DESCRIPTION: Verilator: Batched evaluation of model copies with VlLanes
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+#include <verilated_lanes.h>
+
+#include <vector>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    VlLanes<VM_PREFIX> lanes{7, 3};
+    TEST_CHECK_EQ(lanes.size(), 7);
+    // Each lane is visited exactly once, with its own model
+    std::vector<int> visits(lanes.size(), 0);
+    lanes.forEachLane([&](size_t lane, VM_PREFIX& model) {
+        ++visits[lane];
+        TEST_CHECK_EQ(&model, lanes.modelp(lane));
+    });
+    for (size_t i = 0; i < lanes.size(); ++i) TEST_CHECK_EQ(visits[i], 1);
+    while (!lanes.allGotFinish() && lanes.contextp(0)->time() < 1000) {
+        for (size_t i = 0; i < lanes.size(); ++i) lanes[i].clk = !lanes[i].clk;
+        lanes.timeInc(1);
+        lanes.eval();
+    }
+    for (size_t i = 0; i < lanes.size(); ++i) {
+        TEST_CHECK_EQ(lanes.contextp(i)->gotFinish(), true);
+        // All lanes see the same stimulus, so finish at the same time
+        TEST_CHECK_EQ(lanes.contextp(i)->time(), lanes.contextp(0)->time());
+    }
+    return errors ? 10 : 0;
+}
@@ -0,0 +1,58 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+class Counter;
+   event m_done;
+   int m_count;
+
+   task wait_done();
+      @m_done;
+   endtask
+
+   function void incr();
+      m_count++;
+      if (m_count == 3) ->m_done;
+   endfunction
+endclass
+
+module t;
+   mailbox #(int) m_mbox = new(1);
+   semaphore m_sem = new(0);
+   Counter m_cnt = new;
+   int m_sum;
+
+   initial begin
+      for (int i = 1; i <= 10; i++) begin
+         m_mbox.put(i);
+         #1;
+      end
+   end
+
+   initial begin
+      int v;
+      for (int i = 1; i <= 10; i++) begin
+         m_mbox.get(v);
+         m_sum += v;
+      end
+      m_sem.put(2);
+   end
+
+   initial begin
+      repeat (3) begin
+         #20;
+         m_cnt.incr();
+      end
+   end
+
+   initial begin
+      m_sem.get(2);
+      if (m_sum != 55) $stop;
+      m_cnt.wait_done();
+      if (m_cnt.m_count != 3) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
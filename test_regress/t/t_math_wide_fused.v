@@ -0,0 +1,44 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   localparam W = 3000;  // Wider than --expand-limit words
+
+   reg [W-1:0] a, b, c, d;
+   wire [W-1:0] fused = (a & b) | ~(c ^ d);
+   wire [W-1:0] fused2 = ~(a | (b & ~c)) ^ d;
+   reg [W-1:0] exp, exp2;
+
+   integer cyc = 0;
+   integer i;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      for (i = 0; i < W; i = i + 32) begin
+         a[i +: 32] <= $random;
+         b[i +: 32] <= $random;
+         c[i +: 32] <= $random;
+         d[i +: 32] <= $random;
+      end
+      if (cyc > 1) begin
+         for (i = 0; i < W; i = i + 1) begin
+            exp[i] = (a[i] & b[i]) | ~(c[i] ^ d[i]);
+            exp2[i] = ~(a[i] | (b[i] & ~c[i])) ^ d[i];
+         end
+         if (fused !== exp) $stop;
+         if (fused2 !== exp2) $stop;
+      end
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
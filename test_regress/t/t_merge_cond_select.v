@@ -0,0 +1,46 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0)
+
+module t(/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   reg sel;
+   reg [31:0] a, b, c, d;
+   reg [31:0] x, y;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      sel <= crc[7];
+      a <= crc[31:0];
+      b <= crc[63:32];
+      c <= ~crc[31:0];
+      d <= ~crc[63:32];
+   end
+
+   // Two selects on an unpredictable condition, kept branchless
+   always @ (posedge clk) begin
+      x = sel ? a : b;
+      y = sel ? c : d;
+      if (cyc > 2) begin
+         `checkh(x ^ y, 32'hffffffff);
+      end
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,37 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   int cyc = 0;
+   logic [7:0] a;  // Only read before its NBA, in the same process: updated in place
+   logic [7:0] b;  // Read after its NBA: needs a shadow variable
+   logic [7:0] outa;
+   logic [7:0] outb;
+
+   always @(posedge clk) begin
+      outa <= a;
+      a <= (cyc == 0) ? 8'd0 : a + 8'd1;
+      b <= (cyc == 0) ? 8'd10 : b + 8'd1;
+      outb <= b;
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc >= 2) begin
+         if (outa != 8'(cyc - 2)) $stop;
+         if (outb != outa + 8'd10) $stop;
+      end
+      if (cyc == 9) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
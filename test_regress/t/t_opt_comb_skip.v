@@ -0,0 +1,67 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   // Inputs change rarely
+   reg [15:0] a;
+   reg [15:0] b;
+   reg [3:0] sel;
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      if (cyc % 8 == 0) a <= crc[15:0];
+      if (cyc % 16 == 0) b <= crc[31:16];
+      if (cyc % 4 == 0) sel <= crc[35:32];
+   end
+
+   // Combinational logic, only evaluated when inputs change
+   logic [15:0] y;
+   logic [15:0] tmp;
+   always_comb begin
+      tmp = a ^ {b[7:0], b[15:8]};
+      case (sel)
+        4'd0: y = tmp + b;
+        4'd1: y = tmp - b;
+        4'd2: y = tmp & ~a;
+        4'd3: y = {tmp[0], tmp[15:1]};
+        4'd4: y = tmp | b;
+        4'd5: y = ~tmp;
+        default: y = tmp ^ {sel, sel, sel, sel};
+      endcase
+   end
+
+   wire [15:0] z = (y + a) ^ (b - y) ^ {y[7:0], a[15:8]} ^ (y & b);
+
+   always @(posedge clk) begin
+      if (cyc > 2) begin
+         automatic logic [15:0] t = a ^ {b[7:0], b[15:8]};
+         automatic logic [15:0] e;
+         case (sel)
+           4'd0: e = t + b;
+           4'd1: e = t - b;
+           4'd2: e = t & ~a;
+           4'd3: e = {t[0], t[15:1]};
+           4'd4: e = t | b;
+           4'd5: e = ~t;
+           default: e = t ^ {sel, sel, sel, sel};
+         endcase
+         if (y !== e) $stop;
+         if (z !== ((e + a) ^ (b - e) ^ {e[7:0], a[15:8]} ^ (e & b))) $stop;
+      end
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
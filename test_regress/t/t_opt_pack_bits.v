@@ -0,0 +1,81 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   sub a (.clk, .cyc, .in(crc[7:0]));
+   sub b (.clk, .cyc, .in(crc[15:8]));
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module sub (
+   input clk,
+   input integer cyc,
+   input [7:0] in
+   );
+
+   // Single bit flops and enable, packed
+   reg en;
+   reg q0, q1, q2, q3, q4, q5, q6, q7;
+   always @(posedge clk) begin
+      if (cyc < 2) begin
+         en <= 1'b0;
+         {q7, q6, q5, q4, q3, q2, q1, q0} <= 8'h0;
+      end
+      else begin
+         en <= cyc[0] ^ in[3];
+         if (en) begin
+            q0 <= in[0];
+            q1 <= in[1] ^ q0;
+            q2 <= in[2] & q1;
+            q3 <= in[3] | q2;
+            q4 <= ~in[4];
+            q5 <= q4;
+            q6 <= in[6] ^ q7;
+            q7 <= in[7];
+         end
+      end
+   end
+
+   // Same logic as vectors, for reference
+   reg en_ref;
+   reg [7:0] q_ref;
+   always @(posedge clk) begin
+      if (cyc < 2) begin
+         en_ref <= 1'b0;
+         q_ref <= 8'h0;
+      end
+      else begin
+         en_ref <= cyc[0] ^ in[3];
+         if (en_ref) begin
+            q_ref <= {in[7], in[6] ^ q_ref[7], q_ref[4], ~in[4],
+                      in[3] | q_ref[2], in[2] & q_ref[1], in[1] ^ q_ref[0], in[0]};
+         end
+      end
+   end
+
+   always @(posedge clk) begin
+      if (cyc > 2) begin
+         if ({q7, q6, q5, q4, q3, q2, q1, q0} !== q_ref) $stop;
+         if (en !== en_ref) $stop;
+      end
+   end
+endmodule
@@ -0,0 +1,40 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   reg [7:0] a;
+   reg [3:0] b;
+   reg       c;
+
+   reg [2:0] cyc;
+
+   initial cyc = 0;
+   always @(posedge clk) cyc <= cyc + 1;
+
+   always @* begin
+      case (cyc)
+        3'b000: begin a = 8'h10; b = 4'h1; c = 1'b0; end
+        3'b001: begin a = 8'h21; b = 4'h2; c = 1'b1; end
+        3'b010: begin a = 8'h32; b = 4'h3; c = 1'b0; end
+        3'b100: begin a = 8'h44; b = 4'h4; c = 1'b1; end
+        3'b101: begin a = 8'h55; b = 4'h5; c = 1'b0; end
+        default: begin a = 8'hff; b = 4'hf; c = 1'b1; end
+      endcase
+   end
+
+   always @(posedge clk) begin
+      $display("cyle %d = %x %x %x", cyc, a, b, c);
+      if (cyc == 7) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
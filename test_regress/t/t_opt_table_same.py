@@ -15,6 +15,7 @@ test.compile(verilator_flags2=["--stats"])
 
 if test.vlt_all:
     test.file_grep(test.stats, r'Optimizations, Tables created\s+(\d+)', 2)
+    test.file_grep(test.stats, r'Optimizations, Tables shared\s+(\d+)', 1)
     test.file_grep(test.stats, r'ConstPool, Tables emitted\s+(\d+)', 1)
 
 test.execute(expect_filename=test.golden_filename)
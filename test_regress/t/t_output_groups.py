@@ -11,10 +11,12 @@ import vltest_bootstrap
 
 test.scenarios('vlt_all')
 
-test.compile(verilator_flags2=["--output-groups", "2"])
+test.compile(verilator_flags2=["--stats", "--output-groups", "2"])
 
 test.execute()
 
+test.file_grep(test.stats, r'Concatenation critical path score\s+\d+')
+
 # Check that only vm_classes_*.cpp are to be compiled
 test.file_grep_not(test.obj_dir + "/" + test.vm_prefix + "_classes.mk", "Foo")
 test.file_grep(test.obj_dir + "/" + test.vm_prefix + "_classes.mk", "vm_classes_Slow_1")
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+
+test.compile(verilator_flags2=["--prof-pgo-branches"])
+
+test.execute(all_run_flags=["+verilator+prof+vlt+file+" + test.obj_dir + "/profile.vlt"])
+
+test.file_grep(test.obj_dir + "/profile.vlt", r'profile_data -branch ".*t_pgo_branches.v:21:')
+
+test.compile(verilator_flags2=["--stats", test.obj_dir + "/profile.vlt"])
+
+test.file_grep(test.stats, r'Branch prediction, VL_LIKELY\s+[1-9]')
+test.file_grep(test.stats, r'Branch prediction, VL_UNLIKELY\s+[1-9]')
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,36 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t(/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   integer rare = 0;
+   integer common = 0;
+   integer either = 0;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      // Taken one time in 16
+      if (cyc[3:0] == 4'd0) rare <= rare + 1;
+      // Almost always taken
+      if (cyc != 5) common <= common + 1;
+      // Unpredictable
+      if (cyc[0]) either <= either + 1;
+      else either <= either + 2;
+      if (cyc == 99) begin
+         if (rare != 7) $stop;
+         if (common != 98) $stop;
+         if (either != 149) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+
+test.compile(verilator_flags2=["--stats", test.t_dir + "/t_pgo_cfunc.vlt"])
+
+test.file_grep(test.stats, r'Optimizations, Inline hot modules\s+(\d+)', 1)
+test.file_grep(test.stats, r'Optimizations, Order cold functions\s+[1-9]')
+
+# Main evaluation and profiled hot logic are placed in the hot section
+files = test.glob_some(test.obj_dir + "/" + test.vm_prefix + "___024root__DepSet*__0.cpp")
+test.file_grep_any(files, r'VL_ATTR_HOT void \w+___eval\(')
+test.file_grep_any(files, r'VL_ATTR_HOT void \w+_sequent__')
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,34 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [31:0] a = 0;
+   wire [31:0] b, c;
+
+   sub sub0 (.clk, .in(a), .out(b));
+   sub sub1 (.clk, .in(b), .out(c));
+
+   // Not in the profile, so cold
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      a <= a + 1;
+      if (cyc == 99) begin
+         $display("c=%0d", c);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module sub (input clk, input [31:0] in, output reg [31:0] out);
+   always @(posedge clk) out <= in * 3 + 1;  // Hot according to the profile
+endmodule
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('dist')
+
+t_dir = os.path.relpath(test.t_dir, test.obj_dir)
+
+test.run(cmd=[
+    "cd " + test.obj_dir + " && " + os.environ["VERILATOR_ROOT"] + "/bin/verilator_pgo_merge",
+    "--drift-threshold 1.5", t_dir + "/" + test.name + "_a.vlt", t_dir + "/" + test.name +
+    "_b.vlt=3", "> merge.log"
+],
+         check_finished=False)
+
+test.files_identical(test.obj_dir + "/merge.log", test.golden_filename)
+test.files_identical(test.obj_dir + "/profile_merged.vlt", test.t_dir + "/" + test.name + ".vlt.out")
+
+test.passes()
@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = "t/t_gen_alw.v"  # It doesn't really matter what test
+
+test.compile(v_flags2=["--prof-exec"], threads=2)
+
+test.execute(all_run_flags=[
+    "+verilator+prof+exec+start+0",
+    " +verilator+prof+exec+sample+2",
+    " +verilator+prof+vlt+file+" + test.obj_dir + "/profile.vlt"])  # yapf:disable
+
+test.file_grep(test.obj_dir + "/profile.vlt", r'// mtask \d+ count \d+ histogram')
+test.file_grep(test.obj_dir + "/profile.vlt", r'profile_data ')
+
+test.compile(v_flags2=[" " + test.obj_dir + "/profile.vlt"], threads=2)
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,26 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+`include "t_preproc_inc_guard.vh"
+`include "t_preproc_inc_guard.vh"
+`include "t_preproc_inc_guard.vh"
+   // Undefining the guard must re-read the file
+`undef T_PREPROC_INC_GUARD_VH
+`define T_PREPROC_INC_GUARD_ALT
+   sub sub();
+   initial begin
+      if (GUARD_VALUE != 10) $stop;
+      if (sub.GUARD_VALUE != 1) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
+
+module sub;
+`include "t_preproc_inc_guard.vh"
+`include "t_preproc_inc_guard.vh"
+endmodule
@@ -0,0 +1,14 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`ifndef T_PREPROC_INC_GUARD_VH
+ `define T_PREPROC_INC_GUARD_VH
+ `ifdef T_PREPROC_INC_GUARD_ALT
+localparam int GUARD_VALUE = 1;
+ `else
+localparam int GUARD_VALUE = 10;
+ `endif
+`endif  // T_PREPROC_INC_GUARD_VH
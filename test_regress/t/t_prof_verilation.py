@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import json
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_opt_ifjumpgo.v"
+
+prof_filename = test.obj_dir + "/prof_verilation.json"
+
+test.compile(verilator_flags2=['--prof-verilation', prof_filename, '--verilate-jobs 2'])
+
+with open(prof_filename, 'r', encoding="utf8") as fh:
+    events = json.load(fh)['traceEvents']
+
+categories = {event.get('cat') for event in events}
+for category in ['pass', 'check', 'file']:
+    if category not in categories:
+        test.error("No '" + category + "' events in " + prof_filename)
+if not any(event['name'] == 'linkdot' for event in events if event.get('cat') == 'pass'):
+    test.error("No linkdot pass in " + prof_filename)
+for event in events:
+    if event['ph'] == 'X' and event['dur'] < 0:
+        test.error("Negative duration in " + prof_filename)
+
+test.passes()
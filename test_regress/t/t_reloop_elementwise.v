@@ -0,0 +1,32 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/);
+
+   int aarray [63:0];
+   int barray [63:0];
+   int oarray [62:0];
+
+   initial begin
+      for (int i = 0; i < 64 ; i = i + 1) begin
+        aarray[i] = $random;
+        barray[i] = $random;
+      end
+
+      // Element-wise operation on arrays at different offsets
+      for (int i = 0; i < 63; i = i + 1) begin
+        oarray[i] = (aarray[i] & barray[i + 1]) ^ 32'h5a5a;
+      end
+
+      for (int i = 0; i < 63; i = i + 1) begin
+         if (oarray[i] !== ((aarray[i] & barray[i + 1]) ^ 32'h5a5a)) $stop;
+      end
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
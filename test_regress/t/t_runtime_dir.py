@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_a1_first_cc.v"
+
+runtime_dir = os.path.abspath(test.obj_dir + "/runtime")
+
+test.compile(make_flags=['VERILATOR_RUNTIME_DIR=' + runtime_dir])
+
+# Run-time library compiled into the shared directory, not the model's
+test.glob_some(runtime_dir + "/*/verilated.o")
+if os.path.exists(test.obj_dir + "/verilated.o"):
+    test.error("verilated.o should not be compiled into the model's directory")
+
+test.execute()
+
+test.passes()
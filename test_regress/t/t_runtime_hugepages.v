@@ -0,0 +1,19 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   int mem[1024*1024];  // 4 MB, more than a huge page
+   int sum;
+
+   initial begin
+      for (int i = 0; i < $size(mem); i += 4096) mem[i] = i;
+      sum = 0;
+      for (int i = 0; i < $size(mem); i += 4096) sum += mem[i];
+      if (sum != 32'h7f80000) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
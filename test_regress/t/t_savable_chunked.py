@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_savable.v"
+
+test.compile(make_top_shell=False,
+             make_main=False,
+             v_flags2=["--savable --exe", test.pli_filename])
+
+test.execute(check_finished=False)
+
+test.file_grep(test.obj_dir + "/saved.vltsv", r'^verilatorchunk01')
+test.file_grep(test.obj_dir + "/saved.vltsv", r'vltchidx$')
+
+test.execute(all_run_flags=['+save_restore=1'])
+
+test.passes()
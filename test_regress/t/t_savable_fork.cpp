@@ -0,0 +1,54 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_save.h>
+
+#include <memory>
+#include VM_PREFIX_INCLUDE
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+//======================================================================
+
+int errors = 0;
+
+int main(int argc, char* argv[]) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get(), "top"}};
+    const char* const filenamep = VL_STRINGIFY(TEST_OBJ_DIR) "/saved.vltsv";
+
+    if (contextp->commandArgsPlusMatch("save_restore")[0]) {
+        VerilatedRestore os;
+        os.open(filenamep);
+        os >> *topp;
+        os.close();
+    } else {
+        topp->clk = 0;
+        contextp->timeInc(10);
+    }
+
+    VerilatedSave os;
+    while (!contextp->gotFinish() && contextp->time() < 1000) {
+        topp->clk = !topp->clk;
+        topp->eval();
+        contextp->timeInc(1);
+        if (contextp->time() == 50 && !contextp->commandArgsPlusMatch("save_restore")[0]) {
+            // The model keeps running while the child writes the state at this time
+            os.saveForked(filenamep, [&](VerilatedSave& cos) { cos << *topp; });
+        }
+        if (contextp->time() == 80 && !contextp->commandArgsPlusMatch("save_restore")[0]) {
+            TEST_CHECK_EQ(os.waitForked(), true);
+            break;
+        }
+    }
+    topp->final();
+    return errors ? 10 : 0;
+}
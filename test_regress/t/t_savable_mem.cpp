@@ -0,0 +1,61 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_save.h>
+
+#include <memory>
+#include VM_PREFIX_INCLUDE
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+//======================================================================
+
+int errors = 0;
+
+int main(int argc, char* argv[]) {
+    VerilatedSaveMem image;
+    {
+        // No +save_restore, as this model runs from time 0
+        const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+        const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get(), "top"}};
+        topp->clk = 0;
+        contextp->timeInc(10);
+        while (contextp->time() < 50) {
+            topp->clk = !topp->clk;
+            topp->eval();
+            contextp->timeInc(1);
+        }
+        image.open();
+        image << *topp;
+        image.close();
+        topp->final();
+    }
+    // Each restore into a fresh model continues from the same point
+    for (int run = 0; run < 3; ++run) {
+        const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+        contextp->commandArgs(argc, argv);
+        const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get(), "top"}};
+        {
+            VerilatedRestoreMem os;
+            os.open(image);
+            os >> *topp;
+            os.close();
+        }
+        TEST_CHECK_EQ(contextp->time(), 50);
+        while (!contextp->gotFinish() && contextp->time() < 1000) {
+            topp->clk = !topp->clk;
+            topp->eval();
+            contextp->timeInc(1);
+        }
+        TEST_CHECK_EQ(contextp->gotFinish(), true);
+        topp->final();
+    }
+    return errors ? 10 : 0;
+}
@@ -0,0 +1,44 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include VM_PREFIX_INCLUDE
+
+#include <systemc.h>
+
+int sc_main(int argc, char* argv[]) {
+    using namespace sc_core;
+
+    VM_PREFIX* tb = new VM_PREFIX{"t"};
+    sc_clock clk{"clk", 10, SC_NS, 0.5, 5, SC_NS, true};
+    sc_signal<sc_bv<100>> SC_NAMED(in);
+    sc_signal<sc_bv<100>> SC_NAMED(out);
+    sc_signal<sc_bv<100>> SC_NAMED(comb);
+
+    tb->clk(clk);
+    tb->in(in);
+    tb->out(out);
+    tb->comb(comb);
+
+    bool pass = true;
+    in = sc_bv<100>{"0x123456789abcdef0123456789"};
+    sc_start(1, SC_NS);
+    // No clock edge yet, so input not yet sampled
+    pass &= out.read().or_reduce() == 0;
+
+    sc_start(10, SC_NS);
+    pass &= out.read() == in.read();
+    pass &= comb.read() == ~in.read();
+
+    // Same value again, output unchanged
+    sc_start(10, SC_NS);
+    pass &= out.read() == in.read();
+
+    tb->final();
+    VL_DO_DANGLING(delete tb, tb);
+
+    if (pass) VL_PRINTF("*-* All Finished *-*\n");
+
+    return 0;
+}
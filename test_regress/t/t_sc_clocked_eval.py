@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('simulator')
+
+test.compile(make_top_shell=False,
+             make_main=False,
+             verilator_flags2=["--exe --sc --sc-clocked-eval", test.pli_filename])
+
+# Only the clock in the sensitivity list
+test.file_grep_count(test.obj_dir + "/" + test.vm_prefix + ".cpp", r'sensitive <<', 1)
+test.file_grep_any(test.glob_some(test.obj_dir + "/" + test.vm_prefix + "*.cpp"),
+                   r'VL_ASSIGNCHG_SWW')
+
+test.execute()
+
+test.passes()
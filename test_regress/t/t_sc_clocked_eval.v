@@ -0,0 +1,19 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (
+   input clk,
+   input [99:0] in,
+   output logic [99:0] out,
+   output [99:0] comb
+   );
+
+   // Combinational output, only sampled on clk with --sc-clocked-eval
+   assign comb = ~in;
+
+   always @(posedge clk) out <= in;
+
+endmodule
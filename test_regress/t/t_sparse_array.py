@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('simulator')
+
+test.compile(verilator_flags2=["--stats", "--sparse-array-limit 1048576"])
+
+if test.vlt_all:
+    test.file_grep(test.stats, r'Optimizations, Sparse arrays\s+(\d+)', 2)
+    test.file_grep(test.obj_dir + "/" + test.vm_prefix + "___024root.h",
+                   r'VlSparseUnpacked<IData, 16777216>')
+
+test.execute()
+
+test.passes()
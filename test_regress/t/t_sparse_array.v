@@ -0,0 +1,48 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); $stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   // 64 MiB each, only a few pages are used
+   logic [31:0] mem [0:(1<<24)-1];
+   logic [31:0] copy [0:(1<<24)-1];
+   // Small, stays contiguous
+   logic [31:0] small [0:15];
+
+   integer cyc = 0;
+   logic [23:0] addr = 24'h000001;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      mem[addr] <= mem[addr - 1] + 32'h11;
+      addr <= addr * 3;
+      small[cyc[3:0]] <= cyc;
+      if (cyc == 0) begin
+         mem[0] <= 32'h5;
+         mem[24'hffffff] <= 32'hdeadbeef;
+      end
+      else if (cyc == 20) begin
+         $writememh({`STRINGIFY(`TEST_OBJ_DIR),"/mem.hex"}, mem);
+         $readmemh({`STRINGIFY(`TEST_OBJ_DIR),"/mem.hex"}, copy);
+      end
+      else if (cyc == 21) begin
+         `checkh(copy[0], 32'h5);
+         `checkh(copy[1], mem[1]);
+         `checkh(copy[24'h123456], 32'h0);
+         `checkh(copy[24'hffffff], 32'hdeadbeef);
+         for (int i = 0; i < (1 << 24); i += 4099) `checkh(copy[i], mem[i]);
+         `checkh(small[3], 3);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import json
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_opt_ifjumpgo.v"
+
+test.compile(verilator_flags2=['--stats-memory'])
+
+filename = test.obj_dir + "/V" + test.name + "__stats_memory.json"
+with open(filename, 'r', encoding="utf8") as fh:
+    stages = json.load(fh)['stages']
+
+if not stages:
+    test.error("No stages in " + filename)
+for stage in stages:
+    if stage['astNodeBytes'] != sum(stage['astNodeBytesByType'].values()):
+        test.error("Inconsistent AstNode bytes in stage " + stage['stage'])
+if not any(stage['graphVertexPeakBytes'] for stage in stages):
+    test.error("No graph vertex usage in " + filename)
+if not any('VAR' in stage['astNodeBytesByType'] for stage in stages):
+    test.error("No AstVar usage in " + filename)
+
+test.passes()
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_opt_ifjumpgo.v"
+
+test.lint(verilator_flags2=['--stats'])
+
+test.file_grep(test.stats, r'Node memory links \(MiB\) +\d+')
+test.file_grep(test.stats, r'Node memory with 32-bit links, estimate \(MiB\) +\d+')
+test.file_grep(test.stats, r'Node arena reserved \(MiB\) +\d+')
+
+test.passes()
@@ -0,0 +1,65 @@
+//
+// DESCRIPTION: Verilator: Runtime evaluation statistics with --stats-runtime
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+#include <memory>
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+    const VerilatedStatsRuntime& stats = contextp->statsRuntime();
+
+    uint64_t evals = 0;
+    uint64_t posedges = 0;
+    while (!contextp->gotFinish() && contextp->time() < 1000) {
+        topp->clk = !topp->clk;
+        if (topp->clk) ++posedges;
+        topp->eval();
+        ++evals;
+        contextp->timeInc(1);
+    }
+    TEST_CHECK_EQ(contextp->gotFinish(), true);
+
+    TEST_CHECK_EQ(stats.count(VerilatedStatsRuntime::EVALS), evals);
+    // Every evaluation runs the 'act' and 'nba' loops at least once
+    TEST_CHECK_EQ(stats.count(VerilatedStatsRuntime::ACT_ITERATIONS) >= evals, true);
+    TEST_CHECK_EQ(stats.count(VerilatedStatsRuntime::NBA_ITERATIONS) >= evals, true);
+    // Only the rising clock edges have work
+    TEST_CHECK_EQ(stats.count(VerilatedStatsRuntime::ACT_TRIGGERED), posedges);
+    TEST_CHECK_EQ(stats.count(VerilatedStatsRuntime::NBA_TRIGGERED), posedges);
+    // No combinational logic on inputs
+    TEST_CHECK_EQ(stats.count(VerilatedStatsRuntime::ICO_ITERATIONS), 0);
+    TEST_CHECK_CSTR(VerilatedStatsRuntime::name(VerilatedStatsRuntime::NBA_TRIGGERED),
+                    "nba-triggered");
+    // Every evaluation is timed
+    TEST_CHECK_EQ(stats.evalLatencyMaxNs() > 0, true);
+    TEST_CHECK_EQ(stats.evalLatencyNs(50) <= stats.evalLatencyNs(99), true);
+    TEST_CHECK_EQ(stats.evalLatencyNs(99) <= stats.evalLatencyMaxNs(), true);
+    TEST_CHECK_EQ(stats.evalLatencyNs(100), stats.evalLatencyMaxNs());
+    // From +verilator+low+latency
+    TEST_CHECK_EQ(contextp->lowLatency(), true);
+    TEST_CHECK_EQ(contextp->threadsWait() == VerilatedThreadsWait::SPIN, true);
+
+    contextp->statsPrintSummary();
+
+    contextp->statsRuntime().clear();
+    TEST_CHECK_EQ(stats.count(VerilatedStatsRuntime::EVALS), 0);
+    TEST_CHECK_EQ(stats.evalLatencyMaxNs(), 0);
+    TEST_CHECK_EQ(stats.evalLatencyNs(50), 0);
+    topp->final();
+    return errors ? 10 : 0;
+}
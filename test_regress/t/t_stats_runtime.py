@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.top_filename = "t/t_threads_counter.v"
+
+test.compile(make_top_shell=False,
+             make_main=False,
+             verilator_flags2=["--exe", test.pli_filename, "--cc", "--stats-runtime"])
+
+test.file_grep_any(test.glob_some(test.obj_dir + "/" + test.vm_prefix + "*.cpp"),
+                   r'statsRuntime\(\).add\(VerilatedStatsRuntime::NBA_TRIGGERED\)')
+
+test.execute(all_run_flags=["+verilator+low+latency"])
+
+test.file_grep(test.run_log_filename, r'- Verilator: eval \d+ times; per eval')
+test.file_grep(test.run_log_filename, r' act-iterations [\d.]+')
+test.file_grep(test.run_log_filename, r'- Verilator: eval latency p50 [\d.]+ us; p99 ')
+
+test.passes()
@@ -0,0 +1,40 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0);
+`define checks(gotv,expv) do if ((gotv) != (expv)) begin $write("%%Error: %s:%0d:  got='%s' exp='%s'\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   int cyc = 0;
+   int scoreboard[string];
+   string s;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      // Long keys, shared from the constant pool
+      scoreboard["top.dut.transaction_monitor"] += 1;
+      if (cyc[0]) scoreboard["top.dut.response_checker"] += 2;
+      // Short key, built inline
+      scoreboard["short"] += 3;
+      // Nested concatenations reuse the temporary buffer
+      s = {"the_quick_brown_fox_", $sformatf("%0d", cyc), "_jumps_over_the_lazy_dog"};
+      if (cyc == 9) begin
+         `checkh(scoreboard["top.dut.transaction_monitor"], 10);
+         `checkh(scoreboard["top.dut.response_checker"], 10);
+         `checkh(scoreboard["short"], 30);
+         `checkh(scoreboard.num(), 3);
+         `checks(s, "the_quick_brown_fox_9_jumps_over_the_lazy_dog");
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
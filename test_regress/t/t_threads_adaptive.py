@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = "t/t_threads_counter.v"
+
+test.compile(verilator_flags2=['--cc', '--threads-adaptive'], threads=4)
+
+test.file_grep_any(test.glob_some(test.obj_dir + "/" + test.vm_prefix + "*.cpp"),
+                   r'__Vm_adaptive__nba.beginEval')
+
+# Timed warm-up, then either schedule
+test.execute()
+test.execute(all_run_flags=['+verilator+threads+adaptive+serial'])
+test.execute(all_run_flags=['+verilator+threads+adaptive+parallel'])
+
+test.passes()
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = "t/t_threads_sharing_merge.v"
+
+# Force the multilevel coarsening pre-pass even on this small design
+test.compile(verilator_flags2=["--stats --debug-partition --threads-coarsen-min 1"], threads=4)
+
+test.execute()
+
+test.file_grep(test.stats, r'MTask graph, coarsening merges\s+\d+')
+
+test.passes()
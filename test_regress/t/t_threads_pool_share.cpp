@@ -0,0 +1,54 @@
+//
+// DESCRIPTION: Verilator: Two contexts sharing one thread pool
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+#include <memory>
+#include <thread>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+static void sim(VM_PREFIX* topp) {
+    VerilatedContext* const contextp = topp->contextp();
+    // This test created a thread, so need to associate VerilatedContext with it
+    Verilated::threadContextp(contextp);
+    topp->clk = 0;
+    while (!contextp->gotFinish() && contextp->time() < 1000) {
+        contextp->timeInc(1);
+        topp->clk = !topp->clk;
+        topp->eval();
+    }
+    TEST_CHECK_EQ(contextp->gotFinish(), true);
+}
+
+int main(int argc, char** argv) {
+    std::unique_ptr<VerilatedContext> context0p{new VerilatedContext};
+    std::unique_ptr<VerilatedContext> context1p{new VerilatedContext};
+    context0p->threads(4);
+    context1p->threadPoolShare(*context0p);
+    TEST_CHECK_EQ(context1p->threads(), 4);
+    TEST_CHECK_EQ(context0p->threadPoolp(), context1p->threadPoolp());
+
+    std::unique_ptr<VM_PREFIX> top0p{new VM_PREFIX{context0p.get(), "top0"}};
+    std::unique_ptr<VM_PREFIX> top1p{new VM_PREFIX{context1p.get(), "top1"}};
+
+    // Both models evaluate concurrently on the shared pool
+    std::thread t0{sim, top0p.get()};
+    std::thread t1{sim, top1p.get()};
+    t0.join();
+    t1.join();
+
+    top0p->final();
+    top1p->final();
+    return errors ? 10 : 0;
+}
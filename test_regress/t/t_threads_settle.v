@@ -0,0 +1,65 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   // Combinational loops, which take several iterations to settle
+   /* verilator lint_off UNOPTFLAT */
+   wire [7:0] a;
+   wire [7:0] b;
+   wire [7:0] c;
+   wire [7:0] d;
+   /* verilator lint_on UNOPTFLAT */
+   assign a = {b[6:0], crc[0]};
+   assign b = a ^ crc[15:8];
+   assign c = {d[6:0], crc[32]};
+   assign d = c + crc[47:40];
+
+   // Reference without loops
+   logic [7:0] b_ref;
+   logic [7:0] d_ref;
+   always_comb begin
+      logic [7:0] ta;
+      logic [7:0] tc;
+      logic [7:0] td;
+      ta = 8'h0;
+      ta[0] = crc[0];
+      for (int i = 1; i < 8; ++i) ta[i] = ta[i - 1] ^ crc[8 + i - 1];
+      b_ref = ta ^ crc[15:8];
+      tc = 8'h0;
+      tc[0] = crc[32];
+      for (int i = 1; i < 8; ++i) begin
+         td = tc + crc[47:40];
+         tc[i] = td[i - 1];
+      end
+      d_ref = tc + crc[47:40];
+   end
+
+   always @(posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d b=%x/%x d=%x/%x\n", $time, cyc, b, b_ref, d, d_ref);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      if (cyc > 0) begin
+         if (b !== b_ref) $stop;
+         if (d !== d_ref) $stop;
+      end
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
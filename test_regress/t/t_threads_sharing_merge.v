@@ -0,0 +1,56 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Sibling logic blocks sharing written arrays, for mtask merge scoring.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   // Shared between the blocks below
+   reg [31:0] mem_a [0:63];
+   reg [31:0] mem_b [0:63];
+   reg [31:0] sum_a, sum_b, sum_c, sum_d;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+   end
+
+   // Writers of the shared arrays
+   always @(posedge clk) mem_a[crc[5:0]] <= crc[31:0];
+   always @(posedge clk) mem_b[crc[11:6]] <= crc[63:32];
+
+   // Readers, each a sibling of the others
+   always @(posedge clk) sum_a <= sum_a + mem_a[crc[17:12]] * mem_a[crc[23:18]];
+   always @(posedge clk) sum_b <= sum_b ^ (mem_a[crc[29:24]] + mem_b[crc[35:30]]);
+   always @(posedge clk) sum_c <= sum_c + mem_b[crc[41:36]] * mem_b[crc[47:42]];
+   always @(posedge clk) sum_d <= sum_d - (mem_b[crc[53:48]] ^ crc[31:0]);
+
+   initial begin
+      for (int i = 0; i < 64; ++i) begin
+         mem_a[i] = i;
+         mem_b[i] = ~i;
+      end
+      sum_a = 0;
+      sum_b = 0;
+      sum_c = 0;
+      sum_d = 0;
+   end
+
+   always @(posedge clk) begin
+      if (cyc == 99) begin
+         $display("sums %x %x %x %x", sum_a, sum_b, sum_c, sum_d);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,38 @@
+// DESCRIPTION: Verilator: Verilog Test module, C driver code
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include "verilated.h"
+
+#include "TestCheck.h"
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+int main(int argc, char** argv, char**) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+
+    topp->limit = 20;
+
+    // Posedges at 5, 15, ..., 95
+    topp->evalUntil(100);
+    TEST_CHECK_EQ(contextp->time(), 100);
+    TEST_CHECK_EQ(topp->count, 10);
+
+    // Event at the given time is left for the next call
+    topp->evalUntil(105);
+    TEST_CHECK_EQ(contextp->time(), 105);
+    TEST_CHECK_EQ(topp->count, 10);
+
+    // Returns at $finish, on posedge at 205
+    topp->evalUntil(1000);
+    TEST_CHECK_EQ(contextp->gotFinish(), true);
+    TEST_CHECK_EQ(contextp->time(), 205);
+
+    topp->final();
+    return errors;
+}
@@ -0,0 +1,26 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`timescale 1ns/1ns
+
+module t (
+   input [31:0] limit,
+   output logic [31:0] count
+   );
+
+   logic clk = 0;
+   always #5 clk = ~clk;
+
+   initial count = 0;
+   always @(posedge clk) begin
+      count <= count + 1;
+      if (count == limit) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,58 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checkd(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got=%0d exp=%0d\n", `__FILE__,`__LINE__, (gotv), (expv)); $stop; end while(0);
+
+module t(/*AUTOARG*/);
+   logic clk = 0;
+   logic clk2;
+   int   ticks = 0;
+   int   cyc = 0;
+   int   cyc2 = 0;
+   int   last = 0;
+
+   // Periodic processes
+   always #5 clk = ~clk;
+
+   initial begin
+      clk2 = 0;
+      forever #3 clk2 = ~clk2;
+   end
+
+   always begin
+      #7;
+      ticks = ticks + 1;
+   end
+
+   // Stays a coroutine, as it has a second delay
+   always begin
+      #1 last = last + 1;
+      #1 last = last + 1;
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+`ifdef TEST_VERBOSE
+      $display("[%0t] cyc=%0d", $time, cyc);
+`endif
+      `checkd($time, 5 + 10 * cyc);
+   end
+
+   always @(posedge clk2) begin
+      `checkd($time, 3 + 6 * cyc2);
+      cyc2 <= cyc2 + 1;
+   end
+
+   initial begin
+      #101;
+      `checkd(cyc, 10);
+      `checkd(cyc2, 17);
+      `checkd(ticks, 14);
+      `checkd(last, 101);
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
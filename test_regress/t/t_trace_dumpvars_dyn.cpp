@@ -48,6 +48,9 @@ int main(int argc, char** argv) {
     tfp->dumpvars(1, "top.t.cyc");  // A signal
     tfp->dumpvars(1, "top.t.sub1a");  // Scope
     tfp->dumpvars(2, "top.t.sub1b");  // Scope
+#elif defined(T_TRACE_DUMPVARS_DYN_VCD_2)
+    tfp->dumpvarsMatch("top.t.sub1?.sub2b.*");  // Signals in matching scopes
+    tfp->dumpvarsMatch("*.c?k");  // Signals anywhere
 #else
 #error "Bad test"
 #endif
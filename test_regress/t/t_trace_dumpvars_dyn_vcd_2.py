@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.pli_filename = "t/t_trace_dumpvars_dyn.cpp"
+test.top_filename = "t/t_trace_dumpvars_dyn.v"
+
+test.compile(make_main=False,
+             verilator_flags2=["--trace-vcd --exe", test.pli_filename, "-CFLAGS -DVL_DEBUG"])
+
+test.execute()
+
+# Matched signals are declared and dumped
+test.file_grep(test.trace_filename, r'\$var wire 1 , clk \$end')
+test.file_grep(test.trace_filename, r'\$var wire 32 & value \[31:0\] \$end')
+test.file_grep(test.trace_filename, r'\$var wire 32 \* value \[31:0\] \$end')
+test.file_grep(test.trace_filename, r'^b00000000000000000000000000001100 &$')
+test.file_grep(test.trace_filename, r'^b00000000000000000000000000010110 \*$')
+# Others are not
+test.file_grep_not(test.trace_filename, r'\$var wire 32 \$ value')
+test.file_grep_not(test.trace_filename, r'\$var wire 32 % value')
+test.file_grep_not(test.trace_filename, r'^b\d+ \$$')
+test.file_grep_not(test.trace_filename, r'^b\d+ %$')
+
+test.passes()
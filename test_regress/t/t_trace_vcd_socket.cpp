@@ -0,0 +1,83 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+#include VM_PREFIX_INCLUDE
+
+unsigned long long main_time = 0;
+double sc_time_stamp() { return (double)main_time; }
+
+#define SOCKET_NAME VL_STRINGIFY(TEST_OBJ_DIR) "/vcd.sock"
+
+// A minimal viewer: subscribe, then save everything received
+static void viewer(int listenFd) {
+    const int fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd < 0) return;
+    const char* const subscribe = "top.t.sub1?.sub2b.*\n*.c?k\n\n";
+    (void)::write(fd, subscribe, std::strlen(subscribe));
+    FILE* const fp = std::fopen(VL_STRINGIFY(TEST_OBJ_DIR) "/simx.vcd", "w");
+    char buf[4096];
+    while (true) {
+        const ssize_t got = ::read(fd, buf, sizeof(buf));
+        if (got <= 0) break;
+        std::fwrite(buf, 1, got, fp);
+    }
+    std::fclose(fp);
+    ::close(fd);
+}
+
+int main(int argc, char** argv) {
+    Verilated::debug(0);
+    Verilated::traceEverOn(true);
+    Verilated::commandArgs(argc, argv);
+
+    ::unlink(SOCKET_NAME);
+    const int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, SOCKET_NAME);
+    if (::bind(listenFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0
+        || ::listen(listenFd, 1) != 0) {
+        vl_fatal(__FILE__, __LINE__, "main", "Can't listen on " SOCKET_NAME);
+    }
+    std::thread viewerThread{viewer, listenFd};
+
+    std::unique_ptr<VM_PREFIX> top{new VM_PREFIX{"top"}};
+    VerilatedVcdSocket socket;
+    std::unique_ptr<VerilatedVcdC> tfp{new VerilatedVcdC{&socket}};
+    top->trace(tfp.get(), 99);
+    tfp->open("unix:" SOCKET_NAME);
+    if (!tfp->isOpen()) vl_fatal(__FILE__, __LINE__, "main", "Can't connect to viewer");
+    top->clk = 0;
+
+    while (main_time <= 20) {
+        top->eval();
+        tfp->dump((unsigned int)(main_time));
+        ++main_time;
+        top->clk = !top->clk;
+    }
+    tfp->close();
+    top->final();
+    viewerThread.join();
+    ::close(listenFd);
+    ::unlink(SOCKET_NAME);
+    tfp.reset();
+    top.reset();
+    printf("*-* All Finished *-*\n");
+    return 0;
+}
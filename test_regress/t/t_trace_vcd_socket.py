@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.pli_filename = "t/t_trace_vcd_socket.cpp"
+test.top_filename = "t/t_trace_dumpvars_dyn.v"
+
+test.compile(make_main=False, verilator_flags2=["--trace-vcd --exe", test.pli_filename])
+
+test.execute()
+
+# The viewer received the subscribed signals
+test.file_grep(test.trace_filename, r'\$enddefinitions')
+test.file_grep(test.trace_filename, r'\$var wire 1 , clk \$end')
+test.file_grep(test.trace_filename, r'\$var wire 32 & value \[31:0\] \$end')
+test.file_grep(test.trace_filename, r'\$var wire 32 \* value \[31:0\] \$end')
+test.file_grep(test.trace_filename, r'^b00000000000000000000000000001100 &$')
+# But not others
+test.file_grep_not(test.trace_filename, r'\$var wire 32 \$ value')
+test.file_grep_not(test.trace_filename, r'\$var wire 32 % value')
+
+test.passes()
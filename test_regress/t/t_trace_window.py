@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.pli_filename = "t/t_trace_window.cpp"
+
+test.compile(make_top_shell=False,
+             make_main=False,
+             v_flags2=["--trace-vcd --exe", test.pli_filename])
+
+test.execute()
+
+vcd = test.obj_dir + "/simx.vcd"
+test.file_grep_count(vcd, r'\$enddefinitions', 1)
+# Window written by $dumpflush at time 50
+test.file_grep_not(vcd, r'^#29$')
+test.file_grep(vcd, r'^#30$')
+test.file_grep(vcd, r'^#49$')
+test.file_grep_not(vcd, r'^#50$')
+# Window written by dumpWindow() at end
+test.file_grep_not(vcd, r'^#79$')
+test.file_grep(vcd, r'^#80$')
+test.file_grep(vcd, r'^#99$')
+
+test.passes()
@@ -0,0 +1,55 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   localparam N = 33;  // Odd, so the driver tree is unbalanced
+
+   integer cyc = 0;
+   logic [5:0] sel = '1;
+
+   tri [69:0] bus;
+   pullup p_bus (bus);
+
+   // Half the drivers local, half from submodule inouts
+   for (genvar i = 0; i < N; ++i) begin : g_drv
+      if (i % 2 == 0) begin : g_local
+         assign bus = (sel == i) ? {7{10'(i * 3 + 1)}} : 'z;
+      end
+      else begin : g_sub
+         drv #(.I(i)) u_drv (.sel(sel), .bus(bus));
+      end
+   end
+
+   function automatic logic [69:0] expected(logic [5:0] s);
+      if (s < N) return {7{10'(s * 3 + 1)}};
+      return '1;  // Undriven, so pulled up
+   endfunction
+
+   always @(posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d sel=%0d bus=%x\n", $time, cyc, sel, bus);
+`endif
+      cyc <= cyc + 1;
+      sel <= 6'(cyc);
+      if (bus !== expected(sel)) $stop;
+      if (cyc == N + 6) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
+
+module drv #(parameter I = 0)
+   (input [5:0] sel,
+    inout [69:0] bus);
+   assign bus = (sel == I) ? {7{10'(I * 3 + 1)}} : 'z;
+endmodule
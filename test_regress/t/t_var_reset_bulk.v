@@ -0,0 +1,25 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   logic [7:0] mem8[1024];
+   logic [95:0] memw[16][8];
+   logic [4:0] mem5[100];  // Not written, reset value must be clean
+   logic [70:0] mem71[10];  // Not written, reset value must be clean
+   int sum = 0;
+
+   initial begin
+      for (int i = 0; i < 1024; ++i) mem8[i] = 8'(i);
+      for (int i = 0; i < 16; ++i) for (int j = 0; j < 8; ++j) memw[i][j] = 96'(i * j);
+      for (int i = 0; i < 1024; ++i) sum += int'(mem8[i]);
+      for (int i = 0; i < 16; ++i) for (int j = 0; j < 8; ++j) sum += int'(memw[i][j]);
+      if (sum != 130560 + 3360) $stop;
+      for (int i = 0; i < 100; ++i) if (32'(mem5[i]) > 31) $stop;
+      for (int i = 0; i < 10; ++i) if ((mem71[i] >> 71) != 0) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -22,7 +22,7 @@ test.compile(
         "--cc", "--coverage-toggle --coverage-line --coverage-user",
         "--trace-vcd --vpi ", "--trace-threads 1",
         ("--timing" if test.have_coroutines else "--no-timing -Wno-STMTDLY"), "--prof-exec",
-        "--prof-pgo", root + "/include/verilated_save.cpp"
+        "--prof-pgo", root + "/include/verilated_save.cpp", "-LDFLAGS -lz"
     ],
     threads=2)
 
@@ -18,7 +18,7 @@ test.compile(
     # Can't use --coverage and --savable together, so cheat and compile inline
     verilator_flags2=[
         "--cc --coverage-toggle --coverage-line --coverage-user --trace-vcd --prof-exec --prof-pgo --vpi "
-        + root + "/include/verilated_save.cpp",
+        + root + "/include/verilated_save.cpp -LDFLAGS -lz",
         ("--timing" if test.have_coroutines else "--no-timing -Wno-STMTDLY")
     ],
     make_flags=['DRIVER_STD=newest'])
@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_vlt_warn.v"
+
+N = 20000
+
+
+def gen(filename):
+    with open(filename, 'w', encoding="utf8") as fh:
+        fh.write("// Generated by t_vlt_waiver_many.py\n")
+        fh.write("`verilator_config\n")
+        for i in range(N):
+            # Waivers that share literal prefixes with the real messages, but never match
+            fh.write('lint_off -rule UNUSED -file "*/t_vlt_warn.v"'
+                     ' -match "Signal is not used: \'nosuch_%d\'"\n' % i)
+            if i % 100 == 0:
+                fh.write('lint_off -rule WIDTH -file "*/t_vlt_warn.v" -match "*nosuch_%d*"\n' % i)
+
+
+gen(test.obj_dir + "/many.vlt")
+
+# The waivers of t_vlt_warn.vlt must still apply among all the others
+test.lint(verilator_flags2=["--lint-only -Wall t/t_vlt_warn.vlt", test.obj_dir + "/many.vlt"])
+
+test.passes()
@@ -0,0 +1,101 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "verilated.h"
+#include "verilated_vpi.h"
+
+#include VM_PREFIX_INCLUDE
+
+#include "vpi_user.h"
+
+#include <memory>
+#include <vector>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+#include "TestSimulator.h"
+#include "TestVpi.h"
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->debug(0);
+    contextp->commandArgs(argc, argv);
+
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get(),
+                                                        // Note null name - we're flattening it out
+                                                        ""}};
+    topp->clk = 0;
+    topp->eval();
+
+    TestVpiHandle a8 = VPI_HANDLE("a8");
+    TestVpiHandle a40 = VPI_HANDLE("a40");
+    TestVpiHandle a100 = VPI_HANDLE("a100");
+    TestVpiHandle ap = VPI_HANDLE("ap");
+    TestVpiHandle ap2 = vpi_handle_by_index(ap, 2);
+    TestVpiHandle b8 = VPI_HANDLE("b8");
+    TestVpiHandle b40 = VPI_HANDLE("b40");
+    TestVpiHandle b100 = VPI_HANDLE("b100");
+    TestVpiHandle bp = VPI_HANDLE("bp");
+    TestVpiHandle bp2 = vpi_handle_by_index(bp, 2);
+    TEST_CHECK_NZ(ap2);
+    TEST_CHECK_NZ(bp2);
+
+    VerilatedVpiBatch inputs;
+    TEST_CHECK_EQ(inputs.add(a8), 0);
+    TEST_CHECK_EQ(inputs.add(a40), 1);
+    TEST_CHECK_EQ(inputs.add(a100), 2);
+    TEST_CHECK_EQ(inputs.add(ap2), 3);
+    TEST_CHECK_EQ(inputs.bytes(), (1 + 2 + 4 + 1) * sizeof(uint32_t));
+    TEST_CHECK_EQ(inputs.offset(3), (1 + 2 + 4) * sizeof(uint32_t));
+
+    VerilatedVpiBatch outputs;
+    outputs.add(b8);
+    outputs.add(b40);
+    outputs.add(b100);
+    outputs.add(bp2);
+    outputs.add(bp);
+
+    // Read-only signals can't be written
+    std::vector<uint32_t> outBuf(outputs.bytes() / sizeof(uint32_t));
+    TEST_CHECK_EQ(outputs.put(outBuf.data()), false);
+    TEST_CHECK_NZ(vpi_chk_error(nullptr));
+
+    // Upper unused bits are ignored when written
+    const std::vector<uint32_t> inBuf{0x1ff,      0xffffffff, 0xff12,     0x89abcdef, 0x01234567,
+                                      0xfedcba98, 0xfffffff0, 0x5a5aa5};
+    TEST_CHECK_EQ(inputs.put(inBuf.data()), true);
+    TEST_CHECK_EQ(VerilatedVpi::evalNeeded(), true);
+    topp->clk = 1;
+    topp->eval();
+
+    outputs.get(outBuf.data());
+    TEST_CHECK_HEX_EQ(outBuf[0], 0x00);  // 8'hff + 1
+    TEST_CHECK_HEX_EQ(outBuf[1], 0x00000000);  // 40'h12_ffffffff + 1
+    TEST_CHECK_HEX_EQ(outBuf[2], 0x13);
+    TEST_CHECK_HEX_EQ(outBuf[3], 0x76543210);  // ~100'h0_fffffff0_fedcba98_01234567_89abcdef
+    TEST_CHECK_HEX_EQ(outBuf[4], 0xfedcba98);
+    TEST_CHECK_HEX_EQ(outBuf[5], 0x01234567);
+    TEST_CHECK_HEX_EQ(outBuf[6], 0xf);
+    TEST_CHECK_HEX_EQ(outBuf[7], 0xa5);  // bp[2]
+    TEST_CHECK_HEX_EQ(outBuf[8], 0x00a50000);  // bp
+
+    // Same values through vpi_get_value
+    s_vpi_value v;
+    v.format = vpiIntVal;
+    vpi_get_value(bp2, &v);
+    TEST_CHECK_HEX_EQ(v.value.integer, 0xa5);
+
+    topp->final();
+    if (!errors) VL_PRINTF("*-* All Finished *-*\n");
+    return errors ? 10 : 0;
+}
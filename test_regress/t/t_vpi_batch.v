@@ -0,0 +1,29 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   input clk
+   );
+
+   reg [7:0]       a8   /*verilator public_flat_rw*/;
+   reg [39:0]      a40  /*verilator public_flat_rw*/;
+   reg [99:0]      a100 /*verilator public_flat_rw*/;
+   reg [3:0][7:0]  ap   /*verilator public_flat_rw*/;
+
+   reg [7:0]       b8   /*verilator public_flat_rd*/;
+   reg [39:0]      b40  /*verilator public_flat_rd*/;
+   reg [99:0]      b100 /*verilator public_flat_rd*/;
+   reg [3:0][7:0]  bp   /*verilator public_flat_rd*/;
+
+   always @(posedge clk) begin
+      b8 <= a8 + 8'd1;
+      b40 <= a40 + 40'd1;
+      b100 <= ~a100;
+      bp <= ap;
+   end
+
+endmodule : t
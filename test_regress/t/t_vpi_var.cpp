@@ -43,6 +43,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <string>
 
 // These require the above. Comment prevents clang-format moving them
 #include "TestCheck.h"
@@ -254,6 +255,10 @@ int _mon_check_var() {
 
     TestVpiHandle vh3 = vpi_handle_by_name((PLI_BYTE8*)"onebit", vh2);
     CHECK_RESULT_NZ(vh3);
+    // Repeated lookup of the same name gives a separately releasable handle
+    CHECK_RESULT_NZ(vh3 != vh1);
+    const std::string fullname1 = vpi_get_str(vpiFullName, vh1);
+    CHECK_RESULT_CSTR(vpi_get_str(vpiFullName, vh3), fullname1.c_str());
 
 #ifdef T_VPI_VAR2
     // test scoped attributes